@@ -22,13 +22,16 @@ THE SOFTWARE.
 #pragma once
 
 #include "capsaicin_export.h"
+#include "timing_summary.h"
 
 #include <gfx_imgui.h>
 #include <gfx_scene.h>
 
 #include <map>
+#include <string>
 #include <string_view>
 #include <variant>
+#include <vector>
 
 namespace Capsaicin
 {
@@ -39,6 +42,13 @@ namespace Capsaicin
  */
 CAPSAICIN_EXPORT void Initialize(GfxContext gfx, ImGuiContext *imgui_context = nullptr) noexcept;
 
+/**
+ * Sets the number of threads running the CPU side work of Capsaicin (e.g., scene updates).
+ * @param thread_count The number of threads including the calling thread (0 for the number of hardware threads).
+ * @param pin_threads  True to run each worker thread on its own logical processor.
+ */
+CAPSAICIN_EXPORT void SetThreadCount(uint32_t thread_count, bool pin_threads = false) noexcept;
+
 /**
  * Gets the list of supported renderers.
  * @returns The renderers list.
@@ -71,6 +81,144 @@ CAPSAICIN_EXPORT std::vector<std::string> GetCurrentScenes() noexcept;
  */
 CAPSAICIN_EXPORT bool SetScenes(std::vector<std::string> const &names) noexcept;
 
+/**
+ * Sets whether scenes use the compact (quantized) vertex layout.
+ * @note Takes effect the next time a scene is loaded.
+ * @param compact True to use the compact layout, False to use the full precision layout.
+ */
+CAPSAICIN_EXPORT void SetCompactVertices(bool compact) noexcept;
+
+/**
+ * Checks whether the current scene uses the compact (quantized) vertex layout.
+ * @returns True if using the compact layout.
+ */
+CAPSAICIN_EXPORT bool GetCompactVertices() noexcept;
+
+/**
+ * Sets whether scene meshes are welded and reordered for vertex cache and fetch locality when loaded.
+ * @note Takes effect the next time a scene is loaded.
+ * @param optimize True to optimize meshes, False to upload them unchanged.
+ */
+CAPSAICIN_EXPORT void SetOptimizeMeshes(bool optimize) noexcept;
+
+/**
+ * Checks whether the current scene's meshes were optimized when loaded.
+ * @returns True if meshes were optimized.
+ */
+CAPSAICIN_EXPORT bool GetOptimizeMeshes() noexcept;
+
+/**
+ * Sets whether the flattened scene data is stored in and loaded from a binary cache next to the scene file.
+ * @note Takes effect the next time a scene is loaded.
+ * @param enable True to use the scene cache, False to always build the scene data from the source files.
+ */
+CAPSAICIN_EXPORT void SetSceneCacheEnabled(bool enable) noexcept;
+
+/**
+ * Checks whether the current scene's data was loaded from the binary scene cache.
+ * @note Only valid once the first frame of the scene has been rendered.
+ * @returns True if the scene cache was used.
+ */
+CAPSAICIN_EXPORT bool GetSceneCacheHit() noexcept;
+
+/**
+ * Gets the CPU time taken to load the current scene, this includes importing the scene files and building the
+ * scene data during the first rendered frame.
+ * @returns The load time (in seconds).
+ */
+CAPSAICIN_EXPORT double GetSceneLoadTime() noexcept;
+
+/**
+ * Sets the amount of texture data uploaded each frame while the scene's textures are streamed in, mip chains
+ * are generated in the background and placeholder textures are used until each upload completes.
+ * @note Takes effect the next time a scene is loaded.
+ * @param megabytes The per-frame upload budget (in MiB), 0 to upload all textures during scene load.
+ */
+CAPSAICIN_EXPORT void SetTextureUploadBudget(uint32_t megabytes) noexcept;
+
+/**
+ * Sets the filter used to generate the mip levels of streamed textures.
+ * @note Takes effect the next time a scene is loaded.
+ * @param filter The filter name (either "Box" or "Kaiser").
+ * @returns True if succeeded, False if the filter is unknown.
+ */
+CAPSAICIN_EXPORT bool SetTextureMipFilter(std::string_view const &filter) noexcept;
+
+/**
+ * Gets the number of scene textures that are still being streamed in.
+ * @returns The pending texture count.
+ */
+CAPSAICIN_EXPORT uint32_t GetPendingTextureCount() noexcept;
+
+/**
+ * Sets the rate scene animations are sampled at when baked into channels evaluated by Capsaicin, only the
+ * instances whose transform changed are then updated each frame.
+ * @note Takes effect the next time a scene is loaded.
+ * @param rate The number of samples per second, 0 to apply all animations through gfx every frame.
+ */
+CAPSAICIN_EXPORT void SetAnimationSampleRate(float rate) noexcept;
+
+/**
+ * Sets whether AOVs and buffers only used during part of the frame share memory with each other, based on the
+ * accesses declared by each render technique.
+ * @note Takes effect the next time a renderer is set up, aliased AOVs are not available as debug views.
+ * @param enable True to alias transient resources, False to give every AOV and buffer its own memory.
+ */
+CAPSAICIN_EXPORT void SetTransientAliasing(bool enable) noexcept;
+
+/**
+ * Start recording the gfx calls made each frame, attributed to the render technique or component making them.
+ * @note Calls are only captured when Capsaicin is built with CAPSAICIN_ENABLE_GFX_RECORDING, otherwise only the
+ * frame and per technique CPU times are recorded.
+ */
+CAPSAICIN_EXPORT void StartGfxRecording() noexcept;
+
+/**
+ * Stop recording gfx calls and write the recording to a JSON file.
+ * @param file_path Full pathname to the file to write (nullptr to discard the recording).
+ * @returns True if succeeded, False if the file could not be written.
+ */
+CAPSAICIN_EXPORT bool StopGfxRecording(char const *file_path) noexcept;
+
+/**
+ * Start profiling the CPU time spent in the scopes of each frame (scene updates, render techniques, dumps, thread
+ * pool jobs, etc.) along with the GPU time of each render technique.
+ * @note Scopes are only timed when Capsaicin is built with CAPSAICIN_ENABLE_CPU_PROFILING, otherwise only the
+ * frames and GPU times are profiled.
+ */
+CAPSAICIN_EXPORT void StartCpuProfiling() noexcept;
+
+/**
+ * Stop profiling and write the profile to a Chrome trace JSON file.
+ * @param file_path Full pathname to the file to write (nullptr to discard the profile).
+ * @returns True if succeeded, False if the file could not be written.
+ */
+CAPSAICIN_EXPORT bool StopCpuProfiling(char const *file_path) noexcept;
+
+/**
+ * Start collecting the CPU frame time and the GPU time of every timed section of every rendered frame (e.g., for
+ * benchmarking), any previously collected timings are discarded.
+ * The load time of a scene built while collecting is also recorded, in a section telling whether the scene cache
+ * was used.
+ * @param first_frame The index of the first frame to collect timings for (e.g., to skip warm up frames).
+ */
+CAPSAICIN_EXPORT void StartTimingStatistics(uint32_t first_frame) noexcept;
+
+/**
+ * Gets the statistics of the timings collected so far.
+ * @returns The statistics of the CPU frame time ('CPU Frame'), the total GPU time ('GPU Total') and each timed
+ * section ('<technique>' or '<technique>/<section>'), in milliseconds.
+ */
+CAPSAICIN_EXPORT std::vector<TimingSummary> GetTimingStatistics() noexcept;
+
+/**
+ * Stop collecting timings and write the min, mean, median, 95th and 99th percentiles, max and variance of each
+ * timed section to a file.
+ * @param file_path Full pathname to the CSV or JSON ('.json' extension) file to write (nullptr to discard).
+ * @returns True if succeeded, False if the file could not be written.
+ */
+CAPSAICIN_EXPORT bool StopTimingStatistics(char const *file_path) noexcept;
+
 /**
  * Gets the list of cameras available in the current scene.
  * @returns The cameras list.
@@ -270,6 +418,40 @@ CAPSAICIN_EXPORT bool GetRenderPaused() noexcept;
  */
 CAPSAICIN_EXPORT void StepJitterFrameIndex(uint32_t frames);
 
+/**
+ * Start recording the camera state (eye, center, up, field of view, jitter and play time) of each rendered frame
+ * to a compact binary trajectory file.
+ * @param file_path Full pathname to the file to write.
+ * @returns True if succeeded, False if the file could not be created.
+ */
+CAPSAICIN_EXPORT bool StartCameraRecording(char const *file_path) noexcept;
+
+/**
+ * Stop recording the camera trajectory.
+ */
+CAPSAICIN_EXPORT void StopCameraRecording() noexcept;
+
+/**
+ * Start driving the active camera from a trajectory recorded with StartCameraRecording(), until the last
+ * recorded frame.
+ * @note Replays are only bit for bit reproducible under fixed frame rate playback (see SetFixedFrameRate()), a
+ * warning is printed at the end of the replay if the play time or jitter of any frame differed from the recording.
+ * @param file_path Full pathname to the file to read.
+ * @returns True if succeeded, False if the file is missing or invalid.
+ */
+CAPSAICIN_EXPORT bool StartCameraReplay(char const *file_path) noexcept;
+
+/**
+ * Stop replaying the camera trajectory.
+ */
+CAPSAICIN_EXPORT void StopCameraReplay() noexcept;
+
+/**
+ * Check whether a camera trajectory is being replayed.
+ * @returns True if replaying.
+ */
+CAPSAICIN_EXPORT bool IsCameraReplaying() noexcept;
+
 /**
  * Gets count of enabled delta lights (point,spot,direction) in current scene.
  * @returns The delta light count.
@@ -392,4 +574,49 @@ CAPSAICIN_EXPORT void DumpAOVBuffer(char const *file_path, std::string_view cons
  */
 CAPSAICIN_EXPORT void DumpCamera(char const *file_path, bool jittered) noexcept;
 
+/**
+ * Sets the format of the EXR images saved by DumpAOVBuffer() from now on.
+ * @param compression The compression name (either "None", "ZIP" or "PIZ").
+ * @param half        True to store half precision channels, False to store full precision ones.
+ * @returns True if succeeded, False if the compression is unknown.
+ */
+CAPSAICIN_EXPORT bool SetDumpFormat(std::string_view const &compression, bool half) noexcept;
+
+/**
+ * Gets the number of dumped images waiting to be written to disk by the background writer.
+ * @returns The queue depth.
+ */
+CAPSAICIN_EXPORT uint32_t GetDumpQueueDepth() noexcept;
+
+/**
+ * Gets the rate dumped images are being written to disk at, averaged over the last second.
+ * @returns The number of bytes written per second.
+ */
+CAPSAICIN_EXPORT double GetDumpBytesPerSecond() noexcept;
+
+/**
+ * Start capturing an AOV every frame into a single preallocated frame sequence container, frames are copied
+ * as-is once read back so that long captures don't pay for encoding or per-file overhead.
+ * @note Frames can be extracted to EXR files using the frame_extract tool.
+ * @param file_path   Full pathname to the container, or a command prefixed with '|' to write the raw frames to
+ *                    (4 channels per pixel, 32 or 16-bit floats depending on half).
+ * @param aov         The AOV to capture (get available from @GetAOVs()).
+ * @param first_frame The first frame index to capture (see @GetFrameIndex()).
+ * @param frame_count The number of frames to capture.
+ * @param half        True to store half precision channels, False to store full precision ones.
+ */
+CAPSAICIN_EXPORT void StartFrameCapture(char const *file_path, std::string_view const &aov, uint32_t first_frame,
+    uint32_t frame_count, bool half) noexcept;
+
+/**
+ * Stop capturing frames, waiting for the frames still being read back.
+ */
+CAPSAICIN_EXPORT void StopFrameCapture() noexcept;
+
+/**
+ * Gets the number of frames written by the current frame capture.
+ * @returns The captured frame count.
+ */
+CAPSAICIN_EXPORT uint32_t GetCapturedFrameCount() noexcept;
+
 } // namespace Capsaicin
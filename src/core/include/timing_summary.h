@@ -0,0 +1,42 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Capsaicin
+{
+/** Statistics of the samples of a timed section. */
+struct TimingSummary
+{
+    std::string name;           /**< The section name */
+    uint32_t    count    = 0;   /**< Number of samples */
+    double      min      = 0.0; /**< Smallest sample */
+    double      mean     = 0.0; /**< Arithmetic mean of the samples */
+    double      p50      = 0.0; /**< Median (nearest rank) */
+    double      p95      = 0.0; /**< 95th percentile (nearest rank) */
+    double      p99      = 0.0; /**< 99th percentile (nearest rank) */
+    double      max      = 0.0; /**< Largest sample */
+    double      variance = 0.0; /**< Population variance of the samples */
+};
+} // namespace Capsaicin
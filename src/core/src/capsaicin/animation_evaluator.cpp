@@ -0,0 +1,446 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "animation_evaluator.h"
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Capsaicin
+{
+namespace
+{
+/** Maximum number of samples a single keyframe segment may replace (unless its value is constant). */
+constexpr uint32_t kMaxSegmentLength = 16;
+
+/** Maximum number of keyframes a cursor is walked before falling back to a binary search. */
+constexpr uint32_t kMaxCursorSteps = 4;
+
+/** Maximum number of times an interval between two fixed rate samples is split. */
+constexpr uint32_t kMaxRefinementDepth = 8;
+
+bool Decompose(glm::mat4 const &transform, AnimationKeyframe &keyframe) noexcept
+{
+    if (transform[0][3] != 0.0f || transform[1][3] != 0.0f || transform[2][3] != 0.0f || transform[3][3] != 1.0f)
+    {
+        return false; // projective transforms are not supported
+    }
+    glm::vec3 const x(transform[0]);
+    glm::vec3 const y(transform[1]);
+    glm::vec3 const z(transform[2]);
+    glm::vec3       scale(glm::length(x), glm::length(y), glm::length(z));
+    if (scale.x == 0.0f || scale.y == 0.0f || scale.z == 0.0f)
+    {
+        return false; // the rotation of a degenerate transform is undefined
+    }
+    if (glm::dot(glm::cross(x, y), z) < 0.0f)
+    {
+        scale.x = -scale.x; // mirrored
+    }
+    keyframe.translation = glm::vec3(transform[3]);
+    keyframe.rotation    = glm::normalize(glm::quat_cast(glm::mat3(x / scale.x, y / scale.y, z / scale.z)));
+    keyframe.scale       = scale;
+    return true;
+}
+
+glm::mat4 Compose(AnimationKeyframe const &keyframe) noexcept
+{
+    glm::mat3 const rotation = glm::mat3_cast(keyframe.rotation);
+    return glm::mat4(glm::vec4(rotation[0] * keyframe.scale.x, 0.0f), glm::vec4(rotation[1] * keyframe.scale.y, 0.0f),
+        glm::vec4(rotation[2] * keyframe.scale.z, 0.0f), glm::vec4(keyframe.translation, 1.0f));
+}
+
+AnimationKeyframe Interpolate(AnimationKeyframe const &key0, AnimationKeyframe const &key1, float alpha) noexcept
+{
+    AnimationKeyframe keyframe;
+    keyframe.translation = glm::mix(key0.translation, key1.translation, alpha);
+    keyframe.rotation    = glm::slerp(key0.rotation, key1.rotation, alpha);
+    keyframe.scale       = glm::mix(key0.scale, key1.scale, alpha);
+    return keyframe;
+}
+
+bool Equal(AnimationKeyframe const &key0, AnimationKeyframe const &key1, float tolerance) noexcept
+{
+    glm::vec3 const translation_error = glm::abs(key0.translation - key1.translation);
+    glm::vec3 const scale_error       = glm::abs(key0.scale - key1.scale);
+    float const     rotation_error    = glm::length(key0.rotation - key1.rotation);
+    return glm::all(glm::lessThanEqual(translation_error, (glm::abs(key0.translation) + 1.0f) * tolerance))
+        && glm::all(glm::lessThanEqual(scale_error, (glm::abs(key0.scale) + 1.0f) * tolerance))
+        && rotation_error <= tolerance;
+}
+
+bool Equal(glm::mat4 const &transform0, glm::mat4 const &transform1, float tolerance) noexcept
+{
+    for (uint32_t column = 0; column < 4; ++column)
+    {
+        glm::vec4 const error     = glm::abs(transform0[column] - transform1[column]);
+        glm::vec4 const magnitude = glm::abs(transform1[column]) + 1.0f;
+        if (glm::any(glm::greaterThan(error, magnitude * tolerance)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Decompose the samples of a target and select the keyframes needed to reproduce them by interpolation.
+ * @param       sampler   The sampled animation.
+ * @param       target    The index of the target.
+ * @param       tolerance The maximum allowed error.
+ * @param [out] samples   The decomposed samples (must hold all samples).
+ * @param [out] keys      The sample index of each keyframe.
+ * @returns True if succeeded, False if a sample can't be decomposed.
+ */
+bool ReduceSamples(AnimationSampler const &sampler, uint32_t target, float tolerance,
+    std::vector<AnimationKeyframe> &samples, std::vector<uint32_t> &keys) noexcept
+{
+    std::vector<float> const &times = sampler.getTimes();
+    uint32_t const            count = (uint32_t)times.size();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        glm::mat4 const &transform = sampler.getTransform(i, target);
+        if (!Decompose(transform, samples[i]) || !Equal(Compose(samples[i]), transform, tolerance))
+        {
+            return false; // degenerate or sheared
+        }
+        // Keep consecutive rotations in the same hemisphere so that interpolation takes the shortest path
+        if (i > 0 && glm::dot(samples[i - 1].rotation, samples[i].rotation) < 0.0f)
+        {
+            samples[i].rotation = -samples[i].rotation;
+        }
+    }
+
+    // Greedily extend each segment for as long as the samples it covers are reproduced by interpolation
+    keys.clear();
+    keys.push_back(0);
+    uint32_t start = 0;
+    while (start + 1 < count)
+    {
+        uint32_t end      = start + 1;
+        bool     constant = Equal(samples[start], samples[end], 0.0f);
+        while (end + 1 < count)
+        {
+            // Runs of a constant value are collapsed whatever their length
+            if (constant && Equal(samples[start], samples[end + 1], 0.0f))
+            {
+                ++end;
+                continue;
+            }
+            if (end + 1 - start > kMaxSegmentLength)
+            {
+                break;
+            }
+            float const range      = times[end + 1] - times[start];
+            bool        reproduced = true;
+            for (uint32_t i = start + 1; i <= end && reproduced; ++i)
+            {
+                float const alpha = (times[i] - times[start]) / range;
+                reproduced = Equal(Interpolate(samples[start], samples[end + 1], alpha), samples[i], tolerance);
+            }
+            if (!reproduced)
+            {
+                break;
+            }
+            constant = false;
+            ++end;
+        }
+        keys.push_back(end);
+        start = end;
+    }
+    return true;
+}
+} // namespace
+
+void AnimationSampler::initialize(float length, float rate, float tolerance, uint32_t target_count) noexcept
+{
+    length_        = glm::max(length, 0.0f);
+    tolerance_     = tolerance;
+    target_count_  = target_count;
+    uniform_count_ = glm::max((uint32_t)ceilf(length_ * rate), 1U) + 1;
+    intervals_.clear();
+    times_.clear();
+    transforms_.clear();
+}
+
+bool AnimationSampler::next(float &time) noexcept
+{
+    uint32_t const sample_count = (uint32_t)times_.size();
+    if (sample_count < uniform_count_)
+    {
+        time_ = length_ * (float)sample_count / (float)(uniform_count_ - 1);
+        time  = time_;
+        return true;
+    }
+    if (intervals_.empty())
+    {
+        // Order the samples by time now that sampling is complete
+        std::vector<uint32_t> order(sample_count);
+        for (uint32_t i = 0; i < sample_count; ++i)
+        {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) { return times_[lhs] < times_[rhs]; });
+        std::vector<float>     times(sample_count);
+        std::vector<glm::mat4> transforms(transforms_.size());
+        for (uint32_t i = 0; i < sample_count; ++i)
+        {
+            times[i] = times_[order[i]];
+            std::copy_n(&transforms_[(size_t)order[i] * target_count_], target_count_,
+                &transforms[(size_t)i * target_count_]);
+        }
+        times_.swap(times);
+        transforms_.swap(transforms);
+        return false;
+    }
+    interval_ = intervals_.back();
+    intervals_.pop_back();
+    time_ = 0.5f * (times_[interval_.sample0] + times_[interval_.sample1]);
+    time  = time_;
+    return true;
+}
+
+void AnimationSampler::record(glm::mat4 const *transforms) noexcept
+{
+    uint32_t const sample = (uint32_t)times_.size();
+    times_.push_back(time_);
+    transforms_.insert(transforms_.end(), transforms, transforms + target_count_);
+
+    if (sample < uniform_count_)
+    {
+        if (sample > 0)
+        {
+            intervals_.push_back({sample - 1, sample, 0});
+        }
+        return;
+    }
+
+    // Split the interval if any target's midpoint is not reproduced by interpolating the interval's ends
+    glm::mat4 const *transforms0 = &transforms_[(size_t)interval_.sample0 * target_count_];
+    glm::mat4 const *transforms1 = &transforms_[(size_t)interval_.sample1 * target_count_];
+    for (uint32_t target = 0; target < target_count_; ++target)
+    {
+        AnimationKeyframe key0;
+        AnimationKeyframe key1;
+        if (!Decompose(transforms0[target], key0) || !Decompose(transforms1[target], key1))
+        {
+            continue; // can't be interpolated, the channel is rejected when added
+        }
+        if (glm::dot(key0.rotation, key1.rotation) < 0.0f)
+        {
+            key1.rotation = -key1.rotation;
+        }
+        if (!Equal(Compose(Interpolate(key0, key1, 0.5f)), transforms[target], tolerance_))
+        {
+            if (interval_.depth + 1 < kMaxRefinementDepth)
+            {
+                intervals_.push_back({interval_.sample0, sample, interval_.depth + 1});
+                intervals_.push_back({sample, interval_.sample1, interval_.depth + 1});
+            }
+            break;
+        }
+    }
+}
+
+void AnimationEvaluator::clear() noexcept
+{
+    animations_.clear();
+    channels_.clear();
+    key_times_.clear();
+    key_values_.clear();
+    key_constant_.clear();
+    channel_dirty_.clear();
+    touched_.clear();
+}
+
+bool AnimationEvaluator::addAnimation(
+    AnimationSampler const &sampler, uint32_t const *targets, float tolerance) noexcept
+{
+    std::vector<float> const &times        = sampler.getTimes();
+    uint32_t const            sample_count = (uint32_t)times.size();
+    uint32_t const            target_count = sampler.getTargetCount();
+    if (sample_count == 0)
+    {
+        return false;
+    }
+
+    // Reduce the samples of each target in parallel
+    std::vector<std::vector<AnimationKeyframe>> target_samples(target_count);
+    std::vector<std::vector<uint32_t>>          target_keys(target_count);
+    std::vector<uint8_t>                        target_valid(target_count, 0);
+    ThreadPool().Dispatch(
+        [&](uint32_t target) {
+            std::vector<AnimationKeyframe> &samples = target_samples[target];
+            std::vector<uint32_t>          &keys    = target_keys[target];
+            samples.resize(sample_count);
+            target_valid[target] = ReduceSamples(sampler, target, tolerance, samples, keys) ? 1 : 0;
+        },
+        target_count, 1);
+    for (uint32_t target = 0; target < target_count; ++target)
+    {
+        if (target_valid[target] == 0)
+        {
+            return false;
+        }
+    }
+
+    Animation animation;
+    animation.length = sampler.getLength();
+    animations_.push_back(animation);
+    for (uint32_t target = 0; target < target_count; ++target)
+    {
+        Channel channel;
+        channel.animation  = (uint32_t)animations_.size() - 1;
+        channel.target     = targets[target];
+        channel.key_offset = (uint32_t)key_times_.size();
+        channel.key_count  = (uint32_t)target_keys[target].size();
+        for (uint32_t sample : target_keys[target])
+        {
+            key_times_.push_back(times[sample]);
+            key_values_.push_back(target_samples[target][sample]);
+        }
+
+        // Flag the segments that hold their value so that evaluation can be skipped while inside them
+        for (uint32_t i = 0; i < channel.key_count; ++i)
+        {
+            uint32_t const key = channel.key_offset + i;
+            key_constant_.push_back(
+                i + 1 == channel.key_count || Equal(key_values_[key], key_values_[key + 1], 0.0f) ? 1 : 0);
+        }
+        channels_.push_back(channel);
+    }
+    return true;
+}
+
+std::vector<uint32_t> const &AnimationEvaluator::evaluate(double play_time) noexcept
+{
+    // Wrap the play time to each animation, channels of animations whose time did not change are skipped
+    for (Animation &animation : animations_)
+    {
+        float time = 0.0f;
+        if (animation.length > 0.0f)
+        {
+            time = (float)fmod(play_time, (double)animation.length);
+            // Handle negative playback times
+            time = (time >= 0.0f) ? time : animation.length + time;
+        }
+        animation.changed   = !animation.evaluated || time != animation.time;
+        animation.time      = time;
+        animation.evaluated = true;
+    }
+
+    uint32_t const channel_count = (uint32_t)channels_.size();
+    channel_dirty_.resize(channel_count);
+    ThreadPool().Dispatch(
+        [&](uint32_t i) { channel_dirty_[i] = evaluateChannel(channels_[i]) ? 1 : 0; }, channel_count, 64);
+
+    touched_.clear();
+    for (uint32_t i = 0; i < channel_count; ++i)
+    {
+        if (channel_dirty_[i] != 0)
+        {
+            touched_.push_back(i);
+        }
+    }
+    return touched_;
+}
+
+void AnimationEvaluator::invalidate() noexcept
+{
+    for (Animation &animation : animations_)
+    {
+        animation.evaluated = false;
+    }
+    for (Channel &channel : channels_)
+    {
+        channel.valid = false;
+    }
+}
+
+uint32_t AnimationEvaluator::seek(Channel const &channel, float time) const noexcept
+{
+    float const *times = &key_times_[channel.key_offset];
+    uint32_t     key   = channel.cursor;
+
+    // Playback usually moves by less than a keyframe per frame, so walk the cursor from its last position
+    for (uint32_t step = 0; step < kMaxCursorSteps; ++step)
+    {
+        if (key + 1 < channel.key_count && time >= times[key + 1])
+        {
+            ++key;
+        }
+        else if (key > 0 && time < times[key])
+        {
+            --key;
+        }
+        else
+        {
+            return key;
+        }
+    }
+
+    // Fall back to a binary search after a jump (e.g., when the animation loops)
+    return (uint32_t)(std::upper_bound(times + 1, times + channel.key_count, time) - times) - 1;
+}
+
+bool AnimationEvaluator::evaluateChannel(Channel &channel) noexcept
+{
+    Animation const &animation = animations_[channel.animation];
+    if (!animation.changed && channel.valid)
+    {
+        return false;
+    }
+
+    uint32_t const key = seek(channel, animation.time);
+    if (channel.valid && channel.constant && key == channel.cursor)
+    {
+        return false; // still inside a segment holding its value
+    }
+    channel.cursor = key;
+
+    uint32_t const index = channel.key_offset + key;
+    AnimationKeyframe value;
+    if (key_constant_[index] != 0)
+    {
+        value            = key_values_[index];
+        channel.constant = true;
+    }
+    else
+    {
+        float const alpha = glm::clamp((animation.time - key_times_[index])
+                                           / (key_times_[index + 1] - key_times_[index]),
+            0.0f, 1.0f);
+        value            = Interpolate(key_values_[index], key_values_[index + 1], alpha);
+        channel.constant = false;
+    }
+
+    glm::mat4 const transform = Compose(value);
+    if (channel.valid && transform == channel.transform)
+    {
+        return false;
+    }
+    channel.transform = transform;
+    channel.valid     = true;
+    return true;
+}
+} // namespace Capsaicin
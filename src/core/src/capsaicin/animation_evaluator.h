@@ -0,0 +1,219 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <vector>
+
+namespace Capsaicin
+{
+/** A transform decomposed into translation, rotation and scale. */
+struct AnimationKeyframe
+{
+    glm::vec3 translation = glm::vec3(0.0f);
+    glm::quat rotation    = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::vec3 scale       = glm::vec3(1.0f);
+};
+
+/**
+ * Chooses the times an animation is sampled at when it is baked into channels.
+ * Samples are taken at a fixed rate, every interval between two samples is then checked at its midpoint and split
+ * for as long as interpolating its ends misses the animation (e.g., around keyframes falling in between samples).
+ */
+class AnimationSampler
+{
+public:
+    /**
+     * Start sampling an animation.
+     * @param length       The length of the animation (in seconds).
+     * @param rate         The number of samples per second taken before refinement.
+     * @param tolerance    The maximum allowed interpolation error, relative to the transforms' magnitude.
+     * @param target_count The number of targets recorded by each sample.
+     */
+    void initialize(float length, float rate, float tolerance, uint32_t target_count) noexcept;
+
+    /**
+     * Gets the time of the next sample to record.
+     * @param [out] time The sample time (in seconds).
+     * @returns True if a sample is required, False if sampling is complete.
+     */
+    bool next(float &time) noexcept;
+
+    /**
+     * Record the transforms of all targets at the time returned by the last call to next().
+     * @param transforms The transform of each target.
+     */
+    void record(glm::mat4 const *transforms) noexcept;
+
+    /**
+     * Gets the number of samples recorded.
+     * @returns The sample count.
+     */
+    uint32_t getSampleCount() const noexcept { return (uint32_t)times_.size(); }
+
+    /**
+     * Gets the length of the sampled animation.
+     * @returns The length (in seconds).
+     */
+    float getLength() const noexcept { return length_; }
+
+    /**
+     * Gets the number of targets recorded by each sample.
+     * @returns The target count.
+     */
+    uint32_t getTargetCount() const noexcept { return target_count_; }
+
+    /**
+     * Gets the time of each recorded sample.
+     * @note Samples are ordered by time once next() returned False.
+     * @returns The list of sample times (in seconds).
+     */
+    std::vector<float> const &getTimes() const noexcept { return times_; }
+
+    /**
+     * Gets a recorded transform.
+     * @param sample The index of the sample.
+     * @param target The index of the target.
+     * @returns The transform.
+     */
+    glm::mat4 const &getTransform(uint32_t sample, uint32_t target) const noexcept
+    {
+        return transforms_[(size_t)sample * target_count_ + target];
+    }
+
+private:
+    /** An interval between two recorded samples whose midpoint is to be checked. */
+    struct Interval
+    {
+        uint32_t sample0 = 0; /**< Index of the sample at the start of the interval */
+        uint32_t sample1 = 0; /**< Index of the sample at the end of the interval */
+        uint32_t depth   = 0; /**< Number of times the interval has been split */
+    };
+
+    float                  length_        = 0.0f; /**< The length of the animation (in seconds) */
+    float                  tolerance_     = 0.0f; /**< The maximum allowed interpolation error */
+    uint32_t               target_count_  = 0;    /**< The number of targets recorded by each sample */
+    uint32_t               uniform_count_ = 0;    /**< The number of fixed rate samples */
+    float                  time_          = 0.0f; /**< The time returned by the last call to next() */
+    Interval               interval_;             /**< The interval whose midpoint is being sampled */
+    std::vector<Interval>  intervals_;            /**< Intervals still to be checked */
+    std::vector<float>     times_;                /**< The time of each recorded sample */
+    std::vector<glm::mat4> transforms_;           /**< The recorded transforms (sample-major) */
+};
+
+/**
+ * Evaluates keyframed transform channels, each driving a single target (e.g., an instance).
+ * Channels are grouped by animation, each animation loops over its own length. Every channel keeps a cursor to
+ * its current keyframe so that lookups are amortized O(1) for both forward and reverse playback, channels are
+ * evaluated in parallel and only the ones whose value changed are reported.
+ */
+class AnimationEvaluator
+{
+public:
+    /**
+     * Remove all animations and channels.
+     */
+    void clear() noexcept;
+
+    /**
+     * Add an animation with a channel for each of its sampled targets, removing the samples that can be
+     * interpolated from their neighbours within the given tolerance.
+     * @param sampler   The sampled animation.
+     * @param targets   Caller defined index of each of the sampler's targets.
+     * @param tolerance The maximum allowed error, relative to the transforms' magnitude.
+     * @returns True if succeeded, False if a transform can't be represented as translation, rotation and scale.
+     */
+    bool addAnimation(AnimationSampler const &sampler, uint32_t const *targets, float tolerance) noexcept;
+
+    /**
+     * Evaluate all channels at a given play time.
+     * @param play_time The absolute play time (in seconds), wrapped to the length of each animation.
+     * @returns The indices of the channels whose transform changed since the previous evaluation.
+     */
+    std::vector<uint32_t> const &evaluate(double play_time) noexcept;
+
+    /**
+     * Force all channels to be reported by the next evaluation.
+     */
+    void invalidate() noexcept;
+
+    /**
+     * Gets the number of channels.
+     * @returns The channel count.
+     */
+    uint32_t getChannelCount() const noexcept { return (uint32_t)channels_.size(); }
+
+    /**
+     * Gets the number of keyframes stored over all channels.
+     * @returns The keyframe count.
+     */
+    uint32_t getKeyframeCount() const noexcept { return (uint32_t)key_times_.size(); }
+
+    /**
+     * Gets the target of a channel.
+     * @param channel The index of the channel.
+     * @returns The target index passed when the channel was added.
+     */
+    uint32_t getTarget(uint32_t channel) const noexcept { return channels_[channel].target; }
+
+    /**
+     * Gets the transform of a channel as of the last evaluation.
+     * @param channel The index of the channel.
+     * @returns The transform.
+     */
+    glm::mat4 const &getTransform(uint32_t channel) const noexcept { return channels_[channel].transform; }
+
+private:
+    struct Animation
+    {
+        float length    = 0.0f;  /**< The length of the animation (in seconds) */
+        float time      = 0.0f;  /**< The wrapped time of the current evaluation */
+        bool  evaluated = false; /**< Whether the animation's channels have been evaluated at least once */
+        bool  changed   = false; /**< Whether the wrapped time changed during the current evaluation */
+    };
+
+    struct Channel
+    {
+        uint32_t  animation  = 0;               /**< Index of the driving animation */
+        uint32_t  target     = 0;               /**< Caller defined target index */
+        uint32_t  key_offset = 0;               /**< Index of the channel's first keyframe */
+        uint32_t  key_count  = 0;               /**< Number of keyframes */
+        uint32_t  cursor     = 0;               /**< Keyframe the last evaluated time falls in (relative) */
+        bool      constant   = false;           /**< Whether the last evaluated segment has a constant value */
+        bool      valid      = false;           /**< Whether the transform holds an evaluated value */
+        glm::mat4 transform  = glm::mat4(1.0f); /**< The transform as of the last evaluation */
+    };
+
+    uint32_t seek(Channel const &channel, float time) const noexcept;
+    bool     evaluateChannel(Channel &channel) noexcept;
+
+    std::vector<Animation>         animations_;    /**< The list of animations */
+    std::vector<Channel>           channels_;      /**< The list of channels */
+    std::vector<float>             key_times_;     /**< The keyframe times of all channels */
+    std::vector<AnimationKeyframe> key_values_;    /**< The keyframe values of all channels */
+    std::vector<uint8_t>           key_constant_;  /**< Whether each keyframe's value is held until the next one */
+    std::vector<uint8_t>           channel_dirty_; /**< Whether each channel changed during the current evaluation */
+    std::vector<uint32_t>          touched_;       /**< Channels changed by the last evaluation */
+};
+} // namespace Capsaicin
@@ -0,0 +1,142 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "camera_trajectory.h"
+
+#include <algorithm>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr char kTrajectoryMagic[4] = {'C', 'T', 'R', 'J'};
+
+/** Header found at the start of a trajectory file, followed by the keyframes. */
+struct TrajectoryHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t keyframe_size; /**< sizeof(CameraKeyframe), guards against layout changes */
+    uint32_t reserved;
+};
+} // unnamed namespace
+
+bool CameraTrajectoryWriter::open(char const *file_path) noexcept
+{
+    close();
+    file_ = fopen(file_path, "wb");
+    if (file_ == nullptr)
+    {
+        return false;
+    }
+    TrajectoryHeader header = {};
+    std::copy_n(kTrajectoryMagic, 4, header.magic);
+    header.version       = kVersion;
+    header.keyframe_size = sizeof(CameraKeyframe);
+    if (fwrite(&header, sizeof(header), 1, file_) != 1)
+    {
+        close();
+        return false;
+    }
+    keyframe_count_   = 0;
+    last_frame_index_ = 0;
+    return true;
+}
+
+void CameraTrajectoryWriter::close() noexcept
+{
+    if (file_ != nullptr)
+    {
+        fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+void CameraTrajectoryWriter::write(CameraKeyframe const &keyframe) noexcept
+{
+    if (file_ == nullptr || (keyframe_count_ > 0 && keyframe.frame_index <= last_frame_index_))
+    {
+        return;
+    }
+    fwrite(&keyframe, sizeof(keyframe), 1, file_);
+    ++keyframe_count_;
+    last_frame_index_ = keyframe.frame_index;
+}
+
+bool CameraTrajectoryReader::open(char const *file_path) noexcept
+{
+    close();
+    FILE *file = fopen(file_path, "rb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    TrajectoryHeader header = {};
+    bool             valid  = fread(&header, sizeof(header), 1, file) == 1
+                 && std::equal(header.magic, header.magic + 4, kTrajectoryMagic)
+                 && header.version == CameraTrajectoryWriter::kVersion
+                 && header.keyframe_size == sizeof(CameraKeyframe);
+    CameraKeyframe keyframe;
+    while (valid && fread(&keyframe, sizeof(keyframe), 1, file) == 1)
+    {
+        // Frames must be in increasing order for the look ups
+        valid = keyframes_.empty() || keyframe.frame_index > keyframes_.back().frame_index;
+        keyframes_.push_back(keyframe);
+    }
+    fclose(file);
+    if (!valid)
+    {
+        close();
+    }
+    return isOpen();
+}
+
+void CameraTrajectoryReader::close() noexcept
+{
+    keyframes_.clear();
+    cursor_ = 0;
+}
+
+CameraKeyframe const *CameraTrajectoryReader::find(uint32_t frame_index) noexcept
+{
+    if (keyframes_.empty())
+    {
+        return nullptr;
+    }
+    // Frames are usually rendered in order, so check the last found keyframe and the next one first
+    for (size_t i = cursor_; i < std::min(cursor_ + 2, keyframes_.size()); ++i)
+    {
+        if (keyframes_[i].frame_index == frame_index)
+        {
+            cursor_ = i;
+            return &keyframes_[i];
+        }
+    }
+    auto const keyframe = std::lower_bound(keyframes_.cbegin(), keyframes_.cend(), frame_index,
+        [](CameraKeyframe const &item, uint32_t index) { return item.frame_index < index; });
+    if (keyframe == keyframes_.cend() || keyframe->frame_index != frame_index)
+    {
+        return nullptr;
+    }
+    cursor_ = (size_t)(keyframe - keyframes_.cbegin());
+    return &*keyframe;
+}
+} // namespace Capsaicin
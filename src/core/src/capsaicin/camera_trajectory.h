@@ -0,0 +1,144 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Capsaicin
+{
+/** The state of the camera for a rendered frame. */
+struct CameraKeyframe
+{
+    uint32_t  frame_index = 0;    /**< The index of the frame in the renderer */
+    float     fov_y       = 0.0f; /**< Vertical field of view (radians) */
+    double    play_time   = 0.0;  /**< Animation playback position (s) */
+    glm::vec3 eye;                /**< Camera position */
+    glm::vec3 center;             /**< Point looked at */
+    glm::vec3 up;                 /**< Up direction */
+    float     aspect   = 0.0f;    /**< Aspect ratio */
+    float     jitter_x = 0.0f;    /**< Sub-pixel jitter applied to the projection along X */
+    float     jitter_y = 0.0f;    /**< Sub-pixel jitter applied to the projection along Y */
+};
+
+/**
+ * Appends the camera state of each rendered frame to a compact binary trajectory file.
+ * Only frames with an index greater than the last recorded one are written, so that the trajectory can be looked
+ * up by frame index when replayed.
+ */
+class CameraTrajectoryWriter
+{
+public:
+    /** Version of the file layout, any change to the layout or its meaning must increment it. */
+    static constexpr uint32_t kVersion = 1;
+
+    CameraTrajectoryWriter() noexcept = default;
+    ~CameraTrajectoryWriter() noexcept { close(); }
+
+    CameraTrajectoryWriter(CameraTrajectoryWriter const &)            = delete;
+    CameraTrajectoryWriter &operator=(CameraTrajectoryWriter const &) = delete;
+
+    /**
+     * Create a trajectory file, any previous file is closed.
+     * @param file_path Path to the file.
+     * @returns True if succeeded, False otherwise.
+     */
+    bool open(char const *file_path) noexcept;
+
+    /**
+     * Flush and close the file.
+     */
+    void close() noexcept;
+
+    /**
+     * Check whether a trajectory is being recorded.
+     * @returns True if open.
+     */
+    bool isOpen() const noexcept { return file_ != nullptr; }
+
+    /**
+     * Append the camera state of a frame.
+     * @param keyframe The camera state.
+     */
+    void write(CameraKeyframe const &keyframe) noexcept;
+
+    /**
+     * Gets the number of frames recorded.
+     * @returns The keyframe count.
+     */
+    uint32_t getKeyframeCount() const noexcept { return keyframe_count_; }
+
+private:
+    FILE    *file_             = nullptr; /**< The trajectory file */
+    uint32_t keyframe_count_   = 0;       /**< The number of frames recorded */
+    uint32_t last_frame_index_ = 0;       /**< The index of the last recorded frame */
+};
+
+/** Reads a trajectory file written by CameraTrajectoryWriter and looks up the camera state of each frame. */
+class CameraTrajectoryReader
+{
+public:
+    /**
+     * Load a trajectory file.
+     * @param file_path Path to the file.
+     * @returns True if succeeded, False if the file is missing or invalid.
+     */
+    bool open(char const *file_path) noexcept;
+
+    /**
+     * Release the loaded trajectory.
+     */
+    void close() noexcept;
+
+    /**
+     * Check whether a trajectory is loaded.
+     * @returns True if loaded.
+     */
+    bool isOpen() const noexcept { return !keyframes_.empty(); }
+
+    /**
+     * Gets the number of frames in the trajectory.
+     * @returns The keyframe count.
+     */
+    uint32_t getKeyframeCount() const noexcept { return (uint32_t)keyframes_.size(); }
+
+    /**
+     * Gets the index of the last frame in the trajectory.
+     * @returns The frame index.
+     */
+    uint32_t getLastFrameIndex() const noexcept { return keyframes_.back().frame_index; }
+
+    /**
+     * Find the camera state of a frame.
+     * @note Consecutive frames are found in constant time.
+     * @param frame_index The index of the frame in the renderer.
+     * @returns The camera state, or nullptr if the frame isn't in the trajectory.
+     */
+    CameraKeyframe const *find(uint32_t frame_index) noexcept;
+
+private:
+    std::vector<CameraKeyframe> keyframes_;  /**< Keyframes in increasing frame index order */
+    size_t                      cursor_ = 0; /**< Position of the last keyframe found */
+};
+} // namespace Capsaicin
@@ -39,6 +39,11 @@ void Initialize(GfxContext gfx, ImGuiContext *imgui_context) noexcept
     g_renderer->initialize(gfx, imgui_context);
 }
 
+void SetThreadCount(uint32_t thread_count, bool pin_threads) noexcept
+{
+    ThreadPool::Create(thread_count != 0 ? thread_count : std::thread::hardware_concurrency(), pin_threads);
+}
+
 std::vector<std::string_view> GetRenderers() noexcept
 {
     return CapsaicinInternal::GetRenderers();
@@ -68,6 +73,113 @@ bool SetScenes(std::vector<std::string> const &names) noexcept
     return false;
 }
 
+void SetCompactVertices(bool compact) noexcept
+{
+    if (g_renderer != nullptr) g_renderer->setCompactVertices(compact);
+}
+
+bool GetCompactVertices() noexcept
+{
+    if (g_renderer != nullptr) return g_renderer->getCompactVertices();
+    return false;
+}
+
+void SetOptimizeMeshes(bool optimize) noexcept
+{
+    if (g_renderer != nullptr) g_renderer->setOptimizeMeshes(optimize);
+}
+
+bool GetOptimizeMeshes() noexcept
+{
+    if (g_renderer != nullptr) return g_renderer->getOptimizeMeshes();
+    return false;
+}
+
+void SetSceneCacheEnabled(bool enable) noexcept
+{
+    if (g_renderer != nullptr) g_renderer->setSceneCacheEnabled(enable);
+}
+
+bool GetSceneCacheHit() noexcept
+{
+    if (g_renderer != nullptr) return g_renderer->getSceneCacheHit();
+    return false;
+}
+
+double GetSceneLoadTime() noexcept
+{
+    if (g_renderer != nullptr) return g_renderer->getSceneLoadTime();
+    return 0.0;
+}
+
+void SetTextureUploadBudget(uint32_t megabytes) noexcept
+{
+    if (g_renderer != nullptr) g_renderer->setTextureUploadBudget(megabytes);
+}
+
+bool SetTextureMipFilter(std::string_view const &filter) noexcept
+{
+    if (g_renderer != nullptr) return g_renderer->setTextureMipFilter(filter);
+    return false;
+}
+
+uint32_t GetPendingTextureCount() noexcept
+{
+    if (g_renderer != nullptr) return g_renderer->getPendingTextureCount();
+    return 0;
+}
+
+void SetAnimationSampleRate(float rate) noexcept
+{
+    if (g_renderer != nullptr) g_renderer->setAnimationSampleRate(rate);
+}
+
+void SetTransientAliasing(bool enable) noexcept
+{
+    if (g_renderer != nullptr) g_renderer->setTransientAliasing(enable);
+}
+
+void StartGfxRecording() noexcept
+{
+    GfxRecorder::Start();
+}
+
+bool StopGfxRecording(char const *file_path) noexcept
+{
+    GfxRecorder::Stop();
+    if (file_path == nullptr) return true;
+    return GfxRecorder::Write(file_path, true);
+}
+
+void StartCpuProfiling() noexcept
+{
+    CpuProfiler::Start();
+}
+
+bool StopCpuProfiling(char const *file_path) noexcept
+{
+    CpuProfiler::Stop();
+    if (file_path == nullptr) return true;
+    return CpuProfiler::Write(file_path);
+}
+
+void StartTimingStatistics(uint32_t first_frame) noexcept
+{
+    if (g_renderer != nullptr) g_renderer->startTimingStatistics(first_frame);
+}
+
+std::vector<TimingSummary> GetTimingStatistics() noexcept
+{
+    if (g_renderer != nullptr) return g_renderer->getTimingStatistics();
+    return {};
+}
+
+bool StopTimingStatistics(char const *file_path) noexcept
+{
+    if (g_renderer != nullptr) return g_renderer->stopTimingStatistics(file_path);
+    return false;
+}
+
 std::vector<std::string_view> GetSceneCameras() noexcept
 {
     if (g_renderer != nullptr) return g_renderer->getSceneCameras();
@@ -253,6 +365,34 @@ void StepJitterFrameIndex(uint32_t frames)
     if (g_renderer != nullptr) g_renderer->stepJitterFrameIndex(frames);
 }
 
+bool StartCameraRecording(char const *file_path) noexcept
+{
+    if (g_renderer != nullptr) return g_renderer->startCameraRecording(file_path);
+    return false;
+}
+
+void StopCameraRecording() noexcept
+{
+    if (g_renderer != nullptr) g_renderer->stopCameraRecording();
+}
+
+bool StartCameraReplay(char const *file_path) noexcept
+{
+    if (g_renderer != nullptr) return g_renderer->startCameraReplay(file_path);
+    return false;
+}
+
+void StopCameraReplay() noexcept
+{
+    if (g_renderer != nullptr) g_renderer->stopCameraReplay();
+}
+
+bool IsCameraReplaying() noexcept
+{
+    if (g_renderer != nullptr) return g_renderer->isCameraReplaying();
+    return false;
+}
+
 uint32_t GetDeltaLightCount() noexcept
 {
     if (g_renderer != nullptr) return g_renderer->getDeltaLightCount();
@@ -312,4 +452,55 @@ void DumpCamera(char const *file_path, bool jittered) noexcept
     if (g_renderer != nullptr) g_renderer->dumpCamera(file_path, jittered);
 }
 
+bool SetDumpFormat(std::string_view const &compression, bool half) noexcept
+{
+    if (g_renderer == nullptr) return false;
+    if (compression == "None")
+    {
+        g_renderer->setDumpExrFormat(ImageCompression::None, half);
+    }
+    else if (compression == "ZIP")
+    {
+        g_renderer->setDumpExrFormat(ImageCompression::ZIP, half);
+    }
+    else if (compression == "PIZ")
+    {
+        g_renderer->setDumpExrFormat(ImageCompression::PIZ, half);
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+uint32_t GetDumpQueueDepth() noexcept
+{
+    if (g_renderer != nullptr) return g_renderer->getDumpStats().queue_depth;
+    return 0;
+}
+
+double GetDumpBytesPerSecond() noexcept
+{
+    if (g_renderer != nullptr) return g_renderer->getDumpStats().bytes_per_second;
+    return 0.0;
+}
+
+void StartFrameCapture(char const *file_path, std::string_view const &aov, uint32_t first_frame,
+    uint32_t frame_count, bool half) noexcept
+{
+    if (g_renderer != nullptr) g_renderer->startFrameCapture(file_path, aov, first_frame, frame_count, half);
+}
+
+void StopFrameCapture() noexcept
+{
+    if (g_renderer != nullptr) g_renderer->stopFrameCapture();
+}
+
+uint32_t GetCapturedFrameCount() noexcept
+{
+    if (g_renderer != nullptr) return g_renderer->getCapturedFrameCount();
+    return 0;
+}
+
 } // namespace Capsaicin
@@ -23,19 +23,37 @@ THE SOFTWARE.
 
 #include "common_functions.inl"
 #include "components/light_builder/light_builder.h"
-#include "hash_reduce.h"
 #include "render_technique.h"
 #include "thread_pool.h"
 
 #define _USE_MATH_DEFINES
+#include <cfloat>
 #include <chrono>
 #include <filesystem>
+#include <format>
 #include <gfx_imgui.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <math.h>
 
 namespace Capsaicin
 {
+namespace
+{
+/** Render graph key of buffers, or'ed with their size so that only buffers of the same size share memory */
+constexpr uint64_t kBufferResourceKey = 1ULL << 63;
+
+template<typename ACCESS>
+RenderGraphPlanner::Access GetRenderGraphAccess(ACCESS access) noexcept
+{
+    switch (access)
+    {
+    case ACCESS::Read: return RenderGraphPlanner::Access::Read;
+    case ACCESS::Write: return RenderGraphPlanner::Access::Write;
+    default: return RenderGraphPlanner::Access::ReadWrite;
+    }
+}
+} // unnamed namespace
+
 CapsaicinInternal::CapsaicinInternal() {}
 
 CapsaicinInternal::~CapsaicinInternal()
@@ -184,6 +202,104 @@ void CapsaicinInternal::stepJitterFrameIndex(uint32_t frames) noexcept
     }
 }
 
+bool CapsaicinInternal::startCameraRecording(char const *file_path) noexcept
+{
+    return camera_recording_.open(file_path);
+}
+
+void CapsaicinInternal::stopCameraRecording() noexcept
+{
+    camera_recording_.close();
+}
+
+bool CapsaicinInternal::startCameraReplay(char const *file_path) noexcept
+{
+    camera_replay_mismatches_ = 0;
+    return camera_replay_.open(file_path);
+}
+
+void CapsaicinInternal::stopCameraReplay() noexcept
+{
+    if (camera_replay_.isOpen() && camera_replay_mismatches_ > 0)
+    {
+        GFX_PRINTLN("Warning: %u replayed frames differ from the recorded play time or jitter (recorded without a "
+                    "fixed frame rate?)",
+            camera_replay_mismatches_);
+    }
+    camera_replay_.close();
+}
+
+bool CapsaicinInternal::isCameraReplaying() const noexcept
+{
+    return camera_replay_.isOpen();
+}
+
+void CapsaicinInternal::startTimingStatistics(uint32_t first_frame) noexcept
+{
+    timing_statistics_.clear();
+    timing_statistics_enabled_     = true;
+    timing_statistics_first_frame_ = first_frame;
+}
+
+std::vector<TimingSummary> CapsaicinInternal::getTimingStatistics() const noexcept
+{
+    return timing_statistics_.getSummaries();
+}
+
+bool CapsaicinInternal::stopTimingStatistics(char const *file_path) noexcept
+{
+    timing_statistics_enabled_ = false;
+    bool const result          = file_path == nullptr || timing_statistics_.write(file_path, "ms");
+    timing_statistics_.clear();
+    return result;
+}
+
+CameraKeyframe const *CapsaicinInternal::replayCamera() noexcept
+{
+    CameraKeyframe const *keyframe = camera_replay_.find(frame_index_);
+    if (keyframe != nullptr)
+    {
+        GfxRef<GfxCamera> camera = gfxSceneGetActiveCamera(scene_);
+        camera->eye              = keyframe->eye;
+        camera->center           = keyframe->center;
+        camera->up               = keyframe->up;
+        camera->fovY             = keyframe->fov_y;
+        camera->aspect           = keyframe->aspect;
+    }
+    return keyframe;
+}
+
+void CapsaicinInternal::recordCamera(CameraKeyframe const *replayed_keyframe) noexcept
+{
+    if (camera_recording_.isOpen() || replayed_keyframe != nullptr)
+    {
+        auto const    &camera = getCamera();
+        CameraKeyframe keyframe;
+        keyframe.frame_index = frame_index_;
+        keyframe.fov_y       = camera.fovY;
+        keyframe.play_time   = play_time_;
+        keyframe.eye         = camera.eye;
+        keyframe.center      = camera.center;
+        keyframe.up          = camera.up;
+        keyframe.aspect      = camera.aspect;
+        keyframe.jitter_x    = camera_jitter_x_;
+        keyframe.jitter_y    = camera_jitter_y_;
+        camera_recording_.write(keyframe);
+
+        // Replays are expected to be bit for bit identical to the recording
+        if (replayed_keyframe != nullptr
+            && (keyframe.play_time != replayed_keyframe->play_time || keyframe.jitter_x != replayed_keyframe->jitter_x
+                || keyframe.jitter_y != replayed_keyframe->jitter_y))
+        {
+            ++camera_replay_mismatches_;
+        }
+    }
+    if (camera_replay_.isOpen() && frame_index_ >= camera_replay_.getLastFrameIndex())
+    {
+        stopCameraReplay();
+    }
+}
+
 bool CapsaicinInternal::getMeshesUpdated() const noexcept
 {
     return mesh_updated_;
@@ -194,6 +310,31 @@ bool CapsaicinInternal::getTransformsUpdated() const noexcept
     return transform_updated_;
 }
 
+bool CapsaicinInternal::getTexturesUpdated() const noexcept
+{
+    return textures_updated_;
+}
+
+SceneChangeTracker const &CapsaicinInternal::getSceneChanges() const noexcept
+{
+    return scene_changes_;
+}
+
+void CapsaicinInternal::markMeshChanged(uint32_t mesh_index) noexcept
+{
+    pending_mesh_changes_.push_back(mesh_index);
+}
+
+void CapsaicinInternal::markMaterialChanged(uint32_t material_index) noexcept
+{
+    pending_material_changes_.push_back(material_index);
+}
+
+void CapsaicinInternal::markImageChanged(uint32_t image_index) noexcept
+{
+    pending_image_changes_.push_back(image_index);
+}
+
 bool CapsaicinInternal::getSceneUpdated() const noexcept
 {
     return scene_updated_;
@@ -341,6 +482,7 @@ bool CapsaicinInternal::setScenes(std::vector<std::string> const &names) noexcep
         // Remove environment map as its tied to scene
         setEnvironmentMap("");
         setDebugView("None");
+        destroyScene();
         gfxDestroyScene(scene_);
         scene_       = {};
         scene_files_ = {};
@@ -359,6 +501,27 @@ bool CapsaicinInternal::setScenes(std::vector<std::string> const &names) noexcep
         }
     }
     scene_updated_ = true;
+    scene_changes_.reset();
+    scene_cache_.close();
+    texture_streamer_.terminate();
+    texture_upload_bytes_ = 0;
+    if (texture_upload_budget_ > 0
+        && !texture_streamer_.initialize(gfx_, (uint64_t)texture_upload_budget_ << 20, texture_mip_filter_))
+    {
+        GFX_PRINTLN("Warning: Failed to initialise texture streaming, textures will be uploaded during load");
+    }
+    instance_snapshots_.clear();
+    light_snapshots_.clear();
+    pending_mesh_changes_.clear();
+    pending_material_changes_.clear();
+    pending_image_changes_.clear();
+    animation_evaluator_.clear();
+    unbaked_animations_.clear();
+    animated_instances_.clear();
+    animated_lights_.clear();
+    vertex_layout_compact_ = compact_vertices_;
+    mesh_optimization_     = optimize_meshes_;
+    optimized_mesh_cache_.clear();
     // Create new blank scene
     scene_ = gfxCreateScene();
     if (!scene_)
@@ -381,6 +544,7 @@ bool CapsaicinInternal::setScenes(std::vector<std::string> const &names) noexcep
     gfxSceneSetCameraMetadata(scene_, gfxSceneGetCameraHandle(scene_, 0), userCameraMeta);
 
     // Load in scene based on current requested scene index
+    auto const import_start = std::chrono::high_resolution_clock::now();
     for (auto const &name : names)
     {
         if (gfxSceneImport(scene_, name.c_str()) != kGfxResult_NoError)
@@ -394,6 +558,24 @@ bool CapsaicinInternal::setScenes(std::vector<std::string> const &names) noexcep
 
     scene_files_ = names;
 
+    if (mesh_optimization_)
+    {
+        // Reuse the meshes optimized by a previous load of the scene
+        std::string const cache_path = getOptimizedMeshCachePath();
+        if (LoadOptimizedMeshCache(optimized_mesh_cache_, cache_path.c_str()))
+        {
+            GFX_PRINTLN("Loaded %zu optimized meshes from '%s'", optimized_mesh_cache_.size(), cache_path.c_str());
+        }
+    }
+
+    // Map the flattened scene data if it was cached by a previous load
+    openSceneCache();
+    scene_import_time_ =
+        std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - import_start).count();
+
+    // Sample the animations so that they can be evaluated without going through gfx
+    bakeAnimations();
+
     // Set up camera based on internal scene data
     uint32_t       cameraIndex = 0;
     const uint32_t cameraCount = gfxSceneGetCameraCount(scene_);
@@ -469,6 +651,7 @@ bool CapsaicinInternal::setScenes(std::vector<std::string> const &names) noexcep
         // Reset flags as everything just got forced reset anyway
         mesh_updated_            = false;
         transform_updated_       = false;
+        textures_updated_        = false;
         environment_map_updated_ = false;
         scene_updated_           = false;
         camera_updated_          = false;
@@ -685,6 +868,11 @@ RenderOptionList &CapsaicinInternal::getOptions() noexcept
     return options_;
 }
 
+RenderOptionRegistry const &CapsaicinInternal::getOptionRegistry() const noexcept
+{
+    return option_registry_;
+}
+
 glm::vec4 CapsaicinInternal::getInvDeviceZ() const
 {
     return glm::vec4(0.0f); // this is only here for compatibility with UE5
@@ -714,7 +902,7 @@ CameraMatrices const &CapsaicinInternal::getCameraMatrices(bool jittered) const
 
 GfxBuffer CapsaicinInternal::getCameraMatricesBuffer(bool jittered) const
 {
-    return camera_matrices_buffer_[jittered];
+    return camera_matrices_buffer_[gfxGetBackBufferIndex(gfx_)][jittered];
 }
 
 uint32_t CapsaicinInternal::getDeltaLightCount() const noexcept
@@ -761,6 +949,145 @@ uint64_t CapsaicinInternal::getBvhDataSize() const noexcept
     return bvh_data_size;
 }
 
+uint64_t CapsaicinInternal::getSceneUploadBytes() const noexcept
+{
+    return scene_upload_bytes_;
+}
+
+double CapsaicinInternal::getSceneFlattenRate() const noexcept
+{
+    return scene_flatten_rate_;
+}
+
+void CapsaicinInternal::setTransientAliasing(bool enable) noexcept
+{
+    transient_aliasing_ = enable;
+}
+
+RenderGraphPlanner const &CapsaicinInternal::getRenderGraph() const noexcept
+{
+    return render_graph_;
+}
+
+void CapsaicinInternal::setCompactVertices(bool compact) noexcept
+{
+    compact_vertices_ = compact;
+}
+
+bool CapsaicinInternal::getCompactVertices() const noexcept
+{
+    return vertex_layout_compact_;
+}
+
+void CapsaicinInternal::setOptimizeMeshes(bool optimize) noexcept
+{
+    optimize_meshes_ = optimize;
+}
+
+bool CapsaicinInternal::getOptimizeMeshes() const noexcept
+{
+    return mesh_optimization_;
+}
+
+OptimizedMesh const *CapsaicinInternal::getOptimizedMesh(uint32_t mesh_index) const noexcept
+{
+    return mesh_index < mesh_optimizations_.size() ? mesh_optimizations_[mesh_index] : nullptr;
+}
+
+void CapsaicinInternal::getMeshOptimizationStats(MeshStats &before, MeshStats &after) const noexcept
+{
+    before              = {};
+    after               = {};
+    double   weights[4] = {};
+    uint64_t triangles  = 0;
+    for (uint32_t i = 0; i < gfxSceneGetObjectCount<GfxMesh>(scene_); ++i)
+    {
+        OptimizedMesh const *optimized = getOptimizedMesh(gfxSceneGetObjectHandle<GfxMesh>(scene_, i));
+        if (optimized == nullptr)
+        {
+            continue;
+        }
+        uint64_t const triangle_count = optimized->indices.size() / 3;
+        before.vertex_count += optimized->before.vertex_count;
+        after.vertex_count += optimized->after.vertex_count;
+        weights[0] += (double)optimized->before.acmr * triangle_count;
+        weights[1] += (double)optimized->after.acmr * triangle_count;
+        weights[2] += (double)optimized->before.overfetch * triangle_count;
+        weights[3] += (double)optimized->after.overfetch * triangle_count;
+        triangles += triangle_count;
+    }
+    if (triangles > 0)
+    {
+        before.acmr      = (float)(weights[0] / triangles);
+        after.acmr       = (float)(weights[1] / triangles);
+        before.overfetch = (float)(weights[2] / triangles);
+        after.overfetch  = (float)(weights[3] / triangles);
+    }
+}
+
+void CapsaicinInternal::setSceneCacheEnabled(bool enable) noexcept
+{
+    scene_cache_enabled_ = enable;
+}
+
+bool CapsaicinInternal::getSceneCacheHit() const noexcept
+{
+    return scene_cache_hit_;
+}
+
+double CapsaicinInternal::getSceneLoadTime() const noexcept
+{
+    return scene_import_time_ + scene_build_time_;
+}
+
+void CapsaicinInternal::setTextureUploadBudget(uint32_t megabytes) noexcept
+{
+    texture_upload_budget_ = megabytes;
+}
+
+bool CapsaicinInternal::setTextureMipFilter(std::string_view const &filter) noexcept
+{
+    if (filter == "Box")
+    {
+        texture_mip_filter_ = MipFilter::Box;
+    }
+    else if (filter == "Kaiser")
+    {
+        texture_mip_filter_ = MipFilter::Kaiser;
+    }
+    else
+    {
+        GFX_PRINTLN("Error: Unknown texture mip filter: %s", filter.data());
+        return false;
+    }
+    return true;
+}
+
+uint32_t CapsaicinInternal::getPendingTextureCount() const noexcept
+{
+    return texture_streamer_.getPendingCount();
+}
+
+void CapsaicinInternal::setAnimationSampleRate(float rate) noexcept
+{
+    animation_sample_rate_ = glm::max(rate, 0.0f);
+}
+
+uint64_t CapsaicinInternal::getVertexDataSize() const noexcept
+{
+    return vertex_data_.size() * (vertex_layout_compact_ ? sizeof(CompactVertex) : sizeof(Vertex));
+}
+
+std::vector<std::string> CapsaicinInternal::getSceneShaderDefines() const noexcept
+{
+    std::vector<std::string> defines;
+    if (vertex_layout_compact_)
+    {
+        defines.push_back("COMPACT_VERTEX");
+    }
+    return defines;
+}
+
 GfxBuffer CapsaicinInternal::getInstanceBuffer() const
 {
     return instance_buffer_;
@@ -932,31 +1259,40 @@ std::pair<float3, float3> CapsaicinInternal::getSceneBounds() const
 
 GfxBuffer CapsaicinInternal::allocateConstantBuffer(uint64_t size)
 {
-    GfxBuffer     &constant_buffer_pool        = constant_buffer_pools_[gfxGetBackBufferIndex(gfx_)];
-    uint64_t const constant_buffer_pool_cursor = GFX_ALIGN(constant_buffer_pool_cursor_ + size, 256);
-
-    if (constant_buffer_pool_cursor >= constant_buffer_pool.getSize())
+    GfxRecorder::Record(GfxCallType::Upload, size);
+    FrameAllocation allocation;
+    if (!constant_buffer_allocator_.allocate(size, allocation))
     {
-        gfxDestroyBuffer(gfx_, constant_buffer_pool);
-
-        uint64_t constant_buffer_pool_size = constant_buffer_pool_cursor;
-        constant_buffer_pool_size += ((constant_buffer_pool_size + 2) >> 1);
-        constant_buffer_pool_size = GFX_ALIGN(constant_buffer_pool_size, 65536);
-
-        constant_buffer_pool = gfxCreateBuffer(gfx_, constant_buffer_pool_size, nullptr, kGfxCpuAccess_Write);
-
-        char buffer[256];
-        GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_ConstantBufferPool%u", gfxGetBackBufferIndex(gfx_));
-
-        constant_buffer_pool.setName(buffer);
+        // The pool is only resized when its frame comes round again, until then overflowing data gets its own buffer
+        return gfxCreateBuffer(gfx_, size, nullptr, kGfxCpuAccess_Write);
     }
+    return gfxCreateBufferRange(
+        gfx_, constant_buffer_pools_[constant_buffer_allocator_.getFrameIndex()], allocation.offset, size);
+}
 
-    GfxBuffer constant_buffer =
-        gfxCreateBufferRange(gfx_, constant_buffer_pool, constant_buffer_pool_cursor_, size);
-
-    constant_buffer_pool_cursor_ = constant_buffer_pool_cursor;
+CapsaicinInternal::UploadAllocation CapsaicinInternal::allocateUploadMemory(uint64_t size)
+{
+    uint32_t const   frame_index = constant_buffer_allocator_.getFrameIndex();
+    FrameAllocation  allocation;
+    UploadAllocation upload;
+    GfxRecorder::Record(GfxCallType::Upload, size);
+    if (constant_buffer_allocator_.allocate(size, allocation))
+    {
+        upload.buffer = constant_buffer_pools_[frame_index];
+        upload.offset = allocation.offset;
+    }
+    else
+    {
+        upload.buffer = gfxCreateBuffer(gfx_, size, nullptr, kGfxCpuAccess_Write);
+        constant_buffer_overflows_[frame_index].push_back(upload.buffer);
+    }
+    upload.data = (uint8_t *)gfxBufferGetData(gfx_, upload.buffer) + upload.offset;
+    return upload;
+}
 
-    return constant_buffer;
+FrameAllocatorStats const &CapsaicinInternal::getConstantBufferStats() const noexcept
+{
+    return constant_buffer_allocator_.getFrameStats();
 }
 
 void CapsaicinInternal::initialize(GfxContext gfx, ImGuiContext *imgui_context)
@@ -979,6 +1315,9 @@ void CapsaicinInternal::initialize(GfxContext gfx, ImGuiContext *imgui_context)
         anisotropic_sampler_ = gfxCreateSamplerState(
             gfx, D3D12_FILTER_ANISOTROPIC, D3D12_TEXTURE_ADDRESS_MODE_WRAP, D3D12_TEXTURE_ADDRESS_MODE_WRAP);
     }
+    constant_buffer_allocator_.initialize(kGfxConstant_BackBufferCount, 256, 65536);
+    dirty_transform_sort_.initialise(CPUSort::Type::UInt, CPUSort::Operation::Ascending);
+
     shader_path_ = "src/core/src/";
     // Check if shader source can be found
     std::error_code ec;
@@ -1042,10 +1381,18 @@ void CapsaicinInternal::initialize(GfxContext gfx, ImGuiContext *imgui_context)
     ImGui::SetCurrentContext(imgui_context);
 
     gfx_ = gfx;
+
+    if (!image_writer_.initialize(gfx_))
+    {
+        GFX_PRINTLN("Warning: Failed to initialise the image writer, dumped buffers won't be saved");
+    }
 }
 
 void CapsaicinInternal::render()
 {
+    GfxRecorder::BeginFrame(frame_index_);
+    CpuProfiler::BeginFrame(frame_index_);
+
     // Update current frame time
     auto const previousTime = current_time_;
     auto       wallTime     = std::chrono::duration_cast<std::chrono::microseconds>(
@@ -1056,24 +1403,72 @@ void CapsaicinInternal::render()
     // Check if manual frame increment/decrement has been applied
     bool manual_play = play_time_ != play_time_old_;
 
+    // Pick up the render options changed directly through the options list (e.g., by the UI)
+    option_registry_.sync();
+
+    // Recycle the upload memory of the frame being recorded as the GPU is done with it, resizing it from recent use
+    {
+        uint32_t const frame_index = gfxGetBackBufferIndex(gfx_);
+        uint64_t const pool_size   = constant_buffer_allocator_.beginFrame(frame_index);
+        GfxBuffer     &pool        = constant_buffer_pools_[frame_index];
+        if (pool.getSize() != pool_size)
+        {
+            gfxDestroyBuffer(gfx_, pool);
+            pool = gfxCreateBuffer(gfx_, pool_size, nullptr, kGfxCpuAccess_Write);
+
+            char buffer[256];
+            GFX_SNPRINTF(buffer, sizeof(buffer), "Capsaicin_ConstantBufferPool%u", frame_index);
+            pool.setName(buffer);
+        }
+        for (GfxBuffer const &overflow_buffer : constant_buffer_overflows_[frame_index])
+        {
+            gfxDestroyBuffer(gfx_, overflow_buffer);
+        }
+        constant_buffer_overflows_[frame_index].clear();
+    }
+
     if (!render_paused_ || manual_play || frame_index_ == 0)
     {
         // Reset update flags
         mesh_updated_      = false;
         transform_updated_ = false;
+        textures_updated_  = false;
 
         frameGraph.addValue(static_cast<float>(frame_time_));
+        bool const collect_timings = timing_statistics_enabled_ && frame_index_ >= timing_statistics_first_frame_;
+        if (collect_timings)
+        {
+            timing_statistics_.addSample("CPU Frame", frame_time_ * 1000.0);
+        }
 
-        constant_buffer_pool_cursor_ = 0;
         was_resized_ =
             (buffer_width_ != gfxGetBackBufferWidth(gfx_) || buffer_height_ != gfxGetBackBufferHeight(gfx_));
         buffer_width_  = gfxGetBackBufferWidth(gfx_);
         buffer_height_ = gfxGetBackBufferHeight(gfx_);
 
+        // Apply the edits reported since the last frame, the tracker only keeps the current frame's changes
+        scene_changes_.beginFrame();
+        for (uint32_t mesh_index : pending_mesh_changes_)
+        {
+            scene_changes_.markChanged(SceneChangeTracker::ObjectType::Mesh, mesh_index);
+        }
+        for (uint32_t material_index : pending_material_changes_)
+        {
+            scene_changes_.markChanged(SceneChangeTracker::ObjectType::Material, material_index);
+        }
+        for (uint32_t image_index : pending_image_changes_)
+        {
+            scene_changes_.markChanged(SceneChangeTracker::ObjectType::Image, image_index);
+        }
+        pending_mesh_changes_.clear();
+        pending_material_changes_.clear();
+        pending_image_changes_.clear();
+
         // Run the animations
         bool animation = false;
         if (!play_paused_ || manual_play)
         {
+            CAPSAICIN_PROFILE_SCOPE("Animate");
             if (!play_paused_)
             {
                 if (play_fixed_framerate_)
@@ -1085,10 +1480,10 @@ void CapsaicinInternal::render()
                     play_time_ += frame_time_ * play_speed_ * (!play_rewind_ ? 1.0 : -1.0);
                 }
             }
-            play_time_old_                 = play_time_;
-            uint32_t const animation_count = gfxSceneGetAnimationCount(scene_);
-            animation                      = animation_count > 0;
-            for (uint32_t animation_index = 0; animation_index < animation_count; ++animation_index)
+            play_time_old_ = play_time_;
+            animation      = gfxSceneGetAnimationCount(scene_) > 0;
+            applyBakedAnimations();
+            for (uint32_t animation_index : unbaked_animations_)
             {
                 GfxConstRef<GfxAnimation> animation_ref = gfxSceneGetAnimationHandle(scene_, animation_index);
                 float const animation_length            = gfxSceneGetAnimationLength(scene_, animation_ref);
@@ -1100,7 +1495,14 @@ void CapsaicinInternal::render()
             }
         }
 
+        // Find the scene objects that were changed (by loading or animation), baked animations record their own
+        if (frame_index_ == 0 || (animation && !unbaked_animations_.empty()))
+        {
+            detectSceneChanges(frame_index_ == 0);
+        }
+
         // Calculate the camera matrices for this frame
+        CameraKeyframe const *replayed_keyframe = replayCamera();
         {
             uint32_t const jitter_index = jitter_frame_index_ != ~0 ? jitter_frame_index_ : frame_index_;
 
@@ -1138,32 +1540,23 @@ void CapsaicinInternal::render()
 
                 // Update camera matrices
                 {
-                    gfxDestroyBuffer(gfx_, camera_matrices_buffer_[i]);
-                    camera_matrices_buffer_[i] = allocateConstantBuffer<CameraMatrices>(1);
-                    memcpy(gfxBufferGetData(gfx_, camera_matrices_buffer_[i]), &camera_matrices_[i],
+                    GfxBuffer &camera_matrices_buffer = camera_matrices_buffer_[gfxGetBackBufferIndex(gfx_)][i];
+                    if (!camera_matrices_buffer)
+                    {
+                        camera_matrices_buffer =
+                            gfxCreateBuffer<CameraMatrices>(gfx_, 1, nullptr, kGfxCpuAccess_Write);
+                        camera_matrices_buffer.setName("Capsaicin_CameraMatricesBuffer");
+                    }
+                    memcpy(gfxBufferGetData(gfx_, camera_matrices_buffer), &camera_matrices_[i],
                         sizeof(camera_matrices_[i]));
                 }
             }
         }
 
-        // Update the scene history
-        {
-            for (size_t i = 0; i < prev_transform_data_.size(); ++i)
-            {
-                prev_transform_data_[i] = transform_data_[i];
-            }
+        recordCamera(replayed_keyframe);
 
-            if (!prev_transform_data_.empty())
-            {
-                GfxCommandEvent const command_event(gfx_, "UpdatePreviousTranforms");
-                GfxBuffer             prev_transform_buffer =
-                    allocateConstantBuffer<glm::mat4x3>((uint32_t)prev_transform_data_.size());
-                memcpy(gfxBufferGetData(gfx_, prev_transform_buffer), prev_transform_data_.data(),
-                    prev_transform_data_.size() * sizeof(glm::mat4x3));
-                gfxCommandCopyBuffer(gfx_, prev_transform_buffer_, prev_transform_buffer);
-                gfxDestroyBuffer(gfx_, prev_transform_buffer);
-            }
-        }
+        // Update the scene history
+        updateTransformHistory();
 
         // Update the AOV history
         {
@@ -1201,332 +1594,49 @@ void CapsaicinInternal::render()
         }
 
         // Check whether we need to re-build our acceleration structure
-        size_t mesh_hash = mesh_hash_;
-        if (frame_index_ == 0 || animation)
-            mesh_hash =
-                HashReduce(gfxSceneGetObjects<GfxMesh>(scene_), gfxSceneGetObjectCount<GfxMesh>(scene_));
-
-        if (mesh_hash != mesh_hash_)
+        bool scene_rebuilt = false;
+        if (scene_changes_.hasChanges(SceneChangeTracker::ObjectType::Mesh)
+            || scene_changes_.hasChanges(SceneChangeTracker::ObjectType::Material)
+            || scene_changes_.hasChanges(SceneChangeTracker::ObjectType::Instance)
+            || scene_changes_.hasChanges(SceneChangeTracker::ObjectType::Image))
         {
             GfxCommandEvent const command_event(gfx_, "BuildScene");
             mesh_updated_ = true;
 
-            mesh_data_.clear();
-            index_data_.clear();
-            vertex_data_.clear();
-            instance_data_.clear();
-            material_data_.clear();
-            transform_data_.clear();
-
-            gfxDestroyBuffer(gfx_, mesh_buffer_);
-            gfxDestroyBuffer(gfx_, index_buffer_);
-            gfxDestroyBuffer(gfx_, vertex_buffer_);
-            gfxDestroyBuffer(gfx_, instance_buffer_);
-            gfxDestroyBuffer(gfx_, material_buffer_);
-            gfxDestroyBuffer(gfx_, transform_buffer_);
-
-            for (GfxTexture const &texture : texture_atlas_)
-            {
-                gfxDestroyTexture(gfx_, texture);
-            }
-
-            texture_atlas_.clear();
-            raytracing_primitives_.clear();
-
-            gfxDestroyAccelerationStructure(gfx_, acceleration_structure_);
-
-            GfxMaterial const *materials      = gfxSceneGetObjects<GfxMaterial>(scene_);
-            uint32_t const     material_count = gfxSceneGetObjectCount<GfxMaterial>(scene_);
-
-            for (uint32_t i = 0; i < material_count; ++i)
-            {
-                Material material = {};
-
-                material.albedo = float4(
-                    float3(materials[i].albedo), glm::uintBitsToFloat((uint32_t)materials[i].albedo_map));
-                material.emissivity = float4(
-                    materials[i].emissivity, glm::uintBitsToFloat((uint32_t)materials[i].emissivity_map));
-                material.metallicity_roughness = float4(materials[i].metallicity,
-                    glm::uintBitsToFloat((uint32_t)materials[i].metallicity_map), materials[i].roughness,
-                    glm::uintBitsToFloat((uint32_t)materials[i].roughness_map));
-                material.normal_alpha_side =
-                    float4(glm::uintBitsToFloat((uint32_t)materials[i].normal_map), materials[i].albedo.w,
-                        glm::uintBitsToFloat(
-                            (uint32_t)((materials[i].flags & kGfxMaterialFlag_DoubleSided) != 0)),
-                        0.0f);
-
-                uint32_t const material_index = gfxSceneGetObjectHandle<GfxMaterial>(scene_, i);
-
-                if (material_index >= material_data_.size())
-                {
-                    material_data_.resize((size_t)material_index + 1);
-                }
-
-                material_data_[material_index] = material;
-            }
-
-            material_buffer_ =
-                gfxCreateBuffer<Material>(gfx_, (uint32_t)material_data_.size(), material_data_.data());
-            material_buffer_.setName("Capsaicin_MaterialBuffer");
-
-            uint32_t const image_count = gfxSceneGetObjectCount<GfxImage>(scene_);
-
-            for (uint32_t i = 0; i < image_count; ++i)
-            {
-                GfxConstRef<GfxImage> image_ref = gfxSceneGetObjectHandle<GfxImage>(scene_, i);
-
-                uint32_t const image_index = (uint32_t)image_ref;
-
-                if (image_index >= texture_atlas_.size())
-                {
-                    texture_atlas_.resize((size_t)image_index + 1);
-                }
-
-                GfxTexture &texture = texture_atlas_[image_index];
-
-                DXGI_FORMAT    format         = image_ref->format;
-                uint32_t       image_width    = image_ref->width;
-                uint32_t       image_height   = image_ref->height;
-                uint32_t const image_mips     = gfxCalculateMipCount(image_width, image_height);
-                uint32_t const image_channels = image_ref->channel_count;
-
-                texture = gfxCreateTexture2D(gfx_, image_width, image_height, format, image_mips);
-                texture.setName(gfxSceneGetObjectMetadata<GfxImage>(scene_, image_ref).getObjectName());
-
-                if (!image_ref->width || !image_ref->height)
-                {
-                    gfxCommandClearTexture(gfx_, texture);
-                }
-                else
-                {
-                    uint8_t const *image_data = image_ref->data.data();
-
-                    const uint64_t uncompressed_size =
-                        (uint64_t)image_width * image_height * image_channels * image_ref->bytes_per_channel;
-                    uint64_t texture_size =
-                        !gfxImageIsFormatCompressed(*image_ref) ? uncompressed_size : image_ref->data.size();
-                    bool const mips = image_ref->flags & kGfxImageFlag_HasMipLevels;
-                    if (mips && !gfxImageIsFormatCompressed(*image_ref))
-                    {
-                        texture_size += texture_size / 3;
-                    }
-                    texture_size = GFX_MIN(texture_size, image_ref->data.size());
-                    GfxBuffer texture_data =
-                        gfxCreateBuffer(gfx_, texture_size, image_data, kGfxCpuAccess_Write);
-
-                    gfxCommandCopyBufferToTexture(gfx_, texture, texture_data);
-                    if (!mips && !gfxImageIsFormatCompressed(*image_ref))
-                        gfxCommandGenerateMips(gfx_, texture);
-                    gfxDestroyBuffer(gfx_, texture_data);
-                }
-            }
-            GfxMesh const *meshes     = gfxSceneGetObjects<GfxMesh>(scene_);
-            uint32_t const mesh_count = gfxSceneGetObjectCount<GfxMesh>(scene_);
-
-            for (uint32_t i = 0; i < mesh_count; ++i)
-            {
-                Mesh mesh = {};
-
-                mesh.vertex_offset_idx = (uint32_t)vertex_data_.size();
-                mesh.index_offset_idx  = (uint32_t)index_data_.size();
-                mesh.index_count       = (uint32_t)meshes[i].indices.size();
-
-                uint32_t const mesh_index = gfxSceneGetObjectHandle<GfxMesh>(scene_, i);
-
-                if (mesh_index >= mesh_data_.size())
-                {
-                    mesh_data_.resize((size_t)mesh_index + 1);
-                }
-
-                mesh_data_[mesh_index] = mesh;
-                for (size_t j = 0; j < meshes[i].indices.size(); ++j)
-                    index_data_.push_back(meshes[i].indices[j]);
-
-                for (size_t j = 0; j < meshes[i].vertices.size(); ++j)
-                {
-                    Vertex vertex = {};
-
-                    vertex.position = float4(meshes[i].vertices[j].position, 1.0f);
-                    vertex.normal   = float4(meshes[i].vertices[j].normal, 0.0f);
-                    vertex.uv       = float2(meshes[i].vertices[j].uv);
-
-                    vertex_data_.push_back(vertex);
-                }
-            }
-
-            mesh_buffer_  = gfxCreateBuffer<Mesh>(gfx_, (uint32_t)mesh_data_.size(), mesh_data_.data());
-            index_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, (uint32_t)index_data_.size(), index_data_.data());
-            vertex_buffer_ =
-                gfxCreateBuffer<Vertex>(gfx_, (uint32_t)vertex_data_.size(), vertex_data_.data());
-
-            mesh_buffer_.setName("Capsaicin_MeshBuffer");
-            index_buffer_.setName("Capsaicin_IndexBuffer");
-            vertex_buffer_.setName("Capsaicin_VertexBuffer");
-
-            // NVIDIA-specific fix
-            if (gfx_.getVendorId() == 0x10DEu) // NVIDIA
-            {
-                vertex_buffer_.setStride(4);
-            }
-
-            acceleration_structure_ = gfxCreateAccelerationStructure(gfx_);
-            acceleration_structure_.setName("Capsaicin_AccelerationStructure");
-
-            GfxInstance const *instances      = gfxSceneGetObjects<GfxInstance>(scene_);
-            uint32_t const     instance_count = gfxSceneGetObjectCount<GfxInstance>(scene_);
-
-            for (uint32_t i = 0; i < instance_count; ++i)
-            {
-                Instance instance = {};
-
-                GfxConstRef<GfxMesh>     mesh_ref     = instances[i].mesh;
-                GfxConstRef<GfxMaterial> material_ref = instances[i].material;
-
-                uint32_t const instance_index = gfxSceneGetObjectHandle<GfxInstance>(scene_, i);
-
-                instance.mesh_index      = (uint32_t)mesh_ref;
-                instance.material_index  = (uint32_t)material_ref;
-                instance.transform_index = instance_index;
-
-                if (instance_index >= instance_data_.size())
-                {
-                    instance_data_.resize((size_t)instance_index + 1);
-
-                    instance_min_bounds_.resize((size_t)instance_index + 1);
-                    instance_max_bounds_.resize((size_t)instance_index + 1);
-                }
-
-                instance_data_[instance_index] = instance;
-
-                if (instance.transform_index >= transform_data_.size())
-                {
-                    transform_data_.resize((size_t)instance.transform_index + 1);
-                }
-
-                transform_data_[instance.transform_index] = instances[i].transform;
-
-                Mesh const &mesh = mesh_data_[(uint32_t)mesh_ref];
-
-                uint32_t const index_count  = (uint32_t)mesh_ref->indices.size();
-                uint32_t const vertex_count = (uint32_t)mesh_ref->vertices.size();
-
-                if (instance_index >= raytracing_primitives_.size())
-                {
-                    raytracing_primitives_.resize((size_t)instance_index + 1);
-                }
-
-                GfxRaytracingPrimitive &rt_mesh = raytracing_primitives_[instance_index];
-
-                rt_mesh = gfxCreateRaytracingPrimitive(gfx_, acceleration_structure_);
-
-                GfxBuffer index_buffer =
-                    gfxCreateBufferRange<uint32_t>(gfx_, index_buffer_, mesh.index_offset_idx, index_count);
-                GfxBuffer vertex_buffer =
-                    gfxCreateBufferRange<Vertex>(gfx_, vertex_buffer_, mesh.vertex_offset_idx, vertex_count);
-
-                uint32_t non_opaque =
-                    !material_ref
-                            || (material_ref->albedo.w >= 1.0f
-                                && (!material_ref->albedo_map
-                                    || (material_ref->albedo_map->flags & kGfxImageFlag_HasAlphaChannel)
-                                           == 0))
-                        ? kGfxBuildRaytracingPrimitiveFlag_Opaque
-                        : 0;
-
-                gfxRaytracingPrimitiveBuild(gfx_, rt_mesh, index_buffer, vertex_buffer, 0, non_opaque);
-
-                glm::mat4 const row_major_transform = glm::transpose(instances[i].transform);
-
-                gfxRaytracingPrimitiveSetTransform(gfx_, rt_mesh, &row_major_transform[0][0]);
-                gfxRaytracingPrimitiveSetInstanceID(gfx_, rt_mesh, instance_index);
-                gfxRaytracingPrimitiveSetInstanceContributionToHitGroupIndex(
-                    gfx_, rt_mesh, instance_index * sbt_stride_in_entries_[kGfxShaderGroupType_Hit]);
-
-                gfxDestroyBuffer(gfx_, index_buffer);
-                gfxDestroyBuffer(gfx_, vertex_buffer);
-            }
-
-            instance_buffer_ =
-                gfxCreateBuffer<Instance>(gfx_, (uint32_t)instance_data_.size(), instance_data_.data());
-            instance_buffer_.setName("Capsaicin_InstanceBuffer");
-
-            transform_buffer_ =
-                gfxCreateBuffer<glm::mat4x3>(gfx_, (uint32_t)transform_data_.size(), transform_data_.data());
-            transform_buffer_.setName("Capsaicin_TransformBuffer");
-
-            prev_transform_data_.resize(transform_data_.size());
-
-            for (size_t i = 0; i < prev_transform_data_.size(); ++i)
+            // Patch the changed objects in place, falling back to a full rebuild if the data no longer fits
+            if (!updateScene())
             {
-                prev_transform_data_[i] = transform_data_[i];
+                buildScene();
+                scene_rebuilt = true;
             }
-
-            prev_transform_buffer_ = gfxCreateBuffer<glm::mat4x3>(
-                gfx_, (uint32_t)prev_transform_data_.size(), prev_transform_data_.data());
-            prev_transform_buffer_.setName("Capsaicin_PrevTransformBuffer");
-
-            gfxAccelerationStructureUpdate(gfx_, acceleration_structure_);
-
-            mesh_hash_ = mesh_hash;
         }
 
-        GfxInstance const *instances      = gfxSceneGetObjects<GfxInstance>(scene_);
-        uint32_t const     instance_count = gfxSceneGetObjectCount<GfxInstance>(scene_);
-
         // Check whether we need to re-build our transform data
-        size_t transform_hash = transform_hash_;
-        if (frame_index_ == 0 || animation) transform_hash = HashReduce(instances, instance_count);
-
-        if (transform_hash != transform_hash_ || mesh_updated_)
+        if (scene_changes_.hasChanges(SceneChangeTracker::ObjectType::Transform) || mesh_updated_)
         {
             transform_updated_ = true;
-            transform_hash_    = transform_hash;
-
-            // Update our transforms
-            GfxBuffer transform_buffer =
-                allocateConstantBuffer<glm::mat4x3>((uint32_t)transform_data_.size());
-            glm::mat4x3 *transform_data = (glm::mat4x3 *)gfxBufferGetData(gfx_, transform_buffer);
-
-            for (uint32_t i = 0; i < instance_count; ++i)
-            {
-                uint32_t const instance_index = gfxSceneGetObjectHandle<GfxInstance>(scene_, i);
 
-                if (instance_index >= instance_data_.size())
-                {
-                    continue;
-                }
-
-                GFX_ASSERT(instance_index < instance_min_bounds_.size());
-                GFX_ASSERT(instance_index < instance_max_bounds_.size());
-
-                Instance const &instance = instance_data_[instance_index];
-
-                transform_data[instance.transform_index]  = instances[i].transform;
-                transform_data_[instance.transform_index] = instances[i].transform;
-
-                if (instances[i].mesh)
-                {
-                    GfxMesh const &mesh = *instances[i].mesh;
-
-                    CalculateTransformedBounds(mesh.bounds_min, mesh.bounds_max, instances[i].transform,
-                        instance_min_bounds_[instance_index], instance_max_bounds_[instance_index]);
-                }
-
-                glm::mat4 const row_major_transform = glm::transpose(instances[i].transform);
-
-                gfxRaytracingPrimitiveSetTransform(
-                    gfx_, raytracing_primitives_[instance_index], &row_major_transform[0][0]);
-            }
+            // Only the changed transforms are updated unless the scene buffers were recreated
+            updateTransforms(scene_rebuilt || scene_changes_.hasChanges(SceneChangeTracker::ObjectType::Mesh));
+        }
 
-            // Update our acceleration structure
+        // Swap in the textures that finished streaming, replacing their placeholders
+        if (texture_streamer_.isInitialized())
+        {
+            CAPSAICIN_PROFILE_SCOPE("StreamTextures");
+            GfxCommandEvent const command_event(gfx_, "StreamTextures");
+            texture_upload_bytes_ += texture_streamer_.update(texture_uploads_);
+            for (auto const &[image_index, texture] : texture_uploads_)
             {
-                GfxCommandEvent const command_event(gfx_, "UpdateTLAS");
-
-                gfxCommandCopyBuffer(gfx_, transform_buffer_, transform_buffer);
-                gfxAccelerationStructureUpdate(gfx_, acceleration_structure_);
-                gfxDestroyBuffer(gfx_, transform_buffer);
+                gfxDestroyTexture(gfx_, texture_atlas_[image_index]);
+                texture_atlas_[image_index] = texture;
             }
+            textures_updated_ = !texture_uploads_.empty();
+        }
 
+        // Check whether we need to re-build our instance table
+        if (mesh_updated_)
+        {
             // Set up our instance indirection table
             instance_id_data_.resize(gfxSceneGetObjectCount<GfxInstance>(scene_));
 
@@ -1535,12 +1645,11 @@ void CapsaicinInternal::render()
                 instance_id_data_[i] = gfxSceneGetObjectHandle<GfxInstance>(scene_, (uint32_t)i);
             }
 
-            GfxBuffer instance_id_buffer =
-                allocateConstantBuffer<uint32_t>((uint32_t)instance_id_data_.size());
-            memcpy(gfxBufferGetData(gfx_, instance_id_buffer), instance_id_data_.data(),
-                instance_id_data_.size() * sizeof(uint32_t));
+            uint64_t const         instance_id_size = instance_id_data_.size() * sizeof(uint32_t);
+            UploadAllocation const instance_id_upload = allocateUploadMemory(instance_id_size);
+            memcpy(instance_id_upload.data, instance_id_data_.data(), instance_id_size);
 
-            if (!instance_id_buffer_ || instance_id_buffer.getSize() != instance_id_buffer_.getSize())
+            if (!instance_id_buffer_ || instance_id_buffer_.getSize() != instance_id_size)
             {
                 gfxDestroyBuffer(gfx_, instance_id_buffer_);
                 instance_id_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, (uint32_t)instance_id_data_.size());
@@ -1550,8 +1659,8 @@ void CapsaicinInternal::render()
             // Update our instance table
             {
                 GfxCommandEvent const command_event(gfx_, "UpdateInstanceTable");
-                gfxCommandCopyBuffer(gfx_, instance_id_buffer_, instance_id_buffer);
-                gfxDestroyBuffer(gfx_, instance_id_buffer);
+                gfxCommandCopyBuffer(gfx_, instance_id_buffer_, 0, instance_id_upload.buffer,
+                    instance_id_upload.offset, instance_id_size);
             }
         }
 
@@ -1559,6 +1668,60 @@ void CapsaicinInternal::render()
         gfxCommandBindIndexBuffer(gfx_, index_buffer_);
         gfxCommandBindVertexBuffer(gfx_, vertex_buffer_);
 
+        // Gather the GPU times read back for the techniques of an earlier frame for the CPU profile timeline and
+        // the timing statistics, nested sections are named after their technique (e.g., 'GI-1.0/UpdateRadianceCache')
+        if (CpuProfiler::IsProfiling() || collect_timings)
+        {
+            std::vector<std::pair<std::string, double>> gpu_sections; // sections of the same name are summed
+            double                                      total_gpu_time = 0.0;
+            auto const addGpuSections = [&](Timeable const &timeable) {
+                auto const &timestamp_queries = timeable.getTimestampQueries();
+                for (uint32_t i = 0; i < timeable.getTimestampQueryCount(); ++i)
+                {
+                    double const duration = gfxTimestampQueryGetDuration(gfx_, timestamp_queries[i].query);
+                    CpuProfiler::AddGpuSection(
+                        kGfxConstant_BackBufferCount, timestamp_queries[i].name, i > 0 ? 1 : 0, duration / 1000.0);
+                    if (!collect_timings)
+                    {
+                        continue;
+                    }
+                    std::string section_name(timeable.getName());
+                    if (i > 0)
+                    {
+                        section_name += '/';
+                        section_name += timestamp_queries[i].name;
+                    }
+                    auto const section = std::find_if(gpu_sections.begin(), gpu_sections.end(),
+                        [&](auto const &item) { return item.first == section_name; });
+                    if (section != gpu_sections.end())
+                    {
+                        section->second += duration;
+                    }
+                    else
+                    {
+                        gpu_sections.emplace_back(std::move(section_name), duration);
+                    }
+                    total_gpu_time += (i == 0 ? duration : 0.0);
+                }
+            };
+            for (auto const &component : components_)
+            {
+                addGpuSections(*component.second);
+            }
+            for (auto const &render_technique : render_techniques_)
+            {
+                addGpuSections(*render_technique);
+            }
+            if (collect_timings)
+            {
+                timing_statistics_.addSample("GPU Total", total_gpu_time);
+                for (auto const &[section_name, duration] : gpu_sections)
+                {
+                    timing_statistics_.addSample(section_name, duration);
+                }
+            }
+        }
+
         // Update the components
         for (auto const &component : components_)
         {
@@ -1663,6 +1826,7 @@ void CapsaicinInternal::render()
         }
         dump_requests_.pop_front();
     }
+    captureFrame();
 
     uint32_t dump_available_buffer_count = 0;
     for (auto &dump_in_flight_buffer : dump_in_flight_buffers_)
@@ -1679,20 +1843,19 @@ void CapsaicinInternal::render()
         }
     }
 
-    ThreadPool().Dispatch(
-        [&](uint32_t buffer_index) {
-            auto const &[dump_buffer, dump_buffer_width, dump_buffer_height, dump_file_path,
-                dump_frame_index] = dump_in_flight_buffers_[buffer_index];
-            saveImage(dump_buffer, dump_buffer_width, dump_buffer_height, dump_file_path.c_str());
-        },
-        dump_available_buffer_count, 1);
-
+    // Hand the available buffers over to the background writer, keeping them for the next frame if its queue is full
     for (uint32_t available_buffer_index = 0; available_buffer_index < dump_available_buffer_count;
          available_buffer_index++)
     {
-        gfxDestroyBuffer(gfx_, std::get<0>(dump_in_flight_buffers_.front()));
+        auto const &[dump_buffer, dump_buffer_width, dump_buffer_height, dump_file_path, dump_frame_index] =
+            dump_in_flight_buffers_.front();
+        if (!image_writer_.write(dump_buffer, dump_buffer_width, dump_buffer_height, dump_file_path))
+        {
+            break;
+        }
         dump_in_flight_buffers_.pop_front();
     }
+    image_writer_.update();
 
     // Dump cameras
     ThreadPool().Dispatch(
@@ -1704,6 +1867,9 @@ void CapsaicinInternal::render()
         (uint32_t)dump_camera_requests_.size(), 1);
 
     dump_camera_requests_.clear();
+
+    CpuProfiler::EndFrame();
+    GfxRecorder::EndFrame();
 }
 
 void CapsaicinInternal::renderGUI(bool readOnly)
@@ -1725,12 +1891,80 @@ void CapsaicinInternal::renderGUI(bool readOnly)
     const uint32_t envLightCount   = getEnvironmentLightCount();
     const uint32_t triangleCount   = getTriangleCount();
     const uint64_t bvhDataSize     = getBvhDataSize();
+    const uint64_t sceneUploadSize = getSceneUploadBytes();
+    const double   flattenRate     = getSceneFlattenRate();
+    const uint64_t vertexDataSize  = getVertexDataSize();
+    const uint64_t vertexFullSize  = vertex_data_.size() * sizeof(Vertex);
     ImGui::Text("Triangle Count            :  %u", triangleCount);
     ImGui::Text("Light Count               :  %u", areaLightCount + deltaLightCount + envLightCount);
     ImGui::Text("  Area Light Count        :  %u", areaLightCount);
     ImGui::Text("  Delta Light Count       :  %u", deltaLightCount);
     ImGui::Text("  Environment Light Count :  %u", envLightCount);
     ImGui::Text("BVH Data Size             :  %.1f MiB", bvhDataSize / (1024.0 * 1024.0));
+    ImGui::Text("Scene Upload Size         :  %.1f MiB", sceneUploadSize / (1024.0 * 1024.0));
+    ImGui::Text("Scene Flatten Rate        :  %.1f MVerts/s", flattenRate / 1000000.0);
+    ImGui::Text("Scene Load Time           :  %.1f ms (import %.1f ms, build %.1f ms%s)",
+        getSceneLoadTime() * 1000.0, scene_import_time_ * 1000.0, scene_build_time_ * 1000.0,
+        getSceneCacheHit() ? ", cached" : "");
+    if (texture_streamer_.isInitialized())
+    {
+        ImGui::Text("Texture Streaming         :  %u pending, %.1f MiB uploaded", getPendingTextureCount(),
+            texture_upload_bytes_ / (1024.0 * 1024.0));
+    }
+    if (image_writer_.getStats().image_count > 0 || image_writer_.getStats().queue_depth > 0)
+    {
+        ImGui::Text("Dump Writer               :  %u queued (%u peak), %.1f MiB/s",
+            image_writer_.getStats().queue_depth, image_writer_.getStats().peak_queue_depth,
+            image_writer_.getStats().bytes_per_second / (1024.0 * 1024.0));
+    }
+    if (animation_evaluator_.getChannelCount() > 0)
+    {
+        ImGui::Text("Animation Channels        :  %u (%u keyframes, %u unbaked animations, baked in %.1f ms)",
+            animation_evaluator_.getChannelCount(), animation_evaluator_.getKeyframeCount(),
+            (uint32_t)unbaked_animations_.size(), animation_bake_time_ * 1000.0);
+    }
+    if (render_graph_.getResourceCount() > 0)
+    {
+        ImGui::Text("AOV and Buffer Memory     :  %.1f MiB (%.1f MiB %s aliasing)",
+            (transient_aliasing_ ? render_graph_.getAliasedSize() : render_graph_.getUnaliasedSize())
+                / (1024.0 * 1024.0),
+            (transient_aliasing_ ? render_graph_.getUnaliasedSize() : render_graph_.getAliasedSize())
+                / (1024.0 * 1024.0),
+            transient_aliasing_ ? "without" : "with");
+    }
+    ImGui::Text("Vertex Data Size          :  %.1f MiB (%.1f MiB saved)", vertexDataSize / (1024.0 * 1024.0),
+        (vertexFullSize - vertexDataSize) / (1024.0 * 1024.0));
+    FrameAllocatorStats const &uploadStats = getConstantBufferStats();
+    ImGui::Text("Upload Memory             :  %.1f KiB in %u allocations (%.1f KiB pool, %u overflows)",
+        uploadStats.allocated_bytes / 1024.0, uploadStats.allocation_count, uploadStats.capacity / 1024.0,
+        uploadStats.overflow_count);
+    if (getOptimizeMeshes())
+    {
+        MeshStats meshStatsBefore, meshStatsAfter;
+        getMeshOptimizationStats(meshStatsBefore, meshStatsAfter);
+        ImGui::Text("Mesh Vertex Count         :  %u -> %u", meshStatsBefore.vertex_count,
+            meshStatsAfter.vertex_count);
+        ImGui::Text("Mesh ACMR                 :  %.3f -> %.3f", meshStatsBefore.acmr, meshStatsAfter.acmr);
+        ImGui::Text("Mesh Overfetch            :  %.3f -> %.3f", meshStatsBefore.overfetch,
+            meshStatsAfter.overfetch);
+        if (ImGui::TreeNode("Per-Mesh Optimization"))
+        {
+            for (uint32_t i = 0; i < gfxSceneGetObjectCount<GfxMesh>(scene_); ++i)
+            {
+                GfxConstRef<GfxMesh> meshRef   = gfxSceneGetObjectHandle<GfxMesh>(scene_, i);
+                OptimizedMesh const *optimized = getOptimizedMesh((uint32_t)meshRef);
+                if (optimized == nullptr)
+                {
+                    continue;
+                }
+                ImGui::Text("%-24s:  ACMR %.3f -> %.3f, Overfetch %.3f -> %.3f, Vertices %u -> %u",
+                    gfxSceneGetObjectMetadata<GfxMesh>(scene_, meshRef).getObjectName(),
+                    optimized->before.acmr, optimized->after.acmr, optimized->before.overfetch,
+                    optimized->after.overfetch, optimized->before.vertex_count, optimized->after.vertex_count);
+            }
+            ImGui::TreePop();
+        }
+    }
     ImGui::Text("Render Resolution         :  %ux%u", getWidth(), getHeight());
 
     if (!readOnly)
@@ -1803,6 +2037,40 @@ void CapsaicinInternal::renderGUI(bool readOnly)
             ImGui::TreePop();
         }
 
+        // CPU times of the last frame, if being profiled
+        auto const &cpu_frames = CpuProfiler::GetFrames();
+        if (CpuProfiler::IsProfiling() && !cpu_frames.empty()
+            && ImGui::TreeNodeEx("CPU", ImGuiTreeNodeFlags_None, "%-20s: %.3f ms", "CPU",
+                (double)cpu_frames.back().duration / 1e6))
+        {
+            auto const &cpu_tree = cpu_frames.back().tree;
+            uint32_t    open     = 0; // number of tree levels currently open
+            for (uint32_t i = 0; i < (uint32_t)cpu_tree.size(); ++i)
+            {
+                CpuProfileNode const &node = cpu_tree[i];
+                if (node.depth > open)
+                {
+                    continue; // a parent node is collapsed
+                }
+                for (; open > node.depth; --open)
+                {
+                    ImGui::TreePop();
+                }
+                bool const               hasChildren = i + 1 < cpu_tree.size() && cpu_tree[i + 1].depth > node.depth;
+                ImGuiTreeNodeFlags const flags = (hasChildren ? ImGuiTreeNodeFlags_None : ImGuiTreeNodeFlags_Leaf);
+                if (ImGui::TreeNodeEx((void *)(uintptr_t)i, flags, "%-17s: %.3f ms (x%u)",
+                        CpuProfiler::GetName(node.name).data(), node.time * 1000.0, node.count))
+                {
+                    ++open;
+                }
+            }
+            for (; open > 0; --open)
+            {
+                ImGui::TreePop();
+            }
+            ImGui::TreePop();
+        }
+
         ImGui::Separator();
 
         const std::string graphName = std::format("{:.2f}", frame_time_ * 1000.0) + " ms ("
@@ -1876,20 +2144,30 @@ void CapsaicinInternal::terminate()
 {
     gfxFinish(gfx_); // flush & sync
 
-    // Dump remaining buffers, they are all available after gfxFinish
-    ThreadPool().Dispatch(
-        [&](uint32_t buffer_index) {
-            auto &[dump_buffer, dump_buffer_width, dump_buffer_height, dump_file_path, dump_frame_index] =
-                dump_in_flight_buffers_[buffer_index];
-            saveImage(dump_buffer, dump_buffer_width, dump_buffer_height, dump_file_path.c_str());
-        },
-        (uint32_t)dump_in_flight_buffers_.size(), 1);
+    stopFrameCapture();
+    stopCameraRecording();
+    stopCameraReplay();
 
+    // Dump remaining buffers, they are all available after gfxFinish
     while (dump_in_flight_buffers_.size() > 0)
     {
-        gfxDestroyBuffer(gfx_, std::get<0>(dump_in_flight_buffers_.front()));
+        auto const &[dump_buffer, dump_buffer_width, dump_buffer_height, dump_file_path, dump_frame_index] =
+            dump_in_flight_buffers_.front();
+        if (!image_writer_.write(dump_buffer, dump_buffer_width, dump_buffer_height, dump_file_path))
+        {
+            if (!image_writer_.isInitialized())
+            {
+                gfxDestroyBuffer(gfx_, dump_buffer);
+                dump_in_flight_buffers_.pop_front();
+                continue;
+            }
+            image_writer_.flush();
+            image_writer_.update();
+            continue;
+        }
         dump_in_flight_buffers_.pop_front();
     }
+    image_writer_.terminate();
 
     gfxDestroyKernel(gfx_, blit_kernel_);
     gfxDestroyProgram(gfx_, blit_program_);
@@ -1899,16 +2177,17 @@ void CapsaicinInternal::terminate()
     gfxDestroyKernel(gfx_, dump_copy_to_buffer_kernel_);
     gfxDestroyProgram(gfx_, dump_copy_to_buffer_program_);
 
-    gfxDestroyBuffer(gfx_, camera_matrices_buffer_[0]);
-    gfxDestroyBuffer(gfx_, camera_matrices_buffer_[1]);
-    gfxDestroyBuffer(gfx_, mesh_buffer_);
-    gfxDestroyBuffer(gfx_, index_buffer_);
-    gfxDestroyBuffer(gfx_, vertex_buffer_);
-    gfxDestroyBuffer(gfx_, instance_buffer_);
-    gfxDestroyBuffer(gfx_, material_buffer_);
-    gfxDestroyBuffer(gfx_, transform_buffer_);
+    for (auto &camera_matrices_buffers : camera_matrices_buffer_)
+    {
+        gfxDestroyBuffer(gfx_, camera_matrices_buffers[0]);
+        gfxDestroyBuffer(gfx_, camera_matrices_buffers[1]);
+        camera_matrices_buffers[0] = {};
+        camera_matrices_buffers[1] = {};
+    }
     gfxDestroyBuffer(gfx_, instance_id_buffer_);
-    gfxDestroyBuffer(gfx_, prev_transform_buffer_);
+    destroyScene();
+    scene_cache_.close();
+    texture_streamer_.terminate();
 
     gfxDestroyTexture(gfx_, environment_buffer_);
 
@@ -1917,35 +2196,37 @@ void CapsaicinInternal::terminate()
     gfxDestroySamplerState(gfx_, nearest_sampler_);
     gfxDestroySamplerState(gfx_, anisotropic_sampler_);
 
-    gfxDestroyAccelerationStructure(gfx_, acceleration_structure_);
-
-    for (auto &i : aov_buffers_)
+    for (auto &i : aov_textures_)
     {
-        gfxDestroyTexture(gfx_, i.second);
+        gfxDestroyTexture(gfx_, i);
     }
+    aov_textures_.clear();
     aov_buffers_.clear();
     aov_backup_buffers_.clear();
     aov_clear_buffers_.clear();
 
     debug_views_.clear();
 
-    for (auto &i : shared_buffers_)
+    for (auto &i : shared_buffer_memory_)
     {
-        gfxDestroyBuffer(gfx_, i.second);
+        gfxDestroyBuffer(gfx_, i);
     }
+    shared_buffer_memory_.clear();
     shared_buffers_.clear();
 
-    for (GfxTexture const &texture : texture_atlas_)
-    {
-        gfxDestroyTexture(gfx_, texture);
-    }
-    texture_atlas_.clear();
-
     for (GfxBuffer const &constant_buffer_pool : constant_buffer_pools_)
     {
         gfxDestroyBuffer(gfx_, constant_buffer_pool);
     }
     memset(constant_buffer_pools_, 0, sizeof(constant_buffer_pools_));
+    for (std::vector<GfxBuffer> &overflow_buffers : constant_buffer_overflows_)
+    {
+        for (GfxBuffer const &overflow_buffer : overflow_buffers)
+        {
+            gfxDestroyBuffer(gfx_, overflow_buffer);
+        }
+        overflow_buffers.clear();
+    }
 
     render_techniques_.clear();
     components_.clear();
@@ -2007,17 +2288,20 @@ void CapsaicinInternal::setupRenderTechniques(std::string_view const &name) noex
     gfxFinish(gfx_); // flush & sync
 
     // Delete old AOVS, debug views and buffers
+    option_registry_.clear();
     options_.clear();
     components_.clear();
-    for (auto &i : shared_buffers_)
+    for (auto &i : shared_buffer_memory_)
     {
-        gfxDestroyBuffer(gfx_, i.second);
+        gfxDestroyBuffer(gfx_, i);
     }
+    shared_buffer_memory_.clear();
     shared_buffers_.clear();
-    for (auto &i : aov_buffers_)
+    for (auto &i : aov_textures_)
     {
-        gfxDestroyTexture(gfx_, i.second);
+        gfxDestroyTexture(gfx_, i);
     }
+    aov_textures_.clear();
     aov_buffers_.clear();
     aov_backup_buffers_.clear();
     aov_clear_buffers_.clear();
@@ -2141,8 +2425,12 @@ void CapsaicinInternal::setupRenderTechniques(std::string_view const &name) noex
                 options_.emplace(i.first, i.second);
             }
         }
+        option_registry_.bind(options_);
     }
 
+    // Plan the memory of the Buffers and AOVs from the accesses declared by the components and render techniques
+    render_graph_.clear();
+
     {
         // Get requested buffers
         struct BufferParams
@@ -2177,24 +2465,14 @@ void CapsaicinInternal::setupRenderTechniques(std::string_view const &name) noex
             }
         }
 
-        // Create all requested Buffers
+        // Add all requested Buffers to the render graph, their size is visible to the passes so buffers can only
+        // share memory with buffers of the same size
         for (auto &i : requestedBuffers)
         {
-            // Create new texture
-            GfxBuffer   buffer     = gfxCreateBuffer(gfx_, i.second.size);
-            std::string bufferName = "Capsaicin_";
-            bufferName += i.first;
-            bufferName += "Buffer";
-            buffer.setName(bufferName.c_str());
-            shared_buffers_.emplace_back(i.first, buffer);
-        }
-
-        // Initialise the Buffers
-        for (auto &i : shared_buffers_)
-        {
-            gfxCommandClearBuffer(gfx_, i.second);
+            render_graph_.addResource(i.first, kBufferResourceKey | i.second.size, i.second.size, false);
         }
     }
+    uint32_t const bufferResourceCount = render_graph_.getResourceCount();
 
     {
         // Get requested AOVs
@@ -2385,42 +2663,117 @@ void CapsaicinInternal::setupRenderTechniques(std::string_view const &name) noex
             }
         }
 
-        // Create all requested AOVs
+        // Add all requested AOVs to the render graph, the default AOVs and accumulated ones must be kept for the
+        // whole frame as they are read after the render techniques ran or by the next frame
+        uint64_t const pixelCount = (uint64_t)gfxGetBackBufferWidth(gfx_) * gfxGetBackBufferHeight(gfx_);
         for (auto &i : requestedAOVs)
         {
-            // Create new texture
-            GfxTexture  texture    = gfxCreateTexture2D(gfx_, i.second.format);
-            std::string bufferName = "Capsaicin_";
-            bufferName += i.first;
-            bufferName += "AOV";
-            texture.setName(bufferName.c_str());
-            aov_buffers_.emplace_back(i.first, texture);
-
-            // Add to backup list
+            uint64_t const size     = GfxRecorder::GetBytes(i.second.format, pixelCount);
+            bool const     external = defaultAOVs.contains(i.first) || defaultOptionalAOVs.contains(i.first)
+                                || (i.second.flags & AOV::Accumulate) != 0;
+            uint32_t const resource = render_graph_.addResource(
+                i.first, i.second.format, size, external, (i.second.flags & AOV::Clear) != 0);
             if (!i.second.backup.empty())
             {
-                // Create new backup texture
-                GfxTexture texture2 = gfxCreateTexture2D(gfx_, i.second.format);
-                texture2.setName(i.second.backup.data());
-                aov_backup_buffers_.emplace_back(std::make_pair(texture, texture2));
+                uint32_t const backup = render_graph_.addResource(i.second.backup, i.second.format, size, false);
+                render_graph_.addHistory(resource, backup);
+            }
+        }
+    }
 
-                aov_buffers_.emplace_back(i.second.backup, texture2);
+    {
+        // Record the accesses of each pass in execution order, components run ahead of the render techniques
+        for (auto const &i : components_)
+        {
+            render_graph_.addPass(i.first);
+            for (auto const &j : i.second->getBuffers())
+            {
+                render_graph_.addAccess(render_graph_.findResource(j.name), GetRenderGraphAccess(j.access));
+            }
+        }
+        for (auto const &i : render_techniques_)
+        {
+            render_graph_.addPass(i->getName());
+            for (auto const &j : i->getBuffers())
+            {
+                render_graph_.addAccess(render_graph_.findResource(j.name), GetRenderGraphAccess(j.access));
+            }
+            for (auto const &j : i->getAOVs())
+            {
+                // Optional AOVs that nothing else requested don't exist
+                if (uint32_t const resource = render_graph_.findResource(j.name); resource != UINT32_MAX)
+                {
+                    render_graph_.addAccess(resource, GetRenderGraphAccess(j.access));
+                }
+            }
+        }
+        render_graph_.plan();
+
+        // Create a buffer or texture for each slot of the plan when aliasing, otherwise for each resource
+        std::vector<GfxBuffer>  slotBuffers(render_graph_.getSlotCount());
+        std::vector<GfxTexture> slotTextures(render_graph_.getSlotCount());
+        for (uint32_t resource = 0; resource < render_graph_.getResourceCount(); ++resource)
+        {
+            std::string_view const name    = render_graph_.getResourceName(resource);
+            uint32_t const         slot    = render_graph_.getSlot(resource);
+            bool const             aliased = transient_aliasing_ && render_graph_.getSlotResourceCount(slot) > 1;
+            if (resource < bufferResourceCount)
+            {
+                GfxBuffer &buffer = slotBuffers[slot];
+                if (!aliased || !buffer)
+                {
+                    // Create new buffer
+                    buffer                 = gfxCreateBuffer(gfx_, render_graph_.getResourceSize(resource));
+                    std::string bufferName = "Capsaicin_";
+                    bufferName += (aliased ? "Transient" : name);
+                    bufferName += "Buffer";
+                    buffer.setName(bufferName.c_str());
+                    shared_buffer_memory_.push_back(buffer);
+                }
+                shared_buffers_.emplace_back(name, buffer);
+                continue;
+            }
+            GfxTexture &texture = slotTextures[slot];
+            if (!aliased || !texture)
+            {
+                // Create new texture
+                DXGI_FORMAT const format = (DXGI_FORMAT)render_graph_.getResourceKey(resource);
+                texture                  = gfxCreateTexture2D(gfx_, format);
+                std::string bufferName   = "Capsaicin_";
+                bufferName += (aliased ? "Transient" : name);
+                bufferName += "AOV";
+                texture.setName(bufferName.c_str());
+                aov_textures_.push_back(texture);
+            }
+            aov_buffers_.emplace_back(name, texture);
+
+            // Add to backup list
+            if (uint32_t const source = render_graph_.getHistorySource(resource); source != UINT32_MAX)
+            {
+                GfxTexture const &sourceTexture = aov_buffers_[source - bufferResourceCount].second;
+                aov_backup_buffers_.emplace_back(std::make_pair(sourceTexture, texture));
+                continue;
             }
 
             // Add to clear list
-            if (i.second.flags & AOV::Clear)
+            if (render_graph_.isCleared(resource))
             {
                 aov_clear_buffers_.emplace_back(texture);
             }
 
-            // Add the AOV as a debug view (Using false to differentiate as AOV)
-            if (i.first != "Color" && i.first != "Debug") debug_views_.emplace_back(i.first, false);
+            // Add the AOV as a debug view (Using false to differentiate as AOV), aliased AOVs are overwritten by
+            // other passes before the end of the frame so can't be viewed
+            if (name != "Color" && name != "Debug" && !aliased) debug_views_.emplace_back(name, false);
         }
 
-        // Initialise the AOVs
-        for (auto &i : aov_buffers_)
+        // Initialise the Buffers and AOVs
+        for (auto &i : shared_buffer_memory_)
         {
-            gfxCommandClearTexture(gfx_, i.second);
+            gfxCommandClearBuffer(gfx_, i);
+        }
+        for (auto &i : aov_textures_)
+        {
+            gfxCommandClearTexture(gfx_, i);
         }
     }
 
@@ -2475,6 +2828,7 @@ void CapsaicinInternal::setupRenderTechniques(std::string_view const &name) noex
         // Reset flags as everything just got forced reset anyway
         mesh_updated_            = false;
         transform_updated_       = false;
+        textures_updated_        = false;
         environment_map_updated_ = false;
         scene_updated_           = false;
         camera_updated_          = false;
@@ -22,13 +22,31 @@ THE SOFTWARE.
 #pragma once
 
 #include "gpu_shared.h"
+#include "animation_evaluator.h"
+#include "camera_trajectory.h"
+#include "cpu_profiler.h"
+#include "frame_ring_allocator.h"
+#include "frame_sequence.h"
 #include "graph.h"
+#include "image_writer.h"
+#include "mesh_optimizer.h"
+#include "render_graph_planner.h"
+#include "render_option_registry.h"
 #include "renderer.h"
+#include "scene_cache.h"
+#include "scene_change_tracker.h"
+#include "texture_streamer.h"
+#include "timing_statistics.h"
+#include "transform_bounds.h"
+#include "utilities/cpu_sort.h"
 
 #include <deque>
 #include <gfx_imgui.h>
 #include <gfx_scene.h>
 
+// Must come after all gfx headers as it may redirect gfx calls to the recorder
+#include "gfx_recorder.h"
+
 namespace Capsaicin
 {
 class RenderTechnique;
@@ -166,6 +184,60 @@ class CapsaicinInternal
      */
     void stepJitterFrameIndex(uint32_t frames) noexcept;
 
+    /**
+     * Start recording the camera state (eye, center, up, field of view, jitter and play time) of each rendered
+     * frame to a trajectory file.
+     * @param file_path Full pathname to the file to write.
+     * @returns True if succeeded, False if the file could not be created.
+     */
+    bool startCameraRecording(char const *file_path) noexcept;
+
+    /**
+     * Stop recording the camera trajectory.
+     */
+    void stopCameraRecording() noexcept;
+
+    /**
+     * Start driving the active camera from a recorded trajectory, the camera of each frame found in the
+     * trajectory is replaced by the recorded one until the last recorded frame.
+     * @param file_path Full pathname to the file to read.
+     * @returns True if succeeded, False if the file is missing or invalid.
+     */
+    bool startCameraReplay(char const *file_path) noexcept;
+
+    /**
+     * Stop replaying the camera trajectory.
+     */
+    void stopCameraReplay() noexcept;
+
+    /**
+     * Check whether a camera trajectory is being replayed.
+     * @returns True if replaying.
+     */
+    bool isCameraReplaying() const noexcept;
+
+    /**
+     * Start collecting the CPU frame time and the GPU time of every timed section of every rendered frame, any
+     * previously collected timings are discarded.
+     * @note GPU times are read back a few frames after being recorded, so are collected with a delay of
+     * kGfxConstant_BackBufferCount frames.
+     * @param first_frame The index of the first frame to collect timings for (e.g., to skip warm up frames).
+     */
+    void startTimingStatistics(uint32_t first_frame) noexcept;
+
+    /**
+     * Gets the statistics of the timings collected so far.
+     * @returns The list of section statistics (in milliseconds).
+     */
+    std::vector<TimingSummary> getTimingStatistics() const noexcept;
+
+    /**
+     * Stop collecting timings and write the statistics of each section to a file.
+     * @param file_path Full pathname to the CSV or JSON ('.json' extension) file to write (nullptr to discard).
+     * @returns True if succeeded, False if the file could not be written.
+     */
+    bool stopTimingStatistics(char const *file_path) noexcept;
+
     /**
      * Check if the scenes mesh data was changed this frame.
      * @return True if mesh data has changed.
@@ -178,6 +250,42 @@ class CapsaicinInternal
      */
     bool getTransformsUpdated() const noexcept;
 
+    /**
+     * Check if any scene texture finished streaming in this frame.
+     * @return True if texture data has changed.
+     */
+    bool getTexturesUpdated() const noexcept;
+
+    /**
+     * Get the scene objects that changed this frame.
+     * @return The scene change tracker.
+     */
+    SceneChangeTracker const &getSceneChanges() const noexcept;
+
+    /**
+     * Record that a mesh was edited through getScene(), so that its data gets uploaded again.
+     * Meshes are only checked for changes when a scene is loaded, edits made afterwards must be reported.
+     * @note The change is applied at the start of the next frame.
+     * @param mesh_index The scene handle of the mesh.
+     */
+    void markMeshChanged(uint32_t mesh_index) noexcept;
+
+    /**
+     * Record that a material was edited through getScene(), so that its data gets uploaded again.
+     * Materials are only checked for changes when a scene is loaded, edits made afterwards must be reported.
+     * @note The change is applied at the start of the next frame.
+     * @param material_index The scene handle of the material.
+     */
+    void markMaterialChanged(uint32_t material_index) noexcept;
+
+    /**
+     * Record that an image was edited or reloaded through getScene(), so that its texture gets uploaded again.
+     * Images are only checked for changes when a scene is loaded, edits made afterwards must be reported.
+     * @note The change is applied at the start of the next frame.
+     * @param image_index The scene handle of the image.
+     */
+    void markImageChanged(uint32_t image_index) noexcept;
+
     /**
      * Check if the scene was changed this frame.
      * @return True if scene has changed.
@@ -361,6 +469,13 @@ class CapsaicinInternal
     RenderOptionList const &getOptions() const noexcept;
     RenderOptionList       &getOptions() noexcept;
 
+    /**
+     * Gets the registry indexing the render options currently in use.
+     * @note Changes made directly to the render options list are picked up at the start of each frame.
+     * @returns The render option registry.
+     */
+    RenderOptionRegistry const &getOptionRegistry() const noexcept;
+
     /**
      * Checks if an options exists with the specified type.
      * @tparam T Generic type parameter of the requested option.
@@ -437,11 +552,13 @@ class CapsaicinInternal
             if (std::holds_alternative<T>(i->second))
             {
                 *std::get_if<T>(&(i->second)) = value;
+                option_registry_.sync(name);
             }
         }
         else
         {
             options.emplace(name, value);
+            option_registry_.bind(options);
         }
     }
 
@@ -501,6 +618,133 @@ class CapsaicinInternal
      */
     uint64_t getBvhDataSize() const noexcept;
 
+    /**
+     * Gets the number of bytes uploaded to the GPU by the most recent scene update.
+     * @returns The upload size (in bytes).
+     */
+    uint64_t getSceneUploadBytes() const noexcept;
+
+    /**
+     * Gets the throughput of the vertex flattening done by the most recent scene update.
+     * @returns The flattening rate (in vertices per second).
+     */
+    double getSceneFlattenRate() const noexcept;
+
+    /**
+     * Set whether AOVs and buffers only used during part of the frame share memory with each other.
+     * @note Takes effect the next time a renderer is set up. Aliased AOVs are overwritten before the end of the
+     * frame so are not available as debug views.
+     * @param enable True to alias transient resources, False to give every AOV and buffer its own memory.
+     */
+    void setTransientAliasing(bool enable) noexcept;
+
+    /**
+     * Gets the memory plan of the current renderer's AOVs and buffers.
+     * @returns The planned render graph.
+     */
+    RenderGraphPlanner const &getRenderGraph() const noexcept;
+
+    /**
+     * Set whether scenes use the compact (quantized) vertex layout.
+     * @note Takes effect the next time a scene is loaded.
+     * @param compact True to use the compact layout, False to use the full precision layout.
+     */
+    void setCompactVertices(bool compact) noexcept;
+
+    /**
+     * Check whether the current scene uses the compact (quantized) vertex layout.
+     * @returns True if the vertex buffer uses the CompactVertex layout.
+     */
+    bool getCompactVertices() const noexcept;
+
+    /**
+     * Set whether scene meshes are welded and reordered for vertex cache and fetch locality.
+     * @note Takes effect the next time a scene is loaded.
+     * @param optimize True to optimize meshes, False to upload them unchanged.
+     */
+    void setOptimizeMeshes(bool optimize) noexcept;
+
+    /**
+     * Check whether the current scene's meshes were optimized.
+     * @returns True if meshes were optimized.
+     */
+    bool getOptimizeMeshes() const noexcept;
+
+    /**
+     * Gets the optimization result of a mesh.
+     * @param mesh_index The handle of the mesh.
+     * @returns The optimized mesh (nullptr if the mesh was not optimized).
+     */
+    OptimizedMesh const *getOptimizedMesh(uint32_t mesh_index) const noexcept;
+
+    /**
+     * Gets the vertex cache and fetch statistics of the whole scene before and after mesh optimization.
+     * @note Values are averaged over all meshes weighted by their triangle counts.
+     * @param [out] before Statistics of the source meshes.
+     * @param [out] after  Statistics of the optimized meshes.
+     */
+    void getMeshOptimizationStats(MeshStats &before, MeshStats &after) const noexcept;
+
+    /**
+     * Set whether the flattened scene data is stored in and loaded from a binary cache next to the scene file.
+     * @note Takes effect the next time a scene is loaded.
+     * @param enable True to use the scene cache, False to always build the scene data from the source files.
+     */
+    void setSceneCacheEnabled(bool enable) noexcept;
+
+    /**
+     * Check whether the current scene's data was loaded from the scene cache.
+     * @returns True if the scene cache was used.
+     */
+    bool getSceneCacheHit() const noexcept;
+
+    /**
+     * Gets the CPU time taken to load the current scene.
+     * @note Includes importing the scene files and building the scene data during the first frame.
+     * @returns The load time (in seconds).
+     */
+    double getSceneLoadTime() const noexcept;
+
+    /**
+     * Set the amount of texture data uploaded each frame while a scene's textures are streamed in.
+     * @note Takes effect the next time a scene is loaded.
+     * @param megabytes The per-frame upload budget (in MiB), 0 to upload all textures during scene load.
+     */
+    void setTextureUploadBudget(uint32_t megabytes) noexcept;
+
+    /**
+     * Set the filter used to generate the mip levels of streamed textures.
+     * @note Takes effect the next time a scene is loaded.
+     * @param filter The filter name (either "Box" or "Kaiser").
+     * @returns True if succeeded, False if the filter is unknown.
+     */
+    bool setTextureMipFilter(std::string_view const &filter) noexcept;
+
+    /**
+     * Gets the number of scene textures that are still being streamed in.
+     * @returns The pending texture count.
+     */
+    uint32_t getPendingTextureCount() const noexcept;
+
+    /**
+     * Set the rate scene animations are sampled at when baked into channels evaluated by Capsaicin.
+     * @note Takes effect the next time a scene is loaded.
+     * @param rate The number of samples per second, 0 to apply all animations through gfx every frame.
+     */
+    void setAnimationSampleRate(float rate) noexcept;
+
+    /**
+     * Gets the size of the vertex data uploaded for the current scene.
+     * @returns The vertex data size (in bytes).
+     */
+    uint64_t getVertexDataSize() const noexcept;
+
+    /**
+     * Gets the shader defines required by any shader reading the scene vertex buffer.
+     * @returns The list of defines.
+     */
+    std::vector<std::string> getSceneShaderDefines() const noexcept;
+
     GfxBuffer        getInstanceBuffer() const;
     Instance const  *getInstanceData() const;
     Instance        *getInstanceData();
@@ -554,8 +798,38 @@ class CapsaicinInternal
         return constant_buffer;
     }
 
+    /**
+     * Allocate a buffer from the current frame's upload memory that can be bound to a program.
+     * @note The returned buffer must be destroyed by the caller once recorded, its contents are only valid for the
+     * current frame.
+     * @param size The number of bytes required.
+     * @returns The allocated buffer.
+     */
     GfxBuffer allocateConstantBuffer(uint64_t size);
 
+    /** A range of the current frame's upload memory. */
+    struct UploadAllocation
+    {
+        GfxBuffer buffer;           /**< The buffer holding the range */
+        uint64_t  offset = 0;       /**< Offset of the range within the buffer (in bytes) */
+        void     *data   = nullptr; /**< CPU pointer to the start of the range */
+    };
+
+    /**
+     * Allocate a range of the current frame's upload memory to be used as the source of copy commands.
+     * Unlike allocateConstantBuffer() no buffer view is created, the range is released automatically once the GPU
+     * is done with the frame.
+     * @param size The number of bytes required.
+     * @returns The allocated range.
+     */
+    UploadAllocation allocateUploadMemory(uint64_t size);
+
+    /**
+     * Gets the upload memory statistics of the most recently completed frame.
+     * @returns The frame statistics.
+     */
+    FrameAllocatorStats const &getConstantBufferStats() const noexcept;
+
     /**
      * Initializes Capsaicin. Must be called before any other functions.
      * @param gfx The gfx context to use inside Capsaicin.
@@ -605,6 +879,41 @@ class CapsaicinInternal
      */
     void dumpCamera(char const *file_path, bool jittered);
 
+    /**
+     * Set the format of the EXR images dumped from now on.
+     * @param compression The compression to use.
+     * @param half        True to store half precision channels, False to store full precision ones.
+     */
+    void setDumpExrFormat(ImageCompression compression, bool half) noexcept;
+
+    /**
+     * Gets the statistics of the background writer saving dumped images.
+     * @returns The writer statistics (queue depth, bytes per second...).
+     */
+    ImageWriterStats const &getDumpStats() const noexcept;
+
+    /**
+     * Start capturing an AOV every frame into a single frame sequence container (or a pipe).
+     * @param file_path   Full pathname to the container, or a command prefixed with '|' to write raw frames to.
+     * @param aov         The AOV to capture (get available from @GetAOVs()).
+     * @param first_frame The first frame index to capture (see @getFrameIndex()).
+     * @param frame_count The number of frames to capture, the container is preallocated for them.
+     * @param half        True to store half precision channels, False to store full precision ones.
+     */
+    void startFrameCapture(char const *file_path, std::string_view const &aov, uint32_t first_frame,
+        uint32_t frame_count, bool half) noexcept;
+
+    /**
+     * Stop capturing frames, waiting for the frames still being read back.
+     */
+    void stopFrameCapture() noexcept;
+
+    /**
+     * Gets the number of frames written by the current frame capture.
+     * @returns The captured frame count.
+     */
+    uint32_t getCapturedFrameCount() const noexcept;
+
 private:
     /**
      * Sets up the render techniques for the currently set renderer.
@@ -624,21 +933,120 @@ class CapsaicinInternal
      */
     void resetRenderState() noexcept;
 
+    /**
+     * Rebuild all scene GPU data (meshes, materials, textures, instances and acceleration structure).
+     * Buffers are created with some additional headroom so that later updates can be patched in place.
+     */
+    void buildScene() noexcept;
+
+    /**
+     * Update the scene GPU data by re-uploading only the meshes, materials, images and instances that have
+     * changed since the last update.
+     * @returns False if an existing buffer is too small to hold the changes and a full rebuild is required.
+     */
+    bool updateScene() noexcept;
+
+    /**
+     * Make the current transforms the previous frame's transforms.
+     * The current and previous transform data are swapped rather than copied, so only the transforms that changed
+     * during the previous frame need to be brought up to date.
+     */
+    void updateTransformHistory() noexcept;
+
+    /**
+     * Update the transforms, world-space bounds and raytracing instances of the instances that changed.
+     * @param full_update True to update every instance (e.g., after the scene buffers were recreated).
+     */
+    void updateTransforms(bool full_update) noexcept;
+
+    /**
+     * Weld and reorder meshes for vertex cache and fetch locality.
+     * Results are looked up in (and added to) the optimized mesh cache, which is saved next to the scene file.
+     * @param dirty_meshes The indices of the meshes to optimize.
+     */
+    void optimizeMeshes(std::vector<uint32_t> const &dirty_meshes) noexcept;
+
+    /**
+     * Gets the path of the optimized mesh cache file for the current scene.
+     * @returns The file path (empty if no scene file is loaded).
+     */
+    std::string getOptimizedMeshCachePath() const noexcept;
+
+    /**
+     * Map the scene cache file of the current scene if it matches the source files and build options.
+     * If no valid cache exists then one is written once the scene data has been built.
+     */
+    void openSceneCache() noexcept;
+
+    /**
+     * Fill the scene buffers from the mapped scene cache, the remaining objects are then built by updateScene().
+     * @returns False if the cache does not match the scene and the data needs to be built from the source files.
+     */
+    bool loadSceneCache() noexcept;
+
+    /**
+     * Write the current scene data to the scene cache file.
+     */
+    void saveSceneCache() noexcept;
+
+    /**
+     * Gets the path of the scene cache file for the current scene.
+     * @returns The file path (empty if no scene file is loaded).
+     */
+    std::string getSceneCachePath() const noexcept;
+
+    /**
+     * Destroy all scene GPU data and reset the per-object change tracking.
+     */
+    void destroyScene() noexcept;
+
+    /**
+     * Find the scene objects that changed since the last call and record them in the scene change tracker.
+     * Instances and lights are compared against a snapshot of their previous state so that only actual changes
+     * get marked.
+     * @param full_scan True to check every scene object (i.e., scene load), False to only check the instances and
+     *                  lights driven by the animations applied through gfx.
+     */
+    void detectSceneChanges(bool full_scan) noexcept;
+
+    /**
+     * Bake the animations of the current scene into channels evaluated by the animation evaluator.
+     * Each animation is sampled through gfx, animations driving cameras, lights or instances also driven by another
+     * animation can't be evaluated independently and are left to be applied through gfx.
+     * The instances and lights driven by the animations left to gfx are recorded so that change detection only
+     * needs to check them, this sampling also runs when baking is disabled.
+     */
+    void bakeAnimations() noexcept;
+
+    /**
+     * Evaluate the baked animations at the current play time, writing and recording the changed transforms.
+     */
+    void applyBakedAnimations() noexcept;
+
+    /**
+     * Replace the active camera with the replayed one for the current frame.
+     * @returns The replayed camera state, or nullptr if the frame isn't replayed.
+     */
+    CameraKeyframe const *replayCamera() noexcept;
+
+    /**
+     * Record the camera state of the current frame and check it against the replayed one.
+     * @param replayed_keyframe The camera state replayed for the current frame (nullptr if none).
+     */
+    void recordCamera(CameraKeyframe const *replayed_keyframe) noexcept;
+
     void dumpBuffer(char const *file_path, GfxTexture dump_buffer);
-    void saveImage(GfxBuffer dump_buffer, uint32_t dump_buffer_width, uint32_t dump_buffer_height,
-        char const *file_path);
-    void saveEXR(GfxBuffer dump_buffer, uint32_t dump_buffer_width, uint32_t dump_buffer_height,
-        char const *exr_file_path);
-    void saveJPG(GfxBuffer dump_buffer, uint32_t dump_buffer_width, uint32_t dump_buffer_height,
-        char const *jpg_file_path);
+    void copyToDumpBuffer(GfxTexture dumped_buffer, GfxBuffer dump_copy_buffer, GfxBuffer dump_buffer,
+        uint32_t dump_buffer_width, uint32_t dump_buffer_height);
+    void captureFrame();
+    void appendCapturedFrame();
     void dumpCamera(char const *file_path, CameraMatrices const &camera_matrices, float camera_jitter_x,
         float camera_jitter_y);
 
-    size_t mesh_hash_               = 0;
-    size_t transform_hash_          = 0;
     bool   was_resized_             = false;
     bool   mesh_updated_            = true;
     bool   transform_updated_       = true;
+    bool   textures_updated_        = false;
     bool   environment_map_updated_ = true;
     bool   scene_updated_           = true;
     bool   camera_updated_          = true;
@@ -671,7 +1079,8 @@ class CapsaicinInternal
     float          camera_jitter_x_;
     float          camera_jitter_y_;
 
-    RenderOptionList options_; /**< Options for controlling the operation of each render technique */
+    RenderOptionList     options_;         /**< Options for controlling the operation of each render technique */
+    RenderOptionRegistry option_registry_; /**< Index of the render options tracking their changes */
 
     std::vector<std::unique_ptr<RenderTechnique>>
         render_techniques_; /**< The list of render techniques to be applied. */
@@ -698,10 +1107,17 @@ class CapsaicinInternal
     aov_clear  aov_clear_buffers_;  /**< List of buffers to clear each frame */
     using shared_buffer = std::vector<std::pair<std::string_view, GfxBuffer>>;
     shared_buffer shared_buffers_; /**< The list of buffers populated by the render techniques. */
-    GfxBuffer     constant_buffer_pools_[kGfxConstant_BackBufferCount];
-    uint64_t      constant_buffer_pool_cursor_ = 0;
-
-    GfxBuffer                camera_matrices_buffer_[2]; /**< Unjittered and jittered camera matrices */
+    std::vector<GfxTexture> aov_textures_;         /**< The textures backing the AOVs (shared by aliased AOVs) */
+    std::vector<GfxBuffer>  shared_buffer_memory_; /**< The buffers backing the shared buffers (likewise) */
+    RenderGraphPlanner      render_graph_;         /**< Memory plan of the AOVs and shared buffers */
+    bool transient_aliasing_ = false; /**< Whether transient AOVs and buffers share memory, set on renderer setup */
+    /** Upload memory of each frame in flight, plus any memory allocated separately once a frame's pool was full */
+    GfxBuffer              constant_buffer_pools_[kGfxConstant_BackBufferCount];
+    std::vector<GfxBuffer> constant_buffer_overflows_[kGfxConstant_BackBufferCount];
+    FrameRingAllocator     constant_buffer_allocator_;
+
+    /** Unjittered and jittered camera matrices of each frame in flight */
+    GfxBuffer                camera_matrices_buffer_[kGfxConstant_BackBufferCount][2];
     std::vector<Instance>    instance_data_;
     GfxBuffer                instance_buffer_;
     std::vector<glm::vec3>   instance_min_bounds_;
@@ -729,15 +1145,107 @@ class CapsaicinInternal
     std::vector<GfxRaytracingPrimitive> raytracing_primitives_;
     uint32_t                            sbt_stride_in_entries_[kGfxShaderGroupType_Count] = {};
 
-    // Scene statistics for currently loaded scene
-    uint32_t triangle_count_ = 0;
+    /** Per-object state used to detect which scene objects changed since the last upload. */
+    struct SceneObjectState
+    {
+        size_t   hash            = 0;     /**< Hash (or generation for meshes) of the object when last uploaded */
+        uint32_t vertex_count    = 0;     /**< Number of vertices uploaded for the object (meshes only) */
+        uint32_t vertex_capacity = 0;     /**< Number of vertices reserved for the object (meshes only) */
+        uint32_t index_capacity  = 0;     /**< Number of indices reserved for the object (meshes only) */
+        bool     valid           = false; /**< True if the object was present at the last upload */
+    };
+
+    std::vector<SceneObjectState> mesh_states_;     /**< Upload state of each mesh (indexed by handle) */
+    std::vector<SceneObjectState> material_states_; /**< Upload state of each material (indexed by handle) */
+    std::vector<SceneObjectState> image_states_;    /**< Upload state of each image (indexed by handle) */
+    std::vector<SceneObjectState> instance_states_; /**< Upload state of each instance (indexed by handle) */
+
+    /** Snapshot of an instance's state used to detect changes */
+    struct InstanceSnapshot
+    {
+        uint32_t  mesh_index     = 0;
+        uint32_t  material_index = 0;
+        glm::mat4 transform      = glm::mat4(1.0f);
+    };
+
+    std::vector<uint32_t> dirty_transforms_;        /**< Transforms written since the last history update */
+    std::vector<uint32_t> instance_object_indices_; /**< Scene object index of each instance (by handle) */
+    TransformBoundsBatch  transform_bounds_batch_;  /**< Batch used to compute the bounds of updated instances */
+    CPUSort               dirty_transform_sort_;    /**< Sorts the dirty transforms reusing its scratch memory */
+
+    SceneChangeTracker            scene_changes_;            /**< Generation tracking of changed scene objects */
+    std::vector<InstanceSnapshot> instance_snapshots_;       /**< Per-instance state as of the last detection */
+    std::vector<GfxLight>         light_snapshots_;          /**< Per-light state as of the last detection */
+    std::vector<uint32_t>         pending_mesh_changes_;     /**< Meshes reported as edited since last frame */
+    std::vector<uint32_t>         pending_material_changes_; /**< Materials reported as edited since last frame */
+    std::vector<uint32_t>         pending_image_changes_;    /**< Images reported as edited since last frame */
 
-    Graph frameGraph; /**< The stored frame history graph */
+    // Scene statistics for currently loaded scene
+    uint32_t triangle_count_     = 0;
+    uint64_t scene_upload_bytes_ = 0;   /**< Bytes uploaded by the most recent scene update */
+    double   scene_flatten_rate_ = 0.0; /**< Vertices per second flattened by the most recent scene update */
+
+    bool compact_vertices_      = false; /**< Requested vertex layout to use for the next loaded scene */
+    bool vertex_layout_compact_ = false; /**< Whether the current scene uses the CompactVertex layout */
+    bool optimize_meshes_       = false; /**< Requested mesh optimization to use for the next loaded scene */
+    bool mesh_optimization_     = false; /**< Whether the current scene's meshes are optimized */
+
+    OptimizedMeshCache                 optimized_mesh_cache_;   /**< Optimized meshes indexed by source hash */
+    std::vector<OptimizedMesh const *> mesh_optimizations_;     /**< Optimized data of each mesh (by handle) */
+    std::vector<size_t>                mesh_optimization_keys_; /**< Cache key of each mesh (by handle) */
+
+    bool       scene_cache_enabled_ = true;  /**< Whether scene caches are used when loading a scene */
+    SceneCache scene_cache_;                 /**< The mapped scene cache, only open until the first build */
+    uint64_t   scene_cache_key_     = 0;     /**< Key of the current scene's source files and build options */
+    bool       scene_cache_write_   = false; /**< Whether the scene cache must be written by the first build */
+    bool       scene_cache_hit_     = false; /**< Whether the current scene was built from the scene cache */
+    bool       scene_build_pending_ = false; /**< Whether the current scene has not been built yet */
+    double     scene_import_time_   = 0.0;   /**< Time spent importing the current scene (in seconds) */
+    double     scene_build_time_    = 0.0;   /**< Time spent on the first build of the current scene (in seconds) */
+
+    AnimationEvaluator    animation_evaluator_;          /**< Evaluates the baked animations of the current scene */
+    std::vector<uint32_t> unbaked_animations_;           /**< Animations applied through gfx every frame */
+    std::vector<uint32_t> animated_instances_;           /**< Scene object index of instances driven by gfx */
+    std::vector<uint32_t> animated_lights_;              /**< Scene object index of lights driven by gfx */
+    float                 animation_sample_rate_ = 0.0f; /**< Rate animations are baked at (0 if not baked) */
+    double                animation_bake_time_   = 0.0;  /**< Time spent baking the current scene's animations (s) */
+
+    CameraTrajectoryWriter camera_recording_;             /**< Records the camera state of each rendered frame */
+    CameraTrajectoryReader camera_replay_;                /**< Drives the camera while replaying a trajectory */
+    uint32_t               camera_replay_mismatches_ = 0; /**< Replayed frames whose play time or jitter differ */
+
+    TextureStreamer texture_streamer_;                       /**< Streams scene textures in the background */
+    uint32_t        texture_upload_budget_ = 0;              /**< Per-frame texture upload budget (in MiB) */
+    MipFilter       texture_mip_filter_    = MipFilter::Box; /**< Filter used to generate streamed mip levels */
+    uint64_t        texture_upload_bytes_  = 0;              /**< Texture bytes streamed in for the current scene */
+    std::vector<std::pair<uint32_t, GfxTexture>>
+        texture_uploads_; /**< Textures that finished streaming this frame (image index and texture) */
+
+    Graph            frameGraph;                             /**< The stored frame history graph */
+    TimingStatistics timing_statistics_;                     /**< The timings collected for benchmarking */
+    bool             timing_statistics_enabled_     = false; /**< Whether timings are being collected */
+    uint32_t         timing_statistics_first_frame_ = 0;     /**< The first frame timings are collected for */
 
     std::deque<std::tuple<std::string /*fileName*/, std::string /*AOV*/>>        dump_requests_;
     std::deque<std::tuple<std::string /*fileName*/, bool /*jitterred*/>>         dump_camera_requests_;
     std::deque<std::tuple<GfxBuffer, uint32_t, uint32_t, std::string, uint32_t>> dump_in_flight_buffers_;
     GfxKernel                                                                    dump_copy_to_buffer_kernel_;
     GfxProgram                                                                   dump_copy_to_buffer_program_;
+    ImageWriter image_writer_; /**< Encodes and writes the dumped buffers in the background */
+
+    FrameSequenceWriter    frame_capture_;                                     /**< The captured frame sequence */
+    std::string            frame_capture_path_;                                /**< Empty if not capturing */
+    std::string            frame_capture_aov_;                                 /**< The AOV being captured */
+    FrameEncoding          frame_capture_encoding_     = FrameEncoding::Float; /**< Storage of the captured pixels */
+    uint32_t               frame_capture_first_        = 0;                    /**< First frame index to capture */
+    uint32_t               frame_capture_remaining_    = 0;                    /**< Number of frames left to copy */
+    uint32_t               frame_capture_last_         = UINT32_MAX;           /**< Last frame index copied */
+    uint32_t               frame_capture_width_        = 0;                    /**< Width of the captured frames */
+    uint32_t               frame_capture_height_       = 0;                    /**< Height of the captured frames */
+    uint32_t               frame_capture_submit_index_ = 0;                    /**< Frames rendered while capturing */
+    GfxBuffer              frame_capture_copy_buffer_;                         /**< Float copy of the captured AOV */
+    std::vector<GfxBuffer> frame_capture_buffers_;                             /**< Reusable read back buffers */
+    std::deque<std::tuple<GfxBuffer, uint32_t, uint32_t>>
+        frame_capture_in_flight_; /**< Read back buffers being copied to (buffer, frame index, submit index) */
 };
 } // namespace Capsaicin
@@ -23,8 +23,6 @@ THE SOFTWARE.
 
 #include <fstream>
 #include <sstream>
-#include <tinyexr.h>
-#include <stb_image_write.h>
 
 namespace Capsaicin
 {
@@ -38,14 +36,71 @@ void CapsaicinInternal::dumpCamera(char const *file_path, bool jittered)
     dump_camera_requests_.push_back({file_path, jittered});
 }
 
+void CapsaicinInternal::setDumpExrFormat(ImageCompression compression, bool half) noexcept
+{
+    image_writer_.setExrFormat(compression, half);
+}
+
+ImageWriterStats const &CapsaicinInternal::getDumpStats() const noexcept
+{
+    return image_writer_.getStats();
+}
+
 void CapsaicinInternal::dumpAnyBuffer(char const *file_path, GfxTexture dump_buffer)
 {
     const GfxCommandEvent command_event(gfx_, "Dump '%s'", dump_buffer.getName());
     dumpBuffer(file_path, dump_buffer);
 }
 
+void CapsaicinInternal::startFrameCapture(char const *file_path, std::string_view const &aov, uint32_t first_frame,
+    uint32_t frame_count, bool half) noexcept
+{
+    stopFrameCapture();
+    frame_capture_path_      = file_path;
+    frame_capture_aov_       = aov;
+    frame_capture_first_     = first_frame;
+    frame_capture_remaining_ = frame_count;
+    frame_capture_encoding_  = half ? FrameEncoding::Half : FrameEncoding::Float;
+    frame_capture_last_      = UINT32_MAX;
+}
+
+void CapsaicinInternal::stopFrameCapture() noexcept
+{
+    if (!frame_capture_in_flight_.empty())
+    {
+        // Wait for the frames still being read back so that the sequence is complete
+        gfxFinish(gfx_);
+        while (!frame_capture_in_flight_.empty())
+        {
+            appendCapturedFrame();
+        }
+    }
+    if (frame_capture_.isOpen())
+    {
+        GFX_PRINTLN("Captured %u frames of '%s' to '%s'", frame_capture_.getFrameCount(),
+            frame_capture_aov_.c_str(), frame_capture_path_.c_str());
+        frame_capture_.close();
+    }
+    for (GfxBuffer const &buffer : frame_capture_buffers_)
+    {
+        gfxDestroyBuffer(gfx_, buffer);
+    }
+    frame_capture_buffers_.clear();
+    gfxDestroyBuffer(gfx_, frame_capture_copy_buffer_);
+    frame_capture_copy_buffer_ = {};
+    frame_capture_path_.clear();
+    frame_capture_remaining_ = 0;
+}
+
+uint32_t CapsaicinInternal::getCapturedFrameCount() const noexcept
+{
+    return frame_capture_.getFrameCount();
+}
+
 void CapsaicinInternal::dumpBuffer(char const *dump_file_path, GfxTexture dumped_buffer)
 {
+    CAPSAICIN_PROFILE_SCOPE("DumpBuffer");
+
     uint32_t dump_buffer_width =
         dumped_buffer.getWidth() ? dumped_buffer.getWidth() : gfxGetBackBufferWidth(gfx_);
     uint32_t dump_buffer_height =
@@ -58,6 +113,17 @@ void CapsaicinInternal::dumpBuffer(char const *dump_file_path, GfxTexture dumped
     GfxBuffer dump_buffer = gfxCreateBuffer(gfx_, dump_buffer_size, nullptr, kGfxCpuAccess_Read);
     dump_buffer.setName("Capsaicin_DumpBuffer");
 
+    copyToDumpBuffer(dumped_buffer, dump_copy_buffer, dump_buffer, dump_buffer_width, dump_buffer_height);
+
+    gfxDestroyBuffer(gfx_, dump_copy_buffer);
+
+    dump_in_flight_buffers_.push_back(
+        {dump_buffer, dump_buffer_width, dump_buffer_height, dump_file_path, frame_index_});
+}
+
+void CapsaicinInternal::copyToDumpBuffer(GfxTexture dumped_buffer, GfxBuffer dump_copy_buffer,
+    GfxBuffer dump_buffer, uint32_t dump_buffer_width, uint32_t dump_buffer_height)
+{
     gfxProgramSetParameter(gfx_, dump_copy_to_buffer_program_, "g_BufferDimensions",
         glm::uvec2(dump_buffer_width, dump_buffer_height));
     gfxProgramSetParameter(gfx_, dump_copy_to_buffer_program_, "g_DumpedBuffer", dumped_buffer);
@@ -71,144 +137,104 @@ void CapsaicinInternal::dumpBuffer(char const *dump_file_path, GfxTexture dumped
     gfxCommandDispatch(gfx_, num_groups_x, num_groups_y, 1);
 
     gfxCommandCopyBuffer(gfx_, dump_buffer, dump_copy_buffer);
-
-    gfxDestroyBuffer(gfx_, dump_copy_buffer);
-
-    dump_in_flight_buffers_.push_back(
-        {dump_buffer, dump_buffer_width, dump_buffer_height, dump_file_path, frame_index_});
 }
 
-void CapsaicinInternal::saveImage(
-    GfxBuffer dump_buffer, uint32_t dump_buffer_width, uint32_t dump_buffer_height, char const *file_path)
+void CapsaicinInternal::captureFrame()
 {
-    char const *extension = strrchr(file_path, '.');
-    if (extension != nullptr
-        && (strcmp(extension, ".jpg") == 0 || strcmp(extension, ".jpeg") == 0
-            || strcmp(extension, ".JPG") == 0 || strcmp(extension, ".JPEG") == 0))
-    {
-        saveJPG(dump_buffer, dump_buffer_width, dump_buffer_height, file_path);
-    }
-    else
+    if (frame_capture_path_.empty())
     {
-        saveEXR(dump_buffer, dump_buffer_width, dump_buffer_height, file_path);
+        return;
     }
-}
+    CAPSAICIN_PROFILE_SCOPE("CaptureFrame");
 
-void CapsaicinInternal::saveEXR(
-    GfxBuffer dump_buffer, uint32_t dump_buffer_width, uint32_t dump_buffer_height, char const *exr_file_path)
-{
-    char const channel_names[] = {'B', 'G', 'R'};
-    int const  channel_count   = ARRAYSIZE(channel_names);
-    static_assert(channel_count > 0 && channel_count <= 3);
-
-    // Header
-    std::vector<EXRChannelInfo> channel_infos;
-    std::vector<int>            pixel_types;
-    std::vector<int>            requested_pixel_types;
-    for (char channel_name : channel_names)
+    // Append the frames whose read back has completed
+    ++frame_capture_submit_index_;
+    while (!frame_capture_in_flight_.empty()
+           && frame_capture_submit_index_
+                  > std::get<2>(frame_capture_in_flight_.front()) + kGfxConstant_BackBufferCount)
     {
-        auto &channel_info   = channel_infos.emplace_back();
-        channel_info.name[0] = channel_name;
-        channel_info.name[1] = '\0';
-        pixel_types.push_back(TINYEXR_PIXELTYPE_FLOAT);
-        requested_pixel_types.push_back(TINYEXR_PIXELTYPE_FLOAT);
+        appendCapturedFrame();
     }
 
-    EXRHeader exr_header;
-    InitEXRHeader(&exr_header);
-    exr_header.compression_type      = TINYEXR_COMPRESSIONTYPE_PIZ;
-    exr_header.num_channels          = channel_count;
-    exr_header.channels              = &channel_infos[0];
-    exr_header.pixel_types           = &pixel_types[0];
-    exr_header.requested_pixel_types = &requested_pixel_types[0];
-
-    // Image
-    float const   *dump_buffer_data  = (float *)gfxBufferGetData(gfx_, dump_buffer);
-    const uint32_t image_width       = dump_buffer_width;
-    const uint32_t image_height      = dump_buffer_height;
-    const uint32_t image_pixel_count = dump_buffer_width * dump_buffer_height;
-
-    std::vector<std::vector<float>> image_channels;
-    std::vector<unsigned char *>    images;
-    for (char channel_name : channel_names)
+    // Copy the captured AOV into a read back buffer, once per rendered frame
+    if (frame_capture_remaining_ > 0 && frame_index_ >= frame_capture_first_ && frame_index_ != frame_capture_last_
+        && hasAOVBuffer(frame_capture_aov_))
     {
-        int dump_channel_offset = 0;
-        switch (channel_name)
-        {
-        case 'R': dump_channel_offset = 0; break;
-        case 'G': dump_channel_offset = 1; break;
-        case 'B': dump_channel_offset = 2; break;
-        default: assert(false);
-        }
-
-        auto &image_channel = image_channels.emplace_back();
-        image_channel.resize(image_pixel_count * sizeof(float));
-        images.push_back((unsigned char *)&image_channel[0]);
-        for (size_t pixel_index = 0; pixel_index < image_pixel_count; ++pixel_index)
+        GfxTexture const aov    = getAOVBuffer(frame_capture_aov_);
+        uint32_t const   width  = aov.getWidth() ? aov.getWidth() : gfxGetBackBufferWidth(gfx_);
+        uint32_t const   height = aov.getHeight() ? aov.getHeight() : gfxGetBackBufferHeight(gfx_);
+        if (!frame_capture_.isOpen())
         {
-            image_channel[pixel_index] = dump_buffer_data[4 * pixel_index + dump_channel_offset];
+            if (!frame_capture_.open(
+                    frame_capture_path_.c_str(), width, height, frame_capture_encoding_, frame_capture_remaining_))
+            {
+                GFX_PRINTLN("Error: Failed to open frame capture '%s'", frame_capture_path_.c_str());
+                stopFrameCapture();
+                return;
+            }
+            frame_capture_width_  = width;
+            frame_capture_height_ = height;
         }
-    }
-
-    EXRImage exr_image;
-    InitEXRImage(&exr_image);
-    exr_image.num_channels = channel_count;
-    exr_image.images       = &images[0];
-    exr_image.width        = image_width;
-    exr_image.height       = image_height;
-
-    char const *exr_err = nullptr;
-    int         ret     = SaveEXRImageToFile(&exr_image, &exr_header, exr_file_path, &exr_err);
-
-    if (ret != TINYEXR_SUCCESS)
-    {
-        if (exr_err != nullptr)
+        if (width != frame_capture_width_ || height != frame_capture_height_)
         {
-            GFX_PRINT_ERROR(kGfxResult_InternalError, "Can't save '%s': %s", exr_file_path, exr_err);
-            FreeEXRErrorMessage(exr_err);
+            GFX_PRINTLN("Warning: Frame capture stopped as the captured AOV was resized");
+            frame_capture_remaining_ = 0;
         }
         else
         {
-            GFX_PRINT_ERROR(kGfxResult_InternalError, "Can't save '%s'", exr_file_path);
+            uint64_t const buffer_size = (uint64_t)width * height * 4 * sizeof(float);
+            if (!frame_capture_copy_buffer_)
+            {
+                frame_capture_copy_buffer_ = gfxCreateBuffer(gfx_, buffer_size, nullptr, kGfxCpuAccess_None);
+                frame_capture_copy_buffer_.setName("Capsaicin_CaptureCopyBuffer");
+            }
+            GfxBuffer capture_buffer;
+            if (!frame_capture_buffers_.empty())
+            {
+                capture_buffer = frame_capture_buffers_.back();
+                frame_capture_buffers_.pop_back();
+            }
+            else
+            {
+                capture_buffer = gfxCreateBuffer(gfx_, buffer_size, nullptr, kGfxCpuAccess_Read);
+                capture_buffer.setName("Capsaicin_CaptureBuffer");
+            }
+            const GfxCommandEvent command_event(gfx_, "Capture AOV '%s'", frame_capture_aov_.c_str());
+            copyToDumpBuffer(aov, frame_capture_copy_buffer_, capture_buffer, width, height);
+            frame_capture_in_flight_.emplace_back(capture_buffer, frame_index_, frame_capture_submit_index_);
+            frame_capture_last_ = frame_index_;
+            --frame_capture_remaining_;
         }
     }
-}
-
-void CapsaicinInternal::saveJPG(
-    GfxBuffer dump_buffer, uint32_t dump_buffer_width, uint32_t dump_buffer_height, char const *jpg_file_path)
-{
-    // Image
-    float const   *dump_buffer_data  = (float *)gfxBufferGetData(gfx_, dump_buffer);
-    const uint32_t image_width       = dump_buffer_width;
-    const uint32_t image_height      = dump_buffer_height;
-    const uint32_t image_pixel_count = dump_buffer_width * dump_buffer_height;
-
-    std::vector<unsigned char> image_data;
-    image_data.resize((size_t)image_width * image_height * 3);
 
-    for (size_t pixel_index = 0; pixel_index < image_pixel_count; ++pixel_index)
+    if (frame_capture_remaining_ == 0 && frame_capture_in_flight_.empty())
     {
-        auto quantize = [dump_buffer_data, pixel_index](uint32_t channel_offset) {
-            return (unsigned char)glm::floor(
-                glm::clamp(dump_buffer_data[4 * pixel_index + channel_offset], 0.f, 1.f) * 255.f);
-        };
-
-        image_data[3 * pixel_index + 0] = quantize(0);
-        image_data[3 * pixel_index + 1] = quantize(1);
-        image_data[3 * pixel_index + 2] = quantize(2);
+        stopFrameCapture();
     }
+}
 
-    int ret = stbi_write_jpg(jpg_file_path, image_width, image_height, 3, image_data.data(), 90);
-    if (ret == 0)
+void CapsaicinInternal::appendCapturedFrame()
+{
+    auto const [capture_buffer, capture_frame_index, capture_submit_index] = frame_capture_in_flight_.front();
+    frame_capture_in_flight_.pop_front();
+    if (frame_capture_.isOpen()
+        && !frame_capture_.append(
+            capture_frame_index, static_cast<float const *>(gfxBufferGetData(gfx_, capture_buffer))))
     {
-        GFX_PRINT_ERROR(kGfxResult_InternalError, "Can't save '%s'", jpg_file_path);
+        GFX_PRINTLN("Error: Failed to write frame %u to frame capture '%s'", capture_frame_index,
+            frame_capture_path_.c_str());
+        frame_capture_remaining_ = 0;
     }
+    // The read back buffer is recycled for the following frames
+    frame_capture_buffers_.push_back(capture_buffer);
 }
 
 // clang-format off
 
 void CapsaicinInternal::dumpCamera(char const *json_file_path, CameraMatrices const &camera_matrices, float camera_jitter_x, float camera_jitter_y)
 {
+    CAPSAICIN_PROFILE_SCOPE("DumpCamera");
+
     const auto& _c = getCamera();
     const auto& _0 = camera_matrices.view;
 #if 0
@@ -0,0 +1,1749 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "capsaicin_internal.h"
+
+#include "parallel_algorithms.h"
+#include "scene_flattener.h"
+#include "scene_hash.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+namespace Capsaicin
+{
+namespace
+{
+/**
+ * Get the number of elements to allocate for a scene buffer.
+ * Some headroom is added so that objects streamed in later can be appended without a full rebuild.
+ * @param count The number of elements currently required.
+ * @returns The number of elements to allocate.
+ */
+uint32_t GetSceneBufferCapacity(uint32_t count) noexcept
+{
+    return count + (count >> 3) + 1;
+}
+
+constexpr float kAnimationDiscoveryRate = 30.0f; /**< Rate unbaked animations are sampled at to find what they drive */
+
+/**
+ * Hash the raw bytes of a flattened GPU object.
+ * @param value The object to hash.
+ * @returns The hash value.
+ */
+template<typename TYPE>
+size_t HashBytes(TYPE const &value) noexcept
+{
+    return std::hash<std::string_view> {}(
+        std::string_view(reinterpret_cast<char const *>(&value), sizeof(TYPE)));
+}
+
+Material MakeMaterial(GfxMaterial const &material) noexcept
+{
+    Material ret = {};
+
+    ret.albedo = float4(float3(material.albedo), glm::uintBitsToFloat((uint32_t)material.albedo_map));
+    ret.emissivity =
+        float4(material.emissivity, glm::uintBitsToFloat((uint32_t)material.emissivity_map));
+    ret.metallicity_roughness = float4(material.metallicity,
+        glm::uintBitsToFloat((uint32_t)material.metallicity_map), material.roughness,
+        glm::uintBitsToFloat((uint32_t)material.roughness_map));
+    ret.normal_alpha_side = float4(glm::uintBitsToFloat((uint32_t)material.normal_map), material.albedo.w,
+        glm::uintBitsToFloat((uint32_t)((material.flags & kGfxMaterialFlag_DoubleSided) != 0)), 0.0f);
+
+    return ret;
+}
+
+/**
+ * Hash the source files of a scene so that cached data can be matched to them.
+ * The scene files themselves are hashed by content (in parallel chunks). The files they reference (buffers,
+ * textures, material libraries) only contribute their size and modification time.
+ * @param file_paths The scene files.
+ * @returns The hash value (0 if a file could not be read).
+ */
+size_t HashSceneFiles(std::vector<std::string> const &file_paths) noexcept
+{
+    constexpr uint64_t kChunkSize = 4 << 20;
+
+    size_t hash = 0x5CE4Eu;
+    for (std::string const &file_path : file_paths)
+    {
+        MappedFile file;
+        if (!file.open(file_path.c_str()))
+        {
+            return 0;
+        }
+        uint32_t const      chunk_count = (uint32_t)((file.getSize() + kChunkSize - 1) / kChunkSize);
+        std::vector<size_t> chunk_hashes(chunk_count);
+        ThreadPool().Dispatch(
+            [&](uint32_t i) {
+                uint64_t const offset = i * kChunkSize;
+                chunk_hashes[i]       = std::hash<std::string_view> {}(
+                    std::string_view(reinterpret_cast<char const *>(file.getData()) + offset,
+                        (size_t)glm::min(kChunkSize, file.getSize() - offset)));
+            },
+            chunk_count, 1);
+        HashCombine(hash, file.getSize());
+        for (size_t chunk_hash : chunk_hashes)
+        {
+            HashCombine(hash, chunk_hash);
+        }
+
+        // The referenced files only contribute their size and modification time, a missing file still changes
+        // the key so that the cache is rebuilt once it is restored
+        std::filesystem::path const directory = std::filesystem::path(file_path).parent_path();
+        for (std::string const &reference : GetSceneFileReferences(file_path.c_str()))
+        {
+            std::error_code ec;
+            HashCombine(hash, std::filesystem::path(reference).lexically_relative(directory).generic_string());
+            HashCombine(hash, (uint64_t)std::filesystem::file_size(reference, ec));
+            HashCombine(hash, (int64_t)std::filesystem::last_write_time(reference, ec).time_since_epoch().count());
+        }
+    }
+    return hash != 0 ? hash : 1;
+}
+
+/**
+ * Create the GPU texture for a scene image and record the upload of its contents.
+ * @param gfx       Active gfx context.
+ * @param scene     The scene owning the image.
+ * @param image_ref The image to create the texture for.
+ * @returns The created texture and the number of uploaded bytes.
+ */
+std::pair<GfxTexture, uint64_t> CreateImageTexture(
+    GfxContext gfx, GfxScene scene, GfxConstRef<GfxImage> image_ref) noexcept
+{
+    DXGI_FORMAT    format         = image_ref->format;
+    uint32_t       image_width    = image_ref->width;
+    uint32_t       image_height   = image_ref->height;
+    uint32_t const image_mips     = gfxCalculateMipCount(image_width, image_height);
+    uint32_t const image_channels = image_ref->channel_count;
+
+    GfxTexture texture = gfxCreateTexture2D(gfx, image_width, image_height, format, image_mips);
+    texture.setName(gfxSceneGetObjectMetadata<GfxImage>(scene, image_ref).getObjectName());
+
+    if (!image_ref->width || !image_ref->height)
+    {
+        gfxCommandClearTexture(gfx, texture);
+        return {texture, 0};
+    }
+
+    uint8_t const *image_data = image_ref->data.data();
+
+    const uint64_t uncompressed_size =
+        (uint64_t)image_width * image_height * image_channels * image_ref->bytes_per_channel;
+    uint64_t texture_size =
+        !gfxImageIsFormatCompressed(*image_ref) ? uncompressed_size : image_ref->data.size();
+    bool const mips = image_ref->flags & kGfxImageFlag_HasMipLevels;
+    if (mips && !gfxImageIsFormatCompressed(*image_ref))
+    {
+        texture_size += texture_size / 3;
+    }
+    texture_size           = GFX_MIN(texture_size, image_ref->data.size());
+    GfxBuffer texture_data = gfxCreateBuffer(gfx, texture_size, image_data, kGfxCpuAccess_Write);
+
+    gfxCommandCopyBufferToTexture(gfx, texture, texture_data);
+    if (!mips && !gfxImageIsFormatCompressed(*image_ref)) gfxCommandGenerateMips(gfx, texture);
+    gfxDestroyBuffer(gfx, texture_data);
+
+    return {texture, texture_size};
+}
+
+/**
+ * Create the GPU texture for a scene image and queue its upload on the texture streamer.
+ * A 1x1 placeholder holding the image's average texel is returned and used until the upload completes, images
+ * the streamer does not support are uploaded straight away.
+ * @param gfx       Active gfx context.
+ * @param scene     The scene owning the image.
+ * @param image_ref The image to create the texture for.
+ * @param streamer  The texture streamer.
+ * @returns The texture to use for now and the number of uploaded bytes.
+ */
+std::pair<GfxTexture, uint64_t> CreateStreamedImageTexture(
+    GfxContext gfx, GfxScene scene, GfxConstRef<GfxImage> image_ref, TextureStreamer &streamer) noexcept
+{
+    if (!TextureStreamer::IsSupported(*image_ref))
+    {
+        return CreateImageTexture(gfx, scene, image_ref);
+    }
+
+    DXGI_FORMAT const format     = image_ref->format;
+    char const       *image_name = gfxSceneGetObjectMetadata<GfxImage>(scene, image_ref).getObjectName();
+    GfxTexture        texture    = gfxCreateTexture2D(
+        gfx, image_ref->width, image_ref->height, format, gfxCalculateMipCount(image_ref->width, image_ref->height));
+    texture.setName(image_name);
+    streamer.request((uint32_t)image_ref, texture, *image_ref);
+
+    // The placeholder uses the same format so that sRGB decoding is unchanged
+    MipFormat mip_format = MipFormat::Unorm8;
+    switch (image_ref->bytes_per_channel)
+    {
+    case 2: mip_format = MipFormat::Unorm16; break;
+    case 4: mip_format = MipFormat::Float32; break;
+    default:
+        mip_format = format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB || format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB
+                       ? MipFormat::Unorm8Srgb
+                       : MipFormat::Unorm8;
+        break;
+    }
+    uint64_t const texel_size = (uint64_t)image_ref->channel_count * image_ref->bytes_per_channel;
+    uint8_t        texel[16]  = {};
+    ComputeAverageTexel(texel, image_ref->data.data(), image_ref->width, image_ref->height,
+        image_ref->channel_count, mip_format);
+
+    GfxTexture placeholder = gfxCreateTexture2D(gfx, 1, 1, format);
+    placeholder.setName(image_name);
+    GfxBuffer texel_data = gfxCreateBuffer(gfx, texel_size, texel, kGfxCpuAccess_Write);
+    gfxCommandCopyBufferToTexture(gfx, placeholder, texel_data);
+    gfxDestroyBuffer(gfx, texel_data);
+
+    return {placeholder, texel_size};
+}
+
+/**
+ * Record the upload of a sparse set of array elements, runs of consecutive elements are merged into a single copy.
+ * @param gfx     Active gfx context.
+ * @param buffer  The destination buffer.
+ * @param staging The staging memory (must be large enough to hold all uploaded elements).
+ * @param data    The source array.
+ * @param indices The sorted indices of the elements to upload.
+ */
+template<typename TYPE>
+void ScatterUpload(GfxContext gfx, GfxBuffer const &buffer, CapsaicinInternal::UploadAllocation const &staging,
+    TYPE const *data, std::vector<uint32_t> const &indices) noexcept
+{
+    TYPE *staging_data = (TYPE *)staging.data;
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        staging_data[i] = data[indices[i]];
+    }
+    for (size_t first = 0; first < indices.size();)
+    {
+        size_t last = first;
+        while (last + 1 < indices.size() && indices[last + 1] == indices[last] + 1)
+        {
+            ++last;
+        }
+        gfxCommandCopyBuffer(gfx, buffer, indices[first] * sizeof(TYPE), staging.buffer,
+            staging.offset + first * sizeof(TYPE), (last - first + 1) * sizeof(TYPE));
+        first = last + 1;
+    }
+}
+
+/** View of the vertex and index data of a mesh as uploaded to the GPU, i.e., after any optimization. */
+struct SceneMeshView
+{
+    GfxMesh const       *mesh;      /**< The source mesh */
+    OptimizedMesh const *optimized; /**< The optimized remapping of the source mesh (nullptr if unoptimized) */
+
+    uint32_t getVertexCount() const noexcept
+    {
+        return (uint32_t)(optimized != nullptr ? optimized->vertices.size() : mesh->vertices.size());
+    }
+
+    uint32_t getIndexCount() const noexcept
+    {
+        return (uint32_t)(optimized != nullptr ? optimized->indices.size() : mesh->indices.size());
+    }
+
+    GfxVertex const &getVertex(uint32_t index) const noexcept
+    {
+        return mesh->vertices[optimized != nullptr ? optimized->vertices[index] : index];
+    }
+
+    uint32_t const *getIndices() const noexcept
+    {
+        return optimized != nullptr ? optimized->indices.data() : mesh->indices.data();
+    }
+};
+
+/** A list of buffer sub-range writes that are uploaded together through a single staging buffer. */
+class SceneUploadList
+{
+public:
+    /**
+     * Record a write to a buffer sub-range.
+     * @param buffer The destination buffer.
+     * @param offset The destination offset (in bytes).
+     * @param data   The data to write (copied immediately).
+     * @param size   The size of the data (in bytes).
+     */
+    void add(GfxBuffer const &buffer, uint64_t offset, void const *data, uint64_t size) noexcept
+    {
+        uint64_t const data_offset = reserve(buffer, offset, size);
+        if (size > 0)
+        {
+            memcpy(getData(data_offset), data, size);
+        }
+    }
+
+    /**
+     * Record a write to a buffer sub-range whose contents are filled in later.
+     * @param buffer The destination buffer.
+     * @param offset The destination offset (in bytes).
+     * @param size   The size of the data (in bytes).
+     * @returns The offset of the reserved staging memory, see getData().
+     */
+    uint64_t reserve(GfxBuffer const &buffer, uint64_t offset, uint64_t size) noexcept
+    {
+        uint64_t const data_offset = data_.size();
+        if (size == 0)
+        {
+            return data_offset;
+        }
+        data_.resize(data_offset + size);
+        // Merge with previous write if both are contiguous
+        if (!uploads_.empty())
+        {
+            Upload &last = uploads_.back();
+            if (last.buffer == &buffer && last.buffer_offset + last.size == offset)
+            {
+                last.size += size;
+                return data_offset;
+            }
+        }
+        uploads_.push_back({&buffer, offset, data_offset, size});
+        return data_offset;
+    }
+
+    /**
+     * Get the staging memory for a reserved write.
+     * @note The returned pointer is invalidated by the next call to add() or reserve().
+     * @param data_offset The offset returned by reserve().
+     * @returns The staging memory.
+     */
+    uint8_t *getData(uint64_t data_offset) noexcept { return data_.data() + data_offset; }
+
+    /**
+     * Record the copy commands for all pending writes.
+     * @param gfx Active gfx context.
+     * @returns The number of uploaded bytes.
+     */
+    uint64_t submit(GfxContext gfx) noexcept
+    {
+        uint64_t const upload_size = data_.size();
+        if (upload_size > 0)
+        {
+            GfxBuffer staging_buffer = gfxCreateBuffer(gfx, upload_size, data_.data(), kGfxCpuAccess_Write);
+            for (auto const &upload : uploads_)
+            {
+                gfxCommandCopyBuffer(
+                    gfx, *upload.buffer, upload.buffer_offset, staging_buffer, upload.data_offset, upload.size);
+            }
+            gfxDestroyBuffer(gfx, staging_buffer);
+        }
+        uploads_.clear();
+        data_.clear();
+        return upload_size;
+    }
+
+private:
+    struct Upload
+    {
+        GfxBuffer const *buffer;        /**< The destination buffer */
+        uint64_t         buffer_offset; /**< The destination offset (in bytes) */
+        uint64_t         data_offset;   /**< The source offset into the staging data (in bytes) */
+        uint64_t         size;          /**< The size of the write (in bytes) */
+    };
+
+    std::vector<Upload>  uploads_; /**< The list of pending writes */
+    std::vector<uint8_t> data_;    /**< The staging data for all pending writes */
+};
+} // unnamed namespace
+
+void CapsaicinInternal::buildScene() noexcept
+{
+    CAPSAICIN_PROFILE_SCOPE("BuildScene");
+
+    auto const build_start = std::chrono::high_resolution_clock::now();
+    destroyScene();
+
+    // Size the scene buffers to the current scene (plus some headroom)
+    GfxMesh const   *meshes     = gfxSceneGetObjects<GfxMesh>(scene_);
+    glm::uvec3 const mesh_sizes = ParallelTransformReduce(
+        gfxSceneGetObjectCount<GfxMesh>(scene_), glm::uvec3(0),
+        [&](uint32_t i) {
+            return glm::uvec3((uint32_t)gfxSceneGetObjectHandle<GfxMesh>(scene_, i) + 1,
+                (uint32_t)meshes[i].vertices.size(), (uint32_t)meshes[i].indices.size());
+        },
+        [](glm::uvec3 const &lhs, glm::uvec3 const &rhs) {
+            return glm::uvec3(glm::max(lhs.x, rhs.x), lhs.y + rhs.y, lhs.z + rhs.z);
+        });
+    uint32_t const mesh_count     = mesh_sizes.x;
+    uint32_t const vertex_count   = mesh_sizes.y;
+    uint32_t const index_count    = mesh_sizes.z;
+    uint32_t const material_count = ParallelTransformReduce(
+        gfxSceneGetObjectCount<GfxMaterial>(scene_), 0u,
+        [&](uint32_t i) { return (uint32_t)gfxSceneGetObjectHandle<GfxMaterial>(scene_, i) + 1; },
+        [](uint32_t lhs, uint32_t rhs) { return glm::max(lhs, rhs); });
+    uint32_t const instance_count = ParallelTransformReduce(
+        gfxSceneGetObjectCount<GfxInstance>(scene_), 0u,
+        [&](uint32_t i) { return (uint32_t)gfxSceneGetObjectHandle<GfxInstance>(scene_, i) + 1; },
+        [](uint32_t lhs, uint32_t rhs) { return glm::max(lhs, rhs); });
+
+    mesh_buffer_           = gfxCreateBuffer<Mesh>(gfx_, GetSceneBufferCapacity(mesh_count));
+    index_buffer_          = gfxCreateBuffer<uint32_t>(gfx_, GetSceneBufferCapacity(index_count));
+    vertex_buffer_         = vertex_layout_compact_
+                               ? gfxCreateBuffer<CompactVertex>(gfx_, GetSceneBufferCapacity(vertex_count))
+                               : gfxCreateBuffer<Vertex>(gfx_, GetSceneBufferCapacity(vertex_count));
+    material_buffer_       = gfxCreateBuffer<Material>(gfx_, GetSceneBufferCapacity(material_count));
+    instance_buffer_       = gfxCreateBuffer<Instance>(gfx_, GetSceneBufferCapacity(instance_count));
+    transform_buffer_      = gfxCreateBuffer<glm::mat4x3>(gfx_, GetSceneBufferCapacity(instance_count));
+    prev_transform_buffer_ = gfxCreateBuffer<glm::mat4x3>(gfx_, GetSceneBufferCapacity(instance_count));
+
+    mesh_buffer_.setName("Capsaicin_MeshBuffer");
+    index_buffer_.setName("Capsaicin_IndexBuffer");
+    vertex_buffer_.setName("Capsaicin_VertexBuffer");
+    material_buffer_.setName("Capsaicin_MaterialBuffer");
+    instance_buffer_.setName("Capsaicin_InstanceBuffer");
+    transform_buffer_.setName("Capsaicin_TransformBuffer");
+    prev_transform_buffer_.setName("Capsaicin_PrevTransformBuffer");
+
+    // NVIDIA-specific fix
+    if (gfx_.getVendorId() == 0x10DEu) // NVIDIA
+    {
+        vertex_buffer_.setStride(4);
+    }
+
+    acceleration_structure_ = gfxCreateAccelerationStructure(gfx_);
+    acceleration_structure_.setName("Capsaicin_AccelerationStructure");
+
+    // Meshes and materials found in the scene cache are marked as up to date so only the remaining objects
+    // (images, instances and acceleration structure) are built from the scene
+    scene_cache_hit_ = scene_cache_.isOpen() && loadSceneCache();
+    scene_cache_.close();
+
+    // With empty tracking state every object is considered new and gets uploaded
+    if (!updateScene())
+    {
+        GFX_PRINTLN("Error: Failed to build scene data");
+    }
+    else if (scene_cache_write_)
+    {
+        saveSceneCache();
+    }
+    scene_cache_write_ = false;
+
+    if (scene_build_pending_)
+    {
+        scene_build_time_ =
+            std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - build_start).count();
+        scene_build_pending_ = false;
+        GFX_PRINTLN("Loaded scene in %.1f ms (import %.1f ms, build %.1f ms%s)", getSceneLoadTime() * 1000.0,
+            scene_import_time_ * 1000.0, scene_build_time_ * 1000.0, scene_cache_hit_ ? ", cached" : "");
+        if (timing_statistics_enabled_)
+        {
+            // A load happens once so is collected even during warm up, cached and uncached loads are kept apart
+            timing_statistics_.addSample(
+                scene_cache_hit_ ? "Scene Load (cached)" : "Scene Load (uncached)", getSceneLoadTime() * 1000.0);
+        }
+    }
+}
+
+bool CapsaicinInternal::updateScene() noexcept
+{
+    CAPSAICIN_PROFILE_SCOPE("UpdateScene");
+
+    if (!acceleration_structure_)
+    {
+        return false; // no existing scene data to update
+    }
+
+    GfxMesh const     *meshes         = gfxSceneGetObjects<GfxMesh>(scene_);
+    uint32_t const     mesh_count     = gfxSceneGetObjectCount<GfxMesh>(scene_);
+    GfxMaterial const *materials      = gfxSceneGetObjects<GfxMaterial>(scene_);
+    uint32_t const     material_count = gfxSceneGetObjectCount<GfxMaterial>(scene_);
+    GfxInstance const *instances      = gfxSceneGetObjects<GfxInstance>(scene_);
+    uint32_t const     instance_count = gfxSceneGetObjectCount<GfxInstance>(scene_);
+    uint32_t const     image_count    = gfxSceneGetObjectCount<GfxImage>(scene_);
+
+    uint64_t const mesh_capacity     = mesh_buffer_.getSize() / sizeof(Mesh);
+    uint64_t const index_capacity    = index_buffer_.getSize() / sizeof(uint32_t);
+    uint64_t const vertex_stride     = vertex_layout_compact_ ? sizeof(CompactVertex) : sizeof(Vertex);
+    uint64_t const vertex_capacity   = vertex_buffer_.getSize() / vertex_stride;
+    uint64_t const material_capacity = material_buffer_.getSize() / sizeof(Material);
+    uint64_t const instance_capacity = instance_buffer_.getSize() / sizeof(Instance);
+
+    // Find the meshes that changed and check that they still fit in the existing buffers
+    std::vector<size_t> mesh_hashes(mesh_count);
+    for (uint32_t i = 0; i < mesh_count; ++i)
+    {
+        mesh_hashes[i] = scene_changes_.getGeneration(
+            SceneChangeTracker::ObjectType::Mesh, gfxSceneGetObjectHandle<GfxMesh>(scene_, i));
+    }
+
+    std::vector<uint8_t>  mesh_dirty(mesh_capacity, 0);
+    std::vector<uint32_t> dirty_meshes;
+    for (uint32_t i = 0; i < mesh_count; ++i)
+    {
+        uint32_t const mesh_index = gfxSceneGetObjectHandle<GfxMesh>(scene_, i);
+        if (mesh_index >= mesh_capacity)
+        {
+            return false;
+        }
+        bool const known = mesh_index < mesh_states_.size() && mesh_states_[mesh_index].valid;
+        if (known && mesh_states_[mesh_index].hash == mesh_hashes[i])
+        {
+            continue;
+        }
+        mesh_dirty[mesh_index] = 1;
+        dirty_meshes.push_back(i);
+    }
+    if (mesh_optimization_ && !dirty_meshes.empty())
+    {
+        optimizeMeshes(dirty_meshes);
+    }
+    auto const getMeshView = [&](uint32_t mesh_index, GfxMesh const &mesh) {
+        return SceneMeshView {&mesh, getOptimizedMesh(mesh_index)};
+    };
+
+    uint64_t append_vertex_count = 0;
+    uint64_t append_index_count  = 0;
+    for (uint32_t i : dirty_meshes)
+    {
+        uint32_t const      mesh_index = gfxSceneGetObjectHandle<GfxMesh>(scene_, i);
+        SceneMeshView const mesh       = getMeshView(mesh_index, meshes[i]);
+        if (mesh_index >= mesh_states_.size() || mesh.getVertexCount() > mesh_states_[mesh_index].vertex_capacity
+            || mesh.getIndexCount() > mesh_states_[mesh_index].index_capacity)
+        {
+            // Mesh no longer fits in its previous slot so gets appended
+            append_vertex_count += mesh.getVertexCount();
+            append_index_count += mesh.getIndexCount();
+        }
+    }
+    if (vertex_data_.size() + append_vertex_count > vertex_capacity
+        || index_data_.size() + append_index_count > index_capacity)
+    {
+        return false;
+    }
+
+    // Find the materials that changed
+    std::vector<uint8_t>                      material_dirty(material_capacity, 0);
+    std::vector<std::pair<uint32_t, Material>> dirty_materials;
+    for (uint32_t i = 0; i < material_count; ++i)
+    {
+        uint32_t const material_index = gfxSceneGetObjectHandle<GfxMaterial>(scene_, i);
+        if (material_index >= material_capacity)
+        {
+            return false;
+        }
+        Material const material = MakeMaterial(materials[i]);
+        if (material_index < material_states_.size() && material_states_[material_index].valid
+            && material_states_[material_index].hash == HashBytes(material))
+        {
+            continue;
+        }
+        material_dirty[material_index] = 1;
+        dirty_materials.emplace_back(material_index, material);
+    }
+
+    // Find the instances that changed, this includes any instance referencing a changed mesh or material
+    std::vector<uint32_t> dirty_instances;
+    for (uint32_t i = 0; i < instance_count; ++i)
+    {
+        uint32_t const instance_index = gfxSceneGetObjectHandle<GfxInstance>(scene_, i);
+        if (instance_index >= instance_capacity)
+        {
+            return false;
+        }
+        Instance instance        = {};
+        instance.mesh_index      = (uint32_t)instances[i].mesh;
+        instance.material_index  = (uint32_t)instances[i].material;
+        instance.transform_index = instance_index;
+        if (instance_index < instance_states_.size() && instance_states_[instance_index].valid
+            && instance_states_[instance_index].hash == HashBytes(instance)
+            && (instance.mesh_index >= mesh_dirty.size() || !mesh_dirty[instance.mesh_index])
+            && (instance.material_index >= material_dirty.size() || !material_dirty[instance.material_index]))
+        {
+            continue;
+        }
+        dirty_instances.push_back(i);
+    }
+
+    // Everything fits so patch the existing data
+    SceneUploadList uploads;
+    uint64_t        texture_upload_size = 0;
+
+    // Update the images
+    {
+        std::vector<uint8_t> image_present(image_states_.size(), 0);
+        for (uint32_t i = 0; i < image_count; ++i)
+        {
+            GfxConstRef<GfxImage> image_ref   = gfxSceneGetObjectHandle<GfxImage>(scene_, i);
+            uint32_t const        image_index = (uint32_t)image_ref;
+            size_t const          image_hash =
+                scene_changes_.getGeneration(SceneChangeTracker::ObjectType::Image, image_index);
+
+            if (image_index >= image_states_.size())
+            {
+                image_states_.resize((size_t)image_index + 1);
+                image_present.resize((size_t)image_index + 1, 0);
+            }
+            if (image_index >= texture_atlas_.size())
+            {
+                texture_atlas_.resize((size_t)image_index + 1);
+            }
+            image_present[image_index] = 1;
+
+            SceneObjectState &state = image_states_[image_index];
+            if (state.valid && state.hash == image_hash)
+            {
+                continue;
+            }
+
+            texture_streamer_.cancel(image_index);
+            gfxDestroyTexture(gfx_, texture_atlas_[image_index]);
+            auto const [texture, upload_size] =
+                texture_streamer_.isInitialized()
+                    ? CreateStreamedImageTexture(gfx_, scene_, image_ref, texture_streamer_)
+                    : CreateImageTexture(gfx_, scene_, image_ref);
+            texture_atlas_[image_index]       = texture;
+            texture_upload_size += upload_size;
+            state.hash  = image_hash;
+            state.valid = true;
+        }
+
+        // Release the images that were removed from the scene
+        for (size_t i = 0; i < image_states_.size(); ++i)
+        {
+            if (image_states_[i].valid && !image_present[i])
+            {
+                texture_streamer_.cancel((uint32_t)i);
+                gfxDestroyTexture(gfx_, texture_atlas_[i]);
+                texture_atlas_[i]     = {};
+                image_states_[i].valid = false;
+            }
+        }
+    }
+
+    // Update the materials
+    for (auto const &[material_index, material] : dirty_materials)
+    {
+        if (material_index >= material_data_.size())
+        {
+            material_data_.resize((size_t)material_index + 1);
+            material_states_.resize((size_t)material_index + 1);
+        }
+        material_data_[material_index]  = material;
+        material_states_[material_index] = {HashBytes(material), 0, 0, 0, true};
+        uploads.add(material_buffer_, material_index * sizeof(Material), &material, sizeof(Material));
+    }
+
+    // Update the meshes
+    {
+        std::vector<uint8_t> mesh_present(mesh_states_.size(), 0);
+        for (uint32_t i = 0; i < mesh_count; ++i)
+        {
+            uint32_t const mesh_index = gfxSceneGetObjectHandle<GfxMesh>(scene_, i);
+            if (mesh_index < mesh_present.size())
+            {
+                mesh_present[mesh_index] = 1;
+            }
+        }
+        for (size_t i = 0; i < mesh_states_.size(); ++i)
+        {
+            if (!mesh_present[i])
+            {
+                mesh_states_[i].valid = false; // slot is kept reserved but no longer referenced
+            }
+        }
+    }
+    // Assign every dirty mesh its location in the global buffers, meshes that no longer fit their previous
+    // slot get appended (i.e., a prefix sum over the sizes of the appended meshes)
+    uint64_t const vertex_data_size = vertex_data_.size();
+    uint64_t const index_data_size  = index_data_.size();
+    uint64_t       vertex_offset    = vertex_data_size;
+    uint64_t       index_offset     = index_data_size;
+    for (uint32_t i : dirty_meshes)
+    {
+        uint32_t const mesh_index   = gfxSceneGetObjectHandle<GfxMesh>(scene_, i);
+        uint32_t const vertex_count = getMeshView(mesh_index, meshes[i]).getVertexCount();
+        uint32_t const index_count  = getMeshView(mesh_index, meshes[i]).getIndexCount();
+
+        if (mesh_index >= mesh_data_.size())
+        {
+            mesh_data_.resize((size_t)mesh_index + 1);
+        }
+        if (mesh_index >= mesh_states_.size())
+        {
+            mesh_states_.resize((size_t)mesh_index + 1);
+        }
+
+        Mesh             &mesh  = mesh_data_[mesh_index];
+        SceneObjectState &state = mesh_states_[mesh_index];
+        if (vertex_count > state.vertex_capacity || index_count > state.index_capacity)
+        {
+            mesh.vertex_offset_idx = (uint32_t)vertex_offset;
+            mesh.index_offset_idx  = (uint32_t)index_offset;
+            state.vertex_capacity  = vertex_count;
+            state.index_capacity   = index_count;
+            vertex_offset += vertex_count;
+            index_offset += index_count;
+        }
+        mesh.index_count   = index_count;
+        state.vertex_count = vertex_count;
+        state.hash         = mesh_hashes[i];
+        state.valid        = true;
+    }
+    vertex_data_.resize(vertex_offset);
+    index_data_.resize(index_offset);
+
+    // Reserve the staging memory for all vertex and index writes, these are sorted by buffer so that
+    // consecutive meshes get merged into a single copy
+    std::vector<uint64_t> vertex_staging_offsets(dirty_meshes.size());
+    std::vector<uint64_t> index_staging_offsets(dirty_meshes.size());
+    for (size_t i = 0; i < dirty_meshes.size(); ++i)
+    {
+        uint32_t const mesh_index = gfxSceneGetObjectHandle<GfxMesh>(scene_, dirty_meshes[i]);
+        Mesh const    &mesh       = mesh_data_[mesh_index];
+        vertex_staging_offsets[i] = uploads.reserve(vertex_buffer_, mesh.vertex_offset_idx * vertex_stride,
+            getMeshView(mesh_index, meshes[dirty_meshes[i]]).getVertexCount() * vertex_stride);
+    }
+    for (size_t i = 0; i < dirty_meshes.size(); ++i)
+    {
+        uint32_t const mesh_index = gfxSceneGetObjectHandle<GfxMesh>(scene_, dirty_meshes[i]);
+        Mesh const    &mesh       = mesh_data_[mesh_index];
+        index_staging_offsets[i]  = uploads.reserve(index_buffer_, mesh.index_offset_idx * sizeof(uint32_t),
+            getMeshView(mesh_index, meshes[dirty_meshes[i]]).getIndexCount() * sizeof(uint32_t));
+    }
+
+    // Convert the vertices and indices in parallel, writing straight into the final arrays and staging memory
+    auto const flatten_start = std::chrono::high_resolution_clock::now();
+    FlattenMeshes(
+        (uint32_t)dirty_meshes.size(),
+        [&](uint32_t dirty_mesh) {
+            uint32_t const      mesh_index = gfxSceneGetObjectHandle<GfxMesh>(scene_, dirty_meshes[dirty_mesh]);
+            SceneMeshView const gfx_mesh   = getMeshView(mesh_index, meshes[dirty_meshes[dirty_mesh]]);
+            return std::max(gfx_mesh.getVertexCount(), gfx_mesh.getIndexCount());
+        },
+        [&](uint32_t dirty_mesh, uint32_t first, uint32_t last) {
+            uint32_t const      mesh_index = gfxSceneGetObjectHandle<GfxMesh>(scene_, dirty_meshes[dirty_mesh]);
+            SceneMeshView const gfx_mesh   = getMeshView(mesh_index, meshes[dirty_meshes[dirty_mesh]]);
+            Mesh const         &mesh       = mesh_data_[mesh_index];
+            uint32_t const      vertex_end = glm::min(last, gfx_mesh.getVertexCount());
+            uint32_t const      index_end  = glm::min(last, gfx_mesh.getIndexCount());
+
+            Vertex  *vertices       = vertex_data_.data() + mesh.vertex_offset_idx;
+            uint8_t *vertex_staging = uploads.getData(vertex_staging_offsets[dirty_mesh]);
+            if (vertex_layout_compact_)
+            {
+                for (uint32_t j = first; j < vertex_end; ++j)
+                {
+                    vertices[j] = MakeVertex(gfx_mesh.getVertex(j));
+                    reinterpret_cast<CompactVertex *>(vertex_staging)[j] = MakeCompactVertex(vertices[j]);
+                }
+            }
+            else
+            {
+                for (uint32_t j = first; j < vertex_end; ++j)
+                {
+                    vertices[j]                                   = MakeVertex(gfx_mesh.getVertex(j));
+                    reinterpret_cast<Vertex *>(vertex_staging)[j] = vertices[j];
+                }
+            }
+            if (first < index_end)
+            {
+                uint64_t const  size    = (index_end - first) * sizeof(uint32_t);
+                uint32_t const *indices = gfx_mesh.getIndices() + first;
+                memcpy(&index_data_[(size_t)mesh.index_offset_idx + first], indices, size);
+                memcpy(uploads.getData(index_staging_offsets[dirty_mesh]) + first * sizeof(uint32_t), indices, size);
+            }
+        });
+    auto const flatten_end = std::chrono::high_resolution_clock::now();
+
+    if (!dirty_meshes.empty())
+    {
+        uint64_t flattened_vertex_count = 0;
+        for (uint32_t i : dirty_meshes)
+        {
+            flattened_vertex_count +=
+                getMeshView(gfxSceneGetObjectHandle<GfxMesh>(scene_, i), meshes[i]).getVertexCount();
+        }
+        double const flatten_time = std::chrono::duration<double>(flatten_end - flatten_start).count();
+        scene_flatten_rate_       = flatten_time > 0.0 ? flattened_vertex_count / flatten_time : 0.0;
+    }
+
+    for (uint32_t i : dirty_meshes)
+    {
+        uint32_t const mesh_index = gfxSceneGetObjectHandle<GfxMesh>(scene_, i);
+        uploads.add(mesh_buffer_, mesh_index * sizeof(Mesh), &mesh_data_[mesh_index], sizeof(Mesh));
+    }
+
+    // Release the instances that were removed from the scene
+    {
+        std::vector<uint8_t> instance_present(instance_states_.size(), 0);
+        for (uint32_t i = 0; i < instance_count; ++i)
+        {
+            uint32_t const instance_index = gfxSceneGetObjectHandle<GfxInstance>(scene_, i);
+            if (instance_index < instance_present.size())
+            {
+                instance_present[instance_index] = 1;
+            }
+        }
+        for (size_t i = 0; i < instance_states_.size(); ++i)
+        {
+            if (instance_states_[i].valid && !instance_present[i])
+            {
+                gfxDestroyRaytracingPrimitive(gfx_, raytracing_primitives_[i]);
+                raytracing_primitives_[i] = {};
+                instance_states_[i].valid = false;
+            }
+        }
+    }
+
+    // Update the instances
+    for (uint32_t i : dirty_instances)
+    {
+        GfxConstRef<GfxMesh>     mesh_ref       = instances[i].mesh;
+        GfxConstRef<GfxMaterial> material_ref   = instances[i].material;
+        uint32_t const           instance_index = gfxSceneGetObjectHandle<GfxInstance>(scene_, i);
+
+        Instance instance        = {};
+        instance.mesh_index      = (uint32_t)mesh_ref;
+        instance.material_index  = (uint32_t)material_ref;
+        instance.transform_index = instance_index;
+
+        if (instance_index >= instance_data_.size())
+        {
+            instance_data_.resize((size_t)instance_index + 1);
+            instance_states_.resize((size_t)instance_index + 1);
+            instance_min_bounds_.resize((size_t)instance_index + 1);
+            instance_max_bounds_.resize((size_t)instance_index + 1);
+            raytracing_primitives_.resize((size_t)instance_index + 1);
+        }
+        if (instance.transform_index >= transform_data_.size())
+        {
+            transform_data_.resize((size_t)instance.transform_index + 1);
+            prev_transform_data_.resize((size_t)instance.transform_index + 1);
+        }
+
+        bool const is_new = !instance_states_[instance_index].valid;
+
+        instance_data_[instance_index]   = instance;
+        instance_states_[instance_index] = {HashBytes(instance), 0, 0, 0, true};
+        uploads.add(instance_buffer_, instance_index * sizeof(Instance), &instance, sizeof(Instance));
+
+        if (is_new)
+        {
+            // New instances have no motion history
+            transform_data_[instance.transform_index]      = instances[i].transform;
+            prev_transform_data_[instance.transform_index] = instances[i].transform;
+            uploads.add(prev_transform_buffer_, instance.transform_index * sizeof(glm::mat4x3),
+                &prev_transform_data_[instance.transform_index], sizeof(glm::mat4x3));
+        }
+
+        if (!mesh_ref)
+        {
+            continue;
+        }
+
+        // (Re)build the raytracing primitive from the mesh's current location in the global buffers
+        Mesh const    &mesh         = mesh_data_[(uint32_t)mesh_ref];
+        uint32_t const index_count  = mesh.index_count;
+        uint32_t const vertex_count = mesh_states_[(uint32_t)mesh_ref].vertex_count;
+
+        GfxRaytracingPrimitive &rt_mesh = raytracing_primitives_[instance_index];
+        if (!rt_mesh)
+        {
+            rt_mesh = gfxCreateRaytracingPrimitive(gfx_, acceleration_structure_);
+        }
+
+        GfxBuffer index_buffer =
+            gfxCreateBufferRange<uint32_t>(gfx_, index_buffer_, mesh.index_offset_idx, index_count);
+        GfxBuffer vertex_buffer =
+            vertex_layout_compact_
+                ? gfxCreateBufferRange<CompactVertex>(gfx_, vertex_buffer_, mesh.vertex_offset_idx, vertex_count)
+                : gfxCreateBufferRange<Vertex>(gfx_, vertex_buffer_, mesh.vertex_offset_idx, vertex_count);
+
+        uint32_t non_opaque =
+            !material_ref
+                    || (material_ref->albedo.w >= 1.0f
+                        && (!material_ref->albedo_map
+                            || (material_ref->albedo_map->flags & kGfxImageFlag_HasAlphaChannel) == 0))
+                ? kGfxBuildRaytracingPrimitiveFlag_Opaque
+                : 0;
+
+        gfxRaytracingPrimitiveBuild(gfx_, rt_mesh, index_buffer, vertex_buffer, 0, non_opaque);
+
+        glm::mat4 const row_major_transform = glm::transpose(instances[i].transform);
+
+        gfxRaytracingPrimitiveSetTransform(gfx_, rt_mesh, &row_major_transform[0][0]);
+        gfxRaytracingPrimitiveSetInstanceID(gfx_, rt_mesh, instance_index);
+        gfxRaytracingPrimitiveSetInstanceContributionToHitGroupIndex(
+            gfx_, rt_mesh, instance_index * sbt_stride_in_entries_[kGfxShaderGroupType_Hit]);
+
+        gfxDestroyBuffer(gfx_, index_buffer);
+        gfxDestroyBuffer(gfx_, vertex_buffer);
+    }
+
+    scene_upload_bytes_ = uploads.submit(gfx_) + texture_upload_size;
+
+    gfxAccelerationStructureUpdate(gfx_, acceleration_structure_);
+
+    return true;
+}
+
+void CapsaicinInternal::updateTransformHistory() noexcept
+{
+    CAPSAICIN_PROFILE_SCOPE("UpdateTransformHistory");
+
+    if (dirty_transforms_.empty())
+    {
+        return; // current and previous transforms are already identical
+    }
+
+    GfxCommandEvent const command_event(gfx_, "UpdatePreviousTranforms");
+
+    // The previous data becomes the current data, which is then brought up to date with last frame's changes
+    std::swap(transform_data_, prev_transform_data_);
+    std::swap(transform_buffer_, prev_transform_buffer_);
+    for (uint32_t transform_index : dirty_transforms_)
+    {
+        transform_data_[transform_index] = prev_transform_data_[transform_index];
+    }
+    UploadAllocation const staging = allocateUploadMemory(dirty_transforms_.size() * sizeof(glm::mat4x3));
+    ScatterUpload(gfx_, transform_buffer_, staging, transform_data_.data(), dirty_transforms_);
+
+    dirty_transforms_.clear();
+}
+
+void CapsaicinInternal::updateTransforms(bool full_update) noexcept
+{
+    CAPSAICIN_PROFILE_SCOPE("UpdateTransforms");
+
+    using ObjectType = SceneChangeTracker::ObjectType;
+
+    GfxInstance const *instances      = gfxSceneGetObjects<GfxInstance>(scene_);
+    uint32_t const     instance_count = gfxSceneGetObjectCount<GfxInstance>(scene_);
+
+    // Map the instance handles back to scene objects, this only changes when instances are added
+    if (full_update || scene_changes_.hasChanges(ObjectType::Instance))
+    {
+        instance_object_indices_.assign(instance_data_.size(), ~0u);
+        for (uint32_t i = 0; i < instance_count; ++i)
+        {
+            uint32_t const instance_index = gfxSceneGetObjectHandle<GfxInstance>(scene_, i);
+            if (instance_index < instance_object_indices_.size())
+            {
+                instance_object_indices_[instance_index] = i;
+            }
+        }
+    }
+
+    // Gather the instances to update, sorted so that neighbouring transforms get uploaded together
+    dirty_transforms_.clear();
+    if (full_update)
+    {
+        for (uint32_t i = 0; i < (uint32_t)instance_object_indices_.size(); ++i)
+        {
+            if (instance_object_indices_[i] != ~0u)
+            {
+                dirty_transforms_.push_back(i);
+            }
+        }
+    }
+    else
+    {
+        // Instances bound to a different mesh need their bounds recomputed even if their transform is unchanged
+        for (ObjectType type : {ObjectType::Transform, ObjectType::Instance})
+        {
+            for (uint32_t instance_index : scene_changes_.getDirty(type))
+            {
+                if (instance_index < instance_object_indices_.size()
+                    && instance_object_indices_[instance_index] != ~0u)
+                {
+                    dirty_transforms_.push_back(instance_index);
+                }
+            }
+        }
+        dirty_transform_sort_.sort(dirty_transforms_.data(), (uint)dirty_transforms_.size());
+        dirty_transforms_.erase(
+            std::unique(dirty_transforms_.begin(), dirty_transforms_.end()), dirty_transforms_.end());
+    }
+    if (dirty_transforms_.empty())
+    {
+        return;
+    }
+
+    // Update the transforms of the changed instances only
+    transform_bounds_batch_.clear();
+    for (uint32_t instance_index : dirty_transforms_)
+    {
+        GfxInstance const &instance = instances[instance_object_indices_[instance_index]];
+        GFX_ASSERT(instance_data_[instance_index].transform_index == instance_index);
+
+        transform_data_[instance_index] = instance.transform;
+
+        if (instance.mesh)
+        {
+            transform_bounds_batch_.add(
+                instance_index, instance.mesh->bounds_min, instance.mesh->bounds_max, instance.transform);
+        }
+
+        glm::mat4 const row_major_transform = glm::transpose(instance.transform);
+
+        gfxRaytracingPrimitiveSetTransform(
+            gfx_, raytracing_primitives_[instance_index], &row_major_transform[0][0]);
+    }
+    transform_bounds_batch_.compute(instance_min_bounds_.data(), instance_max_bounds_.data());
+
+    // Update our acceleration structure
+    {
+        GfxCommandEvent const command_event(gfx_, "UpdateTLAS");
+
+        UploadAllocation const staging = allocateUploadMemory(dirty_transforms_.size() * sizeof(glm::mat4x3));
+        ScatterUpload(gfx_, transform_buffer_, staging, transform_data_.data(), dirty_transforms_);
+        gfxAccelerationStructureUpdate(gfx_, acceleration_structure_);
+    }
+}
+
+void CapsaicinInternal::optimizeMeshes(std::vector<uint32_t> const &dirty_meshes) noexcept
+{
+    GfxMesh const *meshes     = gfxSceneGetObjects<GfxMesh>(scene_);
+    size_t const   fetch_size = vertex_layout_compact_ ? sizeof(CompactVertex) : sizeof(Vertex);
+
+    // Identify the meshes by their contents so that cached results survive reloads and duplicates are shared
+    std::vector<size_t> keys(dirty_meshes.size());
+    ThreadPool().Dispatch(
+        [&](uint32_t i) {
+            size_t key = std::hash<GfxMesh> {}(meshes[dirty_meshes[i]]);
+            HashCombine(key, fetch_size);
+            keys[i] = key;
+        },
+        (uint32_t)dirty_meshes.size(), 1);
+
+    // Insertion does not invalidate references to existing cache entries, so they can be filled in in parallel
+    std::vector<std::pair<uint32_t, OptimizedMesh *>> missing_meshes;
+    for (uint32_t i = 0; i < (uint32_t)dirty_meshes.size(); ++i)
+    {
+        auto const [it, inserted] = optimized_mesh_cache_.try_emplace(keys[i]);
+        if (inserted)
+        {
+            missing_meshes.emplace_back(dirty_meshes[i], &it->second);
+        }
+    }
+
+    auto const optimize_start = std::chrono::high_resolution_clock::now();
+    ThreadPool().Dispatch(
+        [&](uint32_t i) {
+            GfxMesh const &mesh = meshes[missing_meshes[i].first];
+            OptimizeMesh(*missing_meshes[i].second, mesh.vertices.data(), (uint32_t)mesh.vertices.size(),
+                sizeof(GfxVertex), mesh.indices.data(), (uint32_t)mesh.indices.size(), fetch_size);
+        },
+        (uint32_t)missing_meshes.size(), 1);
+    auto const optimize_end = std::chrono::high_resolution_clock::now();
+
+    for (uint32_t i = 0; i < (uint32_t)dirty_meshes.size(); ++i)
+    {
+        uint32_t const mesh_index = gfxSceneGetObjectHandle<GfxMesh>(scene_, dirty_meshes[i]);
+        if (mesh_index >= mesh_optimizations_.size())
+        {
+            mesh_optimizations_.resize((size_t)mesh_index + 1, nullptr);
+            mesh_optimization_keys_.resize((size_t)mesh_index + 1, 0);
+        }
+        mesh_optimizations_[mesh_index]     = &optimized_mesh_cache_[keys[i]];
+        mesh_optimization_keys_[mesh_index] = keys[i];
+    }
+
+    if (missing_meshes.empty())
+    {
+        return; // everything was already cached
+    }
+
+    MeshStats before, after;
+    getMeshOptimizationStats(before, after);
+    GFX_PRINTLN("Optimized %zu meshes in %.1f ms (vertices %u -> %u, ACMR %.3f -> %.3f, overfetch %.3f -> %.3f)",
+        missing_meshes.size(), std::chrono::duration<double, std::milli>(optimize_end - optimize_start).count(),
+        before.vertex_count, after.vertex_count, before.acmr, after.acmr, before.overfetch, after.overfetch);
+
+    // Save the meshes used by the scene so that the next load skips the optimization
+    std::string const cache_path = getOptimizedMeshCachePath();
+    if (!cache_path.empty())
+    {
+        std::vector<size_t> cache_keys;
+        for (uint32_t i = 0; i < gfxSceneGetObjectCount<GfxMesh>(scene_); ++i)
+        {
+            uint32_t const mesh_index = gfxSceneGetObjectHandle<GfxMesh>(scene_, i);
+            if (getOptimizedMesh(mesh_index) != nullptr)
+            {
+                cache_keys.push_back(mesh_optimization_keys_[mesh_index]);
+            }
+        }
+        std::sort(cache_keys.begin(), cache_keys.end());
+        cache_keys.erase(std::unique(cache_keys.begin(), cache_keys.end()), cache_keys.end());
+        if (!SaveOptimizedMeshCache(optimized_mesh_cache_, cache_keys, cache_path.c_str()))
+        {
+            GFX_PRINTLN("Warning: Failed to save optimized mesh cache '%s'", cache_path.c_str());
+        }
+    }
+}
+
+std::string CapsaicinInternal::getOptimizedMeshCachePath() const noexcept
+{
+    return !scene_files_.empty() ? scene_files_.front() + ".meshopt" : std::string();
+}
+
+void CapsaicinInternal::openSceneCache() noexcept
+{
+    scene_cache_.close();
+    scene_cache_write_   = false;
+    scene_cache_hit_     = false;
+    scene_build_pending_ = true;
+    scene_build_time_    = 0.0;
+    if (!scene_cache_enabled_ || scene_files_.empty())
+    {
+        return;
+    }
+
+    // The cached data depends on the build options as well as on the source files
+    size_t key = HashSceneFiles(scene_files_);
+    if (key == 0)
+    {
+        return;
+    }
+    HashCombine(key, SceneCache::kVersion);
+    HashCombine(key, vertex_layout_compact_);
+    HashCombine(key, mesh_optimization_);
+    HashCombine(key, sizeof(Mesh));
+    HashCombine(key, sizeof(Vertex));
+    HashCombine(key, sizeof(Material));
+    scene_cache_key_ = key;
+
+    std::string const cache_path = getSceneCachePath();
+    scene_cache_write_           = !scene_cache_.open(cache_path.c_str(), scene_cache_key_);
+}
+
+bool CapsaicinInternal::loadSceneCache() noexcept
+{
+    uint64_t mesh_count = 0, state_count = 0, index_count = 0, vertex_count = 0, gpu_vertex_count = 0,
+             material_count = 0, key_count = 0;
+    Mesh const *meshes = scene_cache_.getSection<Mesh>(SceneCache::Section::Meshes, mesh_count);
+    SceneCache::MeshState const *states =
+        scene_cache_.getSection<SceneCache::MeshState>(SceneCache::Section::MeshStates, state_count);
+    uint32_t const *indices  = scene_cache_.getSection<uint32_t>(SceneCache::Section::Indices, index_count);
+    Vertex const   *vertices = scene_cache_.getSection<Vertex>(SceneCache::Section::Vertices, vertex_count);
+    uint8_t const  *gpu_vertices =
+        scene_cache_.getSection<uint8_t>(SceneCache::Section::GpuVertices, gpu_vertex_count);
+    Material const *materials = scene_cache_.getSection<Material>(SceneCache::Section::Materials, material_count);
+    uint64_t const *mesh_keys = scene_cache_.getSection<uint64_t>(SceneCache::Section::MeshKeys, key_count);
+    uint64_t const  vertex_stride = vertex_layout_compact_ ? sizeof(CompactVertex) : sizeof(Vertex);
+
+    // The key guarantees that the cache was built from the same files, so only check that the cached data is
+    // consistent with the imported scene and fits in the scene buffers
+    if (state_count != mesh_count || mesh_count * sizeof(Mesh) > mesh_buffer_.getSize()
+        || index_count * sizeof(uint32_t) > index_buffer_.getSize()
+        || vertex_count * vertex_stride > vertex_buffer_.getSize()
+        || material_count * sizeof(Material) > material_buffer_.getSize()
+        || (vertex_layout_compact_ && gpu_vertex_count != vertex_count * sizeof(CompactVertex))
+        || (key_count != 0 && key_count != mesh_count))
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < gfxSceneGetObjectCount<GfxMesh>(scene_); ++i)
+    {
+        uint32_t const mesh_index = gfxSceneGetObjectHandle<GfxMesh>(scene_, i);
+        if (mesh_index >= mesh_count || !states[mesh_index].valid
+            || meshes[mesh_index].vertex_offset_idx + (uint64_t)states[mesh_index].vertex_capacity > vertex_count
+            || meshes[mesh_index].index_offset_idx + (uint64_t)states[mesh_index].index_capacity > index_count)
+        {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < gfxSceneGetObjectCount<GfxMaterial>(scene_); ++i)
+    {
+        if (gfxSceneGetObjectHandle<GfxMaterial>(scene_, i) >= material_count)
+        {
+            return false;
+        }
+    }
+
+    // The CPU copies back partial updates and the scene data getters, so fill them in the same pass that writes
+    // the staging memory, the mapped sections are read once and sent with a single staging buffer
+    mesh_data_.resize(mesh_count);
+    index_data_.resize(index_count);
+    vertex_data_.resize(vertex_count);
+    material_data_.resize(material_count);
+    struct CacheUpload
+    {
+        GfxBuffer const *buffer;         /**< Destination GPU buffer (nullptr if the section isn't uploaded) */
+        void const      *data;           /**< Section data in the mapped cache file */
+        void            *cpu_copy;       /**< Destination CPU copy (nullptr if none) */
+        uint64_t         size;           /**< Size of the section (in bytes) */
+        uint64_t         staging_offset; /**< Offset of the section in the staging buffer */
+    };
+    std::vector<CacheUpload> cache_uploads;
+    cache_uploads.push_back({&mesh_buffer_, meshes, mesh_data_.data(), mesh_count * sizeof(Mesh), 0});
+    cache_uploads.push_back({&index_buffer_, indices, index_data_.data(), index_count * sizeof(uint32_t), 0});
+    if (vertex_layout_compact_)
+    {
+        cache_uploads.push_back({&vertex_buffer_, gpu_vertices, nullptr, gpu_vertex_count, 0});
+        cache_uploads.push_back({nullptr, vertices, vertex_data_.data(), vertex_count * sizeof(Vertex), 0});
+    }
+    else
+    {
+        cache_uploads.push_back({&vertex_buffer_, vertices, vertex_data_.data(), vertex_count * sizeof(Vertex), 0});
+    }
+    cache_uploads.push_back(
+        {&material_buffer_, materials, material_data_.data(), material_count * sizeof(Material), 0});
+
+    constexpr uint64_t                         kChunkSize   = 1 << 20;
+    uint64_t                                   staging_size = 0;
+    std::vector<std::pair<uint32_t, uint64_t>> chunks; // (upload, offset) of each copied chunk
+    for (uint32_t i = 0; i < (uint32_t)cache_uploads.size(); ++i)
+    {
+        CacheUpload &upload = cache_uploads[i];
+        if (upload.buffer != nullptr)
+        {
+            upload.staging_offset = staging_size;
+            staging_size += upload.size;
+        }
+        for (uint64_t offset = 0; offset < upload.size; offset += kChunkSize)
+        {
+            chunks.emplace_back(i, offset);
+        }
+    }
+    GfxBuffer staging_buffer =
+        staging_size > 0 ? gfxCreateBuffer(gfx_, staging_size, nullptr, kGfxCpuAccess_Write) : GfxBuffer();
+    uint8_t *staging_data = staging_size > 0 ? gfxBufferGetData<uint8_t>(gfx_, staging_buffer) : nullptr;
+    if (staging_size > 0 && staging_data == nullptr)
+    {
+        gfxDestroyBuffer(gfx_, staging_buffer);
+        mesh_data_.clear();
+        index_data_.clear();
+        vertex_data_.clear();
+        material_data_.clear();
+        return false;
+    }
+    ThreadPool().Dispatch(
+        [&](uint32_t i) {
+            CacheUpload const &upload = cache_uploads[chunks[i].first];
+            uint64_t const     offset = chunks[i].second;
+            uint64_t const     size   = glm::min(kChunkSize, upload.size - offset);
+            uint8_t const     *data   = static_cast<uint8_t const *>(upload.data) + offset;
+            if (upload.buffer != nullptr)
+            {
+                memcpy(staging_data + upload.staging_offset + offset, data, size);
+            }
+            if (upload.cpu_copy != nullptr)
+            {
+                memcpy(static_cast<uint8_t *>(upload.cpu_copy) + offset, data, size);
+            }
+        },
+        (uint32_t)chunks.size(), 1);
+    for (CacheUpload const &upload : cache_uploads)
+    {
+        if (upload.buffer != nullptr && upload.size > 0)
+        {
+            gfxCommandCopyBuffer(gfx_, *upload.buffer, 0, staging_buffer, upload.staging_offset, upload.size);
+        }
+    }
+    gfxDestroyBuffer(gfx_, staging_buffer);
+
+    // Mark the cached objects as up to date
+    mesh_states_.resize(mesh_count);
+    for (uint32_t i = 0; i < (uint32_t)mesh_count; ++i)
+    {
+        SceneObjectState &state = mesh_states_[i];
+        state.hash              = scene_changes_.getGeneration(SceneChangeTracker::ObjectType::Mesh, i);
+        state.vertex_count      = states[i].vertex_count;
+        state.vertex_capacity   = states[i].vertex_capacity;
+        state.index_capacity    = states[i].index_capacity;
+        state.valid             = states[i].valid != 0;
+    }
+    material_states_.resize(material_count);
+    for (uint32_t i = 0; i < gfxSceneGetObjectCount<GfxMaterial>(scene_); ++i)
+    {
+        uint32_t const material_index    = gfxSceneGetObjectHandle<GfxMaterial>(scene_, i);
+        material_states_[material_index] = {HashBytes(material_data_[material_index]), 0, 0, 0, true};
+    }
+    if (mesh_optimization_)
+    {
+        // Optimization statistics are restored from the optimized mesh cache when available
+        mesh_optimizations_.resize(key_count, nullptr);
+        mesh_optimization_keys_.assign(mesh_keys, mesh_keys + key_count);
+        for (uint32_t i = 0; i < (uint32_t)key_count; ++i)
+        {
+            auto const it = optimized_mesh_cache_.find((size_t)mesh_keys[i]);
+            if (states[i].valid && it != optimized_mesh_cache_.end())
+            {
+                mesh_optimizations_[i] = &it->second;
+            }
+        }
+    }
+
+    return true;
+}
+
+void CapsaicinInternal::saveSceneCache() noexcept
+{
+    std::vector<SceneCache::MeshState> states(mesh_states_.size());
+    for (size_t i = 0; i < mesh_states_.size(); ++i)
+    {
+        SceneObjectState const &state = mesh_states_[i];
+        states[i] = {state.vertex_count, state.vertex_capacity, state.index_capacity, state.valid ? 1u : 0u};
+    }
+    std::vector<CompactVertex> gpu_vertices;
+    if (vertex_layout_compact_)
+    {
+        gpu_vertices.resize(vertex_data_.size());
+        ThreadPool().Dispatch(
+            [&](uint32_t i) { gpu_vertices[i] = MakeCompactVertex(vertex_data_[i]); },
+            (uint32_t)vertex_data_.size(), 4096);
+    }
+    std::vector<uint64_t> mesh_keys;
+    if (mesh_optimization_)
+    {
+        mesh_keys.assign(mesh_optimization_keys_.begin(), mesh_optimization_keys_.end());
+        mesh_keys.resize(mesh_data_.size(), 0);
+    }
+
+    SceneCache::SectionData sections[(size_t)SceneCache::Section::Count];
+    sections[(size_t)SceneCache::Section::Meshes]      = {mesh_data_.data(), mesh_data_.size() * sizeof(Mesh)};
+    sections[(size_t)SceneCache::Section::MeshStates]  = {states.data(), states.size() * sizeof(states[0])};
+    sections[(size_t)SceneCache::Section::Indices]     = {index_data_.data(), index_data_.size() * sizeof(uint32_t)};
+    sections[(size_t)SceneCache::Section::Vertices]    = {vertex_data_.data(), vertex_data_.size() * sizeof(Vertex)};
+    sections[(size_t)SceneCache::Section::GpuVertices] = {
+        gpu_vertices.data(), gpu_vertices.size() * sizeof(CompactVertex)};
+    sections[(size_t)SceneCache::Section::Materials] = {
+        material_data_.data(), material_data_.size() * sizeof(Material)};
+    sections[(size_t)SceneCache::Section::MeshKeys] = {mesh_keys.data(), mesh_keys.size() * sizeof(uint64_t)};
+
+    std::string const cache_path = getSceneCachePath();
+    if (!SceneCache::Write(cache_path.c_str(), scene_cache_key_, sections))
+    {
+        GFX_PRINTLN("Warning: Failed to save scene cache '%s'", cache_path.c_str());
+    }
+}
+
+std::string CapsaicinInternal::getSceneCachePath() const noexcept
+{
+    return !scene_files_.empty() ? scene_files_.front() + ".scenecache" : std::string();
+}
+
+void CapsaicinInternal::detectSceneChanges(bool full_scan) noexcept
+{
+    CAPSAICIN_PROFILE_SCOPE("DetectSceneChanges");
+
+    using ObjectType = SceneChangeTracker::ObjectType;
+
+    // Mesh, material and image data is only modified when loading a scene, later edits are reported by
+    // markMeshChanged(), markMaterialChanged() and markImageChanged()
+    if (full_scan)
+    {
+        for (uint32_t i = 0; i < gfxSceneGetObjectCount<GfxMesh>(scene_); ++i)
+        {
+            uint32_t const mesh_index = gfxSceneGetObjectHandle<GfxMesh>(scene_, i);
+            if (!scene_changes_.isTracked(ObjectType::Mesh, mesh_index))
+            {
+                scene_changes_.markChanged(ObjectType::Mesh, mesh_index);
+            }
+        }
+        for (uint32_t i = 0; i < gfxSceneGetObjectCount<GfxMaterial>(scene_); ++i)
+        {
+            uint32_t const material_index = gfxSceneGetObjectHandle<GfxMaterial>(scene_, i);
+            if (!scene_changes_.isTracked(ObjectType::Material, material_index))
+            {
+                scene_changes_.markChanged(ObjectType::Material, material_index);
+            }
+        }
+        for (uint32_t i = 0; i < gfxSceneGetObjectCount<GfxImage>(scene_); ++i)
+        {
+            uint32_t const image_index = gfxSceneGetObjectHandle<GfxImage>(scene_, i);
+            if (!scene_changes_.isTracked(ObjectType::Image, image_index))
+            {
+                scene_changes_.markChanged(ObjectType::Image, image_index);
+            }
+        }
+    }
+
+    // Compare the instances against their previous state, gfx does not report which nodes an animation touched
+    // so the instances it may drive were found when sampling the animations
+    GfxInstance const *instances      = gfxSceneGetObjects<GfxInstance>(scene_);
+    uint32_t const     instance_count = gfxSceneGetObjectCount<GfxInstance>(scene_);
+    uint32_t const     check_count    = full_scan ? instance_count : (uint32_t)animated_instances_.size();
+    if (full_scan)
+    {
+        uint32_t const instance_end = ParallelTransformReduce(
+            instance_count, 0u,
+            [&](uint32_t i) { return (uint32_t)gfxSceneGetObjectHandle<GfxInstance>(scene_, i) + 1; },
+            [](uint32_t lhs, uint32_t rhs) { return glm::max(lhs, rhs); });
+        if (instance_end > instance_snapshots_.size())
+        {
+            instance_snapshots_.resize(instance_end);
+        }
+    }
+
+    constexpr uint8_t    kInstanceChanged  = 1;
+    constexpr uint8_t    kTransformChanged = 2;
+    std::vector<uint8_t> instance_changes(check_count, 0);
+    auto const           getObjectIndex = [&](uint32_t i) { return full_scan ? i : animated_instances_[i]; };
+    ThreadPool().Dispatch(
+        [&](uint32_t i) {
+            uint32_t const object_index = getObjectIndex(i);
+            if (object_index >= instance_count)
+            {
+                return;
+            }
+            uint32_t const instance_index = gfxSceneGetObjectHandle<GfxInstance>(scene_, object_index);
+            if (instance_index >= instance_snapshots_.size())
+            {
+                return; // instances are only added by loading a scene
+            }
+            InstanceSnapshot &snapshot = instance_snapshots_[instance_index];
+            bool const        is_new   = !scene_changes_.isTracked(ObjectType::Instance, instance_index);
+            if (is_new || snapshot.mesh_index != (uint32_t)instances[object_index].mesh
+                || snapshot.material_index != (uint32_t)instances[object_index].material)
+            {
+                snapshot.mesh_index     = (uint32_t)instances[object_index].mesh;
+                snapshot.material_index = (uint32_t)instances[object_index].material;
+                instance_changes[i] |= kInstanceChanged;
+            }
+            if (is_new || snapshot.transform != instances[object_index].transform)
+            {
+                snapshot.transform = instances[object_index].transform;
+                instance_changes[i] |= kTransformChanged;
+            }
+        },
+        check_count, 256);
+    for (uint32_t i = 0; i < check_count; ++i)
+    {
+        if (instance_changes[i] != 0)
+        {
+            uint32_t const instance_index = gfxSceneGetObjectHandle<GfxInstance>(scene_, getObjectIndex(i));
+            if ((instance_changes[i] & kInstanceChanged) != 0)
+            {
+                scene_changes_.markChanged(ObjectType::Instance, instance_index);
+            }
+            if ((instance_changes[i] & kTransformChanged) != 0)
+            {
+                scene_changes_.markChanged(ObjectType::Transform, instance_index);
+            }
+        }
+    }
+
+    // Compare the lights against their previous state
+    GfxLight const *lights            = gfxSceneGetObjects<GfxLight>(scene_);
+    uint32_t const  light_count       = gfxSceneGetObjectCount<GfxLight>(scene_);
+    uint32_t const  check_light_count = full_scan ? light_count : (uint32_t)animated_lights_.size();
+    for (uint32_t j = 0; j < check_light_count; ++j)
+    {
+        uint32_t const i = full_scan ? j : animated_lights_[j];
+        if (i >= light_count)
+        {
+            continue;
+        }
+        uint32_t const light_index = gfxSceneGetObjectHandle<GfxLight>(scene_, i);
+        if (light_index >= light_snapshots_.size())
+        {
+            light_snapshots_.resize((size_t)light_index + 1);
+        }
+        GfxLight       &snapshot = light_snapshots_[light_index];
+        GfxLight const &light    = lights[i];
+        if (!scene_changes_.isTracked(ObjectType::Light, light_index) || snapshot.type != light.type
+            || snapshot.color != light.color || snapshot.intensity != light.intensity
+            || snapshot.position != light.position || snapshot.direction != light.direction
+            || snapshot.range != light.range || snapshot.inner_cone_angle != light.inner_cone_angle
+            || snapshot.outer_cone_angle != light.outer_cone_angle)
+        {
+            snapshot = light;
+            scene_changes_.markChanged(ObjectType::Light, light_index);
+        }
+    }
+}
+
+void CapsaicinInternal::bakeAnimations() noexcept
+{
+    animation_evaluator_.clear();
+    unbaked_animations_.clear();
+    animated_instances_.clear();
+    animated_lights_.clear();
+    animation_bake_time_ = 0.0;
+    uint32_t const animation_count = gfxSceneGetAnimationCount(scene_);
+    if (animation_count == 0)
+    {
+        return;
+    }
+    auto const  bake_start  = std::chrono::high_resolution_clock::now();
+    float const sample_rate = animation_sample_rate_ > 0.0f ? animation_sample_rate_ : kAnimationDiscoveryRate;
+
+    // Keep the imported state so that it can be restored once sampling is done
+    uint32_t const         instance_count = gfxSceneGetObjectCount<GfxInstance>(scene_);
+    uint32_t const         camera_count   = gfxSceneGetCameraCount(scene_);
+    uint32_t const         light_count    = gfxSceneGetObjectCount<GfxLight>(scene_);
+    std::vector<glm::mat4> rest_transforms(instance_count);
+    std::vector<GfxCamera> rest_cameras(camera_count);
+    std::vector<GfxLight>  rest_lights(light_count);
+    auto const             copy_state = [&](glm::mat4 *transforms, GfxCamera *cameras, GfxLight *lights) {
+        GfxInstance const *instances = gfxSceneGetObjects<GfxInstance>(scene_);
+        for (uint32_t i = 0; i < instance_count; ++i)
+        {
+            transforms[i] = instances[i].transform;
+        }
+        for (uint32_t i = 0; i < camera_count; ++i)
+        {
+            GfxConstRef<GfxCamera> camera_ref = gfxSceneGetCameraHandle(scene_, i);
+            cameras[i].eye                    = camera_ref->eye;
+            cameras[i].center                 = camera_ref->center;
+            cameras[i].up                     = camera_ref->up;
+        }
+        std::copy_n(gfxSceneGetObjects<GfxLight>(scene_), light_count, lights);
+    };
+    copy_state(rest_transforms.data(), rest_cameras.data(), rest_lights.data());
+
+    // Find the instances and lights driven by each animation by comparing its samples against its first one,
+    // animations driving cameras, lights or an instance driven by another animation are left to gfx
+    constexpr uint32_t                 kNoAnimation = 0xFFFFFFFFu;
+    std::vector<uint32_t>              instance_animations(instance_count, kNoAnimation);
+    std::vector<uint8_t>               animation_bakeable(animation_count, 1);
+    std::vector<std::vector<uint32_t>> animation_instances(animation_count);
+    std::vector<std::vector<uint32_t>> animation_lights(animation_count);
+    std::vector<glm::mat4>             first_transforms(instance_count);
+    std::vector<GfxCamera>             first_cameras(camera_count);
+    std::vector<GfxLight>              first_lights(light_count);
+    std::vector<uint8_t>               instance_changed(instance_count);
+    std::vector<uint8_t>               light_changed(light_count);
+    for (uint32_t animation_index = 0; animation_index < animation_count; ++animation_index)
+    {
+        GfxConstRef<GfxAnimation> animation_ref    = gfxSceneGetAnimationHandle(scene_, animation_index);
+        float const               animation_length = gfxSceneGetAnimationLength(scene_, animation_ref);
+        uint32_t const            sample_count     = glm::max((uint32_t)ceilf(animation_length * sample_rate), 1U) + 1;
+        std::fill(instance_changed.begin(), instance_changed.end(), (uint8_t)0);
+        std::fill(light_changed.begin(), light_changed.end(), (uint8_t)0);
+        for (uint32_t sample = 0; sample < sample_count; ++sample)
+        {
+            gfxSceneApplyAnimation(
+                scene_, animation_ref, animation_length * (float)sample / (float)(sample_count - 1));
+            if (sample == 0)
+            {
+                copy_state(first_transforms.data(), first_cameras.data(), first_lights.data());
+                continue;
+            }
+            GfxInstance const *instances = gfxSceneGetObjects<GfxInstance>(scene_);
+            GfxLight const    *lights    = gfxSceneGetObjects<GfxLight>(scene_);
+            ThreadPool().Dispatch(
+                [&](uint32_t i) {
+                    if (instances[i].transform != first_transforms[i])
+                    {
+                        instance_changed[i] = 1;
+                    }
+                },
+                instance_count, 256);
+            for (uint32_t i = 0; i < camera_count; ++i)
+            {
+                GfxConstRef<GfxCamera> camera_ref = gfxSceneGetCameraHandle(scene_, i);
+                if (camera_ref->eye != first_cameras[i].eye || camera_ref->center != first_cameras[i].center
+                    || camera_ref->up != first_cameras[i].up)
+                {
+                    animation_bakeable[animation_index] = 0;
+                }
+            }
+            for (uint32_t i = 0; i < light_count; ++i)
+            {
+                if (lights[i].position != first_lights[i].position
+                    || lights[i].direction != first_lights[i].direction)
+                {
+                    animation_bakeable[animation_index] = 0;
+                    light_changed[i]                    = 1;
+                }
+            }
+        }
+        for (uint32_t i = 0; i < light_count; ++i)
+        {
+            if (light_changed[i] != 0)
+            {
+                animation_lights[animation_index].push_back(i);
+            }
+        }
+        for (uint32_t i = 0; i < instance_count; ++i)
+        {
+            if (instance_changed[i] == 0)
+            {
+                continue;
+            }
+            if (instance_animations[i] != kNoAnimation)
+            {
+                animation_bakeable[instance_animations[i]] = 0;
+                animation_bakeable[animation_index]        = 0;
+            }
+            instance_animations[i] = animation_index;
+            animation_instances[animation_index].push_back(i);
+        }
+    }
+
+    // Sample the instances of each animation and reduce them into channels
+    AnimationSampler       sampler;
+    std::vector<glm::mat4> transforms;
+    for (uint32_t animation_index = 0; animation_index < animation_count; ++animation_index)
+    {
+        std::vector<uint32_t> const &instance_indices = animation_instances[animation_index];
+        if (animation_sample_rate_ <= 0.0f || animation_bakeable[animation_index] == 0)
+        {
+            unbaked_animations_.push_back(animation_index);
+            continue;
+        }
+        if (instance_indices.empty())
+        {
+            continue; // nothing animated
+        }
+        GfxConstRef<GfxAnimation> animation_ref = gfxSceneGetAnimationHandle(scene_, animation_index);
+        sampler.initialize(gfxSceneGetAnimationLength(scene_, animation_ref), animation_sample_rate_, 1e-4f,
+            (uint32_t)instance_indices.size());
+        transforms.resize(instance_indices.size());
+        float time = 0.0f;
+        while (sampler.next(time))
+        {
+            gfxSceneApplyAnimation(scene_, animation_ref, time);
+            GfxInstance const *instances = gfxSceneGetObjects<GfxInstance>(scene_);
+            for (size_t i = 0; i < instance_indices.size(); ++i)
+            {
+                transforms[i] = instances[instance_indices[i]].transform;
+            }
+            sampler.record(transforms.data());
+        }
+        if (!animation_evaluator_.addAnimation(sampler, instance_indices.data(), 1e-4f))
+        {
+            unbaked_animations_.push_back(animation_index); // e.g., sheared or scaled to zero
+        }
+    }
+
+    // Restore the imported state, gfx only updates the nodes driven by an animation when applying it
+    for (uint32_t i = 0; i < instance_count; ++i)
+    {
+        gfxSceneGetObjectHandle<GfxInstance>(scene_, i)->transform = rest_transforms[i];
+    }
+    for (uint32_t i = 0; i < camera_count; ++i)
+    {
+        GfxRef<GfxCamera> camera_ref = gfxSceneGetCameraHandle(scene_, i);
+        camera_ref->eye              = rest_cameras[i].eye;
+        camera_ref->center           = rest_cameras[i].center;
+        camera_ref->up               = rest_cameras[i].up;
+    }
+    for (uint32_t i = 0; i < light_count; ++i)
+    {
+        GfxRef<GfxLight> light_ref = gfxSceneGetObjectHandle<GfxLight>(scene_, i);
+        light_ref->position        = rest_lights[i].position;
+        light_ref->direction       = rest_lights[i].direction;
+    }
+
+    // Record what the animations applied through gfx drive, only these objects need checking for changes
+    for (uint32_t animation_index : unbaked_animations_)
+    {
+        animated_instances_.insert(animated_instances_.end(), animation_instances[animation_index].begin(),
+            animation_instances[animation_index].end());
+        animated_lights_.insert(animated_lights_.end(), animation_lights[animation_index].begin(),
+            animation_lights[animation_index].end());
+    }
+    for (std::vector<uint32_t> *objects : {&animated_instances_, &animated_lights_})
+    {
+        std::sort(objects->begin(), objects->end());
+        objects->erase(std::unique(objects->begin(), objects->end()), objects->end());
+    }
+
+    animation_bake_time_ =
+        std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - bake_start).count();
+    if (animation_sample_rate_ <= 0.0f)
+    {
+        return;
+    }
+    GFX_PRINTLN("Baked %u of %u animations into %u channels (%u keyframes) in %.1f ms",
+        animation_count - (uint32_t)unbaked_animations_.size(), animation_count,
+        animation_evaluator_.getChannelCount(), animation_evaluator_.getKeyframeCount(),
+        animation_bake_time_ * 1000.0);
+}
+
+void CapsaicinInternal::applyBakedAnimations() noexcept
+{
+    CAPSAICIN_PROFILE_SCOPE("ApplyBakedAnimations");
+
+    using ObjectType = SceneChangeTracker::ObjectType;
+
+    // Only the instances whose transform changed are written and recorded, their snapshot is kept up to date so
+    // that a full change detection does not report them a second time
+    for (uint32_t channel : animation_evaluator_.evaluate(play_time_))
+    {
+        GfxRef<GfxInstance> instance_ref =
+            gfxSceneGetObjectHandle<GfxInstance>(scene_, animation_evaluator_.getTarget(channel));
+        uint32_t const instance_index = (uint32_t)instance_ref;
+        instance_ref->transform       = animation_evaluator_.getTransform(channel);
+        if (instance_index < instance_snapshots_.size()
+            && scene_changes_.isTracked(ObjectType::Instance, instance_index))
+        {
+            instance_snapshots_[instance_index].transform = instance_ref->transform;
+            scene_changes_.markChanged(ObjectType::Transform, instance_index);
+        }
+    }
+}
+
+void CapsaicinInternal::destroyScene() noexcept
+{
+    gfxDestroyBuffer(gfx_, mesh_buffer_);
+    gfxDestroyBuffer(gfx_, index_buffer_);
+    gfxDestroyBuffer(gfx_, vertex_buffer_);
+    gfxDestroyBuffer(gfx_, instance_buffer_);
+    gfxDestroyBuffer(gfx_, material_buffer_);
+    gfxDestroyBuffer(gfx_, transform_buffer_);
+    gfxDestroyBuffer(gfx_, prev_transform_buffer_);
+    mesh_buffer_           = {};
+    index_buffer_          = {};
+    vertex_buffer_         = {};
+    instance_buffer_       = {};
+    material_buffer_       = {};
+    transform_buffer_      = {};
+    prev_transform_buffer_ = {};
+
+    texture_streamer_.cancelAll();
+    for (GfxTexture const &texture : texture_atlas_)
+    {
+        gfxDestroyTexture(gfx_, texture);
+    }
+    texture_atlas_.clear();
+
+    // Destroying the acceleration structure also releases its raytracing primitives
+    raytracing_primitives_.clear();
+    gfxDestroyAccelerationStructure(gfx_, acceleration_structure_);
+    acceleration_structure_ = {};
+
+    mesh_data_.clear();
+    index_data_.clear();
+    vertex_data_.clear();
+    instance_data_.clear();
+    material_data_.clear();
+    transform_data_.clear();
+    prev_transform_data_.clear();
+    instance_min_bounds_.clear();
+    instance_max_bounds_.clear();
+    dirty_transforms_.clear();
+    instance_object_indices_.clear();
+
+    mesh_states_.clear();
+    mesh_optimizations_.clear();
+    mesh_optimization_keys_.clear();
+    material_states_.clear();
+    image_states_.clear();
+    instance_states_.clear();
+
+    scene_upload_bytes_ = 0;
+    scene_flatten_rate_ = 0.0;
+}
+} // namespace Capsaicin
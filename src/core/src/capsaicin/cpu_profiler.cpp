@@ -0,0 +1,383 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "cpu_profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <gfx.h>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Capsaicin
+{
+std::vector<CpuProfileFrame> CpuProfiler::frames_;
+std::deque<std::string>      CpuProfiler::names_;
+uint32_t                     CpuProfiler::render_thread_ = 0;
+int64_t                      CpuProfiler::start_time_    = 0;
+bool                         CpuProfiler::in_frame_      = false;
+
+namespace
+{
+/** Maximum number of scopes a thread can complete between two frames, further scopes are dropped */
+constexpr uint32_t kThreadEventCapacity = 4096;
+
+/** Maximum nesting depth of the timed scopes */
+constexpr uint32_t kMaxScopeDepth = 64;
+
+/** A scope completed by a thread and not yet collected. */
+struct ThreadEvent
+{
+    char const *name;
+    uint32_t    name_length;
+    uint32_t    depth;
+    int64_t     begin;
+    int64_t     end;
+};
+
+/** Completed scopes of a thread, written by the thread and read by the render thread without locking. */
+struct ThreadBuffer
+{
+    ThreadEvent           events[kThreadEventCapacity];
+    std::atomic<uint64_t> head    = 0; /**< Number of events ever written, only written by the owning thread */
+    std::atomic<uint64_t> tail    = 0; /**< Number of events ever collected, only written by the render thread */
+    std::atomic<uint64_t> dropped = 0; /**< Number of events dropped while the buffer was full */
+    std::string           name;        /**< The thread name, guarded by the registry mutex */
+};
+
+/** Scopes currently entered by a thread. */
+struct ThreadScopes
+{
+    ThreadBuffer    *buffer = nullptr;       /**< The buffer of the thread (none until first used) */
+    uint32_t         thread = 0;             /**< Index of the thread buffer */
+    uint32_t         depth  = 0;             /**< Number of entered scopes */
+    int64_t          begins[kMaxScopeDepth]; /**< Time each scope was entered, 0 if not profiled */
+    std::string_view names[kMaxScopeDepth];  /**< Name of each entered scope */
+};
+
+std::atomic<bool>                              g_profiling = false;
+std::mutex                                     g_registry_mutex; /**< Guards the list of thread buffers */
+std::vector<std::unique_ptr<ThreadBuffer>>     g_thread_buffers; /**< Buffers are never destroyed or moved */
+std::unordered_map<std::string_view, uint32_t> g_name_indices;   /**< Keys point into CpuProfiler::names_ */
+thread_local ThreadScopes                      t_scopes;
+
+int64_t GetTime() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/** Gets the buffer of the calling thread, registering the thread the first time. */
+ThreadBuffer &GetThreadBuffer() noexcept
+{
+    if (t_scopes.buffer == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        t_scopes.thread = (uint32_t)g_thread_buffers.size();
+        t_scopes.buffer = g_thread_buffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+        t_scopes.buffer->name = "Thread " + std::to_string(t_scopes.thread);
+    }
+    return *t_scopes.buffer;
+}
+
+/** Write a string as a JSON string literal, escaping the quotes, backslashes and control characters. */
+void WriteJsonString(std::ostream &stream, std::string_view const &string) noexcept
+{
+    stream << '"';
+    for (char const character : string)
+    {
+        if (character == '"' || character == '\\')
+        {
+            stream << '\\' << character;
+        }
+        else if ((unsigned char)character < 0x20)
+        {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned int)character);
+            stream << escaped;
+        }
+        else
+        {
+            stream << character;
+        }
+    }
+    stream << '"';
+}
+} // unnamed namespace
+
+void CpuProfiler::Start() noexcept
+{
+    if (in_frame_) EndFrame();
+    frames_.clear();
+    names_.clear();
+    g_name_indices.clear();
+    // Discard the scopes completed while not profiling
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        for (auto const &buffer : g_thread_buffers)
+        {
+            buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+        }
+    }
+    start_time_ = GetTime();
+    g_profiling.store(true, std::memory_order_release);
+}
+
+void CpuProfiler::Stop() noexcept
+{
+    if (in_frame_) EndFrame();
+    g_profiling.store(false, std::memory_order_release);
+}
+
+bool CpuProfiler::IsProfiling() noexcept
+{
+    return g_profiling.load(std::memory_order_relaxed);
+}
+
+void CpuProfiler::BeginFrame(uint32_t frame_index) noexcept
+{
+    if (!IsProfiling()) return;
+    if (in_frame_) EndFrame();
+    GetThreadBuffer();
+    render_thread_ = t_scopes.thread;
+    CpuProfileFrame &frame = frames_.emplace_back();
+    frame.frame_index      = frame_index;
+    frame.begin            = GetTime() - start_time_;
+    in_frame_              = true;
+}
+
+void CpuProfiler::EndFrame() noexcept
+{
+    if (!in_frame_) return;
+    CpuProfileFrame &frame = frames_.back();
+    frame.duration         = GetTime() - start_time_ - frame.begin;
+    in_frame_              = false;
+
+    // Collect the scopes completed by every thread, the buffers may be written to while being read
+    std::vector<ThreadBuffer *> buffers;
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        for (auto const &buffer : g_thread_buffers)
+        {
+            buffers.push_back(buffer.get());
+        }
+    }
+    for (uint32_t thread = 0; thread < (uint32_t)buffers.size(); ++thread)
+    {
+        ThreadBuffer  &buffer = *buffers[thread];
+        uint64_t const head   = buffer.head.load(std::memory_order_acquire);
+        uint64_t const tail   = buffer.tail.load(std::memory_order_relaxed);
+        for (uint64_t index = tail; index < head; ++index)
+        {
+            ThreadEvent const &thread_event = buffer.events[index % kThreadEventCapacity];
+            CpuProfileEvent   &event        = frame.events.emplace_back();
+            event.name     = GetNameIndex(std::string_view(thread_event.name, thread_event.name_length));
+            event.thread   = thread;
+            event.depth    = thread_event.depth;
+            event.begin    = thread_event.begin - start_time_;
+            event.duration = thread_event.end - thread_event.begin;
+        }
+        buffer.tail.store(head, std::memory_order_release);
+    }
+
+    // Merge the render thread scopes by call path, completed scopes are in post-order so sort them in pre-order
+    std::vector<CpuProfileEvent> render_events;
+    std::copy_if(frame.events.cbegin(), frame.events.cend(), std::back_inserter(render_events),
+        [](CpuProfileEvent const &event) { return event.thread == render_thread_; });
+    std::sort(render_events.begin(), render_events.end(),
+        [](CpuProfileEvent const &lhs, CpuProfileEvent const &rhs) {
+            return lhs.begin != rhs.begin ? lhs.begin < rhs.begin : lhs.depth < rhs.depth;
+        });
+    std::vector<uint32_t> node_stack;
+    for (CpuProfileEvent const &event : render_events)
+    {
+        while (!node_stack.empty() && frame.tree[node_stack.back()].depth >= event.depth)
+        {
+            node_stack.pop_back();
+        }
+        uint32_t const parent = (!node_stack.empty() ? node_stack.back() : CpuProfileNode::kNoParent);
+        auto const     node   = std::find_if(frame.tree.cbegin(), frame.tree.cend(),
+            [&](CpuProfileNode const &item) { return item.parent == parent && item.name == event.name; });
+        uint32_t const index  = (uint32_t)(node - frame.tree.cbegin());
+        if (node == frame.tree.cend())
+        {
+            CpuProfileNode &new_node = frame.tree.emplace_back();
+            new_node.name            = event.name;
+            new_node.parent          = parent;
+            new_node.depth           = event.depth;
+        }
+        ++frame.tree[index].count;
+        frame.tree[index].time += (double)event.duration / 1e9;
+        node_stack.push_back(index);
+    }
+}
+
+#ifdef CAPSAICIN_ENABLE_CPU_PROFILING
+void CpuProfiler::BeginScope(std::string_view const &name) noexcept
+{
+    ThreadScopes &scopes = t_scopes;
+    if (scopes.depth < kMaxScopeDepth)
+    {
+        scopes.begins[scopes.depth] = (IsProfiling() ? GetTime() : 0);
+        scopes.names[scopes.depth]  = name;
+    }
+    ++scopes.depth;
+}
+
+void CpuProfiler::EndScope() noexcept
+{
+    ThreadScopes &scopes = t_scopes;
+    if (scopes.depth == 0) return;
+    uint32_t const depth = --scopes.depth;
+    // Scopes entered before profiling was started are not profiled
+    if (depth >= kMaxScopeDepth || scopes.begins[depth] == 0 || !IsProfiling()) return;
+
+    ThreadBuffer  &buffer = GetThreadBuffer();
+    uint64_t const head   = buffer.head.load(std::memory_order_relaxed);
+    if (head - buffer.tail.load(std::memory_order_acquire) >= kThreadEventCapacity)
+    {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ThreadEvent &event = buffer.events[head % kThreadEventCapacity];
+    event.name         = scopes.names[depth].data();
+    event.name_length  = (uint32_t)scopes.names[depth].size();
+    event.depth        = depth;
+    event.begin        = scopes.begins[depth];
+    event.end          = GetTime();
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+#endif
+
+void CpuProfiler::SetThreadName(std::string_view const &name) noexcept
+{
+    ThreadBuffer               &buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    buffer.name = name;
+}
+
+void CpuProfiler::AddGpuSection(
+    uint32_t frame_latency, std::string_view const &name, uint32_t depth, double duration) noexcept
+{
+    if (!IsProfiling() || frames_.size() <= frame_latency) return;
+    CpuProfileFrame &frame = frames_[frames_.size() - 1 - frame_latency];
+
+    // Follow the last section of the same depth unless the preceding section of lower depth started after it
+    int64_t begin = frame.begin + frame.duration;
+    for (auto event = frame.events.crbegin(); event != frame.events.crend(); ++event)
+    {
+        if (event->thread != CpuProfileEvent::kGpuThread || event->depth > depth) continue;
+        begin = (event->depth == depth ? event->begin + event->duration : event->begin);
+        break;
+    }
+    CpuProfileEvent &event = frame.events.emplace_back();
+    event.name             = GetNameIndex(name);
+    event.thread           = CpuProfileEvent::kGpuThread;
+    event.depth            = depth;
+    event.begin            = begin;
+    event.duration         = (int64_t)(duration * 1e9);
+}
+
+bool CpuProfiler::Write(char const *file_path) noexcept
+{
+    std::ofstream json_file(file_path);
+    if (!json_file.is_open())
+    {
+        GFX_PRINTLN("Failed to open CPU profile file '%s'", file_path);
+        return false;
+    }
+
+    // Chrome trace times are in microseconds
+    std::vector<std::string> thread_names;
+    uint64_t                 dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        for (auto const &buffer : g_thread_buffers)
+        {
+            thread_names.push_back(buffer->name);
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+    }
+    uint32_t const gpu_thread = (uint32_t)thread_names.size();
+    thread_names.emplace_back("GPU");
+    if (!frames_.empty() && render_thread_ < gpu_thread)
+    {
+        thread_names[render_thread_] = "Render";
+    }
+
+    json_file << std::fixed << std::setprecision(3); // keep nanosecond precision however long the profile
+    json_file << "{" << '\n' << "    \"displayTimeUnit\": \"ms\"," << '\n' << "    \"traceEvents\": [" << '\n';
+    for (uint32_t thread = 0; thread < (uint32_t)thread_names.size(); ++thread)
+    {
+        json_file << "        {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << thread
+                  << ", \"args\": {\"name\": ";
+        WriteJsonString(json_file, thread_names[thread]);
+        json_file << "}}," << '\n'
+                  << "        {\"name\": \"thread_sort_index\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << thread
+                  << ", \"args\": {\"sort_index\": " << thread << "}}";
+        json_file << (thread + 1 < thread_names.size() || !frames_.empty() ? "," : "") << '\n';
+    }
+    for (size_t frame_index = 0; frame_index < frames_.size(); ++frame_index)
+    {
+        CpuProfileFrame const &frame = frames_[frame_index];
+        json_file << "        {\"name\": \"Frame " << frame.frame_index << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": "
+                  << render_thread_ << ", \"ts\": " << (double)frame.begin / 1e3
+                  << ", \"dur\": " << (double)frame.duration / 1e3 << "}";
+        for (CpuProfileEvent const &event : frame.events)
+        {
+            json_file << "," << '\n'
+                      << "        {\"name\": ";
+            WriteJsonString(json_file, names_[event.name]);
+            json_file << ", \"ph\": \"X\", \"pid\": 0, \"tid\": "
+                      << (event.thread == CpuProfileEvent::kGpuThread ? gpu_thread : event.thread)
+                      << ", \"ts\": " << (double)event.begin / 1e3 << ", \"dur\": " << (double)event.duration / 1e3
+                      << ", \"args\": {\"frame\": " << frame.frame_index << "}}";
+        }
+        json_file << (frame_index + 1 < frames_.size() ? "," : "") << '\n';
+    }
+    json_file << "    ]," << '\n'
+              << "    \"otherData\": {\"dropped_scopes\": " << dropped << "}" << '\n'
+              << "}" << '\n';
+    return json_file.good();
+}
+
+uint32_t CpuProfiler::GetNameIndex(std::string_view const &name) noexcept
+{
+    std::string_view const key   = (!name.empty() ? name : "<unnamed>");
+    auto const             found = g_name_indices.find(key);
+    if (found != g_name_indices.cend())
+    {
+        return found->second;
+    }
+    uint32_t const index = (uint32_t)names_.size();
+    names_.emplace_back(key);
+    g_name_indices.emplace(names_.back(), index);
+    return index;
+}
+} // namespace Capsaicin
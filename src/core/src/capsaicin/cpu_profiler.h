@@ -0,0 +1,187 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Capsaicin
+{
+/** A timed scope or GPU section, times are relative to the start of the profile. */
+struct CpuProfileEvent
+{
+    uint32_t name     = 0; /**< Index of the name in the profile names (see CpuProfiler::GetName()) */
+    uint32_t thread   = 0; /**< Index of the thread the scope ran on, kGpuThread for GPU sections */
+    uint32_t depth    = 0; /**< Nesting depth of the scope within its thread */
+    int64_t  begin    = 0; /**< Time the scope was entered (in nanoseconds) */
+    int64_t  duration = 0; /**< Time spent inside the scope (in nanoseconds) */
+
+    static constexpr uint32_t kGpuThread = 0xFFFFFFFFu;
+};
+
+/** Render thread scopes of a frame merged by call path. */
+struct CpuProfileNode
+{
+    uint32_t name   = 0;         /**< Index of the name in the profile names */
+    uint32_t parent = kNoParent; /**< Index of the parent node, kNoParent for top level scopes */
+    uint32_t depth  = 0;         /**< Nesting depth of the node */
+    uint32_t count  = 0;         /**< Number of times the scope was entered */
+    double   time   = 0.0;       /**< Total time spent inside the scope (in seconds) */
+
+    static constexpr uint32_t kNoParent = 0xFFFFFFFFu;
+};
+
+/** The scopes profiled during a single frame. */
+struct CpuProfileFrame
+{
+    uint32_t                     frame_index = 0; /**< Index of the frame */
+    int64_t                      begin       = 0; /**< Time the frame was begun (in nanoseconds) */
+    int64_t                      duration    = 0; /**< Time spent recording the frame (in nanoseconds) */
+    std::vector<CpuProfileEvent> events;          /**< Scopes completed on any thread during the frame */
+    std::vector<CpuProfileNode>  tree;            /**< Render thread scopes, in depth first order */
+};
+
+/**
+ * Hierarchical CPU scope profiler.
+ * Each thread appends its completed scopes to its own fixed size buffer without locking, the buffers are drained
+ * by the render thread at the end of every frame. Scopes are only timed when built with
+ * CAPSAICIN_ENABLE_CPU_PROFILING, otherwise CAPSAICIN_PROFILE_SCOPE() expands to nothing and only the frames and
+ * GPU sections are profiled. Frames must be begun and ended from the render thread.
+ */
+class CpuProfiler
+{
+public:
+    /** RAII helper timing the enclosing scope. */
+    class Scope
+    {
+        Scope(Scope const &)            = delete;
+        Scope &operator=(Scope const &) = delete;
+
+    public:
+        Scope(std::string_view const &name) noexcept { BeginScope(name); }
+        ~Scope() noexcept { EndScope(); }
+    };
+
+    /**
+     * Start profiling, discarding any previously profiled frames.
+     */
+    static void Start() noexcept;
+
+    /**
+     * Stop profiling, the profiled frames remain available.
+     */
+    static void Stop() noexcept;
+
+    /**
+     * Check if scopes are being profiled.
+     * @returns True if profiling.
+     */
+    static bool IsProfiling() noexcept;
+
+    /**
+     * Start a new frame.
+     * @param frame_index The index of the frame.
+     */
+    static void BeginFrame(uint32_t frame_index) noexcept;
+
+    /**
+     * End the current frame, collecting the scopes completed by all threads since the previous frame.
+     */
+    static void EndFrame() noexcept;
+
+#ifdef CAPSAICIN_ENABLE_CPU_PROFILING
+    /**
+     * Enter a scope on the calling thread.
+     * @param name The scope name, must remain valid until the end of the frame.
+     */
+    static void BeginScope(std::string_view const &name) noexcept;
+
+    /**
+     * Leave the innermost scope of the calling thread.
+     */
+    static void EndScope() noexcept;
+#else
+    static void BeginScope(std::string_view const &) noexcept {}
+    static void EndScope() noexcept {}
+#endif
+
+    /**
+     * Sets the name the calling thread is shown with.
+     * @param name The thread name.
+     */
+    static void SetThreadName(std::string_view const &name) noexcept;
+
+    /**
+     * Add a section timed on the GPU to a previous frame.
+     * GPU timestamps only provide durations, sections are therefore placed one after the other from the end of the
+     * frame they were recorded in, children are placed from the start of the preceding section of lower depth.
+     * @param frame_latency The number of frames between the current frame and the one the section was recorded in.
+     * @param name          The section name.
+     * @param depth         Nesting depth of the section.
+     * @param duration      Time spent on the GPU (in seconds).
+     */
+    static void AddGpuSection(uint32_t frame_latency, std::string_view const &name, uint32_t depth,
+        double duration) noexcept;
+
+    /**
+     * Gets the profiled frames.
+     * @returns The list of frames, in profiling order.
+     */
+    static std::vector<CpuProfileFrame> const &GetFrames() noexcept { return frames_; }
+
+    /**
+     * Gets the name of an event or node.
+     * @param name The index of the name.
+     * @returns The name string.
+     */
+    static std::string_view GetName(uint32_t name) noexcept { return names_[name]; }
+
+    /**
+     * Write the profiled frames to a Chrome trace JSON file (see chrome://tracing or https://ui.perfetto.dev).
+     * @param file_path Full pathname to the file to write.
+     * @returns True if succeeded, False if the file could not be written.
+     */
+    static bool Write(char const *file_path) noexcept;
+
+private:
+    static uint32_t GetNameIndex(std::string_view const &name) noexcept;
+
+    static std::vector<CpuProfileFrame> frames_;        /**< The profiled frames */
+    static std::deque<std::string>      names_;         /**< Names of the scopes, by index */
+    static uint32_t                     render_thread_; /**< Index of the thread frames are begun from */
+    static int64_t                      start_time_;    /**< Time the profile was started (in nanoseconds) */
+    static bool                         in_frame_;      /**< Whether a frame was begun and not ended */
+};
+} // namespace Capsaicin
+
+#ifdef CAPSAICIN_ENABLE_CPU_PROFILING
+#    define CAPSAICIN_PROFILE_CONCAT_(a, b) a##b
+#    define CAPSAICIN_PROFILE_CONCAT(a, b)  CAPSAICIN_PROFILE_CONCAT_(a, b)
+/** Time the enclosing scope under the given name (a string literal or other string outliving the frame). */
+#    define CAPSAICIN_PROFILE_SCOPE(name) \
+        ::Capsaicin::CpuProfiler::Scope const CAPSAICIN_PROFILE_CONCAT(cpu_profile_scope_, __LINE__)(name)
+#else
+#    define CAPSAICIN_PROFILE_SCOPE(name)
+#endif
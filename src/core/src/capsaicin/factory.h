@@ -100,11 +100,8 @@ class Factory
     template<class T>
     class Registrar
     {
-        template<typename T2, typename = void>
-        static constexpr bool isDefined = false;
-
         template<typename T2>
-        static constexpr bool isDefined<T2, std::void_t<decltype(sizeof(T2::Name))>> = true;
+        static constexpr bool isDefined = requires { sizeof(T2::Name); };
 
     public:
         friend T;
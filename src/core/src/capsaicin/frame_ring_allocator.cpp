@@ -0,0 +1,104 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "frame_ring_allocator.h"
+
+#include <algorithm>
+
+namespace Capsaicin
+{
+namespace
+{
+uint64_t AlignUp(uint64_t value, uint64_t alignment) noexcept
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+} // unnamed namespace
+
+void FrameRingAllocator::initialize(uint32_t frame_count, uint64_t alignment, uint64_t granularity) noexcept
+{
+    capacities_.assign(frame_count, 0);
+    demand_history_.assign(kHistoryLength, 0);
+    history_cursor_ = 0;
+    frame_index_    = 0;
+    cursor_         = 0;
+    alignment_      = std::max(alignment, (uint64_t)1);
+    granularity_    = std::max(granularity, alignment_);
+    frame_active_   = false;
+    stats_          = {};
+    last_stats_     = {};
+}
+
+uint64_t FrameRingAllocator::beginFrame(uint32_t frame_index) noexcept
+{
+    if (frame_index >= capacities_.size())
+    {
+        return 0;
+    }
+
+    // Record the demand of the frame that just ended
+    if (frame_active_)
+    {
+        demand_history_[history_cursor_] = stats_.allocated_bytes + stats_.overflow_bytes;
+        history_cursor_                  = (history_cursor_ + 1) % kHistoryLength;
+        last_stats_                      = stats_;
+    }
+
+    // Size the block for the recent peak plus some headroom, it only shrinks once well oversized to avoid
+    // recreating it every time the demand fluctuates
+    uint64_t const high_water = getHighWaterMark();
+    uint64_t const required   = AlignUp(std::max(high_water + high_water / 4, (uint64_t)1), granularity_);
+    uint64_t      &capacity   = capacities_[frame_index];
+    if (capacity < required || capacity > 4 * required)
+    {
+        capacity = required;
+    }
+
+    frame_index_    = frame_index;
+    cursor_         = 0;
+    frame_active_   = true;
+    stats_          = {};
+    stats_.capacity = capacity;
+    return capacity;
+}
+
+bool FrameRingAllocator::allocate(uint64_t size, FrameAllocation &allocation) noexcept
+{
+    uint64_t const aligned_size = AlignUp(std::max(size, (uint64_t)1), alignment_);
+    if (!frame_active_ || aligned_size > stats_.capacity - cursor_)
+    {
+        stats_.overflow_bytes += aligned_size;
+        ++stats_.overflow_count;
+        return false;
+    }
+    allocation.offset = cursor_;
+    allocation.size   = aligned_size;
+    cursor_ += aligned_size;
+    stats_.allocated_bytes = cursor_;
+    ++stats_.allocation_count;
+    return true;
+}
+
+uint64_t FrameRingAllocator::getHighWaterMark() const noexcept
+{
+    return demand_history_.empty() ? 0 : *std::max_element(demand_history_.begin(), demand_history_.end());
+}
+} // namespace Capsaicin
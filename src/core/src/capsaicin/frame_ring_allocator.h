@@ -0,0 +1,113 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Capsaicin
+{
+/** A range of a frame's upload memory. */
+struct FrameAllocation
+{
+    uint64_t offset = 0; /**< Offset from the start of the frame's memory (in bytes) */
+    uint64_t size   = 0; /**< Size of the range, including alignment padding (in bytes) */
+};
+
+/** Statistics of the allocations made during a single frame. */
+struct FrameAllocatorStats
+{
+    uint64_t allocated_bytes  = 0; /**< Bytes allocated from the frame's memory (including alignment padding) */
+    uint32_t allocation_count = 0; /**< Number of allocations served from the frame's memory */
+    uint64_t overflow_bytes   = 0; /**< Bytes requested that did not fit in the frame's memory */
+    uint32_t overflow_count   = 0; /**< Number of allocations that did not fit in the frame's memory */
+    uint64_t capacity         = 0; /**< Size of the frame's memory (in bytes) */
+};
+
+/**
+ * Linear allocator handing out ranges of per-frame upload memory.
+ * Each frame in flight owns a separate block of memory that is recycled as a whole once the frame that last used
+ * it has completed. Blocks are only resized when a frame begins, based on the highest demand seen over recent
+ * frames, so that allocations never move once handed out. The allocator only tracks offsets, the caller owns the
+ * memory itself.
+ */
+class FrameRingAllocator
+{
+public:
+    /**
+     * Set up the allocator, releasing all blocks and history.
+     * @param frame_count Number of frames in flight (i.e., number of memory blocks).
+     * @param alignment   Alignment of each allocation (must be a power of 2).
+     * @param granularity Block sizes are rounded up to a multiple of this (must be a power of 2).
+     */
+    void initialize(uint32_t frame_count, uint64_t alignment, uint64_t granularity) noexcept;
+
+    /**
+     * Start allocating from the block of a frame, ending the current frame.
+     * @note The caller must ensure the GPU is done with the block before calling.
+     * @param frame_index The index of the frame in flight.
+     * @returns The size the frame's block must have (in bytes).
+     */
+    uint64_t beginFrame(uint32_t frame_index) noexcept;
+
+    /**
+     * Allocate a range of the current frame's block.
+     * @param       size       The number of bytes required.
+     * @param [out] allocation The allocated range.
+     * @returns True if succeeded, False if the block is full (the caller must then provide the memory itself).
+     */
+    bool allocate(uint64_t size, FrameAllocation &allocation) noexcept;
+
+    /**
+     * Gets the index of the frame currently being allocated from.
+     * @returns The frame index.
+     */
+    uint32_t getFrameIndex() const noexcept { return frame_index_; }
+
+    /**
+     * Gets the statistics of the most recently completed frame.
+     * @returns The frame statistics.
+     */
+    FrameAllocatorStats const &getFrameStats() const noexcept { return last_stats_; }
+
+    /**
+     * Gets the highest number of bytes requested by a single frame over recent frames.
+     * @returns The high-water mark (in bytes).
+     */
+    uint64_t getHighWaterMark() const noexcept;
+
+private:
+    /** Number of frames the high-water mark is tracked over. */
+    static constexpr uint32_t kHistoryLength = 120;
+
+    std::vector<uint64_t> capacities_;             /**< Size of each frame's block */
+    std::vector<uint64_t> demand_history_;         /**< Bytes requested by each recent frame, used as a ring */
+    uint32_t              history_cursor_ = 0;     /**< Next entry of the history to be written */
+    uint32_t              frame_index_    = 0;     /**< The frame currently being allocated from */
+    uint64_t              cursor_         = 0;     /**< Next free byte of the current frame's block */
+    uint64_t              alignment_      = 1;     /**< Alignment of each allocation */
+    uint64_t              granularity_    = 1;     /**< Block size granularity */
+    bool                  frame_active_   = false; /**< Whether beginFrame() has been called */
+    FrameAllocatorStats   stats_;                  /**< Statistics of the current frame */
+    FrameAllocatorStats   last_stats_;             /**< Statistics of the most recently completed frame */
+};
+} // namespace Capsaicin
@@ -0,0 +1,273 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "frame_sequence.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <glm/gtc/packing.hpp>
+
+#ifdef _WIN32
+#    define popen  _popen
+#    define pclose _pclose
+#endif
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr char     kSequenceMagic[4] = {'C', 'S', 'E', 'Q'};
+constexpr uint64_t kFrameAlignment   = 4096; /**< Alignment of the first frame within the file (in bytes) */
+#ifdef _WIN32
+constexpr char kPipeMode[] = "wb";
+#else
+constexpr char kPipeMode[] = "w";
+#endif
+
+/** Header found at the start of a container. */
+struct SequenceHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t encoding;
+    uint32_t frame_capacity;
+    uint32_t frame_count; /**< Updated after each frame is written */
+    uint32_t reserved;
+    uint64_t frame_size;   /**< Size of an encoded frame (in bytes) */
+    uint64_t index_offset; /**< Offset of the FrameEntry[frame_capacity] frame index (in bytes) */
+    uint64_t data_offset;  /**< Offset of the first frame (in bytes) */
+};
+
+/** Entry of the frame index, one per frame in container order. */
+struct FrameEntry
+{
+    uint32_t frame_index; /**< The index of the frame in the renderer */
+    uint32_t reserved;
+    uint64_t offset; /**< Offset of the frame from the start of the file (in bytes) */
+};
+
+uint64_t GetFrameSize(uint32_t pixel_count, FrameEncoding encoding) noexcept
+{
+    return (uint64_t)pixel_count * 4 * (encoding == FrameEncoding::Half ? sizeof(uint16_t) : sizeof(float));
+}
+
+void EncodeFrame(float const *data, uint32_t pixel_count, FrameEncoding encoding, uint8_t *frame) noexcept
+{
+    if (encoding == FrameEncoding::Float)
+    {
+        memcpy(frame, data, GetFrameSize(pixel_count, encoding));
+        return;
+    }
+    for (uint32_t pixel = 0; pixel < pixel_count; ++pixel)
+    {
+        glm::uint64 const packed = glm::packHalf4x16(
+            glm::vec4(data[4 * pixel + 0], data[4 * pixel + 1], data[4 * pixel + 2], data[4 * pixel + 3]));
+        memcpy(&frame[pixel * sizeof(packed)], &packed, sizeof(packed));
+    }
+}
+} // unnamed namespace
+
+bool FrameSequenceWriter::open(
+    char const *file_path, uint32_t width, uint32_t height, FrameEncoding encoding, uint32_t frame_capacity) noexcept
+{
+    close();
+    pixel_count_ = width * height;
+    encoding_    = encoding;
+    frame_size_  = GetFrameSize(pixel_count_, encoding);
+    frame_count_ = 0;
+    if (pixel_count_ == 0)
+    {
+        return false;
+    }
+
+    if (file_path[0] == '|')
+    {
+        pipe_ = popen(file_path + 1, kPipeMode);
+        if (pipe_ == nullptr)
+        {
+            return false;
+        }
+        pipe_buffer_.resize(encoding == FrameEncoding::Float ? 0 : frame_size_);
+        return true;
+    }
+
+    if (frame_capacity == 0)
+    {
+        return false;
+    }
+    uint64_t const index_offset = sizeof(SequenceHeader);
+    uint64_t const data_offset =
+        (index_offset + frame_capacity * sizeof(FrameEntry) + kFrameAlignment - 1) & ~(kFrameAlignment - 1);
+    if (!file_.create(file_path, data_offset + frame_capacity * frame_size_))
+    {
+        return false;
+    }
+    file_path_ = file_path;
+
+    SequenceHeader header = {};
+    std::copy_n(kSequenceMagic, 4, header.magic);
+    header.version        = kVersion;
+    header.width          = width;
+    header.height         = height;
+    header.encoding       = (uint32_t)encoding;
+    header.frame_capacity = frame_capacity;
+    header.frame_size     = frame_size_;
+    header.index_offset   = index_offset;
+    header.data_offset    = data_offset;
+    memcpy(file_.getWritableData(), &header, sizeof(header));
+    return true;
+}
+
+void FrameSequenceWriter::close() noexcept
+{
+    if (pipe_ != nullptr)
+    {
+        pclose(pipe_);
+        pipe_ = nullptr;
+        pipe_buffer_.clear();
+    }
+    if (file_.getWritableData() != nullptr)
+    {
+        // Release the space preallocated for frames that were never captured
+        SequenceHeader const &header = *reinterpret_cast<SequenceHeader const *>(file_.getData());
+        uint64_t const        size   = header.data_offset + frame_count_ * frame_size_;
+        file_.close();
+        std::error_code error;
+        std::filesystem::resize_file(file_path_, size, error);
+    }
+    file_path_.clear();
+}
+
+bool FrameSequenceWriter::append(uint32_t frame_index, float const *data) noexcept
+{
+    if (pipe_ != nullptr)
+    {
+        uint8_t const *frame = reinterpret_cast<uint8_t const *>(data);
+        if (encoding_ != FrameEncoding::Float)
+        {
+            EncodeFrame(data, pixel_count_, encoding_, pipe_buffer_.data());
+            frame = pipe_buffer_.data();
+        }
+        if (fwrite(frame, 1, frame_size_, pipe_) != frame_size_)
+        {
+            return false;
+        }
+        ++frame_count_;
+        return true;
+    }
+
+    uint8_t *const  file   = file_.getWritableData();
+    SequenceHeader &header = *reinterpret_cast<SequenceHeader *>(file);
+    if (file == nullptr || frame_count_ >= header.frame_capacity)
+    {
+        return false;
+    }
+    uint64_t const offset = header.data_offset + frame_count_ * frame_size_;
+    EncodeFrame(data, pixel_count_, encoding_, file + offset);
+    FrameEntry &entry = reinterpret_cast<FrameEntry *>(file + header.index_offset)[frame_count_];
+    entry.frame_index = frame_index;
+    entry.offset      = offset;
+    // Only publish the frame once its data and index entry are written
+    header.frame_count = ++frame_count_;
+    return true;
+}
+
+bool FrameSequenceReader::open(char const *file_path) noexcept
+{
+    close();
+    if (!file_.open(file_path))
+    {
+        return false;
+    }
+
+    // Validate the header and the bounds of the frame index and every frame before reading anything else
+    SequenceHeader const *header = reinterpret_cast<SequenceHeader const *>(file_.getData());
+    uint64_t const        size   = file_.getSize();
+    bool valid = size >= sizeof(SequenceHeader) && std::equal(header->magic, header->magic + 4, kSequenceMagic)
+              && header->version == FrameSequenceWriter::kVersion
+              && header->encoding <= (uint32_t)FrameEncoding::Half && header->frame_count <= header->frame_capacity
+              && header->frame_size
+                     == GetFrameSize(header->width * header->height, (FrameEncoding)header->encoding)
+              && header->frame_size > 0 && header->index_offset % alignof(FrameEntry) == 0
+              && header->index_offset <= size
+              && header->frame_capacity <= (size - header->index_offset) / sizeof(FrameEntry);
+    for (uint32_t frame = 0; valid && frame < header->frame_count; ++frame)
+    {
+        FrameEntry const &entry =
+            reinterpret_cast<FrameEntry const *>(file_.getData() + header->index_offset)[frame];
+        valid = entry.offset <= size && header->frame_size <= size - entry.offset;
+    }
+    if (!valid)
+    {
+        close();
+        return false;
+    }
+    width_        = header->width;
+    height_       = header->height;
+    encoding_     = (FrameEncoding)header->encoding;
+    frame_count_  = header->frame_count;
+    frame_size_   = header->frame_size;
+    index_offset_ = header->index_offset;
+    return true;
+}
+
+uint32_t FrameSequenceReader::getFrameIndex(uint32_t frame) const noexcept
+{
+    return reinterpret_cast<FrameEntry const *>(file_.getData() + index_offset_)[frame].frame_index;
+}
+
+uint32_t FrameSequenceReader::findFrame(uint32_t frame_index) const noexcept
+{
+    for (uint32_t frame = 0; frame < frame_count_; ++frame)
+    {
+        if (getFrameIndex(frame) == frame_index)
+        {
+            return frame;
+        }
+    }
+    return UINT32_MAX;
+}
+
+void FrameSequenceReader::readFrame(uint32_t frame, float *data) const noexcept
+{
+    FrameEntry const &entry       = reinterpret_cast<FrameEntry const *>(file_.getData() + index_offset_)[frame];
+    uint8_t const    *encoded     = file_.getData() + entry.offset;
+    uint32_t const    pixel_count = width_ * height_;
+    if (encoding_ == FrameEncoding::Float)
+    {
+        memcpy(data, encoded, frame_size_);
+        return;
+    }
+    for (uint32_t pixel = 0; pixel < pixel_count; ++pixel)
+    {
+        glm::uint64 packed;
+        memcpy(&packed, &encoded[pixel * sizeof(packed)], sizeof(packed));
+        glm::vec4 const value = glm::unpackHalf4x16(packed);
+        data[4 * pixel + 0]   = value.x;
+        data[4 * pixel + 1]   = value.y;
+        data[4 * pixel + 2]   = value.z;
+        data[4 * pixel + 3]   = value.w;
+    }
+}
+} // namespace Capsaicin
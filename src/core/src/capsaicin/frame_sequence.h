@@ -0,0 +1,183 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "scene_cache.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Capsaicin
+{
+/** Storage of the pixels of a captured frame, each pixel has 4 channels (RGBA). */
+enum class FrameEncoding : uint32_t
+{
+    Float = 0, /**< 32-bit float channels, stored as read back */
+    Half,      /**< 16-bit float channels */
+};
+
+/**
+ * Writes a sequence of frames to a single preallocated and memory mapped container, or streams them to a pipe.
+ * The container starts with a header and a frame index followed by the frames stored back to back, the header
+ * frame count is updated after each frame so that the container stays readable if the capture is interrupted.
+ * When writing to a pipe the raw frames are written one after the other without any header (e.g., for an encoder
+ * reading 'rgbaf32le' or 'rgbaf16le' raw video).
+ */
+class FrameSequenceWriter
+{
+public:
+    /** Version of the container layout, any change to the layout or its meaning must increment it. */
+    static constexpr uint32_t kVersion = 1;
+
+    FrameSequenceWriter() noexcept = default;
+    ~FrameSequenceWriter() noexcept { close(); }
+
+    FrameSequenceWriter(FrameSequenceWriter const &)            = delete;
+    FrameSequenceWriter &operator=(FrameSequenceWriter const &) = delete;
+
+    /**
+     * Create a container, or start a command and write the frames to its standard input, any previous sequence
+     * is closed.
+     * @param file_path      Path to the container, or the command to start prefixed with '|'.
+     * @param width          The width of the frames.
+     * @param height         The height of the frames.
+     * @param encoding       The storage of the pixels.
+     * @param frame_capacity The number of frames to preallocate the container for (unused when piping).
+     * @returns True if succeeded, False otherwise.
+     */
+    bool open(char const *file_path, uint32_t width, uint32_t height, FrameEncoding encoding,
+        uint32_t frame_capacity) noexcept;
+
+    /**
+     * Finish the sequence, the container is shrunk to the frames actually written.
+     */
+    void close() noexcept;
+
+    /**
+     * Check whether a sequence is being written.
+     * @returns True if open.
+     */
+    bool isOpen() const noexcept { return file_.getWritableData() != nullptr || pipe_ != nullptr; }
+
+    /**
+     * Append a frame.
+     * @param frame_index The index of the frame in the renderer (stored in the frame index).
+     * @param data        The frame pixels as 4 floats per pixel.
+     * @returns True if succeeded, False if the container is full or the pipe is closed.
+     */
+    bool append(uint32_t frame_index, float const *data) noexcept;
+
+    /**
+     * Gets the number of frames written.
+     * @returns The frame count.
+     */
+    uint32_t getFrameCount() const noexcept { return frame_count_; }
+
+    /**
+     * Gets the size of a frame once encoded.
+     * @returns The frame size (in bytes).
+     */
+    uint64_t getFrameSize() const noexcept { return frame_size_; }
+
+private:
+    MappedFile           file_;                               /**< The mapped container (if not piping) */
+    std::string          file_path_;                          /**< Path to the container */
+    FILE                *pipe_        = nullptr;              /**< The pipe to the started command (if piping) */
+    std::vector<uint8_t> pipe_buffer_;                        /**< Encoded frame written to the pipe */
+    uint32_t             pixel_count_ = 0;                    /**< The number of pixels per frame */
+    FrameEncoding        encoding_    = FrameEncoding::Float; /**< The storage of the pixels */
+    uint64_t             frame_size_  = 0;                    /**< The size of an encoded frame (in bytes) */
+    uint32_t             frame_count_ = 0;                    /**< The number of frames written */
+};
+
+/** Reads the frames of a container written by FrameSequenceWriter. */
+class FrameSequenceReader
+{
+public:
+    /**
+     * Map a container and validate its layout.
+     * @param file_path Path to the container.
+     * @returns True if succeeded, False if the file is missing or invalid.
+     */
+    bool open(char const *file_path) noexcept;
+
+    /**
+     * Unmap the container.
+     */
+    void close() noexcept { file_.close(); }
+
+    /**
+     * Gets the width of the frames.
+     * @returns The frame width.
+     */
+    uint32_t getWidth() const noexcept { return width_; }
+
+    /**
+     * Gets the height of the frames.
+     * @returns The frame height.
+     */
+    uint32_t getHeight() const noexcept { return height_; }
+
+    /**
+     * Gets the storage of the pixels.
+     * @returns The frame encoding.
+     */
+    FrameEncoding getEncoding() const noexcept { return encoding_; }
+
+    /**
+     * Gets the number of frames in the container.
+     * @returns The frame count.
+     */
+    uint32_t getFrameCount() const noexcept { return frame_count_; }
+
+    /**
+     * Gets the index a frame had in the renderer when it was captured.
+     * @param frame The position of the frame in the container.
+     * @returns The renderer frame index.
+     */
+    uint32_t getFrameIndex(uint32_t frame) const noexcept;
+
+    /**
+     * Find a frame by the index it had in the renderer.
+     * @param frame_index The renderer frame index.
+     * @returns The position of the frame in the container, or UINT32_MAX if not found.
+     */
+    uint32_t findFrame(uint32_t frame_index) const noexcept;
+
+    /**
+     * Decode a frame.
+     * @param       frame The position of the frame in the container.
+     * @param [out] data  The frame pixels as 4 floats per pixel (width * height * 4 floats).
+     */
+    void readFrame(uint32_t frame, float *data) const noexcept;
+
+private:
+    MappedFile    file_;                                /**< The mapped container */
+    uint32_t      width_        = 0;                    /**< The width of the frames */
+    uint32_t      height_       = 0;                    /**< The height of the frames */
+    FrameEncoding encoding_     = FrameEncoding::Float; /**< The storage of the pixels */
+    uint32_t      frame_count_  = 0;                    /**< The number of frames in the container */
+    uint64_t      frame_size_   = 0;                    /**< The size of an encoded frame (in bytes) */
+    uint64_t      index_offset_ = 0;                    /**< Offset of the frame index (in bytes) */
+};
+} // namespace Capsaicin
@@ -0,0 +1,318 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "gfx_recorder.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace Capsaicin
+{
+bool                                        GfxRecorder::recording_ = false;
+bool                                        GfxRecorder::in_frame_  = false;
+std::vector<GfxRecordedFrame>               GfxRecorder::frames_;
+std::vector<uint32_t>                       GfxRecorder::scope_stack_;
+std::vector<GfxRecorder::Clock::time_point> GfxRecorder::scope_starts_;
+GfxRecorder::Clock::time_point              GfxRecorder::frame_start_;
+
+namespace
+{
+uint32_t GetBitsPerPixel(DXGI_FORMAT format) noexcept
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R32G32B32A32_FLOAT:
+    case DXGI_FORMAT_R32G32B32A32_UINT:
+    case DXGI_FORMAT_R32G32B32A32_SINT: return 128;
+    case DXGI_FORMAT_R32G32B32_FLOAT:
+    case DXGI_FORMAT_R32G32B32_UINT:
+    case DXGI_FORMAT_R32G32B32_SINT: return 96;
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+    case DXGI_FORMAT_R16G16B16A16_UNORM:
+    case DXGI_FORMAT_R16G16B16A16_UINT:
+    case DXGI_FORMAT_R16G16B16A16_SNORM:
+    case DXGI_FORMAT_R16G16B16A16_SINT:
+    case DXGI_FORMAT_R32G32_FLOAT:
+    case DXGI_FORMAT_R32G32_UINT:
+    case DXGI_FORMAT_R32G32_SINT:
+    case DXGI_FORMAT_D32_FLOAT_S8X24_UINT: return 64;
+    case DXGI_FORMAT_R10G10B10A2_UNORM:
+    case DXGI_FORMAT_R10G10B10A2_UINT:
+    case DXGI_FORMAT_R11G11B10_FLOAT:
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_R8G8B8A8_UINT:
+    case DXGI_FORMAT_R8G8B8A8_SNORM:
+    case DXGI_FORMAT_R8G8B8A8_SINT:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    case DXGI_FORMAT_R16G16_FLOAT:
+    case DXGI_FORMAT_R16G16_UNORM:
+    case DXGI_FORMAT_R16G16_UINT:
+    case DXGI_FORMAT_R16G16_SNORM:
+    case DXGI_FORMAT_R16G16_SINT:
+    case DXGI_FORMAT_R32_FLOAT:
+    case DXGI_FORMAT_R32_UINT:
+    case DXGI_FORMAT_R32_SINT:
+    case DXGI_FORMAT_D32_FLOAT:
+    case DXGI_FORMAT_D24_UNORM_S8_UINT:
+    case DXGI_FORMAT_R9G9B9E5_SHAREDEXP: return 32;
+    case DXGI_FORMAT_R8G8_UNORM:
+    case DXGI_FORMAT_R8G8_UINT:
+    case DXGI_FORMAT_R8G8_SNORM:
+    case DXGI_FORMAT_R8G8_SINT:
+    case DXGI_FORMAT_R16_FLOAT:
+    case DXGI_FORMAT_R16_UNORM:
+    case DXGI_FORMAT_R16_UINT:
+    case DXGI_FORMAT_R16_SNORM:
+    case DXGI_FORMAT_R16_SINT:
+    case DXGI_FORMAT_D16_UNORM: return 16;
+    case DXGI_FORMAT_R8_UNORM:
+    case DXGI_FORMAT_R8_UINT:
+    case DXGI_FORMAT_R8_SNORM:
+    case DXGI_FORMAT_R8_SINT:
+    case DXGI_FORMAT_A8_UNORM:
+    case DXGI_FORMAT_BC2_UNORM:
+    case DXGI_FORMAT_BC2_UNORM_SRGB:
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+    case DXGI_FORMAT_BC5_UNORM:
+    case DXGI_FORMAT_BC5_SNORM:
+    case DXGI_FORMAT_BC6H_UF16:
+    case DXGI_FORMAT_BC6H_SF16:
+    case DXGI_FORMAT_BC7_UNORM:
+    case DXGI_FORMAT_BC7_UNORM_SRGB: return 8;
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+    case DXGI_FORMAT_BC4_UNORM:
+    case DXGI_FORMAT_BC4_SNORM: return 4;
+    default: return 0;
+    }
+}
+
+void WriteCounts(std::ofstream &json_file, char const *key, GfxRecordedScope const &scope, bool bytes)
+{
+    json_file << "\"" << key << "\": {";
+    bool first = true;
+    for (uint32_t type = 0; type < (uint32_t)GfxCallType::Count; ++type)
+    {
+        if (scope.counts[type] == 0) continue;
+        json_file << (first ? "" : ", ") << "\"" << GfxRecorder::GetCallTypeName((GfxCallType)type)
+                  << "\": " << (bytes ? scope.bytes[type] : (uint64_t)scope.counts[type]);
+        first = false;
+    }
+    json_file << "}";
+}
+} // unnamed namespace
+
+void GfxRecorder::Start() noexcept
+{
+    frames_.clear();
+    scope_stack_.clear();
+    scope_starts_.clear();
+    in_frame_  = false;
+    recording_ = true;
+}
+
+void GfxRecorder::Stop() noexcept
+{
+    if (in_frame_) EndFrame();
+    recording_ = false;
+}
+
+void GfxRecorder::BeginFrame(uint32_t frame_index) noexcept
+{
+    if (!recording_) return;
+    if (in_frame_) EndFrame();
+    frames_.emplace_back();
+    frames_.back().frame_index = frame_index;
+    frames_.back().scopes.emplace_back().name = "Capsaicin";
+    scope_stack_.clear();
+    scope_starts_.clear();
+    frame_start_ = Clock::now();
+    in_frame_    = true;
+}
+
+void GfxRecorder::EndFrame() noexcept
+{
+    if (!in_frame_) return;
+    Clock::time_point const now = Clock::now();
+    while (!scope_stack_.empty())
+    {
+        EndScope();
+    }
+    GfxRecordedFrame &frame       = frames_.back();
+    frame.cpu_time                = std::chrono::duration<double>(now - frame_start_).count();
+    frame.scopes.front().cpu_time = frame.cpu_time;
+    in_frame_                     = false;
+}
+
+void GfxRecorder::BeginScope(std::string_view const &name) noexcept
+{
+    if (!recording_ || !in_frame_) return;
+    std::vector<GfxRecordedScope> &scopes = frames_.back().scopes;
+    auto const scope = std::find_if(
+        scopes.cbegin(), scopes.cend(), [&name](GfxRecordedScope const &item) { return item.name == name; });
+    uint32_t const index = (uint32_t)(scope - scopes.cbegin());
+    if (scope == scopes.cend())
+    {
+        scopes.emplace_back().name = name;
+    }
+    scope_stack_.push_back(index);
+    scope_starts_.push_back(Clock::now());
+}
+
+void GfxRecorder::EndScope() noexcept
+{
+    if (!in_frame_ || scope_stack_.empty()) return;
+    uint32_t const index = scope_stack_.back();
+    scope_stack_.pop_back();
+    Clock::time_point const start = scope_starts_.back();
+    scope_starts_.pop_back();
+    // Only the outermost entry of a scope is timed, so that nested sections of a technique are not counted twice
+    if (std::find(scope_stack_.cbegin(), scope_stack_.cend(), index) == scope_stack_.cend())
+    {
+        frames_.back().scopes[index].cpu_time += std::chrono::duration<double>(Clock::now() - start).count();
+    }
+}
+
+void GfxRecorder::Record(GfxCallType type, uint64_t bytes, uint32_t x, uint32_t y, uint32_t z) noexcept
+{
+    if (!recording_) return;
+    if (!in_frame_ && (frames_.empty() || frames_.back().frame_index != GfxRecordedFrame::kNoFrame))
+    {
+        // Calls made between frames (e.g., while loading a scene) are gathered in their own frame
+        frames_.emplace_back();
+        frames_.back().frame_index = GfxRecordedFrame::kNoFrame;
+        frames_.back().scopes.emplace_back().name = "Capsaicin";
+    }
+    GfxRecordedFrame &frame = frames_.back();
+    GfxRecordedCall  &call  = frame.calls.emplace_back();
+    call.type               = type;
+    call.scope              = (in_frame_ && !scope_stack_.empty() ? scope_stack_.back() : 0);
+    call.bytes              = bytes;
+    call.size[0]            = x;
+    call.size[1]            = y;
+    call.size[2]            = z;
+    GfxRecordedScope &scope = frame.scopes[call.scope];
+    ++scope.counts[(size_t)type];
+    scope.bytes[(size_t)type] += bytes;
+    if (call.scope != 0)
+    {
+        ++frame.scopes.front().counts[(size_t)type];
+        frame.scopes.front().bytes[(size_t)type] += bytes;
+    }
+}
+
+std::string_view GfxRecorder::GetCallTypeName(GfxCallType type) noexcept
+{
+    switch (type)
+    {
+    case GfxCallType::CreateBuffer: return "CreateBuffer";
+    case GfxCallType::CreateTexture: return "CreateTexture";
+    case GfxCallType::DestroyBuffer: return "DestroyBuffer";
+    case GfxCallType::DestroyTexture: return "DestroyTexture";
+    case GfxCallType::CreateKernel: return "CreateKernel";
+    case GfxCallType::Dispatch: return "Dispatch";
+    case GfxCallType::DispatchIndirect: return "DispatchIndirect";
+    case GfxCallType::DispatchRays: return "DispatchRays";
+    case GfxCallType::Draw: return "Draw";
+    case GfxCallType::CopyBuffer: return "CopyBuffer";
+    case GfxCallType::CopyTexture: return "CopyTexture";
+    case GfxCallType::ClearBuffer: return "ClearBuffer";
+    case GfxCallType::ClearTexture: return "ClearTexture";
+    case GfxCallType::CreateRaytracingPrimitive: return "CreateRaytracingPrimitive";
+    case GfxCallType::BuildRaytracingPrimitive: return "BuildRaytracingPrimitive";
+    case GfxCallType::UpdateAccelerationStructure: return "UpdateAccelerationStructure";
+    case GfxCallType::Upload: return "Upload";
+    default: return "Unknown";
+    }
+}
+
+bool GfxRecorder::Write(char const *file_path, bool calls) noexcept
+{
+    std::ofstream json_file(file_path);
+    if (!json_file.is_open())
+    {
+        GFX_PRINTLN("Failed to open gfx recording file '%s'", file_path);
+        return false;
+    }
+    json_file << "{" << '\n' << "    \"frames\": [" << '\n';
+    for (size_t frame_index = 0; frame_index < frames_.size(); ++frame_index)
+    {
+        GfxRecordedFrame const &frame = frames_[frame_index];
+        json_file << "        {" << '\n'
+                  << "            \"frame\": "
+                  << (frame.frame_index == GfxRecordedFrame::kNoFrame ? -1 : (int64_t)frame.frame_index) << ","
+                  << '\n'
+                  << "            \"cpu_time\": " << frame.cpu_time << "," << '\n'
+                  << "            \"scopes\": [" << '\n';
+        for (size_t scope_index = 0; scope_index < frame.scopes.size(); ++scope_index)
+        {
+            GfxRecordedScope const &scope = frame.scopes[scope_index];
+            json_file << "                {\"name\": \"" << scope.name << "\", \"cpu_time\": " << scope.cpu_time
+                      << ", ";
+            WriteCounts(json_file, "counts", scope, false);
+            json_file << ", ";
+            WriteCounts(json_file, "bytes", scope, true);
+            json_file << "}" << (scope_index + 1 < frame.scopes.size() ? "," : "") << '\n';
+        }
+        json_file << "            ]";
+        if (calls)
+        {
+            json_file << "," << '\n' << "            \"calls\": [" << '\n';
+            for (size_t call_index = 0; call_index < frame.calls.size(); ++call_index)
+            {
+                GfxRecordedCall const &call = frame.calls[call_index];
+                json_file << "                {\"type\": \"" << GetCallTypeName(call.type) << "\", \"scope\": \""
+                          << frame.scopes[call.scope].name << "\", \"bytes\": " << call.bytes << ", \"size\": ["
+                          << call.size[0] << ", " << call.size[1] << ", " << call.size[2] << "]}"
+                          << (call_index + 1 < frame.calls.size() ? "," : "") << '\n';
+            }
+            json_file << "            ]";
+        }
+        json_file << '\n' << "        }" << (frame_index + 1 < frames_.size() ? "," : "") << '\n';
+    }
+    json_file << "    ]" << '\n' << "}" << '\n';
+    return json_file.good();
+}
+
+uint64_t GfxRecorder::GetBytes(GfxTexture const &texture) noexcept
+{
+    if (!texture) return 0;
+    uint64_t bytes = 0;
+    for (uint32_t mip_level = 0; mip_level < texture.getMipLevels(); ++mip_level)
+    {
+        uint64_t const width  = std::max(texture.getWidth() >> mip_level, 1U);
+        uint64_t const height = std::max(texture.getHeight() >> mip_level, 1U);
+        uint64_t const depth  = (texture.is3D() ? std::max(texture.getDepth() >> mip_level, 1U)
+                                                : std::max(texture.getDepth(), 1U));
+        bytes += GetBytes(texture.getFormat(), width * height * depth);
+    }
+    return bytes;
+}
+
+uint64_t GfxRecorder::GetBytes(DXGI_FORMAT format, uint64_t texel_count) noexcept
+{
+    return (texel_count * GetBitsPerPixel(format) + 7) / 8;
+}
+} // namespace Capsaicin
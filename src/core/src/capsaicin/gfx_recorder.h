@@ -0,0 +1,435 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <gfx.h>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Capsaicin
+{
+/** Type of a recorded gfx call. */
+enum class GfxCallType : uint8_t
+{
+    CreateBuffer = 0,
+    CreateTexture,
+    DestroyBuffer,
+    DestroyTexture,
+    CreateKernel,
+    Dispatch,
+    DispatchIndirect,
+    DispatchRays,
+    Draw,
+    CopyBuffer,
+    CopyTexture,
+    ClearBuffer,
+    ClearTexture,
+    CreateRaytracingPrimitive,
+    BuildRaytracingPrimitive,
+    UpdateAccelerationStructure,
+    Upload,
+    Count
+};
+
+/** A single recorded gfx call. */
+struct GfxRecordedCall
+{
+    GfxCallType type    = GfxCallType::Count; /**< The type of call */
+    uint32_t    scope   = 0;                  /**< Index of the frame scope the call was made in */
+    uint64_t    bytes   = 0;                  /**< Size of the resource created or data written (0 if unknown) */
+    uint32_t    size[3] = {0, 0, 0};          /**< Group count of dispatches, vertex and instance counts of draws */
+};
+
+/** Calls recorded during a frame from within a named scope (i.e., a render technique or component). */
+struct GfxRecordedScope
+{
+    std::string name;                                    /**< The scope name */
+    double      cpu_time                           = 0.0; /**< CPU time spent inside the scope (in seconds) */
+    uint32_t    counts[(size_t)GfxCallType::Count] = {};  /**< Number of calls of each type */
+    uint64_t    bytes[(size_t)GfxCallType::Count]  = {};  /**< Bytes created or written by each call type */
+};
+
+/** The calls recorded during a single frame. */
+struct GfxRecordedFrame
+{
+    uint32_t                      frame_index = 0;   /**< Index of the frame, kNoFrame for calls made between frames */
+    double                        cpu_time    = 0.0; /**< CPU time spent recording the frame (in seconds) */
+    std::vector<GfxRecordedScope> scopes;            /**< Totals of each scope, the first one is the frame itself */
+    std::vector<GfxRecordedCall>  calls;             /**< The recorded command stream */
+
+    static constexpr uint32_t kNoFrame = 0xFFFFFFFFu;
+};
+
+/**
+ * Records the gfx calls made by Capsaicin into a per-frame command stream.
+ * Calls are attributed to the innermost timed section's owner (i.e., render technique or component) so that CPU
+ * time, resource creation, upload bytes and dispatch counts can be compared per technique between runs.
+ * Calls are only captured when built with CAPSAICIN_ENABLE_GFX_RECORDING, in which case the gfx functions are
+ * routed through the wrappers below by every file including this header after gfx. Must only be used from the
+ * render thread.
+ */
+class GfxRecorder
+{
+public:
+    /**
+     * Start recording, discarding any previously recorded frames.
+     */
+    static void Start() noexcept;
+
+    /**
+     * Stop recording, the recorded frames remain available.
+     */
+    static void Stop() noexcept;
+
+    /**
+     * Check if calls are being recorded.
+     * @returns True if recording.
+     */
+    static bool IsRecording() noexcept { return recording_; }
+
+    /**
+     * Start a new frame, calls made outside of a frame are recorded in a separate frame.
+     * @param frame_index The index of the frame.
+     */
+    static void BeginFrame(uint32_t frame_index) noexcept;
+
+    /**
+     * End the current frame.
+     */
+    static void EndFrame() noexcept;
+
+    /**
+     * Enter a named scope, nested scopes of the same name are merged.
+     * @param name The scope name.
+     */
+    static void BeginScope(std::string_view const &name) noexcept;
+
+    /**
+     * Leave the current scope.
+     */
+    static void EndScope() noexcept;
+
+    /**
+     * Record a call.
+     * @param type  The type of call.
+     * @param bytes The size of the resource created or of the data written (0 if unknown).
+     * @param x     The first dimension of the work (e.g., dispatched group count along X).
+     * @param y     The second dimension of the work.
+     * @param z     The third dimension of the work.
+     */
+    static void Record(GfxCallType type, uint64_t bytes = 0, uint32_t x = 0, uint32_t y = 0, uint32_t z = 0) noexcept;
+
+    /**
+     * Gets the recorded frames.
+     * @returns The list of frames, in recording order.
+     */
+    static std::vector<GfxRecordedFrame> const &GetFrames() noexcept { return frames_; }
+
+    /**
+     * Gets the name of a call type.
+     * @param type The type of call.
+     * @returns The type name.
+     */
+    static std::string_view GetCallTypeName(GfxCallType type) noexcept;
+
+    /**
+     * Write the recorded frames to a JSON file.
+     * @param file_path Full pathname to the file to write.
+     * @param calls     True to also write the command stream of each frame, False for the per-scope totals only.
+     * @returns True if succeeded, False if the file could not be written.
+     */
+    static bool Write(char const *file_path, bool calls) noexcept;
+
+    /**
+     * Gets the size of a buffer.
+     * @param buffer The buffer.
+     * @returns The size (in bytes).
+     */
+    static uint64_t GetBytes(GfxBuffer const &buffer) noexcept { return buffer.getSize(); }
+
+    /**
+     * Gets the size of a texture including all its mip levels.
+     * @param texture The texture.
+     * @returns The size (in bytes, 0 for unknown formats).
+     */
+    static uint64_t GetBytes(GfxTexture const &texture) noexcept;
+
+    /**
+     * Gets the size of a number of texels of a given format.
+     * @param format      The texel format.
+     * @param texel_count The number of texels.
+     * @returns The size (in bytes, 0 for unknown formats).
+     */
+    static uint64_t GetBytes(DXGI_FORMAT format, uint64_t texel_count) noexcept;
+
+    // The wrappers the gfx functions are routed through, they forward all their arguments so as not to depend on
+    // the exact gfx signatures and overloads
+
+    template<typename TYPE = void, typename... ARGS>
+    static GfxBuffer CreateBuffer(GfxContext const &gfx, ARGS &&...args) noexcept
+    {
+        GfxBuffer buffer;
+        if constexpr (std::is_void_v<TYPE>)
+        {
+            buffer = ::gfxCreateBuffer(gfx, std::forward<ARGS>(args)...);
+        }
+        else
+        {
+            buffer = ::gfxCreateBuffer<TYPE>(gfx, std::forward<ARGS>(args)...);
+        }
+        if (recording_) Record(GfxCallType::CreateBuffer, buffer.getSize());
+        return buffer;
+    }
+
+#define CAPSAICIN_GFX_RECORDER_CREATE_TEXTURE(WRAPPER, FUNCTION)               \
+    template<typename... ARGS>                                                 \
+    static GfxTexture WRAPPER(GfxContext const &gfx, ARGS &&...args) noexcept  \
+    {                                                                          \
+        GfxTexture texture = ::FUNCTION(gfx, std::forward<ARGS>(args)...);     \
+        if (recording_) Record(GfxCallType::CreateTexture, GetBytes(texture)); \
+        return texture;                                                        \
+    }
+    CAPSAICIN_GFX_RECORDER_CREATE_TEXTURE(CreateTexture2D, gfxCreateTexture2D)
+    CAPSAICIN_GFX_RECORDER_CREATE_TEXTURE(CreateTexture2DArray, gfxCreateTexture2DArray)
+    CAPSAICIN_GFX_RECORDER_CREATE_TEXTURE(CreateTexture3D, gfxCreateTexture3D)
+    CAPSAICIN_GFX_RECORDER_CREATE_TEXTURE(CreateTextureCube, gfxCreateTextureCube)
+#undef CAPSAICIN_GFX_RECORDER_CREATE_TEXTURE
+
+    static GfxResult DestroyBuffer(GfxContext const &gfx, GfxBuffer const &buffer) noexcept
+    {
+        if (recording_ && buffer) Record(GfxCallType::DestroyBuffer, buffer.getSize());
+        return ::gfxDestroyBuffer(gfx, buffer);
+    }
+
+    static GfxResult DestroyTexture(GfxContext const &gfx, GfxTexture const &texture) noexcept
+    {
+        if (recording_ && texture) Record(GfxCallType::DestroyTexture, GetBytes(texture));
+        return ::gfxDestroyTexture(gfx, texture);
+    }
+
+#define CAPSAICIN_GFX_RECORDER_CREATE_KERNEL(WRAPPER, FUNCTION)              \
+    template<typename... ARGS>                                               \
+    static GfxKernel WRAPPER(GfxContext const &gfx, ARGS &&...args) noexcept \
+    {                                                                        \
+        if (recording_) Record(GfxCallType::CreateKernel);                   \
+        return ::FUNCTION(gfx, std::forward<ARGS>(args)...);                 \
+    }
+    CAPSAICIN_GFX_RECORDER_CREATE_KERNEL(CreateComputeKernel, gfxCreateComputeKernel)
+    CAPSAICIN_GFX_RECORDER_CREATE_KERNEL(CreateGraphicsKernel, gfxCreateGraphicsKernel)
+    CAPSAICIN_GFX_RECORDER_CREATE_KERNEL(CreateRaytracingKernel, gfxCreateRaytracingKernel)
+#undef CAPSAICIN_GFX_RECORDER_CREATE_KERNEL
+
+    template<typename... ARGS>
+    static GfxResult CommandDispatch(GfxContext const &gfx, ARGS &&...args) noexcept
+    {
+        if (recording_) RecordWork(GfxCallType::Dispatch, 0, args...);
+        return ::gfxCommandDispatch(gfx, std::forward<ARGS>(args)...);
+    }
+
+    template<typename... ARGS>
+    static GfxResult CommandDispatchIndirect(GfxContext const &gfx, ARGS &&...args) noexcept
+    {
+        if (recording_) Record(GfxCallType::DispatchIndirect);
+        return ::gfxCommandDispatchIndirect(gfx, std::forward<ARGS>(args)...);
+    }
+
+    template<typename SBT, typename... ARGS>
+    static GfxResult CommandDispatchRays(GfxContext const &gfx, SBT const &sbt, ARGS &&...args) noexcept
+    {
+        if (recording_) RecordWork(GfxCallType::DispatchRays, 0, args...);
+        return ::gfxCommandDispatchRays(gfx, sbt, std::forward<ARGS>(args)...);
+    }
+
+    template<typename... ARGS>
+    static GfxResult CommandDispatchRaysIndirect(GfxContext const &gfx, ARGS &&...args) noexcept
+    {
+        if (recording_) Record(GfxCallType::DispatchIndirect);
+        return ::gfxCommandDispatchRaysIndirect(gfx, std::forward<ARGS>(args)...);
+    }
+
+#define CAPSAICIN_GFX_RECORDER_DRAW(WRAPPER, FUNCTION)                       \
+    template<typename... ARGS>                                               \
+    static GfxResult WRAPPER(GfxContext const &gfx, ARGS &&...args) noexcept \
+    {                                                                        \
+        if (recording_) RecordWork(GfxCallType::Draw, 0, args...);           \
+        return ::FUNCTION(gfx, std::forward<ARGS>(args)...);                 \
+    }
+    CAPSAICIN_GFX_RECORDER_DRAW(CommandDraw, gfxCommandDraw)
+    CAPSAICIN_GFX_RECORDER_DRAW(CommandDrawIndexed, gfxCommandDrawIndexed)
+#undef CAPSAICIN_GFX_RECORDER_DRAW
+
+#define CAPSAICIN_GFX_RECORDER_COPY(WRAPPER, FUNCTION, TYPE)                 \
+    template<typename... ARGS>                                               \
+    static GfxResult WRAPPER(GfxContext const &gfx, ARGS &&...args) noexcept \
+    {                                                                        \
+        if (recording_) Record(GfxCallType::TYPE, GetCopyBytes(args...));    \
+        return ::FUNCTION(gfx, std::forward<ARGS>(args)...);                 \
+    }
+    CAPSAICIN_GFX_RECORDER_COPY(CommandCopyBuffer, gfxCommandCopyBuffer, CopyBuffer)
+    CAPSAICIN_GFX_RECORDER_COPY(CommandCopyTexture, gfxCommandCopyTexture, CopyTexture)
+    CAPSAICIN_GFX_RECORDER_COPY(CommandCopyBufferToTexture, gfxCommandCopyBufferToTexture, CopyTexture)
+#undef CAPSAICIN_GFX_RECORDER_COPY
+
+#define CAPSAICIN_GFX_RECORDER_CLEAR(WRAPPER, FUNCTION, TYPE)                       \
+    template<typename RESOURCE, typename... ARGS>                                   \
+    static GfxResult WRAPPER(                                                       \
+        GfxContext const &gfx, RESOURCE const &resource, ARGS &&...args) noexcept   \
+    {                                                                               \
+        if (recording_) Record(GfxCallType::TYPE, GetBytes(resource));              \
+        return ::FUNCTION(gfx, resource, std::forward<ARGS>(args)...);              \
+    }
+    CAPSAICIN_GFX_RECORDER_CLEAR(CommandClearBuffer, gfxCommandClearBuffer, ClearBuffer)
+    CAPSAICIN_GFX_RECORDER_CLEAR(CommandClearTexture, gfxCommandClearTexture, ClearTexture)
+#undef CAPSAICIN_GFX_RECORDER_CLEAR
+
+    template<typename... ARGS>
+    static GfxRaytracingPrimitive CreateRaytracingPrimitive(GfxContext const &gfx, ARGS &&...args) noexcept
+    {
+        if (recording_) Record(GfxCallType::CreateRaytracingPrimitive);
+        return ::gfxCreateRaytracingPrimitive(gfx, std::forward<ARGS>(args)...);
+    }
+
+    template<typename PRIMITIVE, typename... ARGS>
+    static GfxResult RaytracingPrimitiveBuild(
+        GfxContext const &gfx, PRIMITIVE const &primitive, ARGS &&...args) noexcept
+    {
+        if (recording_) Record(GfxCallType::BuildRaytracingPrimitive, GetFirstBytes(args...));
+        return ::gfxRaytracingPrimitiveBuild(gfx, primitive, std::forward<ARGS>(args)...);
+    }
+
+    template<typename PRIMITIVE, typename... ARGS>
+    static GfxResult RaytracingPrimitiveUpdate(
+        GfxContext const &gfx, PRIMITIVE const &primitive, ARGS &&...args) noexcept
+    {
+        if (recording_) Record(GfxCallType::BuildRaytracingPrimitive, GetFirstBytes(args...));
+        return ::gfxRaytracingPrimitiveUpdate(gfx, primitive, std::forward<ARGS>(args)...);
+    }
+
+    template<typename... ARGS>
+    static GfxResult AccelerationStructureUpdate(GfxContext const &gfx, ARGS &&...args) noexcept
+    {
+        if (recording_) Record(GfxCallType::UpdateAccelerationStructure);
+        return ::gfxAccelerationStructureUpdate(gfx, std::forward<ARGS>(args)...);
+    }
+
+private:
+    /** Record a call whose first arguments are the dimensions of the work (e.g., dispatched group counts). */
+    template<typename... ARGS>
+    static void RecordWork(GfxCallType type, uint64_t bytes, ARGS const &...args) noexcept
+    {
+        uint32_t   size[3] = {0, 0, 0};
+        uint32_t   index   = 0;
+        auto const gather  = [&](auto const &arg) {
+            if constexpr (std::is_arithmetic_v<std::decay_t<decltype(arg)>>)
+            {
+                if (index < 3) size[index++] = (uint32_t)arg;
+            }
+            else
+            {
+                index = 3; // only leading integral arguments are dimensions
+            }
+        };
+        (gather(args), ...);
+        Record(type, bytes, size[0], size[1], size[2]);
+    }
+
+    /** Gets the bytes written by a copy, whole resource copies use the smaller of both resources. */
+    template<typename... ARGS>
+    static uint64_t GetCopyBytes(ARGS const &...args) noexcept
+    {
+        auto const arguments = std::forward_as_tuple(args...);
+        if constexpr (sizeof...(ARGS) == 2)
+        {
+            uint64_t const dst_bytes = GetFirstBytes(std::get<0>(arguments));
+            uint64_t const src_bytes = GetFirstBytes(std::get<1>(arguments));
+            return dst_bytes < src_bytes ? dst_bytes : src_bytes;
+        }
+        else if constexpr (sizeof...(ARGS) == 5)
+        {
+            return (uint64_t)std::get<4>(arguments); // dst, dst_offset, src, src_offset, size
+        }
+        else
+        {
+            return 0; // partial copies of textures
+        }
+    }
+
+    /** Gets the size of the first resource in a list of arguments (0 if none). */
+    template<typename ARG, typename... ARGS>
+    static uint64_t GetFirstBytes(ARG const &arg, ARGS const &...args) noexcept
+    {
+        if constexpr (std::is_same_v<ARG, GfxBuffer> || std::is_same_v<ARG, GfxTexture>)
+        {
+            return GetBytes(arg);
+        }
+        else
+        {
+            return GetFirstBytes(args...);
+        }
+    }
+    static uint64_t GetFirstBytes() noexcept { return 0; }
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    static bool                           recording_;    /**< Whether calls are being recorded */
+    static bool                           in_frame_;     /**< Whether a frame was begun and not ended */
+    static std::vector<GfxRecordedFrame>  frames_;       /**< The recorded frames */
+    static std::vector<uint32_t>          scope_stack_;  /**< Index of each entered scope in the current frame */
+    static std::vector<Clock::time_point> scope_starts_; /**< Time each entered scope was entered */
+    static Clock::time_point              frame_start_;  /**< Time the current frame was begun */
+};
+} // namespace Capsaicin
+
+#ifdef CAPSAICIN_ENABLE_GFX_RECORDING
+// Route the gfx calls through the recorder, object-like macros also catch the typed buffer creation templates
+#    define gfxCreateBuffer                ::Capsaicin::GfxRecorder::CreateBuffer
+#    define gfxCreateTexture2D             ::Capsaicin::GfxRecorder::CreateTexture2D
+#    define gfxCreateTexture2DArray        ::Capsaicin::GfxRecorder::CreateTexture2DArray
+#    define gfxCreateTexture3D             ::Capsaicin::GfxRecorder::CreateTexture3D
+#    define gfxCreateTextureCube           ::Capsaicin::GfxRecorder::CreateTextureCube
+#    define gfxDestroyBuffer               ::Capsaicin::GfxRecorder::DestroyBuffer
+#    define gfxDestroyTexture              ::Capsaicin::GfxRecorder::DestroyTexture
+#    define gfxCreateComputeKernel         ::Capsaicin::GfxRecorder::CreateComputeKernel
+#    define gfxCreateGraphicsKernel        ::Capsaicin::GfxRecorder::CreateGraphicsKernel
+#    define gfxCreateRaytracingKernel      ::Capsaicin::GfxRecorder::CreateRaytracingKernel
+#    define gfxCommandDispatch             ::Capsaicin::GfxRecorder::CommandDispatch
+#    define gfxCommandDispatchIndirect     ::Capsaicin::GfxRecorder::CommandDispatchIndirect
+#    define gfxCommandDispatchRays         ::Capsaicin::GfxRecorder::CommandDispatchRays
+#    define gfxCommandDispatchRaysIndirect ::Capsaicin::GfxRecorder::CommandDispatchRaysIndirect
+#    define gfxCommandDraw                 ::Capsaicin::GfxRecorder::CommandDraw
+#    define gfxCommandDrawIndexed          ::Capsaicin::GfxRecorder::CommandDrawIndexed
+#    define gfxCommandCopyBuffer           ::Capsaicin::GfxRecorder::CommandCopyBuffer
+#    define gfxCommandCopyTexture          ::Capsaicin::GfxRecorder::CommandCopyTexture
+#    define gfxCommandCopyBufferToTexture  ::Capsaicin::GfxRecorder::CommandCopyBufferToTexture
+#    define gfxCommandClearBuffer          ::Capsaicin::GfxRecorder::CommandClearBuffer
+#    define gfxCommandClearTexture         ::Capsaicin::GfxRecorder::CommandClearTexture
+#    define gfxCreateRaytracingPrimitive   ::Capsaicin::GfxRecorder::CreateRaytracingPrimitive
+#    define gfxRaytracingPrimitiveBuild    ::Capsaicin::GfxRecorder::RaytracingPrimitiveBuild
+#    define gfxRaytracingPrimitiveUpdate   ::Capsaicin::GfxRecorder::RaytracingPrimitiveUpdate
+#    define gfxAccelerationStructureUpdate ::Capsaicin::GfxRecorder::AccelerationStructureUpdate
+#endif
@@ -22,6 +22,7 @@ THE SOFTWARE.
 #pragma once
 
 #include <array>
+#include <cstdint>
 
 namespace Capsaicin
 {
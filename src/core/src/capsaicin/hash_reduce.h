@@ -21,8 +21,10 @@ THE SOFTWARE.
 ********************************************************************/
 #pragma once
 
-#include "capsaicin_internal.h"
-#include "thread_pool.h"
+#include "parallel_algorithms.h"
+
+#include <functional>
+#include <glm/glm.hpp>
 
 namespace Capsaicin
 {
@@ -35,123 +37,18 @@ void HashCombine(size_t &seed, TYPE const &value)
 template<typename TYPE>
 size_t HashReduce(TYPE const *values, uint32_t count)
 {
-    uint32_t index = 0;
-
-    constexpr uint32_t const block_size = 16;
-
-    uint32_t block_count = (count + block_size - 1) / block_size;
-
-    if (!block_count)
-    {
-        return (size_t)0x12345678u;
-    }
-
-    size_t *partial_hashes[] = {
-        (size_t *)alloca(block_count * sizeof(size_t)),
-        (size_t *)alloca(((block_count + block_size - 1) / block_size) * sizeof(size_t)),
-    };
-
-    Capsaicin::ThreadPool().Dispatch(
-        [&](uint32_t i) {
-            size_t hash = 0x12345678u;
-
-            for (uint32_t j = i * block_size; j < (i + 1) * block_size; ++j)
-            {
-                if (j >= count)
-                {
-                    break;
-                }
-
-                HashCombine(hash, values[j]);
-            }
-
-            partial_hashes[index][i] = hash;
-        },
-        block_count, 1);
-
-    while (block_count > 1)
-    {
-        count = block_count;
-
-        block_count = (block_count + block_size - 1) / block_size;
-
-        Capsaicin::ThreadPool().Dispatch(
-            [&](uint32_t i) {
-                size_t hash = partial_hashes[index][i * block_size];
-
-                for (uint32_t j = i * block_size + 1; j < (i + 1) * block_size; ++j)
-                {
-                    if (j >= count)
-                    {
-                        break;
-                    }
-
-                    HashCombine(hash, partial_hashes[index][j]);
-                }
-
-                partial_hashes[1 - index][i] = hash;
-            },
-            block_count, 1);
-
-        index = 1 - index;
-    }
-
-    return *partial_hashes[index];
+    // The block hashes are combined in order, so the hash doesn't depend on the thread count
+    return ParallelTransformReduce(
+        count, (size_t)0x12345678u, [values](uint32_t i) { return std::hash<TYPE> {}(values[i]); },
+        [](size_t hash, size_t value) {
+            HashCombine(hash, value);
+            return hash;
+        });
 }
 } // namespace Capsaicin
 
 namespace std
 {
-template<>
-struct hash<GfxMesh>
-{
-    inline size_t operator()(GfxMesh const &value) const
-    {
-        size_t hash = 0x12345678u;
-
-        Capsaicin::HashCombine(hash, value.bounds_min);
-        Capsaicin::HashCombine(hash, value.bounds_max);
-        Capsaicin::HashCombine(hash, value.vertices.size());
-        Capsaicin::HashCombine(hash, value.indices.size());
-
-        return hash;
-    }
-};
-
-template<>
-struct hash<GfxInstance>
-{
-    inline size_t operator()(GfxInstance const &value) const
-    {
-        size_t hash = 0x12345678u;
-
-        Capsaicin::HashCombine(hash, (uint64_t)value.mesh);
-        Capsaicin::HashCombine(hash, (uint64_t)value.material);
-        Capsaicin::HashCombine(hash, value.transform);
-
-        return hash;
-    }
-};
-
-template<>
-struct hash<GfxLight>
-{
-    inline size_t operator()(GfxLight const &value) const
-    {
-        size_t hash = 0x12345678u;
-
-        Capsaicin::HashCombine(hash, value.color);
-        Capsaicin::HashCombine(hash, value.intensity);
-        Capsaicin::HashCombine(hash, value.position);
-        Capsaicin::HashCombine(hash, value.direction);
-        Capsaicin::HashCombine(hash, value.range);
-        Capsaicin::HashCombine(hash, value.inner_cone_angle);
-        Capsaicin::HashCombine(hash, value.outer_cone_angle);
-
-        return hash;
-    }
-};
-
 template<>
 struct hash<glm::mat4>
 {
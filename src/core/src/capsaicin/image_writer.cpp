@@ -0,0 +1,338 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "image_writer.h"
+
+#include "cpu_profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stb_image_write.h>
+#include <tinyexr.h>
+
+namespace Capsaicin
+{
+namespace
+{
+/** Maximum number of images being written in parallel */
+constexpr uint32_t kMaxWorkerThreads = 4;
+
+/** Maximum number of images queued or being written, further images are refused until some are written */
+constexpr uint32_t kMaxQueuedImages = 16;
+
+bool IsJPG(std::string const &file_path) noexcept
+{
+    char const *extension = strrchr(file_path.c_str(), '.');
+    return extension != nullptr
+        && (strcmp(extension, ".jpg") == 0 || strcmp(extension, ".jpeg") == 0 || strcmp(extension, ".JPG") == 0
+            || strcmp(extension, ".JPEG") == 0);
+}
+
+/**
+ * Encode and write an EXR image.
+ * @param [in,out] scratch Memory reused between images to hold the de-interleaved channels.
+ * @returns The number of bytes written (0 if failed).
+ */
+uint64_t WriteEXR(float const *data, uint32_t width, uint32_t height, char const *file_path,
+    ImageCompression compression, bool half, std::vector<float> &scratch) noexcept
+{
+    // EXR channels are stored in alphabetical order
+    char const channel_names[]  = {'B', 'G', 'R'};
+    int const  channel_offset[] = {2, 1, 0};
+    int const  channel_count    = ARRAYSIZE(channel_names);
+
+    // Header
+    EXRChannelInfo channel_infos[channel_count];
+    int            pixel_types[channel_count];
+    int            requested_pixel_types[channel_count];
+    for (int channel = 0; channel < channel_count; ++channel)
+    {
+        channel_infos[channel].name[0]  = channel_names[channel];
+        channel_infos[channel].name[1]  = '\0';
+        pixel_types[channel]           = TINYEXR_PIXELTYPE_FLOAT;
+        requested_pixel_types[channel] = (half ? TINYEXR_PIXELTYPE_HALF : TINYEXR_PIXELTYPE_FLOAT);
+    }
+
+    EXRHeader exr_header;
+    InitEXRHeader(&exr_header);
+    switch (compression)
+    {
+    case ImageCompression::None: exr_header.compression_type = TINYEXR_COMPRESSIONTYPE_NONE; break;
+    case ImageCompression::ZIP: exr_header.compression_type = TINYEXR_COMPRESSIONTYPE_ZIP; break;
+    default: exr_header.compression_type = TINYEXR_COMPRESSIONTYPE_PIZ; break;
+    }
+    exr_header.num_channels          = channel_count;
+    exr_header.channels              = channel_infos;
+    exr_header.pixel_types           = pixel_types;
+    exr_header.requested_pixel_types = requested_pixel_types;
+
+    // Image, de-interleaved into the scratch memory
+    size_t const pixel_count = (size_t)width * height;
+    scratch.resize(pixel_count * channel_count);
+    unsigned char *images[channel_count];
+    for (int channel = 0; channel < channel_count; ++channel)
+    {
+        float *image_channel = &scratch[pixel_count * channel];
+        images[channel]      = (unsigned char *)image_channel;
+        for (size_t pixel_index = 0; pixel_index < pixel_count; ++pixel_index)
+        {
+            image_channel[pixel_index] = data[4 * pixel_index + channel_offset[channel]];
+        }
+    }
+
+    EXRImage exr_image;
+    InitEXRImage(&exr_image);
+    exr_image.num_channels = channel_count;
+    exr_image.images       = images;
+    exr_image.width        = (int)width;
+    exr_image.height       = (int)height;
+
+    unsigned char *memory  = nullptr;
+    char const    *exr_err = nullptr;
+    size_t const   size    = SaveEXRImageToMemory(&exr_image, &exr_header, &memory, &exr_err);
+    if (size == 0)
+    {
+        if (exr_err != nullptr)
+        {
+            GFX_PRINT_ERROR(kGfxResult_InternalError, "Can't save '%s': %s", file_path, exr_err);
+            FreeEXRErrorMessage(exr_err);
+        }
+        else
+        {
+            GFX_PRINT_ERROR(kGfxResult_InternalError, "Can't save '%s'", file_path);
+        }
+        return 0;
+    }
+
+    std::ofstream file(file_path, std::ios::binary);
+    file.write((char const *)memory, (std::streamsize)size);
+    free(memory);
+    if (!file.good())
+    {
+        GFX_PRINT_ERROR(kGfxResult_InternalError, "Can't save '%s'", file_path);
+        return 0;
+    }
+    return size;
+}
+
+/**
+ * Encode and write a JPEG image.
+ * @param [in,out] scratch Memory reused between images to hold the quantized pixels.
+ * @returns The number of bytes written (0 if failed).
+ */
+uint64_t WriteJPG(
+    float const *data, uint32_t width, uint32_t height, char const *file_path, std::vector<uint8_t> &scratch) noexcept
+{
+    size_t const pixel_count = (size_t)width * height;
+    scratch.resize(pixel_count * 3);
+    for (size_t pixel_index = 0; pixel_index < pixel_count; ++pixel_index)
+    {
+        for (uint32_t channel = 0; channel < 3; ++channel)
+        {
+            scratch[3 * pixel_index + channel] =
+                (uint8_t)(std::clamp(data[4 * pixel_index + channel], 0.0f, 1.0f) * 255.0f);
+        }
+    }
+
+    struct Output
+    {
+        std::ofstream file;
+        uint64_t      bytes = 0;
+    } output;
+    output.file.open(file_path, std::ios::binary);
+    int const ret = stbi_write_jpg_to_func(
+        [](void *context, void *bytes, int size) {
+            Output &out = *(Output *)context;
+            out.file.write((char const *)bytes, size);
+            out.bytes += (uint64_t)size;
+        },
+        &output, (int)width, (int)height, 3, scratch.data(), 90);
+    if (ret == 0 || !output.file.good())
+    {
+        GFX_PRINT_ERROR(kGfxResult_InternalError, "Can't save '%s'", file_path);
+        return 0;
+    }
+    return output.bytes;
+}
+} // unnamed namespace
+
+bool ImageWriter::initialize(GfxContext gfx) noexcept
+{
+    terminate();
+
+    gfx_          = gfx;
+    terminate_    = false;
+    stats_        = ImageWriterStats();
+    window_bytes_ = 0;
+    window_start_ = std::chrono::steady_clock::now();
+
+    uint32_t const worker_count = std::clamp(std::thread::hardware_concurrency() / 4, 1u, kMaxWorkerThreads);
+    for (uint32_t i = 0; i < worker_count; ++i)
+    {
+        workers_.emplace_back(&ImageWriter::worker, this);
+    }
+    return true;
+}
+
+void ImageWriter::terminate() noexcept
+{
+    if (!isInitialized())
+    {
+        return;
+    }
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        terminate_ = true;
+    }
+    signal_.notify_all();
+    for (std::thread &worker : workers_)
+    {
+        worker.join();
+    }
+    workers_.clear();
+    update();
+}
+
+void ImageWriter::setExrFormat(ImageCompression compression, bool half) noexcept
+{
+    compression_ = compression;
+    half_        = half;
+}
+
+bool ImageWriter::write(
+    GfxBuffer const &buffer, uint32_t width, uint32_t height, std::string_view const &file_path) noexcept
+{
+    if (!isInitialized())
+    {
+        return false;
+    }
+    auto job         = std::make_shared<Job>();
+    job->buffer      = buffer;
+    job->data        = (float const *)gfxBufferGetData(gfx_, buffer);
+    job->width       = width;
+    job->height      = height;
+    job->file_path   = file_path;
+    job->compression = compression_;
+    job->half        = half_;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (jobs_.size() >= kMaxQueuedImages)
+        {
+            return false;
+        }
+        jobs_.push_back(std::move(job));
+        stats_.peak_queue_depth = std::max(stats_.peak_queue_depth, (uint32_t)jobs_.size());
+    }
+    signal_.notify_one();
+    return true;
+}
+
+void ImageWriter::update() noexcept
+{
+    // Release the buffers of written images, in any order as images may be written out of order
+    std::vector<GfxBuffer> written_buffers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = jobs_.begin(); it != jobs_.end();)
+        {
+            Job const &job = **it;
+            if (job.state != JobState::Written)
+            {
+                ++it;
+                continue;
+            }
+            written_buffers.push_back(job.buffer);
+            ++stats_.image_count;
+            stats_.bytes_written += job.bytes;
+            window_bytes_ += job.bytes;
+            it = jobs_.erase(it);
+        }
+        stats_.queue_depth = (uint32_t)jobs_.size();
+    }
+    for (GfxBuffer const &buffer : written_buffers)
+    {
+        gfxDestroyBuffer(gfx_, buffer);
+    }
+
+    auto const   now     = std::chrono::steady_clock::now();
+    double const elapsed = std::chrono::duration<double>(now - window_start_).count();
+    if (elapsed >= 1.0)
+    {
+        stats_.bytes_per_second = (double)window_bytes_ / elapsed;
+        window_bytes_           = 0;
+        window_start_           = now;
+    }
+}
+
+void ImageWriter::flush() noexcept
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    written_signal_.wait(lock, [&] {
+        return std::all_of(
+            jobs_.begin(), jobs_.end(), [](auto const &job) { return job->state == JobState::Written; });
+    });
+}
+
+void ImageWriter::worker() noexcept
+{
+    CpuProfiler::SetThreadName("ImageWriter");
+
+    // Scratch memory is kept for the lifetime of the worker so that encoding doesn't allocate for every image
+    std::vector<float>   exr_scratch;
+    std::vector<uint8_t> jpg_scratch;
+    for (;;)
+    {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            signal_.wait(lock, [&] {
+                return terminate_ || std::any_of(jobs_.begin(), jobs_.end(), [](auto const &queued_job) {
+                    return queued_job->state == JobState::Queued;
+                });
+            });
+            if (terminate_)
+            {
+                return;
+            }
+            job = *std::find_if(jobs_.begin(), jobs_.end(),
+                [](auto const &queued_job) { return queued_job->state == JobState::Queued; });
+            job->state = JobState::Writing;
+        }
+
+        // The buffer is owned by the job until it is released by update() so is safe to read without the lock
+        CAPSAICIN_PROFILE_SCOPE("WriteImage");
+        uint64_t const bytes =
+            IsJPG(job->file_path)
+                ? WriteJPG(job->data, job->width, job->height, job->file_path.c_str(), jpg_scratch)
+                : WriteEXR(job->data, job->width, job->height, job->file_path.c_str(), job->compression, job->half,
+                    exr_scratch);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job->bytes = bytes;
+            job->state = JobState::Written;
+        }
+        written_signal_.notify_all();
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,164 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <gfx.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Capsaicin
+{
+/** Compression used for EXR images. */
+enum class ImageCompression : uint8_t
+{
+    None = 0,
+    ZIP,
+    PIZ,
+};
+
+/** Statistics of the image writer. */
+struct ImageWriterStats
+{
+    uint32_t queue_depth      = 0;   /**< Number of images queued or being written */
+    uint32_t peak_queue_depth = 0;   /**< Highest queue depth since initialisation */
+    uint64_t image_count      = 0;   /**< Number of images written since initialisation */
+    uint64_t bytes_written    = 0;   /**< Number of bytes written since initialisation */
+    double   bytes_per_second = 0.0; /**< Bytes written per second, averaged over the last second */
+};
+
+/**
+ * Writes dumped images to disk on background worker threads.
+ * The writer takes ownership of the read back buffers so that the render thread never waits on encoding or disk
+ * I/O, buffers are released on the render thread once written. The queue is bounded, images are refused when it
+ * is full so that the caller can keep its read back buffer and try again later.
+ */
+class ImageWriter
+{
+public:
+    ImageWriter() noexcept = default;
+    ~ImageWriter() noexcept { terminate(); }
+
+    ImageWriter(ImageWriter const &)            = delete;
+    ImageWriter &operator=(ImageWriter const &) = delete;
+
+    /**
+     * Start the worker threads.
+     * @param gfx Active gfx context.
+     * @returns True if succeeded, False otherwise.
+     */
+    bool initialize(GfxContext gfx) noexcept;
+
+    /**
+     * Write all queued images, then stop the worker threads and release the read back buffers.
+     */
+    void terminate() noexcept;
+
+    /**
+     * Check whether the writer has been initialised.
+     * @returns True if initialised.
+     */
+    bool isInitialized() const noexcept { return !workers_.empty(); }
+
+    /**
+     * Set the format of the EXR images queued from now on.
+     * @param compression The compression to use.
+     * @param half        True to store half precision channels, False to store full precision ones.
+     */
+    void setExrFormat(ImageCompression compression, bool half) noexcept;
+
+    /**
+     * Queue an image for writing.
+     * @note The image is written as a JPEG if the file extension is '.jpg' or '.jpeg', as an EXR otherwise.
+     * @param buffer    Read back buffer holding 4 float channels per pixel, owned by the writer if queued.
+     * @param width     The width of the image.
+     * @param height    The height of the image.
+     * @param file_path Full pathname to the file to write.
+     * @returns True if queued, False if the queue is full.
+     */
+    bool write(
+        GfxBuffer const &buffer, uint32_t width, uint32_t height, std::string_view const &file_path) noexcept;
+
+    /**
+     * Release the buffers of written images and update the statistics.
+     * Must be called from the render thread, once per frame.
+     */
+    void update() noexcept;
+
+    /**
+     * Wait until all queued images have been written.
+     */
+    void flush() noexcept;
+
+    /**
+     * Gets the writer statistics.
+     * @returns The statistics as of the last update.
+     */
+    ImageWriterStats const &getStats() const noexcept { return stats_; }
+
+private:
+    /** State of a queued image. */
+    enum class JobState : uint32_t
+    {
+        Queued = 0, /**< Waiting for a worker thread */
+        Writing,    /**< Image is being encoded and written */
+        Written,    /**< Image is written, its buffer can be released */
+    };
+
+    /** A queued image. */
+    struct Job
+    {
+        GfxBuffer        buffer;                              /**< The read back buffer */
+        float const     *data        = nullptr;               /**< Mapped data of the buffer */
+        uint32_t         width       = 0;                     /**< The width of the image */
+        uint32_t         height      = 0;                     /**< The height of the image */
+        std::string      file_path;                           /**< Full pathname to the file to write */
+        ImageCompression compression = ImageCompression::PIZ; /**< EXR compression */
+        bool             half        = false;                 /**< Whether EXR channels are stored as halfs */
+        JobState         state       = JobState::Queued;      /**< The job progress */
+        uint64_t         bytes       = 0;                     /**< Number of bytes written */
+    };
+
+    void worker() noexcept;
+
+    GfxContext       gfx_;                                 /**< The gfx context owning the buffers */
+    ImageCompression compression_ = ImageCompression::PIZ; /**< Compression of the EXR images queued next */
+    bool             half_        = false;                 /**< Whether the EXR images queued next use halfs */
+
+    mutable std::mutex               mutex_;             /**< Protects the job queue */
+    std::condition_variable          signal_;            /**< Signals queued jobs and termination to workers */
+    std::condition_variable          written_signal_;    /**< Signals written jobs to flush() */
+    std::deque<std::shared_ptr<Job>> jobs_;              /**< Jobs in request order until their buffer is released */
+    std::vector<std::thread>         workers_;           /**< The worker threads encoding and writing images */
+    bool                             terminate_ = false; /**< Whether the worker threads must exit */
+
+    ImageWriterStats                      stats_;            /**< Statistics as of the last update */
+    uint64_t                              window_bytes_ = 0; /**< Bytes written during the current window */
+    std::chrono::steady_clock::time_point window_start_;     /**< Start of the current statistics window */
+};
+} // namespace Capsaicin
@@ -0,0 +1,467 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string_view>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint32_t kForsythCacheSize    = 32;  /**< Size of the modelled cache used for scoring vertices */
+constexpr uint32_t kForsythMaxValence   = 32;  /**< Valence above which vertices all get the same boost */
+constexpr float    kCacheDecayPower     = 1.5f;
+constexpr float    kLastTriangleScore   = 0.75f;
+constexpr float    kValenceBoostScale   = 2.0f;
+constexpr float    kValenceBoostPower   = 0.5f;
+constexpr uint32_t kFetchCacheLineCount = 256; /**< Number of lines of the modelled vertex fetch cache */
+
+constexpr char     kCacheMagic[4] = {'C', 'M', 'O', 'C'};
+constexpr uint32_t kCacheVersion  = 1;
+
+/** Lookup tables of Forsyth's vertex scoring function. */
+struct VertexScoreTable
+{
+    VertexScoreTable() noexcept
+    {
+        for (uint32_t i = 0; i < kForsythCacheSize; ++i)
+        {
+            if (i < 3)
+            {
+                // Vertices of the most recent triangle get a fixed score so that strips are not favoured
+                cache[i] = kLastTriangleScore;
+            }
+            else
+            {
+                float const scaler = 1.0f / (float)(kForsythCacheSize - 3);
+                cache[i]           = powf(1.0f - (float)(i - 3) * scaler, kCacheDecayPower);
+            }
+        }
+        valence[0] = 0.0f;
+        for (uint32_t i = 1; i <= kForsythMaxValence; ++i)
+        {
+            // Boost vertices with few remaining triangles so that they get retired early
+            valence[i] = kValenceBoostScale * powf((float)i, -kValenceBoostPower);
+        }
+    }
+
+    float cache[kForsythCacheSize];
+    float valence[kForsythMaxValence + 1];
+};
+
+float GetVertexScore(VertexScoreTable const &table, int32_t cache_position, uint32_t live_triangles) noexcept
+{
+    if (live_triangles == 0)
+    {
+        return -1.0f; // no triangles left to emit using this vertex
+    }
+    float score = cache_position >= 0 ? table.cache[cache_position] : 0.0f;
+    score += table.valence[std::min(live_triangles, kForsythMaxValence)];
+    return score;
+}
+
+/** Write an array of plain values to a binary file. */
+template<typename TYPE>
+bool WriteValues(FILE *file, TYPE const *values, size_t count) noexcept
+{
+    return count == 0 || fwrite(values, sizeof(TYPE), count, file) == count;
+}
+
+/** Read an array of plain values from a binary file. */
+template<typename TYPE>
+bool ReadValues(FILE *file, TYPE *values, size_t count) noexcept
+{
+    return count == 0 || fread(values, sizeof(TYPE), count, file) == count;
+}
+} // unnamed namespace
+
+uint32_t WeldVertices(std::vector<uint32_t> &remap, void const *vertices, uint32_t vertex_count,
+    size_t vertex_size, uint32_t const *indices, uint32_t index_count) noexcept
+{
+    char const *vertex_data = static_cast<char const *>(vertices);
+    remap.assign(vertex_count, ~0u);
+
+    // Vertices are numbered in order of first reference so the output is already close to fetch order
+    std::unordered_map<std::string_view, uint32_t> unique_vertices;
+    unique_vertices.reserve(vertex_count);
+    uint32_t unique_count = 0;
+    for (uint32_t i = 0; i < index_count; ++i)
+    {
+        uint32_t const index = indices[i];
+        if (remap[index] != ~0u)
+        {
+            continue;
+        }
+        std::string_view const vertex(vertex_data + (size_t)index * vertex_size, vertex_size);
+        auto const [it, inserted] = unique_vertices.try_emplace(vertex, unique_count);
+        remap[index]              = it->second;
+        if (inserted)
+        {
+            ++unique_count;
+        }
+    }
+    return unique_count;
+}
+
+void OptimizeVertexCache(uint32_t *indices, uint32_t index_count, uint32_t vertex_count) noexcept
+{
+    uint32_t const triangle_count = index_count / 3;
+    if (triangle_count == 0)
+    {
+        return;
+    }
+    static VertexScoreTable const score_table;
+
+    // Build the vertex to triangle adjacency
+    std::vector<uint32_t> live_triangles(vertex_count, 0);
+    for (uint32_t i = 0; i < index_count; ++i)
+    {
+        ++live_triangles[indices[i]];
+    }
+    std::vector<uint32_t> adjacency_offsets(vertex_count);
+    uint32_t              adjacency_offset = 0;
+    for (uint32_t i = 0; i < vertex_count; ++i)
+    {
+        adjacency_offsets[i] = adjacency_offset;
+        adjacency_offset += live_triangles[i];
+    }
+    std::vector<uint32_t> adjacency(index_count);
+    {
+        std::vector<uint32_t> cursors = adjacency_offsets;
+        for (uint32_t i = 0; i < index_count; ++i)
+        {
+            adjacency[cursors[indices[i]]++] = i / 3;
+        }
+    }
+
+    // Initialise the scores
+    std::vector<float> vertex_scores(vertex_count);
+    for (uint32_t i = 0; i < vertex_count; ++i)
+    {
+        vertex_scores[i] = GetVertexScore(score_table, -1, live_triangles[i]);
+    }
+    std::vector<float>   triangle_scores(triangle_count);
+    std::vector<uint8_t> emitted(triangle_count, 0);
+    uint32_t             best_triangle = 0;
+    for (uint32_t i = 0; i < triangle_count; ++i)
+    {
+        triangle_scores[i] = vertex_scores[indices[i * 3 + 0]] + vertex_scores[indices[i * 3 + 1]]
+                           + vertex_scores[indices[i * 3 + 2]];
+        if (triangle_scores[i] > triangle_scores[best_triangle])
+        {
+            best_triangle = i;
+        }
+    }
+
+    std::vector<uint32_t> output(index_count);
+    uint32_t              cache[kForsythCacheSize + 3];
+    uint32_t              cache_count = 0;
+    uint32_t              scan_cursor = 0;
+    for (uint32_t output_triangle = 0; output_triangle < triangle_count; ++output_triangle)
+    {
+        if (best_triangle == ~0u)
+        {
+            // Nothing left in the cache so continue with the next unemitted triangle in input order
+            while (emitted[scan_cursor])
+            {
+                ++scan_cursor;
+            }
+            best_triangle = scan_cursor;
+        }
+
+        uint32_t const *triangle = &indices[best_triangle * 3];
+        output[output_triangle * 3 + 0] = triangle[0];
+        output[output_triangle * 3 + 1] = triangle[1];
+        output[output_triangle * 3 + 2] = triangle[2];
+        emitted[best_triangle]          = 1;
+
+        // Push the triangle's vertices to the front of the cache
+        uint32_t new_cache[kForsythCacheSize + 3];
+        uint32_t new_cache_count = 0;
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            uint32_t const vertex = triangle[i];
+            if (std::find(new_cache, new_cache + new_cache_count, vertex) == new_cache + new_cache_count)
+            {
+                new_cache[new_cache_count++] = vertex;
+            }
+
+            // Remove the triangle from the vertex's list of live triangles
+            uint32_t *triangles = &adjacency[adjacency_offsets[vertex]];
+            uint32_t &count     = live_triangles[vertex];
+            for (uint32_t j = 0; j < count; ++j)
+            {
+                if (triangles[j] == best_triangle)
+                {
+                    triangles[j] = triangles[count - 1];
+                    --count;
+                    break;
+                }
+            }
+        }
+        for (uint32_t i = 0; i < cache_count; ++i)
+        {
+            uint32_t const vertex = cache[i];
+            if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+            {
+                new_cache[new_cache_count++] = vertex;
+            }
+        }
+        cache_count = std::min(new_cache_count, kForsythCacheSize);
+        std::copy(new_cache, new_cache + cache_count, cache);
+
+        // Update the scores of the vertices in (or just evicted from) the cache, and find the best triangle among
+        // their remaining triangles
+        best_triangle    = ~0u;
+        float best_score = -1.0f;
+        for (uint32_t i = 0; i < new_cache_count; ++i)
+        {
+            uint32_t const vertex         = new_cache[i];
+            int32_t const  cache_position = i < kForsythCacheSize ? (int32_t)i : -1;
+
+            float const score     = GetVertexScore(score_table, cache_position, live_triangles[vertex]);
+            float const delta     = score - vertex_scores[vertex];
+            vertex_scores[vertex] = score;
+
+            uint32_t const *triangles = &adjacency[adjacency_offsets[vertex]];
+            for (uint32_t j = 0; j < live_triangles[vertex]; ++j)
+            {
+                uint32_t const adjacent = triangles[j];
+                triangle_scores[adjacent] += delta;
+                if (triangle_scores[adjacent] > best_score)
+                {
+                    best_score    = triangle_scores[adjacent];
+                    best_triangle = adjacent;
+                }
+            }
+        }
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+}
+
+uint32_t OptimizeVertexFetch(
+    std::vector<uint32_t> &remap, uint32_t *indices, uint32_t index_count, uint32_t vertex_count) noexcept
+{
+    remap.assign(vertex_count, ~0u);
+    uint32_t next_vertex = 0;
+    for (uint32_t i = 0; i < index_count; ++i)
+    {
+        uint32_t &index = indices[i];
+        if (remap[index] == ~0u)
+        {
+            remap[index] = next_vertex++;
+        }
+        index = remap[index];
+    }
+    return next_vertex;
+}
+
+MeshStats AnalyzeMesh(
+    uint32_t const *indices, uint32_t index_count, uint32_t vertex_count, size_t vertex_size) noexcept
+{
+    MeshStats stats    = {};
+    stats.vertex_count = vertex_count;
+    if (index_count < 3 || vertex_count == 0)
+    {
+        return stats;
+    }
+
+    // A FIFO cache holds an entry iff it was inserted within the last N insertions, so tracking the insertion
+    // time of each entry is enough to model it exactly
+    {
+        std::vector<uint32_t> insert_times(vertex_count, 0);
+        uint32_t              time   = kMeshOptimizerCacheSize + 1;
+        uint32_t              misses = 0;
+        for (uint32_t i = 0; i < index_count; ++i)
+        {
+            uint32_t const index = indices[i];
+            if (time - insert_times[index] > kMeshOptimizerCacheSize)
+            {
+                insert_times[index] = time++;
+                ++misses;
+            }
+        }
+        stats.acmr = (float)misses / (float)(index_count / 3);
+    }
+
+    // Model the vertex fetch as going through a FIFO cache of cache lines
+    {
+        size_t const          line_count = (vertex_count * vertex_size + kMeshOptimizerFetchLineSize - 1)
+                                / kMeshOptimizerFetchLineSize;
+        std::vector<uint32_t> insert_times(line_count, 0);
+        std::vector<uint8_t>  referenced(vertex_count, 0);
+        uint32_t              time             = kFetchCacheLineCount + 1;
+        uint64_t              fetched_bytes    = 0;
+        uint64_t              referenced_count = 0;
+        for (uint32_t i = 0; i < index_count; ++i)
+        {
+            uint32_t const index = indices[i];
+            referenced_count += referenced[index] == 0;
+            referenced[index] = 1;
+
+            size_t const first_line = index * vertex_size / kMeshOptimizerFetchLineSize;
+            size_t const last_line  = (index * vertex_size + vertex_size - 1) / kMeshOptimizerFetchLineSize;
+            for (size_t line = first_line; line <= last_line; ++line)
+            {
+                if (time - insert_times[line] > kFetchCacheLineCount)
+                {
+                    insert_times[line] = time++;
+                    fetched_bytes += kMeshOptimizerFetchLineSize;
+                }
+            }
+        }
+        stats.overfetch = (float)((double)fetched_bytes / (double)(referenced_count * vertex_size));
+    }
+
+    return stats;
+}
+
+void OptimizeMesh(OptimizedMesh &result, void const *vertices, uint32_t vertex_count, size_t vertex_size,
+    uint32_t const *indices, uint32_t index_count, size_t fetch_size) noexcept
+{
+    result.before = AnalyzeMesh(indices, index_count, vertex_count, fetch_size);
+    if (index_count == 0 || (index_count % 3) != 0)
+    {
+        // Not a triangle list, keep the mesh unchanged
+        result.vertices.resize(vertex_count);
+        for (uint32_t i = 0; i < vertex_count; ++i)
+        {
+            result.vertices[i] = i;
+        }
+        result.indices.assign(indices, indices + index_count);
+        result.after = result.before;
+        return;
+    }
+
+    // Merge the duplicated vertices
+    std::vector<uint32_t> remap;
+    uint32_t const unique_count = WeldVertices(remap, vertices, vertex_count, vertex_size, indices, index_count);
+    std::vector<uint32_t> unique_vertices(unique_count, ~0u);
+    for (uint32_t i = 0; i < vertex_count; ++i)
+    {
+        if (remap[i] != ~0u && unique_vertices[remap[i]] == ~0u)
+        {
+            unique_vertices[remap[i]] = i;
+        }
+    }
+    result.indices.resize(index_count);
+    for (uint32_t i = 0; i < index_count; ++i)
+    {
+        result.indices[i] = remap[indices[i]];
+    }
+
+    // Reorder the triangles, then the vertices to match the new triangle order
+    OptimizeVertexCache(result.indices.data(), index_count, unique_count);
+    uint32_t const output_count = OptimizeVertexFetch(remap, result.indices.data(), index_count, unique_count);
+    result.vertices.resize(output_count);
+    for (uint32_t i = 0; i < unique_count; ++i)
+    {
+        if (remap[i] != ~0u)
+        {
+            result.vertices[remap[i]] = unique_vertices[i];
+        }
+    }
+
+    result.after = AnalyzeMesh(result.indices.data(), index_count, output_count, fetch_size);
+}
+
+bool LoadOptimizedMeshCache(OptimizedMeshCache &cache, char const *file_path) noexcept
+{
+    FILE *file = fopen(file_path, "rb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    char     magic[4]    = {};
+    uint32_t version     = 0;
+    uint64_t entry_count = 0;
+    bool     result      = ReadValues(file, magic, 4) && std::equal(magic, magic + 4, kCacheMagic)
+                && ReadValues(file, &version, 1) && version == kCacheVersion && ReadValues(file, &entry_count, 1);
+    for (uint64_t i = 0; result && i < entry_count; ++i)
+    {
+        uint64_t      key          = 0;
+        uint32_t      vertex_count = 0;
+        uint32_t      index_count  = 0;
+        OptimizedMesh mesh;
+        result = ReadValues(file, &key, 1) && ReadValues(file, &mesh.before, 1)
+              && ReadValues(file, &mesh.after, 1) && ReadValues(file, &vertex_count, 1)
+              && ReadValues(file, &index_count, 1);
+        if (!result)
+        {
+            break;
+        }
+        mesh.vertices.resize(vertex_count);
+        mesh.indices.resize(index_count);
+        result = ReadValues(file, mesh.vertices.data(), vertex_count)
+              && ReadValues(file, mesh.indices.data(), index_count);
+        if (result)
+        {
+            cache[(size_t)key] = std::move(mesh);
+        }
+    }
+    fclose(file);
+
+    return result;
+}
+
+bool SaveOptimizedMeshCache(
+    OptimizedMeshCache const &cache, std::vector<size_t> const &keys, char const *file_path) noexcept
+{
+    FILE *file = fopen(file_path, "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    uint64_t entry_count = 0;
+    for (size_t key : keys)
+    {
+        entry_count += cache.find(key) != cache.end();
+    }
+    bool result = WriteValues(file, kCacheMagic, 4) && WriteValues(file, &kCacheVersion, 1)
+               && WriteValues(file, &entry_count, 1);
+    for (size_t key : keys)
+    {
+        auto const it = cache.find(key);
+        if (!result || it == cache.end())
+        {
+            continue;
+        }
+        OptimizedMesh const &mesh         = it->second;
+        uint64_t const       key_value    = key;
+        uint32_t const       vertex_count = (uint32_t)mesh.vertices.size();
+        uint32_t const       index_count  = (uint32_t)mesh.indices.size();
+        result = WriteValues(file, &key_value, 1) && WriteValues(file, &mesh.before, 1)
+              && WriteValues(file, &mesh.after, 1) && WriteValues(file, &vertex_count, 1)
+              && WriteValues(file, &index_count, 1) && WriteValues(file, mesh.vertices.data(), vertex_count)
+              && WriteValues(file, mesh.indices.data(), index_count);
+    }
+    fclose(file);
+
+    return result;
+}
+} // namespace Capsaicin
@@ -0,0 +1,131 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Capsaicin
+{
+/** Number of entries of the FIFO post-transform cache used to evaluate index orderings. */
+constexpr uint32_t kMeshOptimizerCacheSize = 16;
+
+/** Size of the cache lines used to evaluate vertex fetch locality (in bytes). */
+constexpr uint32_t kMeshOptimizerFetchLineSize = 64;
+
+/** Vertex cache and fetch statistics of an indexed triangle mesh. */
+struct MeshStats
+{
+    uint32_t vertex_count = 0;    /**< Number of vertices */
+    float    acmr         = 0.0f; /**< Average cache miss ratio (transformed vertices per triangle) */
+    float    overfetch    = 0.0f; /**< Fetched vertex bytes relative to the size of the vertex data */
+};
+
+/** Result of optimizing a mesh, stored as a remapping of the source mesh so it can be cached compactly. */
+struct OptimizedMesh
+{
+    std::vector<uint32_t> vertices; /**< Index of the source vertex used for each output vertex */
+    std::vector<uint32_t> indices;  /**< The optimized indices (into the output vertices) */
+    MeshStats             before;   /**< Statistics of the source mesh */
+    MeshStats             after;    /**< Statistics of the optimized mesh */
+};
+
+/**
+ * Merge vertices whose contents are bit-wise identical.
+ * Vertices that are not referenced by any index are dropped.
+ * @param [out] remap        Receives the new index of each source vertex (~0u for unreferenced vertices).
+ * @param       vertices     The source vertex data.
+ * @param       vertex_count Number of source vertices.
+ * @param       vertex_size  Size of a single vertex (in bytes).
+ * @param       indices      The source indices.
+ * @param       index_count  Number of source indices.
+ * @returns The number of unique vertices.
+ */
+uint32_t WeldVertices(std::vector<uint32_t> &remap, void const *vertices, uint32_t vertex_count,
+    size_t vertex_size, uint32_t const *indices, uint32_t index_count) noexcept;
+
+/**
+ * Reorder triangles to improve post-transform vertex cache locality (Forsyth's linear-speed algorithm).
+ * @param [in,out] indices      The triangle list indices to reorder.
+ * @param          index_count  Number of indices (must be a multiple of 3).
+ * @param          vertex_count Number of vertices referenced by the indices.
+ */
+void OptimizeVertexCache(uint32_t *indices, uint32_t index_count, uint32_t vertex_count) noexcept;
+
+/**
+ * Reorder vertices in the order they are first referenced to improve vertex fetch locality.
+ * @param [out]    remap        Receives the new index of each vertex (~0u for unreferenced vertices).
+ * @param [in,out] indices      The indices, rewritten to reference the reordered vertices.
+ * @param          index_count  Number of indices.
+ * @param          vertex_count Number of vertices referenced by the indices.
+ * @returns The number of referenced vertices.
+ */
+uint32_t OptimizeVertexFetch(
+    std::vector<uint32_t> &remap, uint32_t *indices, uint32_t index_count, uint32_t vertex_count) noexcept;
+
+/**
+ * Evaluate the vertex cache and fetch efficiency of an index ordering.
+ * @param indices      The triangle list indices.
+ * @param index_count  Number of indices.
+ * @param vertex_count Number of vertices referenced by the indices.
+ * @param vertex_size  Size of a single vertex as fetched by the GPU (in bytes).
+ * @returns The mesh statistics.
+ */
+MeshStats AnalyzeMesh(
+    uint32_t const *indices, uint32_t index_count, uint32_t vertex_count, size_t vertex_size) noexcept;
+
+/**
+ * Weld, cache optimize and fetch optimize a mesh.
+ * @param [out] result       The optimized mesh.
+ * @param       vertices     The source vertex data.
+ * @param       vertex_count Number of source vertices.
+ * @param       vertex_size  Size of a single source vertex (in bytes), used to find duplicates.
+ * @param       indices      The source indices.
+ * @param       index_count  Number of source indices (must be a multiple of 3).
+ * @param       fetch_size   Size of a single vertex as fetched by the GPU (in bytes), used for statistics.
+ */
+void OptimizeMesh(OptimizedMesh &result, void const *vertices, uint32_t vertex_count, size_t vertex_size,
+    uint32_t const *indices, uint32_t index_count, size_t fetch_size) noexcept;
+
+/** Optimized meshes indexed by the hash of their source data. */
+using OptimizedMeshCache = std::unordered_map<size_t, OptimizedMesh>;
+
+/**
+ * Load a cache of optimized meshes from disk, entries are added to any existing ones.
+ * @param [in,out] cache     The cache to fill.
+ * @param          file_path Path to the cache file.
+ * @returns True if succeeded, False if the file was missing or invalid.
+ */
+bool LoadOptimizedMeshCache(OptimizedMeshCache &cache, char const *file_path) noexcept;
+
+/**
+ * Save a cache of optimized meshes to disk.
+ * @param cache     The cache to save.
+ * @param keys      The entries to save, so that meshes no longer used by the scene are pruned.
+ * @param file_path Path to the cache file.
+ * @returns True if succeeded, False otherwise.
+ */
+bool SaveOptimizedMeshCache(
+    OptimizedMeshCache const &cache, std::vector<size_t> const &keys, char const *file_path) noexcept;
+} // namespace Capsaicin
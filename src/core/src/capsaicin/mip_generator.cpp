@@ -0,0 +1,420 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "mip_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr float    kKaiserRadius    = 1.5f; /**< Kaiser filter support radius (in destination texels) */
+constexpr float    kKaiserAlpha     = 4.0f; /**< Kaiser window shape parameter */
+constexpr uint32_t kAverageGridSize = 32;   /**< Number of samples per axis used to average an image */
+constexpr float    kPi              = 3.14159265358979f;
+
+uint32_t GetChannelSize(MipFormat format) noexcept
+{
+    switch (format)
+    {
+    case MipFormat::Unorm8:
+    case MipFormat::Unorm8Srgb: return 1;
+    case MipFormat::Unorm16: return 2;
+    case MipFormat::Float32: return 4;
+    default: return 0;
+    }
+}
+
+float SrgbToLinear(float value) noexcept
+{
+    return value <= 0.04045f ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+}
+
+/** Lookup tables converting between 8-bit sRGB values and linear values. */
+struct SrgbTable
+{
+    SrgbTable() noexcept
+    {
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            to_linear[i] = SrgbToLinear((float)i / 255.0f);
+            // The transfer function is monotonic so rounding in sRGB space equals comparing against the
+            // linear value of each rounding boundary
+            thresholds[i] = SrgbToLinear(((float)i + 0.5f) / 255.0f);
+        }
+    }
+
+    uint8_t toSrgb(float value) const noexcept
+    {
+        return (uint8_t)(std::upper_bound(thresholds, thresholds + 255, value) - thresholds);
+    }
+
+    float to_linear[256];
+    float thresholds[256];
+};
+
+SrgbTable const &GetSrgbTable() noexcept
+{
+    static SrgbTable const table;
+    return table;
+}
+
+/** Convert texels to linear floating point values. */
+void ToFloat(float *values, void const *data, uint64_t texel_count, uint32_t channel_count,
+    MipFormat format) noexcept
+{
+    uint64_t const value_count = texel_count * channel_count;
+    switch (format)
+    {
+    case MipFormat::Unorm8:
+    {
+        uint8_t const *source = static_cast<uint8_t const *>(data);
+        for (uint64_t i = 0; i < value_count; ++i)
+        {
+            values[i] = (float)source[i] * (1.0f / 255.0f);
+        }
+        break;
+    }
+    case MipFormat::Unorm8Srgb:
+    {
+        uint8_t const   *source = static_cast<uint8_t const *>(data);
+        SrgbTable const &table  = GetSrgbTable();
+        for (uint64_t i = 0; i < value_count; i += channel_count)
+        {
+            // Only colour channels are encoded, alpha is stored linearly
+            for (uint32_t c = 0; c < channel_count; ++c)
+            {
+                values[i + c] =
+                    c < 3 ? table.to_linear[source[i + c]] : (float)source[i + c] * (1.0f / 255.0f);
+            }
+        }
+        break;
+    }
+    case MipFormat::Unorm16:
+    {
+        uint16_t const *source = static_cast<uint16_t const *>(data);
+        for (uint64_t i = 0; i < value_count; ++i)
+        {
+            values[i] = (float)source[i] * (1.0f / 65535.0f);
+        }
+        break;
+    }
+    case MipFormat::Float32: memcpy(values, data, value_count * sizeof(float)); break;
+    default: break;
+    }
+}
+
+/** Convert linear floating point values back to texels. */
+void FromFloat(void *data, float const *values, uint64_t texel_count, uint32_t channel_count,
+    MipFormat format) noexcept
+{
+    uint64_t const value_count = texel_count * channel_count;
+    switch (format)
+    {
+    case MipFormat::Unorm8:
+    {
+        uint8_t *destination = static_cast<uint8_t *>(data);
+        for (uint64_t i = 0; i < value_count; ++i)
+        {
+            destination[i] = (uint8_t)(std::clamp(values[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+        break;
+    }
+    case MipFormat::Unorm8Srgb:
+    {
+        uint8_t         *destination = static_cast<uint8_t *>(data);
+        SrgbTable const &table       = GetSrgbTable();
+        for (uint64_t i = 0; i < value_count; i += channel_count)
+        {
+            for (uint32_t c = 0; c < channel_count; ++c)
+            {
+                destination[i + c] = c < 3 ? table.toSrgb(values[i + c])
+                                           : (uint8_t)(std::clamp(values[i + c], 0.0f, 1.0f) * 255.0f + 0.5f);
+            }
+        }
+        break;
+    }
+    case MipFormat::Unorm16:
+    {
+        uint16_t *destination = static_cast<uint16_t *>(data);
+        for (uint64_t i = 0; i < value_count; ++i)
+        {
+            destination[i] = (uint16_t)(std::clamp(values[i], 0.0f, 1.0f) * 65535.0f + 0.5f);
+        }
+        break;
+    }
+    case MipFormat::Float32: memcpy(data, values, value_count * sizeof(float)); break;
+    default: break;
+    }
+}
+
+/** Zeroth order modified Bessel function of the first kind (used by the Kaiser window). */
+float BesselI0(float x) noexcept
+{
+    float sum  = 1.0f;
+    float term = 1.0f;
+    for (uint32_t k = 1; k < 16; ++k)
+    {
+        float const factor = x / (2.0f * (float)k);
+        term *= factor * factor;
+        sum += term;
+    }
+    return sum;
+}
+
+float KaiserWeight(float distance) noexcept
+{
+    if (fabsf(distance) >= kKaiserRadius)
+    {
+        return 0.0f;
+    }
+    float const ratio  = distance / kKaiserRadius;
+    float const window = BesselI0(kKaiserAlpha * sqrtf(1.0f - ratio * ratio)) / BesselI0(kKaiserAlpha);
+    float const sinc   = distance != 0.0f ? sinf(kPi * distance) / (kPi * distance) : 1.0f;
+    return sinc * window;
+}
+
+/** Source texels and weights contributing to each destination texel along one axis. */
+struct FilterTaps
+{
+    std::vector<uint32_t> offsets; /**< First tap of each destination texel (plus a final end offset) */
+    std::vector<uint32_t> indices; /**< Source texel of each tap (clamped to the source size) */
+    std::vector<float>    weights; /**< Normalized weight of each tap */
+};
+
+void BuildFilterTaps(FilterTaps &taps, uint32_t source_size, uint32_t destination_size, MipFilter filter) noexcept
+{
+    taps.offsets.clear();
+    taps.indices.clear();
+    taps.weights.clear();
+
+    float const ratio = (float)source_size / (float)destination_size;
+    for (uint32_t i = 0; i < destination_size; ++i)
+    {
+        uint32_t const first = (uint32_t)taps.indices.size();
+        taps.offsets.push_back(first);
+        if (filter == MipFilter::Box)
+        {
+            // Weight each source texel by how much of it the destination texel covers
+            float const begin = (float)i * ratio;
+            float const end   = (float)(i + 1) * ratio;
+            for (int32_t j = (int32_t)floorf(begin); j < (int32_t)ceilf(end); ++j)
+            {
+                float const weight = std::min(end, (float)(j + 1)) - std::max(begin, (float)j);
+                if (weight > 0.0f)
+                {
+                    taps.indices.push_back(std::min((uint32_t)j, source_size - 1));
+                    taps.weights.push_back(weight);
+                }
+            }
+        }
+        else
+        {
+            // Filter is evaluated in destination texel units so that it scales with the reduction ratio
+            float const center = ((float)i + 0.5f) * ratio;
+            float const radius = kKaiserRadius * std::max(ratio, 1.0f);
+            for (int32_t j = (int32_t)floorf(center - radius); j <= (int32_t)ceilf(center + radius); ++j)
+            {
+                float const weight = KaiserWeight(((float)j + 0.5f - center) / std::max(ratio, 1.0f));
+                if (weight != 0.0f)
+                {
+                    taps.indices.push_back((uint32_t)std::clamp(j, 0, (int32_t)source_size - 1));
+                    taps.weights.push_back(weight);
+                }
+            }
+        }
+        float total = 0.0f;
+        for (size_t j = first; j < taps.weights.size(); ++j)
+        {
+            total += taps.weights[j];
+        }
+        for (size_t j = first; j < taps.weights.size(); ++j)
+        {
+            taps.weights[j] /= total;
+        }
+    }
+    taps.offsets.push_back((uint32_t)taps.indices.size());
+}
+
+/** Downsample an image using separable filtering (horizontal then vertical). */
+void Downsample(std::vector<float> &destination, std::vector<float> &scratch, std::vector<float> const &source,
+    uint32_t width, uint32_t height, uint32_t destination_width, uint32_t destination_height,
+    uint32_t channel_count, MipFilter filter) noexcept
+{
+    if (filter == MipFilter::Box && destination_width * 2 == width && destination_height * 2 == height)
+    {
+        // Exact 2:1 reduction, each destination texel is the average of a 2x2 footprint
+        size_t const row_size = (size_t)width * channel_count;
+        destination.resize((size_t)destination_width * destination_height * channel_count);
+        for (uint32_t y = 0; y < destination_height; ++y)
+        {
+            float const *row0            = source.data() + 2 * y * row_size;
+            float const *row1            = row0 + row_size;
+            float       *destination_row = destination.data() + (size_t)y * destination_width * channel_count;
+            for (uint32_t x = 0; x < destination_width; ++x)
+            {
+                for (uint32_t c = 0; c < channel_count; ++c)
+                {
+                    size_t const i = (size_t)2 * x * channel_count + c;
+                    destination_row[(size_t)x * channel_count + c] =
+                        0.25f * (row0[i] + row0[i + channel_count] + row1[i] + row1[i + channel_count]);
+                }
+            }
+        }
+        return;
+    }
+
+    FilterTaps taps;
+    BuildFilterTaps(taps, width, destination_width, filter);
+    scratch.assign((size_t)destination_width * height * channel_count, 0.0f);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        float const *source_row      = source.data() + (size_t)y * width * channel_count;
+        float       *destination_row = scratch.data() + (size_t)y * destination_width * channel_count;
+        for (uint32_t x = 0; x < destination_width; ++x)
+        {
+            for (uint32_t j = taps.offsets[x]; j < taps.offsets[x + 1]; ++j)
+            {
+                float const *texel  = source_row + (size_t)taps.indices[j] * channel_count;
+                float const  weight = taps.weights[j];
+                for (uint32_t c = 0; c < channel_count; ++c)
+                {
+                    destination_row[x * channel_count + c] += texel[c] * weight;
+                }
+            }
+        }
+    }
+
+    BuildFilterTaps(taps, height, destination_height, filter);
+    size_t const row_size = (size_t)destination_width * channel_count;
+    destination.assign(row_size * destination_height, 0.0f);
+    for (uint32_t y = 0; y < destination_height; ++y)
+    {
+        float *destination_row = destination.data() + y * row_size;
+        for (uint32_t j = taps.offsets[y]; j < taps.offsets[y + 1]; ++j)
+        {
+            float const *source_row = scratch.data() + taps.indices[j] * row_size;
+            float const  weight     = taps.weights[j];
+            for (size_t k = 0; k < row_size; ++k)
+            {
+                destination_row[k] += source_row[k] * weight;
+            }
+        }
+    }
+}
+} // unnamed namespace
+
+uint32_t GetMipCount(uint32_t width, uint32_t height) noexcept
+{
+    uint32_t mip_count = 1;
+    for (uint32_t size = std::max(width, height); size > 1; size >>= 1)
+    {
+        ++mip_count;
+    }
+    return mip_count;
+}
+
+uint64_t GetMipChainSize(
+    uint32_t width, uint32_t height, uint32_t channel_count, MipFormat format, uint32_t mip_count) noexcept
+{
+    uint64_t size = 0;
+    for (uint32_t i = 0; i < mip_count; ++i)
+    {
+        size += (uint64_t)std::max(width >> i, 1u) * std::max(height >> i, 1u) * channel_count
+              * GetChannelSize(format);
+    }
+    return size;
+}
+
+bool GenerateMipChain(std::vector<uint8_t> &result, void const *data, uint32_t width, uint32_t height,
+    uint32_t channel_count, MipFormat format, MipFilter filter) noexcept
+{
+    if (data == nullptr || width == 0 || height == 0 || channel_count == 0 || channel_count > 4
+        || GetChannelSize(format) == 0)
+    {
+        return false;
+    }
+
+    uint32_t const mip_count  = GetMipCount(width, height);
+    uint64_t const level_size = (uint64_t)width * height * channel_count * GetChannelSize(format);
+    result.resize(GetMipChainSize(width, height, channel_count, format, mip_count));
+    memcpy(result.data(), data, level_size);
+
+    // Each level is filtered from the previous one at full precision to avoid accumulating quantization errors
+    std::vector<float> level((size_t)width * height * channel_count);
+    std::vector<float> next_level;
+    std::vector<float> scratch;
+    ToFloat(level.data(), data, (uint64_t)width * height, channel_count, format);
+    uint64_t offset = level_size;
+    for (uint32_t i = 1; i < mip_count; ++i)
+    {
+        uint32_t const level_width  = std::max(width >> (i - 1), 1u);
+        uint32_t const level_height = std::max(height >> (i - 1), 1u);
+        uint32_t const next_width   = std::max(width >> i, 1u);
+        uint32_t const next_height  = std::max(height >> i, 1u);
+        Downsample(next_level, scratch, level, level_width, level_height, next_width, next_height, channel_count,
+            filter);
+        FromFloat(result.data() + offset, next_level.data(), (uint64_t)next_width * next_height, channel_count,
+            format);
+        offset += (uint64_t)next_width * next_height * channel_count * GetChannelSize(format);
+        level.swap(next_level);
+    }
+    return true;
+}
+
+void ComputeAverageTexel(void *texel, void const *data, uint32_t width, uint32_t height,
+    uint32_t channel_count, MipFormat format) noexcept
+{
+    uint32_t const texel_size = channel_count * GetChannelSize(format);
+    if (texel_size == 0 || channel_count > 4)
+    {
+        return;
+    }
+    float    sum[4]       = {};
+    uint32_t sample_count = 0;
+    uint32_t const samples_x = std::min(width, kAverageGridSize);
+    uint32_t const samples_y = std::min(height, kAverageGridSize);
+    for (uint32_t y = 0; y < samples_y; ++y)
+    {
+        for (uint32_t x = 0; x < samples_x; ++x)
+        {
+            uint64_t const source_x = ((uint64_t)x * 2 + 1) * width / (2 * samples_x);
+            uint64_t const source_y = ((uint64_t)y * 2 + 1) * height / (2 * samples_y);
+            float          values[4];
+            ToFloat(values, static_cast<uint8_t const *>(data) + (source_y * width + source_x) * texel_size, 1,
+                channel_count, format);
+            for (uint32_t c = 0; c < channel_count; ++c)
+            {
+                sum[c] += values[c];
+            }
+            ++sample_count;
+        }
+    }
+    for (uint32_t c = 0; c < channel_count; ++c)
+    {
+        sum[c] /= (float)std::max(sample_count, 1u);
+    }
+    FromFloat(texel, sum, 1, channel_count, format);
+}
+} // namespace Capsaicin
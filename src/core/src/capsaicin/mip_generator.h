@@ -0,0 +1,92 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Capsaicin
+{
+/** Filter used to downsample each mip level. */
+enum class MipFilter : uint32_t
+{
+    Box = 0, /**< Area-weighted average of the covered texels */
+    Kaiser,  /**< Kaiser-windowed sinc, sharper than box but may slightly ring */
+};
+
+/** Texel channel formats supported by the mip generator. */
+enum class MipFormat : uint32_t
+{
+    Unorm8 = 0, /**< 8-bit normalized channels */
+    Unorm8Srgb, /**< 8-bit normalized sRGB encoded channels (alpha is always linear) */
+    Unorm16,    /**< 16-bit normalized channels */
+    Float32,    /**< 32-bit floating point channels */
+};
+
+/**
+ * Gets the number of mip levels of a full mip chain.
+ * @param width  The width of the top level.
+ * @param height The height of the top level.
+ * @returns The mip count (down to and including the 1x1 level).
+ */
+uint32_t GetMipCount(uint32_t width, uint32_t height) noexcept;
+
+/**
+ * Gets the size of a tightly packed mip chain.
+ * @param width         The width of the top level.
+ * @param height        The height of the top level.
+ * @param channel_count Number of channels per texel.
+ * @param format        The channel format.
+ * @param mip_count     Number of mip levels.
+ * @returns The size (in bytes).
+ */
+uint64_t GetMipChainSize(
+    uint32_t width, uint32_t height, uint32_t channel_count, MipFormat format, uint32_t mip_count) noexcept;
+
+/**
+ * Generate a full mip chain.
+ * Levels are stored tightly packed one after the other starting with a copy of the source image. Filtering
+ * is done in linear space for sRGB formats, with clamp to edge addressing.
+ * @param [out] result        The mip chain data.
+ * @param       data          The top level texels.
+ * @param       width         The width of the top level.
+ * @param       height        The height of the top level.
+ * @param       channel_count Number of channels per texel (1 to 4).
+ * @param       format        The channel format.
+ * @param       filter        The downsampling filter.
+ * @returns True if succeeded, False if the parameters are invalid.
+ */
+bool GenerateMipChain(std::vector<uint8_t> &result, void const *data, uint32_t width, uint32_t height,
+    uint32_t channel_count, MipFormat format, MipFilter filter) noexcept;
+
+/**
+ * Compute the average texel of an image, estimated from a regular grid of samples.
+ * @param [out] texel         Receives the average texel (channel_count channels in the given format).
+ * @param       data          The image texels.
+ * @param       width         The image width.
+ * @param       height        The image height.
+ * @param       channel_count Number of channels per texel (1 to 4).
+ * @param       format        The channel format.
+ */
+void ComputeAverageTexel(void *texel, void const *data, uint32_t width, uint32_t height,
+    uint32_t channel_count, MipFormat format) noexcept;
+} // namespace Capsaicin
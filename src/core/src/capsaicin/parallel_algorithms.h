@@ -0,0 +1,468 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "thread_pool.h"
+
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Number of elements processed per block by the parallel algorithms. The partition into blocks doesn't depend on
+ * the thread count and partial results are combined in block order, so results are reproducible even for operators
+ * that are not associative (e.g., floating point sums or hash combination).
+ */
+constexpr uint32_t kParallelBlockSize = 4096;
+
+/**
+ * Gets the number of blocks covering a range, without overflowing for counts close to UINT32_MAX.
+ * @param count      The number of elements.
+ * @param block_size The number of elements per block.
+ * @returns The block count.
+ */
+constexpr uint32_t GetParallelBlockCount(uint32_t count, uint32_t block_size) noexcept
+{
+    return count / block_size + (count % block_size != 0 ? 1 : 0);
+}
+
+/**
+ * Gets the end of a block of a range, the block bounds are computed on 64 bits so that they don't wrap around.
+ * @param begin      The first element of the range.
+ * @param block      The index of the block in the range.
+ * @param block_size The number of elements per block.
+ * @param end        The end of the range.
+ * @returns The element following the last one of the block.
+ */
+constexpr uint32_t GetParallelBlockEnd(uint32_t begin, uint32_t block, uint32_t block_size, uint32_t end) noexcept
+{
+    return (uint32_t)std::min((uint64_t)begin + ((uint64_t)block + 1) * block_size, (uint64_t)end);
+}
+
+/**
+ * Reduce the transformed elements of a range in parallel.
+ * @param count      The number of elements.
+ * @param identity   The identity of the operator (the result of an empty range).
+ * @param transform  Returns the value of element i.
+ * @param op         The operator combining two values.
+ * @param block_size The number of elements reduced serially per block.
+ * @returns op(...op(op(identity, transform(0)), transform(1))..., transform(count - 1)), grouped by block.
+ */
+template<typename TYPE, typename TRANSFORM, typename OP>
+TYPE ParallelTransformReduce(uint32_t count, TYPE identity, TRANSFORM const &transform, OP const &op,
+    uint32_t block_size = kParallelBlockSize)
+{
+    uint32_t const    block_count = GetParallelBlockCount(count, block_size);
+    std::vector<TYPE> partials(block_count, identity);
+    ThreadPool::ParallelFor(
+        block_count,
+        [&](uint32_t block) {
+            uint32_t const end     = GetParallelBlockEnd(0, block, block_size, count);
+            TYPE           partial = identity;
+            for (uint32_t i = block * block_size; i < end; ++i)
+            {
+                partial = op(partial, transform(i));
+            }
+            partials[block] = partial;
+        },
+        1);
+    TYPE result = identity;
+    for (TYPE const &partial : partials)
+    {
+        result = op(result, partial);
+    }
+    return result;
+}
+
+/**
+ * Reduce the elements of an array in parallel.
+ * @param values   The elements.
+ * @param count    The number of elements.
+ * @param identity The identity of the operator (the result of an empty range).
+ * @param op       The operator combining two values.
+ * @returns The reduced value.
+ */
+template<typename TYPE, typename OP>
+TYPE ParallelReduce(TYPE const *values, uint32_t count, TYPE identity, OP const &op)
+{
+    return ParallelTransformReduce(count, identity, [values](uint32_t i) { return values[i]; }, op);
+}
+
+/**
+ * Scan the transformed elements of a range in parallel.
+ * @note The transform is called twice per element, once to reduce the blocks and once to scan them.
+ * @param       count     The number of elements.
+ * @param [out] output    The scanned values (may alias the transform source).
+ * @param       identity  The identity of the operator.
+ * @param       transform Returns the value of element i.
+ * @param       op        The operator combining two values.
+ * @param       inclusive True for an inclusive scan (output[i] includes element i), False for an exclusive scan.
+ * @returns The reduction of the whole range.
+ */
+template<typename TYPE, typename TRANSFORM, typename OP>
+TYPE ParallelTransformScan(
+    uint32_t count, TYPE *output, TYPE identity, TRANSFORM const &transform, OP const &op, bool inclusive)
+{
+    // Reduce each block, then scan the block totals to get the offset of each block
+    uint32_t const    block_count = GetParallelBlockCount(count, kParallelBlockSize);
+    std::vector<TYPE> offsets(block_count, identity);
+    ThreadPool::ParallelFor(
+        block_count,
+        [&](uint32_t block) {
+            uint32_t const end     = GetParallelBlockEnd(0, block, kParallelBlockSize, count);
+            TYPE           partial = identity;
+            for (uint32_t i = block * kParallelBlockSize; i < end; ++i)
+            {
+                partial = op(partial, transform(i));
+            }
+            offsets[block] = partial;
+        },
+        1);
+    TYPE total = identity;
+    for (TYPE &offset : offsets)
+    {
+        TYPE const partial = offset;
+        offset             = total;
+        total              = op(total, partial);
+    }
+
+    // Scan each block starting from its offset
+    ThreadPool::ParallelFor(
+        block_count,
+        [&](uint32_t block) {
+            uint32_t const end     = GetParallelBlockEnd(0, block, kParallelBlockSize, count);
+            TYPE           running = offsets[block];
+            for (uint32_t i = block * kParallelBlockSize; i < end; ++i)
+            {
+                TYPE const value = transform(i);
+                if (!inclusive)
+                {
+                    output[i] = running;
+                }
+                running = op(running, value);
+                if (inclusive)
+                {
+                    output[i] = running;
+                }
+            }
+        },
+        1);
+    return total;
+}
+
+/**
+ * Inclusive scan of an array in parallel (output[i] = values[0] op ... op values[i]).
+ * @param       values   The elements.
+ * @param       count    The number of elements.
+ * @param [out] output   The scanned values (may be the same array as the elements).
+ * @param       identity The identity of the operator.
+ * @param       op       The operator combining two values.
+ * @returns The reduction of the whole array.
+ */
+template<typename TYPE, typename OP>
+TYPE ParallelInclusiveScan(TYPE const *values, uint32_t count, TYPE *output, TYPE identity, OP const &op)
+{
+    return ParallelTransformScan(count, output, identity, [values](uint32_t i) { return values[i]; }, op, true);
+}
+
+/**
+ * Exclusive scan of an array in parallel (output[i] = identity op values[0] op ... op values[i - 1]).
+ * @param       values   The elements.
+ * @param       count    The number of elements.
+ * @param [out] output   The scanned values (may be the same array as the elements).
+ * @param       identity The identity of the operator.
+ * @param       op       The operator combining two values.
+ * @returns The reduction of the whole array.
+ */
+template<typename TYPE, typename OP>
+TYPE ParallelExclusiveScan(TYPE const *values, uint32_t count, TYPE *output, TYPE identity, OP const &op)
+{
+    return ParallelTransformScan(count, output, identity, [values](uint32_t i) { return values[i]; }, op, false);
+}
+
+/**
+ * Stream compaction, emit the elements of a range that pass a predicate at their position in the compacted range.
+ * @param count     The number of elements.
+ * @param predicate Returns true to keep element i (called once per element).
+ * @param emit      Called as emit(i, position) for each kept element i.
+ * @returns The number of kept elements.
+ */
+template<typename PREDICATE, typename EMIT>
+uint32_t ParallelCompactEmit(uint32_t count, PREDICATE const &predicate, EMIT const &emit)
+{
+    // Flag and count the kept elements of each block, then scan the block counts to get the output offset of each
+    uint32_t const        block_count = GetParallelBlockCount(count, kParallelBlockSize);
+    std::vector<uint8_t>  flags(count);
+    std::vector<uint32_t> offsets(block_count, 0);
+    ThreadPool::ParallelFor(
+        block_count,
+        [&](uint32_t block) {
+            uint32_t const end        = GetParallelBlockEnd(0, block, kParallelBlockSize, count);
+            uint32_t       kept_count = 0;
+            for (uint32_t i = block * kParallelBlockSize; i < end; ++i)
+            {
+                flags[i] = predicate(i) ? 1 : 0;
+                kept_count += flags[i];
+            }
+            offsets[block] = kept_count;
+        },
+        1);
+    uint32_t total = 0;
+    for (uint32_t &offset : offsets)
+    {
+        uint32_t const block_total = offset;
+        offset                     = total;
+        total += block_total;
+    }
+    ThreadPool::ParallelFor(
+        block_count,
+        [&](uint32_t block) {
+            uint32_t const end      = GetParallelBlockEnd(0, block, kParallelBlockSize, count);
+            uint32_t       position = offsets[block];
+            for (uint32_t i = block * kParallelBlockSize; i < end; ++i)
+            {
+                if (flags[i] != 0)
+                {
+                    emit(i, position++);
+                }
+            }
+        },
+        1);
+    return total;
+}
+
+/**
+ * Stream compaction, gather the indices of the elements of a range that pass a predicate.
+ * @param       count     The number of elements.
+ * @param       predicate Returns true to keep element i (called once per element).
+ * @param [out] indices   The indices of the kept elements in increasing order (must hold up to count indices).
+ * @returns The number of kept elements.
+ */
+template<typename PREDICATE>
+uint32_t ParallelCompact(uint32_t count, PREDICATE const &predicate, uint32_t *indices)
+{
+    return ParallelCompactEmit(count, predicate, [indices](uint32_t i, uint32_t position) { indices[position] = i; });
+}
+
+/**
+ * Stream compaction, copy the elements of an array that pass a predicate keeping their order.
+ * @param       values    The elements.
+ * @param       count     The number of elements.
+ * @param       predicate Returns true to keep an element (called once per element with the element).
+ * @param [out] output    The kept elements (must hold up to count elements).
+ * @returns The number of kept elements.
+ */
+template<typename TYPE, typename PREDICATE>
+uint32_t ParallelCopyIf(TYPE const *values, uint32_t count, PREDICATE const &predicate, TYPE *output)
+{
+    return ParallelCompactEmit(
+        count, [&](uint32_t i) { return predicate(values[i]); },
+        [&](uint32_t i, uint32_t position) { output[position] = values[i]; });
+}
+
+/**
+ * Count the elements of a range falling in each bin.
+ * @param count     The number of elements.
+ * @param bin_count The number of bins.
+ * @param bin       Returns the bin of element i (elements outside [0, bin_count) are ignored).
+ * @returns The number of elements in each bin.
+ */
+template<typename BIN>
+std::vector<uint32_t> ParallelHistogram(uint32_t count, uint32_t bin_count, BIN const &bin)
+{
+    // Each chunk of elements fills its own histogram, the histograms are then summed per bin
+    uint32_t const        block_count = GetParallelBlockCount(count, kParallelBlockSize);
+    uint32_t const        chunk_count = std::min(block_count, ThreadPool::GetThreadCount() * 4);
+    uint32_t const        chunk_size  = (block_count != 0 ? GetParallelBlockCount(count, chunk_count) : 0);
+    std::vector<uint32_t> chunk_histograms((size_t)chunk_count * bin_count, 0);
+    ThreadPool::ParallelFor(
+        chunk_count,
+        [&](uint32_t chunk) {
+            uint32_t      *histogram = &chunk_histograms[(size_t)chunk * bin_count];
+            uint32_t const end       = GetParallelBlockEnd(0, chunk, chunk_size, count);
+            for (uint32_t i = chunk * chunk_size; i < end; ++i)
+            {
+                uint32_t const element_bin = (uint32_t)bin(i);
+                if (element_bin < bin_count)
+                {
+                    ++histogram[element_bin];
+                }
+            }
+        },
+        1);
+    std::vector<uint32_t> histogram(bin_count, 0);
+    ThreadPool::ParallelFor(bin_count, [&](uint32_t i) {
+        for (uint32_t chunk = 0; chunk < chunk_count; ++chunk)
+        {
+            histogram[i] += chunk_histograms[(size_t)chunk * bin_count + i];
+        }
+    });
+    return histogram;
+}
+
+/**
+ * Split segments into blocks of up to kParallelBlockSize elements, so that large segments are processed by several
+ * threads while small ones still take a single block.
+ * @param       segment_offsets The first element of each segment followed by the element count (segment_count + 1
+ *                              offsets).
+ * @param       segment_count   The number of segments.
+ * @param [out] first_blocks    The first block of each segment followed by the block count (segment_count + 1
+ *                              values).
+ * @param [out] block_segments  The segment of each block.
+ */
+inline void SplitParallelSegments(uint32_t const *segment_offsets, uint32_t segment_count,
+    std::vector<uint32_t> &first_blocks, std::vector<uint32_t> &block_segments)
+{
+    first_blocks.resize((size_t)segment_count + 1);
+    first_blocks[segment_count] = ParallelTransformScan(
+        segment_count, first_blocks.data(), 0u,
+        [segment_offsets](uint32_t segment) {
+            return GetParallelBlockCount(segment_offsets[segment + 1] - segment_offsets[segment], kParallelBlockSize);
+        },
+        [](uint32_t a, uint32_t b) { return a + b; }, false);
+    block_segments.resize(first_blocks[segment_count]);
+    ThreadPool::ParallelFor(segment_count, [&](uint32_t segment) {
+        std::fill(block_segments.begin() + first_blocks[segment], block_segments.begin() + first_blocks[segment + 1],
+            segment);
+    });
+}
+
+/**
+ * Reduce each segment of an array in parallel.
+ * Segments are split into blocks that are reduced concurrently, then the blocks of each segment are combined in
+ * order so that the results don't depend on the thread count.
+ * @param       values          The elements.
+ * @param       segment_offsets The first element of each segment followed by the element count (segment_count + 1
+ *                              offsets).
+ * @param       segment_count   The number of segments.
+ * @param       identity        The identity of the operator (the result of an empty segment).
+ * @param       op              The operator combining two values.
+ * @param [out] output          The reduced value of each segment.
+ */
+template<typename TYPE, typename OP>
+void ParallelSegmentedReduce(TYPE const *values, uint32_t const *segment_offsets, uint32_t segment_count,
+    TYPE identity, OP const &op, TYPE *output)
+{
+    std::vector<uint32_t> first_blocks;
+    std::vector<uint32_t> block_segments;
+    SplitParallelSegments(segment_offsets, segment_count, first_blocks, block_segments);
+    std::vector<TYPE> partials(block_segments.size(), identity);
+    ThreadPool::ParallelFor(
+        (uint32_t)block_segments.size(),
+        [&](uint32_t block) {
+            uint32_t const segment     = block_segments[block];
+            uint32_t const begin       = segment_offsets[segment];
+            uint32_t const segment_end = segment_offsets[segment + 1];
+            uint32_t const index       = block - first_blocks[segment];
+            uint32_t const end         = GetParallelBlockEnd(begin, index, kParallelBlockSize, segment_end);
+            TYPE           partial     = identity;
+            for (uint32_t i = begin + index * kParallelBlockSize; i < end; ++i)
+            {
+                partial = op(partial, values[i]);
+            }
+            partials[block] = partial;
+        },
+        1);
+    ThreadPool::ParallelFor(segment_count, [&](uint32_t segment) {
+        TYPE result = identity;
+        for (uint32_t block = first_blocks[segment]; block < first_blocks[segment + 1]; ++block)
+        {
+            result = op(result, partials[block]);
+        }
+        output[segment] = result;
+    });
+}
+
+/**
+ * Scan each segment of an array in parallel.
+ * Segments are split into blocks, the blocks are reduced concurrently and each block is then scanned from the
+ * reduction of the previous blocks of its segment.
+ * @param       values          The elements.
+ * @param       segment_offsets The first element of each segment followed by the element count (segment_count + 1
+ *                              offsets).
+ * @param       segment_count   The number of segments.
+ * @param [out] output          The scanned values, restarting at each segment (may be the same array as the
+ *                              elements).
+ * @param       identity        The identity of the operator.
+ * @param       op              The operator combining two values.
+ * @param       inclusive       True for an inclusive scan, False for an exclusive scan.
+ */
+template<typename TYPE, typename OP>
+void ParallelSegmentedScan(TYPE const *values, uint32_t const *segment_offsets, uint32_t segment_count,
+    TYPE *output, TYPE identity, OP const &op, bool inclusive)
+{
+    std::vector<uint32_t> first_blocks;
+    std::vector<uint32_t> block_segments;
+    SplitParallelSegments(segment_offsets, segment_count, first_blocks, block_segments);
+    uint32_t const    block_count = (uint32_t)block_segments.size();
+    std::vector<TYPE> offsets(block_count, identity);
+    auto const        for_each_block = [&](auto const &kernel) {
+        ThreadPool::ParallelFor(
+            block_count,
+            [&](uint32_t block) {
+                uint32_t const segment = block_segments[block];
+                uint32_t const begin   = segment_offsets[segment];
+                uint32_t const index   = block - first_blocks[segment];
+                kernel(block, begin + index * kParallelBlockSize,
+                    GetParallelBlockEnd(begin, index, kParallelBlockSize, segment_offsets[segment + 1]));
+            },
+            1);
+    };
+
+    // Reduce each block, then scan the block totals of each segment to get the offset of each block
+    for_each_block([&](uint32_t block, uint32_t begin, uint32_t end) {
+        TYPE partial = identity;
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            partial = op(partial, values[i]);
+        }
+        offsets[block] = partial;
+    });
+    ThreadPool::ParallelFor(segment_count, [&](uint32_t segment) {
+        TYPE total = identity;
+        for (uint32_t block = first_blocks[segment]; block < first_blocks[segment + 1]; ++block)
+        {
+            TYPE const partial = offsets[block];
+            offsets[block]     = total;
+            total              = op(total, partial);
+        }
+    });
+
+    // Scan each block starting from its offset
+    for_each_block([&](uint32_t block, uint32_t begin, uint32_t end) {
+        TYPE running = offsets[block];
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            TYPE const value = values[i];
+            if (!inclusive)
+            {
+                output[i] = running;
+            }
+            running = op(running, value);
+            if (inclusive)
+            {
+                output[i] = running;
+            }
+        }
+    });
+}
+} // namespace Capsaicin
@@ -0,0 +1,204 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "render_graph_planner.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Capsaicin
+{
+void RenderGraphPlanner::clear() noexcept
+{
+    resources_.clear();
+    passes_.clear();
+    accesses_.clear();
+    slots_.clear();
+    unaliased_size_ = 0;
+    aliased_size_   = 0;
+}
+
+uint32_t RenderGraphPlanner::addResource(
+    std::string_view const &name, uint64_t key, uint64_t size, bool external, bool cleared) noexcept
+{
+    Resource &resource = resources_.emplace_back();
+    resource.name      = name;
+    resource.key       = key;
+    resource.size      = size;
+    resource.external  = external;
+    resource.cleared   = cleared;
+    return (uint32_t)resources_.size() - 1;
+}
+
+uint32_t RenderGraphPlanner::findResource(std::string_view const &name) const noexcept
+{
+    auto const resource = std::find_if(
+        resources_.cbegin(), resources_.cend(), [&name](Resource const &item) { return item.name == name; });
+    return resource != resources_.cend() ? (uint32_t)(resource - resources_.cbegin()) : UINT32_MAX;
+}
+
+void RenderGraphPlanner::addHistory(uint32_t source, uint32_t backup) noexcept
+{
+    resources_[source].copied = true;
+    resources_[backup].source = source + 1;
+}
+
+void RenderGraphPlanner::addPass(std::string_view const &name) noexcept
+{
+    passes_.push_back(name);
+}
+
+void RenderGraphPlanner::addAccess(uint32_t resource, Access access) noexcept
+{
+    // Accesses made before the first pass are considered part of it
+    accesses_.push_back({resource, std::max((uint32_t)passes_.size(), 1U), access});
+}
+
+void RenderGraphPlanner::plan() noexcept
+{
+    uint32_t const end_step   = (uint32_t)passes_.size() + 1;
+    uint32_t const step_count = end_step + 1;
+
+    // Gather the first and last access of each resource, accesses are recorded in pass order
+    std::vector<AccessRecord const *> first_access(resources_.size(), nullptr);
+    std::vector<uint32_t>             last_access(resources_.size(), 0);
+    for (AccessRecord const &access : accesses_)
+    {
+        if (first_access[access.resource] == nullptr)
+        {
+            first_access[access.resource] = &access;
+        }
+        last_access[access.resource] = access.step;
+    }
+
+    // Derive lifetimes, anything whose previous content may be read must be kept for the whole frame
+    for (uint32_t index = 0; index < (uint32_t)resources_.size(); ++index)
+    {
+        Resource &resource = resources_[index];
+        resource.transient = false;
+        resource.first     = 0;
+        resource.last      = end_step;
+        if (resource.external || first_access[index] == nullptr)
+        {
+            continue;
+        }
+        if (resource.source != 0)
+        {
+            // Written by the copy at the start of the frame, only needed until its last reader
+            if (!resource.copied)
+            {
+                resource.transient = true;
+                resource.last      = last_access[index];
+            }
+            continue;
+        }
+        if (!resource.cleared && first_access[index]->access != Access::Write)
+        {
+            continue;
+        }
+        resource.first = (resource.cleared ? 0 : first_access[index]->step);
+        resource.last  = last_access[index];
+        if (resource.copied)
+        {
+            // Must survive until copied at the start of the next frame
+            if (resource.first == 0)
+            {
+                resource.last = end_step;
+                continue;
+            }
+            resource.last = 0;
+        }
+        resource.transient = true;
+    }
+
+    // Place resources in slots, first fit in order of first live step is optimal for non-wrapping lifetimes
+    std::vector<uint32_t> order(resources_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t lhs, uint32_t rhs) {
+        Resource const &left  = resources_[lhs];
+        Resource const &right = resources_[rhs];
+        if (left.transient != right.transient) return !left.transient;
+        if (left.key != right.key) return left.key < right.key;
+        if (left.first != right.first) return left.first < right.first;
+        return left.size > right.size;
+    });
+    slots_.clear();
+    size_t const mask_count = (step_count + 63) / 64;
+    for (uint32_t const index : order)
+    {
+        Resource &resource = resources_[index];
+        Slot     *slot     = nullptr;
+        if (resource.transient)
+        {
+            for (Slot &candidate : slots_)
+            {
+                if (!candidate.shared || candidate.key != resource.key) continue;
+                bool overlaps = false;
+                for (uint32_t step = 0; step < step_count && !overlaps; ++step)
+                {
+                    overlaps = isLive(resource, step) && (candidate.live[step / 64] & (1ULL << (step % 64))) != 0;
+                }
+                if (!overlaps)
+                {
+                    slot = &candidate;
+                    break;
+                }
+            }
+        }
+        if (slot == nullptr)
+        {
+            slot         = &slots_.emplace_back();
+            slot->key    = resource.key;
+            slot->shared = resource.transient;
+            slot->live.resize(mask_count, 0);
+        }
+        for (uint32_t step = 0; step < step_count; ++step)
+        {
+            if (isLive(resource, step)) slot->live[step / 64] |= 1ULL << (step % 64);
+        }
+        slot->size = std::max(slot->size, resource.size);
+        ++slot->resource_count;
+        resource.slot = (uint32_t)(slot - slots_.data());
+    }
+
+    unaliased_size_ = 0;
+    aliased_size_   = 0;
+    for (Resource const &resource : resources_)
+    {
+        unaliased_size_ += resource.size;
+    }
+    for (Slot const &slot : slots_)
+    {
+        aliased_size_ += slot.size;
+    }
+}
+
+bool RenderGraphPlanner::isLive(Resource const &resource, uint32_t step) const noexcept
+{
+    if (!resource.transient) return true;
+    if (resource.first <= resource.last)
+    {
+        return step >= resource.first && step <= resource.last;
+    }
+    return step >= resource.first || step <= resource.last;
+}
+} // namespace Capsaicin
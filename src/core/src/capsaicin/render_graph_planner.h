@@ -0,0 +1,247 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Plans the memory of the resources shared between the passes of a frame (e.g., AOVs and buffers).
+ * Each resource's lifetime is derived from the order and type of the accesses declared by the passes. Transient
+ * resources whose lifetimes don't overlap are then placed in the same allocation (slot), while resources whose
+ * content must survive from one frame to the next keep an allocation of their own.
+ * The frame is split into steps: step 0 is the start of the frame (clears and history copies), each pass is a
+ * step of its own and the last step is the end of the frame (presentation). A lifetime may wrap around the end of
+ * the frame when a resource written during a frame is still needed at the start of the next one.
+ */
+class RenderGraphPlanner
+{
+public:
+    enum class Access : uint8_t
+    {
+        Read,
+        Write,
+        ReadWrite,
+    };
+
+    /**
+     * Remove all resources and passes.
+     */
+    void clear() noexcept;
+
+    /**
+     * Add a resource.
+     * @param name     The name of the resource.
+     * @param key      Resources can only share a slot when their keys match (e.g., same texture format).
+     * @param size     The size of the resource (in bytes).
+     * @param external True if the content must be kept for the whole frame and across frames.
+     * @param cleared  True if the resource is cleared at the start of each frame.
+     * @returns The index of the resource.
+     */
+    uint32_t addResource(
+        std::string_view const &name, uint64_t key, uint64_t size, bool external, bool cleared = false) noexcept;
+
+    /**
+     * Find a resource by name.
+     * @param name The name of the resource.
+     * @returns The index of the resource, or UINT32_MAX if not found.
+     */
+    uint32_t findResource(std::string_view const &name) const noexcept;
+
+    /**
+     * Record that a resource is a copy of another one's content taken at the start of each frame.
+     * @param source The index of the resource copied from.
+     * @param backup The index of the resource copied to.
+     */
+    void addHistory(uint32_t source, uint32_t backup) noexcept;
+
+    /**
+     * Start a new pass, following accesses are made by this pass.
+     * @param name The name of the pass.
+     */
+    void addPass(std::string_view const &name) noexcept;
+
+    /**
+     * Record an access to a resource by the current pass.
+     * @param resource The index of the resource.
+     * @param access   The type of access.
+     */
+    void addAccess(uint32_t resource, Access access) noexcept;
+
+    /**
+     * Compute the lifetime of each resource and assign them to slots.
+     */
+    void plan() noexcept;
+
+    /**
+     * Gets the number of resources.
+     * @returns The resource count.
+     */
+    uint32_t getResourceCount() const noexcept { return (uint32_t)resources_.size(); }
+
+    /**
+     * Gets the name of a resource.
+     * @param resource The index of the resource.
+     * @returns The name passed when the resource was added.
+     */
+    std::string_view getResourceName(uint32_t resource) const noexcept { return resources_[resource].name; }
+
+    /**
+     * Gets the key of a resource.
+     * @param resource The index of the resource.
+     * @returns The key passed when the resource was added.
+     */
+    uint64_t getResourceKey(uint32_t resource) const noexcept { return resources_[resource].key; }
+
+    /**
+     * Gets the size of a resource.
+     * @param resource The index of the resource.
+     * @returns The size passed when the resource was added (in bytes).
+     */
+    uint64_t getResourceSize(uint32_t resource) const noexcept { return resources_[resource].size; }
+
+    /**
+     * Check whether a resource is cleared at the start of each frame.
+     * @param resource The index of the resource.
+     * @returns True if cleared.
+     */
+    bool isCleared(uint32_t resource) const noexcept { return resources_[resource].cleared; }
+
+    /**
+     * Gets the resource whose content is copied into a resource at the start of each frame.
+     * @param resource The index of the resource.
+     * @returns The index of the source resource, or UINT32_MAX if the resource isn't a copy.
+     */
+    uint32_t getHistorySource(uint32_t resource) const noexcept { return resources_[resource].source - 1; }
+
+    /**
+     * Gets the number of passes.
+     * @returns The pass count.
+     */
+    uint32_t getPassCount() const noexcept { return (uint32_t)passes_.size(); }
+
+    /**
+     * Gets the number of slots assigned by the last plan.
+     * @returns The slot count.
+     */
+    uint32_t getSlotCount() const noexcept { return (uint32_t)slots_.size(); }
+
+    /**
+     * Gets the slot a resource was assigned to.
+     * @param resource The index of the resource.
+     * @returns The index of the slot.
+     */
+    uint32_t getSlot(uint32_t resource) const noexcept { return resources_[resource].slot; }
+
+    /**
+     * Gets the size of a slot.
+     * @param slot The index of the slot.
+     * @returns The size of the largest resource in the slot (in bytes).
+     */
+    uint64_t getSlotSize(uint32_t slot) const noexcept { return slots_[slot].size; }
+
+    /**
+     * Gets the number of resources sharing a slot.
+     * @param slot The index of the slot.
+     * @returns The resource count.
+     */
+    uint32_t getSlotResourceCount(uint32_t slot) const noexcept { return slots_[slot].resource_count; }
+
+    /**
+     * Check whether a resource only holds valid content during part of the frame.
+     * @param resource The index of the resource.
+     * @returns True if transient, False if the content is kept for the whole frame.
+     */
+    bool isTransient(uint32_t resource) const noexcept { return resources_[resource].transient; }
+
+    /**
+     * Gets the first step a resource is live at.
+     * @param resource The index of the resource.
+     * @returns The step index (0 for the start of the frame, the pass index + 1 for a pass).
+     */
+    uint32_t getFirstStep(uint32_t resource) const noexcept { return resources_[resource].first; }
+
+    /**
+     * Gets the last step a resource is live at.
+     * @note This is lower than the first step for lifetimes wrapping around the end of the frame.
+     * @param resource The index of the resource.
+     * @returns The step index (the pass count + 1 for the end of the frame).
+     */
+    uint32_t getLastStep(uint32_t resource) const noexcept { return resources_[resource].last; }
+
+    /**
+     * Gets the memory needed when every resource has its own allocation.
+     * @returns The size (in bytes).
+     */
+    uint64_t getUnaliasedSize() const noexcept { return unaliased_size_; }
+
+    /**
+     * Gets the memory needed by the planned slots.
+     * @returns The size (in bytes).
+     */
+    uint64_t getAliasedSize() const noexcept { return aliased_size_; }
+
+private:
+    struct Resource
+    {
+        std::string_view name;              /**< The name of the resource */
+        uint64_t         key       = 0;     /**< Resources can only share a slot when their keys match */
+        uint64_t         size      = 0;     /**< The size of the resource (in bytes) */
+        bool             external  = false; /**< Whether the content must be kept across frames */
+        bool             cleared   = false; /**< Whether the resource is cleared at the start of the frame */
+        bool             copied    = false; /**< Whether the resource is copied to another one each frame */
+        bool             transient = false; /**< Whether the resource only holds content part of the frame */
+        uint32_t         source    = 0;     /**< Index of the resource copied into this one plus 1 (0 if none) */
+        uint32_t         first     = 0;     /**< First live step */
+        uint32_t         last      = 0;     /**< Last live step (lower than first if wrapping) */
+        uint32_t         slot      = 0;     /**< The assigned slot */
+    };
+
+    struct AccessRecord
+    {
+        uint32_t resource = 0;            /**< The index of the accessed resource */
+        uint32_t step     = 0;            /**< The step the access is made at */
+        Access   access   = Access::Read; /**< The type of access */
+    };
+
+    struct Slot
+    {
+        uint64_t              key            = 0;    /**< The key of the resources placed in the slot */
+        uint64_t              size           = 0;    /**< The size of the largest resource in the slot */
+        uint32_t              resource_count = 0;    /**< The number of resources placed in the slot */
+        bool                  shared         = true; /**< Whether other resources may be placed in the slot */
+        std::vector<uint64_t> live;                  /**< Bit mask of the steps the slot is used at */
+    };
+
+    bool isLive(Resource const &resource, uint32_t step) const noexcept;
+
+    std::vector<Resource>         resources_;          /**< The list of resources */
+    std::vector<std::string_view> passes_;             /**< The name of each pass */
+    std::vector<AccessRecord>     accesses_;           /**< The accesses of all passes, in pass order */
+    std::vector<Slot>             slots_;              /**< The slots assigned by the last plan */
+    uint64_t                      unaliased_size_ = 0; /**< Memory needed without aliasing (in bytes) */
+    uint64_t                      aliased_size_   = 0; /**< Memory needed by the planned slots (in bytes) */
+};
+} // namespace Capsaicin
@@ -0,0 +1,106 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "render_option_registry.h"
+
+namespace Capsaicin
+{
+RenderOptionList const RenderOptionRegistry::empty_options_;
+
+void RenderOptionRegistry::clear() noexcept
+{
+    options_ = &empty_options_;
+    entries_.clear();
+    indices_.clear();
+    bool_values_.clear();
+    uint_values_.clear();
+    int_values_.clear();
+    float_values_.clear();
+    ++generation_;
+}
+
+void RenderOptionRegistry::bind(RenderOptionList &options) noexcept
+{
+    options_ = &options;
+    for (auto &[name, value] : options)
+    {
+        if (indices_.contains(name))
+        {
+            continue;
+        }
+        Entry entry;
+        entry.source     = &value;
+        entry.type       = (uint32_t)value.index();
+        entry.generation = generation_ + 1;
+        std::visit(
+            [&](auto const &typed_value) {
+                auto &typed_values = values<std::decay_t<decltype(typed_value)>>();
+                entry.slot         = (uint32_t)typed_values.size();
+                typed_values.push_back(typed_value);
+            },
+            value);
+        indices_.emplace(name, (uint32_t)entries_.size());
+        entries_.push_back(entry);
+    }
+    ++generation_;
+}
+
+bool RenderOptionRegistry::sync() noexcept
+{
+    bool changed = false;
+    for (uint32_t i = 0; i < (uint32_t)entries_.size(); ++i)
+    {
+        changed = syncEntry(i) || changed;
+    }
+    return changed;
+}
+
+bool RenderOptionRegistry::sync(std::string_view const &name) noexcept
+{
+    auto const i = indices_.find(name);
+    return i != indices_.end() && syncEntry(i->second);
+}
+
+bool RenderOptionRegistry::syncEntry(uint32_t index) noexcept
+{
+    Entry &entry = entries_[index];
+    if (entry.source->index() != entry.type)
+    {
+        return false; // type was changed through the list, which is not supported
+    }
+    bool changed = false;
+    std::visit(
+        [&](auto const &source_value) {
+            auto &value = values<std::decay_t<decltype(source_value)>>()[entry.slot];
+            if (value != source_value)
+            {
+                value   = source_value;
+                changed = true;
+            }
+        },
+        *entry.source);
+    if (changed)
+    {
+        entry.generation = ++generation_;
+    }
+    return changed;
+}
+} // namespace Capsaicin
@@ -0,0 +1,223 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "capsaicin_internal_types.h"
+
+#include <unordered_map>
+
+namespace Capsaicin
+{
+/**
+ * Handle to a registered render option of a given type.
+ * Handles stay valid until the registry is cleared, i.e., until the renderer is changed.
+ */
+template<typename T>
+struct RenderOptionHandle
+{
+    uint32_t index = UINT32_MAX; /**< Dense index of the option within the registry */
+
+    explicit operator bool() const noexcept { return index != UINT32_MAX; }
+};
+
+/**
+ * Registry assigning each render option a dense index with its value stored in a flat array of its type.
+ * The registry mirrors a render option list, which remains the interface used to list options by name and to edit
+ * them directly (e.g., through the UI). Every change bumps a global generation along with the generation of the
+ * changed option so that users of the options can skip any work while nothing changed.
+ */
+class RenderOptionRegistry
+{
+public:
+    /**
+     * Release all registered options, invalidating all handles.
+     */
+    void clear() noexcept;
+
+    /**
+     * Register the options of a list that are not registered yet.
+     * @note The list entries are referenced by the registry so must not be erased until the registry is cleared.
+     * @param options The list to mirror.
+     */
+    void bind(RenderOptionList &options) noexcept;
+
+    /**
+     * Pick up the changes made to the values of the mirrored list.
+     * @returns True if any option changed.
+     */
+    bool sync() noexcept;
+
+    /**
+     * Pick up the change made to a single value of the mirrored list.
+     * @param name The name of the option.
+     * @returns True if the option changed.
+     */
+    bool sync(std::string_view const &name) noexcept;
+
+    /**
+     * Find an option.
+     * @tparam T Type of the option.
+     * @param name The name of the option.
+     * @returns The option handle (invalid if the option does not exist or has a different type).
+     */
+    template<typename T>
+    RenderOptionHandle<T> find(std::string_view const &name) const noexcept
+    {
+        if (auto const i = indices_.find(name); i != indices_.end() && entries_[i->second].type == TypeIndex<T>())
+        {
+            return {i->second};
+        }
+        return {};
+    }
+
+    /**
+     * Gets the value of an option.
+     * @tparam T Type of the option.
+     * @param handle The option handle.
+     * @returns The option value (default value if the handle is invalid).
+     */
+    template<typename T>
+    T get(RenderOptionHandle<T> handle) const noexcept
+    {
+        return handle ? (T)values<T>()[entries_[handle.index].slot] : T();
+    }
+
+    /**
+     * Sets the value of an option, the mirrored list is updated as well.
+     * @tparam T Type of the option.
+     * @param handle The option handle.
+     * @param value  The new value.
+     */
+    template<typename T>
+    void set(RenderOptionHandle<T> handle, T value) noexcept
+    {
+        if (handle)
+        {
+            *std::get_if<T>(entries_[handle.index].source) = value;
+            syncEntry(handle.index);
+        }
+    }
+
+    /**
+     * Gets the generation of all options, increased every time any option changes.
+     * @returns The generation.
+     */
+    uint64_t getGeneration() const noexcept { return generation_; }
+
+    /**
+     * Gets the generation of the most recent change to an option.
+     * @tparam T Type of the option.
+     * @param handle The option handle.
+     * @returns The generation (0 if the handle is invalid).
+     */
+    template<typename T>
+    uint64_t getGeneration(RenderOptionHandle<T> handle) const noexcept
+    {
+        return handle ? entries_[handle.index].generation : 0;
+    }
+
+    /**
+     * Gets the mirrored render option list.
+     * @returns The render options.
+     */
+    RenderOptionList const &getOptions() const noexcept { return *options_; }
+
+private:
+    /** A registered option. */
+    struct Entry
+    {
+        option  *source;     /**< The value within the mirrored list */
+        uint32_t type;       /**< Index of the value type within the option variant */
+        uint32_t slot;       /**< Index of the value within the array of its type */
+        uint64_t generation; /**< Generation of the most recent change */
+    };
+
+    template<typename T>
+    static constexpr uint32_t TypeIndex() noexcept
+    {
+        return (uint32_t)option(T()).index();
+    }
+
+    template<typename T>
+    auto &values() noexcept
+    {
+        if constexpr (std::is_same_v<T, bool>) return bool_values_;
+        else if constexpr (std::is_same_v<T, uint32_t>) return uint_values_;
+        else if constexpr (std::is_same_v<T, int32_t>) return int_values_;
+        else return float_values_;
+    }
+
+    template<typename T>
+    auto const &values() const noexcept
+    {
+        return const_cast<RenderOptionRegistry *>(this)->values<T>();
+    }
+
+    bool syncEntry(uint32_t index) noexcept;
+
+    static RenderOptionList const empty_options_; /**< List mirrored while nothing is bound */
+
+    RenderOptionList const                        *options_ = &empty_options_; /**< The mirrored option list */
+    std::vector<Entry>                             entries_;         /**< Registered options by index */
+    std::unordered_map<std::string_view, uint32_t> indices_;         /**< Index of each option by name */
+    std::vector<uint8_t>                           bool_values_;     /**< Values of the boolean options */
+    std::vector<uint32_t>                          uint_values_;     /**< Values of the unsigned integer options */
+    std::vector<int32_t>                           int_values_;      /**< Values of the signed integer options */
+    std::vector<float>                             float_values_;    /**< Values of the floating point options */
+    uint64_t                                       generation_ = 1;  /**< Generation of the most recent change */
+};
+
+/**
+ * Caches a render options struct so that it is only converted again from the option list once an option changed.
+ * @tparam OPTIONS The render options struct.
+ */
+template<typename OPTIONS>
+class RenderOptionsCache
+{
+public:
+    /**
+     * Gets the up to date render options.
+     * @param registry The render option registry.
+     * @param convert  Function converting a render option list to the render options struct.
+     * @returns The render options.
+     */
+    template<typename CONVERT>
+    OPTIONS const &get(RenderOptionRegistry const &registry, CONVERT convert) noexcept
+    {
+        if (generation_ != registry.getGeneration())
+        {
+            options_    = convert(registry.getOptions());
+            generation_ = registry.getGeneration();
+        }
+        return options_;
+    }
+
+    /**
+     * Force the options to be converted again on next use.
+     */
+    void reset() noexcept { generation_ = 0; }
+
+private:
+    OPTIONS  options_;        /**< The cached render options */
+    uint64_t generation_ = 0; /**< The registry generation the cached options were converted at */
+};
+} // namespace Capsaicin
@@ -0,0 +1,563 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "scene_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr char     kCacheMagic[4]    = {'C', 'S', 'C', 'N'};
+constexpr uint64_t kSectionAlignment = 64; /**< Alignment of each section within the file (in bytes) */
+
+/** Location of a section within a cache file. */
+struct SectionEntry
+{
+    uint64_t offset; /**< Offset from the start of the file (in bytes) */
+    uint64_t size;   /**< Size of the section (in bytes) */
+};
+
+/** Header found at the start of a cache file. */
+struct CacheHeader
+{
+    char         magic[4];
+    uint32_t     version;
+    uint64_t     key;
+    uint64_t     file_size;
+    SectionEntry sections[(size_t)SceneCache::Section::Count];
+};
+
+uint64_t AlignSection(uint64_t offset) noexcept
+{
+    return (offset + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+}
+
+/**
+ * Gets the value of a hexadecimal digit.
+ * @param c The digit.
+ * @returns The value, or -1 if not a hexadecimal digit.
+ */
+int GetHexDigit(char c) noexcept
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/**
+ * Append a code point to a string using UTF-8.
+ * @param [in,out] text       The string.
+ * @param          code_point The code point.
+ */
+void AppendUtf8(std::string &text, uint32_t code_point) noexcept
+{
+    if (code_point < 0x80)
+    {
+        text += (char)code_point;
+    }
+    else if (code_point < 0x800)
+    {
+        text += (char)(0xC0 | (code_point >> 6));
+        text += (char)(0x80 | (code_point & 0x3F));
+    }
+    else
+    {
+        text += (char)(0xE0 | (code_point >> 12));
+        text += (char)(0x80 | ((code_point >> 6) & 0x3F));
+        text += (char)(0x80 | (code_point & 0x3F));
+    }
+}
+
+/**
+ * Get the path of a file referenced by a scene file.
+ * @param directory The directory of the scene file.
+ * @param reference The UTF-8 path of the file as written in the scene file.
+ * @returns The path of the file.
+ */
+std::string GetReferencePath(std::filesystem::path const &directory, std::string_view reference) noexcept
+{
+    std::filesystem::path const path(std::u8string(reference.begin(), reference.end()));
+    return (directory / path).lexically_normal().string();
+}
+
+/**
+ * Find the external buffers and images of a glTF scene, i.e. the values of its "uri" properties.
+ * @param          json       The JSON text of the scene.
+ * @param          directory  The directory of the scene file.
+ * @param [in,out] references The paths of the referenced files.
+ */
+void FindGltfReferences(
+    std::string_view json, std::filesystem::path const &directory, std::vector<std::string> &references) noexcept
+{
+    constexpr std::string_view kUriKey = "\"uri\"";
+
+    auto const skipSpaces = [&](size_t position) {
+        while (position < json.size()
+               && (json[position] == ' ' || json[position] == '\t' || json[position] == '\n'
+                   || json[position] == '\r'))
+        {
+            ++position;
+        }
+        return position;
+    };
+    for (size_t position = json.find(kUriKey); position != std::string_view::npos;
+         position        = json.find(kUriKey, position))
+    {
+        position = skipSpaces(position + kUriKey.size());
+        if (position >= json.size() || json[position] != ':')
+        {
+            continue; // not a key
+        }
+        position = skipSpaces(position + 1);
+        if (position >= json.size() || json[position] != '"')
+        {
+            continue;
+        }
+
+        // Unescape the JSON string
+        std::string uri;
+        for (++position; position < json.size() && json[position] != '"'; ++position)
+        {
+            if (json[position] != '\\' || position + 1 >= json.size())
+            {
+                uri += json[position];
+                continue;
+            }
+            char const escape = json[++position];
+            switch (escape)
+            {
+            case 'b': uri += '\b'; break;
+            case 'f': uri += '\f'; break;
+            case 'n': uri += '\n'; break;
+            case 'r': uri += '\r'; break;
+            case 't': uri += '\t'; break;
+            case 'u':
+            {
+                uint32_t code_point = 0;
+                for (uint32_t i = 0; i < 4 && position + 1 < json.size(); ++i)
+                {
+                    int const digit = GetHexDigit(json[position + 1]);
+                    if (digit < 0)
+                    {
+                        break;
+                    }
+                    code_point = (code_point << 4) | (uint32_t)digit;
+                    ++position;
+                }
+                AppendUtf8(uri, code_point);
+                break;
+            }
+            default: uri += escape; break;
+            }
+        }
+
+        // Embedded data is part of the scene file itself, other URIs are percent-encoded relative paths
+        if (uri.starts_with("data:"))
+        {
+            continue;
+        }
+        std::string path;
+        for (size_t i = 0; i < uri.size(); ++i)
+        {
+            int const high = i + 2 < uri.size() && uri[i] == '%' ? GetHexDigit(uri[i + 1]) : -1;
+            int const low  = high >= 0 ? GetHexDigit(uri[i + 2]) : -1;
+            if (low >= 0)
+            {
+                path += (char)((high << 4) | low);
+                i += 2;
+            }
+            else
+            {
+                path += uri[i];
+            }
+        }
+        references.push_back(GetReferencePath(directory, path));
+    }
+}
+
+/**
+ * Find the files referenced by an OBJ scene or material library, i.e. the values of its "mtllib" statements or
+ * of its texture map statements.
+ * @param          text       The text of the file.
+ * @param          directory  The directory of the file.
+ * @param          material   True to look for the textures of a material library, False for the material libraries
+ *                            of a scene.
+ * @param [in,out] references The paths of the referenced files.
+ */
+void FindObjReferences(std::string_view text, std::filesystem::path const &directory, bool material,
+    std::vector<std::string> &references) noexcept
+{
+    constexpr std::string_view kSpaces = " \t\r";
+
+    while (!text.empty())
+    {
+        size_t const     line_end = std::min(text.find('\n'), text.size());
+        std::string_view line     = text.substr(0, line_end);
+        text.remove_prefix(std::min(line_end + 1, text.size()));
+
+        size_t const line_start = line.find_first_not_of(kSpaces);
+        if (line_start == std::string_view::npos)
+        {
+            continue;
+        }
+        line.remove_prefix(line_start);
+        size_t const           statement_end = std::min(line.find_first_of(kSpaces), line.size());
+        std::string_view const statement     = line.substr(0, statement_end);
+        line.remove_prefix(statement_end);
+        line = line.substr(0, line.find_last_not_of(kSpaces) + 1);
+        line.remove_prefix(std::min(line.find_first_not_of(kSpaces), line.size()));
+        if (line.empty())
+        {
+            continue;
+        }
+        if (!material && statement == "mtllib")
+        {
+            references.push_back(GetReferencePath(directory, line));
+        }
+        else if (material
+                 && (statement.starts_with("map_") || statement == "bump" || statement == "disp"
+                     || statement == "decal" || statement == "refl" || statement == "norm"))
+        {
+            // The file name follows the options of the statement
+            size_t const name_start = line.find_last_of(kSpaces);
+            references.push_back(GetReferencePath(
+                directory, name_start != std::string_view::npos ? line.substr(name_start + 1) : line));
+        }
+    }
+}
+} // unnamed namespace
+
+bool MappedFile::open(char const *file_path) noexcept
+{
+    close();
+#ifdef _WIN32
+    HANDLE const file = CreateFileA(file_path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER size = {};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE const mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    void const *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    file_    = file;
+    mapping_ = mapping;
+    data_    = static_cast<uint8_t *>(const_cast<void *>(data));
+    size_    = (uint64_t)size.QuadPart;
+#else
+    int const file = ::open(file_path, O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+    struct stat file_stat = {};
+    if (fstat(file, &file_stat) != 0 || file_stat.st_size == 0)
+    {
+        ::close(file);
+        return false;
+    }
+    void *data = mmap(nullptr, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file); // the mapping keeps its own reference to the file
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+    data_ = static_cast<uint8_t *>(data);
+    size_ = (uint64_t)file_stat.st_size;
+#endif
+    return true;
+}
+
+bool MappedFile::create(char const *file_path, uint64_t size) noexcept
+{
+    close();
+    if (size == 0)
+    {
+        return false;
+    }
+#ifdef _WIN32
+    HANDLE const file = CreateFileA(file_path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+        CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    // Mapping more than the file size grows the file
+    HANDLE const mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READWRITE, (DWORD)(size >> 32), (DWORD)size, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    void *data = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    file_    = file;
+    mapping_ = mapping;
+#else
+    int const file = ::open(file_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0)
+    {
+        return false;
+    }
+    if (ftruncate(file, (off_t)size) != 0)
+    {
+        ::close(file);
+        return false;
+    }
+    void *data = mmap(nullptr, (size_t)size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    ::close(file); // the mapping keeps its own reference to the file
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+#endif
+    data_     = static_cast<uint8_t *>(data);
+    size_     = size;
+    writable_ = true;
+    return true;
+}
+
+void MappedFile::close() noexcept
+{
+#ifdef _WIN32
+    if (data_ != nullptr)
+    {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr)
+    {
+        CloseHandle(mapping_);
+    }
+    if (file_ != nullptr)
+    {
+        CloseHandle(file_);
+    }
+#else
+    if (data_ != nullptr)
+    {
+        munmap(data_, (size_t)size_);
+    }
+#endif
+    data_     = nullptr;
+    size_     = 0;
+    writable_ = false;
+    file_     = nullptr;
+    mapping_  = nullptr;
+}
+
+bool SceneCache::open(char const *file_path, uint64_t key) noexcept
+{
+    close();
+    if (!file_.open(file_path))
+    {
+        return false;
+    }
+
+    // Validate the header and the bounds of every section before handing out any pointer into the file
+    CacheHeader const *header = reinterpret_cast<CacheHeader const *>(file_.getData());
+    bool               valid  = file_.getSize() >= sizeof(CacheHeader)
+                 && std::equal(header->magic, header->magic + 4, kCacheMagic) && header->version == kVersion
+                 && header->key == key && header->file_size == file_.getSize();
+    for (uint32_t i = 0; valid && i < (uint32_t)Section::Count; ++i)
+    {
+        SectionEntry const &section = header->sections[i];
+        valid = section.offset % kSectionAlignment == 0 && section.offset <= file_.getSize()
+             && section.size <= file_.getSize() - section.offset;
+    }
+    if (!valid)
+    {
+        close();
+    }
+    return valid;
+}
+
+void SceneCache::close() noexcept
+{
+    file_.close();
+}
+
+bool SceneCache::Write(
+    char const *file_path, uint64_t key, SectionData const (&sections)[(size_t)Section::Count]) noexcept
+{
+    CacheHeader header = {};
+    std::copy(kCacheMagic, kCacheMagic + 4, header.magic);
+    header.version = kVersion;
+    header.key     = key;
+    uint64_t offset = AlignSection(sizeof(CacheHeader));
+    for (uint32_t i = 0; i < (uint32_t)Section::Count; ++i)
+    {
+        header.sections[i].offset = offset;
+        header.sections[i].size   = sections[i].size;
+        offset                    = AlignSection(offset + sections[i].size);
+    }
+    header.file_size = offset;
+
+    // Write to a temporary file first so that a partially written cache is never picked up
+    std::string const temp_path = std::string(file_path) + ".tmp";
+    FILE             *file      = fopen(temp_path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    char const padding[kSectionAlignment] = {};
+    bool       result  = fwrite(&header, sizeof(header), 1, file) == 1;
+    uint64_t   written = sizeof(header);
+    for (uint32_t i = 0; result && i <= (uint32_t)Section::Count; ++i)
+    {
+        uint64_t const section_offset =
+            i < (uint32_t)Section::Count ? header.sections[i].offset : header.file_size;
+        result = fwrite(padding, 1, (size_t)(section_offset - written), file) == section_offset - written;
+        written = section_offset;
+        if (result && i < (uint32_t)Section::Count && sections[i].size > 0)
+        {
+            result = fwrite(sections[i].data, 1, (size_t)sections[i].size, file) == sections[i].size;
+            written += sections[i].size;
+        }
+    }
+    result = (fclose(file) == 0) && result;
+    if (result)
+    {
+        remove(file_path);
+        result = rename(temp_path.c_str(), file_path) == 0;
+    }
+    if (!result)
+    {
+        remove(temp_path.c_str());
+    }
+    return result;
+}
+
+void const *SceneCache::getSectionData(Section section, uint64_t &size) const noexcept
+{
+    if (!isOpen() || section >= Section::Count)
+    {
+        size = 0;
+        return nullptr;
+    }
+    SectionEntry const &entry = reinterpret_cast<CacheHeader const *>(file_.getData())->sections[(size_t)section];
+    size                      = entry.size;
+    return file_.getData() + entry.offset;
+}
+std::vector<std::string> GetSceneFileReferences(char const *file_path) noexcept
+{
+    std::vector<std::string> references;
+    MappedFile               file;
+    if (!file.open(file_path))
+    {
+        return references;
+    }
+    std::string_view const text(reinterpret_cast<char const *>(file.getData()), (size_t)file.getSize());
+    std::filesystem::path const scene_path(file_path);
+    std::filesystem::path const directory = scene_path.parent_path();
+    std::string                 extension = scene_path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+        [](char c) { return (char)(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c); });
+
+    if (extension == ".gltf")
+    {
+        FindGltfReferences(text, directory, references);
+    }
+    else if (extension == ".glb")
+    {
+        // The JSON chunk directly follows the 12 bytes header of a binary glTF file
+        constexpr uint32_t kJsonChunkType = 0x4E4F534Au; // "JSON"
+        uint32_t           chunk[2]       = {};
+        if (text.size() >= 20)
+        {
+            memcpy(chunk, text.data() + 12, sizeof(chunk));
+        }
+        if (chunk[1] == kJsonChunkType && chunk[0] <= text.size() - 20)
+        {
+            FindGltfReferences(text.substr(20, chunk[0]), directory, references);
+        }
+    }
+    else if (extension == ".obj")
+    {
+        FindObjReferences(text, directory, false, references);
+        size_t const library_count = references.size();
+        for (size_t i = 0; i < library_count; ++i)
+        {
+            MappedFile library;
+            if (library.open(references[i].c_str()))
+            {
+                FindObjReferences(
+                    std::string_view(reinterpret_cast<char const *>(library.getData()), (size_t)library.getSize()),
+                    std::filesystem::path(references[i]).parent_path(), true, references);
+            }
+        }
+    }
+    return references;
+}
+} // namespace Capsaicin
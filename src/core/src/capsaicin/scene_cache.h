@@ -0,0 +1,185 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Capsaicin
+{
+/** A memory mapping of a whole file, read-only unless created through create(). */
+class MappedFile
+{
+public:
+    MappedFile() noexcept = default;
+    ~MappedFile() noexcept { close(); }
+
+    MappedFile(MappedFile const &)            = delete;
+    MappedFile &operator=(MappedFile const &) = delete;
+
+    /**
+     * Map a file into memory, any previously mapped file is unmapped.
+     * @param file_path Path to the file.
+     * @returns True if succeeded, False otherwise.
+     */
+    bool open(char const *file_path) noexcept;
+
+    /**
+     * Create (or overwrite) a file of a given size and map it into memory for writing, any previously mapped file
+     * is unmapped.
+     * @param file_path Path to the file.
+     * @param size      The size of the file (in bytes).
+     * @returns True if succeeded, False otherwise.
+     */
+    bool create(char const *file_path, uint64_t size) noexcept;
+
+    /**
+     * Unmap the file.
+     */
+    void close() noexcept;
+
+    /**
+     * Gets the mapped file contents.
+     * @returns The file data (nullptr if no file is mapped).
+     */
+    uint8_t const *getData() const noexcept { return data_; }
+
+    /**
+     * Gets the mapped file contents for writing.
+     * @returns The file data (nullptr if no file is mapped or the file was mapped read-only).
+     */
+    uint8_t *getWritableData() const noexcept { return writable_ ? data_ : nullptr; }
+
+    /**
+     * Gets the size of the mapped file.
+     * @returns The file size (in bytes).
+     */
+    uint64_t getSize() const noexcept { return size_; }
+
+private:
+    uint8_t *data_     = nullptr; /**< The mapped file contents */
+    uint64_t size_     = 0;       /**< The size of the mapped file (in bytes) */
+    bool     writable_ = false;   /**< Whether the file is mapped for writing */
+    void    *file_     = nullptr; /**< The native file handle (Windows only) */
+    void    *mapping_  = nullptr; /**< The native file mapping handle (Windows only) */
+};
+
+/**
+ * Versioned binary cache of the flattened scene data.
+ * The file is memory mapped when loaded so that its sections can be uploaded to the GPU without any parsing or
+ * conversion.
+ */
+class SceneCache
+{
+public:
+    /** Version of the cache layout, any change to the cached types or their meaning must increment it. */
+    static constexpr uint32_t kVersion = 1;
+
+    /** The sections stored in a cache file. */
+    enum class Section : uint32_t
+    {
+        Meshes = 0,  /**< Mesh[] indexed by mesh handle */
+        MeshStates,  /**< MeshState[] indexed by mesh handle */
+        Indices,     /**< uint32_t[] global index data */
+        Vertices,    /**< Vertex[] global vertex data */
+        GpuVertices, /**< Global vertex data in the layout uploaded to the GPU (empty if same as Vertices) */
+        Materials,   /**< Material[] indexed by material handle */
+        MeshKeys,    /**< uint64_t[] optimized mesh cache key of each mesh (empty if meshes are not optimized) */
+        Count
+    };
+
+    /** Location of each mesh in the global buffers. */
+    struct MeshState
+    {
+        uint32_t vertex_count;    /**< Number of vertices of the mesh as uploaded */
+        uint32_t vertex_capacity; /**< Number of vertices reserved for the mesh */
+        uint32_t index_capacity;  /**< Number of indices reserved for the mesh */
+        uint32_t valid;           /**< Non-zero if the mesh exists */
+    };
+
+    /** The data of a section to be written. */
+    struct SectionData
+    {
+        void const *data = nullptr; /**< The section contents */
+        uint64_t    size = 0;       /**< The section size (in bytes) */
+    };
+
+    /**
+     * Map a cache file and check that it matches the expected version and key.
+     * @param file_path Path to the cache file.
+     * @param key       The key identifying the source files and build options.
+     * @returns True if succeeded, False if the file is missing, invalid or stale.
+     */
+    bool open(char const *file_path, uint64_t key) noexcept;
+
+    /**
+     * Unmap the cache file.
+     */
+    void close() noexcept;
+
+    /**
+     * Check whether a cache file is currently mapped.
+     * @returns True if mapped.
+     */
+    bool isOpen() const noexcept { return file_.getData() != nullptr; }
+
+    /**
+     * Gets the contents of a section.
+     * @param       section The section to get.
+     * @param [out] count   The number of elements in the section.
+     * @returns The section contents (pointing into the mapped file).
+     */
+    template<typename TYPE>
+    TYPE const *getSection(Section section, uint64_t &count) const noexcept
+    {
+        uint64_t size = 0;
+        void const *data = getSectionData(section, size);
+        count = size / sizeof(TYPE);
+        return static_cast<TYPE const *>(data);
+    }
+
+    /**
+     * Write a cache file.
+     * @param file_path Path to the cache file.
+     * @param key       The key identifying the source files and build options.
+     * @param sections  The contents of each section.
+     * @returns True if succeeded, False otherwise.
+     */
+    static bool Write(
+        char const *file_path, uint64_t key, SectionData const (&sections)[(size_t)Section::Count]) noexcept;
+
+private:
+    void const *getSectionData(Section section, uint64_t &size) const noexcept;
+
+    MappedFile file_; /**< The mapped cache file */
+};
+
+/**
+ * Find the files referenced by a scene file, i.e. the buffers and images of a glTF scene or the material libraries
+ * of an OBJ scene and their textures. Embedded data is skipped and other formats reference no files.
+ * @param file_path Path to the scene file.
+ * @returns The paths of the referenced files (relative to the current directory) in the order they are referenced.
+ */
+std::vector<std::string> GetSceneFileReferences(char const *file_path) noexcept;
+} // namespace Capsaicin
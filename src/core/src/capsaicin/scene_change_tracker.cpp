@@ -0,0 +1,90 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "scene_change_tracker.h"
+
+namespace Capsaicin
+{
+void SceneChangeTracker::reset() noexcept
+{
+    for (auto &objects : objects_)
+    {
+        objects.generations.clear();
+        objects.dirty_frames.clear();
+        objects.dirty.clear();
+        ++objects.generation;
+    }
+    frame_ = 1;
+}
+
+void SceneChangeTracker::beginFrame() noexcept
+{
+    for (auto &objects : objects_)
+    {
+        objects.dirty.clear();
+    }
+    ++frame_;
+}
+
+void SceneChangeTracker::markChanged(ObjectType type, uint32_t handle) noexcept
+{
+    Objects &objects = objects_[(size_t)type];
+    if (handle >= objects.generations.size())
+    {
+        objects.generations.resize((size_t)handle + 1, 0);
+        objects.dirty_frames.resize((size_t)handle + 1, 0);
+    }
+    // Skip zero on wrap-around as it is reserved for untracked objects
+    objects.generations[handle] = objects.generations[handle] + 1 != 0 ? objects.generations[handle] + 1 : 1;
+    ++objects.generation;
+    if (objects.dirty_frames[handle] != frame_)
+    {
+        objects.dirty_frames[handle] = frame_;
+        objects.dirty.push_back(handle);
+    }
+}
+
+bool SceneChangeTracker::isTracked(ObjectType type, uint32_t handle) const noexcept
+{
+    return getGeneration(type, handle) != 0;
+}
+
+uint32_t SceneChangeTracker::getGeneration(ObjectType type, uint32_t handle) const noexcept
+{
+    Objects const &objects = objects_[(size_t)type];
+    return handle < objects.generations.size() ? objects.generations[handle] : 0;
+}
+
+uint64_t SceneChangeTracker::getGeneration(ObjectType type) const noexcept
+{
+    return objects_[(size_t)type].generation;
+}
+
+std::vector<uint32_t> const &SceneChangeTracker::getDirty(ObjectType type) const noexcept
+{
+    return objects_[(size_t)type].dirty;
+}
+
+bool SceneChangeTracker::hasChanges(ObjectType type) const noexcept
+{
+    return !objects_[(size_t)type].dirty.empty();
+}
+} // namespace Capsaicin
@@ -0,0 +1,118 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Tracks changes made to scene objects using per-object generation counters.
+ * Every time an object is marked as changed its generation is incremented and it is added to the dirty list of
+ * the current frame, so that consumers only need to process the objects that actually changed.
+ */
+class SceneChangeTracker
+{
+public:
+    /** The types of tracked scene objects. */
+    enum class ObjectType : uint32_t
+    {
+        Mesh = 0,  /**< Mesh vertex/index data */
+        Material,  /**< Material properties */
+        Instance,  /**< Instance mesh/material bindings */
+        Transform, /**< Instance transforms */
+        Light,     /**< Light properties */
+        Image,     /**< Image texel data */
+        Count
+    };
+
+    /**
+     * Clear all tracking state, used when a new scene is loaded.
+     */
+    void reset() noexcept;
+
+    /**
+     * Start a new frame by clearing the dirty lists of the previous frame.
+     * @note Cost is proportional to the number of objects changed in the previous frame.
+     */
+    void beginFrame() noexcept;
+
+    /**
+     * Mark an object as changed.
+     * @param type   The type of the object.
+     * @param handle The scene handle of the object.
+     */
+    void markChanged(ObjectType type, uint32_t handle) noexcept;
+
+    /**
+     * Check whether an object has ever been marked as changed (i.e., is known to the tracker).
+     * @param type   The type of the object.
+     * @param handle The scene handle of the object.
+     * @returns True if tracked, False otherwise.
+     */
+    bool isTracked(ObjectType type, uint32_t handle) const noexcept;
+
+    /**
+     * Get the generation of an object.
+     * @param type   The type of the object.
+     * @param handle The scene handle of the object.
+     * @returns The generation, zero if the object is not tracked.
+     */
+    uint32_t getGeneration(ObjectType type, uint32_t handle) const noexcept;
+
+    /**
+     * Get the generation of an object type, this is incremented whenever any object of that type changes.
+     * @param type The type of the objects.
+     * @returns The generation.
+     */
+    uint64_t getGeneration(ObjectType type) const noexcept;
+
+    /**
+     * Get the list of objects changed during the current frame.
+     * @param type The type of the objects.
+     * @returns The scene handles of the changed objects (each handle appears once).
+     */
+    std::vector<uint32_t> const &getDirty(ObjectType type) const noexcept;
+
+    /**
+     * Check whether any object of a given type changed during the current frame.
+     * @param type The type of the objects.
+     * @returns True if at least one object changed, False otherwise.
+     */
+    bool hasChanges(ObjectType type) const noexcept;
+
+private:
+    struct Objects
+    {
+        std::vector<uint32_t> generations;   /**< Per-object generation (0 means untracked) */
+        std::vector<uint32_t> dirty_frames;  /**< Per-object frame in which it was last marked */
+        std::vector<uint32_t> dirty;         /**< Objects marked during the current frame */
+        uint64_t              generation = 0; /**< Generation of the whole object type */
+    };
+
+    std::array<Objects, (size_t)ObjectType::Count> objects_;   /**< Tracking state for each object type */
+    uint32_t                                       frame_ = 1; /**< The current tracking frame */
+};
+} // namespace Capsaicin
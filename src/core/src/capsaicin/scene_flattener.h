@@ -0,0 +1,105 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "gpu_shared.h"
+#include "thread_pool.h"
+#include "vertex_packing.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace Capsaicin
+{
+/** Number of vertices and indices converted by each job of FlattenMeshes(). */
+constexpr uint32_t kFlattenJobSize = 16384;
+
+/**
+ * Convert a scene vertex to the GPU vertex layout.
+ * @param vertex The source vertex (any type with position, normal and uv members, e.g. GfxVertex).
+ * @returns The GPU vertex.
+ */
+template<typename VERTEX>
+Vertex MakeVertex(VERTEX const &vertex) noexcept
+{
+    Vertex ret = {};
+
+    ret.position = float4(vertex.position, 1.0f);
+    ret.normal   = float4(vertex.normal, 0.0f);
+    ret.uv       = float2(vertex.uv);
+
+    return ret;
+}
+
+static_assert(sizeof(CompactVertex) == 20, "CompactVertex must match the tightly packed HLSL layout");
+
+/**
+ * Convert a GPU vertex to the compact vertex layout.
+ * @param vertex The vertex to convert.
+ * @returns The compact vertex.
+ */
+inline CompactVertex MakeCompactVertex(Vertex const &vertex) noexcept
+{
+    CompactVertex ret = {};
+
+    ret.position = glm::vec3(vertex.position);
+    ret.normal   = PackNormalOctahedral(glm::vec3(vertex.normal));
+    ret.uv       = PackUV(glm::vec2(vertex.uv));
+
+    return ret;
+}
+
+/**
+ * Convert the vertices and indices of a list of meshes in parallel.
+ * The meshes are split into similarly sized jobs so that a few large meshes don't serialize the conversion, each
+ * job covers the same range of vertices and indices of a single mesh.
+ * @param mesh_count The number of meshes.
+ * @param get_count  Called as get_count(mesh), returns the larger of the vertex and index count of the mesh.
+ * @param flatten    Called as flatten(mesh, first, last) from the worker threads to convert the vertices and indices
+ *                   in [first, last), last must be clamped to the vertex and index counts by the callee.
+ */
+template<typename GET_COUNT, typename FLATTEN>
+void FlattenMeshes(uint32_t mesh_count, GET_COUNT const &get_count, FLATTEN const &flatten) noexcept
+{
+    struct FlattenJob
+    {
+        uint32_t mesh;  /**< The index of the mesh */
+        uint32_t first; /**< The first vertex/index to be converted */
+    };
+
+    std::vector<FlattenJob> jobs;
+    for (uint32_t i = 0; i < mesh_count; ++i)
+    {
+        uint32_t const count = get_count(i);
+        for (uint32_t first = 0; first < count; first += kFlattenJobSize)
+        {
+            jobs.push_back({i, first});
+        }
+    }
+    ThreadPool().Dispatch(
+        [&](uint32_t job_index) {
+            FlattenJob const &job = jobs[job_index];
+            flatten(job.mesh, job.first, job.first + kFlattenJobSize);
+        },
+        (uint32_t)jobs.size(), 1);
+}
+} // namespace Capsaicin
@@ -0,0 +1,85 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "capsaicin_internal.h"
+#include "hash_reduce.h"
+
+namespace std
+{
+template<>
+struct hash<GfxMesh>
+{
+    inline size_t operator()(GfxMesh const &value) const
+    {
+        size_t hash = 0x12345678u;
+
+        Capsaicin::HashCombine(hash, value.bounds_min);
+        Capsaicin::HashCombine(hash, value.bounds_max);
+        Capsaicin::HashCombine(hash, value.vertices.size());
+        Capsaicin::HashCombine(hash, value.indices.size());
+        // Include the contents so that deformations that keep the bounds unchanged are still detected
+        Capsaicin::HashCombine(hash,
+            std::string_view(reinterpret_cast<char const *>(value.vertices.data()),
+                value.vertices.size() * sizeof(GfxVertex)));
+        Capsaicin::HashCombine(hash,
+            std::string_view(reinterpret_cast<char const *>(value.indices.data()),
+                value.indices.size() * sizeof(uint32_t)));
+
+        return hash;
+    }
+};
+
+template<>
+struct hash<GfxInstance>
+{
+    inline size_t operator()(GfxInstance const &value) const
+    {
+        size_t hash = 0x12345678u;
+
+        Capsaicin::HashCombine(hash, (uint64_t)value.mesh);
+        Capsaicin::HashCombine(hash, (uint64_t)value.material);
+        Capsaicin::HashCombine(hash, value.transform);
+
+        return hash;
+    }
+};
+
+template<>
+struct hash<GfxLight>
+{
+    inline size_t operator()(GfxLight const &value) const
+    {
+        size_t hash = 0x12345678u;
+
+        Capsaicin::HashCombine(hash, value.color);
+        Capsaicin::HashCombine(hash, value.intensity);
+        Capsaicin::HashCombine(hash, value.position);
+        Capsaicin::HashCombine(hash, value.direction);
+        Capsaicin::HashCombine(hash, value.range);
+        Capsaicin::HashCombine(hash, value.inner_cone_angle);
+        Capsaicin::HashCombine(hash, value.outer_cone_angle);
+
+        return hash;
+    }
+};
+} // namespace std
@@ -23,6 +23,7 @@ THE SOFTWARE.
 
 #include <algorithm>
 #include <array>
+#include <limits>
 #include <string>
 #include <string_view>
 
@@ -519,34 +520,45 @@ consteval StaticString<Size - 1> toStaticString(char const (&other)[Size]) noexc
 }
 
 /**
- * Gets the readable name for a specified type.
- * @tparam T Generic type parameter.
- * @returns The type name string.
+ * Gets the signature of a function templated on a specified type, from which the type name is retrieved.
+ * A function template is used rather than a templated lambda as GCC leaves the size of the signature unknown in the
+ * latter.
+ * @tparam T2 Generic type parameter.
+ * @returns The function signature string.
  */
-template<typename T>
-constexpr auto toStaticString() noexcept
+template<typename T2>
+consteval auto getFunctionName() noexcept
 {
-    constexpr auto getFunctionName = []<typename T2>() noexcept {
 #if defined(__clang__) || defined(__GNUC__)
-        return toStaticString(__PRETTY_FUNCTION__);
+    return toStaticString(__PRETTY_FUNCTION__);
 #elif defined(_MSC_VER)
-        return toStaticString(__FUNCSIG__);
+    return toStaticString(__FUNCSIG__);
 #else
 #    error Unsupported compiler
 #endif
-    };
+}
+
+/**
+ * Gets the readable name for a specified type.
+ * @tparam T Generic type parameter.
+ * @returns The type name string.
+ */
+template<typename T>
+constexpr auto toStaticString() noexcept
+{
     // Sentinel information used to retrieve type name from output of getFunctionName
     // Uses a known type 'float' to interrogate function name string
-    constexpr auto sentinelString = getFunctionName.template operator()<float>();
+    constexpr auto sentinelString = getFunctionName<float>();
     constexpr auto                                           floatString = toStaticString("float");
     constexpr auto                                           startOffset = sentinelString.rfind(floatString);
     constexpr auto endOffset = sentinelString.size() - startOffset - floatString.size();
 
     // Split the type name out from the function name
-    constexpr auto const function                                = getFunctionName.template operator()<T>();
+    constexpr auto const function                                = getFunctionName<T>();
     constexpr size_t                                         end = function.size() - endOffset;
     constexpr auto                                           it2 = function.rfind(':');
-    constexpr size_t   startOffset2 = (it2 < function.size() - 2) ? it2 + 1 : startOffset;
+    // Only strip the namespaces of the type itself, GCC omits those shared with the function
+    constexpr size_t   startOffset2 = (it2 >= startOffset && it2 < function.size() - 2) ? it2 + 1 : startOffset;
     constexpr auto     size         = end - startOffset2;
     StaticString<size> buffer;
     char              *dest   = buffer.data();
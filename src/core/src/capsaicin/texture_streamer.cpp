@@ -0,0 +1,328 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "texture_streamer.h"
+
+#include "gfx_recorder.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint64_t kStagingAlignment = 512; /**< Alignment of texture data placed in the staging ring */
+constexpr uint32_t kMaxWorkerThreads = 4;   /**< Maximum number of threads generating mip chains */
+
+/**
+ * Get the mip generator format matching an image.
+ * @param       image  The image.
+ * @param [out] format The matching format.
+ * @returns True if the image format is supported by the mip generator.
+ */
+bool GetMipFormat(GfxImage const &image, MipFormat &format) noexcept
+{
+    switch (image.format)
+    {
+    case DXGI_FORMAT_R8_UNORM:
+    case DXGI_FORMAT_R8G8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM: format = MipFormat::Unorm8; break;
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB: format = MipFormat::Unorm8Srgb; break;
+    case DXGI_FORMAT_R16_UNORM:
+    case DXGI_FORMAT_R16G16_UNORM:
+    case DXGI_FORMAT_R16G16B16A16_UNORM: format = MipFormat::Unorm16; break;
+    case DXGI_FORMAT_R32_FLOAT:
+    case DXGI_FORMAT_R32G32_FLOAT:
+    case DXGI_FORMAT_R32G32B32A32_FLOAT: format = MipFormat::Float32; break;
+    default: return false;
+    }
+    uint32_t const channel_size = format == MipFormat::Float32 ? 4 : (format == MipFormat::Unorm16 ? 2 : 1);
+    return image.bytes_per_channel == channel_size
+        && (image.channel_count == 1 || image.channel_count == 2 || image.channel_count == 4);
+}
+} // unnamed namespace
+
+bool TextureStreamer::initialize(GfxContext gfx, uint64_t upload_budget, MipFilter filter) noexcept
+{
+    terminate();
+
+    // The ring must hold every upload still in flight on the GPU plus the current frame's uploads
+    uint64_t const ring_size = GFX_ALIGN(upload_budget * (gfxGetBackBufferCount(gfx) + 1), kStagingAlignment);
+    staging_ring_            = gfxCreateBuffer(gfx, ring_size, nullptr, kGfxCpuAccess_Write);
+    if (!staging_ring_)
+    {
+        return false;
+    }
+    staging_ring_.setName("Capsaicin_TextureStagingRing");
+
+    gfx_           = gfx;
+    upload_budget_ = upload_budget;
+    filter_        = filter;
+    frame_index_   = 0;
+    terminate_     = false;
+
+    uint32_t const worker_count =
+        std::clamp(std::thread::hardware_concurrency() / 2, 1u, kMaxWorkerThreads);
+    for (uint32_t i = 0; i < worker_count; ++i)
+    {
+        workers_.emplace_back(&TextureStreamer::worker, this);
+    }
+    return true;
+}
+
+void TextureStreamer::terminate() noexcept
+{
+    if (!isInitialized())
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        terminate_ = true;
+    }
+    signal_.notify_all();
+    for (std::thread &worker : workers_)
+    {
+        worker.join();
+    }
+    workers_.clear();
+
+    cancelAll();
+    gfxDestroyBuffer(gfx_, staging_ring_);
+    staging_ring_ = {};
+    ring_allocations_.clear();
+}
+
+bool TextureStreamer::IsSupported(GfxImage const &image) noexcept
+{
+    MipFormat format;
+    return image.width > 0 && image.height > 0 && (image.flags & kGfxImageFlag_HasMipLevels) == 0
+        && !gfxImageIsFormatCompressed(image) && GetMipFormat(image, format)
+        && image.data.size() >= (uint64_t)image.width * image.height * image.channel_count * image.bytes_per_channel;
+}
+
+void TextureStreamer::request(uint32_t image_index, GfxTexture const &texture, GfxImage const &image) noexcept
+{
+    auto job           = std::make_shared<Job>();
+    job->image_index   = image_index;
+    job->texture       = texture;
+    job->width         = image.width;
+    job->height        = image.height;
+    job->channel_count = image.channel_count;
+    GetMipFormat(image, job->format);
+    job->data.assign(image.data.data(),
+        image.data.data() + (size_t)image.width * image.height * image.channel_count * image.bytes_per_channel);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(std::move(job));
+    }
+    signal_.notify_one();
+}
+
+void TextureStreamer::cancel(uint32_t image_index) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = jobs_.begin(); it != jobs_.end(); ++it)
+    {
+        if ((*it)->image_index == image_index)
+        {
+            // A job being processed is released by its worker once done
+            (*it)->state = JobState::Cancelled;
+            gfxDestroyTexture(gfx_, (*it)->texture);
+            jobs_.erase(it);
+            break;
+        }
+    }
+}
+
+void TextureStreamer::cancelAll() noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto const &job : jobs_)
+    {
+        job->state = JobState::Cancelled;
+        gfxDestroyTexture(gfx_, job->texture);
+    }
+    jobs_.clear();
+}
+
+uint64_t TextureStreamer::update(std::vector<std::pair<uint32_t, GfxTexture>> &completed) noexcept
+{
+    completed.clear();
+    if (!isInitialized())
+    {
+        return 0;
+    }
+
+    // Release the staging ranges the GPU is done with
+    ++frame_index_;
+    uint64_t const frames_in_flight = gfxGetBackBufferCount(gfx_);
+    while (!ring_allocations_.empty() && frame_index_ - ring_allocations_.front().frame_index > frames_in_flight)
+    {
+        ring_allocations_.pop_front();
+    }
+
+    // Pick the ready jobs in request order until the budget or the ring is exhausted
+    std::vector<std::pair<std::shared_ptr<Job>, uint64_t>> uploads;
+    uint64_t                                               upload_size = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = jobs_.begin(); it != jobs_.end();)
+        {
+            Job const &job = **it;
+            if (job.state != JobState::Ready)
+            {
+                ++it;
+                continue;
+            }
+            uint64_t const size = job.data.size();
+            if (upload_size > 0 && upload_size + size > upload_budget_)
+            {
+                break; // always upload at least one texture per frame so large textures still make progress
+            }
+            uint64_t offset = UINT64_MAX;
+            if (size <= staging_ring_.getSize() && !allocateStaging(size, offset))
+            {
+                break; // wait for the GPU to release some of the ring
+            }
+            uploads.emplace_back(*it, offset);
+            upload_size += size;
+            it = jobs_.erase(it);
+        }
+    }
+
+    // Copy the mip chains into the ring and record the uploads
+    uint8_t *ring_data = (uint8_t *)gfxBufferGetData(gfx_, staging_ring_);
+    for (auto const &[job, offset] : uploads)
+    {
+        GfxBuffer staging_buffer;
+        if (offset != UINT64_MAX)
+        {
+            memcpy(ring_data + offset, job->data.data(), job->data.size());
+            staging_buffer = gfxCreateBufferRange(gfx_, staging_ring_, offset, job->data.size());
+        }
+        else
+        {
+            // Texture is larger than the whole ring so gets its own staging buffer
+            staging_buffer = gfxCreateBuffer(gfx_, job->data.size(), job->data.data(), kGfxCpuAccess_Write);
+        }
+        gfxCommandCopyBufferToTexture(gfx_, job->texture, staging_buffer);
+        if (!job->has_mips)
+        {
+            gfxCommandGenerateMips(gfx_, job->texture); // only the top level could be uploaded
+        }
+        gfxDestroyBuffer(gfx_, staging_buffer);
+        completed.emplace_back(job->image_index, job->texture);
+    }
+
+    return upload_size;
+}
+
+uint32_t TextureStreamer::getPendingCount() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return (uint32_t)jobs_.size();
+}
+
+void TextureStreamer::worker() noexcept
+{
+    for (;;)
+    {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            signal_.wait(lock, [&] {
+                return terminate_ || std::any_of(jobs_.begin(), jobs_.end(), [](auto const &queued_job) {
+                    return queued_job->state == JobState::Queued;
+                });
+            });
+            if (terminate_)
+            {
+                return;
+            }
+            job = *std::find_if(jobs_.begin(), jobs_.end(),
+                [](auto const &queued_job) { return queued_job->state == JobState::Queued; });
+            job->state = JobState::Processing;
+        }
+
+        // The job owns a copy of the source texels so is safe to process without holding the lock
+        std::vector<uint8_t> mips;
+        bool const           result =
+            GenerateMipChain(mips, job->data.data(), job->width, job->height, job->channel_count, job->format, filter_);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (job->state == JobState::Cancelled)
+        {
+            continue; // texture was already released by cancel()
+        }
+        if (result)
+        {
+            job->data.swap(mips);
+        }
+        job->has_mips = result;
+        job->state    = JobState::Ready;
+    }
+}
+
+bool TextureStreamer::allocateStaging(uint64_t size, uint64_t &offset) noexcept
+{
+    size                     = GFX_ALIGN(size, kStagingAlignment);
+    uint64_t const ring_size = staging_ring_.getSize();
+    if (ring_allocations_.empty())
+    {
+        offset = 0;
+    }
+    else
+    {
+        // The head never catches up with the tail so that a full ring is distinguishable from an empty one
+        uint64_t const tail = ring_allocations_.front().begin;
+        uint64_t const head = ring_allocations_.back().end;
+        if (head > tail)
+        {
+            if (ring_size - head >= size)
+            {
+                offset = head;
+            }
+            else if (tail > size)
+            {
+                offset = 0; // wrap around
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else if (tail - head > size)
+        {
+            offset = head;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    ring_allocations_.push_back({frame_index_, offset, offset + size});
+    return true;
+}
+} // namespace Capsaicin
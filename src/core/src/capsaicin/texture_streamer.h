@@ -0,0 +1,161 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "mip_generator.h"
+
+#include <condition_variable>
+#include <deque>
+#include <gfx_scene.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Uploads scene textures asynchronously.
+ * Mip chains are generated on background worker threads and uploaded through a fixed-size staging ring, the
+ * amount of data uploaded each frame is limited by a budget so that loading a scene does not stall rendering.
+ */
+class TextureStreamer
+{
+public:
+    TextureStreamer() noexcept = default;
+    ~TextureStreamer() noexcept { terminate(); }
+
+    TextureStreamer(TextureStreamer const &)            = delete;
+    TextureStreamer &operator=(TextureStreamer const &) = delete;
+
+    /**
+     * Start the worker threads and create the staging ring.
+     * @param gfx           Active gfx context.
+     * @param upload_budget Maximum number of bytes uploaded per frame.
+     * @param filter        The filter used to generate mip levels.
+     * @returns True if succeeded, False otherwise.
+     */
+    bool initialize(GfxContext gfx, uint64_t upload_budget, MipFilter filter) noexcept;
+
+    /**
+     * Stop the worker threads and release all pending uploads.
+     */
+    void terminate() noexcept;
+
+    /**
+     * Check whether the streamer has been initialised.
+     * @returns True if initialised.
+     */
+    bool isInitialized() const noexcept { return !workers_.empty(); }
+
+    /**
+     * Check whether an image can be streamed, other images must be uploaded directly.
+     * @param image The image to check.
+     * @returns True if the image format is supported.
+     */
+    static bool IsSupported(GfxImage const &image) noexcept;
+
+    /**
+     * Queue the upload of an image.
+     * @note The image contents are copied so the image may be modified or released straight away.
+     * @param image_index The index identifying the image.
+     * @param texture     The texture to upload to (must have a full mip chain), owned by the streamer until the
+     *                    upload completes.
+     * @param image       The image to upload.
+     */
+    void request(uint32_t image_index, GfxTexture const &texture, GfxImage const &image) noexcept;
+
+    /**
+     * Cancel the pending upload of an image (if any) and release its texture.
+     * @param image_index The index identifying the image.
+     */
+    void cancel(uint32_t image_index) noexcept;
+
+    /**
+     * Cancel all pending uploads and release their textures.
+     */
+    void cancelAll() noexcept;
+
+    /**
+     * Record the upload of the mip chains generated so far, within the per-frame budget.
+     * Must be called once per frame.
+     * @param [out] completed The images whose upload was recorded this frame, along with their texture.
+     * @returns The number of bytes uploaded.
+     */
+    uint64_t update(std::vector<std::pair<uint32_t, GfxTexture>> &completed) noexcept;
+
+    /**
+     * Gets the number of images that have not been uploaded yet.
+     * @returns The pending image count.
+     */
+    uint32_t getPendingCount() const noexcept;
+
+private:
+    /** State of a queued image upload. */
+    enum class JobState : uint32_t
+    {
+        Queued = 0, /**< Waiting for a worker thread */
+        Processing, /**< Mip chain is being generated */
+        Ready,      /**< Mip chain is ready for upload */
+        Cancelled,  /**< Upload was cancelled while being processed */
+    };
+
+    /** A queued image upload. */
+    struct Job
+    {
+        uint32_t             image_index   = 0;                 /**< The index identifying the image */
+        GfxTexture           texture;                           /**< The texture to upload to */
+        std::vector<uint8_t> data;          /**< The top level texels, then the generated mip chain */
+        uint32_t             width         = 0;                 /**< The width of the top level */
+        uint32_t             height        = 0;                 /**< The height of the top level */
+        uint32_t             channel_count = 0;                 /**< Number of channels per texel */
+        MipFormat            format        = MipFormat::Unorm8; /**< The channel format */
+        JobState             state         = JobState::Queued;  /**< The job progress */
+        bool                 has_mips      = false;             /**< Whether data holds the full mip chain */
+    };
+
+    /** A range of the staging ring in use by the GPU. */
+    struct RingAllocation
+    {
+        uint64_t frame_index; /**< The frame the range was written */
+        uint64_t begin;       /**< The start of the range (in bytes) */
+        uint64_t end;         /**< The end of the range (in bytes) */
+    };
+
+    void worker() noexcept;
+    bool allocateStaging(uint64_t size, uint64_t &offset) noexcept;
+
+    GfxContext gfx_;                            /**< The gfx context used for uploads */
+    uint64_t   upload_budget_ = 0;              /**< Maximum number of bytes uploaded per frame */
+    MipFilter  filter_        = MipFilter::Box; /**< The filter used to generate mip levels */
+
+    GfxBuffer                  staging_ring_;     /**< Upload buffer all mip chains are copied through */
+    std::deque<RingAllocation> ring_allocations_; /**< Ranges of the ring in use, oldest first */
+    uint64_t                   frame_index_ = 0;  /**< Number of calls to update() */
+
+    mutable std::mutex               mutex_;             /**< Protects the job queue */
+    std::condition_variable          signal_;            /**< Signals queued jobs and termination to workers */
+    std::deque<std::shared_ptr<Job>> jobs_;              /**< Pending jobs in request order */
+    std::vector<std::thread>         workers_;           /**< The worker threads generating mip chains */
+    bool                             terminate_ = false; /**< Whether the worker threads must exit */
+};
+} // namespace Capsaicin
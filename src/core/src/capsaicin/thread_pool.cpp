@@ -21,92 +21,320 @@ THE SOFTWARE.
 ********************************************************************/
 #include "thread_pool.h"
 
+#include "cpu_profiler.h"
+
+#ifdef _WIN32
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <pthread.h>
+#endif
+
 namespace Capsaicin
 {
-bool                  ThreadPool::terminate_;
-uint32_t              ThreadPool::thread_count_;
-uint32_t              ThreadPool::count_;
-uint32_t              ThreadPool::block_size_;
-uint32_t              ThreadPool::block_count_;
-std::atomic<uint32_t> ThreadPool::block_index_;
-
-std::mutex                              ThreadPool::mutex_;
-std::condition_variable                 ThreadPool::sync_;
-std::condition_variable                 ThreadPool::signal_;
-std::unique_ptr<ThreadPool::KernelBase> ThreadPool::kernel_;
-std::vector<std::thread>                ThreadPool::threads_;
+namespace
+{
+/** Number of times an idle thread looks for tasks before going to sleep */
+constexpr uint32_t kSpinCount = 64;
 
-uint32_t ThreadPool::GetThreadCount()
+/** Index of the queue owned by the current thread (threads other than the workers share the last queue) */
+thread_local uint32_t g_queue_index = UINT32_MAX;
+
+void PinThread(std::thread &thread, uint32_t processor)
 {
-    return (uint32_t)threads_.size();
+#ifdef _WIN32
+    if (processor < 64)
+    {
+        SetThreadAffinityMask(thread.native_handle(), (DWORD_PTR)1 << processor);
+    }
+#else
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(processor, &cpu_set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set);
+#endif
 }
+} // unnamed namespace
 
-bool ThreadPool::Create(uint32_t thread_count)
+/** A queued unit of work. */
+class ThreadPool::Task
 {
-    terminate_ = false;
+public:
+    std::function<void()>   function_;                 /**< The work to be done (released once run) */
+    std::atomic<uint32_t>   dependency_count_ = 0;     /**< Dependencies left before the task can be queued */
+    std::atomic<bool>       done_             = false; /**< Set once the task has completed */
+    std::mutex              mutex_;                    /**< Guards the continuations */
+    std::vector<TaskHandle> continuations_;            /**< Tasks waiting for this task to complete */
+};
 
-    thread_count_ = 0;
+std::atomic<bool>     ThreadPool::terminate_;
+std::atomic<uint32_t> ThreadPool::queued_count_;
+std::atomic<uint32_t> ThreadPool::sleeping_count_;
+std::atomic<uint32_t> ThreadPool::thread_count_ = 1;
 
-    thread_count = (std::max(thread_count, 1u) + 1u) & ~1u;
+std::shared_mutex                               ThreadPool::lifetime_mutex_;
+std::mutex                                      ThreadPool::mutex_;
+std::condition_variable                         ThreadPool::signal_;
+std::vector<std::unique_ptr<ThreadPool::Queue>> ThreadPool::queues_;
+std::vector<std::thread>                        ThreadPool::threads_;
 
-    threads_.reserve(thread_count);
+ThreadPool::TaskHandle ThreadPool::Submit(std::function<void()> function, std::vector<TaskHandle> const &dependencies)
+{
+    auto task       = std::make_shared<Task>();
+    task->function_ = std::move(function);
 
-    // Spawn requested number of threads
-    for (size_t i = 0; i < threads_.capacity(); ++i)
+    // The extra dependency is released once the continuations are registered so that the task can't be queued by
+    // a dependency completing in the meantime
+    task->dependency_count_ = (uint32_t)dependencies.size() + 1;
+    for (TaskHandle const &dependency : dependencies)
     {
-        threads_.push_back(std::thread(Worker));
+        bool pending;
+        {
+            std::lock_guard<std::mutex> lock(dependency->mutex_);
+            pending = !dependency->done_.load(std::memory_order_acquire);
+            if (pending)
+            {
+                dependency->continuations_.push_back(task);
+            }
+        }
+        if (!pending)
+        {
+            task->dependency_count_.fetch_sub(1, std::memory_order_acq_rel);
+        }
     }
+    Release(task);
+    return task;
+}
 
-    // Wait for all threads to have started
-    for (;;)
+void ThreadPool::Wait(TaskHandle const &task)
+{
+    uint32_t spin_count = 0;
+    while (!task->done_.load(std::memory_order_acquire))
     {
-        std::unique_lock<std::mutex> lock(mutex_);
-        if (thread_count_ == threads_.size()) break; // all threads have started
-        sync_.wait(lock);
+        if (TaskHandle const queued_task = Pop())
+        {
+            Run(queued_task);
+            spin_count = 0;
+        }
+        else if (++spin_count < kSpinCount)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            // Nothing left to help with, the task is running on another thread
+            task->done_.wait(false, std::memory_order_acquire);
+        }
     }
+}
 
-    return true;
+bool ThreadPool::IsDone(TaskHandle const &task)
+{
+    return task->done_.load(std::memory_order_acquire);
 }
 
-void ThreadPool::Destroy()
+uint32_t ThreadPool::GetThreadCount()
+{
+    return thread_count_.load(std::memory_order_relaxed);
+}
+
+bool ThreadPool::Create(uint32_t thread_count, bool pin_threads)
 {
-    terminate_ = true;
+    Destroy();
 
-    // Wait for all threads to have completed
-    if (threads_.size() > 0)
+    // Other threads may be submitting tasks, they wait for the new queues (the new workers too until all of them
+    // have been started)
+    std::unique_lock<std::shared_mutex> lifetime_lock(lifetime_mutex_);
+    terminate_ = false;
+
+    // The calling thread runs tasks too
+    uint32_t const worker_count = std::max(thread_count, 1u) - 1;
+    for (uint32_t i = 0; i <= worker_count; ++i)
     {
-        signal_.notify_all();
+        queues_.push_back(std::make_unique<Queue>());
+    }
 
-        for (size_t i = 0; i < threads_.size(); ++i)
+    // Spawn requested number of threads, the first processor is left to the calling thread when pinning
+    uint32_t const processor_count = std::max(std::thread::hardware_concurrency(), 1u);
+    threads_.reserve(worker_count);
+    for (uint32_t i = 0; i < worker_count; ++i)
+    {
+        threads_.push_back(std::thread(Worker, i));
+        if (pin_threads)
         {
-            threads_[i].join();
+            PinThread(threads_.back(), (i + 1) % processor_count);
         }
     }
+    thread_count_ = worker_count + 1;
+
+    return true;
+}
+
+void ThreadPool::Destroy()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        terminate_ = true;
+    }
+    signal_.notify_all();
 
-    threads_.resize(0);
+    // Wait for all threads to have completed, workers only return once the queues are empty
+    for (size_t i = 0; i < threads_.size(); ++i)
+    {
+        threads_[i].join();
+    }
 
-    thread_count_ = 0;
+    // Workers leave nothing behind but other threads may still be submitting tasks, these are run here until the
+    // queues are released (tasks submitted afterwards run in place)
+    for (;;)
+    {
+        while (TaskHandle const task = Pop())
+        {
+            Run(task);
+        }
+        std::unique_lock<std::shared_mutex> lifetime_lock(lifetime_mutex_);
+        if (queued_count_.load() == 0)
+        {
+            threads_.clear();
+            queues_.clear();
+            thread_count_ = 1;
+            break;
+        }
+    }
 }
 
-void ThreadPool::Worker()
+void ThreadPool::Worker(uint32_t index)
 {
+    g_queue_index = index;
+    CpuProfiler::SetThreadName("ThreadPool");
+
+    uint32_t spin_count = 0;
     for (;;)
     {
-        // Put the thread to sleep until some blocks need processing
+        if (TaskHandle const task = Pop())
+        {
+            CAPSAICIN_PROFILE_SCOPE("ThreadPool::Task");
+            Run(task);
+            spin_count = 0;
+        }
+        else if (terminate_.load(std::memory_order_relaxed))
         {
+            break; // were we woken up to kill ourselves?
+        }
+        else if (++spin_count < kSpinCount)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            // Put the thread to sleep until some tasks are queued
             std::unique_lock<std::mutex> lock(mutex_);
-            if (++thread_count_ == threads_.capacity())
-                sync_.notify_one(); // all threads are back to the pool
-            signal_.wait(lock);
+            ++sleeping_count_;
+            signal_.wait(lock, [] { return terminate_ || queued_count_ > 0; });
+            --sleeping_count_;
+            spin_count = 0;
+        }
+    }
+}
+
+void ThreadPool::Schedule(TaskHandle const &task)
+{
+    {
+        std::shared_lock<std::shared_mutex> lifetime_lock(lifetime_mutex_);
+        if (threads_.empty())
+        {
+            lifetime_lock.unlock();
+            Run(task); // no workers, run in place
+            return;
         }
 
-        // Were we woken up to kill ourselves?
-        if (terminate_) { break; }
+        Queue &queue = *queues_[std::min(g_queue_index, (uint32_t)threads_.size())];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(task);
+        }
+        queued_count_.fetch_add(1);
+    }
 
-        // Process all the available blocks
+    // Sleeping workers register before checking the queued count, so either they see the task or they are woken up
+    if (sleeping_count_.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+        signal_.notify_one();
+    }
+}
+
+void ThreadPool::Release(TaskHandle const &task)
+{
+    if (task->dependency_count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        Schedule(task);
+    }
+}
+
+void ThreadPool::Run(TaskHandle const &task)
+{
+    task->function_();
+    task->function_ = nullptr; // release anything captured
+
+    std::vector<TaskHandle> continuations;
+    {
+        std::lock_guard<std::mutex> lock(task->mutex_);
+        task->done_.store(true, std::memory_order_release);
+        continuations.swap(task->continuations_);
+    }
+    task->done_.notify_all();
+
+    for (TaskHandle const &continuation : continuations)
+    {
+        Release(continuation);
+    }
+}
+
+ThreadPool::TaskHandle ThreadPool::Pop()
+{
+    if (queued_count_.load(std::memory_order_acquire) == 0)
+    {
+        return nullptr;
+    }
+
+    // Take the most recent task of our own queue first (its data is likely still in cache), then steal the oldest
+    // task of the other queues
+    std::shared_lock<std::shared_mutex> lifetime_lock(lifetime_mutex_);
+    uint32_t const                      queue_count = (uint32_t)queues_.size();
+    if (queue_count == 0)
+    {
+        return nullptr;
+    }
+    uint32_t const own_queue = std::min(g_queue_index, queue_count - 1);
+    for (uint32_t i = 0; i < queue_count; ++i)
+    {
+        Queue                      &queue = *queues_[(own_queue + i) % queue_count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
         {
-            kernel_->Run();
+            TaskHandle task;
+            if (i == 0)
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            queued_count_.fetch_sub(1);
+            return task;
         }
     }
+    return nullptr;
 }
 } // namespace Capsaicin
@@ -23,124 +23,188 @@ THE SOFTWARE.
 
 #include <algorithm>
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <thread>
 #include <vector>
 
 namespace Capsaicin
 {
+/**
+ * Work-stealing task scheduler used for the CPU side work of Capsaicin.
+ * Each worker owns a deque of tasks, it pushes and pops tasks at the back while idle workers steal the oldest tasks
+ * from the front. Threads waiting for a task (including the calling thread) run queued tasks in the meantime, so that
+ * parallel loops can be nested and several subsystems can have tasks in flight at the same time.
+ * The pool may be re-sized (see Create()) while other threads submit tasks, no queued task is ever dropped.
+ */
 class ThreadPool
 {
 public:
+    class Task;
+    using TaskHandle = std::shared_ptr<Task>; /**< Handle used to wait for a task or to add continuations */
+
     inline ThreadPool() {}
 
+    /**
+     * Run a kernel for each index in [0, count) and wait for completion (see ParallelFor()).
+     * @param kernel     The kernel, called with the index of each invocation.
+     * @param count      The number of kernel invocations.
+     * @param block_size The number of consecutive invocations claimed at once by a thread.
+     */
     template<typename KERNEL>
     void Dispatch(KERNEL const &kernel, uint32_t count, uint32_t block_size = 16) const
     {
-        // Set dispatch properties
-        count_       = count;
-        block_size_  = std::max(block_size, 1u);
-        block_count_ = (count_ + block_size_ - 1) / block_size_;
+        ParallelFor(count, kernel, block_size);
+    }
+
+    /**
+     * Run a kernel for each index in [0, count) on the workers and the calling thread and wait for completion.
+     * Blocks of consecutive indices are claimed dynamically so that uneven kernels stay balanced.
+     * @param count      The number of kernel invocations.
+     * @param kernel     The kernel, called with the index of each invocation.
+     * @param grain_size The number of consecutive invocations claimed at once (0 to derive it from the thread count).
+     */
+    template<typename KERNEL>
+    static void ParallelFor(uint32_t count, KERNEL const &kernel, uint32_t grain_size = 0)
+    {
+        uint32_t const thread_count = GetThreadCount();
+        if (grain_size == 0)
+        {
+            grain_size = std::max(count / (thread_count * kBlocksPerThread), 1u);
+        }
+        uint32_t const block_count = count / grain_size + (count % grain_size != 0 ? 1 : 0);
 
-        // Special case - only 1 block? no need to go wide
-        if (block_count_ <= 1)
+        // Special case - only 1 block or thread? no need to go wide
+        if (block_count <= 1 || thread_count <= 1)
         {
             for (uint32_t i = 0; i < count; ++i)
             {
                 kernel(i);
             }
+            return;
         }
-        else
-        {
-            // Install the kernel
-            block_index_ = 0;
-            kernel_      = std::make_unique<Kernel<KERNEL>>(kernel);
-
-            // And dispatch
-            thread_count_ = 0; // consume all threads from the pool
-            signal_.notify_all();
 
-            // Wait until all threads have returned to the pool
+        std::atomic<uint32_t> block_index = 0;
+        auto const            run_blocks  = [&]() {
             for (;;)
             {
-                std::unique_lock<std::mutex> lock(mutex_);
-                if (thread_count_ == threads_.size()) break; // all threads have completed
-                sync_.wait(lock);
+                uint32_t const block = block_index.fetch_add(1, std::memory_order_relaxed);
+                if (block >= block_count)
+                {
+                    break; // everything has been processed
+                }
+                uint32_t const begin = block * grain_size;
+                uint32_t const end   = (uint32_t)std::min((uint64_t)begin + grain_size, (uint64_t)count);
+                for (uint32_t index = begin; index < end; ++index)
+                {
+                    kernel(index); // run the kernel
+                }
             }
-
-            // Release kernel
-            kernel_.reset();
+        };
+
+        // Fork helpers for the other threads, the calling thread processes blocks until none are left and then
+        // joins (helpers that start late find no block left and return straight away)
+        uint32_t const          helper_count = std::min(thread_count, block_count) - 1;
+        std::vector<TaskHandle> helpers;
+        helpers.reserve(helper_count);
+        for (uint32_t i = 0; i < helper_count; ++i)
+        {
+            helpers.push_back(Submit([&run_blocks]() { run_blocks(); }));
+        }
+        run_blocks();
+        for (TaskHandle const &helper : helpers)
+        {
+            Wait(helper);
         }
     }
 
+    /**
+     * Queue a task, it runs once all its dependencies have completed.
+     * @param function     The work to be done.
+     * @param dependencies Tasks that must complete first (the new task is their continuation).
+     * @returns The handle of the new task.
+     */
+    static TaskHandle Submit(std::function<void()> function, std::vector<TaskHandle> const &dependencies = {});
+
+    /**
+     * Queue a continuation of a task.
+     * @param task     The task to continue.
+     * @param function The work to be done once the task has completed.
+     * @returns The handle of the new task.
+     */
+    static TaskHandle Then(TaskHandle const &task, std::function<void()> function)
+    {
+        return Submit(std::move(function), {task});
+    }
+
+    /**
+     * Wait for a task to complete, running queued tasks in the meantime.
+     * @param task The task to wait for.
+     */
+    static void Wait(TaskHandle const &task);
+
+    /**
+     * Check whether a task has completed.
+     * @param task The task to check.
+     * @returns True if completed.
+     */
+    static bool IsDone(TaskHandle const &task);
+
+    /**
+     * Gets the number of threads running tasks, the workers plus the calling thread (which runs tasks while it
+     * waits). Unlike the former barrier pool, which only counted its workers, this is the thread count requested
+     * from Create() and it is at least 1, so callers can split work into GetThreadCount() chunks.
+     * @returns The thread count.
+     */
     static uint32_t GetThreadCount();
 
-    static bool Create(uint32_t thread_count);
+    /**
+     * Start the workers, any previous workers are stopped first.
+     * Queued tasks are run before the previous workers are released, tasks submitted in the meantime by other
+     * threads are run in place or queued to the new workers.
+     * @param thread_count The number of threads running tasks including the calling thread (e.g., the number of
+     *                     hardware threads).
+     * @param pin_threads  True to run each worker on its own logical processor.
+     * @returns True if succeeded, False otherwise.
+     */
+    static bool Create(uint32_t thread_count, bool pin_threads = false);
+
+    /**
+     * Run any queued task and stop the workers, tasks submitted afterwards run on the submitting thread.
+     */
     static void Destroy();
 
 protected:
-    class KernelBase
-    {
-        KernelBase(KernelBase const &)            = delete;
-        KernelBase &operator=(KernelBase const &) = delete;
-
-    public:
-        inline KernelBase() {}
+    /** Number of blocks a parallel loop is split into per thread when no grain size is given */
+    static constexpr uint32_t kBlocksPerThread = 4;
 
-        inline virtual ~KernelBase() {}
-
-        inline virtual void Run() = 0 {}
-    };
-
-    template<typename KERNEL>
-    class Kernel : public KernelBase
+    /** The tasks queued by a thread. */
+    struct Queue
     {
-    public:
-        Kernel(KERNEL const &kernel)
-            : kernel_(kernel)
-        {}
-
-        void Run() override
-        {
-            for (;;)
-            {
-                uint32_t const block_index = block_index_++;
-
-                if (block_index >= block_count_)
-                {
-                    break; // everything has been processed
-                }
-
-                uint32_t const begin = block_index * block_size_;
-
-                uint32_t const end = std::min((block_index + 1) * block_size_, count_);
-
-                for (uint32_t index = begin; index < end; ++index)
-                {
-                    kernel_(index); // run the kernel
-                }
-            }
-        }
-
-    protected:
-        KERNEL const &kernel_; /**< The kernel to be executed.*/
+        std::mutex             mutex; /**< Guards the tasks */
+        std::deque<TaskHandle> tasks; /**< Queued tasks, oldest first */
     };
 
-    static void Worker();
-
-    static bool                  terminate_;    /**< Whether to terminate the threads. */
-    static uint32_t              thread_count_; /**< The number of available threads. */
-    static uint32_t              count_;        /**< The number of kernel invocations. */
-    static uint32_t              block_size_;   /**< The size of a block. */
-    static uint32_t              block_count_;  /**< The number of available blocks. */
-    static std::atomic<uint32_t> block_index_;  /**< The index of the currently executed block. */
-
-    static std::mutex                  mutex_;   /**< The mutex for synchronization. */
-    static std::condition_variable     sync_;    /**< The condition variable for synchronizing. */
-    static std::condition_variable     signal_;  /**< The condition variable for signalling. */
-    static std::unique_ptr<KernelBase> kernel_;  /**< The kernel scheduled for execution. */
-    static std::vector<std::thread>    threads_; /**< The available CPU threads. */
+    static void       Worker(uint32_t index);
+    static void       Schedule(TaskHandle const &task);
+    static void       Release(TaskHandle const &task);
+    static void       Run(TaskHandle const &task);
+    static TaskHandle Pop();
+
+    static std::atomic<bool>     terminate_;      /**< Whether to terminate the threads. */
+    static std::atomic<uint32_t> queued_count_;   /**< The number of tasks waiting in the queues. */
+    static std::atomic<uint32_t> sleeping_count_; /**< The number of workers waiting for tasks. */
+    static std::atomic<uint32_t> thread_count_;   /**< The number of threads running tasks. */
+
+    static std::shared_mutex                   lifetime_mutex_; /**< Guards the queues and threads from re-sizing. */
+    static std::mutex                          mutex_;          /**< The mutex for synchronization. */
+    static std::condition_variable             signal_;         /**< The condition variable for signalling. */
+    static std::vector<std::unique_ptr<Queue>> queues_;         /**< One queue per worker then one for others. */
+    static std::vector<std::thread>            threads_;        /**< The available CPU threads. */
 };
 } // namespace Capsaicin
@@ -22,6 +22,9 @@ THE SOFTWARE.
 
 #include "timeable.h"
 
+#include "cpu_profiler.h"
+#include "gfx_recorder.h"
+
 namespace Capsaicin
 {
 Timeable::TimedSection::TimedSection(Timeable &parentTimeable, std::string_view const &name) noexcept
@@ -36,10 +39,14 @@ Timeable::TimedSection::TimedSection(Timeable &parentTimeable, std::string_view
     parent.queries[queryIndex].name = (!name.empty() ? name : "<unnamed>");
     gfxCommandBeginEvent(parent.gfx_, parent.queries[queryIndex].name.data());
     gfxCommandBeginTimestampQuery(parent.gfx_, parent.queries[queryIndex].query);
+    GfxRecorder::BeginScope(parent.getName());
+    CpuProfiler::BeginScope(parent.queries[queryIndex].name);
 }
 
 Timeable::TimedSection::~TimedSection() noexcept
 {
+    CpuProfiler::EndScope();
+    GfxRecorder::EndScope();
     gfxCommandEndTimestampQuery(parent.gfx_, parent.queries[queryIndex].query);
     gfxCommandEndEvent(parent.gfx_);
 }
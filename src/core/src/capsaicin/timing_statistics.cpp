@@ -0,0 +1,145 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "timing_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <gfx.h>
+
+namespace Capsaicin
+{
+namespace
+{
+/** Gets the nearest rank percentile of sorted samples. */
+double GetPercentile(std::vector<double> const &sorted_samples, double percentile) noexcept
+{
+    size_t const rank = (size_t)std::ceil(percentile / 100.0 * (double)sorted_samples.size());
+    return sorted_samples[std::clamp(rank, (size_t)1, sorted_samples.size()) - 1];
+}
+} // unnamed namespace
+
+void TimingStatistics::clear() noexcept
+{
+    sections_.clear();
+    section_indices_.clear();
+}
+
+void TimingStatistics::addSample(std::string_view const &name, double value) noexcept
+{
+    std::string key(name);
+    auto const  section = section_indices_.find(key);
+    uint32_t    index;
+    if (section != section_indices_.cend())
+    {
+        index = section->second;
+    }
+    else
+    {
+        index = (uint32_t)sections_.size();
+        sections_.emplace_back().name = key;
+        section_indices_.emplace(std::move(key), index);
+    }
+    sections_[index].samples.push_back(value);
+}
+
+std::vector<TimingSummary> TimingStatistics::getSummaries() const noexcept
+{
+    std::vector<TimingSummary> summaries;
+    std::vector<double>        samples;
+    for (Section const &section : sections_)
+    {
+        samples = section.samples;
+        summaries.push_back(Summarize(section.name, samples));
+    }
+    return summaries;
+}
+
+bool TimingStatistics::write(char const *file_path, std::string_view const &unit) const noexcept
+{
+    std::ofstream file(file_path);
+    if (!file.is_open())
+    {
+        GFX_PRINTLN("Failed to open timing statistics file '%s'", file_path);
+        return false;
+    }
+    std::vector<TimingSummary> const summaries = getSummaries();
+    std::string_view const           path      = file_path;
+    if (path.size() >= 5 && path.substr(path.size() - 5) == ".json")
+    {
+        file << "{" << '\n' << "    \"unit\": \"" << unit << "\"," << '\n' << "    \"sections\": [" << '\n';
+        for (size_t index = 0; index < summaries.size(); ++index)
+        {
+            TimingSummary const &summary = summaries[index];
+            file << "        {\"name\": \"" << summary.name << "\", \"count\": " << summary.count
+                 << ", \"min\": " << summary.min << ", \"mean\": " << summary.mean << ", \"p50\": " << summary.p50
+                 << ", \"p95\": " << summary.p95 << ", \"p99\": " << summary.p99 << ", \"max\": " << summary.max
+                 << ", \"variance\": " << summary.variance << "}" << (index + 1 < summaries.size() ? "," : "")
+                 << '\n';
+        }
+        file << "    ]" << '\n' << "}" << '\n';
+    }
+    else
+    {
+        file << "Section,Count,Min (" << unit << "),Mean (" << unit << "),P50 (" << unit << "),P95 (" << unit
+             << "),P99 (" << unit << "),Max (" << unit << "),Variance (" << unit << "^2)" << '\n';
+        for (TimingSummary const &summary : summaries)
+        {
+            file << summary.name << "," << summary.count << "," << summary.min << "," << summary.mean << ","
+                 << summary.p50 << "," << summary.p95 << "," << summary.p99 << "," << summary.max << ","
+                 << summary.variance << '\n';
+        }
+    }
+    return file.good();
+}
+
+TimingSummary TimingStatistics::Summarize(std::string_view const &name, std::vector<double> &samples) noexcept
+{
+    TimingSummary summary;
+    summary.name  = name;
+    summary.count = (uint32_t)samples.size();
+    if (samples.empty())
+    {
+        return summary;
+    }
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double const sample : samples)
+    {
+        sum += sample;
+    }
+    summary.mean = sum / (double)samples.size();
+    // Two pass variance, avoiding the cancellation of the sum of squares formulation
+    double squared_deviations = 0.0;
+    for (double const sample : samples)
+    {
+        squared_deviations += (sample - summary.mean) * (sample - summary.mean);
+    }
+    summary.variance = squared_deviations / (double)samples.size();
+    summary.min      = samples.front();
+    summary.max      = samples.back();
+    summary.p50      = GetPercentile(samples, 50.0);
+    summary.p95      = GetPercentile(samples, 95.0);
+    summary.p99      = GetPercentile(samples, 99.0);
+    return summary;
+}
+} // namespace Capsaicin
@@ -0,0 +1,88 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "timing_summary.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Capsaicin
+{
+/** Collects the timings of named sections over many frames and summarises them (e.g., for benchmarking). */
+class TimingStatistics
+{
+public:
+    /**
+     * Discard all samples.
+     */
+    void clear() noexcept;
+
+    /**
+     * Add a sample to a section, sections are created on first use.
+     * @param name  The section name.
+     * @param value The sample value (e.g., in milliseconds).
+     */
+    void addSample(std::string_view const &name, double value) noexcept;
+
+    /**
+     * Check whether any sample was added.
+     * @returns True if no section has samples.
+     */
+    bool empty() const noexcept { return sections_.empty(); }
+
+    /**
+     * Gets the statistics of every section.
+     * @returns The list of summaries, in order of section creation.
+     */
+    std::vector<TimingSummary> getSummaries() const noexcept;
+
+    /**
+     * Write the statistics of every section to a file.
+     * @param file_path Full pathname to the file to write, written as JSON if it ends in '.json' or as CSV otherwise.
+     * @param unit      The unit the samples are in (used in the column names).
+     * @returns True if succeeded, False if the file could not be written.
+     */
+    bool write(char const *file_path, std::string_view const &unit) const noexcept;
+
+    /**
+     * Compute the statistics of a list of samples.
+     * @param name    The section name.
+     * @param samples The samples (reordered).
+     * @returns The summary (all zeros if there are no samples).
+     */
+    static TimingSummary Summarize(std::string_view const &name, std::vector<double> &samples) noexcept;
+
+private:
+    struct Section
+    {
+        std::string         name;
+        std::vector<double> samples;
+    };
+
+    std::vector<Section>                      sections_;        /**< Sections in order of creation */
+    std::unordered_map<std::string, uint32_t> section_indices_; /**< Index of each section by name */
+};
+} // namespace Capsaicin
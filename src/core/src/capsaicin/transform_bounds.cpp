@@ -0,0 +1,138 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "transform_bounds.h"
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#    include <emmintrin.h>
+#    define CAPSAICIN_TRANSFORM_BOUNDS_SSE 1
+#endif
+
+namespace Capsaicin
+{
+void TransformBoundsBatch::clear() noexcept
+{
+    indices_.clear();
+    for (auto &values : transforms_)
+    {
+        values.clear();
+    }
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        centers_[i].clear();
+        extents_[i].clear();
+    }
+}
+
+void TransformBoundsBatch::add(
+    uint32_t index, glm::vec3 const &min_bounds, glm::vec3 const &max_bounds, glm::mat4 const &transform) noexcept
+{
+    indices_.push_back(index);
+    for (uint32_t column = 0; column < 4; ++column)
+    {
+        for (uint32_t row = 0; row < 3; ++row)
+        {
+            transforms_[column * 3 + row].push_back(transform[column][row]);
+        }
+    }
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        centers_[i].push_back(0.5f * (min_bounds[i] + max_bounds[i]));
+        extents_[i].push_back(0.5f * (max_bounds[i] - min_bounds[i]));
+    }
+}
+
+void TransformBoundsBatch::compute(glm::vec3 *out_min_bounds, glm::vec3 *out_max_bounds) noexcept
+{
+    uint32_t const count = size();
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Pad to a whole number of SIMD lanes
+    uint32_t const padded_count = (count + 3) & ~3u;
+    for (auto &values : transforms_)
+    {
+        values.resize(padded_count, 0.0f);
+    }
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        centers_[i].resize(padded_count, 0.0f);
+        extents_[i].resize(padded_count, 0.0f);
+        min_bounds_[i].resize(padded_count);
+        max_bounds_[i].resize(padded_count);
+    }
+
+    // The bounds of a transformed box are centered on the transformed center, with a half extent given by the
+    // absolute values of the transform's linear part applied to the object-space half extent
+#ifdef CAPSAICIN_TRANSFORM_BOUNDS_SSE
+    __m128 const sign_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    for (uint32_t i = 0; i < padded_count; i += 4)
+    {
+        __m128 const center[3] = {
+            _mm_loadu_ps(&centers_[0][i]), _mm_loadu_ps(&centers_[1][i]), _mm_loadu_ps(&centers_[2][i])};
+        __m128 const extent[3] = {
+            _mm_loadu_ps(&extents_[0][i]), _mm_loadu_ps(&extents_[1][i]), _mm_loadu_ps(&extents_[2][i])};
+        for (uint32_t row = 0; row < 3; ++row)
+        {
+            __m128 world_center = _mm_loadu_ps(&transforms_[9 + row][i]);
+            __m128 world_extent = _mm_setzero_ps();
+            for (uint32_t column = 0; column < 3; ++column)
+            {
+                __m128 const value = _mm_loadu_ps(&transforms_[column * 3 + row][i]);
+                world_center       = _mm_add_ps(world_center, _mm_mul_ps(value, center[column]));
+                world_extent =
+                    _mm_add_ps(world_extent, _mm_mul_ps(_mm_and_ps(value, sign_mask), extent[column]));
+            }
+            _mm_storeu_ps(&min_bounds_[row][i], _mm_sub_ps(world_center, world_extent));
+            _mm_storeu_ps(&max_bounds_[row][i], _mm_add_ps(world_center, world_extent));
+        }
+    }
+#else
+    for (uint32_t i = 0; i < padded_count; ++i)
+    {
+        for (uint32_t row = 0; row < 3; ++row)
+        {
+            float world_center = transforms_[9 + row][i];
+            float world_extent = 0.0f;
+            for (uint32_t column = 0; column < 3; ++column)
+            {
+                float const value = transforms_[column * 3 + row][i];
+                world_center += value * centers_[column][i];
+                world_extent += fabsf(value) * extents_[column][i];
+            }
+            min_bounds_[row][i] = world_center - world_extent;
+            max_bounds_[row][i] = world_center + world_extent;
+        }
+    }
+#endif
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t const index  = indices_[i];
+        out_min_bounds[index] = glm::vec3(min_bounds_[0][i], min_bounds_[1][i], min_bounds_[2][i]);
+        out_max_bounds[index] = glm::vec3(max_bounds_[0][i], max_bounds_[1][i], max_bounds_[2][i]);
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,74 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Computes the world-space bounds of a batch of transformed boxes.
+ * Transforms are stored as a structure of arrays so that the bounds of 4 instances are computed per SIMD
+ * instruction, results are then scattered back to their instance.
+ */
+class TransformBoundsBatch
+{
+public:
+    /**
+     * Remove all the boxes from the batch.
+     */
+    void clear() noexcept;
+
+    /**
+     * Add a box to the batch.
+     * @param index      The index the resulting bounds are written to.
+     * @param min_bounds The object-space minimum bounds.
+     * @param max_bounds The object-space maximum bounds.
+     * @param transform  The object to world transform.
+     */
+    void add(uint32_t index, glm::vec3 const &min_bounds, glm::vec3 const &max_bounds,
+        glm::mat4 const &transform) noexcept;
+
+    /**
+     * Compute the world-space bounds of all boxes in the batch.
+     * @param [out] out_min_bounds The minimum bounds, indexed by the index of each box.
+     * @param [out] out_max_bounds The maximum bounds, indexed by the index of each box.
+     */
+    void compute(glm::vec3 *out_min_bounds, glm::vec3 *out_max_bounds) noexcept;
+
+    /**
+     * Gets the number of boxes in the batch.
+     * @returns The box count.
+     */
+    uint32_t size() const noexcept { return (uint32_t)indices_.size(); }
+
+private:
+    std::vector<uint32_t> indices_;        /**< The output index of each box */
+    std::vector<float>    transforms_[12]; /**< The affine transform of each box (column-major) */
+    std::vector<float>    centers_[3];     /**< The object-space center of each box */
+    std::vector<float>    extents_[3];     /**< The object-space half extent of each box */
+    std::vector<float>    min_bounds_[3];  /**< The computed world-space minimum bounds */
+    std::vector<float>    max_bounds_[3];  /**< The computed world-space maximum bounds */
+};
+} // namespace Capsaicin
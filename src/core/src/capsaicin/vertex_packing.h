@@ -0,0 +1,87 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+namespace Capsaicin
+{
+/**
+ * Pack a normal vector to 2x16bit snorm values using an octahedral mapping.
+ * @note Matches packNormalOctahedral in math/pack.hlsl.
+ * @param value Input normalised vector to pack.
+ * @returns Packed octahedral coordinates (x in lower 16bits, y in upper 16bits).
+ */
+inline uint32_t PackNormalOctahedral(glm::vec3 const &value) noexcept
+{
+    glm::vec2 octahedral = glm::vec2(value) / (glm::abs(value.x) + glm::abs(value.y) + glm::abs(value.z));
+    if (value.z < 0.0f)
+    {
+        octahedral = (1.0f - glm::abs(glm::vec2(octahedral.y, octahedral.x)))
+                   * glm::vec2(octahedral.x >= 0.0f ? 1.0f : -1.0f, octahedral.y >= 0.0f ? 1.0f : -1.0f);
+    }
+    glm::ivec2 const packed_value = glm::ivec2(glm::round(glm::clamp(octahedral, -1.0f, 1.0f) * 32767.0f));
+    return ((uint32_t)packed_value.x & 0xFFFFu) | ((uint32_t)packed_value.y << 16);
+}
+
+/**
+ * Convert octahedral 2x16bit snorms to a normal vector.
+ * @note Matches unpackNormalOctahedral in math/pack.hlsl.
+ * @param packed_value Input snorm values to convert.
+ * @returns Converted normalised vector.
+ */
+inline glm::vec3 UnpackNormalOctahedral(uint32_t packed_value) noexcept
+{
+    glm::vec2 const octahedral = glm::max(
+        glm::vec2((float)(int16_t)(packed_value & 0xFFFFu), (float)(int16_t)(packed_value >> 16)) / 32767.0f,
+        -1.0f);
+    glm::vec3   normal(octahedral, 1.0f - glm::abs(octahedral.x) - glm::abs(octahedral.y));
+    float const t = glm::clamp(-normal.z, 0.0f, 1.0f);
+    normal.x += normal.x >= 0.0f ? -t : t;
+    normal.y += normal.y >= 0.0f ? -t : t;
+    return glm::normalize(normal);
+}
+
+/**
+ * Pack texture coordinates to 2x16bit half precision values.
+ * @note Matches packHalf2 in math/pack.hlsl.
+ * @param value Input UVs to pack.
+ * @returns Packed UVs (x in lower 16bits, y in upper 16bits).
+ */
+inline uint32_t PackUV(glm::vec2 const &value) noexcept
+{
+    return glm::packHalf2x16(value);
+}
+
+/**
+ * Convert 2x16bit half precision values to texture coordinates.
+ * @note Matches unpackHalf2 in math/pack.hlsl.
+ * @param packed_value Input half values to convert.
+ * @returns Converted UVs.
+ */
+inline glm::vec2 UnpackUV(uint32_t packed_value) noexcept
+{
+    return glm::unpackHalf2x16(packed_value);
+}
+} // namespace Capsaicin
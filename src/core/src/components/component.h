@@ -23,6 +23,7 @@ THE SOFTWARE.
 
 #include "capsaicin_internal_types.h"
 #include "factory.h"
+#include "render_option_registry.h"
 #include "timeable.h"
 
 namespace Capsaicin
@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ********************************************************************/
 
+#include "../../geometry/vertex.hlsl"
 #include "../../lights/lights_shared.h"
 #include "../../math/transform.hlsl"
 
@@ -43,11 +44,11 @@ Params VS(in Vertex vertex, in uint drawID)
     Instance instance   = g_InstanceBuffer[instanceID];
 
     float3x4 transform = g_TransformBuffer[instance.transform_index];
-    float3   position  = transformPoint(vertex.position.xyz, transform);
+    float3   position  = transformPoint(getVertexPosition(vertex), transform);
 
     Params params;
     params.position   = float4(position, 1.0f);
-    params.uv         = vertex.uv.xy;
+    params.uv         = getVertexUV(vertex);
     params.instanceID = instanceID;
     params.materialID = instance.material_index;
 
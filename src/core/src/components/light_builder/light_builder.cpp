@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "light_builder.h"
 
 #include "capsaicin_internal.h"
-#include "hash_reduce.h"
+#include "parallel_algorithms.h"
 #include "render_technique.h"
 
 namespace Capsaicin
@@ -59,8 +59,16 @@ bool LightBuilder::init(CapsaicinInternal const &capsaicin) noexcept
 {
     gatherAreaLightsProgram =
         gfxCreateProgram(gfx_, "components/light_builder/gather_area_lights", capsaicin.getShaderPath());
-    countAreaLightsKernel   = gfxCreateGraphicsKernel(gfx_, gatherAreaLightsProgram, "CountAreaLights");
-    scatterAreaLightsKernel = gfxCreateGraphicsKernel(gfx_, gatherAreaLightsProgram, "ScatterAreaLights");
+    std::vector<std::string>  sceneDefines(capsaicin.getSceneShaderDefines());
+    std::vector<char const *> defines;
+    for (auto &i : sceneDefines)
+    {
+        defines.push_back(i.c_str());
+    }
+    countAreaLightsKernel = gfxCreateGraphicsKernel(
+        gfx_, gatherAreaLightsProgram, "CountAreaLights", defines.data(), (uint32_t)defines.size());
+    scatterAreaLightsKernel = gfxCreateGraphicsKernel(
+        gfx_, gatherAreaLightsProgram, "ScatterAreaLights", defines.data(), (uint32_t)defines.size());
 
     lightCountBuffer = gfxCreateBuffer<uint32_t>(gfx_, 1);
     lightCountBuffer.setName("LightCountBuffer");
@@ -75,38 +83,38 @@ bool LightBuilder::init(CapsaicinInternal const &capsaicin) noexcept
         buffer.setName(name.c_str());
         lightCountBufferTemp.emplace_back(false, buffer);
     }
-    lightHash = 0;
+    lightsDirty = true;
 
     return !!gatherAreaLightsProgram;
 }
 
 void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
 {
-    auto optionsNew = convertOptions(capsaicin.getOptions());
+    auto optionsNew = optionsCache.get(capsaicin.getOptionRegistry(), convertOptions);
     auto scene      = capsaicin.getScene();
 
     // Check if meshes were updated
     std::vector<uint32_t> lightInstancePrimitiveCount;
     if (capsaicin.getMeshesUpdated() || capsaicin.getFrameIndex() == 0)
     {
-        areaLightTotal = 0;
+        // Each emissive instance gets the offset of its first primitive in the area light list
+        GfxInstance const *instances = gfxSceneGetObjects<GfxInstance>(scene);
         lightInstancePrimitiveCount.resize(gfxSceneGetObjectCount<GfxInstance>(scene));
-        for (uint32_t i = 0; i < gfxSceneGetObjectCount<GfxInstance>(scene); ++i)
-        {
-            auto const &instance = gfxSceneGetObjects<GfxInstance>(scene)[i];
-            if (instance.mesh && instance.material && gfxMaterialIsEmissive(*instance.material))
-            {
-                lightInstancePrimitiveCount[i] = areaLightTotal;
-                areaLightTotal += (uint32_t)instance.mesh->indices.size() / 3;
-            }
-        }
+        areaLightTotal = ParallelTransformScan(
+            (uint32_t)lightInstancePrimitiveCount.size(), lightInstancePrimitiveCount.data(), 0u,
+            [instances](uint32_t i) {
+                auto const &instance = instances[i];
+                return (instance.mesh && instance.material && gfxMaterialIsEmissive(*instance.material))
+                         ? (uint32_t)instance.mesh->indices.size() / 3
+                         : 0u;
+            },
+            std::plus<uint32_t>(), false);
     }
 
     // Check whether we need to update lighting structures
-    size_t oldLightHash = lightHash;
-    if (!capsaicin.getPaused() || capsaicin.getFrameIndex() == 0)
-        lightHash = Capsaicin::HashReduce(
-            gfxSceneGetObjects<GfxLight>(scene), gfxSceneGetObjectCount<GfxLight>(scene));
+    bool const lightsChanged =
+        lightsDirty || capsaicin.getSceneChanges().hasChanges(SceneChangeTracker::ObjectType::Light);
+    lightsDirty = false;
 
     // Get last valid area light count value
     const uint32_t bufferIndex = gfxGetBackBufferIndex(gfx_);
@@ -134,11 +142,13 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
                        || options.area_light_enable != optionsNew.area_light_enable
                        || options.environment_light_enable != optionsNew.environment_light_enable;
     options = optionsNew;
-    if (oldLightHash != lightHash
+    if (lightsChanged
         || (capsaicin.getEnvironmentMapUpdated() && options.environment_light_enable)
         || (oldAreaLightMaxCount != areaLightMaxCount) || (oldDeltaLightCount != deltaLightCount)
         || lightSettingChanged
-        || (areaLightMaxCount > 0 && (capsaicin.getMeshesUpdated() || capsaicin.getTransformsUpdated())))
+        || (areaLightMaxCount > 0
+            && (capsaicin.getMeshesUpdated() || capsaicin.getTransformsUpdated()
+                || capsaicin.getTexturesUpdated())))
     {
         lightsUpdated = true;
 
@@ -225,8 +235,7 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
         {
             TimedSection const timedSection(*this, "GatherAreaLights");
 
-            uint32_t const instanceCount    = gfxSceneGetObjectCount<GfxInstance>(scene);
-            uint32_t       drawCommandCount = 0;
+            uint32_t const instanceCount = gfxSceneGetObjectCount<GfxInstance>(scene);
 
             GfxBuffer instanceIDBuffer = capsaicin.allocateConstantBuffer<uint32_t>(instanceCount);
             uint32_t *instanceIDData   = (uint32_t *)gfxBufferGetData(gfx_, instanceIDBuffer);
@@ -253,20 +262,21 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
                 lightInstancePrimitiveBuffer.setName("Capsaicin_LightInstancePrimitiveBuffer");
             }
 
-            for (uint32_t i = 0; i < instanceCount; ++i)
-            {
-                GfxConstRef<GfxInstance> instanceRef = gfxSceneGetObjectHandle<GfxInstance>(scene, i);
-
-                if (!instanceRef->mesh || !instanceRef->material
-                    || !gfxMaterialIsEmissive(*instanceRef->material))
-                {
-                    continue; // not an emissive primitive
-                }
-
-                uint32_t const  drawCommandIndex = drawCommandCount++;
-                uint32_t const  instanceIndex    = (uint32_t)instanceRef;
-                Instance const &instance         = capsaicin.getInstanceData()[instanceIndex];
-                Mesh const     &mesh             = capsaicin.getMeshData()[instance.mesh_index];
+            // Gather the emissive instances, then write a draw command for each of them
+            GfxInstance const    *instances = gfxSceneGetObjects<GfxInstance>(scene);
+            std::vector<uint32_t> emissiveInstances(instanceCount);
+            uint32_t const        drawCommandCount = ParallelCompact(
+                instanceCount,
+                [instances](uint32_t i) {
+                    return instances[i].mesh && instances[i].material
+                        && gfxMaterialIsEmissive(*instances[i].material);
+                },
+                emissiveInstances.data());
+            ThreadPool::ParallelFor(drawCommandCount, [&](uint32_t drawCommandIndex) {
+                uint32_t const instanceIndex =
+                    (uint32_t)gfxSceneGetObjectHandle<GfxInstance>(scene, emissiveInstances[drawCommandIndex]);
+                Instance const &instance = capsaicin.getInstanceData()[instanceIndex];
+                Mesh const     &mesh     = capsaicin.getMeshData()[instance.mesh_index];
 
                 drawCommands[drawCommandIndex].IndexCountPerInstance = mesh.index_count;
                 drawCommands[drawCommandIndex].InstanceCount         = 1;
@@ -275,7 +285,7 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
                 drawCommands[drawCommandIndex].StartInstanceLocation = drawCommandIndex;
 
                 instanceIDData[drawCommandIndex] = instanceIndex;
-            }
+            });
 
             gfxProgramSetParameter(gfx_, gatherAreaLightsProgram, "g_LightBuffer", lightBuffers[lightBufferIndex]);
             gfxProgramSetParameter(gfx_, gatherAreaLightsProgram, "g_LightBufferSize", lightCountBuffer);
@@ -143,15 +143,16 @@ class LightBuilder
     bool getLightSettingsUpdated() const;
 
 private:
-    RenderOptions options;
-
-    uint32_t areaLightTotal      = 0; /**< Number of area lights in meshes (may not be all enabled) */
-    size_t   lightHash           = 0;
-    uint32_t areaLightMaxCount   = 0; /**< Max number of area lights in light buffer */
-    uint32_t areaLightCount      = 0; /**< Approximate number of area lights in light buffer */
-    uint32_t deltaLightCount     = 0; /**< Number of delta lights in light buffer */
-    uint32_t environmentMapCount = 0; /**< Number of environment map lights in buffer */
-    uint32_t lightBufferIndex    = 0; /**< Index of currently active light buffer */
+    RenderOptions                     options;
+    RenderOptionsCache<RenderOptions> optionsCache;
+
+    uint32_t areaLightTotal      = 0;    /**< Number of area lights in meshes (may not be all enabled) */
+    bool     lightsDirty         = true; /**< Whether lights need updating regardless of scene changes */
+    uint32_t areaLightMaxCount   = 0;    /**< Max number of area lights in light buffer */
+    uint32_t areaLightCount      = 0;    /**< Approximate number of area lights in light buffer */
+    uint32_t deltaLightCount     = 0;    /**< Number of delta lights in light buffer */
+    uint32_t environmentMapCount = 0;    /**< Number of environment map lights in buffer */
+    uint32_t lightBufferIndex    = 0;    /**< Index of currently active light buffer */
 
     bool lightsUpdated       = true;
     bool lightSettingChanged = true;
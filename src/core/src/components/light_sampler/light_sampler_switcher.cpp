@@ -96,7 +96,7 @@ bool LightSamplerSwitcher::init(CapsaicinInternal const &capsaicin) noexcept
 void LightSamplerSwitcher::run(CapsaicinInternal &capsaicin) noexcept
 {
     samplerChanged        = false;
-    auto const optionsNew = convertOptions(capsaicin.getOptions());
+    auto const optionsNew = optionsCache.get(capsaicin.getOptionRegistry(), convertOptions);
     if (optionsNew.light_sampler_type != options.light_sampler_type)
     {
         samplerChanged = true;
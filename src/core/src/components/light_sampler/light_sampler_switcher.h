@@ -145,7 +145,8 @@ class LightSamplerSwitcher
     void setGfxContext(GfxContext const &gfx) noexcept override;
 
 private:
-    RenderOptions                 options;
+    RenderOptions                     options;
+    RenderOptionsCache<RenderOptions> optionsCache;
     std::unique_ptr<LightSampler> currentSampler = nullptr; /**< The currently active light sampler */
     bool samplerChanged = true; /**< Flag indicating if a sampler change has occurred */
 };
@@ -79,7 +79,7 @@ bool LightSamplerGridCDF::init(CapsaicinInternal const &capsaicin) noexcept
 void LightSamplerGridCDF::run(CapsaicinInternal &capsaicin) noexcept
 {
     // Update internal options
-    auto const optionsNew   = convertOptions(capsaicin.getOptions());
+    auto const optionsNew   = optionsCache.get(capsaicin.getOptionRegistry(), convertOptions);
     auto       lightBuilder = capsaicin.getComponent<LightBuilder>();
 
     recompileFlag =
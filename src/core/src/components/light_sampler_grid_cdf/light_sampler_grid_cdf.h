@@ -143,8 +143,9 @@ class LightSamplerGridCDF
 private:
     bool initKernels(CapsaicinInternal const &capsaicin) noexcept;
 
-    RenderOptions options;
-    bool          recompileFlag =
+    RenderOptions                     options;
+    RenderOptionsCache<RenderOptions> optionsCache;
+    bool                              recompileFlag =
         false; /**< Flag to indicate if option change requires a shader recompile this frame */
     bool lightsUpdatedFlag = false; /**< Flag to indicate if option change effects light samples */
 
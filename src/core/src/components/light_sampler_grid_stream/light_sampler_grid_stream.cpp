@@ -208,7 +208,7 @@ void LightSamplerGridStream::setBounds(
 void LightSamplerGridStream::update(CapsaicinInternal &capsaicin, Timeable *parent) noexcept
 {
     // Update internal options
-    auto const optionsNew   = convertOptions(capsaicin.getOptions());
+    auto const optionsNew   = optionsCache.get(capsaicin.getOptionRegistry(), convertOptions);
     auto       lightBuilder = capsaicin.getComponent<LightBuilder>();
 
     // Check if many lights kernel should be run. This requires greater than 128 lights per reservoir as
@@ -192,8 +192,9 @@ class LightSamplerGridStream
     bool initBoundsBuffers() noexcept;
     bool initLightIndexBuffer() noexcept;
 
-    RenderOptions options;
-    bool          recompileFlag =
+    RenderOptions                     options;
+    RenderOptionsCache<RenderOptions> optionsCache;
+    bool                              recompileFlag =
         false; /**< Flag to indicate if option change requires a shader recompile this frame */
     bool lightsUpdatedFlag = false; /**< Flag to indicate if option change effects light samples */
     bool usingManyLights   = false; /**< Flag indicating if ,any lights parallel build is in use */
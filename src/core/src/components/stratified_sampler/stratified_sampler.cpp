@@ -90,7 +90,7 @@ bool StratifiedSampler::init(CapsaicinInternal const &capsaicin) noexcept
 void StratifiedSampler::run(CapsaicinInternal &capsaicin) noexcept
 {
     // Check for option changed
-    auto const optionsNew = convertOptions(capsaicin.getOptions());
+    auto const optionsNew = optionsCache.get(capsaicin.getOptionRegistry(), convertOptions);
     bool update = optionsNew.stratified_sampler_deterministic != options.stratified_sampler_deterministic;
     options = optionsNew;
 
@@ -88,7 +88,8 @@ class StratifiedSampler
     void addProgramParameters(CapsaicinInternal const &capsaicin, GfxProgram program) const noexcept;
 
 private:
-    RenderOptions options;
+    RenderOptions                     options;
+    RenderOptionsCache<RenderOptions> optionsCache;
     GfxBuffer seedBuffer;
     GfxBuffer sobolBuffer;
 };
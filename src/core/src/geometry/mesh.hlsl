@@ -30,6 +30,7 @@ StructuredBuffer<Vertex> g_VertexBuffer;
 */
 
 #include "../gpu_shared.h"
+#include "vertex.hlsl"
 
 struct Triangle
 {
@@ -92,9 +93,9 @@ Triangle fetchVertices(Mesh mesh, uint primitiveIndex)
     uint i2 = g_IndexBuffer[mesh.index_offset_idx + 3 * primitiveIndex + 2] + mesh.vertex_offset_idx;
 
     // Get vertex values from buffers
-    float3 v0 = g_VertexBuffer[i0].position.xyz;
-    float3 v1 = g_VertexBuffer[i1].position.xyz;
-    float3 v2 = g_VertexBuffer[i2].position.xyz;
+    float3 v0 = getVertexPosition(g_VertexBuffer[i0]);
+    float3 v1 = getVertexPosition(g_VertexBuffer[i1]);
+    float3 v2 = getVertexPosition(g_VertexBuffer[i2]);
 
     Triangle ret = {v0, v1, v2};
     return ret;
@@ -114,14 +115,14 @@ TriangleUV fetchVerticesUV(Mesh mesh, uint primitiveIndex)
     uint i2 = g_IndexBuffer[mesh.index_offset_idx + 3 * primitiveIndex + 2] + mesh.vertex_offset_idx;
 
     // Get vertex values from buffers
-    float3 v0 = g_VertexBuffer[i0].position.xyz;
-    float3 v1 = g_VertexBuffer[i1].position.xyz;
-    float3 v2 = g_VertexBuffer[i2].position.xyz;
+    float3 v0 = getVertexPosition(g_VertexBuffer[i0]);
+    float3 v1 = getVertexPosition(g_VertexBuffer[i1]);
+    float3 v2 = getVertexPosition(g_VertexBuffer[i2]);
 
     // Get UV values from buffers
-    float2 uv0 = g_VertexBuffer[i0].uv;
-    float2 uv1 = g_VertexBuffer[i1].uv;
-    float2 uv2 = g_VertexBuffer[i2].uv;
+    float2 uv0 = getVertexUV(g_VertexBuffer[i0]);
+    float2 uv1 = getVertexUV(g_VertexBuffer[i1]);
+    float2 uv2 = getVertexUV(g_VertexBuffer[i2]);
 
     TriangleUV ret = {v0, v1, v2, uv0, uv1, uv2};
     return ret;
@@ -141,14 +142,14 @@ TriangleNorm fetchVerticesNorm(Mesh mesh, uint primitiveIndex)
     uint i2 = g_IndexBuffer[mesh.index_offset_idx + 3 * primitiveIndex + 2] + mesh.vertex_offset_idx;
 
     // Get vertex values from buffers
-    float3 v0 = g_VertexBuffer[i0].position.xyz;
-    float3 v1 = g_VertexBuffer[i1].position.xyz;
-    float3 v2 = g_VertexBuffer[i2].position.xyz;
+    float3 v0 = getVertexPosition(g_VertexBuffer[i0]);
+    float3 v1 = getVertexPosition(g_VertexBuffer[i1]);
+    float3 v2 = getVertexPosition(g_VertexBuffer[i2]);
 
     // Get normal values from buffers
-    float3 n0 = g_VertexBuffer[i0].normal.xyz;
-    float3 n1 = g_VertexBuffer[i1].normal.xyz;
-    float3 n2 = g_VertexBuffer[i2].normal.xyz;
+    float3 n0 = getVertexNormal(g_VertexBuffer[i0]);
+    float3 n1 = getVertexNormal(g_VertexBuffer[i1]);
+    float3 n2 = getVertexNormal(g_VertexBuffer[i2]);
 
     TriangleNorm ret = {v0, v1, v2, n0, n1, n2};
     return ret;
@@ -168,19 +169,19 @@ TriangleNormUV fetchVerticesNormUV(Mesh mesh, uint primitiveIndex)
     uint i2 = g_IndexBuffer[mesh.index_offset_idx + 3 * primitiveIndex + 2] + mesh.vertex_offset_idx;
 
     // Get vertex values from buffers
-    float3 v0 = g_VertexBuffer[i0].position.xyz;
-    float3 v1 = g_VertexBuffer[i1].position.xyz;
-    float3 v2 = g_VertexBuffer[i2].position.xyz;
+    float3 v0 = getVertexPosition(g_VertexBuffer[i0]);
+    float3 v1 = getVertexPosition(g_VertexBuffer[i1]);
+    float3 v2 = getVertexPosition(g_VertexBuffer[i2]);
 
     // Get normal values from buffers
-    float3 n0 = g_VertexBuffer[i0].normal.xyz;
-    float3 n1 = g_VertexBuffer[i1].normal.xyz;
-    float3 n2 = g_VertexBuffer[i2].normal.xyz;
+    float3 n0 = getVertexNormal(g_VertexBuffer[i0]);
+    float3 n1 = getVertexNormal(g_VertexBuffer[i1]);
+    float3 n2 = getVertexNormal(g_VertexBuffer[i2]);
 
     // Get UV values from buffers
-    float2 uv0 = g_VertexBuffer[i0].uv;
-    float2 uv1 = g_VertexBuffer[i1].uv;
-    float2 uv2 = g_VertexBuffer[i2].uv;
+    float2 uv0 = getVertexUV(g_VertexBuffer[i0]);
+    float2 uv1 = getVertexUV(g_VertexBuffer[i1]);
+    float2 uv2 = getVertexUV(g_VertexBuffer[i2]);
 
     TriangleNormUV ret = {v0, v1, v2, n0, n1, n2, uv0, uv1, uv2};
     return ret;
@@ -200,9 +201,9 @@ UVs fetchUVs(Mesh mesh, uint primitiveIndex)
     uint i2 = g_IndexBuffer[mesh.index_offset_idx + 3 * primitiveIndex + 2] + mesh.vertex_offset_idx;
 
     // Get UV values from buffers
-    float2 uv0 = g_VertexBuffer[i0].uv;
-    float2 uv1 = g_VertexBuffer[i1].uv;
-    float2 uv2 = g_VertexBuffer[i2].uv;
+    float2 uv0 = getVertexUV(g_VertexBuffer[i0]);
+    float2 uv1 = getVertexUV(g_VertexBuffer[i1]);
+    float2 uv2 = getVertexUV(g_VertexBuffer[i2]);
 
     UVs ret = {uv0, uv1, uv2};
     return ret;
@@ -0,0 +1,67 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#ifndef VERTEX_HLSL
+#define VERTEX_HLSL
+
+#include "../gpu_shared.h"
+#include "../math/pack.hlsl"
+
+/**
+ * Get the object space position of a vertex.
+ * @param vertex The vertex to read.
+ * @returns The vertex position.
+ */
+float3 getVertexPosition(Vertex vertex)
+{
+    return vertex.position.xyz;
+}
+
+/**
+ * Get the object space normal of a vertex.
+ * @param vertex The vertex to read.
+ * @returns The vertex normal.
+ */
+float3 getVertexNormal(Vertex vertex)
+{
+#ifdef COMPACT_VERTEX
+    return unpackNormalOctahedral(vertex.normal);
+#else
+    return vertex.normal.xyz;
+#endif
+}
+
+/**
+ * Get the texture coordinates of a vertex.
+ * @param vertex The vertex to read.
+ * @returns The vertex UVs.
+ */
+float2 getVertexUV(Vertex vertex)
+{
+#ifdef COMPACT_VERTEX
+    return unpackHalf2(vertex.uv);
+#else
+    return vertex.uv;
+#endif
+}
+
+#endif // VERTEX_HLSL
@@ -150,6 +150,7 @@ struct Mesh
     uint index_count;
 };
 
+#if defined(__cplusplus) || !defined(COMPACT_VERTEX)
 struct Vertex
 {
     float4 position SEMANTIC(POSITION);
@@ -157,6 +158,23 @@ struct Vertex
     float2 uv       SEMANTIC(TEXCOORDS);
     float2 unused   SEMANTIC(UNUSED);
 };
+#endif
+
+/** Compact vertex layout (20 bytes), used in place of Vertex when COMPACT_VERTEX is defined. */
+struct CompactVertex
+{
+#ifdef __cplusplus
+    glm::vec3 position; // unaligned to match the tight HLSL packing
+#else
+    float3 position SEMANTIC(POSITION);
+#endif
+    uint normal SEMANTIC(NORMAL);    // octahedral encoded, see packNormalOctahedral
+    uint uv     SEMANTIC(TEXCOORDS); // 2x half precision
+};
+
+#if !defined(__cplusplus) && defined(COMPACT_VERTEX)
+typedef CompactVertex Vertex;
+#endif
 
 struct CameraMatrices
 {
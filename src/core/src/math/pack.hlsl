@@ -24,6 +24,7 @@ THE SOFTWARE.
 #define PACK_HLSL
 
 #include "../gpu_shared.h"
+#include "math.hlsl"
 
 /**
  * Convert float value to single 8bit unorm.
@@ -485,6 +486,38 @@ float3 unpackNormal(uint packedValue)
     return float3(value) * (1.0f / 511.0f).xxx;
 }
 
+/**
+ * Pack normal vector to 2x16bit snorm values using an octahedral mapping.
+ * @param value Input normalised vector to pack.
+ * @returns Packed octahedral coordinates (x in lower 16bits, y in upper 16bits).
+ */
+uint packNormalOctahedral(float3 value)
+{
+    float2 octahedral = value.xy / (abs(value.x) + abs(value.y) + abs(value.z));
+    if (value.z < 0.0f)
+    {
+        octahedral = (1.0f - abs(octahedral.yx)) * select(octahedral >= 0.0f, 1.0f.xx, -1.0f.xx);
+    }
+    int2 packedValue = int2(round(clamp(octahedral, -1.0f.xx, 1.0f.xx) * 32767.0f.xx));
+    return (uint(packedValue.x) & 0xFFFFu) | (uint(packedValue.y) << 16);
+}
+
+/**
+ * Convert octahedral 2x16bit snorms to normal vector.
+ * @param packedValue Input snorm values to convert.
+ * @returns Converted normalised vector.
+ */
+float3 unpackNormalOctahedral(uint packedValue)
+{
+    // Sign extend the 16bit values
+    int2   value      = int2(packedValue << 16, packedValue) >> 16;
+    float2 octahedral = max(float2(value) * (1.0f / 32767.0f).xx, -1.0f.xx);
+    float3 normal     = float3(octahedral, 1.0f - abs(octahedral.x) - abs(octahedral.y));
+    float  t          = saturate(-normal.z);
+    normal.xy += select(normal.xy >= 0.0f, -t.xx, t.xx);
+    return normalize(normal);
+}
+
 /**
  * Pack UV values values to 16bit floats.
  * @param value Input float values to pack.
@@ -73,7 +73,7 @@ bool Atmosphere::init(CapsaicinInternal const &capsaicin) noexcept
 
 void Atmosphere::render(CapsaicinInternal &capsaicin) noexcept
 {
-    options = convertOptions(capsaicin.getOptions());
+    options = options_cache_.get(capsaicin.getOptionRegistry(), convertOptions);
     if (!options.atmosphere_enable) return;
 
     GfxTexture environment_buffer = capsaicin.getEnvironmentBuffer();
@@ -74,9 +74,10 @@ class Atmosphere : public RenderTechnique
     void terminate() noexcept override;
 
 protected:
-    RenderOptions options;
-    GfxProgram    atmosphere_program_;
-    GfxKernel     draw_atmosphere_kernel_;
+    RenderOptions                     options;
+    RenderOptionsCache<RenderOptions> options_cache_;
+    GfxProgram                        atmosphere_program_;
+    GfxKernel                         draw_atmosphere_kernel_;
     GfxKernel     filter_atmosphere_kernel_;
 
     mutable glm::vec3    sun_direction_ = glm::vec3(0.0f, 1.0f, 0.0f);
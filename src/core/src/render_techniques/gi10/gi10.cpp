@@ -1238,6 +1238,8 @@ bool GI10::init(CapsaicinInternal const &capsaicin) noexcept
     // Set up the base defines based on available features
     auto                      light_sampler = capsaicin.getComponent<LightSamplerGridStream>();
     std::vector<std::string>  defines(std::move(light_sampler->getShaderDefines(capsaicin)));
+    std::vector<std::string>  scene_defines(capsaicin.getSceneShaderDefines());
+    defines.insert(defines.end(), scene_defines.begin(), scene_defines.end());
     std::vector<char const *> base_defines;
     for (auto &i : defines)
     {
@@ -1444,7 +1446,7 @@ bool GI10::init(CapsaicinInternal const &capsaicin) noexcept
 
 void GI10::render(CapsaicinInternal &capsaicin) noexcept
 {
-    RenderOptions options            = convertOptions(capsaicin.getOptions());
+    RenderOptions options            = options_cache_.get(capsaicin.getOptionRegistry(), convertOptions);
     auto          light_sampler      = capsaicin.getComponent<LightSamplerGridStream>();
     auto          brdf_lut           = capsaicin.getComponent<BrdfLut>();
     auto          prefilter_ibl      = capsaicin.getComponent<PrefilterIBL>();
@@ -344,6 +344,8 @@ class GI10 : public RenderTechnique
         GfxBuffer  blur_sample_count_buffer_;
     };
 
+    RenderOptionsCache<RenderOptions> options_cache_;
+
     GfxCamera        previous_camera_;
     RenderOptions    options_;
     std::string_view debug_view_;
@@ -616,6 +616,8 @@ std::vector<std::string> MIGI::getShaderCompileDefinitions(const CapsaicinIntern
 
     for(auto e : light_sampler_defines) ret.push_back(e);
 
+    for(auto &e : capsaicin.getSceneShaderDefines()) ret.push_back(e);
+
     if (capsaicin.hasAOVBuffer("OcclusionAndBentNormal")) ret.emplace_back("HAS_OCCLUSION");
     ret.emplace_back("USE_RESAMPLING");
 
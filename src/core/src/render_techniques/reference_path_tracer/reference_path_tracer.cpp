@@ -106,7 +106,7 @@ bool ReferencePT::init(CapsaicinInternal const &capsaicin) noexcept
 
 void ReferencePT::render(CapsaicinInternal &capsaicin) noexcept
 {
-    RenderOptions newOptions         = convertOptions(capsaicin.getOptions());
+    RenderOptions newOptions         = optionsCache.get(capsaicin.getOptionRegistry(), convertOptions);
     auto          lightSampler       = capsaicin.getComponent<LightSamplerSwitcher>();
     auto          stratified_sampler = capsaicin.getComponent<StratifiedSampler>();
 
@@ -120,6 +120,7 @@ void ReferencePT::render(CapsaicinInternal &capsaicin) noexcept
                          && options.reference_pt_bounce_count == newOptions.reference_pt_bounce_count
                          && options.reference_pt_min_rr_bounces == newOptions.reference_pt_min_rr_bounces
                          && !capsaicin.getMeshesUpdated() && !capsaicin.getTransformsUpdated()
+                         && !capsaicin.getTexturesUpdated()
                          && !lightSampler->getLightsUpdated(capsaicin)
                          && !capsaicin.getEnvironmentMapUpdated() && capsaicin.getFrameIndex() > 0;
 
@@ -234,6 +235,8 @@ bool ReferencePT::initKernels(CapsaicinInternal const &capsaicin) noexcept
     // Set up the base defines based on available features
     auto                      lightSampler = capsaicin.getComponent<LightSamplerSwitcher>();
     std::vector<std::string>  baseDefines(std::move(lightSampler->getShaderDefines(capsaicin)));
+    std::vector<std::string>  sceneDefines(capsaicin.getSceneShaderDefines());
+    baseDefines.insert(baseDefines.end(), sceneDefines.begin(), sceneDefines.end());
     std::vector<char const *> defines;
     for (auto &i : baseDefines)
     {
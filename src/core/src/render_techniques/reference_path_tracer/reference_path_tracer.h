@@ -142,6 +142,7 @@ class ReferencePT : public RenderTechnique
     uint2      bufferDimensions = uint2(0);
     GfxCamera  camera           = {};
     RenderOptions options;
+    RenderOptionsCache<RenderOptions> optionsCache;
 
     GfxProgram reference_pt_program_;
     GfxKernel  reference_pt_kernel_;
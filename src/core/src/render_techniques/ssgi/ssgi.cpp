@@ -99,7 +99,7 @@ bool SSGI::init(CapsaicinInternal const &capsaicin) noexcept
 void SSGI::render(CapsaicinInternal &capsaicin) noexcept
 {
     // BE CAREFUL: Used for rendering current frame and initializing next frame
-    auto const options            = convertOptions(capsaicin.getOptions());
+    auto const options            = options_cache_.get(capsaicin.getOptionRegistry(), convertOptions);
     auto       blue_noise_sampler = capsaicin.getComponent<BlueNoiseSampler>();
     auto       stratified_sampler = capsaicin.getComponent<StratifiedSampler>();
 
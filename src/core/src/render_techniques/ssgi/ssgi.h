@@ -99,7 +99,8 @@ class SSGI : public RenderTechnique
     void destroyBuffers();
     void destroyKernels();
 
-    RenderOptions options_;
+    RenderOptions                     options_;
+    RenderOptionsCache<RenderOptions> options_cache_;
     uint32_t      buffer_width_;
     uint32_t      buffer_height_;
 
@@ -110,7 +110,7 @@ void TAA::render(CapsaicinInternal &capsaicin) noexcept
     // Bind the shader parameters
     uint32_t const buffer_dimensions[] = {buffer_width, buffer_height};
 
-    options = convertOptions(capsaicin.getOptions());
+    options = options_cache_.get(capsaicin.getOptionRegistry(), convertOptions);
 
     gfxProgramSetParameter(
         gfx_, taa_program_, "g_HaveHistory", not_cleared_history && capsaicin.getFrameIndex() > 0);
@@ -82,7 +82,8 @@ class TAA : public RenderTechnique
     void renderGUI(CapsaicinInternal &capsaicin) const noexcept override;
 
 protected:
-    RenderOptions options;
+    RenderOptions                     options;
+    RenderOptionsCache<RenderOptions> options_cache_;
 
     GfxTexture color_buffers_[2];
 
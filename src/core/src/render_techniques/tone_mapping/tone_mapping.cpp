@@ -76,7 +76,7 @@ bool ToneMapping::init(CapsaicinInternal const &capsaicin) noexcept
 
 void ToneMapping::render(CapsaicinInternal &capsaicin) noexcept
 {
-    options = convertOptions(capsaicin.getOptions());
+    options = options_cache_.get(capsaicin.getOptionRegistry(), convertOptions);
 
     if (!options.tonemap_enable) return;
 
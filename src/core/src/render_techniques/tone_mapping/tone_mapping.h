@@ -89,7 +89,8 @@ class ToneMapping : public RenderTechnique
     void renderGUI(CapsaicinInternal &capsaicin) const noexcept override;
 
 private:
-    RenderOptions options;
+    RenderOptions                     options;
+    RenderOptionsCache<RenderOptions> options_cache_;
 
     GfxKernel  tone_mapping_kernel_;
     GfxProgram tone_mapping_program_;
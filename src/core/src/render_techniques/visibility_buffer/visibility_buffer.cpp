@@ -93,6 +93,8 @@ DebugViewList VisibilityBuffer::getDebugViews() const noexcept
 
 bool VisibilityBuffer::init(CapsaicinInternal const &capsaicin) noexcept
 {
+    taa_enable_option_ = capsaicin.getOptionRegistry().find<bool>("taa_enable");
+
     if (capsaicin.hasAOVBuffer("DisocclusionMask"))
     {
         // Initialise disocclusion program
@@ -122,7 +124,7 @@ bool VisibilityBuffer::init(CapsaicinInternal const &capsaicin) noexcept
 void VisibilityBuffer::render(CapsaicinInternal &capsaicin) noexcept
 {
     // Check for option change
-    RenderOptions newOptions = convertOptions(capsaicin.getOptions());
+    RenderOptions newOptions = options_cache_.get(capsaicin.getOptionRegistry(), convertOptions);
     bool          recompile  = options.visibility_buffer_use_rt != newOptions.visibility_buffer_use_rt
                   || (options.visibility_buffer_use_rt
                       && options.visibility_buffer_use_rt_dxr10 != newOptions.visibility_buffer_use_rt_dxr10);
@@ -140,7 +142,7 @@ void VisibilityBuffer::render(CapsaicinInternal &capsaicin) noexcept
 
     auto        blue_noise_sampler = capsaicin.getComponent<BlueNoiseSampler>();
     auto const &camera             = capsaicin.getCameraMatrices(
-        capsaicin.hasOption<bool>("taa_enable") && capsaicin.getOption<bool>("taa_enable"));
+        capsaicin.getOptionRegistry().get(taa_enable_option_));
 
     if (!options.visibility_buffer_use_rt)
     {
@@ -353,8 +355,14 @@ void VisibilityBuffer::render(CapsaicinInternal &capsaicin) noexcept
 
             GfxDrawState debug_material_draw_state;
             gfxDrawStateSetColorTarget(debug_material_draw_state, 0, capsaicin.getAOVBuffer("Debug"));
-            debug_material_kernel_ = gfxCreateGraphicsKernel(
-                gfx_, debug_material_program_, debug_material_draw_state, "DebugMaterial");
+            std::vector<std::string>  scene_defines(capsaicin.getSceneShaderDefines());
+            std::vector<char const *> defines;
+            for (auto &i : scene_defines)
+            {
+                defines.push_back(i.c_str());
+            }
+            debug_material_kernel_ = gfxCreateGraphicsKernel(gfx_, debug_material_program_,
+                debug_material_draw_state, "DebugMaterial", defines.data(), (uint32_t)defines.size());
         }
 
         enum class MaterialMode : uint32_t
@@ -479,7 +487,12 @@ bool VisibilityBuffer::initKernel(CapsaicinInternal const &capsaicin) noexcept
         gfxDrawStateSetColorTarget(visibility_buffer_draw_state, 0, capsaicin.getAOVBuffer("Visibility"));
         gfxDrawStateSetColorTarget(visibility_buffer_draw_state, 1, capsaicin.getAOVBuffer("GeometryNormal"));
         gfxDrawStateSetColorTarget(visibility_buffer_draw_state, 2, capsaicin.getAOVBuffer("Velocity"));
+        std::vector<std::string>  scene_defines(capsaicin.getSceneShaderDefines());
         std::vector<char const *> defines;
+        for (auto &i : scene_defines)
+        {
+            defines.push_back(i.c_str());
+        }
         if (capsaicin.hasAOVBuffer("ShadingNormal"))
         {
             gfxDrawStateSetColorTarget(
@@ -507,7 +520,12 @@ bool VisibilityBuffer::initKernel(CapsaicinInternal const &capsaicin) noexcept
     else
     {
         // Initialise the ray tracing variant of visibility buffer kernel
+        std::vector<std::string>  scene_defines(capsaicin.getSceneShaderDefines());
         std::vector<char const *> defines;
+        for (auto &i : scene_defines)
+        {
+            defines.push_back(i.c_str());
+        }
         defines.push_back("HAS_RT");
         if (capsaicin.hasAOVBuffer("ShadingNormal"))
         {
@@ -98,7 +98,10 @@ class VisibilityBuffer : public RenderTechnique
      */
     bool initKernel(CapsaicinInternal const &capsaicin) noexcept;
 
-    RenderOptions options;
+    RenderOptions                     options;
+    RenderOptionsCache<RenderOptions> options_cache_;
+    RenderOptionHandle<bool>          taa_enable_option_; /**< Handle to the TAA option (if TAA is in use) */
+
     GfxKernel     disocclusion_mask_kernel_;
     GfxProgram    disocclusion_mask_program_;
     GfxKernel     visibility_buffer_kernel_;
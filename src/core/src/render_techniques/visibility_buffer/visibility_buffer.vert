@@ -21,6 +21,7 @@ THE SOFTWARE.
 ********************************************************************/
 
 #include "../../gpu_shared.h"
+#include "../../geometry/vertex.hlsl"
 #include "../../math/transform.hlsl"
 
 float4x4 g_ViewProjection;
@@ -56,15 +57,15 @@ Params main(in Vertex vertex, in uint drawID : gfx_DrawID)
     float3x4 transform      = g_TransformBuffer[instance.transform_index];
     float3x4 prev_transform = g_PrevTransformBuffer[instance.transform_index];
 
-    float3 position      = transformPoint(vertex.position.xyz, transform);
-    float3 prev_position = transformPoint(vertex.position.xyz, prev_transform);
+    float3 position      = transformPoint(getVertexPosition(vertex), transform);
+    float3 prev_position = transformPoint(getVertexPosition(vertex), prev_transform);
 
     Params params;
     params.position = mul(g_ViewProjection, float4(position, 1.0f));
 #if defined(HAS_SHADING_NORMAL) || defined(HAS_VERTEX_NORMAL)
-    params.normal     = transformNormal(vertex.normal.xyz, transform);
+    params.normal     = transformNormal(getVertexNormal(vertex), transform);
 #endif
-    params.uv         = vertex.uv;
+    params.uv         = getVertexUV(vertex);
     params.world      = position;
     params.current    = params.position;
     params.previous   = mul(g_PrevViewProjection, float4(prev_position, 1.0f));
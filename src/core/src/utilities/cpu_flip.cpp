@@ -0,0 +1,567 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "cpu_flip.h"
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#    include <emmintrin.h>
+#    define CAPSAICIN_FLIP_SSE 1
+#endif
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr float kPi = 3.14159265358979f;
+
+constexpr float kColorExponent   = 0.7f;   /**< qc, exponent applied to the HyAB colour distance */
+constexpr float kColorBreakpoint = 0.4f;   /**< pc, fraction of the maximum distance remapped below pt */
+constexpr float kColorTarget     = 0.95f;  /**< pt, error given to distances at the breakpoint */
+constexpr float kFeatureWidth    = 0.082f; /**< w, width of the feature detectors (in degrees) */
+constexpr uint  kBandHeight      = 16;     /**< Number of rows filtered by a task */
+
+/** Parameters of the contrast sensitivity function of each YCxCz channel, as a sum of 2 Gaussians. */
+constexpr float kCSFAmplitudes[3][2] = {{1.0f, 0.0f}, {1.0f, 0.0f}, {34.1f, 13.5f}};
+constexpr float kCSFScales[3][2]     = {{0.0047f, 1.0e-5f}, {0.0053f, 1.0e-5f}, {0.04f, 0.025f}};
+
+/** Coefficients of the ACES curve fit used by HDR-FLIP, (ax^2 + bx + c) / (dx^2 + ex + f) with x pre-scaled by 0.6. */
+constexpr float kToneMapping[6] = {0.6f * 0.6f * 2.51f, 0.6f * 0.03f, 0.0f, 0.6f * 0.6f * 2.43f, 0.6f * 0.59f, 0.14f};
+constexpr float kExposureTarget = 0.85f; /**< Tone mapped value of the luminances bounding the HDR-FLIP exposures */
+
+/** Rec709 linear RGB to XYZ. */
+constexpr float kRGBToXYZ[3][3] = {{0.412390799f, 0.357584339f, 0.180480788f},
+    {0.212639006f, 0.715168679f, 0.072192315f}, {0.019330819f, 0.119194780f, 0.950532152f}};
+/** XYZ to Rec709 linear RGB. */
+constexpr float kXYZToRGB[3][3] = {{3.240969942f, -1.537383178f, -0.498610760f},
+    {-0.969243636f, 1.875967502f, 0.041555057f}, {0.055630080f, -0.203976959f, 1.056971514f}};
+/** The D65 reference white, XYZ of linear RGB (1, 1, 1). */
+constexpr float kWhite[3] = {0.950455927f, 1.0f, 1.089057751f};
+
+void Transform(float const (&matrix)[3][3], float const (&input)[3], float (&output)[3]) noexcept
+{
+    for (uint row = 0; row < 3; ++row)
+    {
+        output[row] = matrix[row][0] * input[0] + matrix[row][1] * input[1] + matrix[row][2] * input[2];
+    }
+}
+
+float ToneMap(float value) noexcept
+{
+    float const x = std::max(value, 0.0f);
+    return (x * (kToneMapping[0] * x + kToneMapping[1]) + kToneMapping[2])
+         / (x * (kToneMapping[3] * x + kToneMapping[4]) + kToneMapping[5]);
+}
+
+/**
+ * Gets the value that the tone mapping curve maps to a target, the positive root of
+ * (a - td)x^2 + (b - te)x + (c - tf) = 0.
+ * @param target The tone mapped value.
+ * @returns The value before tone mapping.
+ */
+float InverseToneMap(float target) noexcept
+{
+    float const a = kToneMapping[0] - target * kToneMapping[3];
+    float const b = kToneMapping[1] - target * kToneMapping[4];
+    float const c = kToneMapping[2] - target * kToneMapping[5];
+    return std::max((-b + std::sqrt(b * b - 4.0f * a * c)) / (2.0f * a), 0.0f);
+}
+
+float LabCurve(float value) noexcept
+{
+    float const delta = 6.0f / 29.0f;
+    // pow is faster than cbrt, the value being positive
+    return value > delta * delta * delta ? std::pow(value, 1.0f / 3.0f) : value / (3.0f * delta * delta) + 4.0f / 29.0f;
+}
+
+/**
+ * Convert a XYZ colour to L*a*b* with a Hunt adjusted chroma (a* and b* scaled by 0.01 L*).
+ * @param       xyz The XYZ colour.
+ * @param [out] lab The Hunt adjusted L*a*b* colour.
+ */
+void ConvertToHuntLab(float const (&xyz)[3], float (&lab)[3]) noexcept
+{
+    float const x = LabCurve(xyz[0] / kWhite[0]);
+    float const y = LabCurve(xyz[1] / kWhite[1]);
+    float const z = LabCurve(xyz[2] / kWhite[2]);
+    lab[0]        = 116.0f * y - 16.0f;
+    lab[1]        = 0.01f * lab[0] * 500.0f * (x - y);
+    lab[2]        = 0.01f * lab[0] * 200.0f * (y - z);
+}
+
+/**
+ * Gets the HyAB distance of 2 L*a*b* colours (L1 for lightness and L2 for chroma).
+ * @return The distance.
+ */
+float GetHyAB(float const (&lab0)[3], float const (&lab1)[3]) noexcept
+{
+    float const a = lab0[1] - lab1[1];
+    float const b = lab0[2] - lab1[2];
+    return std::abs(lab0[0] - lab1[0]) + std::sqrt(a * a + b * b);
+}
+
+/**
+ * Gets the filtered colour of a pixel back from YCxCz, clamped to the displayable range, as Hunt adjusted L*a*b*.
+ * @param       ycxcz The filtered YCxCz colour.
+ * @param [out] lab   The Hunt adjusted L*a*b* colour.
+ */
+void ConvertFilteredToHuntLab(float const (&ycxcz)[3], float (&lab)[3]) noexcept
+{
+    float const y      = (ycxcz[0] + 16.0f) / 116.0f;
+    float const xyz[3] = {kWhite[0] * (ycxcz[1] / 500.0f + y), kWhite[1] * y, kWhite[2] * (y - ycxcz[2] / 200.0f)};
+    float       rgb[3];
+    Transform(kXYZToRGB, xyz, rgb);
+    for (float &channel : rgb)
+    {
+        channel = std::clamp(channel, 0.0f, 1.0f);
+    }
+    float clampedXYZ[3];
+    Transform(kRGBToXYZ, rgb, clampedXYZ);
+    ConvertToHuntLab(clampedXYZ, lab);
+}
+
+/**
+ * Convolve a span of values, output[x] = Sum(weights[tap] * inputs[tap][x]).
+ * Taps are added in the same order by the SIMD and the scalar paths so that results don't depend on the path.
+ * @param          inputs     The input values seen by each tap.
+ * @param          weights    The weight of each tap.
+ * @param          tapCount   The number of taps.
+ * @param          count      The number of values.
+ * @param          accumulate True to add the convolution to the output, False to overwrite it.
+ * @param [in,out] output     The convolved values.
+ */
+void Convolve(float const *const *inputs, float const *weights, uint tapCount, uint count, bool accumulate,
+    float *output) noexcept
+{
+    uint x = 0;
+#ifdef CAPSAICIN_FLIP_SSE
+    // Accumulate 8 values in registers over all taps, as 2 independent vectors to hide the addition latency
+    for (; x + 8 <= count; x += 8)
+    {
+        __m128 sum0 = (accumulate ? _mm_loadu_ps(&output[x]) : _mm_setzero_ps());
+        __m128 sum1 = (accumulate ? _mm_loadu_ps(&output[x + 4]) : _mm_setzero_ps());
+        for (uint tap = 0; tap < tapCount; ++tap)
+        {
+            __m128 const weight = _mm_set1_ps(weights[tap]);
+            sum0                = _mm_add_ps(sum0, _mm_mul_ps(weight, _mm_loadu_ps(&inputs[tap][x])));
+            sum1                = _mm_add_ps(sum1, _mm_mul_ps(weight, _mm_loadu_ps(&inputs[tap][x + 4])));
+        }
+        _mm_storeu_ps(&output[x], sum0);
+        _mm_storeu_ps(&output[x + 4], sum1);
+    }
+#endif
+    for (; x < count; ++x)
+    {
+        float sum = (accumulate ? output[x] : 0.0f);
+        for (uint tap = 0; tap < tapCount; ++tap)
+        {
+            sum += weights[tap] * inputs[tap][x];
+        }
+        output[x] = sum;
+    }
+}
+} // unnamed namespace
+
+bool CPUFlip::initialise(float pixelsPerDegree, float exposure) noexcept
+{
+    if (!(pixelsPerDegree > 0.0f))
+    {
+        return false;
+    }
+    exposureScale = std::exp2(exposure);
+
+    // Contrast sensitivity filters, each 2D Gaussian term is separable and the sum of the terms is normalised
+    float const maxScale = std::max({kCSFScales[0][0], kCSFScales[1][0], kCSFScales[2][0], kCSFScales[2][1]});
+    int const   radius   = (int)std::ceil(3.0f * std::sqrt(maxScale / (2.0f * kPi * kPi)) * pixelsPerDegree);
+    for (uint channel = 0; channel < 3; ++channel)
+    {
+        float total = 0.0f;
+        for (uint term = 0; term < 2; ++term)
+        {
+            Kernel &kernel = colorKernels[channel][term];
+            kernel.radius  = radius;
+            kernel.weights.resize(2 * radius + 1);
+            float sum = 0.0f;
+            for (int offset = -radius; offset <= radius; ++offset)
+            {
+                float const degrees = (float)offset / pixelsPerDegree;
+                float const weight  = std::exp(-kPi * kPi * degrees * degrees / kCSFScales[channel][term]);
+                sum += weight;
+                kernel.weights[offset + radius] = weight;
+            }
+            colorWeights[channel][term] =
+                kCSFAmplitudes[channel][term] * std::sqrt(kPi / kCSFScales[channel][term]);
+            total += colorWeights[channel][term] * sum * sum;
+        }
+        for (float &weight : colorWeights[channel])
+        {
+            weight /= total;
+        }
+    }
+
+    // Feature detectors, the Gaussian is normalised and the positive and negative weights of its derivatives
+    // are normalised separately (the sign of a weight only depends on the offset along the derivative)
+    float const deviation     = 0.5f * kFeatureWidth * pixelsPerDegree;
+    int const   featureRadius = (int)std::ceil(3.0f * deviation);
+    for (Kernel *kernel : {&gaussianKernel, &edgeKernel, &pointKernel})
+    {
+        kernel->radius = featureRadius;
+        kernel->weights.resize(2 * featureRadius + 1);
+    }
+    float gaussianSum  = 0.0f;
+    float edgeSums[2]  = {};
+    float pointSums[2] = {};
+    for (int offset = -featureRadius; offset <= featureRadius; ++offset)
+    {
+        float const x        = (float)offset;
+        float const gaussian = std::exp(-x * x / (2.0f * deviation * deviation));
+        float const edge     = -x * gaussian;
+        float const point    = (x * x / (deviation * deviation) - 1.0f) * gaussian;
+
+        gaussianKernel.weights[offset + featureRadius] = gaussian;
+        edgeKernel.weights[offset + featureRadius]     = edge;
+        pointKernel.weights[offset + featureRadius]    = point;
+        gaussianSum += gaussian;
+        edgeSums[edge < 0.0f ? 1 : 0] += std::abs(edge);
+        pointSums[point < 0.0f ? 1 : 0] += std::abs(point);
+    }
+    for (uint i = 0; i < gaussianKernel.weights.size(); ++i)
+    {
+        gaussianKernel.weights[i] /= gaussianSum;
+        edgeKernel.weights[i] /= edgeSums[edgeKernel.weights[i] < 0.0f ? 1 : 0];
+        pointKernel.weights[i] /= pointSums[pointKernel.weights[i] < 0.0f ? 1 : 0];
+    }
+    return true;
+}
+
+bool CPUFlip::compare(float const *sourceImage, float const *referenceImage, uint widthIn, uint heightIn) noexcept
+{
+    if (sourceImage == nullptr || referenceImage == nullptr || widthIn == 0 || heightIn == 0
+        || gaussianKernel.weights.empty())
+    {
+        return false;
+    }
+    width                   = widthIn;
+    height                  = heightIn;
+    size_t const pixelCount = (size_t)width * height;
+    for (auto *planes : {&colorPlanes[0], &colorPlanes[1], &colorPlanes[2], &colorPlanes[3], &colorPlanes[4],
+             &colorPlanes[5], &grayPlanes[0], &grayPlanes[1], &edgePlanes[0], &edgePlanes[1], &pointPlanes[0],
+             &pointPlanes[1], &scratchPlanes[0], &scratchPlanes[1], &scratchPlanes[2], &errorMap})
+    {
+        planes->resize(pixelCount);
+    }
+
+    convertImage(sourceImage, 0);
+    convertImage(referenceImage, 1);
+    for (uint plane = 0; plane < 6; ++plane)
+    {
+        filterColor(plane);
+    }
+    detectFeatures(0);
+    detectFeatures(1);
+
+    // Maximum colour distance, between Hunt adjusted green and blue
+    float green[3];
+    float blue[3];
+    float greenLab[3];
+    float blueLab[3];
+    Transform(kRGBToXYZ, {0.0f, 1.0f, 0.0f}, green);
+    Transform(kRGBToXYZ, {0.0f, 0.0f, 1.0f}, blue);
+    ConvertToHuntLab(green, greenLab);
+    ConvertToHuntLab(blue, blueLab);
+    float const maxDistance = std::pow(GetHyAB(greenLab, blueLab), kColorExponent);
+    float const breakpoint  = kColorBreakpoint * maxDistance;
+
+    ThreadPool::ParallelFor(height, [&](uint y) {
+        for (size_t pixel = (size_t)y * width; pixel < (size_t)(y + 1) * width; ++pixel)
+        {
+            float sourceLab[3];
+            float referenceLab[3];
+            ConvertFilteredToHuntLab({colorPlanes[0][pixel], colorPlanes[1][pixel], colorPlanes[2][pixel]}, sourceLab);
+            ConvertFilteredToHuntLab(
+                {colorPlanes[3][pixel], colorPlanes[4][pixel], colorPlanes[5][pixel]}, referenceLab);
+            float colorError = std::pow(GetHyAB(sourceLab, referenceLab), kColorExponent);
+            colorError       = (colorError < breakpoint
+                                    ? colorError * kColorTarget / breakpoint
+                                    : kColorTarget
+                                    + (colorError - breakpoint) / (maxDistance - breakpoint) * (1.0f - kColorTarget));
+
+            float const featureDifference = std::max(std::abs(edgePlanes[0][pixel] - edgePlanes[1][pixel]),
+                std::abs(pointPlanes[0][pixel] - pointPlanes[1][pixel]));
+            float const featureError = std::sqrt(featureDifference / std::sqrt(2.0f)); // qf = 0.5
+
+            errorMap[pixel] = std::pow(colorError, 1.0f - featureError);
+        }
+    });
+    updateMetricValue();
+    return true;
+}
+
+bool CPUFlip::compareHDR(float const *sourceImage, float const *referenceImage, uint widthIn, uint heightIn) noexcept
+{
+    if (sourceImage == nullptr || referenceImage == nullptr || widthIn == 0 || heightIn == 0
+        || gaussianKernel.weights.empty())
+    {
+        return false;
+    }
+    size_t const pixelCount = (size_t)widthIn * heightIn;
+    luminances.resize(pixelCount);
+    ThreadPool::ParallelFor(heightIn, [&](uint y) {
+        for (size_t pixel = (size_t)y * widthIn; pixel < (size_t)(y + 1) * widthIn; ++pixel)
+        {
+            float luminance = 0.0f;
+            for (uint channel = 0; channel < 3; ++channel)
+            {
+                luminance += kRGBToXYZ[1][channel] * std::max(referenceImage[4 * pixel + channel], 0.0f);
+            }
+            luminances[pixel] = luminance;
+        }
+    });
+    float const maxLuminance = *std::max_element(luminances.begin(), luminances.end());
+    std::nth_element(luminances.begin(), luminances.begin() + pixelCount / 2, luminances.end());
+    float const medianLuminance = luminances[pixelCount / 2];
+
+    // The exposures range from mapping the maximum luminance to mapping the median luminance to the target, at
+    // least one stop apart (a black reference is only compared at its own exposure)
+    float const target        = InverseToneMap(kExposureTarget);
+    float const startExposure = (maxLuminance > 0.0f ? std::log2(target / maxLuminance) : 0.0f);
+    float const stopExposure  = (medianLuminance > 0.0f ? std::log2(target / medianLuminance) : startExposure);
+    uint const  exposureCount = std::max((uint)std::ceil(stopExposure - startExposure), 2u);
+
+    float const savedScale = exposureScale;
+    toneMapping            = true;
+    hdrErrorMap.assign(pixelCount, 0.0f);
+    for (uint exposure = 0; exposure < exposureCount; ++exposure)
+    {
+        exposureScale = std::exp2(
+            startExposure + (stopExposure - startExposure) * (float)exposure / (float)(exposureCount - 1));
+        compare(sourceImage, referenceImage, widthIn, heightIn);
+        ThreadPool::ParallelFor(heightIn, [&](uint y) {
+            for (size_t pixel = (size_t)y * widthIn; pixel < (size_t)(y + 1) * widthIn; ++pixel)
+            {
+                hdrErrorMap[pixel] = std::max(hdrErrorMap[pixel], errorMap[pixel]);
+            }
+        });
+    }
+    toneMapping   = false;
+    exposureScale = savedScale;
+    errorMap.swap(hdrErrorMap);
+    updateMetricValue();
+    return true;
+}
+
+float CPUFlip::getMetricValue() const noexcept
+{
+    return currentValue;
+}
+
+std::vector<float> const &CPUFlip::getErrorMap() const noexcept
+{
+    return errorMap;
+}
+
+bool CPUFlip::getTileHistograms(uint tileSize, uint binCount, std::vector<uint> &histograms) const noexcept
+{
+    if (tileSize == 0 || binCount == 0 || errorMap.empty())
+    {
+        return false;
+    }
+    uint const tileCountX = (width + tileSize - 1) / tileSize;
+    uint const tileCountY = (height + tileSize - 1) / tileSize;
+    histograms.assign((size_t)tileCountX * tileCountY * binCount, 0);
+    ThreadPool::ParallelFor(
+        tileCountY,
+        [&](uint tileY) {
+            uint const rowEnd = std::min((tileY + 1) * tileSize, height);
+            for (uint y = tileY * tileSize; y < rowEnd; ++y)
+            {
+                float const *errors = &errorMap[(size_t)y * width];
+                for (uint x = 0; x < width; ++x)
+                {
+                    uint const bin = std::min((uint)(std::max(errors[x], 0.0f) * (float)binCount), binCount - 1);
+                    ++histograms[((size_t)tileY * tileCountX + x / tileSize) * binCount + bin];
+                }
+            }
+        },
+        1);
+    return true;
+}
+
+void CPUFlip::updateMetricValue() noexcept
+{
+    rowSums.resize(height);
+    ThreadPool::ParallelFor(height, [&](uint y) {
+        double sum = 0.0;
+        for (size_t pixel = (size_t)y * width; pixel < (size_t)(y + 1) * width; ++pixel)
+        {
+            sum += errorMap[pixel];
+        }
+        rowSums[y] = sum;
+    });
+
+    // Rows are summed in order so that the result doesn't depend on the thread count
+    double sum = 0.0;
+    for (double const rowSum : rowSums)
+    {
+        sum += rowSum;
+    }
+    currentValue = (float)(sum / ((double)width * height));
+}
+
+void CPUFlip::convertImage(float const *image, uint index) noexcept
+{
+    ThreadPool::ParallelFor(height, [&](uint y) {
+        for (size_t pixel = (size_t)y * width; pixel < (size_t)(y + 1) * width; ++pixel)
+        {
+            float rgb[3];
+            for (uint channel = 0; channel < 3; ++channel)
+            {
+                float const value = image[4 * pixel + channel] * exposureScale;
+                rgb[channel]      = std::clamp(toneMapping ? ToneMap(value) : value, 0.0f, 1.0f);
+            }
+            float xyz[3];
+            Transform(kRGBToXYZ, rgb, xyz);
+            float const normalizedY          = xyz[1] / kWhite[1];
+            colorPlanes[3 * index][pixel]     = 116.0f * normalizedY - 16.0f;
+            colorPlanes[3 * index + 1][pixel] = 500.0f * (xyz[0] / kWhite[0] - normalizedY);
+            colorPlanes[3 * index + 2][pixel] = 200.0f * (normalizedY - xyz[2] / kWhite[2]);
+            grayPlanes[index][pixel]          = normalizedY;
+        }
+    });
+}
+
+void CPUFlip::filterColor(uint plane) noexcept
+{
+    uint const channel = plane % 3;
+    float     *values  = colorPlanes[plane].data();
+    filterRows(values, scratchPlanes[0].data(), colorKernels[channel][0]);
+    bool const secondTerm = colorWeights[channel][1] != 0.0f;
+    if (secondTerm)
+    {
+        filterRows(values, scratchPlanes[1].data(), colorKernels[channel][1]);
+    }
+
+    // The weight of each term is folded into its vertical pass
+    Kernel kernel = colorKernels[channel][0];
+    for (float &weight : kernel.weights)
+    {
+        weight *= colorWeights[channel][0];
+    }
+    filterColumns(scratchPlanes[0].data(), values, kernel, false);
+    if (secondTerm)
+    {
+        kernel = colorKernels[channel][1];
+        for (float &weight : kernel.weights)
+        {
+            weight *= colorWeights[channel][1];
+        }
+        filterColumns(scratchPlanes[1].data(), values, kernel, true);
+    }
+}
+
+void CPUFlip::detectFeatures(uint index) noexcept
+{
+    float *edges  = edgePlanes[index].data();
+    float *points = pointPlanes[index].data();
+    filterRows(grayPlanes[index].data(), scratchPlanes[0].data(), edgeKernel);
+    filterRows(grayPlanes[index].data(), scratchPlanes[1].data(), gaussianKernel);
+    filterRows(grayPlanes[index].data(), scratchPlanes[2].data(), pointKernel);
+
+    // Edges, the gradient along X then along Y (held in the point plane until combined)
+    filterColumns(scratchPlanes[0].data(), edges, gaussianKernel, false);
+    filterColumns(scratchPlanes[1].data(), points, edgeKernel, false);
+    ThreadPool::ParallelFor(height, [&](uint y) {
+        for (size_t pixel = (size_t)y * width; pixel < (size_t)(y + 1) * width; ++pixel)
+        {
+            edges[pixel] = std::sqrt(edges[pixel] * edges[pixel] + points[pixel] * points[pixel]);
+        }
+    });
+
+    // Points, the second derivative along X then along Y
+    filterColumns(scratchPlanes[2].data(), scratchPlanes[0].data(), gaussianKernel, false);
+    filterColumns(scratchPlanes[1].data(), points, pointKernel, false);
+    float const *pointsX = scratchPlanes[0].data();
+    ThreadPool::ParallelFor(height, [&](uint y) {
+        for (size_t pixel = (size_t)y * width; pixel < (size_t)(y + 1) * width; ++pixel)
+        {
+            points[pixel] = std::sqrt(pointsX[pixel] * pointsX[pixel] + points[pixel] * points[pixel]);
+        }
+    });
+}
+
+void CPUFlip::filterRows(float const *source, float *destination, Kernel const &kernel) const noexcept
+{
+    uint const bandCount = (height + kBandHeight - 1) / kBandHeight;
+    ThreadPool::ParallelFor(
+        bandCount,
+        [&](uint band) {
+            // Rows are copied with the pixels outside the image clamped to the edges, so that every tap of a pixel
+            // is at a constant offset from it
+            uint const                 tapCount = 2 * kernel.radius + 1;
+            std::vector<float>         paddedRow(width + tapCount - 1);
+            std::vector<float const *> taps(tapCount);
+            for (uint tap = 0; tap < tapCount; ++tap)
+            {
+                taps[tap] = &paddedRow[tap];
+            }
+            uint const rowEnd = std::min((band + 1) * kBandHeight, height);
+            for (uint y = band * kBandHeight; y < rowEnd; ++y)
+            {
+                float const *input = &source[(size_t)y * width];
+                for (uint x = 0; x < paddedRow.size(); ++x)
+                {
+                    paddedRow[x] = input[std::clamp((int)x - kernel.radius, 0, (int)width - 1)];
+                }
+                Convolve(taps.data(), kernel.weights.data(), tapCount, width, false, &destination[(size_t)y * width]);
+            }
+        },
+        1);
+}
+
+void CPUFlip::filterColumns(
+    float const *source, float *destination, Kernel const &kernel, bool accumulate) const noexcept
+{
+    uint const bandCount = (height + kBandHeight - 1) / kBandHeight;
+    ThreadPool::ParallelFor(
+        bandCount,
+        [&](uint band) {
+            // Rows outside the image are clamped to the edges
+            uint const                 tapCount = 2 * kernel.radius + 1;
+            std::vector<float const *> taps(tapCount);
+            uint const                 rowEnd = std::min((band + 1) * kBandHeight, height);
+            for (uint y = band * kBandHeight; y < rowEnd; ++y)
+            {
+                for (uint tap = 0; tap < tapCount; ++tap)
+                {
+                    int const row = std::clamp((int)y + (int)tap - kernel.radius, 0, (int)height - 1);
+                    taps[tap]     = &source[(size_t)row * width];
+                }
+                Convolve(
+                    taps.data(), kernel.weights.data(), tapCount, width, accumulate, &destination[(size_t)y * width]);
+            }
+        },
+        1);
+}
+} // namespace Capsaicin
@@ -0,0 +1,139 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "gpu_shared.h"
+
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Multithreaded perceptual difference of images on the host, following LDR-FLIP (Andersson et al. 2020).
+ * Colour differences are measured in a Hunt adjusted L*a*b* space after filtering both images with the contrast
+ * sensitivity of the eye, then amplified where edges and points differ. Errors are in [0,1], 0 meaning identical.
+ * Images are tightly packed rows of 4 floats per pixel holding linear RGB values, they are scaled by the exposure and
+ * clamped to [0,1] so HDR images should either be compared at the exposure they are displayed at or with HDR-FLIP
+ * (Andersson et al. 2021), the maximum error over the exposures spanning the range of the reference.
+ */
+class CPUFlip
+{
+public:
+    /** Pixels per degree of a 0.7m wide 4K monitor seen from 0.7m, the default of the FLIP reference. */
+    static constexpr float kDefaultPixelsPerDegree = 67.0f;
+
+    /**
+     * Initialise the internal data based on current configuration.
+     * @param pixelsPerDegree The number of pixels per degree of visual angle, from the display size and distance.
+     * @param exposure        The exposure (in stops) applied to both images before they are clamped.
+     * @return True, if any initialisation/changes succeeded.
+     */
+    bool initialise(float pixelsPerDegree = kDefaultPixelsPerDegree, float exposure = 0.0f) noexcept;
+
+    /**
+     * Generate the error map of 2 different images.
+     * @param sourceImage    The input image to compare (width * height RGBA pixels).
+     * @param referenceImage The reference image to compare to (width * height RGBA pixels).
+     * @param width          The width of both images.
+     * @param height         The height of both images.
+     * @returns True, if operation succeeded.
+     */
+    bool compare(float const *sourceImage, float const *referenceImage, uint width, uint height) noexcept;
+
+    /**
+     * Generate the HDR-FLIP error map of 2 different HDR images.
+     * Both images are tone mapped at exposures ranging from the one mapping the maximum luminance of the reference
+     * to the one mapping its median luminance, the initialised exposure is ignored.
+     * @param sourceImage    The input image to compare (width * height RGBA pixels).
+     * @param referenceImage The reference image to compare to (width * height RGBA pixels).
+     * @param width          The width of both images.
+     * @param height         The height of both images.
+     * @returns True, if operation succeeded.
+     */
+    bool compareHDR(float const *sourceImage, float const *referenceImage, uint width, uint height) noexcept;
+
+    /**
+     * Read back the mean error of the most recent comparison.
+     * @returns The mean error, Zero if no image was compared.
+     */
+    float getMetricValue() const noexcept;
+
+    /**
+     * Get the per-pixel errors of the most recent comparison.
+     * @returns The error of each pixel in row order (width * height values).
+     */
+    std::vector<float> const &getErrorMap() const noexcept;
+
+    /**
+     * Build the error histogram of each tile of the most recent comparison.
+     * @param       tileSize   The width and height of the tiles (in pixels), tiles on the right and bottom edges may be
+     *                         smaller.
+     * @param       binCount   The number of bins evenly dividing the [0,1] range of errors.
+     * @param [out] histograms The pixel count of each bin, in row order of tiles (binCount values per tile).
+     * @return True, if operation succeeded.
+     */
+    bool getTileHistograms(uint tileSize, uint binCount, std::vector<uint> &histograms) const noexcept;
+
+private:
+    /** A separable 1D filter kernel. */
+    struct Kernel
+    {
+        std::vector<float> weights; /**< The 2 * radius + 1 weights */
+        int                radius = 0;
+    };
+
+    void convertImage(float const *image, uint index) noexcept;
+
+    void filterColor(uint plane) noexcept;
+
+    void detectFeatures(uint index) noexcept;
+
+    void filterRows(float const *source, float *destination, Kernel const &kernel) const noexcept;
+
+    void filterColumns(
+        float const *source, float *destination, Kernel const &kernel, bool accumulate) const noexcept;
+
+    void updateMetricValue() noexcept;
+
+    float exposureScale = 1.0f;
+    bool  toneMapping   = false; /**< True to tone map the images after scaling them by the exposure */
+    uint  width         = 0;
+    uint  height        = 0;
+    float currentValue  = 0.0f; /**< Most recent calculated mean error */
+
+    Kernel colorKernels[3][2]; /**< The terms of the contrast sensitivity filter of each YCxCz channel */
+    float  colorWeights[3][2]; /**< The weight of each term of the contrast sensitivity filters */
+    Kernel gaussianKernel;     /**< Feature detection Gaussian */
+    Kernel edgeKernel;         /**< Feature detection Gaussian first derivative */
+    Kernel pointKernel;        /**< Feature detection Gaussian second derivative */
+
+    std::vector<float>  colorPlanes[6];   /**< YCxCz channels of the source then reference image */
+    std::vector<float>  grayPlanes[2];    /**< Achromatic values of the source and reference image */
+    std::vector<float>  edgePlanes[2];    /**< Edge magnitude of the source and reference image */
+    std::vector<float>  pointPlanes[2];   /**< Point magnitude of the source and reference image */
+    std::vector<float>  scratchPlanes[3]; /**< Intermediate filtering results */
+    std::vector<float>  errorMap;         /**< Per-pixel error */
+    std::vector<float>  hdrErrorMap;      /**< Maximum per-pixel error over the exposures of HDR-FLIP */
+    std::vector<float>  luminances;       /**< Luminance of the reference image pixels */
+    std::vector<double> rowSums;          /**< Sum of the errors of each row */
+};
+} // namespace Capsaicin
@@ -0,0 +1,412 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "cpu_image_metrics.h"
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace Capsaicin
+{
+namespace
+{
+using Type      = CPUImageMetrics::Type;
+using Operation = CPUImageMetrics::Operation;
+
+constexpr int    kWindowRadius      = 5;  /**< Offset of the centre of the SSIM window */
+constexpr int    kWindowSize        = 11; /**< Width and height of the SSIM window */
+constexpr uint   kMomentCount       = 5;  /**< Window moments needed by SSIM (I, R, I^2, R^2, I*R) */
+constexpr uint   kBandHeight        = 64; /**< Number of SSIM rows computed by a task */
+constexpr double kSumSquaredWeights = 0.0353944717; /**< The sum of the squared window weights */
+
+/**
+ * Gets the 1D Gaussian (sigma=1.5) whose outer product is the normalised SSIM window used by the shader.
+ * @return The weights of each window offset.
+ */
+std::array<double, kWindowSize> const &GetGaussianWeights() noexcept
+{
+    static std::array<double, kWindowSize> const weights = [] {
+        std::array<double, kWindowSize> gaussian {};
+        double                          sum = 0.0;
+        for (int i = 0; i < kWindowSize; ++i)
+        {
+            double const offset = (double)(i - kWindowRadius);
+            gaussian[i]         = std::exp(-offset * offset / (2.0 * 1.5 * 1.5));
+            sum += gaussian[i];
+        }
+        for (double &weight : gaussian)
+        {
+            weight /= sum;
+        }
+        return gaussian;
+    }();
+    return weights;
+}
+
+float EncodeSRGB(float value) noexcept
+{
+    return value < 0.0031308f ? 12.92f * value : 1.055f * std::pow(std::abs(value), 1.0f / 2.4f) - 0.055f;
+}
+
+float DecodePQEOTF(float value) noexcept
+{
+    float const c1    = 0.8359375f;
+    float const c2    = 18.8515625f;
+    float const c3    = 18.6875f;
+    float const m1    = 0.1593017578125f;
+    float const m2    = 78.84375f;
+    float const powM1 = std::pow(value, m1);
+    return std::pow((c1 + c2 * powM1) / (1.0f + c3 * powM1), m2);
+}
+
+/**
+ * Gets the value of a pixel that metrics operate on, as GetImageValues() of the shader.
+ * @param pixel The RGBA pixel.
+ * @param type  The type of data in the image.
+ * @return The luma (or single channel) value, PQ encoded for HDR types.
+ */
+float GetImageValue(float const *pixel, Type type) noexcept
+{
+    bool const hdr = (type == Type::HDR || type == Type::HDR_RGB);
+    float      value;
+    if (type == Type::HDR_RGB || type == Type::SDR_RGB || type == Type::SDR_SRGB)
+    {
+        float rgb[3] = {pixel[0], pixel[1], pixel[2]};
+        if (!hdr)
+        {
+            // Luma operates on gamma corrected values, sRGB values are read linearised so are converted back
+            for (float &channel : rgb)
+            {
+                channel = EncodeSRGB(channel);
+            }
+        }
+        value = 0.2126f * rgb[0] + 0.7152f * rgb[1] + 0.0722f * rgb[2];
+    }
+    else
+    {
+        value = (type == Type::SDR ? EncodeSRGB(pixel[0]) : pixel[0]);
+    }
+    return hdr ? DecodePQEOTF(value) : value;
+}
+
+/**
+ * Gets the per-pixel metric summed over the image.
+ * @param input     The value of the source pixel.
+ * @param reference The value of the reference pixel.
+ * @return The pixel error.
+ */
+template<Operation OP>
+float GetPixelMetric(float input, float reference) noexcept
+{
+    float const difference = reference - input;
+    if constexpr (OP == Operation::RMAE)
+    {
+        return reference != 0.0f ? std::abs(difference) / reference : 0.0f;
+    }
+    else if constexpr (OP == Operation::SMAPE)
+    {
+        float const divisor = (std::abs(reference) + std::abs(input)) / 2.0f;
+        return divisor != 0.0f ? std::abs(difference) / divisor : 0.0f;
+    }
+    else
+    {
+        return difference * difference;
+    }
+}
+
+/**
+ * Sum the per-pixel metric of every row.
+ * @param       sourceImage    The input image.
+ * @param       referenceImage The reference image.
+ * @param       width          The width of the images.
+ * @param       height         The height of the images.
+ * @param       type           The type of data in the images.
+ * @param [out] rowSums        The sum of each row.
+ */
+template<Operation OP>
+void SumRows(float const *sourceImage, float const *referenceImage, uint width, uint height, Type type,
+    double *rowSums) noexcept
+{
+    ThreadPool::ParallelFor(height, [&](uint y) {
+        size_t const rowOffset = (size_t)y * width * 4;
+        double       sum       = 0.0;
+        for (uint x = 0; x < width; ++x)
+        {
+            float const input     = GetImageValue(&sourceImage[rowOffset + 4 * x], type);
+            float const reference = GetImageValue(&referenceImage[rowOffset + 4 * x], type);
+            sum += (double)GetPixelMetric<OP>(input, reference);
+        }
+        rowSums[y] = sum;
+    });
+}
+
+/**
+ * Sum values in order so that the result doesn't depend on the thread count that produced them.
+ * @param values The values to sum.
+ * @return The sum.
+ */
+double SumInOrder(std::vector<double> const &values) noexcept
+{
+    double sum = 0.0;
+    for (double const value : values)
+    {
+        sum += value;
+    }
+    return sum;
+}
+
+/**
+ * Filter a row of the images horizontally to get the moments of the SSIM window.
+ * Taps outside the image are skipped, the window being clamped rather than renormalised at image edges.
+ * @param       input     The source values of the row.
+ * @param       reference The reference values of the row.
+ * @param       width     The width of the row.
+ * @param [out] moments   The kMomentCount filtered rows (I, R, I^2, R^2, I*R).
+ */
+void FilterRow(float const *input, float const *reference, uint width, double *moments) noexcept
+{
+    auto const &weights = GetGaussianWeights();
+    double     *meanI   = moments;
+    double     *meanR   = moments + width;
+    double     *sqI     = moments + 2 * width;
+    double     *sqR     = moments + 3 * width;
+    double     *crossIR = moments + 4 * width;
+    std::fill_n(moments, kMomentCount * width, 0.0);
+    for (int tap = 0; tap < kWindowSize; ++tap)
+    {
+        // Loop over the destination pixels with a valid tap so that the inner loop vectorises
+        int const    offset = tap - kWindowRadius;
+        uint const   begin  = (uint)std::max(-offset, 0);
+        uint const   end    = (uint)std::clamp((int)width - offset, 0, (int)width);
+        double const weight = weights[tap];
+        for (uint x = begin; x < end; ++x)
+        {
+            double const valueI = input[x + offset];
+            double const valueR = reference[x + offset];
+            meanI[x] += weight * valueI;
+            meanR[x] += weight * valueR;
+            sqI[x] += weight * valueI * valueI;
+            sqR[x] += weight * valueR * valueR;
+            crossIR[x] += weight * valueI * valueR;
+        }
+    }
+}
+} // unnamed namespace
+
+bool CPUImageMetrics::initialise(Type type, Operation operation) noexcept
+{
+    if (type > Type::SDR_SRGB || operation > Operation::SSIM)
+    {
+        return false;
+    }
+    currentType      = type;
+    currentOperation = operation;
+    return true;
+}
+
+bool CPUImageMetrics::compare(
+    float const *sourceImage, float const *referenceImage, uint width, uint height) noexcept
+{
+    if (sourceImage == nullptr || referenceImage == nullptr || width == 0 || height == 0)
+    {
+        return false;
+    }
+
+    rowSums.resize(height);
+    switch (currentOperation)
+    {
+    case Operation::RMAE:
+        SumRows<Operation::RMAE>(sourceImage, referenceImage, width, height, currentType, rowSums.data());
+        break;
+    case Operation::SMAPE:
+        SumRows<Operation::SMAPE>(sourceImage, referenceImage, width, height, currentType, rowSums.data());
+        break;
+    case Operation::SSIM:
+        convertImages(sourceImage, referenceImage, width, height);
+        sumStructuralSimilarity(width, height);
+        break;
+    default: SumRows<Operation::MSE>(sourceImage, referenceImage, width, height, currentType, rowSums.data()); break;
+    }
+
+    currentValue = convertMetric(SumInOrder(rowSums), width * height);
+    return true;
+}
+
+bool CPUImageMetrics::compareTemporal(
+    float const *sourceImage, float const *referenceImage, uint width, uint height) noexcept
+{
+    if (sourceImage == nullptr || referenceImage == nullptr || width == 0 || height == 0)
+    {
+        return false;
+    }
+
+    convertImages(sourceImage, referenceImage, width, height);
+    bool const hasPrevious = (previousWidth == width && previousSourceValues.size() == sourceValues.size());
+    if (hasPrevious)
+    {
+        rowSums.resize(height);
+        ThreadPool::ParallelFor(height, [&](uint y) {
+            double sum = 0.0;
+            for (size_t pixel = (size_t)y * width; pixel < (size_t)(y + 1) * width; ++pixel)
+            {
+                float const instability = (sourceValues[pixel] - previousSourceValues[pixel])
+                                        - (referenceValues[pixel] - previousReferenceValues[pixel]);
+                sum += (double)(instability * instability);
+            }
+            rowSums[y] = sum;
+        });
+        currentValue = (float)std::sqrt(SumInOrder(rowSums) / ((double)width * height));
+    }
+
+    // The values of this frame are kept for the next one
+    std::swap(sourceValues, previousSourceValues);
+    std::swap(referenceValues, previousReferenceValues);
+    previousWidth = width;
+    return hasPrevious;
+}
+
+void CPUImageMetrics::resetTemporal() noexcept
+{
+    previousSourceValues.clear();
+    previousReferenceValues.clear();
+    previousWidth = 0;
+}
+
+float CPUImageMetrics::getMetricValue() const noexcept
+{
+    return currentValue;
+}
+
+void CPUImageMetrics::convertImages(
+    float const *sourceImage, float const *referenceImage, uint width, uint height) noexcept
+{
+    size_t const pixelCount = (size_t)width * height;
+    sourceValues.resize(pixelCount);
+    referenceValues.resize(pixelCount);
+    ThreadPool::ParallelFor(height, [&](uint y) {
+        size_t const rowOffset = (size_t)y * width;
+        for (uint x = 0; x < width; ++x)
+        {
+            sourceValues[rowOffset + x]    = GetImageValue(&sourceImage[4 * (rowOffset + x)], currentType);
+            referenceValues[rowOffset + x] = GetImageValue(&referenceImage[4 * (rowOffset + x)], currentType);
+        }
+    });
+}
+
+void CPUImageMetrics::sumStructuralSimilarity(uint width, uint height) noexcept
+{
+    // The 2D window is separable so moments are filtered horizontally once per row and then vertically, instead
+    // of the 121 taps per pixel of the shader. The weighted variance Sum(w(v - mean)^2) is expanded as
+    // Sum(w v^2) - 2 mean^2 + mean^2 Sum(w), accurate enough in double precision
+    auto const         &weights = GetGaussianWeights();
+    std::vector<double> columnWeights(width, 0.0);
+    for (uint x = 0; x < width; ++x)
+    {
+        for (int tap = 0; tap < kWindowSize; ++tap)
+        {
+            int const column = (int)x + tap - kWindowRadius;
+            columnWeights[x] += (column >= 0 && column < (int)width ? weights[tap] : 0.0);
+        }
+    }
+
+    uint const bandCount = (height + kBandHeight - 1) / kBandHeight;
+    ThreadPool::ParallelFor(
+        bandCount,
+        [&](uint band) {
+            // Filtered rows are kept in a ring indexed by row modulo the window size, so that each row of a band
+            // (and of its halo) is filtered once
+            std::vector<double> filteredRows((size_t)kWindowSize * kMomentCount * width);
+            std::vector<double> windowMoments((size_t)kMomentCount * width);
+            uint const          bandBegin = band * kBandHeight;
+            uint const          bandEnd   = std::min(bandBegin + kBandHeight, height);
+            uint                nextRow   = (uint)std::max((int)bandBegin - kWindowRadius, 0);
+            for (uint y = bandBegin; y < bandEnd; ++y)
+            {
+                uint const firstRow = (uint)std::max((int)y - kWindowRadius, 0);
+                uint const lastRow  = std::min(y + kWindowRadius, height - 1);
+                for (; nextRow <= lastRow; ++nextRow)
+                {
+                    size_t const rowOffset = (size_t)nextRow * width;
+                    FilterRow(&sourceValues[rowOffset], &referenceValues[rowOffset], width,
+                        &filteredRows[(size_t)(nextRow % kWindowSize) * kMomentCount * width]);
+                }
+
+                std::fill(windowMoments.begin(), windowMoments.end(), 0.0);
+                double rowWeight = 0.0;
+                for (uint row = firstRow; row <= lastRow; ++row)
+                {
+                    double const  weight   = weights[row + kWindowRadius - y];
+                    double const *filtered = &filteredRows[(size_t)(row % kWindowSize) * kMomentCount * width];
+                    rowWeight += weight;
+                    for (size_t i = 0; i < windowMoments.size(); ++i)
+                    {
+                        windowMoments[i] += weight * filtered[i];
+                    }
+                }
+
+                double const c1  = 0.01 * 0.01;
+                double const c2  = 0.03 * 0.03;
+                double       sum = 0.0;
+                for (uint x = 0; x < width; ++x)
+                {
+                    double const meanI     = windowMoments[x];
+                    double const meanR     = windowMoments[width + x];
+                    double const remainder = 2.0 - columnWeights[x] * rowWeight;
+                    double const varianceI = std::max(
+                        (windowMoments[2 * width + x] - remainder * meanI * meanI) / (1.0 - kSumSquaredWeights), 0.0);
+                    double const varianceR = std::max(
+                        (windowMoments[3 * width + x] - remainder * meanR * meanR) / (1.0 - kSumSquaredWeights), 0.0);
+                    double const crossCorrelation =
+                        (windowMoments[4 * width + x] - remainder * meanI * meanR) / (1.0 - kSumSquaredWeights);
+                    sum += ((2.0 * meanI * meanR + c1) * (2.0 * crossCorrelation + c2))
+                         / ((meanI * meanI + meanR * meanR + c1) * (varianceI + varianceR + c2));
+                }
+                rowSums[y] = sum;
+            }
+        },
+        1);
+}
+
+float CPUImageMetrics::convertMetric(double value, uint totalSamples) const noexcept
+{
+    double ret = value / static_cast<double>(totalSamples);
+    switch (currentOperation)
+    {
+    case Operation::RMSE:
+        // RMSE = sqrt(MSE)
+        ret = sqrt(ret);
+        break;
+    case Operation::PSNR:
+        // PSNR = 20log10(MaxValue) - 10log10(MSE), MaxValue is 1 for normalised HDR values and 255 for 8bit ones
+        ret = (currentType == Type::HDR || currentType == Type::HDR_RGB ? 0.0 : 48.13080361) - 10.0 * log10(ret);
+        break;
+    case Operation::SMAPE:
+        // SMAPE = [100/(width*height)]Sum(Abs(Ref.x.y - Src.x.y)/([abs(Ref.x.y)+Abs(Src.x.y)]/2)
+        ret *= 100.0;
+        break;
+    default: break;
+    }
+    return static_cast<float>(ret);
+}
+} // namespace Capsaicin
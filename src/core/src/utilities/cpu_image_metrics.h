@@ -0,0 +1,103 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "gpu_image_metrics.h"
+
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Multithreaded comparison of images on the host, covering the same types and operations as GPUImageMetrics.
+ * Images are tightly packed rows of 4 floats per pixel (RGBA), single channel types only read the first channel and
+ * sRGB images must hold the linearised values that a sRGB texture read returns.
+ * Pixel values are converted in single precision as in the shader, while sums and SSIM windows are accumulated in
+ * double precision in row order so that results don't depend on the thread count. Results match the GPU to within
+ * a relative error of 1e-4 (the GPU float reduction being the main source of difference).
+ */
+class CPUImageMetrics
+{
+public:
+    using Type      = GPUImageMetrics::Type;
+    using Operation = GPUImageMetrics::Operation;
+
+    /**
+     * Initialise the internal data based on current configuration.
+     * @param type      The type of data in the images.
+     * @param operation The type of operation to perform.
+     * @return True, if any initialisation/changes succeeded.
+     */
+    bool initialise(Type type, Operation operation) noexcept;
+
+    /**
+     * Generate comparison metrics for 2 different images.
+     * @param sourceImage    The input image to compare (width * height RGBA pixels).
+     * @param referenceImage The reference image to compare to (width * height RGBA pixels).
+     * @param width          The width of both images.
+     * @param height         The height of both images.
+     * @returns True, if operation succeeded.
+     */
+    bool compare(float const *sourceImage, float const *referenceImage, uint width, uint height) noexcept;
+
+    /**
+     * Measure the temporal instability (flicker) of a frame of a sequence, as the RMS of the change of the source
+     * since the previous frame that isn't in the change of the reference, so that animation and camera motion aren't
+     * counted. Pixel values are converted as for the current type, the current operation isn't used.
+     * @param sourceImage    The input frame (width * height RGBA pixels).
+     * @param referenceImage The reference frame (width * height RGBA pixels).
+     * @param width          The width of both images.
+     * @param height         The height of both images.
+     * @returns True, if a value was calculated (False on the first frame of a sequence).
+     */
+    bool compareTemporal(float const *sourceImage, float const *referenceImage, uint width, uint height) noexcept;
+
+    /**
+     * Start a new sequence, the next frame passed to 'compareTemporal' being its first frame.
+     */
+    void resetTemporal() noexcept;
+
+    /**
+     * Read back the value of the most recent calculated metric.
+     * @returns The calculate metric value.
+     */
+    float getMetricValue() const noexcept;
+
+private:
+    void convertImages(float const *sourceImage, float const *referenceImage, uint width, uint height) noexcept;
+
+    void sumStructuralSimilarity(uint width, uint height) noexcept;
+
+    float convertMetric(double value, uint totalSamples) const noexcept;
+
+    Type      currentType      = Type::HDR_RGB;
+    Operation currentOperation = Operation::RMSE;
+    float     currentValue     = 1.0f; /**< Most recent calculated metric value */
+
+    std::vector<float>  sourceValues;            /**< Per-pixel values of the source image, for SSIM and flicker */
+    std::vector<float>  referenceValues;         /**< Per-pixel values of the reference image, for SSIM and flicker */
+    std::vector<float>  previousSourceValues;    /**< Per-pixel values of the previous source frame */
+    std::vector<float>  previousReferenceValues; /**< Per-pixel values of the previous reference frame */
+    uint                previousWidth = 0;       /**< Width of the previous frame, 0 at the start of a sequence */
+    std::vector<double> rowSums;                 /**< Sum of the per-pixel metric of each row */
+};
+} // namespace Capsaicin
@@ -0,0 +1,361 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "cpu_reduce.h"
+
+#include "parallel_algorithms.h"
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace Capsaicin
+{
+namespace
+{
+using Operation = CPUReduce::Operation;
+using Summation = CPUReduce::Summation;
+
+/** Number of scalars reduced at once in independent lanes, a multiple of both the SIMD and the element widths */
+template<uint COMPONENTS>
+constexpr uint kLaneCount = (COMPONENTS == 3 ? 12 : 16);
+
+/** Number of elements below which pairwise summation sums its lanes directly */
+constexpr uint kPairwiseBaseSize = 128;
+
+template<typename T, Operation OP>
+T Identity() noexcept
+{
+    if constexpr (OP == Operation::Sum)
+    {
+        return T(0);
+    }
+    else if constexpr (OP == Operation::Product)
+    {
+        return T(1);
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        return std::numeric_limits<T>::quiet_NaN(); // ignored by min/max
+    }
+    else
+    {
+        return (OP == Operation::Min ? std::numeric_limits<T>::max() : std::numeric_limits<T>::lowest());
+    }
+}
+
+template<typename T, Operation OP>
+T Combine(T a, T b) noexcept
+{
+    if constexpr (std::is_integral_v<T> && (OP == Operation::Sum || OP == Operation::Product))
+    {
+        // Wrap around on overflow as the GPU does
+        using Unsigned = std::make_unsigned_t<T>;
+        return (T)(OP == Operation::Sum ? (Unsigned)a + (Unsigned)b : (Unsigned)a * (Unsigned)b);
+    }
+    else if constexpr (OP == Operation::Sum)
+    {
+        return a + b;
+    }
+    else if constexpr (OP == Operation::Product)
+    {
+        return a * b;
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        // Return the other value if either one is NaN, as HLSL min/max
+        return (OP == Operation::Min ? (b < a || a != a) : (b > a || a != a)) ? b : a;
+    }
+    else
+    {
+        return (OP == Operation::Min ? (b < a) : (b > a)) ? b : a;
+    }
+}
+
+/**
+ * Reduce elements in independent lanes, then combine the lanes of each component in order.
+ * @param       values The elements (COMPONENTS scalars each).
+ * @param       count  The number of elements.
+ * @param [out] result The reduced value of each component.
+ */
+template<typename T, uint COMPONENTS, Operation OP>
+void ReduceLanes(T const *values, size_t count, T *result) noexcept
+{
+    constexpr uint kLanes = kLaneCount<COMPONENTS>;
+    T              lanes[kLanes];
+    std::fill_n(lanes, kLanes, Identity<T, OP>());
+    size_t const scalarCount = count * COMPONENTS;
+    size_t       i           = 0;
+    for (; i + kLanes <= scalarCount; i += kLanes)
+    {
+        for (uint lane = 0; lane < kLanes; ++lane)
+        {
+            lanes[lane] = Combine<T, OP>(lanes[lane], values[i + lane]);
+        }
+    }
+    for (uint lane = 0; i < scalarCount; ++i, ++lane)
+    {
+        lanes[lane] = Combine<T, OP>(lanes[lane], values[i]);
+    }
+    for (uint component = 0; component < COMPONENTS; ++component)
+    {
+        result[component] = Identity<T, OP>();
+        for (uint lane = component; lane < kLanes; lane += COMPONENTS)
+        {
+            result[component] = Combine<T, OP>(result[component], lanes[lane]);
+        }
+    }
+}
+
+/**
+ * Sum elements by recursively summing each half.
+ * @param       values The elements (COMPONENTS scalars each).
+ * @param       count  The number of elements.
+ * @param [out] result The sum of each component.
+ */
+template<typename T, uint COMPONENTS>
+void SumPairwise(T const *values, size_t count, T *result) noexcept
+{
+    if (count <= kPairwiseBaseSize)
+    {
+        ReduceLanes<T, COMPONENTS, Operation::Sum>(values, count, result);
+        return;
+    }
+    size_t const half = count / 2;
+    T            right[COMPONENTS];
+    SumPairwise<T, COMPONENTS>(values, half, result);
+    SumPairwise<T, COMPONENTS>(values + half * COMPONENTS, count - half, right);
+    for (uint component = 0; component < COMPONENTS; ++component)
+    {
+        result[component] += right[component];
+    }
+}
+
+/**
+ * Add a value to a Neumaier compensated sum.
+ * @param [in,out] sum          The running sum.
+ * @param [in,out] compensation The low-order bits lost by the running sum.
+ * @param          value        The value to add.
+ */
+template<typename T>
+void AddNeumaier(T &sum, T &compensation, T value) noexcept
+{
+    // Selects rather than branches so that lanes can be vectorized
+    bool const sumIsLarger = std::abs(sum) >= std::abs(value);
+    T const    larger      = (sumIsLarger ? sum : value);
+    T const    smaller     = (sumIsLarger ? value : sum);
+    T const    total       = sum + value;
+    compensation += (larger - total) + smaller;
+    sum = total;
+}
+
+/**
+ * Sum elements in independent compensated lanes, then combine the lanes of each component.
+ * @param       values        The elements (COMPONENTS scalars each).
+ * @param       count         The number of elements.
+ * @param [out] sums          The sum of each component.
+ * @param [out] compensations The low-order bits lost by each sum.
+ */
+template<typename T, uint COMPONENTS, Summation SUMMATION>
+void SumCompensated(T const *values, size_t count, T *sums, T *compensations) noexcept
+{
+    constexpr uint kLanes              = kLaneCount<COMPONENTS>;
+    T              lanes[kLanes]       = {};
+    T              corrections[kLanes] = {};
+    auto const     add                 = [&](uint lane, T value) {
+        if constexpr (SUMMATION == Summation::Neumaier)
+        {
+            AddNeumaier(lanes[lane], corrections[lane], value);
+        }
+        else
+        {
+            // Kahan, the correction is subtracted from the next value (and dropped once the sum isn't finite so
+            // that infinities don't turn into NaN)
+            T const    corrected  = value - corrections[lane];
+            T const    total      = lanes[lane] + corrected;
+            T const    correction = (total - lanes[lane]) - corrected;
+            bool const finite     = std::abs(total) <= std::numeric_limits<T>::max();
+            corrections[lane]     = (finite ? correction : T(0));
+            lanes[lane]           = total;
+        }
+    };
+    size_t const scalarCount = count * COMPONENTS;
+    size_t       i           = 0;
+    for (; i + kLanes <= scalarCount; i += kLanes)
+    {
+        for (uint lane = 0; lane < kLanes; ++lane)
+        {
+            add(lane, values[i + lane]);
+        }
+    }
+    for (uint lane = 0; i < scalarCount; ++i, ++lane)
+    {
+        add(lane, values[i]);
+    }
+    for (uint component = 0; component < COMPONENTS; ++component)
+    {
+        sums[component]          = T(0);
+        compensations[component] = T(0);
+        for (uint lane = component; lane < kLanes; lane += COMPONENTS)
+        {
+            AddNeumaier(sums[component], compensations[component], lanes[lane]);
+            compensations[component] +=
+                (SUMMATION == Summation::Neumaier ? corrections[lane] : -corrections[lane]);
+        }
+    }
+}
+
+template<typename T, uint COMPONENTS, Operation OP>
+void ReduceOperation(T const *values, uint count, [[maybe_unused]] Summation summation, T *result) noexcept
+{
+    uint const blockCount = (count + kParallelBlockSize - 1) / kParallelBlockSize;
+    auto const getBlock   = [&](uint block) {
+        return std::make_pair(values + (size_t)block * kParallelBlockSize * COMPONENTS,
+            std::min(kParallelBlockSize, count - block * kParallelBlockSize));
+    };
+
+    if constexpr (OP == Operation::Sum && std::is_floating_point_v<T>)
+    {
+        if (summation == Summation::Kahan || summation == Summation::Neumaier)
+        {
+            // Each block keeps its compensation, blocks are then added with Neumaier summation
+            std::vector<T> partials((size_t)blockCount * COMPONENTS * 2);
+            ThreadPool::ParallelFor(
+                blockCount,
+                [&](uint block) {
+                    auto const [blockValues, blockSize] = getBlock(block);
+                    T *const sums = &partials[(size_t)block * COMPONENTS * 2];
+                    if (summation == Summation::Kahan)
+                    {
+                        SumCompensated<T, COMPONENTS, Summation::Kahan>(
+                            blockValues, blockSize, sums, sums + COMPONENTS);
+                    }
+                    else
+                    {
+                        SumCompensated<T, COMPONENTS, Summation::Neumaier>(
+                            blockValues, blockSize, sums, sums + COMPONENTS);
+                    }
+                },
+                1);
+            for (uint component = 0; component < COMPONENTS; ++component)
+            {
+                T sum          = T(0);
+                T compensation = T(0);
+                for (uint block = 0; block < blockCount; ++block)
+                {
+                    AddNeumaier(sum, compensation, partials[(size_t)block * COMPONENTS * 2 + component]);
+                    compensation += partials[(size_t)block * COMPONENTS * 2 + COMPONENTS + component];
+                }
+                // The compensation is meaningless once the sum is infinite or NaN
+                result[component] = (std::isfinite(sum) ? sum + compensation : sum);
+            }
+            return;
+        }
+    }
+
+    std::vector<T> partials((size_t)blockCount * COMPONENTS);
+    ThreadPool::ParallelFor(
+        blockCount,
+        [&](uint block) {
+            auto const [blockValues, blockSize] = getBlock(block);
+            T *const partial                    = &partials[(size_t)block * COMPONENTS];
+            if constexpr (OP == Operation::Sum && std::is_floating_point_v<T>)
+            {
+                if (summation == Summation::Pairwise)
+                {
+                    SumPairwise<T, COMPONENTS>(blockValues, blockSize, partial);
+                    return;
+                }
+            }
+            ReduceLanes<T, COMPONENTS, OP>(blockValues, blockSize, partial);
+        },
+        1);
+    if constexpr (OP == Operation::Sum && std::is_floating_point_v<T>)
+    {
+        if (summation == Summation::Pairwise)
+        {
+            SumPairwise<T, COMPONENTS>(partials.data(), blockCount, result);
+            return;
+        }
+    }
+    ReduceLanes<T, COMPONENTS, OP>(partials.data(), blockCount, result);
+}
+
+template<typename T, uint COMPONENTS>
+void ReduceType(void const *source, uint count, Operation operation, Summation summation, void *result) noexcept
+{
+    T const *values = static_cast<T const *>(source);
+    T       *output = static_cast<T *>(result);
+    switch (operation)
+    {
+    case Operation::Sum: ReduceOperation<T, COMPONENTS, Operation::Sum>(values, count, summation, output); break;
+    case Operation::Min: ReduceOperation<T, COMPONENTS, Operation::Min>(values, count, summation, output); break;
+    case Operation::Max: ReduceOperation<T, COMPONENTS, Operation::Max>(values, count, summation, output); break;
+    case Operation::Product:
+        ReduceOperation<T, COMPONENTS, Operation::Product>(values, count, summation, output);
+        break;
+    }
+}
+} // unnamed namespace
+
+bool CPUReduce::initialise(Type type, Operation operation, Summation summation) noexcept
+{
+    currentType      = type;
+    currentOperation = operation;
+    currentSummation = summation;
+    return true;
+}
+
+bool CPUReduce::reduceIndirect(void const *source, uint const *numKeys, uint maxNumKeys, void *result) noexcept
+{
+    return reduce(source, std::min(*numKeys, maxNumKeys), result);
+}
+
+bool CPUReduce::reduce(void const *source, uint numKeys, void *result) noexcept
+{
+    if (numKeys == 0)
+    {
+        return false;
+    }
+    switch (currentType)
+    {
+    case Type::Float: ReduceType<float, 1>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::Float2: ReduceType<float, 2>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::Float3: ReduceType<float, 3>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::Float4: ReduceType<float, 4>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::UInt: ReduceType<uint32_t, 1>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::UInt2: ReduceType<uint32_t, 2>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::UInt3: ReduceType<uint32_t, 3>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::UInt4: ReduceType<uint32_t, 4>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::Int: ReduceType<int32_t, 1>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::Int2: ReduceType<int32_t, 2>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::Int3: ReduceType<int32_t, 3>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::Int4: ReduceType<int32_t, 4>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::Double: ReduceType<double, 1>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::Double2: ReduceType<double, 2>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::Double3: ReduceType<double, 3>(source, numKeys, currentOperation, currentSummation, result); break;
+    case Type::Double4: ReduceType<double, 4>(source, numKeys, currentOperation, currentSummation, result); break;
+    default: return false;
+    }
+    return true;
+}
+} // namespace Capsaicin
@@ -0,0 +1,83 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "gpu_reduce.h"
+
+namespace Capsaicin
+{
+/**
+ * Multithreaded reduction of arrays on the host, covering the same types and operations as GPUReduce.
+ * Elements are tightly packed as in the GPU buffers (e.g., 12 bytes per Float3). Each thread reduces blocks of
+ * elements in independent SIMD lanes and the partial results are combined in block order, so results don't
+ * depend on the thread count.
+ * Integer sums and products wrap around, Min and Max ignore NaNs (as HLSL min/max) and denormals are preserved.
+ */
+class CPUReduce
+{
+public:
+    using Type      = GPUReduce::Type;
+    using Operation = GPUReduce::Operation;
+
+    /** Algorithm used to sum floating point types, other types and operations are exact. */
+    enum class Summation
+    {
+        Blocked,  /**< Lanes of each block summed in order, fastest with an error growing linearly with count */
+        Pairwise, /**< Recursive pairwise summation, error growing with log(count) */
+        Kahan,    /**< Kahan compensated summation */
+        Neumaier, /**< Neumaier compensated summation, also exact when adding values larger than the sum */
+    };
+
+    /**
+     * Initialise the internal data based on current configuration.
+     * @param type      The object type to reduce.
+     * @param operation The type of operation to perform.
+     * @param summation The summation algorithm used by Sum on floating point types.
+     * @return True, if any initialisation/changes succeeded.
+     */
+    bool initialise(Type type, Operation operation, Summation summation = Summation::Pairwise) noexcept;
+
+    /**
+     * Reduce a list of keys using indirect execution.
+     * @param       source     The keys to reduce.
+     * @param       numKeys    The number of keys to reduce, read when reducing.
+     * @param       maxNumKeys The maximum possible number of keys, @numKeys is clamped to it.
+     * @param [out] result     The reduced key (a single element of the current type).
+     * @return True, if operation succeeded (false if there are no keys).
+     */
+    bool reduceIndirect(void const *source, uint const *numKeys, uint maxNumKeys, void *result) noexcept;
+
+    /**
+     * Reduce a list of keys using selected operation.
+     * @param       source  The keys to reduce.
+     * @param       numKeys The number of keys in the source.
+     * @param [out] result  The reduced key (a single element of the current type).
+     * @return True, if operation succeeded (false if there are no keys).
+     */
+    bool reduce(void const *source, uint numKeys, void *result) noexcept;
+
+private:
+    Type      currentType      = Type::Float;
+    Operation currentOperation = Operation::Sum;
+    Summation currentSummation = Summation::Pairwise;
+};
+} // namespace Capsaicin
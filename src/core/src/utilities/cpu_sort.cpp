@@ -0,0 +1,381 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "cpu_sort.h"
+
+#include "parallel_algorithms.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint kRadixBits     = 8; /**< Key bits sorted per pass */
+constexpr uint kRadixBinCount = 1 << kRadixBits;
+constexpr uint kRadixPasses   = 32 / kRadixBits;
+
+/** Number of keys below which an insertion sort is faster than counting digits */
+constexpr uint kInsertionSortThreshold = 64;
+
+/** Number of keys below which a list is sorted on a single thread */
+constexpr uint kSerialSortThreshold = 64 * 1024;
+
+/**
+ * Gets the radix digit of a key.
+ */
+uint GetDigit(uint key, uint shift) noexcept
+{
+    return (key >> shift) & (kRadixBinCount - 1);
+}
+
+/**
+ * Turn digit counts into the position of the first key of each digit.
+ * Descending sorts place the digits in reverse order, which matches the GPU sort inverting each digit.
+ * @param [in,out] histogram The number of keys of each digit, replaced by their positions.
+ * @param          offset    The position of the first key.
+ * @returns The position following the last key.
+ */
+uint ScanHistogram(uint *histogram, uint offset, bool descending) noexcept
+{
+    for (uint bin = 0; bin < kRadixBinCount; ++bin)
+    {
+        uint const digit      = (descending ? kRadixBinCount - 1 - bin : bin);
+        uint const digitCount = histogram[digit];
+        histogram[digit]      = offset;
+        offset += digitCount;
+    }
+    return offset;
+}
+
+/**
+ * Stable scatter of a range of keys and optional payload to the positions of their digits.
+ * @param [in,out] offsets The position of the next key of each digit.
+ */
+template<bool PAYLOAD>
+void Scatter(uint const *sourceKeys, uint const *sourcePayload, uint begin, uint end, uint shift,
+    uint (&offsets)[kRadixBinCount], uint *destinationKeys, uint *destinationPayload) noexcept
+{
+    for (uint i = begin; i < end; ++i)
+    {
+        uint const position        = offsets[GetDigit(sourceKeys[i], shift)]++;
+        destinationKeys[position] = sourceKeys[i];
+        if constexpr (PAYLOAD)
+        {
+            destinationPayload[position] = sourcePayload[i];
+        }
+    }
+}
+
+/**
+ * Stable insertion sort of a short list of keys and optional payload.
+ */
+void InsertionSort(uint *keys, uint *payload, uint count, bool descending) noexcept
+{
+    for (uint i = 1; i < count; ++i)
+    {
+        uint const key   = keys[i];
+        uint const value = (payload != nullptr ? payload[i] : 0);
+        uint       j     = i;
+        for (; j > 0 && (descending ? keys[j - 1] < key : keys[j - 1] > key); --j)
+        {
+            keys[j] = keys[j - 1];
+            if (payload != nullptr)
+            {
+                payload[j] = payload[j - 1];
+            }
+        }
+        keys[j] = key;
+        if (payload != nullptr)
+        {
+            payload[j] = value;
+        }
+    }
+}
+
+/**
+ * Sort a list of keys and optional payload on the calling thread.
+ * @param keysScratch    Memory holding at least @count keys.
+ * @param payloadScratch Memory holding at least @count payloads (unused if @payload is null).
+ */
+void RadixSortSerial(uint *keys, uint *payload, uint count, uint *keysScratch, uint *payloadScratch,
+    bool descending) noexcept
+{
+    if (count <= kInsertionSortThreshold)
+    {
+        InsertionSort(keys, payload, count, descending);
+        return;
+    }
+
+    // The number of keys per digit doesn't depend on their order, so all passes are counted at once
+    uint histograms[kRadixPasses][kRadixBinCount] = {};
+    for (uint i = 0; i < count; ++i)
+    {
+        uint const key = keys[i];
+        for (uint pass = 0; pass < kRadixPasses; ++pass)
+        {
+            ++histograms[pass][GetDigit(key, pass * kRadixBits)];
+        }
+    }
+
+    uint *sourceKeys         = keys;
+    uint *destinationKeys    = keysScratch;
+    uint *sourcePayload      = payload;
+    uint *destinationPayload = payloadScratch;
+    for (uint pass = 0; pass < kRadixPasses; ++pass)
+    {
+        uint const shift = pass * kRadixBits;
+        if (histograms[pass][GetDigit(sourceKeys[0], shift)] == count)
+        {
+            continue; // all keys share this digit
+        }
+        ScanHistogram(histograms[pass], 0, descending);
+        if (payload != nullptr)
+        {
+            Scatter<true>(sourceKeys, sourcePayload, 0, count, shift, histograms[pass], destinationKeys,
+                destinationPayload);
+        }
+        else
+        {
+            Scatter<false>(sourceKeys, nullptr, 0, count, shift, histograms[pass], destinationKeys, nullptr);
+        }
+        std::swap(sourceKeys, destinationKeys);
+        std::swap(sourcePayload, destinationPayload);
+    }
+    if (sourceKeys != keys)
+    {
+        memcpy(keys, sourceKeys, count * sizeof(uint));
+        if (payload != nullptr)
+        {
+            memcpy(payload, sourcePayload, count * sizeof(uint));
+        }
+    }
+}
+
+/**
+ * Sort a list of keys and optional payload using the thread pool.
+ * The list is split into chunks that count their digits concurrently, the digit-major scan of the chunk
+ * histograms then gives each chunk the output position of each of its digits so that chunks scatter concurrently
+ * while keeping the sort stable.
+ * @param keysScratch      Memory holding at least @count keys.
+ * @param payloadScratch   Memory holding at least @count payloads (unused if @payload is null).
+ * @param histogramScratch Memory reused for the per-chunk histograms.
+ */
+void RadixSortParallel(uint *keys, uint *payload, uint count, uint *keysScratch, uint *payloadScratch,
+    bool descending, std::vector<uint> &histogramScratch) noexcept
+{
+    uint const blockCount = (count + kParallelBlockSize - 1) / kParallelBlockSize;
+    uint const chunkCount = std::min(blockCount, ThreadPool::GetThreadCount() * 4);
+    uint const chunkSize  = (count + chunkCount - 1) / chunkCount;
+    histogramScratch.resize((size_t)chunkCount * kRadixBinCount);
+
+    uint *sourceKeys         = keys;
+    uint *destinationKeys    = keysScratch;
+    uint *sourcePayload      = payload;
+    uint *destinationPayload = payloadScratch;
+    for (uint pass = 0; pass < kRadixPasses; ++pass)
+    {
+        uint const shift = pass * kRadixBits;
+        ThreadPool::ParallelFor(
+            chunkCount,
+            [&](uint chunk) {
+                uint       histogram[kRadixBinCount] = {};
+                uint const end                       = std::min((chunk + 1) * chunkSize, count);
+                for (uint i = chunk * chunkSize; i < end; ++i)
+                {
+                    ++histogram[GetDigit(sourceKeys[i], shift)];
+                }
+                std::copy_n(histogram, kRadixBinCount, &histogramScratch[(size_t)chunk * kRadixBinCount]);
+            },
+            1);
+
+        // Scan digit-major so that each digit of a chunk is placed after the same digit of the previous chunks
+        uint offset   = 0;
+        bool skipPass = false;
+        for (uint bin = 0; bin < kRadixBinCount && !skipPass; ++bin)
+        {
+            uint const digit      = (descending ? kRadixBinCount - 1 - bin : bin);
+            uint const digitStart = offset;
+            for (uint chunk = 0; chunk < chunkCount; ++chunk)
+            {
+                uint      &histogram  = histogramScratch[(size_t)chunk * kRadixBinCount + digit];
+                uint const digitCount = histogram;
+                histogram             = offset;
+                offset += digitCount;
+            }
+            skipPass = (offset - digitStart == count); // all keys share this digit
+        }
+        if (skipPass)
+        {
+            continue;
+        }
+
+        ThreadPool::ParallelFor(
+            chunkCount,
+            [&](uint chunk) {
+                uint offsets[kRadixBinCount];
+                std::copy_n(&histogramScratch[(size_t)chunk * kRadixBinCount], kRadixBinCount, offsets);
+                uint const begin = chunk * chunkSize;
+                uint const end   = std::min(begin + chunkSize, count);
+                if (payload != nullptr)
+                {
+                    Scatter<true>(sourceKeys, sourcePayload, begin, end, shift, offsets, destinationKeys,
+                        destinationPayload);
+                }
+                else
+                {
+                    Scatter<false>(sourceKeys, nullptr, begin, end, shift, offsets, destinationKeys, nullptr);
+                }
+            },
+            1);
+        std::swap(sourceKeys, destinationKeys);
+        std::swap(sourcePayload, destinationPayload);
+    }
+    if (sourceKeys != keys)
+    {
+        ThreadPool::ParallelFor(
+            chunkCount,
+            [&](uint chunk) {
+                uint const begin = chunk * chunkSize;
+                uint const end   = std::min(begin + chunkSize, count);
+                memcpy(&keys[begin], &sourceKeys[begin], (end - begin) * sizeof(uint));
+                if (payload != nullptr)
+                {
+                    memcpy(&payload[begin], &sourcePayload[begin], (end - begin) * sizeof(uint));
+                }
+            },
+            1);
+    }
+}
+} // unnamed namespace
+
+bool CPUSort::initialise(Type type, Operation operation) noexcept
+{
+    currentType      = type;
+    currentOperation = operation;
+    return true;
+}
+
+void CPUSort::sortIndirect(uint *keys, uint const *numKeys, uint maxNumKeys) noexcept
+{
+    sortInternal(keys, std::min(*numKeys, maxNumKeys));
+}
+
+void CPUSort::sortIndirectPayload(uint *keys, uint const *numKeys, uint maxNumKeys, uint *payload) noexcept
+{
+    sortInternal(keys, std::min(*numKeys, maxNumKeys), payload);
+}
+
+void CPUSort::sort(uint *keys, uint numKeys) noexcept
+{
+    sortInternal(keys, numKeys);
+}
+
+void CPUSort::sortPayload(uint *keys, uint numKeys, uint *payload) noexcept
+{
+    sortInternal(keys, numKeys, payload);
+}
+
+void CPUSort::sortIndirectSegmented(uint *keys, uint numSegments, uint const *numKeys, uint maxNumKeys) noexcept
+{
+    sortInternalSegmented(keys, numSegments, numKeys, maxNumKeys);
+}
+
+void CPUSort::sortIndirectPayloadSegmented(
+    uint *keys, uint numSegments, uint const *numKeys, uint maxNumKeys, uint *payload) noexcept
+{
+    sortInternalSegmented(keys, numSegments, numKeys, maxNumKeys, payload);
+}
+
+void CPUSort::sortSegmented(uint *keys, std::vector<uint> const &numKeys, uint maxNumKeys) noexcept
+{
+    sortInternalSegmented(keys, (uint)numKeys.size(), numKeys.data(), maxNumKeys);
+}
+
+void CPUSort::sortPayloadSegmented(
+    uint *keys, std::vector<uint> const &numKeys, uint maxNumKeys, uint *payload) noexcept
+{
+    sortInternalSegmented(keys, (uint)numKeys.size(), numKeys.data(), maxNumKeys, payload);
+}
+
+void CPUSort::sortInternal(uint *keys, uint numKeys, uint *payload) noexcept
+{
+    bool const descending = (currentOperation == Operation::Descending);
+    if (numKeys <= kInsertionSortThreshold)
+    {
+        InsertionSort(keys, payload, numKeys, descending);
+        return;
+    }
+    keysScratch.resize(std::max((size_t)numKeys, keysScratch.size()));
+    if (payload != nullptr)
+    {
+        payloadScratch.resize(std::max((size_t)numKeys, payloadScratch.size()));
+    }
+    if (numKeys < kSerialSortThreshold || ThreadPool::GetThreadCount() == 1)
+    {
+        RadixSortSerial(keys, payload, numKeys, keysScratch.data(), payloadScratch.data(), descending);
+    }
+    else
+    {
+        RadixSortParallel(keys, payload, numKeys, keysScratch.data(), payloadScratch.data(), descending,
+            histogramScratch);
+    }
+}
+
+void CPUSort::sortInternalSegmented(
+    uint *keys, uint numSegments, uint const *numKeys, uint maxNumKeys, uint *payload) noexcept
+{
+    // Large segments are sorted one after the other using all threads, the others concurrently on one thread each
+    // using the scratch memory at the same offset as the segment
+    std::vector<uint> serialSegments;
+    for (uint segment = 0; segment < numSegments; ++segment)
+    {
+        uint const segmentKeys = std::min(numKeys[segment], maxNumKeys);
+        if (segmentKeys >= kSerialSortThreshold && ThreadPool::GetThreadCount() > 1)
+        {
+            sortInternal(&keys[(size_t)segment * maxNumKeys], segmentKeys,
+                payload != nullptr ? &payload[(size_t)segment * maxNumKeys] : nullptr);
+        }
+        else if (segmentKeys > 1)
+        {
+            serialSegments.push_back(segment);
+        }
+    }
+    if (serialSegments.empty())
+    {
+        return;
+    }
+    size_t const scratchSize = (size_t)numSegments * maxNumKeys;
+    keysScratch.resize(std::max(scratchSize, keysScratch.size()));
+    if (payload != nullptr)
+    {
+        payloadScratch.resize(std::max(scratchSize, payloadScratch.size()));
+    }
+    bool const descending = (currentOperation == Operation::Descending);
+    ThreadPool::ParallelFor((uint)serialSegments.size(), [&](uint index) {
+        size_t const offset = (size_t)serialSegments[index] * maxNumKeys;
+        RadixSortSerial(&keys[offset], payload != nullptr ? &payload[offset] : nullptr,
+            std::min(numKeys[serialSegments[index]], maxNumKeys), &keysScratch[offset],
+            payload != nullptr ? &payloadScratch[offset] : nullptr, descending);
+    });
+}
+} // namespace Capsaicin
@@ -0,0 +1,147 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "gpu_sort.h"
+
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Multithreaded LSD radix sort of 32bit keys on the host, with the same semantics as GPUSort.
+ * Keys are sorted by their bit pattern in 8bit digits, so float keys are ordered exactly as on the GPU (negative
+ * values are not supported and sort after positive ones). The sort is stable, equal keys keep their relative order
+ * and so do their payloads.
+ */
+class CPUSort
+{
+public:
+    using Type      = GPUSort::Type;
+    using Operation = GPUSort::Operation;
+
+    /**
+     * Initialise the internal data based on current configuration.
+     * @param type      The object type to sort.
+     * @param operation The type of operation to perform.
+     * @return True, if any initialisation/changes succeeded.
+     */
+    bool initialise(Type type, Operation operation) noexcept;
+
+    /**
+     * Sort a list of keys using indirect execution.
+     * @param keys       The keys to sort (32bit uint or float>=0 bit patterns).
+     * @param numKeys    The number of keys to sort, read when sorting.
+     * @param maxNumKeys The maximum possible number of keys, @numKeys is clamped to it.
+     */
+    void sortIndirect(uint *keys, uint const *numKeys, uint maxNumKeys) noexcept;
+
+    /**
+     * Sort a list of keys and associated payload using indirect execution.
+     * @param keys       The keys to sort (32bit uint or float>=0 bit patterns).
+     * @param numKeys    The number of keys to sort, read when sorting.
+     * @param maxNumKeys The maximum possible number of keys, @numKeys is clamped to it.
+     * @param payload    The payload of each key (32bit per key).
+     */
+    void sortIndirectPayload(uint *keys, uint const *numKeys, uint maxNumKeys, uint *payload) noexcept;
+
+    /**
+     * Sort a list of keys.
+     * @param keys    The keys to sort (32bit uint or float>=0 bit patterns).
+     * @param numKeys The number of keys.
+     */
+    void sort(uint *keys, uint numKeys) noexcept;
+
+    /**
+     * Sort a list of keys and associated payload.
+     * @param keys    The keys to sort (32bit uint or float>=0 bit patterns).
+     * @param numKeys The number of keys.
+     * @param payload The payload of each key (32bit per key).
+     */
+    void sortPayload(uint *keys, uint numKeys, uint *payload) noexcept;
+
+    /**
+     * Sort a segmented list of keys using indirect execution.
+     * @param keys        The keys to sort, segment i starts at key i * @maxNumKeys.
+     * @param numSegments The number of segments to sort.
+     * @param numKeys     The number of keys in each segment (must have @numSegments values), read when sorting.
+     * @param maxNumKeys  The maximum possible number of keys in each segment.
+     */
+    void sortIndirectSegmented(uint *keys, uint numSegments, uint const *numKeys, uint maxNumKeys) noexcept;
+
+    /**
+     * Sort a segmented list of keys and associated payload using indirect execution.
+     * @param keys        The keys to sort, segment i starts at key i * @maxNumKeys.
+     * @param numSegments The number of segments to sort.
+     * @param numKeys     The number of keys in each segment (must have @numSegments values), read when sorting.
+     * @param maxNumKeys  The maximum possible number of keys in each segment.
+     * @param payload     The payload of each key (32bit per key).
+     */
+    void sortIndirectPayloadSegmented(
+        uint *keys, uint numSegments, uint const *numKeys, uint maxNumKeys, uint *payload) noexcept;
+
+    /**
+     * Sort a segmented list of keys.
+     * @param keys       The keys to sort, segment i starts at key i * @maxNumKeys.
+     * @param numKeys    List containing the number of keys in each segment.
+     * @param maxNumKeys Value containing the max number of keys in any segment.
+     */
+    void sortSegmented(uint *keys, std::vector<uint> const &numKeys, uint maxNumKeys) noexcept;
+
+    /**
+     * Sort a segmented list of keys and associated payload.
+     * @param keys       The keys to sort, segment i starts at key i * @maxNumKeys.
+     * @param numKeys    List containing the number of keys in each segment.
+     * @param maxNumKeys Value containing the max number of keys in any segment.
+     * @param payload    The payload of each key (32bit per key).
+     */
+    void sortPayloadSegmented(
+        uint *keys, std::vector<uint> const &numKeys, uint maxNumKeys, uint *payload) noexcept;
+
+private:
+    /**
+     * Internal sort implementation used to handle multiple sort cases.
+     * @param keys    The keys to sort.
+     * @param numKeys The number of keys.
+     * @param payload (Optional) The payload of each key.
+     */
+    void sortInternal(uint *keys, uint numKeys, uint *payload = nullptr) noexcept;
+
+    /**
+     * Internal sort implementation used to handle multiple segmented sort cases.
+     * @param keys        The keys to sort, segment i starts at key i * @maxNumKeys.
+     * @param numSegments The number of segments to sort.
+     * @param numKeys     The number of keys in each segment, clamped to @maxNumKeys.
+     * @param maxNumKeys  The maximum possible number of keys in each segment.
+     * @param payload     (Optional) The payload of each key.
+     */
+    void sortInternalSegmented(
+        uint *keys, uint numSegments, uint const *numKeys, uint maxNumKeys, uint *payload = nullptr) noexcept;
+
+    Type      currentType      = Type::Float;
+    Operation currentOperation = Operation::Ascending;
+
+    std::vector<uint> keysScratch;      /**< Ping-pong copy of the keys, reused between sorts */
+    std::vector<uint> payloadScratch;   /**< Ping-pong copy of the payload, reused between sorts */
+    std::vector<uint> histogramScratch; /**< Per-chunk digit histograms of the parallel passes */
+};
+} // namespace Capsaicin
@@ -0,0 +1,171 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "frame_sequence.h"
+
+#include <CLI/CLI.hpp>
+#include <filesystem>
+#include <string>
+#include <tinyexr.h>
+#include <vector>
+
+using namespace Capsaicin;
+
+namespace
+{
+/**
+ * Write a frame as an EXR image.
+ * @param data      The frame pixels as 4 floats per pixel.
+ * @param width     The width of the frame.
+ * @param height    The height of the frame.
+ * @param half      True to store half precision channels, False to store full precision ones.
+ * @param file_path Full pathname to the file to write.
+ * @returns True if succeeded, False otherwise.
+ */
+bool WriteEXR(std::vector<float> const &data, uint32_t width, uint32_t height, bool half, char const *file_path)
+{
+    // EXR channels are stored in alphabetical order
+    char const channel_names[]  = {'A', 'B', 'G', 'R'};
+    int const  channel_offset[] = {3, 2, 1, 0};
+    int const  channel_count    = 4;
+
+    EXRChannelInfo channel_infos[channel_count];
+    int            pixel_types[channel_count];
+    int            requested_pixel_types[channel_count];
+    for (int channel = 0; channel < channel_count; ++channel)
+    {
+        channel_infos[channel].name[0] = channel_names[channel];
+        channel_infos[channel].name[1] = '\0';
+        pixel_types[channel]           = TINYEXR_PIXELTYPE_FLOAT;
+        requested_pixel_types[channel] = (half ? TINYEXR_PIXELTYPE_HALF : TINYEXR_PIXELTYPE_FLOAT);
+    }
+
+    EXRHeader exr_header;
+    InitEXRHeader(&exr_header);
+    exr_header.compression_type      = TINYEXR_COMPRESSIONTYPE_PIZ;
+    exr_header.num_channels          = channel_count;
+    exr_header.channels              = channel_infos;
+    exr_header.pixel_types           = pixel_types;
+    exr_header.requested_pixel_types = requested_pixel_types;
+
+    size_t const       pixel_count = (size_t)width * height;
+    std::vector<float> image_channels(pixel_count * channel_count);
+    unsigned char     *images[channel_count];
+    for (int channel = 0; channel < channel_count; ++channel)
+    {
+        float *image_channel = &image_channels[pixel_count * channel];
+        images[channel]      = (unsigned char *)image_channel;
+        for (size_t pixel_index = 0; pixel_index < pixel_count; ++pixel_index)
+        {
+            image_channel[pixel_index] = data[4 * pixel_index + channel_offset[channel]];
+        }
+    }
+
+    EXRImage exr_image;
+    InitEXRImage(&exr_image);
+    exr_image.num_channels = channel_count;
+    exr_image.images       = images;
+    exr_image.width        = (int)width;
+    exr_image.height       = (int)height;
+
+    char const *exr_err = nullptr;
+    if (SaveEXRImageToFile(&exr_image, &exr_header, file_path, &exr_err) != TINYEXR_SUCCESS)
+    {
+        fprintf(stderr, "Can't save '%s': %s\n", file_path, exr_err != nullptr ? exr_err : "unknown error");
+        FreeEXRErrorMessage(exr_err);
+        return false;
+    }
+    return true;
+}
+} // unnamed namespace
+
+int main(int argc, char **argv)
+{
+    CLI::App app("Capsaicin - Frame Extract");
+    std::string sequence_path;
+    app.add_option("sequence", sequence_path, "Frame sequence container written by a frame capture")
+        ->required()
+        ->check(CLI::ExistingFile);
+    std::vector<uint32_t> frame_indices;
+    app.add_option("-f,--frames", frame_indices, "Renderer frame indices to extract (all frames if omitted)");
+    std::string output_prefix;
+    app.add_option("-o,--output", output_prefix,
+        "Prefix of the extracted files, '_<frame index>.exr' is appended (defaults to the container path)");
+    bool list = false;
+    app.add_flag("-l,--list", list, "List the frames in the container instead of extracting them");
+    CLI11_PARSE(app, argc, argv);
+
+    FrameSequenceReader sequence;
+    if (!sequence.open(sequence_path.c_str()))
+    {
+        fprintf(stderr, "Invalid frame sequence '%s'\n", sequence_path.c_str());
+        return 1;
+    }
+    printf("%s: %u frames of %ux%u (%s)\n", sequence_path.c_str(), sequence.getFrameCount(), sequence.getWidth(),
+        sequence.getHeight(), sequence.getEncoding() == FrameEncoding::Half ? "half" : "float");
+    if (list)
+    {
+        for (uint32_t frame = 0; frame < sequence.getFrameCount(); ++frame)
+        {
+            printf("%u\n", sequence.getFrameIndex(frame));
+        }
+        return 0;
+    }
+
+    // Gather the requested frames in container order
+    std::vector<uint32_t> frames;
+    if (frame_indices.empty())
+    {
+        for (uint32_t frame = 0; frame < sequence.getFrameCount(); ++frame)
+        {
+            frames.push_back(frame);
+        }
+    }
+    for (uint32_t const frame_index : frame_indices)
+    {
+        uint32_t const frame = sequence.findFrame(frame_index);
+        if (frame == UINT32_MAX)
+        {
+            fprintf(stderr, "Frame %u is not in '%s'\n", frame_index, sequence_path.c_str());
+            return 1;
+        }
+        frames.push_back(frame);
+    }
+
+    if (output_prefix.empty())
+    {
+        output_prefix = std::filesystem::path(sequence_path).replace_extension().string();
+    }
+    std::vector<float> data((size_t)sequence.getWidth() * sequence.getHeight() * 4);
+    for (uint32_t const frame : frames)
+    {
+        sequence.readFrame(frame, data.data());
+        std::string const file_path = output_prefix + '_' + std::to_string(sequence.getFrameIndex(frame)) + ".exr";
+        if (!WriteEXR(data, sequence.getWidth(), sequence.getHeight(),
+                sequence.getEncoding() == FrameEncoding::Half, file_path.c_str()))
+        {
+            return 1;
+        }
+        printf("Extracted frame %u to '%s'\n", sequence.getFrameIndex(frame), file_path.c_str());
+    }
+    return 0;
+}
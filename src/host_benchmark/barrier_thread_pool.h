@@ -0,0 +1,163 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Copy of the thread pool Capsaicin used before the work-stealing scheduler, kept as the baseline of the host
+ * benchmarks. A single kernel runs at a time: every worker is woken for each dispatch and the calling thread
+ * sleeps until all of them are back in the pool.
+ * @note Unlike the original, workers wait on a dispatch counter so that spurious wake ups can't run a stale kernel.
+ */
+class BarrierThreadPool
+{
+public:
+    /**
+     * Start the worker threads.
+     * @param thread_count The number of threads (rounded up to an even number as the original pool did).
+     */
+    explicit BarrierThreadPool(uint32_t thread_count) noexcept
+    {
+        thread_count = (std::max(thread_count, 1u) + 1u) & ~1u;
+        threads_.reserve(thread_count);
+        for (uint32_t i = 0; i < thread_count; ++i)
+        {
+            threads_.emplace_back(&BarrierThreadPool::worker, this);
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        sync_.wait(lock, [&] { return idle_count_ == threads_.size(); });
+    }
+
+    ~BarrierThreadPool() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            terminate_ = true;
+            ++dispatch_index_;
+        }
+        signal_.notify_all();
+        for (std::thread &thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+    BarrierThreadPool(BarrierThreadPool const &)            = delete;
+    BarrierThreadPool &operator=(BarrierThreadPool const &) = delete;
+
+    /**
+     * Run a kernel for each index in [0, count) on the workers and wait for all of them to return to the pool.
+     * @param kernel     The kernel, called with the index of each invocation.
+     * @param count      The number of kernel invocations.
+     * @param block_size The number of consecutive invocations claimed at once by a thread.
+     */
+    template<typename KERNEL>
+    void Dispatch(KERNEL const &kernel, uint32_t count, uint32_t block_size = 16) noexcept
+    {
+        block_size                 = std::max(block_size, 1u);
+        uint32_t const block_count = (count + block_size - 1) / block_size;
+
+        // Special case - only 1 block? no need to go wide
+        if (block_count <= 1)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                kernel(i);
+            }
+            return;
+        }
+
+        std::atomic<uint32_t> block_index = 0;
+        auto const            run_blocks  = [&]() {
+            for (;;)
+            {
+                uint32_t const block = block_index++;
+                if (block >= block_count)
+                {
+                    break; // everything has been processed
+                }
+                uint32_t const end = std::min((block + 1) * block_size, count);
+                for (uint32_t index = block * block_size; index < end; ++index)
+                {
+                    kernel(index);
+                }
+            }
+        };
+
+        // Wake every worker then sleep until all of them are back in the pool
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            kernel_     = run_blocks;
+            idle_count_ = 0;
+            ++dispatch_index_;
+        }
+        signal_.notify_all();
+        std::unique_lock<std::mutex> lock(mutex_);
+        sync_.wait(lock, [&] { return idle_count_ == threads_.size(); });
+        kernel_ = nullptr;
+    }
+
+private:
+    void worker() noexcept
+    {
+        uint64_t dispatch_index = 0;
+        for (;;)
+        {
+            std::function<void()> kernel;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (++idle_count_ == threads_.size())
+                {
+                    sync_.notify_one(); // all threads are back to the pool
+                }
+                signal_.wait(lock, [&] { return dispatch_index_ != dispatch_index; });
+                dispatch_index = dispatch_index_;
+                if (terminate_)
+                {
+                    break;
+                }
+                kernel = kernel_;
+            }
+            kernel();
+        }
+    }
+
+    std::mutex               mutex_;                  /**< The mutex for synchronization */
+    std::condition_variable  sync_;                   /**< Signals the calling thread that all workers are idle */
+    std::condition_variable  signal_;                 /**< Signals the workers that a kernel was dispatched */
+    std::function<void()>    kernel_;                 /**< The kernel of the current dispatch */
+    std::vector<std::thread> threads_;                /**< The worker threads */
+    size_t                   idle_count_     = 0;     /**< The number of workers back in the pool */
+    uint64_t                 dispatch_index_ = 0;     /**< Incremented by each dispatch (and on termination) */
+    bool                     terminate_      = false; /**< Whether the workers must exit */
+};
+} // namespace Capsaicin
@@ -0,0 +1,194 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "animation_evaluator.h"
+#include "host_benchmark.h"
+
+#include <algorithm>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint32_t kAnimationCount     = 16;           /**< Number of animations */
+constexpr float    kAnimationLength    = 4.0f;         /**< Length of each animation (in seconds) */
+constexpr float    kKeyframeRate       = 30.0f;        /**< Number of keyframes per second */
+constexpr float    kFrameTime          = 1.0f / 60.0f; /**< Play time elapsed every frame (in seconds) */
+constexpr uint32_t kFramesPerIteration = 60;           /**< Number of frames timed per iteration */
+
+/**
+ * Get the animated transform of a node, half of the nodes spin while the others hold their pose.
+ * @param node The index of the node.
+ * @param time The animation time (in seconds).
+ * @returns The transform, decomposed.
+ */
+AnimationKeyframe GetNodeTransform(uint32_t node, float time) noexcept
+{
+    AnimationKeyframe keyframe;
+    keyframe.translation = glm::vec3((float)(node % 64), 0.0f, (float)(node / 64));
+    if ((node & 1) != 0)
+    {
+        float const angle      = 6.2831853f * time / kAnimationLength;
+        keyframe.translation.y = 0.5f * sinf(angle);
+        keyframe.rotation      = glm::quat(cosf(0.5f * angle), 0.0f, sinf(0.5f * angle), 0.0f);
+    }
+    return keyframe;
+}
+
+/**
+ * Compose a decomposed transform.
+ * @param keyframe The decomposed transform.
+ * @returns The transform matrix.
+ */
+glm::mat4 Compose(AnimationKeyframe const &keyframe) noexcept
+{
+    glm::mat3 const rotation = glm::mat3_cast(keyframe.rotation);
+    return glm::mat4(glm::vec4(rotation[0] * keyframe.scale.x, 0.0f), glm::vec4(rotation[1] * keyframe.scale.y, 0.0f),
+        glm::vec4(rotation[2] * keyframe.scale.z, 0.0f), glm::vec4(keyframe.translation, 1.0f));
+}
+
+/** Keyframed animation applied the way the scene animations were (see gfxSceneApplyAnimation()). */
+struct SceneAnimation
+{
+    std::vector<float>             times;  /**< The keyframe times, shared by all the channels */
+    std::vector<AnimationKeyframe> values; /**< The keyframe values (channel-major) */
+    std::vector<uint32_t>          nodes;  /**< The node driven by each channel */
+
+    /**
+     * Search the keyframes and write the transform of every node.
+     * @param       time       The animation time (in seconds).
+     * @param [out] transforms The node transforms.
+     */
+    void apply(float time, std::vector<glm::mat4> &transforms) const noexcept
+    {
+        uint32_t const key_count = (uint32_t)times.size();
+        for (uint32_t channel = 0; channel < (uint32_t)nodes.size(); ++channel)
+        {
+            // Every channel searches its keyframes from scratch
+            uint32_t const key = (uint32_t)glm::clamp(
+                (int32_t)(std::upper_bound(times.begin(), times.end(), time) - times.begin()) - 1, 0,
+                (int32_t)key_count - 2);
+            AnimationKeyframe const &key0  = values[(size_t)channel * key_count + key];
+            AnimationKeyframe const &key1  = values[(size_t)channel * key_count + key + 1];
+            float const              alpha =
+                glm::clamp((time - times[key]) / (times[key + 1] - times[key]), 0.0f, 1.0f);
+            AnimationKeyframe        value;
+            value.translation          = glm::mix(key0.translation, key1.translation, alpha);
+            value.rotation             = glm::slerp(key0.rotation, key1.rotation, alpha);
+            value.scale                = glm::mix(key0.scale, key1.scale, alpha);
+            transforms[nodes[channel]] = Compose(value);
+        }
+    }
+};
+} // unnamed namespace
+
+HOST_BENCHMARK(AnimationEvaluation)
+{
+    uint32_t const node_count          = runner.scaled(4096);
+    uint32_t const nodes_per_animation = glm::max(node_count / kAnimationCount, 1U);
+    uint32_t const key_count           = (uint32_t)(kAnimationLength * kKeyframeRate) + 1;
+
+    // Build the same animations for both implementations
+    std::vector<SceneAnimation> scene_animations(kAnimationCount);
+    AnimationEvaluator          evaluator;
+    for (uint32_t animation = 0; animation < kAnimationCount; ++animation)
+    {
+        SceneAnimation &scene_animation = scene_animations[animation];
+        for (uint32_t i = 0; i < nodes_per_animation; ++i)
+        {
+            scene_animation.nodes.push_back(animation * nodes_per_animation + i);
+        }
+        for (uint32_t key = 0; key < key_count; ++key)
+        {
+            scene_animation.times.push_back((float)key / kKeyframeRate);
+        }
+        for (uint32_t node : scene_animation.nodes)
+        {
+            for (float time : scene_animation.times)
+            {
+                scene_animation.values.push_back(GetNodeTransform(node, time));
+            }
+        }
+
+        AnimationSampler sampler;
+        sampler.initialize(kAnimationLength, kKeyframeRate, 1e-4f, nodes_per_animation);
+        std::vector<glm::mat4> transforms(nodes_per_animation);
+        for (float time; sampler.next(time);)
+        {
+            for (uint32_t i = 0; i < nodes_per_animation; ++i)
+            {
+                transforms[i] = Compose(GetNodeTransform(scene_animation.nodes[i], time));
+            }
+            sampler.record(transforms.data());
+        }
+        evaluator.addAnimation(sampler, scene_animation.nodes.data(), 1e-4f);
+    }
+
+    struct Input
+    {
+        char const *name;
+        float       speed;
+    };
+
+    Input const inputs[] = {
+        {"forward playback",  1.0f},
+        {"reverse playback", -1.0f},
+        {          "paused",  0.0f},
+    };
+    uint32_t const channel_count = nodes_per_animation * kAnimationCount;
+    uint64_t const item_count    = (uint64_t)channel_count * kFramesPerIteration;
+    for (Input const &input : inputs)
+    {
+        std::string const name = std::to_string(channel_count) + " nodes (" + input.name + ")";
+
+        // Every frame used to apply each animation in turn
+        std::vector<glm::mat4> transforms(channel_count);
+        double                 play_time = 1.0;
+        runner.measure("Apply all animations", name, item_count, [&] {
+            for (uint32_t frame = 0; frame < kFramesPerIteration; ++frame)
+            {
+                play_time += input.speed * kFrameTime;
+                float const time = (float)(play_time - kAnimationLength * floor(play_time / kAnimationLength));
+                for (SceneAnimation const &scene_animation : scene_animations)
+                {
+                    scene_animation.apply(time, transforms);
+                }
+                BenchmarkRunner::Consume(transforms[0]);
+            }
+        });
+
+        // The evaluator only touches the channels whose value changed
+        play_time = 1.0;
+        runner.measure("AnimationEvaluator", name, item_count, [&] {
+            for (uint32_t frame = 0; frame < kFramesPerIteration; ++frame)
+            {
+                play_time += input.speed * kFrameTime;
+                std::vector<uint32_t> const &touched = evaluator.evaluate(play_time);
+                for (uint32_t channel : touched)
+                {
+                    transforms[evaluator.getTarget(channel)] = evaluator.getTransform(channel);
+                }
+                BenchmarkRunner::Consume(touched.size());
+            }
+        });
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,182 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "host_benchmark.h"
+#include "render_option_registry.h"
+
+#include <array>
+#include <string>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint32_t kTechniqueCount      = 8;    /**< Number of render techniques reading the options */
+constexpr uint32_t kOptionsPerType      = 6;    /**< Number of options of each type read by a technique */
+constexpr uint32_t kFramesPerIteration  = 1000; /**< Number of frames timed per iteration */
+constexpr uint32_t kOptionsPerTechnique = 4 * kOptionsPerType;
+constexpr uint32_t kOptionCount         = kTechniqueCount * kOptionsPerTechnique;
+
+/** Options of a render technique, as converted by its convertOptions(). */
+struct TechniqueOptions
+{
+    std::array<bool, kOptionsPerType>     flags;
+    std::array<uint32_t, kOptionsPerType> counts;
+    std::array<int32_t, kOptionsPerType>  offsets;
+    std::array<float, kOptionsPerType>    scales;
+};
+
+/** Registry handles of the options of a render technique. */
+struct TechniqueHandles
+{
+    std::array<RenderOptionHandle<bool>, kOptionsPerType>     flags;
+    std::array<RenderOptionHandle<uint32_t>, kOptionsPerType> counts;
+    std::array<RenderOptionHandle<int32_t>, kOptionsPerType>  offsets;
+    std::array<RenderOptionHandle<float>, kOptionsPerType>    scales;
+};
+
+/**
+ * Get the index of a technique option in the options list.
+ * @param technique The index of the technique.
+ * @param type      The index of the option type (bool, uint32_t, int32_t then float).
+ * @param option    The index of the option within those of its type.
+ * @returns The option index.
+ */
+uint32_t GetOptionIndex(uint32_t technique, uint32_t type, uint32_t option) noexcept
+{
+    return technique * kOptionsPerTechnique + type * kOptionsPerType + option;
+}
+
+/**
+ * Convert the options of a technique by looking up their names, as RENDER_OPTION_GET() does.
+ * @param options   The options list.
+ * @param names     The option names.
+ * @param technique The index of the technique.
+ * @returns The technique options.
+ */
+TechniqueOptions ConvertOptions(
+    RenderOptionList const &options, std::vector<std::string> const &names, uint32_t technique) noexcept
+{
+    TechniqueOptions ret;
+    for (uint32_t i = 0; i < kOptionsPerType; ++i)
+    {
+        ret.flags[i]   = *std::get_if<bool>(&options.at(names[GetOptionIndex(technique, 0, i)]));
+        ret.counts[i]  = *std::get_if<uint32_t>(&options.at(names[GetOptionIndex(technique, 1, i)]));
+        ret.offsets[i] = *std::get_if<int32_t>(&options.at(names[GetOptionIndex(technique, 2, i)]));
+        ret.scales[i]  = *std::get_if<float>(&options.at(names[GetOptionIndex(technique, 3, i)]));
+    }
+    return ret;
+}
+} // unnamed namespace
+
+HOST_BENCHMARK(OptionLookup)
+{
+    // The option names are stored separately as the list only references them
+    std::vector<std::string> names(kOptionCount);
+    RenderOptionList         options;
+    for (uint32_t technique = 0; technique < kTechniqueCount; ++technique)
+    {
+        for (uint32_t i = 0; i < kOptionsPerType; ++i)
+        {
+            std::string const prefix = "technique" + std::to_string(technique) + "_option" + std::to_string(i);
+            names[GetOptionIndex(technique, 0, i)] = prefix + "_enable";
+            names[GetOptionIndex(technique, 1, i)] = prefix + "_count";
+            names[GetOptionIndex(technique, 2, i)] = prefix + "_offset";
+            names[GetOptionIndex(technique, 3, i)] = prefix + "_scale";
+            options.emplace(names[GetOptionIndex(technique, 0, i)], (i & 1) != 0);
+            options.emplace(names[GetOptionIndex(technique, 1, i)], i);
+            options.emplace(names[GetOptionIndex(technique, 2, i)], -(int32_t)i);
+            options.emplace(names[GetOptionIndex(technique, 3, i)], (float)i);
+        }
+    }
+
+    RenderOptionRegistry registry;
+    registry.bind(options);
+    std::array<TechniqueHandles, kTechniqueCount> handles;
+    for (uint32_t technique = 0; technique < kTechniqueCount; ++technique)
+    {
+        for (uint32_t i = 0; i < kOptionsPerType; ++i)
+        {
+            handles[technique].flags[i]   = registry.find<bool>(names[GetOptionIndex(technique, 0, i)]);
+            handles[technique].counts[i]  = registry.find<uint32_t>(names[GetOptionIndex(technique, 1, i)]);
+            handles[technique].offsets[i] = registry.find<int32_t>(names[GetOptionIndex(technique, 2, i)]);
+            handles[technique].scales[i]  = registry.find<float>(names[GetOptionIndex(technique, 3, i)]);
+        }
+    }
+
+    // Optionally edit one option through the list each frame, as the UI does while a slider is dragged
+    float *const edited_option = std::get_if<float>(&options.at(names[GetOptionIndex(0, 3, 0)]));
+    for (bool const edit : {false, true})
+    {
+        std::string const name =
+            std::to_string(kOptionCount) + " options (" + (edit ? "one edit" : "no edit") + " per frame)";
+        uint64_t const frame_count = runner.scaled(kFramesPerIteration);
+
+        // Every technique used to look up all its options by name each frame
+        runner.measure("String lookup", name, frame_count, [&] {
+            for (uint64_t frame = 0; frame < frame_count; ++frame)
+            {
+                *edited_option += edit ? 1.0f : 0.0f;
+                for (uint32_t technique = 0; technique < kTechniqueCount; ++technique)
+                {
+                    BenchmarkRunner::Consume(ConvertOptions(options, names, technique));
+                }
+            }
+        });
+
+        // Techniques reading their options through registry handles
+        runner.measure("Registry handles", name, frame_count, [&] {
+            for (uint64_t frame = 0; frame < frame_count; ++frame)
+            {
+                *edited_option += edit ? 1.0f : 0.0f;
+                registry.sync();
+                for (TechniqueHandles const &technique : handles)
+                {
+                    TechniqueOptions ret;
+                    for (uint32_t i = 0; i < kOptionsPerType; ++i)
+                    {
+                        ret.flags[i]   = registry.get(technique.flags[i]);
+                        ret.counts[i]  = registry.get(technique.counts[i]);
+                        ret.offsets[i] = registry.get(technique.offsets[i]);
+                        ret.scales[i]  = registry.get(technique.scales[i]);
+                    }
+                    BenchmarkRunner::Consume(ret);
+                }
+            }
+        });
+
+        // Techniques only converting their options when the registry generation changes
+        std::array<RenderOptionsCache<TechniqueOptions>, kTechniqueCount> caches;
+        runner.measure("Options cache", name, frame_count, [&] {
+            for (uint64_t frame = 0; frame < frame_count; ++frame)
+            {
+                *edited_option += edit ? 1.0f : 0.0f;
+                registry.sync();
+                for (uint32_t technique = 0; technique < kTechniqueCount; ++technique)
+                {
+                    BenchmarkRunner::Consume(caches[technique].get(registry,
+                        [&](RenderOptionList const &list) { return ConvertOptions(list, names, technique); }));
+                }
+            }
+        });
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,168 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "barrier_thread_pool.h"
+#include "hash_reduce.h"
+#include "host_benchmark.h"
+#include "parallel_algorithms.h"
+
+#include <numeric>
+#include <random>
+
+namespace Capsaicin
+{
+namespace
+{
+/**
+ * Hash an array with the two-level reduction tree formerly used by HashReduce(), each level being a fork/join
+ * dispatch over blocks of 16 values.
+ * @param pool   The thread pool running the dispatches.
+ * @param values The values.
+ * @param count  The number of values.
+ * @returns The hash of the values.
+ */
+size_t BarrierHashReduce(BarrierThreadPool &pool, uint32_t const *values, uint32_t count) noexcept
+{
+    constexpr uint32_t block_size  = 16;
+    uint32_t           block_count = (count + block_size - 1) / block_size;
+    if (!block_count)
+    {
+        return (size_t)0x12345678u;
+    }
+
+    // The former implementation allocated the partial hashes on the stack, which overflows with large inputs
+    std::vector<size_t> partial_hashes[] = {
+        std::vector<size_t>(block_count), std::vector<size_t>((block_count + block_size - 1) / block_size)};
+    uint32_t index = 0;
+    pool.Dispatch(
+        [&](uint32_t i) {
+            size_t hash = 0x12345678u;
+            for (uint32_t j = i * block_size; j < std::min((i + 1) * block_size, count); ++j)
+            {
+                HashCombine(hash, values[j]);
+            }
+            partial_hashes[index][i] = hash;
+        },
+        block_count, 1);
+    while (block_count > 1)
+    {
+        uint32_t const level_count = block_count;
+        block_count                = (block_count + block_size - 1) / block_size;
+        pool.Dispatch(
+            [&](uint32_t i) {
+                size_t hash = partial_hashes[index][i * block_size];
+                for (uint32_t j = i * block_size + 1; j < std::min((i + 1) * block_size, level_count); ++j)
+                {
+                    HashCombine(hash, partial_hashes[index][j]);
+                }
+                partial_hashes[1 - index][i] = hash;
+            },
+            block_count, 1);
+        index = 1 - index;
+    }
+    return partial_hashes[index][0];
+}
+} // unnamed namespace
+
+HOST_BENCHMARK(ParallelAlgorithms)
+{
+    BarrierThreadPool     barrier_pool(ThreadPool::GetThreadCount());
+    uint32_t const        count = runner.scaled(1 << 24);
+    std::vector<uint32_t> values(count);
+    std::mt19937          random(1234);
+    std::uniform_int_distribution<uint32_t> distribution(0, 255);
+    for (uint32_t &value : values)
+    {
+        value = distribution(random);
+    }
+    std::string const count_name = " of " + std::to_string(count) + " values";
+
+    // Reductions read each value once
+    runner.setItemSize(sizeof(uint32_t));
+    {
+        uint64_t sum = 0;
+        runner.measure("Serial", "Sum" + count_name, count,
+            [&] { sum = std::accumulate(values.begin(), values.end(), (uint64_t)0); });
+        runner.measure("Parallel algorithms", "Sum" + count_name, count, [&] {
+            sum = ParallelTransformReduce(
+                count, (uint64_t)0, [&](uint32_t i) { return (uint64_t)values[i]; },
+                [](uint64_t a, uint64_t b) { return a + b; });
+        });
+        BenchmarkRunner::Consume(sum);
+    }
+    {
+        size_t hash = 0;
+        runner.measure("Serial", "Hash" + count_name, count, [&] {
+            hash = 0x12345678u;
+            for (uint32_t value : values)
+            {
+                HashCombine(hash, value);
+            }
+        });
+        runner.measure("Barrier pool", "Hash" + count_name, count,
+            [&] { hash = BarrierHashReduce(barrier_pool, values.data(), count); });
+        runner.measure(
+            "Parallel algorithms", "Hash" + count_name, count, [&] { hash = HashReduce(values.data(), count); });
+        BenchmarkRunner::Consume(hash);
+    }
+
+    // Scans and compaction read each value and write up to one value
+    runner.setItemSize(2 * sizeof(uint32_t));
+    std::vector<uint32_t> output(count);
+    auto const            add = [](uint32_t a, uint32_t b) { return a + b; };
+    runner.measure("Serial", "Inclusive scan" + count_name, count,
+        [&] { std::inclusive_scan(values.begin(), values.end(), output.begin()); });
+    runner.measure("Parallel algorithms", "Inclusive scan" + count_name, count,
+        [&] { ParallelInclusiveScan(values.data(), count, output.data(), 0u, add); });
+    runner.measure("Serial", "Exclusive scan" + count_name, count,
+        [&] { std::exclusive_scan(values.begin(), values.end(), output.begin(), 0u); });
+    runner.measure("Parallel algorithms", "Exclusive scan" + count_name, count,
+        [&] { ParallelExclusiveScan(values.data(), count, output.data(), 0u, add); });
+    {
+        auto const is_kept    = [](uint32_t value) { return value < 128; };
+        size_t     kept_count = 0;
+        runner.measure("Serial", "Compaction" + count_name, count, [&] {
+            kept_count = std::copy_if(values.begin(), values.end(), output.begin(), is_kept) - output.begin();
+        });
+        runner.measure("Parallel algorithms", "Compaction" + count_name, count,
+            [&] { kept_count = ParallelCopyIf(values.data(), count, is_kept, output.data()); });
+        BenchmarkRunner::Consume(kept_count);
+    }
+    BenchmarkRunner::Consume(output[count - 1]);
+
+    // Histograms read each value, the 256 bins stay in cache
+    runner.setItemSize(sizeof(uint32_t));
+    {
+        std::vector<uint32_t> histogram;
+        runner.measure("Serial", "Histogram" + count_name, count, [&] {
+            histogram.assign(256, 0);
+            for (uint32_t value : values)
+            {
+                ++histogram[value];
+            }
+        });
+        runner.measure("Parallel algorithms", "Histogram" + count_name, count,
+            [&] { histogram = ParallelHistogram(count, 256, [&](uint32_t i) { return values[i]; }); });
+        BenchmarkRunner::Consume(histogram[0]);
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,123 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "hash_reduce.h"
+#include "host_benchmark.h"
+#include "scene_change_tracker.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace Capsaicin
+{
+namespace
+{
+/** Instance with the layout of the scene instances (GfxInstance). */
+struct SceneInstance
+{
+    uint32_t  mesh;
+    uint32_t  material;
+    glm::mat4 transform;
+};
+} // unnamed namespace
+} // namespace Capsaicin
+
+namespace std
+{
+/** Hashes the same members as the scene instance hash (see scene_hash.h). */
+template<>
+struct hash<Capsaicin::SceneInstance>
+{
+    inline size_t operator()(Capsaicin::SceneInstance const &value) const
+    {
+        size_t hash = 0x12345678u;
+
+        Capsaicin::HashCombine(hash, (uint64_t)value.mesh);
+        Capsaicin::HashCombine(hash, (uint64_t)value.material);
+        Capsaicin::HashCombine(hash, value.transform);
+
+        return hash;
+    }
+};
+} // namespace std
+
+namespace Capsaicin
+{
+HOST_BENCHMARK(SceneChanges)
+{
+    struct Input
+    {
+        char const *name;
+        uint32_t    animated_percent;
+    };
+
+    Input const inputs[] = {
+        {  "1% animated",   1},
+        { "10% animated",  10},
+        {"100% animated", 100},
+    };
+    uint32_t const             instance_count = runner.scaled(100000);
+    std::vector<SceneInstance> instances(instance_count);
+    for (uint32_t i = 0; i < instance_count; ++i)
+    {
+        instances[i] = {i % 1024, i % 64, glm::mat4(1.0f)};
+    }
+    for (Input const &input : inputs)
+    {
+        // Spread the animated instances over the scene as the nodes of an animation usually are
+        std::vector<uint32_t> animated(instance_count);
+        std::iota(animated.begin(), animated.end(), 0u);
+        std::shuffle(animated.begin(), animated.end(), std::mt19937(input.animated_percent));
+        animated.resize(glm::max((uint64_t)instance_count * input.animated_percent / 100, (uint64_t)1));
+        std::sort(animated.begin(), animated.end());
+
+        std::string const name    = std::to_string(instance_count) + " instances (" + input.name + ")";
+        auto const        animate = [&] {
+            for (uint32_t instance_index : animated)
+            {
+                instances[instance_index].transform[3][0] += 1e-3f;
+            }
+        };
+
+        // Every animated frame used to hash all the instances and compare against the previous frame's hash
+        size_t previous_hash = 0;
+        runner.measure("HashReduce", name, instance_count, [&] {
+            animate();
+            size_t const hash = HashReduce(instances.data(), instance_count);
+            BenchmarkRunner::Consume(hash != previous_hash);
+            previous_hash = hash;
+        });
+
+        // The tracker only visits the instances written by the animations
+        SceneChangeTracker tracker;
+        runner.measure("SceneChangeTracker", name, instance_count, [&] {
+            tracker.beginFrame();
+            animate();
+            for (uint32_t instance_index : animated)
+            {
+                tracker.markChanged(SceneChangeTracker::ObjectType::Transform, instance_index);
+            }
+            BenchmarkRunner::Consume(tracker.getDirty(SceneChangeTracker::ObjectType::Transform).size());
+        });
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,221 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "host_benchmark.h"
+#include "scene_flattener.h"
+
+#include <cstring>
+#include <random>
+
+namespace Capsaicin
+{
+namespace
+{
+/** Vertex with the layout of the scene vertices (GfxVertex). */
+struct SceneVertex
+{
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 uv;
+};
+
+/** Mesh with the layout of the scene meshes (GfxMesh). */
+struct SceneMesh
+{
+    std::vector<SceneVertex> vertices;
+    std::vector<uint32_t>    indices;
+};
+
+/**
+ * Build a list of random meshes.
+ * @param mesh_count   The number of meshes.
+ * @param vertex_count The number of vertices of each mesh (each has twice as many triangles).
+ * @returns The meshes.
+ */
+std::vector<SceneMesh> MakeMeshes(uint32_t mesh_count, uint32_t vertex_count) noexcept
+{
+    std::mt19937                          random(mesh_count);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<SceneMesh>                meshes(mesh_count);
+    for (SceneMesh &mesh : meshes)
+    {
+        mesh.vertices.resize(vertex_count);
+        for (SceneVertex &vertex : mesh.vertices)
+        {
+            vertex.position = glm::vec3(distribution(random), distribution(random), distribution(random));
+            vertex.normal   = glm::normalize(vertex.position + glm::vec3(0.0f, 0.0f, 2.0f));
+            vertex.uv       = glm::vec2(distribution(random), distribution(random));
+        }
+        mesh.indices.resize((size_t)vertex_count * 6);
+        for (uint32_t &index : mesh.indices)
+        {
+            index = random() % vertex_count;
+        }
+    }
+    return meshes;
+}
+
+/**
+ * Flatten the meshes the way the scene was built before the parallel flatten, appending each vertex and index to
+ * growing arrays on the calling thread then copying the arrays to the upload memory.
+ * @param       meshes         The meshes to flatten.
+ * @param [out] mesh_data      The location of each mesh in the flattened arrays.
+ * @param [out] vertex_data    The flattened vertices.
+ * @param [out] index_data     The flattened indices.
+ * @param [out] vertex_staging The upload memory of the vertices.
+ * @param [out] index_staging  The upload memory of the indices.
+ */
+void FlattenSerial(std::vector<SceneMesh> const &meshes, std::vector<Mesh> &mesh_data,
+    std::vector<Vertex> &vertex_data, std::vector<uint32_t> &index_data, std::vector<uint8_t> &vertex_staging,
+    std::vector<uint8_t> &index_staging) noexcept
+{
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        Mesh mesh              = {};
+        mesh.vertex_offset_idx = (uint32_t)vertex_data.size();
+        mesh.index_offset_idx  = (uint32_t)index_data.size();
+        mesh.index_count       = (uint32_t)meshes[i].indices.size();
+        mesh_data[i]           = mesh;
+        for (uint32_t index : meshes[i].indices)
+        {
+            index_data.push_back(index);
+        }
+        for (SceneVertex const &vertex : meshes[i].vertices)
+        {
+            vertex_data.push_back(MakeVertex(vertex));
+        }
+    }
+    memcpy(vertex_staging.data(), vertex_data.data(), vertex_data.size() * sizeof(Vertex));
+    memcpy(index_staging.data(), index_data.data(), index_data.size() * sizeof(uint32_t));
+}
+
+/**
+ * Flatten the meshes the way the scene is built, sizing the arrays up front then converting similarly sized jobs in
+ * parallel straight into the arrays and the upload memory.
+ * @param       meshes         The meshes to flatten.
+ * @param       compact        True to write compact vertices to the upload memory.
+ * @param [out] mesh_data      The location of each mesh in the flattened arrays.
+ * @param [out] vertex_data    The flattened vertices.
+ * @param [out] index_data     The flattened indices.
+ * @param [out] vertex_staging The upload memory of the vertices.
+ * @param [out] index_staging  The upload memory of the indices.
+ */
+void FlattenParallel(std::vector<SceneMesh> const &meshes, bool compact, std::vector<Mesh> &mesh_data,
+    std::vector<Vertex> &vertex_data, std::vector<uint32_t> &index_data, std::vector<uint8_t> &vertex_staging,
+    std::vector<uint8_t> &index_staging) noexcept
+{
+    size_t vertex_offset = 0;
+    size_t index_offset  = 0;
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        mesh_data[i].vertex_offset_idx = (uint32_t)vertex_offset;
+        mesh_data[i].index_offset_idx  = (uint32_t)index_offset;
+        mesh_data[i].index_count       = (uint32_t)meshes[i].indices.size();
+        vertex_offset += meshes[i].vertices.size();
+        index_offset += meshes[i].indices.size();
+    }
+    vertex_data.resize(vertex_offset);
+    index_data.resize(index_offset);
+
+    size_t const vertex_stride = compact ? sizeof(CompactVertex) : sizeof(Vertex);
+    FlattenMeshes(
+        (uint32_t)meshes.size(),
+        [&](uint32_t mesh) {
+            return (uint32_t)std::max(meshes[mesh].vertices.size(), meshes[mesh].indices.size());
+        },
+        [&](uint32_t mesh_index, uint32_t first, uint32_t last) {
+            SceneMesh const &scene_mesh = meshes[mesh_index];
+            Mesh const      &mesh       = mesh_data[mesh_index];
+            uint32_t const   vertex_end = std::min(last, (uint32_t)scene_mesh.vertices.size());
+            uint32_t const   index_end  = std::min(last, (uint32_t)scene_mesh.indices.size());
+
+            Vertex  *vertices = vertex_data.data() + mesh.vertex_offset_idx;
+            uint8_t *staging  = vertex_staging.data() + mesh.vertex_offset_idx * vertex_stride;
+            if (compact)
+            {
+                for (uint32_t j = first; j < vertex_end; ++j)
+                {
+                    vertices[j]                                   = MakeVertex(scene_mesh.vertices[j]);
+                    reinterpret_cast<CompactVertex *>(staging)[j] = MakeCompactVertex(vertices[j]);
+                }
+            }
+            else
+            {
+                for (uint32_t j = first; j < vertex_end; ++j)
+                {
+                    vertices[j]                            = MakeVertex(scene_mesh.vertices[j]);
+                    reinterpret_cast<Vertex *>(staging)[j] = vertices[j];
+                }
+            }
+            if (first < index_end)
+            {
+                uint64_t const size = (index_end - first) * sizeof(uint32_t);
+                memcpy(&index_data[(size_t)mesh.index_offset_idx + first], &scene_mesh.indices[first], size);
+                memcpy(index_staging.data() + ((size_t)mesh.index_offset_idx + first) * sizeof(uint32_t),
+                    &scene_mesh.indices[first], size);
+            }
+        });
+}
+} // unnamed namespace
+
+HOST_BENCHMARK(SceneFlatten)
+{
+    struct Input
+    {
+        char const *name;
+        uint32_t    mesh_count;
+        uint32_t    vertex_count;
+    };
+
+    Input const inputs[] = {
+        {"Many small meshes", runner.scaled(4096), 256},
+        {  "Few large meshes",         runner.scaled(4), 262144},
+    };
+    for (Input const &input : inputs)
+    {
+        std::vector<SceneMesh> const meshes       = MakeMeshes(input.mesh_count, input.vertex_count);
+        uint64_t const               vertex_count = (uint64_t)input.mesh_count * input.vertex_count;
+        std::vector<Mesh>            mesh_data(meshes.size());
+        std::vector<Vertex>          vertex_data;
+        std::vector<uint32_t>        index_data;
+        std::vector<uint8_t>         vertex_staging(vertex_count * sizeof(Vertex));
+        std::vector<uint8_t>         index_staging(vertex_count * 6 * sizeof(uint32_t));
+        auto const                   reset = [&] {
+            vertex_data = {};
+            index_data  = {};
+        };
+
+        runner.measure("Serial", input.name, vertex_count, reset, [&] {
+            FlattenSerial(meshes, mesh_data, vertex_data, index_data, vertex_staging, index_staging);
+        });
+        BenchmarkRunner::Consume(vertex_data.back());
+        runner.measure("Parallel", input.name, vertex_count, reset, [&] {
+            FlattenParallel(meshes, false, mesh_data, vertex_data, index_data, vertex_staging, index_staging);
+        });
+        BenchmarkRunner::Consume(vertex_data.back());
+        runner.measure("Parallel (compact)", input.name, vertex_count, reset, [&] {
+            FlattenParallel(meshes, true, mesh_data, vertex_data, index_data, vertex_staging, index_staging);
+        });
+        BenchmarkRunner::Consume(vertex_data.back());
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,157 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "host_benchmark.h"
+#include "texture_streamer.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint32_t kImageSize = 1024; /**< Width and height of the streamed images */
+
+/**
+ * Build a list of RGBA8 images.
+ * @param image_count The number of images.
+ * @returns The images.
+ */
+std::vector<GfxImage> MakeImages(uint32_t image_count) noexcept
+{
+    std::vector<GfxImage> images(image_count);
+    for (uint32_t i = 0; i < image_count; ++i)
+    {
+        GfxImage &image         = images[i];
+        image.width             = kImageSize;
+        image.height            = kImageSize;
+        image.format            = DXGI_FORMAT_R8G8B8A8_UNORM;
+        image.channel_count     = 4;
+        image.bytes_per_channel = 1;
+        image.data.resize((size_t)kImageSize * kImageSize * 4);
+        for (size_t j = 0; j < image.data.size(); ++j)
+        {
+            image.data[j] = (uint8_t)((j * 7 + i * 13) >> 3);
+        }
+    }
+    return images;
+}
+
+/**
+ * Get the time elapsed since a given time.
+ * @param start The start time.
+ * @returns The elapsed time (in seconds).
+ */
+double GetElapsedTime(std::chrono::high_resolution_clock::time_point start) noexcept
+{
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+} // unnamed namespace
+
+HOST_BENCHMARK(TextureStreaming)
+{
+    GfxContext const            gfx         = gfxCreateContext(1920, 1080);
+    uint32_t const              image_count = runner.scaled(32);
+    std::vector<GfxImage> const images      = MakeImages(image_count);
+    std::vector<GfxTexture>     textures;
+    std::string const           input = std::to_string(image_count) + " textures of " + std::to_string(kImageSize)
+                                + "x" + std::to_string(kImageSize) + " RGBA8";
+
+    auto const createTexture = [&](GfxImage const &image) {
+        return gfxCreateTexture2D(gfx, image.width, image.height, image.format, GetMipCount(image.width, image.height));
+    };
+    auto const releaseTextures = [&] {
+        for (GfxTexture const &texture : textures)
+        {
+            gfxDestroyTexture(gfx, texture);
+        }
+        textures.clear();
+    };
+
+    // Before streaming every texture was uploaded by the load through its own staging buffer, stalling the first
+    // frame until it was all copied
+    runner.measure("Upload during load", input + " (load stall)", image_count, releaseTextures, [&] {
+        for (GfxImage const &image : images)
+        {
+            GfxTexture const texture = createTexture(image);
+            GfxBuffer const  staging = gfxCreateBuffer(gfx, image.data.size(), image.data.data(), kGfxCpuAccess_Write);
+            gfxCommandCopyBufferToTexture(gfx, texture, staging);
+            gfxCommandGenerateMips(gfx, texture);
+            gfxDestroyBuffer(gfx, staging);
+            textures.push_back(texture);
+        }
+    });
+    releaseTextures();
+    double const load_time = runner.getResults().back().seconds;
+    runner.record("Upload during load", input + " (worst frame)", image_count, load_time);
+    runner.record("Upload during load", input + " (until streamed)", image_count, load_time);
+
+    // Streaming only copies the texels during load, the mip chains are then generated in the background and uploaded
+    // within the budget of each frame
+    for (uint32_t const budget : {1u, 4u, 16u})
+    {
+        TextureStreamer streamer;
+        if (!streamer.initialize(gfx, (uint64_t)budget << 20, MipFilter::Box))
+        {
+            continue;
+        }
+        std::string const variant    = "Streamed (" + std::to_string(budget) + " MiB budget)";
+        auto const        requestAll = [&] {
+            for (uint32_t i = 0; i < image_count; ++i)
+            {
+                streamer.request(i, createTexture(images[i]), images[i]);
+            }
+        };
+        runner.measure(variant, input + " (load stall)", image_count, [&] { streamer.cancelAll(); }, requestAll);
+        streamer.cancelAll();
+
+        // The frame loop is only timed as a whole, so it is run the requested number of times keeping the best
+        double                                       worst_frame = 0.0;
+        double                                       stream_time = 0.0;
+        std::vector<std::pair<uint32_t, GfxTexture>> completed;
+        for (uint32_t i = 0; i < runner.getRepeatCount(); ++i)
+        {
+            requestAll();
+            double     frame_time = 0.0;
+            auto const start      = std::chrono::high_resolution_clock::now();
+            while (streamer.getPendingCount() > 0)
+            {
+                auto const frame_start = std::chrono::high_resolution_clock::now();
+                streamer.update(completed);
+                gfxFrame(gfx);
+                frame_time = std::max(frame_time, GetElapsedTime(frame_start));
+                for (auto const &[image_index, texture] : completed)
+                {
+                    textures.push_back(texture);
+                }
+            }
+            double const time = GetElapsedTime(start);
+            worst_frame       = i == 0 ? frame_time : std::min(worst_frame, frame_time);
+            stream_time       = i == 0 ? time : std::min(stream_time, time);
+            releaseTextures();
+        }
+        runner.record(variant, input + " (worst frame)", image_count, worst_frame);
+        runner.record(variant, input + " (until streamed)", image_count, stream_time);
+    }
+    gfxDestroyContext(gfx);
+}
+} // namespace Capsaicin
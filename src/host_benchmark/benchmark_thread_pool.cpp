@@ -0,0 +1,105 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "barrier_thread_pool.h"
+#include "host_benchmark.h"
+#include "thread_pool.h"
+
+#include <cmath>
+
+namespace Capsaicin
+{
+HOST_BENCHMARK(ThreadPool)
+{
+    BarrierThreadPool barrier_pool(ThreadPool::GetThreadCount());
+
+    // Fork/join latency of small dispatches, as issued many times per frame by the renderer
+    {
+        uint32_t const        dispatch_count = runner.scaled(1000);
+        uint32_t const        count          = 256;
+        std::vector<uint32_t> output(count);
+        auto const            kernel = [&](uint32_t i) { output[i] = i; };
+        std::string const     name   = std::to_string(dispatch_count) + " dispatches of " + std::to_string(count);
+        runner.measure("Barrier pool", name, dispatch_count, [&] {
+            for (uint32_t i = 0; i < dispatch_count; ++i)
+            {
+                barrier_pool.Dispatch(kernel, count);
+            }
+        });
+        runner.measure("Scheduler Dispatch", name, dispatch_count, [&] {
+            for (uint32_t i = 0; i < dispatch_count; ++i)
+            {
+                ThreadPool().Dispatch(kernel, count);
+            }
+        });
+        runner.measure("Scheduler ParallelFor", name, dispatch_count, [&] {
+            for (uint32_t i = 0; i < dispatch_count; ++i)
+            {
+                ThreadPool::ParallelFor(count, kernel);
+            }
+        });
+        BenchmarkRunner::Consume(output[count - 1]);
+    }
+
+    // Throughput of a large dispatch
+    {
+        uint32_t const     count = runner.scaled(1 << 20);
+        std::vector<float> output(count);
+        auto const         kernel = [&](uint32_t i) { output[i] = std::sqrt((float)i); };
+        std::string const  name   = "1 dispatch of " + std::to_string(count);
+        runner.measure("Barrier pool", name, count, [&] { barrier_pool.Dispatch(kernel, count); });
+        runner.measure("Scheduler Dispatch", name, count, [&] { ThreadPool().Dispatch(kernel, count); });
+        runner.measure("Scheduler ParallelFor", name, count, [&] { ThreadPool::ParallelFor(count, kernel); });
+        BenchmarkRunner::Consume(output[count - 1]);
+    }
+
+    // Nested parallelism, the barrier pool can only run the inner loops one at a time from the calling thread
+    {
+        uint32_t const     outer_count = 64;
+        uint32_t const     inner_count = runner.scaled(4096);
+        std::vector<float> output((size_t)outer_count * inner_count);
+        auto const         inner_kernel = [&](uint32_t outer, uint32_t i) {
+            output[(size_t)outer * inner_count + i] = std::sqrt((float)(outer + i));
+        };
+        std::string const name = std::to_string(outer_count) + " nested dispatches of " + std::to_string(inner_count);
+        uint64_t const    item_count = (uint64_t)outer_count * inner_count;
+        runner.measure("Barrier pool", name, item_count, [&] {
+            for (uint32_t outer = 0; outer < outer_count; ++outer)
+            {
+                barrier_pool.Dispatch([&](uint32_t i) { inner_kernel(outer, i); }, inner_count);
+            }
+        });
+        runner.measure("Scheduler Dispatch", name, item_count, [&] {
+            ThreadPool().Dispatch(
+                [&](uint32_t outer) {
+                    ThreadPool().Dispatch([&](uint32_t i) { inner_kernel(outer, i); }, inner_count);
+                },
+                outer_count, 1);
+        });
+        runner.measure("Scheduler ParallelFor", name, item_count, [&] {
+            ThreadPool::ParallelFor(outer_count, [&](uint32_t outer) {
+                ThreadPool::ParallelFor(inner_count, [&](uint32_t i) { inner_kernel(outer, i); });
+            });
+        });
+        BenchmarkRunner::Consume(output.back());
+    }
+}
+} // namespace Capsaicin
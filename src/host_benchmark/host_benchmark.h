@@ -0,0 +1,177 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Capsaicin
+{
+/** A timing reported by a host benchmark. */
+struct BenchmarkResult
+{
+    std::string benchmark;  /**< The name of the benchmark */
+    std::string variant;    /**< The measured implementation (e.g., serial or parallel) */
+    std::string input;      /**< The description of the input data */
+    uint64_t    item_count; /**< The number of items processed by an iteration */
+    uint64_t    byte_count; /**< The number of bytes accessed by an iteration (0 if not reported) */
+    double      seconds;    /**< The fastest iteration time (in seconds) */
+};
+
+/**
+ * Runs the host benchmarks and collects their timings.
+ * Benchmarks are plain functions registered with HOST_BENCHMARK(), they build their inputs then time each
+ * implementation with measure(). Each implementation is run several times and the fastest iteration is kept.
+ */
+class BenchmarkRunner
+{
+public:
+    using Function = void (*)(BenchmarkRunner &runner);
+
+    /**
+     * Register a benchmark (see HOST_BENCHMARK()).
+     * @param name     The name of the benchmark.
+     * @param function The benchmark function.
+     * @returns Always True.
+     */
+    static bool Register(char const *name, Function function) noexcept;
+
+    /**
+     * Run the registered benchmarks.
+     * @param filter       Only run the benchmarks whose name contains this string (all if empty).
+     * @param repeat_count The number of timed iterations of each implementation.
+     * @param scale        Multiplier of the benchmark input sizes.
+     * @returns The number of benchmarks run.
+     */
+    uint32_t run(std::string const &filter, uint32_t repeat_count, double scale) noexcept;
+
+    /**
+     * Time an implementation, reporting its fastest iteration.
+     * @param variant    The name of the implementation.
+     * @param input      The description of the input data.
+     * @param item_count The number of items processed by an iteration (used to report throughput).
+     * @param prepare    Called before each iteration to reset the data (not timed).
+     * @param kernel     The timed work.
+     */
+    template<typename PREPARE, typename KERNEL>
+    void measure(std::string const &variant, std::string const &input, uint64_t item_count, PREPARE const &prepare,
+        KERNEL const &kernel) noexcept
+    {
+        double best = 0.0;
+        for (uint32_t i = 0; i < repeat_count_ + 1; ++i)
+        {
+            prepare();
+            auto const start = std::chrono::high_resolution_clock::now();
+            kernel();
+            double const seconds =
+                std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+            if (i > 0 && (i == 1 || seconds < best))
+            {
+                best = seconds; // first iteration warms up the caches and the thread pool
+            }
+        }
+        results_.push_back({benchmark_, variant, input, item_count, item_count * item_size_, best});
+    }
+
+    /**
+     * Time an implementation that needs no reset between iterations.
+     * @param variant    The name of the implementation.
+     * @param input      The description of the input data.
+     * @param item_count The number of items processed by an iteration (used to report throughput).
+     * @param kernel     The timed work.
+     */
+    template<typename KERNEL>
+    void measure(std::string const &variant, std::string const &input, uint64_t item_count,
+        KERNEL const &kernel) noexcept
+    {
+        measure(variant, input, item_count, [] {}, kernel);
+    }
+
+    /**
+     * Report a timing measured by the benchmark itself (e.g., the slowest frame of a frame loop).
+     * @param variant    The name of the implementation.
+     * @param input      The description of the input data.
+     * @param item_count The number of items processed (used to report throughput).
+     * @param seconds    The measured time (in seconds).
+     */
+    void record(std::string const &variant, std::string const &input, uint64_t item_count, double seconds) noexcept
+    {
+        results_.push_back({benchmark_, variant, input, item_count, item_count * item_size_, seconds});
+    }
+
+    /**
+     * Set the number of bytes read and written per item by the implementations timed next, used to report their
+     * memory bandwidth. Reset to 0 (not reported) at the start of each benchmark.
+     * @param item_size The number of bytes per item.
+     */
+    void setItemSize(uint64_t item_size) noexcept { item_size_ = item_size; }
+
+    /**
+     * Gets the number of timed iterations requested for each implementation.
+     * @returns The repeat count.
+     */
+    uint32_t getRepeatCount() const noexcept { return repeat_count_; }
+
+    /**
+     * Scale a benchmark input size by the requested scale.
+     * @param count The default size.
+     * @returns The scaled size (at least 1).
+     */
+    uint32_t scaled(uint32_t count) const noexcept;
+
+    /**
+     * Keep a value alive so that the compiler can't optimise away the work producing it.
+     * @param value The value.
+     */
+    template<typename TYPE>
+    static void Consume(TYPE const &value) noexcept
+    {
+        sink_ = *reinterpret_cast<char const volatile *>(&value);
+    }
+
+    /**
+     * Gets the timings recorded by the benchmarks.
+     * @returns The timings, in run order.
+     */
+    std::vector<BenchmarkResult> const &getResults() const noexcept { return results_; }
+
+private:
+    std::string                  benchmark_;          /**< The name of the running benchmark */
+    uint32_t                     repeat_count_ = 1;   /**< The number of timed iterations */
+    double                       scale_        = 1.0; /**< The multiplier of the input sizes */
+    uint64_t                     item_size_    = 0;   /**< The number of bytes accessed per item */
+    std::vector<BenchmarkResult> results_;            /**< The timings recorded so far */
+
+    static inline volatile char sink_ = 0; /**< Written by Consume() so the consumed values stay live */
+};
+} // namespace Capsaicin
+
+/**
+ * Define a host benchmark, the function body receives the runner as 'runner'.
+ * @param NAME The name of the benchmark.
+ */
+#define HOST_BENCHMARK(NAME)                                                                           \
+    static void       NAME##Benchmark(Capsaicin::BenchmarkRunner &runner);                             \
+    static bool const NAME##Registered = Capsaicin::BenchmarkRunner::Register(#NAME, NAME##Benchmark); \
+    static void       NAME##Benchmark(Capsaicin::BenchmarkRunner &runner)
@@ -0,0 +1,149 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "host_benchmark.h"
+#include "thread_pool.h"
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace Capsaicin
+{
+namespace
+{
+/** A registered benchmark. */
+struct Benchmark
+{
+    char const               *name;
+    BenchmarkRunner::Function function;
+};
+
+/**
+ * Gets the registered benchmarks, created on first use as benchmarks register during static initialisation.
+ * @returns The benchmarks.
+ */
+std::vector<Benchmark> &GetBenchmarks() noexcept
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+} // unnamed namespace
+
+bool BenchmarkRunner::Register(char const *name, Function function) noexcept
+{
+    GetBenchmarks().push_back({name, function});
+    return true;
+}
+
+uint32_t BenchmarkRunner::run(std::string const &filter, uint32_t repeat_count, double scale) noexcept
+{
+    std::vector<Benchmark> benchmarks = GetBenchmarks();
+    std::sort(benchmarks.begin(), benchmarks.end(),
+        [](Benchmark const &a, Benchmark const &b) { return std::string_view(a.name) < std::string_view(b.name); });
+    repeat_count_      = std::max(repeat_count, 1u);
+    scale_             = scale;
+    uint32_t run_count = 0;
+    for (Benchmark const &benchmark : benchmarks)
+    {
+        if (!filter.empty() && std::string_view(benchmark.name).find(filter) == std::string_view::npos)
+        {
+            continue;
+        }
+        fprintf(stderr, "Running %s\n", benchmark.name);
+        benchmark_ = benchmark.name;
+        item_size_ = 0;
+        benchmark.function(*this);
+        ++run_count;
+    }
+    return run_count;
+}
+
+uint32_t BenchmarkRunner::scaled(uint32_t count) const noexcept
+{
+    return std::max((uint32_t)(count * scale_), 1u);
+}
+} // namespace Capsaicin
+
+using namespace Capsaicin;
+
+int main(int argc, char **argv)
+{
+    CLI::App app("Capsaicin - Host Benchmark");
+    std::string filter;
+    app.add_option("-f,--filter", filter, "Only run the benchmarks whose name contains this string");
+    std::string output_path;
+    app.add_option("-o,--output", output_path, "CSV file to write the timings to (printed if omitted)");
+    uint32_t repeat_count = 5;
+    app.add_option("-r,--repeat", repeat_count, "Number of timed iterations, the fastest one is reported")
+        ->check(CLI::PositiveNumber);
+    double scale = 1.0;
+    app.add_option("-s,--scale", scale, "Multiplier of the benchmark input sizes")->check(CLI::PositiveNumber);
+    uint32_t thread_count = std::thread::hardware_concurrency();
+    app.add_option("-j,--threads", thread_count, "Number of threads used by the parallel implementations");
+    CLI11_PARSE(app, argc, argv);
+
+    std::ofstream output_file;
+    if (!output_path.empty())
+    {
+        output_file.open(output_path);
+        if (!output_file.is_open())
+        {
+            fprintf(stderr, "Can't create '%s'\n", output_path.c_str());
+            return 1;
+        }
+    }
+    std::ostream &output = output_path.empty() ? std::cout : output_file;
+
+    ThreadPool::Create(thread_count);
+    BenchmarkRunner runner;
+    uint32_t const  run_count = runner.run(filter, repeat_count, scale);
+    ThreadPool::Destroy();
+    if (run_count == 0)
+    {
+        fprintf(stderr, "No benchmark matches '%s'\n", filter.c_str());
+        return 1;
+    }
+
+    // The speedup of each implementation is relative to the first implementation timed on the same input
+    // The bandwidth is left empty for the benchmarks that don't report the bytes accessed per item
+    output << "Benchmark,Variant,Input,Items,Time (ms),Items per second,GB/s,Speedup\n";
+    std::vector<BenchmarkResult> const &results = runner.getResults();
+    for (BenchmarkResult const &result : results)
+    {
+        BenchmarkResult const &baseline =
+            *std::find_if(results.begin(), results.end(), [&](BenchmarkResult const &other) {
+                return other.benchmark == result.benchmark && other.input == result.input;
+            });
+        output << result.benchmark << ',' << result.variant << ',' << result.input << ',' << result.item_count << ','
+               << result.seconds * 1000.0 << ',' << (result.seconds > 0.0 ? result.item_count / result.seconds : 0.0)
+               << ',';
+        if (result.byte_count != 0)
+        {
+            output << (result.seconds > 0.0 ? result.byte_count / result.seconds * 1e-9 : 0.0);
+        }
+        output << ',' << (result.seconds > 0.0 ? baseline.seconds / result.seconds : 0.0) << '\n';
+    }
+    return 0;
+}
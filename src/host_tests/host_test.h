@@ -0,0 +1,97 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+namespace Capsaicin
+{
+/**
+ * State of a running host test.
+ * Tests are plain functions registered with HOST_TEST(), they check their expectations with HOST_CHECK() and keep
+ * running after a failed check so that every failure of a test gets reported.
+ */
+class HostTest
+{
+public:
+    using Function = void (*)(HostTest &test);
+
+    /**
+     * Register a test (see HOST_TEST()).
+     * @param name     The name of the test.
+     * @param function The test function.
+     * @returns Always True.
+     */
+    static bool Register(char const *name, Function function) noexcept;
+
+    /**
+     * Run the registered tests.
+     * @param filter Only run the tests whose name contains this string (all if nullptr).
+     * @returns The number of failed tests.
+     */
+    static uint32_t RunAll(char const *filter) noexcept;
+
+    /**
+     * Check an expectation (see HOST_CHECK()).
+     * @param passed     The result of the check.
+     * @param expression The checked expression.
+     * @param file       The source file of the check.
+     * @param line       The source line of the check.
+     * @returns The result of the check.
+     */
+    bool check(bool passed, char const *expression, char const *file, int line) noexcept
+    {
+        if (!passed)
+        {
+            fprintf(stderr, "%s(%d): check failed: %s\n", file, line, expression);
+            ++failure_count_;
+        }
+        return passed;
+    }
+
+    /**
+     * Gets the number of failed checks of the test.
+     * @returns The failure count.
+     */
+    uint32_t getFailureCount() const noexcept { return failure_count_; }
+
+private:
+    uint32_t failure_count_ = 0;
+};
+} // namespace Capsaicin
+
+/**
+ * Define a host test, the function body receives the test state as 'test'.
+ * @param NAME The name of the test.
+ */
+#define HOST_TEST(NAME)                                                                    \
+    static void       NAME##Test(Capsaicin::HostTest &test);                               \
+    static bool const NAME##Registered = Capsaicin::HostTest::Register(#NAME, NAME##Test); \
+    static void       NAME##Test(Capsaicin::HostTest &test)
+
+/**
+ * Check an expectation of a host test, failures are reported and the test keeps running.
+ * @param CONDITION The expected condition.
+ * @returns The result of the check.
+ */
+#define HOST_CHECK(CONDITION) test.check(!!(CONDITION), #CONDITION, __FILE__, __LINE__)
@@ -0,0 +1,94 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "host_test.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Capsaicin
+{
+namespace
+{
+/** A registered test. */
+struct Test
+{
+    char const        *name;
+    HostTest::Function function;
+};
+
+/**
+ * Gets the registered tests, created on first use as tests register during static initialisation.
+ * @returns The tests.
+ */
+std::vector<Test> &GetTests() noexcept
+{
+    static std::vector<Test> tests;
+    return tests;
+}
+} // unnamed namespace
+
+bool HostTest::Register(char const *name, Function function) noexcept
+{
+    GetTests().push_back({name, function});
+    return true;
+}
+
+uint32_t HostTest::RunAll(char const *filter) noexcept
+{
+    std::vector<Test> tests = GetTests();
+    std::sort(tests.begin(), tests.end(),
+        [](Test const &a, Test const &b) { return std::string_view(a.name) < std::string_view(b.name); });
+    uint32_t run_count     = 0;
+    uint32_t failure_count = 0;
+    for (Test const &test : tests)
+    {
+        if (filter != nullptr && std::string_view(test.name).find(filter) == std::string_view::npos)
+        {
+            continue;
+        }
+        HostTest   state;
+        auto const start = std::chrono::high_resolution_clock::now();
+        test.function(state);
+        double const time =
+            std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        printf("[%s] %s (%.1fms)\n", state.getFailureCount() == 0 ? "PASSED" : "FAILED", test.name, time * 1000.0);
+        failure_count += (state.getFailureCount() != 0 ? 1 : 0);
+        ++run_count;
+    }
+    printf("%u/%u tests passed\n", run_count - failure_count, run_count);
+    return run_count == 0 ? 1 : failure_count;
+}
+} // namespace Capsaicin
+
+int main(int argc, char **argv)
+{
+    // Tests run with the same scheduler as Capsaicin so that the parallel code paths get exercised
+    Capsaicin::ThreadPool::Create(std::max(std::thread::hardware_concurrency(), 4u));
+    uint32_t const failure_count = Capsaicin::HostTest::RunAll(argc > 1 ? argv[1] : nullptr);
+    Capsaicin::ThreadPool::Destroy();
+    return failure_count == 0 ? 0 : 1;
+}
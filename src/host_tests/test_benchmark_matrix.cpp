@@ -0,0 +1,163 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "benchmark_matrix.h"
+#include "host_test.h"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+namespace Capsaicin
+{
+namespace
+{
+/**
+ * Build the summary of a section.
+ * @param name     The section name.
+ * @param mean     The mean of the samples (in milliseconds).
+ * @param variance The population variance of the samples.
+ * @param count    The number of samples.
+ * @returns The summary.
+ */
+TimingSummary MakeTiming(char const *name, double mean, double variance, uint32_t count = 256) noexcept
+{
+    TimingSummary timing;
+    timing.name     = name;
+    timing.count    = count;
+    timing.min      = mean - 1.0;
+    timing.mean     = mean;
+    timing.p50      = mean;
+    timing.p95      = mean + 0.5;
+    timing.p99      = mean + 0.75;
+    timing.max      = mean + 1.0;
+    timing.variance = variance;
+    return timing;
+}
+} // unnamed namespace
+
+HOST_TEST(BenchmarkRegressionThreshold)
+{
+    double change = 0.0;
+    double t      = 0.0;
+
+    // Identical timings never change
+    TimingSummary const baseline = MakeTiming("Frame", 10.0, 0.01);
+    HOST_CHECK(CompareBenchmarkTimings(baseline, baseline, 2.0, change, t) == BenchmarkStatus::Unchanged);
+    HOST_CHECK(change == 0.0 && t == 0.0);
+
+    // A significant 5% slow down is only reported above the threshold
+    TimingSummary const slower = MakeTiming("Frame", 10.5, 0.01);
+    HOST_CHECK(CompareBenchmarkTimings(slower, baseline, 2.0, change, t) == BenchmarkStatus::Regressed);
+    HOST_CHECK(std::abs(change - 5.0) < 1e-9);
+    HOST_CHECK(t > 3.0);
+    HOST_CHECK(CompareBenchmarkTimings(slower, baseline, 10.0, change, t) == BenchmarkStatus::Unchanged);
+    HOST_CHECK(CompareBenchmarkTimings(slower, baseline, 5.0, change, t) == BenchmarkStatus::Unchanged);
+
+    // ... and must be statistically significant (Welch's t-test on the sample variances)
+    TimingSummary const noisy = MakeTiming("Frame", 10.5, 100.0);
+    HOST_CHECK(CompareBenchmarkTimings(noisy, baseline, 2.0, change, t) == BenchmarkStatus::Unchanged);
+    double const expected_t = 0.5 / std::sqrt(100.0 * 256 / 255 / 256 + 0.01 * 256 / 255 / 256);
+    HOST_CHECK(std::abs(t - expected_t) < 1e-9);
+
+    // Speed ups are reported the same way
+    TimingSummary const faster = MakeTiming("Frame", 9.0, 0.01);
+    HOST_CHECK(CompareBenchmarkTimings(faster, baseline, 2.0, change, t) == BenchmarkStatus::Improved);
+    HOST_CHECK(std::abs(change + 10.0) < 1e-9 && t < -3.0);
+
+    // Constant timings are infinitely significant, a single sample never is
+    TimingSummary const constant = MakeTiming("Frame", 10.0, 0.0);
+    HOST_CHECK(CompareBenchmarkTimings(MakeTiming("Frame", 11.0, 0.0), constant, 2.0, change, t)
+               == BenchmarkStatus::Regressed);
+    HOST_CHECK(std::isinf(t) && t > 0.0);
+    HOST_CHECK(CompareBenchmarkTimings(MakeTiming("Frame", 20.0, 0.0, 1), constant, 2.0, change, t)
+               == BenchmarkStatus::Unchanged);
+}
+
+HOST_TEST(BenchmarkBaselineReport)
+{
+    std::filesystem::path const directory = std::filesystem::temp_directory_path() / "capsaicin_host_tests";
+    std::filesystem::create_directories(directory);
+    std::filesystem::path const matrix_path   = directory / "benchmark_matrix.txt";
+    std::filesystem::path const baseline_path = directory / "benchmark_baseline.csv";
+    std::filesystem::path const report_path   = directory / "benchmark_report.csv";
+
+    // The matrix threshold is used to compare against the baseline
+    {
+        std::ofstream file(matrix_path);
+        file << "# Test matrix" << '\n'
+             << "scenes = Sponza, Gas Station" << '\n'
+             << "renderers = Path Tracer" << '\n'
+             << "options = HalfRes: option_a=1 option_b=2" << '\n'
+             << "regression_threshold = 3.5" << '\n';
+    }
+    BenchmarkMatrix matrix;
+    std::string     error;
+    HOST_CHECK(matrix.load(matrix_path.string(), error));
+    HOST_CHECK(matrix.scenes.size() == 2 && matrix.scenes[1] == "Gas Station");
+    HOST_CHECK(matrix.optionSets.size() == 1 && matrix.optionSets[0].options.size() == 2);
+    HOST_CHECK(matrix.regressionThreshold == 3.5);
+    std::filesystem::remove(matrix_path);
+
+    // Names with separators are written as they are compared
+    std::vector<BenchmarkResult> baseline = {
+        {"Sponza", "", "Path Tracer", "HalfRes", MakeTiming("Frame", 10.0, 0.01)},
+        {"Sponza", "", "Path Tracer", "HalfRes", MakeTiming("Pass, primary", 2.0, 0.0001)},
+        {"Gas Station", "", "Path Tracer", "HalfRes", MakeTiming("Frame", 20.0, 0.01)},
+    };
+    std::vector<BenchmarkResult> regressions;
+    HOST_CHECK(WriteBenchmarkReport(baseline_path.string(), baseline, {}, matrix.regressionThreshold, regressions));
+    HOST_CHECK(regressions.empty());
+    std::vector<BenchmarkResult> loaded;
+    HOST_CHECK(ReadBenchmarkReport(baseline_path.string(), loaded));
+    HOST_CHECK(loaded.size() == baseline.size());
+    for (size_t i = 0; i < loaded.size() && i < baseline.size(); ++i)
+    {
+        HOST_CHECK(loaded[i].scene == baseline[i].scene && loaded[i].renderer == baseline[i].renderer);
+        HOST_CHECK(loaded[i].timing.count == baseline[i].timing.count);
+        HOST_CHECK(loaded[i].timing.mean == baseline[i].timing.mean);
+        HOST_CHECK(loaded[i].timing.variance == baseline[i].timing.variance);
+    }
+    HOST_CHECK(loaded.size() < 2 || loaded[1].timing.name == "Pass; primary");
+
+    // Only the significant slow downs above the threshold regress, cells missing from the baseline are new
+    std::vector<BenchmarkResult> results = {
+        {"Sponza", "", "Path Tracer", "HalfRes", MakeTiming("Frame", 10.2, 0.01)},
+        {"Sponza", "", "Path Tracer", "HalfRes", MakeTiming("Pass, primary", 2.5, 0.0001)},
+        {"Gas Station", "", "Path Tracer", "HalfRes", MakeTiming("Frame", 19.0, 0.01)},
+        {"Gas Station", "", "Path Tracer", "HalfRes", MakeTiming("Pass, primary", 5.0, 0.0001)},
+    };
+    HOST_CHECK(WriteBenchmarkReport(report_path.string(), results, loaded, matrix.regressionThreshold, regressions));
+    HOST_CHECK(regressions.size() == 1 && regressions[0].timing.name == "Pass, primary");
+    std::ifstream            report(report_path);
+    std::string              line;
+    std::vector<std::string> statuses;
+    while (std::getline(report, line))
+    {
+        statuses.push_back(line.substr(line.rfind(',') + 1));
+    }
+    report.close();
+    HOST_CHECK(statuses == std::vector<std::string>({"Status", "Unchanged", "Regressed", "Improved", "New"}));
+
+    std::filesystem::remove(baseline_path);
+    std::filesystem::remove(report_path);
+}
+} // namespace Capsaicin
@@ -0,0 +1,128 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "camera_trajectory.h"
+#include "host_test.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace Capsaicin
+{
+namespace
+{
+/**
+ * Get the camera state of a test frame.
+ * @param frame_index The index of the frame.
+ * @returns The camera state.
+ */
+CameraKeyframe GetKeyframe(uint32_t frame_index) noexcept
+{
+    float const    t = (float)frame_index;
+    CameraKeyframe keyframe;
+    keyframe.frame_index = frame_index;
+    keyframe.fov_y       = 0.5f + 0.01f * t;
+    keyframe.play_time   = frame_index / 60.0;
+    keyframe.eye         = glm::vec3(t, 1.0f, -t);
+    keyframe.center      = glm::vec3(0.0f, 0.5f * t, 0.0f);
+    keyframe.up          = glm::vec3(0.0f, 1.0f, 0.0f);
+    keyframe.aspect      = 16.0f / 9.0f;
+    keyframe.jitter_x    = 0.25f - 0.01f * t;
+    keyframe.jitter_y    = -0.25f + 0.01f * t;
+    return keyframe;
+}
+
+/**
+ * Check that two camera states match exactly.
+ * @param lhs The first camera state.
+ * @param rhs The second camera state.
+ * @returns True if equal.
+ */
+bool Equal(CameraKeyframe const &lhs, CameraKeyframe const &rhs) noexcept
+{
+    return lhs.frame_index == rhs.frame_index && lhs.fov_y == rhs.fov_y && lhs.play_time == rhs.play_time
+        && lhs.eye == rhs.eye && lhs.center == rhs.center && lhs.up == rhs.up && lhs.aspect == rhs.aspect
+        && lhs.jitter_x == rhs.jitter_x && lhs.jitter_y == rhs.jitter_y;
+}
+} // unnamed namespace
+
+HOST_TEST(CameraTrajectoryRoundTrip)
+{
+    std::filesystem::path const directory = std::filesystem::temp_directory_path() / "capsaicin_host_tests";
+    std::filesystem::create_directories(directory);
+    std::string const file_path = (directory / "camera.ctrj").string();
+
+    // Frames 0 to 9 then 20 to 24, repeated and older frames are skipped
+    {
+        CameraTrajectoryWriter writer;
+        HOST_CHECK(writer.open(file_path.c_str()));
+        for (uint32_t frame_index = 0; frame_index < 10; ++frame_index)
+        {
+            writer.write(GetKeyframe(frame_index));
+            writer.write(GetKeyframe(frame_index));
+        }
+        writer.write(GetKeyframe(3));
+        for (uint32_t frame_index = 20; frame_index < 25; ++frame_index)
+        {
+            writer.write(GetKeyframe(frame_index));
+        }
+        HOST_CHECK(writer.getKeyframeCount() == 15);
+        writer.close();
+        HOST_CHECK(!writer.isOpen());
+    }
+
+    CameraTrajectoryReader reader;
+    if (HOST_CHECK(reader.open(file_path.c_str())))
+    {
+        HOST_CHECK(reader.getKeyframeCount() == 15);
+        HOST_CHECK(reader.getLastFrameIndex() == 24);
+
+        // Consecutive, rewound and random look ups
+        for (uint32_t frame_index : {0u, 1u, 2u, 9u, 20u, 21u, 4u, 5u, 24u, 0u})
+        {
+            CameraKeyframe const *keyframe = reader.find(frame_index);
+            HOST_CHECK(keyframe != nullptr && Equal(*keyframe, GetKeyframe(frame_index)));
+        }
+        for (uint32_t frame_index : {10u, 19u, 25u, UINT32_MAX})
+        {
+            HOST_CHECK(reader.find(frame_index) == nullptr);
+        }
+        reader.close();
+        HOST_CHECK(!reader.isOpen() && reader.find(0) == nullptr);
+    }
+
+    // Files from another layout, or holding no frame, are refused
+    {
+        std::fstream file(file_path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(4);
+        uint32_t const version = CameraTrajectoryWriter::kVersion + 1;
+        file.write((char const *)&version, sizeof(version));
+    }
+    HOST_CHECK(!reader.open(file_path.c_str()));
+    {
+        CameraTrajectoryWriter writer;
+        HOST_CHECK(writer.open(file_path.c_str()));
+    }
+    HOST_CHECK(!reader.open(file_path.c_str()));
+    HOST_CHECK(!reader.open((directory / "missing.ctrj").string().c_str()));
+    std::filesystem::remove_all(directory);
+}
+} // namespace Capsaicin
@@ -0,0 +1,204 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "cpu_flip.h"
+#include "host_test.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint kImageWidth  = 37; /**< Width of the test images (not a multiple of the tile size) */
+constexpr uint kImageHeight = 29; /**< Height of the test images (not a multiple of the tile size) */
+constexpr uint kTileSize    = 16; /**< Size of the histogram tiles */
+
+/** HyAB distance between the Hunt adjusted L*a*b* green and blue, the largest colour distance of FLIP. */
+constexpr double kMaxHyAB = 203.305;
+
+/**
+ * Build an image of a single colour.
+ * @param value The linear value of the RGB channels.
+ * @returns The image pixels.
+ */
+std::vector<float> MakeUniformImage(float value) noexcept
+{
+    std::vector<float> image((size_t)kImageWidth * kImageHeight * 4, value);
+    for (size_t pixel = 0; pixel < (size_t)kImageWidth * kImageHeight; ++pixel)
+    {
+        image[4 * pixel + 3] = 1.0f;
+    }
+    return image;
+}
+
+/**
+ * Gets the FLIP error of 2 greys, uniform images having neither contrast to filter nor features.
+ * @param source    The linear value of the source grey.
+ * @param reference The linear value of the reference grey.
+ * @returns The colour error.
+ */
+double GetGreyError(double source, double reference) noexcept
+{
+    // Greys have no chroma so their HyAB distance is the difference of their L* lightness
+    auto const lightness = [](double luminance) {
+        double const delta = 6.0 / 29.0;
+        return 116.0 * (luminance > delta * delta * delta ? std::cbrt(luminance)
+                                                          : luminance / (3.0 * delta * delta) + 4.0 / 29.0)
+             - 16.0;
+    };
+    double const distance   = std::pow(std::abs(lightness(source) - lightness(reference)), 0.7);
+    double const max_error  = std::pow(kMaxHyAB, 0.7);
+    double const breakpoint = 0.4 * max_error;
+    return distance < breakpoint ? 0.95 * distance / breakpoint
+                                 : 0.95 + 0.05 * (distance - breakpoint) / (max_error - breakpoint);
+}
+
+/**
+ * Check that every pixel of each tile falls in a single bin.
+ * @param histograms The tile histograms.
+ * @param bin_count  The number of bins of each histogram.
+ * @param bin        The expected bin.
+ * @returns True if the histograms match.
+ */
+bool IsSingleBin(std::vector<uint> const &histograms, uint bin_count, uint bin) noexcept
+{
+    uint const tile_count_x = (kImageWidth + kTileSize - 1) / kTileSize;
+    uint const tile_count_y = (kImageHeight + kTileSize - 1) / kTileSize;
+    if (histograms.size() != (size_t)tile_count_x * tile_count_y * bin_count)
+    {
+        return false;
+    }
+    for (uint tile_y = 0; tile_y < tile_count_y; ++tile_y)
+    {
+        for (uint tile_x = 0; tile_x < tile_count_x; ++tile_x)
+        {
+            // Tiles on the right and bottom edges are smaller
+            uint const width  = std::min(kTileSize, kImageWidth - tile_x * kTileSize);
+            uint const height = std::min(kTileSize, kImageHeight - tile_y * kTileSize);
+            uint const *tile  = &histograms[((size_t)tile_y * tile_count_x + tile_x) * bin_count];
+            for (uint i = 0; i < bin_count; ++i)
+            {
+                if (tile[i] != (i == bin ? width * height : 0))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+} // unnamed namespace
+
+HOST_TEST(CPUFlipUniformImages)
+{
+    CPUFlip flip;
+    HOST_CHECK(!flip.initialise(0.0f));
+    HOST_CHECK(flip.initialise());
+
+    // Identical images have no error
+    std::vector<float> const black = MakeUniformImage(0.0f);
+    std::vector<float> const white = MakeUniformImage(1.0f);
+    std::vector<float> const grey  = MakeUniformImage(0.5f);
+    std::vector<float> const dark  = MakeUniformImage(0.25f);
+    std::vector<uint>        histograms;
+    HOST_CHECK(flip.compare(grey.data(), grey.data(), kImageWidth, kImageHeight));
+    HOST_CHECK(flip.getMetricValue() == 0.0f);
+    HOST_CHECK(flip.getErrorMap().size() == (size_t)kImageWidth * kImageHeight);
+    HOST_CHECK(flip.getTileHistograms(kTileSize, 10, histograms) && IsSingleBin(histograms, 10, 0));
+
+    // Black against white is 100 apart in lightness, beyond the breakpoint of the error remapping
+    double const black_white_error = GetGreyError(0.0, 1.0);
+    HOST_CHECK(std::abs(black_white_error - 0.96738) < 1e-4);
+    HOST_CHECK(flip.compare(black.data(), white.data(), kImageWidth, kImageHeight));
+    HOST_CHECK(std::abs(flip.getMetricValue() - black_white_error) < 1e-4);
+    bool uniform = true;
+    for (float const error : flip.getErrorMap())
+    {
+        uniform = uniform && std::abs(error - black_white_error) < 1e-4;
+    }
+    HOST_CHECK(uniform);
+    HOST_CHECK(flip.getTileHistograms(kTileSize, 10, histograms) && IsSingleBin(histograms, 10, 9));
+    HOST_CHECK(flip.getTileHistograms(kTileSize, 32, histograms) && IsSingleBin(histograms, 32, 30));
+
+    // The error is symmetric and smaller differences are remapped linearly below the breakpoint
+    double const grey_error = GetGreyError(0.5, 0.25);
+    HOST_CHECK(std::abs(grey_error - 0.45184) < 1e-4);
+    HOST_CHECK(flip.compare(dark.data(), grey.data(), kImageWidth, kImageHeight));
+    HOST_CHECK(std::abs(flip.getMetricValue() - grey_error) < 1e-4);
+    HOST_CHECK(flip.compare(grey.data(), dark.data(), kImageWidth, kImageHeight));
+    HOST_CHECK(std::abs(flip.getMetricValue() - grey_error) < 1e-4);
+    HOST_CHECK(flip.getTileHistograms(kTileSize, 10, histograms) && IsSingleBin(histograms, 10, 4));
+    HOST_CHECK(!flip.getTileHistograms(0, 10, histograms) && !flip.getTileHistograms(kTileSize, 0, histograms));
+
+    // The exposure scales both images before they are clamped, 2 stops down maps white to the grey of 0.25
+    HOST_CHECK(flip.initialise(CPUFlip::kDefaultPixelsPerDegree, -2.0f));
+    HOST_CHECK(flip.compare(black.data(), white.data(), kImageWidth, kImageHeight));
+    HOST_CHECK(std::abs(flip.getMetricValue() - GetGreyError(0.0, 0.25)) < 1e-4);
+
+    // HDR-FLIP of identical images has no error whatever their range
+    std::vector<float> const bright = MakeUniformImage(64.0f);
+    HOST_CHECK(flip.compareHDR(bright.data(), bright.data(), kImageWidth, kImageHeight));
+    HOST_CHECK(flip.getMetricValue() == 0.0f);
+}
+
+HOST_TEST(CPUFlipFeatures)
+{
+    // A single white pixel on black is both a colour difference and a point feature, so it is amplified above the
+    // colour error alone while the error stays local to the pixel
+    std::vector<float> const black = MakeUniformImage(0.0f);
+    std::vector<float>       point = black;
+    uint const               x     = kImageWidth / 2;
+    uint const               y     = kImageHeight / 2;
+    for (uint channel = 0; channel < 3; ++channel)
+    {
+        point[((size_t)y * kImageWidth + x) * 4 + channel] = 1.0f;
+    }
+    CPUFlip flip;
+    HOST_CHECK(flip.initialise());
+    HOST_CHECK(flip.compare(point.data(), black.data(), kImageWidth, kImageHeight));
+    std::vector<float> const &errors = flip.getErrorMap();
+    float const               peak   = errors[(size_t)y * kImageWidth + x];
+    HOST_CHECK(peak == *std::max_element(errors.begin(), errors.end()));
+    HOST_CHECK(peak > 0.0f && peak <= 1.0f);
+    HOST_CHECK(errors[0] == 0.0f && errors.back() == 0.0f);
+
+    // The mean error is the mean of the error map and each pixel is counted once by the histograms
+    double sum = 0.0;
+    for (float const error : errors)
+    {
+        sum += error;
+    }
+    HOST_CHECK(std::abs(flip.getMetricValue() - sum / errors.size()) < 1e-6);
+    std::vector<uint> histograms;
+    HOST_CHECK(flip.getTileHistograms(kTileSize, 8, histograms));
+    uint total = 0;
+    for (uint const count : histograms)
+    {
+        total += count;
+    }
+    HOST_CHECK(total == kImageWidth * kImageHeight);
+    uint const tile_count_x = (kImageWidth + kTileSize - 1) / kTileSize;
+    uint const peak_tile    = (y / kTileSize) * tile_count_x + x / kTileSize;
+    HOST_CHECK(histograms[(size_t)peak_tile * 8 + std::min((uint)(peak * 8.0f), 7u)] >= 1);
+}
+} // namespace Capsaicin
@@ -0,0 +1,203 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "cpu_image_metrics.h"
+#include "host_test.h"
+#include "thread_pool.h"
+
+#include <cmath>
+#include <random>
+#include <thread>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint kImageWidth  = 67; /**< Width of the test images (not a multiple of the SSIM window) */
+constexpr uint kImageHeight = 71; /**< Height of the test images (more than a band of SSIM rows) */
+
+/**
+ * Build an RGBA image, only the first channel is read by single channel types.
+ * @param value The function giving the value of each pixel from its coordinates.
+ * @returns The image pixels.
+ */
+template<typename FUNCTION>
+std::vector<float> MakeImage(FUNCTION const &value) noexcept
+{
+    std::vector<float> image((size_t)kImageWidth * kImageHeight * 4, 1.0f);
+    for (uint y = 0; y < kImageHeight; ++y)
+    {
+        for (uint x = 0; x < kImageWidth; ++x)
+        {
+            image[((size_t)y * kImageWidth + x) * 4] = value(x, y);
+        }
+    }
+    return image;
+}
+
+/**
+ * Compute a metric of two images.
+ * @param operation The metric to compute.
+ * @param source    The source image.
+ * @param reference The reference image.
+ * @returns The metric value.
+ */
+float Compare(CPUImageMetrics::Operation operation, std::vector<float> const &source,
+    std::vector<float> const &reference) noexcept
+{
+    CPUImageMetrics metrics;
+    metrics.initialise(CPUImageMetrics::Type::SDR_NONLINEAR, operation);
+    metrics.compare(source.data(), reference.data(), kImageWidth, kImageHeight);
+    return metrics.getMetricValue();
+}
+
+/**
+ * Compute the SSIM of two single channel images directly from its definition, each pixel weighting the 11x11
+ * window around it by a Gaussian (sigma=1.5) and skipping the taps outside the image.
+ * @param source    The source image.
+ * @param reference The reference image.
+ * @returns The mean SSIM.
+ */
+double ReferenceSSIM(std::vector<float> const &source, std::vector<float> const &reference) noexcept
+{
+    double gaussian[11];
+    double gaussian_sum = 0.0;
+    for (int i = 0; i < 11; ++i)
+    {
+        gaussian[i] = std::exp(-(double)((i - 5) * (i - 5)) / (2.0 * 1.5 * 1.5));
+        gaussian_sum += gaussian[i];
+    }
+    double squared_weights = 0.0;
+    for (int i = 0; i < 11; ++i)
+    {
+        for (int j = 0; j < 11; ++j)
+        {
+            squared_weights += std::pow(gaussian[i] * gaussian[j] / (gaussian_sum * gaussian_sum), 2.0);
+        }
+    }
+
+    double sum = 0.0;
+    for (int y = 0; y < (int)kImageHeight; ++y)
+    {
+        for (int x = 0; x < (int)kImageWidth; ++x)
+        {
+            auto const window = [&](auto const &function) {
+                for (int j = 0; j < 11; ++j)
+                {
+                    for (int i = 0; i < 11; ++i)
+                    {
+                        int const column = x + i - 5;
+                        int const row    = y + j - 5;
+                        if (column >= 0 && column < (int)kImageWidth && row >= 0 && row < (int)kImageHeight)
+                        {
+                            size_t const pixel = ((size_t)row * kImageWidth + column) * 4;
+                            function(gaussian[i] * gaussian[j] / (gaussian_sum * gaussian_sum),
+                                (double)source[pixel], (double)reference[pixel]);
+                        }
+                    }
+                }
+            };
+            double mean_source    = 0.0;
+            double mean_reference = 0.0;
+            window([&](double weight, double value_source, double value_reference) {
+                mean_source += weight * value_source;
+                mean_reference += weight * value_reference;
+            });
+            double variance_source    = 0.0;
+            double variance_reference = 0.0;
+            double covariance         = 0.0;
+            window([&](double weight, double value_source, double value_reference) {
+                variance_source += weight * (value_source - mean_source) * (value_source - mean_source);
+                variance_reference += weight * (value_reference - mean_reference) * (value_reference - mean_reference);
+                covariance += weight * (value_source - mean_source) * (value_reference - mean_reference);
+            });
+            variance_source /= 1.0 - squared_weights;
+            variance_reference /= 1.0 - squared_weights;
+            covariance /= 1.0 - squared_weights;
+            double const c1 = 0.01 * 0.01;
+            double const c2 = 0.03 * 0.03;
+            sum += ((2.0 * mean_source * mean_reference + c1) * (2.0 * covariance + c2))
+                 / ((mean_source * mean_source + mean_reference * mean_reference + c1)
+                     * (variance_source + variance_reference + c2));
+        }
+    }
+    return sum / ((double)kImageWidth * kImageHeight);
+}
+} // unnamed namespace
+
+HOST_TEST(CPUImageMetricsPSNR)
+{
+    using Operation = CPUImageMetrics::Operation;
+
+    // A uniform error of 0.1 gives a MSE of 0.01, so a PSNR of 20log10(255) + 20dB
+    std::vector<float> const reference = MakeImage([](uint x, uint y) { return (float)((x + y) % 5) / 8.0f; });
+    std::vector<float> const shifted   = MakeImage([](uint x, uint y) { return (float)((x + y) % 5) / 8.0f + 0.1f; });
+    HOST_CHECK(std::abs(Compare(Operation::MSE, shifted, reference) - 0.01f) < 1e-6f);
+    HOST_CHECK(std::abs(Compare(Operation::RMSE, shifted, reference) - 0.1f) < 1e-6f);
+    HOST_CHECK(std::abs(Compare(Operation::PSNR, shifted, reference) - 68.1308036f) < 1e-3f);
+
+    // Halving the number of wrong pixels halves the MSE, adding 10log10(2) dB
+    std::vector<float> const half = MakeImage([](uint x, uint y) {
+        return (float)((x + y) % 5) / 8.0f + ((x + y * kImageWidth) % 2 == 0 ? 0.1f : 0.0f);
+    });
+    float const wrong_fraction = (float)((kImageWidth * kImageHeight + 1) / 2) / (kImageWidth * kImageHeight);
+    HOST_CHECK(std::abs(Compare(Operation::MSE, half, reference) - 0.01f * wrong_fraction) < 1e-6f);
+    HOST_CHECK(std::abs(Compare(Operation::PSNR, half, reference) - (68.1308036f - 10.0f * std::log10(wrong_fraction)))
+               < 1e-3f);
+
+    // Identical images have no error
+    HOST_CHECK(Compare(Operation::MSE, reference, reference) == 0.0f);
+    HOST_CHECK(std::isinf(Compare(Operation::PSNR, reference, reference)));
+}
+
+HOST_TEST(CPUImageMetricsSSIM)
+{
+    using Operation = CPUImageMetrics::Operation;
+
+    std::mt19937                          random(kImageWidth);
+    std::uniform_real_distribution<float> noise(-0.05f, 0.05f);
+    std::vector<float> const              reference = MakeImage([](uint x, uint y) {
+        return 0.5f + 0.25f * std::sin((float)x * 0.3f) * std::cos((float)y * 0.2f);
+    });
+    std::vector<float> const              noisy     = MakeImage([&](uint x, uint y) {
+        return 0.5f + 0.25f * std::sin((float)x * 0.3f) * std::cos((float)y * 0.2f) + noise(random);
+    });
+    std::vector<float> const              inverted  = MakeImage([](uint x, uint y) {
+        return 0.5f - 0.25f * std::sin((float)x * 0.3f) * std::cos((float)y * 0.2f);
+    });
+
+    // Identical images are perfectly similar, anti-correlated ones have a negative SSIM
+    HOST_CHECK(std::abs(Compare(Operation::SSIM, reference, reference) - 1.0f) < 1e-6f);
+    float const noisy_ssim = Compare(Operation::SSIM, noisy, reference);
+    HOST_CHECK(noisy_ssim > 0.0f && noisy_ssim < 1.0f);
+    HOST_CHECK(Compare(Operation::SSIM, inverted, reference) < 0.0f);
+
+    // The separable filtering matches the per-pixel window of the definition, including at the image edges
+    HOST_CHECK(std::abs(noisy_ssim - ReferenceSSIM(noisy, reference)) < 1e-5);
+    HOST_CHECK(std::abs(Compare(Operation::SSIM, inverted, reference) - ReferenceSSIM(inverted, reference)) < 1e-5);
+
+    // Results don't depend on the number of threads
+    ThreadPool::Create(1);
+    float const single_thread_ssim = Compare(Operation::SSIM, noisy, reference);
+    ThreadPool::Create(std::max(std::thread::hardware_concurrency(), 4u));
+    HOST_CHECK(single_thread_ssim == noisy_ssim);
+}
+} // namespace Capsaicin
@@ -0,0 +1,323 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "cpu_profiler.h"
+#include "host_test.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+namespace Capsaicin
+{
+namespace
+{
+/** A parsed JSON value. */
+struct JsonValue
+{
+    enum class Type
+    {
+        Null,
+        Boolean,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    Type                             type   = Type::Null;
+    double                           number = 0.0;
+    std::string                      string;
+    std::vector<JsonValue>           elements;
+    std::map<std::string, JsonValue> members;
+
+    /**
+     * Gets a member of an object.
+     * @param name The member name.
+     * @returns The member, a null value if missing.
+     */
+    JsonValue const &operator[](std::string const &name) const noexcept
+    {
+        static JsonValue const null_value;
+        auto const             member = members.find(name);
+        return member != members.end() ? member->second : null_value;
+    }
+};
+
+/** Minimal strict JSON parser, enough to check the structure of the exported traces. */
+class JsonParser
+{
+public:
+    explicit JsonParser(std::string const &text) noexcept
+        : text_(text)
+    {}
+
+    /**
+     * Parse the whole text as a single value.
+     * @param [out] value The parsed value.
+     * @returns True if the text is valid JSON, False otherwise.
+     */
+    bool parse(JsonValue &value) noexcept { return parseValue(value) && (skipSpaces(), position_ == text_.size()); }
+
+private:
+    void skipSpaces() noexcept
+    {
+        while (position_ < text_.size() && strchr(" \t\r\n", text_[position_]) != nullptr) ++position_;
+    }
+
+    bool consume(char character) noexcept
+    {
+        skipSpaces();
+        if (position_ < text_.size() && text_[position_] == character)
+        {
+            ++position_;
+            return true;
+        }
+        return false;
+    }
+
+    bool consumeWord(char const *word) noexcept
+    {
+        size_t const length = strlen(word);
+        if (text_.compare(position_, length, word) != 0) return false;
+        position_ += length;
+        return true;
+    }
+
+    bool parseString(std::string &string) noexcept
+    {
+        if (!consume('"')) return false;
+        while (position_ < text_.size() && text_[position_] != '"')
+        {
+            char character = text_[position_++];
+            if ((unsigned char)character < 0x20) return false;
+            if (character == '\\')
+            {
+                if (position_ >= text_.size()) return false;
+                character = text_[position_++];
+                if (character == 'u')
+                {
+                    if (position_ + 4 > text_.size()) return false;
+                    character = (char)strtoul(text_.substr(position_, 4).c_str(), nullptr, 16);
+                    position_ += 4;
+                }
+                else if (character == 'n')
+                {
+                    character = '\n';
+                }
+                else if (character == 't')
+                {
+                    character = '\t';
+                }
+                else if (character != '"' && character != '\\' && character != '/')
+                {
+                    return false;
+                }
+            }
+            string += character;
+        }
+        return consume('"');
+    }
+
+    bool parseValue(JsonValue &value) noexcept
+    {
+        skipSpaces();
+        if (position_ >= text_.size()) return false;
+        char const character = text_[position_];
+        if (character == '{')
+        {
+            value.type = JsonValue::Type::Object;
+            ++position_;
+            if (consume('}')) return true;
+            do
+            {
+                std::string name;
+                if (!parseString(name) || !consume(':') || value.members.count(name) != 0) return false;
+                if (!parseValue(value.members[name])) return false;
+            } while (consume(','));
+            return consume('}');
+        }
+        if (character == '[')
+        {
+            value.type = JsonValue::Type::Array;
+            ++position_;
+            if (consume(']')) return true;
+            do
+            {
+                if (!parseValue(value.elements.emplace_back())) return false;
+            } while (consume(','));
+            return consume(']');
+        }
+        if (character == '"')
+        {
+            value.type = JsonValue::Type::String;
+            return parseString(value.string);
+        }
+        if (consumeWord("true") || consumeWord("false"))
+        {
+            value.type = JsonValue::Type::Boolean;
+            return true;
+        }
+        if (consumeWord("null")) return true;
+        char const *begin = text_.c_str() + position_;
+        char       *end   = nullptr;
+        value.type        = JsonValue::Type::Number;
+        value.number      = strtod(begin, &end);
+        position_ += (size_t)(end - begin);
+        return end != begin && strchr("+-0123456789", *begin) != nullptr;
+    }
+
+    std::string const &text_;
+    size_t             position_ = 0;
+};
+
+/** A complete ("X") trace event. */
+struct TraceSpan
+{
+    std::string name;
+    uint32_t    thread;
+    double      begin;
+    double      end;
+};
+} // unnamed namespace
+
+HOST_TEST(CpuProfilerChromeTrace)
+{
+    // Profile two frames with nested scopes on the render thread, a scope on another thread and GPU sections,
+    // names that need escaping must be exported as valid JSON
+    CpuProfiler::Start();
+    for (uint32_t frame_index = 0; frame_index < 2; ++frame_index)
+    {
+        CpuProfiler::BeginFrame(frame_index);
+        {
+            CAPSAICIN_PROFILE_SCOPE("Render \"frame\"");
+            for (uint32_t i = 0; i < 3; ++i)
+            {
+                CAPSAICIN_PROFILE_SCOPE("Pass\\Child");
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            std::thread([]() {
+                CpuProfiler::SetThreadName("Worker\t1");
+                CAPSAICIN_PROFILE_SCOPE("Load");
+            }).join();
+        }
+        CpuProfiler::AddGpuSection(0, "Frame GPU", 0, 1e-3);
+        CpuProfiler::AddGpuSection(0, "GPU pass", 1, 2e-4);
+    }
+    CpuProfiler::Stop();
+
+    // The render thread scopes are merged by call path
+    std::vector<CpuProfileFrame> const &frames = CpuProfiler::GetFrames();
+    HOST_CHECK(frames.size() == 2);
+    for (CpuProfileFrame const &frame : frames)
+    {
+        HOST_CHECK(frame.tree.size() == 2);
+        if (frame.tree.size() == 2)
+        {
+            HOST_CHECK(CpuProfiler::GetName(frame.tree[0].name) == "Render \"frame\"");
+            HOST_CHECK(frame.tree[0].parent == CpuProfileNode::kNoParent && frame.tree[0].count == 1);
+            HOST_CHECK(CpuProfiler::GetName(frame.tree[1].name) == "Pass\\Child");
+            HOST_CHECK(frame.tree[1].parent == 0 && frame.tree[1].depth == 1 && frame.tree[1].count == 3);
+            HOST_CHECK(frame.tree[1].time <= frame.tree[0].time);
+        }
+    }
+
+    std::filesystem::path const directory = std::filesystem::temp_directory_path() / "capsaicin_host_tests";
+    std::filesystem::create_directories(directory);
+    std::filesystem::path const file_path = directory / "cpu_profile.json";
+    HOST_CHECK(CpuProfiler::Write(file_path.string().c_str()));
+    std::stringstream text;
+    text << std::ifstream(file_path).rdbuf();
+    std::filesystem::remove(file_path);
+
+    JsonValue trace;
+    if (!HOST_CHECK(JsonParser(text.str()).parse(trace))) return;
+    HOST_CHECK(trace["displayTimeUnit"].string == "ms");
+    HOST_CHECK(trace["otherData"]["dropped_scopes"].type == JsonValue::Type::Number);
+    HOST_CHECK(trace["traceEvents"].type == JsonValue::Type::Array);
+
+    // Every event is either thread metadata or a complete event on a named thread
+    std::map<uint32_t, std::string> thread_names;
+    std::vector<TraceSpan>          spans;
+    for (JsonValue const &event : trace["traceEvents"].elements)
+    {
+        HOST_CHECK(event["name"].type == JsonValue::Type::String);
+        HOST_CHECK(event["pid"].type == JsonValue::Type::Number && event["pid"].number == 0.0);
+        HOST_CHECK(event["tid"].type == JsonValue::Type::Number);
+        uint32_t const thread = (uint32_t)event["tid"].number;
+        if (event["ph"].string == "M")
+        {
+            if (event["name"].string == "thread_name")
+            {
+                HOST_CHECK(event["args"]["name"].type == JsonValue::Type::String);
+                thread_names[thread] = event["args"]["name"].string;
+            }
+            continue;
+        }
+        HOST_CHECK(event["ph"].string == "X");
+        HOST_CHECK(event["ts"].type == JsonValue::Type::Number && event["ts"].number >= 0.0);
+        HOST_CHECK(event["dur"].type == JsonValue::Type::Number && event["dur"].number >= 0.0);
+        spans.push_back({event["name"].string, thread, event["ts"].number, event["ts"].number + event["dur"].number});
+    }
+
+    std::map<std::string, std::vector<TraceSpan>> spans_by_name;
+    for (TraceSpan const &span : spans)
+    {
+        HOST_CHECK(thread_names.count(span.thread) == 1);
+        spans_by_name[span.name].push_back(span);
+    }
+    HOST_CHECK(spans_by_name["Frame 0"].size() == 1 && spans_by_name["Frame 1"].size() == 1);
+    HOST_CHECK(spans_by_name["Render \"frame\""].size() == 2);
+    HOST_CHECK(spans_by_name["Pass\\Child"].size() == 6);
+    HOST_CHECK(spans_by_name["Load"].size() == 2);
+    HOST_CHECK(spans_by_name["Frame GPU"].size() == 2 && spans_by_name["GPU pass"].size() == 2);
+
+    // Frames and scopes of the render thread are shown on the same track, children within their parents
+    for (TraceSpan const &frame : spans_by_name["Frame 0"])
+    {
+        HOST_CHECK(thread_names[frame.thread] == "Render");
+    }
+    for (TraceSpan const &child : spans_by_name["Pass\\Child"])
+    {
+        bool nested = false;
+        for (TraceSpan const &parent : spans_by_name["Render \"frame\""])
+        {
+            nested = nested
+                  || (parent.thread == child.thread && parent.begin <= child.begin && child.end <= parent.end);
+        }
+        HOST_CHECK(nested);
+    }
+    for (TraceSpan const &load : spans_by_name["Load"])
+    {
+        HOST_CHECK(thread_names[load.thread] == "Worker\t1");
+    }
+    for (TraceSpan const &section : spans_by_name["GPU pass"])
+    {
+        HOST_CHECK(thread_names[section.thread] == "GPU");
+        HOST_CHECK(section.end - section.begin > 199.0 && section.end - section.begin < 201.0);
+    }
+}
+} // namespace Capsaicin
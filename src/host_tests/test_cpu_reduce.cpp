@@ -0,0 +1,268 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_reduce.h"
+#include "host_test.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace Capsaicin
+{
+namespace
+{
+using Operation = CPUReduce::Operation;
+using Summation = CPUReduce::Summation;
+
+/** Element counts covering partial lanes, a single block, partial blocks and many blocks. */
+constexpr uint kReduceSizes[] = {1, 5, 4096, 4099, 70001};
+
+/**
+ * Build the scalars of a list of elements suited to an operation.
+ * Integers are small (sums and products still wrap around), floating point products stay close to 1 so that they
+ * don't overflow and floating point min/max inputs contain NaNs that must be ignored.
+ * @param count     The number of scalars.
+ * @param operation The reduce operation.
+ * @returns The scalars.
+ */
+template<typename T>
+std::vector<T> MakeValues(uint count, Operation operation) noexcept
+{
+    std::vector<T> values(count);
+    std::mt19937   random(count);
+    for (uint i = 0; i < count; ++i)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            bool const                        product = (operation == Operation::Product);
+            std::uniform_real_distribution<T> distribution(product ? T(0.999) : T(-1000), product ? T(1.001) : T(1000));
+            values[i] = distribution(random);
+            if (operation == Operation::Min || operation == Operation::Max)
+            {
+                values[i] = (i % 97 == 0 ? std::numeric_limits<T>::quiet_NaN() : values[i]);
+            }
+        }
+        else
+        {
+            std::uniform_int_distribution<int32_t> distribution(std::is_signed_v<T> ? -50 : 0, 100);
+            values[i] = (T)distribution(random);
+        }
+    }
+    return values;
+}
+
+/**
+ * Check the reduction of every operation (and every summation for floating point sums) of a type against a serial
+ * reference: integer results must be exact (wrapping around), floating point ones within the error bound of the
+ * summation.
+ * @param type The reduced type, made of COMPONENTS scalars of type T.
+ * @returns True if all the results match.
+ */
+template<typename T, uint COMPONENTS>
+bool ReduceMatchesReference(CPUReduce::Type type) noexcept
+{
+    bool      matches = true;
+    CPUReduce reduce;
+    for (uint count : kReduceSizes)
+    {
+        for (Operation operation : {Operation::Sum, Operation::Min, Operation::Max, Operation::Product})
+        {
+            std::vector<T> const values = MakeValues<T>(count * COMPONENTS, operation);
+            for (Summation summation :
+                {Summation::Blocked, Summation::Pairwise, Summation::Kahan, Summation::Neumaier})
+            {
+                if (operation != Operation::Sum && summation != Summation::Pairwise)
+                {
+                    continue; // only used by sums
+                }
+                T          result[COMPONENTS] = {};
+                bool const reduced = reduce.initialise(type, operation, summation) &&
+                                     reduce.reduce(values.data(), count, result);
+                matches            = matches && reduced;
+                for (uint component = 0; component < COMPONENTS; ++component)
+                {
+                    if constexpr (std::is_floating_point_v<T>)
+                    {
+                        long double expected = (operation == Operation::Product ? 1.0L : 0.0L);
+                        long double absolute = 0.0L;
+                        if (operation == Operation::Min || operation == Operation::Max)
+                        {
+                            expected = std::numeric_limits<long double>::quiet_NaN();
+                        }
+                        for (uint i = 0; i < count; ++i)
+                        {
+                            T const value = values[i * COMPONENTS + component];
+                            absolute += std::abs((long double)value);
+                            if (operation == Operation::Sum)
+                            {
+                                expected += value;
+                            }
+                            else if (operation == Operation::Product)
+                            {
+                                expected *= value;
+                            }
+                            else if (!std::isnan(value))
+                            {
+                                expected = (std::isnan(expected) || (operation == Operation::Min ? value < expected
+                                                                                                 : value > expected)
+                                                ? value
+                                                : expected);
+                            }
+                        }
+                        // Blocked sums and products accumulate an error linear with the count, the other
+                        // summations an error bounded by a few rounding errors per level of their trees
+                        long double const epsilon = std::numeric_limits<T>::epsilon();
+                        long double       bound   = 0.0L;
+                        if (operation == Operation::Sum)
+                        {
+                            bound = (summation == Summation::Blocked ? count : 64) * epsilon * absolute;
+                        }
+                        else if (operation == Operation::Product)
+                        {
+                            bound = count * epsilon * std::abs(expected);
+                        }
+                        matches = matches && (std::isnan(expected) ? std::isnan(result[component])
+                                                                   : std::abs(result[component] - expected) <= bound);
+                    }
+                    else
+                    {
+                        using Unsigned = std::make_unsigned_t<T>;
+                        T expected     = (operation == Operation::Product ? T(1) : T(0));
+                        if (operation == Operation::Min || operation == Operation::Max)
+                        {
+                            expected = values[component];
+                        }
+                        for (uint i = 0; i < count; ++i)
+                        {
+                            T const value = values[i * COMPONENTS + component];
+                            switch (operation)
+                            {
+                            case Operation::Sum: expected = (T)((Unsigned)expected + (Unsigned)value); break;
+                            case Operation::Product: expected = (T)((Unsigned)expected * (Unsigned)value); break;
+                            case Operation::Min: expected = std::min(expected, value); break;
+                            case Operation::Max: expected = std::max(expected, value); break;
+                            }
+                        }
+                        matches = matches && result[component] == expected;
+                    }
+                }
+            }
+        }
+    }
+    return matches;
+}
+} // unnamed namespace
+
+HOST_TEST(CPUReduceTypes)
+{
+    HOST_CHECK((ReduceMatchesReference<float, 1>(CPUReduce::Type::Float)));
+    HOST_CHECK((ReduceMatchesReference<float, 2>(CPUReduce::Type::Float2)));
+    HOST_CHECK((ReduceMatchesReference<float, 3>(CPUReduce::Type::Float3)));
+    HOST_CHECK((ReduceMatchesReference<float, 4>(CPUReduce::Type::Float4)));
+    HOST_CHECK((ReduceMatchesReference<uint32_t, 1>(CPUReduce::Type::UInt)));
+    HOST_CHECK((ReduceMatchesReference<uint32_t, 2>(CPUReduce::Type::UInt2)));
+    HOST_CHECK((ReduceMatchesReference<uint32_t, 3>(CPUReduce::Type::UInt3)));
+    HOST_CHECK((ReduceMatchesReference<uint32_t, 4>(CPUReduce::Type::UInt4)));
+    HOST_CHECK((ReduceMatchesReference<int32_t, 1>(CPUReduce::Type::Int)));
+    HOST_CHECK((ReduceMatchesReference<int32_t, 2>(CPUReduce::Type::Int2)));
+    HOST_CHECK((ReduceMatchesReference<int32_t, 3>(CPUReduce::Type::Int3)));
+    HOST_CHECK((ReduceMatchesReference<int32_t, 4>(CPUReduce::Type::Int4)));
+    HOST_CHECK((ReduceMatchesReference<double, 1>(CPUReduce::Type::Double)));
+    HOST_CHECK((ReduceMatchesReference<double, 2>(CPUReduce::Type::Double2)));
+    HOST_CHECK((ReduceMatchesReference<double, 3>(CPUReduce::Type::Double3)));
+    HOST_CHECK((ReduceMatchesReference<double, 4>(CPUReduce::Type::Double4)));
+}
+
+HOST_TEST(CPUReduceEdgeCases)
+{
+    CPUReduce reduce;
+
+    // Empty lists have no result, indirect counts are clamped to the maximum
+    uint32_t const counts[] = {3, 1, 4, 1, 5};
+    uint32_t       result   = 0;
+    HOST_CHECK(reduce.initialise(CPUReduce::Type::UInt, Operation::Sum));
+    HOST_CHECK(!reduce.reduce(counts, 0, &result));
+    uint32_t const zero = 0;
+    HOST_CHECK(!reduce.reduceIndirect(counts, &zero, 5, &result));
+    uint32_t const too_many = 100;
+    HOST_CHECK(reduce.reduceIndirect(counts, &too_many, 4, &result) && result == 9);
+
+    // Integer sums and products wrap around
+    uint32_t const large[] = {0xFFFFFFFFu, 2u, 0x80000000u};
+    HOST_CHECK(reduce.reduce(large, 3, &result) && result == 0x80000001u);
+    HOST_CHECK(reduce.initialise(CPUReduce::Type::UInt, Operation::Product));
+    HOST_CHECK(reduce.reduce(large, 3, &result) && result == 0u);
+    int32_t const signed_values[] = {std::numeric_limits<int32_t>::max(), 2, -3};
+    int32_t       signed_result   = 0;
+    HOST_CHECK(reduce.initialise(CPUReduce::Type::Int, Operation::Product));
+    HOST_CHECK(reduce.reduce(signed_values, 3, &signed_result) && signed_result == 6);
+    HOST_CHECK(reduce.initialise(CPUReduce::Type::Int, Operation::Min));
+    HOST_CHECK(reduce.reduce(signed_values, 3, &signed_result) && signed_result == -3);
+
+    // Min and max ignore NaNs (the result is NaN only if all values are) and preserve denormals
+    float const nan            = std::numeric_limits<float>::quiet_NaN();
+    float const denormal       = std::numeric_limits<float>::denorm_min();
+    float const float_values[] = {nan, 2.0f * denormal, denormal, nan, 3.0f * denormal};
+    float       float_result   = 0.0f;
+    HOST_CHECK(reduce.initialise(CPUReduce::Type::Float, Operation::Min));
+    HOST_CHECK(reduce.reduce(float_values, 5, &float_result) && float_result == denormal);
+    HOST_CHECK(reduce.initialise(CPUReduce::Type::Float, Operation::Max));
+    HOST_CHECK(reduce.reduce(float_values, 5, &float_result) && float_result == 3.0f * denormal);
+    HOST_CHECK(reduce.reduce(float_values, 1, &float_result) && std::isnan(float_result));
+    HOST_CHECK(reduce.initialise(CPUReduce::Type::Float, Operation::Sum, Summation::Blocked));
+    HOST_CHECK(reduce.reduce(&float_values[1], 2, &float_result) && float_result == 3.0f * denormal);
+}
+
+HOST_TEST(CPUReduceSummation)
+{
+    // Adding many values below half an ulp of a large first value loses them unless the sum is compensated
+    uint32_t const     count = 1 << 20;
+    std::vector<float> values(count + 1, 1.0f / (1 << 24));
+    values[0] = 1.0f;
+    float const exact = 1.0f + (float)count / (1 << 24);
+
+    CPUReduce reduce;
+    float     result = 0.0f;
+    for (Summation summation : {Summation::Kahan, Summation::Neumaier})
+    {
+        HOST_CHECK(reduce.initialise(CPUReduce::Type::Float, Operation::Sum, summation));
+        HOST_CHECK(reduce.reduce(values.data(), count + 1, &result) && result == exact);
+    }
+    HOST_CHECK(reduce.initialise(CPUReduce::Type::Float, Operation::Sum, Summation::Pairwise));
+    HOST_CHECK(reduce.reduce(values.data(), count + 1, &result) && std::abs(result - exact) < 1e-6f);
+
+    // Only Neumaier summation keeps small values added before a larger value cancelling out
+    double const cancelling[]  = {1.0, 1e100, 1.0, -1e100};
+    double       double_result = 0.0;
+    HOST_CHECK(reduce.initialise(CPUReduce::Type::Double, Operation::Sum, Summation::Neumaier));
+    HOST_CHECK(reduce.reduce(cancelling, 4, &double_result) && double_result == 2.0);
+
+    // Compensations are dropped once the sum overflows, leaving an infinity rather than a NaN
+    float const overflowing[] = {3e38f, 3e38f, 1.0f};
+    for (Summation summation : {Summation::Blocked, Summation::Pairwise, Summation::Kahan, Summation::Neumaier})
+    {
+        HOST_CHECK(reduce.initialise(CPUReduce::Type::Float, Operation::Sum, summation));
+        HOST_CHECK(reduce.reduce(overflowing, 3, &result) && std::isinf(result) && result > 0.0f);
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,288 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_sort.h"
+#include "host_test.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <random>
+
+namespace Capsaicin
+{
+namespace
+{
+/** List sizes covering empty lists, the insertion sort, the serial radix sort and the parallel radix sort. */
+constexpr uint kSortSizes[] = {0, 1, 2, 64, 65, 1000, 70000, 300000};
+
+/**
+ * Build a list of keys with many duplicates, so that the stability of the sort is checked.
+ * @param count The number of keys.
+ * @param mask  The bits of the keys that may be set.
+ * @returns The keys.
+ */
+std::vector<uint> MakeKeys(uint count, uint mask) noexcept
+{
+    std::vector<uint>                   keys(count);
+    std::mt19937                        random(count);
+    std::uniform_int_distribution<uint> distribution(0, 511);
+    for (uint &key : keys)
+    {
+        // Spread a few distinct values over all the digits
+        key = (distribution(random) * 0x9E3779B9u) & mask;
+    }
+    return keys;
+}
+
+/**
+ * Build a list of bit patterns of floats of both signs, including signed zeros, denormals and infinities.
+ * @param count The number of keys.
+ * @returns The keys.
+ */
+std::vector<uint> MakeFloatKeys(uint count) noexcept
+{
+    float const special[] = {0.0f, -0.0f, 1e-40f, -1e-40f, 1.17549435e-38f, 0.5f, -1.0f, 65504.0f, 3.4e38f,
+        -3.4e38f, INFINITY, -INFINITY};
+
+    std::vector<uint>                     keys(count);
+    std::mt19937                          random(count);
+    std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+    for (uint i = 0; i < count; ++i)
+    {
+        float const value = (i % 7 == 0 ? special[(i / 7) % std::size(special)] : distribution(random));
+        keys[i]           = std::bit_cast<uint>(value);
+    }
+    return keys;
+}
+
+/**
+ * Sort keys and the indices of their initial positions with the expected GPUSort ordering.
+ * GPUSort orders the keys of every type by their bit pattern, so float keys are ordered by value only when they are
+ * non-negative (negative ones follow, by increasing magnitude from -0).
+ * @param keys       The keys.
+ * @param descending True for a descending sort.
+ * @returns The sorted (key, initial index) pairs.
+ */
+std::vector<std::pair<uint, uint>> ReferenceSort(std::vector<uint> const &keys, bool descending)
+{
+    std::vector<std::pair<uint, uint>> sorted(keys.size());
+    for (uint i = 0; i < (uint)keys.size(); ++i)
+    {
+        sorted[i] = {keys[i], i};
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [&](auto const &a, auto const &b) {
+        return descending ? b.first < a.first : a.first < b.first;
+    });
+    return sorted;
+}
+
+/**
+ * Check that keys and payloads sorted by CPUSort match the reference sort.
+ * @param sorted  The expected (key, initial index) pairs.
+ * @param keys    The sorted keys.
+ * @param payload The sorted payloads (the initial index of each key), or nullptr to only check the keys.
+ * @returns True if the keys and payloads match.
+ */
+bool MatchesReference(std::vector<std::pair<uint, uint>> const &sorted, uint const *keys, uint const *payload)
+{
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+        if (keys[i] != sorted[i].first || (payload != nullptr && payload[i] != sorted[i].second))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // unnamed namespace
+
+HOST_TEST(CPUSortOrdering)
+{
+    // Every type and operation must give the same order as GPUSort, stable on equal keys
+    CPUSort sort;
+    for (CPUSort::Type type : {CPUSort::Type::UInt, CPUSort::Type::Float})
+    {
+        for (CPUSort::Operation operation : {CPUSort::Operation::Ascending, CPUSort::Operation::Descending})
+        {
+            HOST_CHECK(sort.initialise(type, operation));
+            bool const descending = (operation == CPUSort::Operation::Descending);
+            for (uint count : kSortSizes)
+            {
+                std::vector<uint> const keys =
+                    (type == CPUSort::Type::Float ? MakeFloatKeys(count) : MakeKeys(count, 0xFFFFFFFFu));
+                auto const sorted = ReferenceSort(keys, descending);
+
+                std::vector<uint> sorted_keys = keys;
+                sort.sort(sorted_keys.data(), count);
+                HOST_CHECK(MatchesReference(sorted, sorted_keys.data(), nullptr));
+
+                std::vector<uint> payload(count);
+                for (uint i = 0; i < count; ++i)
+                {
+                    payload[i] = i;
+                }
+                sorted_keys = keys;
+                sort.sortPayload(sorted_keys.data(), count, payload.data());
+                HOST_CHECK(MatchesReference(sorted, sorted_keys.data(), payload.data()));
+            }
+        }
+    }
+
+    // Keys sharing some digits skip radix passes, which must not change the result
+    HOST_CHECK(sort.initialise(CPUSort::Type::UInt, CPUSort::Operation::Descending));
+    for (uint mask : {0x0000FF00u, 0xFF0000FFu, 0u})
+    {
+        std::vector<uint> keys   = MakeKeys(100000, mask);
+        auto const        sorted = ReferenceSort(keys, true);
+        std::vector<uint> payload(keys.size());
+        for (uint i = 0; i < (uint)payload.size(); ++i)
+        {
+            payload[i] = i;
+        }
+        sort.sortPayload(keys.data(), (uint)keys.size(), payload.data());
+        HOST_CHECK(MatchesReference(sorted, keys.data(), payload.data()));
+    }
+}
+
+HOST_TEST(CPUSortNegativeFloats)
+{
+    // Float keys are sorted by bit pattern as on the GPU, not by value: the sign bit places negative keys after the
+    // positive ones, ordered from -0 to -infinity
+    std::vector<float> const values    = {-INFINITY, 1.0f, -0.0f, 0.0f, -1.0f, INFINITY, -1e-40f, 2.0f, -2.0f, 1e-40f};
+    std::vector<float> const ascending = {0.0f, 1e-40f, 1.0f, 2.0f, INFINITY, -0.0f, -1e-40f, -1.0f, -2.0f, -INFINITY};
+    std::vector<uint>        keys(values.size());
+    std::vector<uint>        payload(values.size());
+    CPUSort                  sort;
+    for (CPUSort::Operation operation : {CPUSort::Operation::Ascending, CPUSort::Operation::Descending})
+    {
+        HOST_CHECK(sort.initialise(CPUSort::Type::Float, operation));
+        for (uint i = 0; i < (uint)values.size(); ++i)
+        {
+            keys[i]    = std::bit_cast<uint>(values[i]);
+            payload[i] = i;
+        }
+        sort.sortPayload(keys.data(), (uint)keys.size(), payload.data());
+        bool matches = true;
+        for (uint i = 0; i < (uint)keys.size(); ++i)
+        {
+            uint const  expected_index = (operation == CPUSort::Operation::Ascending ? i : (uint)keys.size() - 1 - i);
+            float const expected       = ascending[expected_index];
+            // Compare bit patterns so that 0 and -0 are told apart
+            matches = matches && keys[i] == std::bit_cast<uint>(expected)
+                   && std::bit_cast<uint>(values[payload[i]]) == keys[i];
+        }
+        HOST_CHECK(matches);
+    }
+}
+
+HOST_TEST(CPUSortIndirect)
+{
+    // The key count is clamped to the maximum, the following keys are left untouched
+    CPUSort sort;
+    HOST_CHECK(sort.initialise(CPUSort::Type::UInt, CPUSort::Operation::Ascending));
+    for (uint count : {0u, 50u, 1000u, 100000u})
+    {
+        uint const        max_count = 1000;
+        std::vector<uint> keys      = MakeKeys(max_count + 16, 0xFFFFFFFFu);
+        std::vector<uint> payload(keys.size());
+        for (uint i = 0; i < (uint)payload.size(); ++i)
+        {
+            payload[i] = i;
+        }
+        uint const        sorted_count = std::min(count, max_count);
+        std::vector<uint> expected     = keys;
+        std::sort(expected.begin(), expected.begin() + sorted_count);
+
+        std::vector<uint> sorted_keys = keys;
+        sort.sortIndirect(sorted_keys.data(), &count, max_count);
+        HOST_CHECK(sorted_keys == expected);
+
+        sorted_keys = keys;
+        sort.sortIndirectPayload(sorted_keys.data(), &count, max_count, payload.data());
+        HOST_CHECK(sorted_keys == expected);
+        bool payload_matches = true;
+        for (uint i = 0; i < (uint)keys.size(); ++i)
+        {
+            payload_matches = payload_matches && keys[payload[i]] == sorted_keys[i];
+            payload_matches = payload_matches && (i < sorted_count || payload[i] == i);
+        }
+        HOST_CHECK(payload_matches);
+    }
+}
+
+HOST_TEST(CPUSortSegmented)
+{
+    // Each segment is sorted on its own, small segments concurrently and large ones using all threads
+    CPUSort sort;
+    HOST_CHECK(sort.initialise(CPUSort::Type::Float, CPUSort::Operation::Descending));
+    uint const              max_count     = 80000;
+    std::vector<uint> const counts        = {0, 1, 64, 65, 1000, max_count, 100000, 3};
+    uint const              segment_count = (uint)counts.size();
+    std::vector<uint> const keys          = MakeFloatKeys(segment_count * max_count);
+    std::vector<uint>       initial_payload(keys.size());
+    for (uint i = 0; i < (uint)keys.size(); ++i)
+    {
+        initial_payload[i] = i;
+    }
+
+    for (uint variant = 0; variant < 4; ++variant)
+    {
+        bool const        with_payload = (variant & 1) != 0;
+        std::vector<uint> sorted_keys  = keys;
+        std::vector<uint> payload      = initial_payload;
+        if (variant == 0)
+        {
+            sort.sortSegmented(sorted_keys.data(), counts, max_count);
+        }
+        else if (variant == 1)
+        {
+            sort.sortPayloadSegmented(sorted_keys.data(), counts, max_count, payload.data());
+        }
+        else if (variant == 2)
+        {
+            sort.sortIndirectSegmented(sorted_keys.data(), segment_count, counts.data(), max_count);
+        }
+        else
+        {
+            sort.sortIndirectPayloadSegmented(
+                sorted_keys.data(), segment_count, counts.data(), max_count, payload.data());
+        }
+
+        for (uint segment = 0; segment < segment_count; ++segment)
+        {
+            size_t const      offset = (size_t)segment * max_count;
+            uint const        count  = std::min(counts[segment], max_count);
+            std::vector<uint> segment_keys(keys.begin() + offset, keys.begin() + offset + max_count);
+            segment_keys.resize(count);
+            auto sorted = ReferenceSort(segment_keys, true);
+            for (auto &[key, index] : sorted)
+            {
+                index += (uint)offset;
+            }
+            HOST_CHECK(MatchesReference(sorted, &sorted_keys[offset], with_payload ? &payload[offset] : nullptr));
+            HOST_CHECK(std::equal(keys.begin() + offset + count, keys.begin() + offset + max_count,
+                sorted_keys.begin() + offset + count));
+        }
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,181 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "frame_ring_allocator.h"
+#include "host_test.h"
+
+#include <algorithm>
+#include <random>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint32_t kFrameCount  = 3;     /**< Number of frames in flight */
+constexpr uint64_t kAlignment   = 256;   /**< Alignment of the allocations */
+constexpr uint64_t kGranularity = 65536; /**< Granularity of the block sizes */
+} // unnamed namespace
+
+HOST_TEST(FrameRingAllocatorWrap)
+{
+    FrameRingAllocator allocator;
+    allocator.initialize(kFrameCount, kAlignment, kGranularity);
+
+    // A frame that was never begun has no memory to allocate from
+    FrameAllocation allocation;
+    HOST_CHECK(!allocator.allocate(16, allocation));
+    HOST_CHECK(allocator.beginFrame(kFrameCount) == 0);
+
+    std::mt19937        random(kFrameCount);
+    FrameAllocatorStats expected;
+    for (uint32_t frame = 0; frame < 4 * kFrameCount; ++frame)
+    {
+        uint32_t const frame_index = frame % kFrameCount;
+        uint64_t const capacity    = allocator.beginFrame(frame_index);
+        HOST_CHECK(allocator.getFrameIndex() == frame_index);
+        HOST_CHECK(capacity % kGranularity == 0);
+
+        // The statistics of a frame are reported once the next one begins
+        if (frame > 0)
+        {
+            FrameAllocatorStats const &stats = allocator.getFrameStats();
+            HOST_CHECK(stats.capacity == expected.capacity);
+            HOST_CHECK(stats.allocated_bytes == expected.allocated_bytes);
+            HOST_CHECK(stats.allocation_count == expected.allocation_count);
+            HOST_CHECK(stats.overflow_bytes == expected.overflow_bytes);
+            HOST_CHECK(stats.overflow_count == expected.overflow_count);
+            HOST_CHECK(allocator.getHighWaterMark() >= stats.allocated_bytes + stats.overflow_bytes);
+        }
+
+        // Allocations start at the beginning of the block, are aligned and packed one after the other
+        expected          = {};
+        expected.capacity = capacity;
+        for (uint32_t i = 0; i < 64; ++i)
+        {
+            uint64_t const size         = 1 + random() % 1024;
+            uint64_t const aligned_size = (size + kAlignment - 1) & ~(kAlignment - 1);
+            if (!allocator.allocate(size, allocation))
+            {
+                HOST_CHECK(expected.allocated_bytes + aligned_size > capacity);
+                expected.overflow_bytes += aligned_size;
+                ++expected.overflow_count;
+                continue;
+            }
+            HOST_CHECK(allocation.offset == expected.allocated_bytes);
+            HOST_CHECK(allocation.size == aligned_size);
+            HOST_CHECK(allocation.offset + allocation.size <= capacity);
+            expected.allocated_bytes += allocation.size;
+            ++expected.allocation_count;
+        }
+    }
+}
+
+HOST_TEST(FrameRingAllocatorGrowth)
+{
+    FrameRingAllocator allocator;
+    allocator.initialize(kFrameCount, kAlignment, kGranularity);
+
+    // The first frame has no history so overflows, the blocks then grow to the demand of the busiest frame
+    uint64_t const  demand = 5 * kGranularity + 100;
+    FrameAllocation allocation;
+    uint32_t        overflow_frames = 0;
+    for (uint32_t frame = 0; frame < 4 * kFrameCount; ++frame)
+    {
+        uint64_t const capacity = allocator.beginFrame(frame % kFrameCount);
+        uint32_t       overflow = 0;
+        for (uint64_t allocated = 0; allocated < demand; allocated += kGranularity)
+        {
+            overflow += allocator.allocate(kGranularity, allocation) ? 0 : 1;
+        }
+        overflow_frames += overflow > 0 ? 1 : 0;
+        HOST_CHECK(overflow == 0 || frame == 0);
+        HOST_CHECK(frame == 0 || capacity >= demand);
+    }
+    HOST_CHECK(overflow_frames == 1);
+
+    // Blocks shrink back once the busy frames have left the history
+    uint64_t capacity = 0;
+    for (uint32_t frame = 0; frame < 200; ++frame)
+    {
+        capacity = allocator.beginFrame(frame % kFrameCount);
+        HOST_CHECK(allocator.allocate(kAlignment, allocation));
+    }
+    HOST_CHECK(capacity == kGranularity);
+    HOST_CHECK(allocator.getHighWaterMark() == kAlignment);
+}
+
+HOST_TEST(FrameRingAllocatorFenceReuse)
+{
+    FrameRingAllocator allocator;
+    allocator.initialize(kFrameCount, kAlignment, kGranularity);
+
+    // Each allocation is filled with a distinct value, the data must still be intact when the GPU is done with the
+    // frame, i.e., when its block is recycled frame count frames later
+    struct Allocation
+    {
+        FrameAllocation range;
+        uint32_t        value;
+    };
+    std::vector<uint32_t>   blocks[kFrameCount];
+    std::vector<Allocation> block_allocations[kFrameCount];
+    uint32_t                block_frames[kFrameCount] = {};
+    uint32_t                value                     = 0;
+    std::mt19937            random(1);
+    for (uint32_t frame = 1; frame <= 64; ++frame)
+    {
+        uint32_t const frame_index = frame % kFrameCount;
+        if (block_frames[frame_index] != 0)
+        {
+            HOST_CHECK(frame - block_frames[frame_index] == kFrameCount);
+            for (Allocation const &allocation : block_allocations[frame_index])
+            {
+                uint64_t const first = allocation.range.offset / 4;
+                uint64_t const last  = (allocation.range.offset + allocation.range.size) / 4;
+                if (!HOST_CHECK(std::all_of(blocks[frame_index].data() + first, blocks[frame_index].data() + last,
+                        [&](uint32_t word) { return word == allocation.value; })))
+                {
+                    return;
+                }
+            }
+        }
+
+        // Blocks are only resized when a frame begins, which discards the contents the GPU is done with
+        uint64_t const capacity = allocator.beginFrame(frame_index);
+        if (blocks[frame_index].size() != capacity / 4)
+        {
+            blocks[frame_index].assign(capacity / 4, 0);
+        }
+        block_frames[frame_index] = frame;
+        block_allocations[frame_index].clear();
+
+        uint32_t const allocation_count = 1 + random() % 32;
+        for (uint32_t i = 0; i < allocation_count; ++i)
+        {
+            FrameAllocation range;
+            if (allocator.allocate(4 * (1 + random() % 4096), range))
+            {
+                std::fill_n(blocks[frame_index].data() + range.offset / 4, range.size / 4, ++value);
+                block_allocations[frame_index].push_back({range, value});
+            }
+        }
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,117 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "frame_sequence.h"
+#include "host_test.h"
+
+#include <filesystem>
+#include <vector>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint32_t kFrameWidth    = 7; /**< Width of the frames (odd to catch row padding) */
+constexpr uint32_t kFrameHeight   = 5; /**< Height of the frames */
+constexpr uint32_t kFrameCapacity = 8; /**< Number of frames preallocated in the container */
+constexpr uint32_t kFrameCount    = 5; /**< Number of frames written */
+
+/**
+ * Get the pixels of a test frame, values are multiples of 1/4 below 256 so that halfs store them exactly.
+ * @param frame The index of the frame.
+ * @returns The frame pixels as 4 floats per pixel.
+ */
+std::vector<float> GetFramePixels(uint32_t frame) noexcept
+{
+    std::vector<float> pixels((size_t)kFrameWidth * kFrameHeight * 4);
+    for (uint32_t i = 0; i < (uint32_t)pixels.size(); ++i)
+    {
+        pixels[i] = (float)((i * 7 + frame * 31) % 1024) * 0.25f - 64.0f;
+    }
+    return pixels;
+}
+} // unnamed namespace
+
+HOST_TEST(FrameSequenceRoundTrip)
+{
+    std::filesystem::path const directory = std::filesystem::temp_directory_path() / "capsaicin_host_tests";
+    std::filesystem::create_directories(directory);
+    std::string const file_path = (directory / "sequence.cseq").string();
+    for (FrameEncoding const encoding : {FrameEncoding::Float, FrameEncoding::Half})
+    {
+        uint64_t preallocated_size = 0;
+        {
+            FrameSequenceWriter writer;
+            HOST_CHECK(writer.open(file_path.c_str(), kFrameWidth, kFrameHeight, encoding, kFrameCapacity));
+            HOST_CHECK(writer.isOpen());
+            preallocated_size = std::filesystem::file_size(file_path);
+            for (uint32_t frame = 0; frame < kFrameCount; ++frame)
+            {
+                HOST_CHECK(writer.append(10 + 2 * frame, GetFramePixels(frame).data()));
+            }
+            HOST_CHECK(writer.getFrameCount() == kFrameCount);
+            writer.close();
+            HOST_CHECK(!writer.isOpen());
+        }
+
+        // The container is shrunk to the written frames
+        uint64_t const frame_size = (uint64_t)kFrameWidth * kFrameHeight * 4
+                                  * (encoding == FrameEncoding::Half ? sizeof(uint16_t) : sizeof(float));
+        uint64_t const size       = std::filesystem::file_size(file_path);
+        HOST_CHECK(size == preallocated_size - (kFrameCapacity - kFrameCount) * frame_size);
+
+        FrameSequenceReader reader;
+        if (!HOST_CHECK(reader.open(file_path.c_str())))
+        {
+            continue;
+        }
+        HOST_CHECK(reader.getWidth() == kFrameWidth && reader.getHeight() == kFrameHeight);
+        HOST_CHECK(reader.getEncoding() == encoding);
+        HOST_CHECK(reader.getFrameCount() == kFrameCount);
+        std::vector<float> pixels((size_t)kFrameWidth * kFrameHeight * 4);
+        for (uint32_t frame = 0; frame < kFrameCount; ++frame)
+        {
+            HOST_CHECK(reader.getFrameIndex(frame) == 10 + 2 * frame);
+            HOST_CHECK(reader.findFrame(10 + 2 * frame) == frame);
+            reader.readFrame(frame, pixels.data());
+            HOST_CHECK(pixels == GetFramePixels(frame));
+        }
+        HOST_CHECK(reader.findFrame(11) == UINT32_MAX);
+        reader.close();
+
+        // A truncated container is refused rather than read out of bounds
+        std::filesystem::resize_file(file_path, size - frame_size / 2);
+        HOST_CHECK(!reader.open(file_path.c_str()));
+    }
+
+    // Containers are bounded by their capacity
+    {
+        FrameSequenceWriter writer;
+        HOST_CHECK(writer.open(file_path.c_str(), kFrameWidth, kFrameHeight, FrameEncoding::Float, 1));
+        HOST_CHECK(writer.append(0, GetFramePixels(0).data()));
+        HOST_CHECK(!writer.append(1, GetFramePixels(1).data()));
+        HOST_CHECK(writer.getFrameCount() == 1);
+    }
+    FrameSequenceReader reader;
+    HOST_CHECK(!reader.open((directory / "missing.cseq").string().c_str()));
+    std::filesystem::remove_all(directory);
+}
+} // namespace Capsaicin
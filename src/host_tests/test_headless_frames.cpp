@@ -0,0 +1,355 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "capsaicin_internal.h"
+#include "host_test.h"
+#include "renderer.h"
+
+#include <chrono>
+#include <glm/gtc/matrix_transform.hpp>
+#include <thread>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint32_t    kWidth      = 256;                 /**< Width of the back buffer */
+constexpr uint32_t    kHeight     = 128;                 /**< Height of the back buffer */
+constexpr uint32_t    kFrameCount = 16;                  /**< Number of frames rendered by the test */
+constexpr uint32_t    kImageSize  = 64;                  /**< Width and height of the streamed albedo map */
+constexpr char const *kSceneFile  = "headless.gltf";     /**< Asset file built by the scene importer */
+constexpr char const *kRenderer   = "Headless Renderer"; /**< Name of the registered test renderer */
+
+/** Constants uploaded by the test technique each frame. */
+struct HeadlessConstants
+{
+    uint32_t  buffer_dimensions[2];
+    uint32_t  frame_index;
+    uint32_t  instance_count;
+    glm::mat4 view_projection;
+};
+
+/**
+ * Render technique shading the Color AOV with a single compute dispatch, it goes through the same services of the
+ * framework as the shipped techniques (shader path, per-frame constants, scene buffers and AOVs).
+ */
+class HeadlessTechnique : public RenderTechnique
+{
+public:
+    HeadlessTechnique() noexcept
+        : RenderTechnique("Headless")
+    {}
+
+    ~HeadlessTechnique() noexcept override { terminate(); }
+
+    AOVList getAOVs() const noexcept override
+    {
+        AOVList aovs;
+        aovs.push_back({"Color", AOV::Write});
+        return aovs;
+    }
+
+    bool init(CapsaicinInternal const &capsaicin) noexcept override
+    {
+        program_ = gfxCreateProgram(gfx_, "render_techniques/headless/headless", capsaicin.getShaderPath());
+        kernel_  = gfxCreateComputeKernel(gfx_, program_, "Shade");
+        return !!kernel_;
+    }
+
+    void render(CapsaicinInternal &capsaicin) noexcept override
+    {
+        GfxBuffer const    constant_buffer = capsaicin.allocateConstantBuffer<HeadlessConstants>(1);
+        HeadlessConstants &constants       = *gfxBufferGetData<HeadlessConstants>(gfx_, constant_buffer);
+        constants.buffer_dimensions[0]     = capsaicin.getWidth();
+        constants.buffer_dimensions[1]     = capsaicin.getHeight();
+        constants.frame_index              = capsaicin.getFrameIndex();
+        constants.instance_count           = gfxSceneGetObjectCount<GfxInstance>(capsaicin.getScene());
+        constants.view_projection          = capsaicin.getCameraMatrices().view_projection;
+
+        gfxProgramSetParameter(gfx_, program_, "g_Constants", constant_buffer);
+        gfxProgramSetParameter(gfx_, program_, "g_TransformBuffer", capsaicin.getTransformBuffer());
+        gfxProgramSetParameter(gfx_, program_, "g_ColorBuffer", capsaicin.getAOVBuffer("Color"));
+
+        uint32_t const *num_threads  = gfxKernelGetNumThreads(gfx_, kernel_);
+        uint32_t const  num_groups_x = (capsaicin.getWidth() + num_threads[0] - 1) / num_threads[0];
+        uint32_t const  num_groups_y = (capsaicin.getHeight() + num_threads[1] - 1) / num_threads[1];
+        gfxCommandBindKernel(gfx_, kernel_);
+        gfxCommandDispatch(gfx_, num_groups_x, num_groups_y, 1);
+        gfxDestroyBuffer(gfx_, constant_buffer);
+    }
+
+    void terminate() noexcept override
+    {
+        gfxDestroyKernel(gfx_, kernel_);
+        kernel_ = {};
+        gfxDestroyProgram(gfx_, program_);
+        program_ = {};
+    }
+
+private:
+    GfxProgram program_;
+    GfxKernel  kernel_;
+};
+
+/** Renderer made of the test technique, registered with the renderer factory like the shipped renderers. */
+class HeadlessRenderer
+    : public Renderer
+    , public RendererFactory::Registrar<HeadlessRenderer>
+{
+public:
+    static constexpr std::string_view Name = kRenderer;
+
+    HeadlessRenderer() noexcept {}
+
+    std::vector<std::unique_ptr<RenderTechnique>> setupRenderTechniques(
+        [[maybe_unused]] RenderOptionList const &renderOptions) noexcept override
+    {
+        std::vector<std::unique_ptr<RenderTechnique>> render_techniques;
+        render_techniques.emplace_back(std::make_unique<HeadlessTechnique>());
+        return render_techniques;
+    }
+};
+
+/**
+ * Scene importer of the null backend, builds two textured quads and a camera. The second quad is animated so that
+ * the transforms and acceleration structure are updated each frame.
+ * @param scene      The scene to import into.
+ * @param asset_file The asset file to import.
+ * @returns The import result.
+ */
+GfxResult ImportHeadlessScene(GfxScene scene, char const *asset_file)
+{
+    if (std::string_view(asset_file) != kSceneFile)
+    {
+        return kGfxResult_InvalidParameter;
+    }
+
+    GfxRef<GfxCamera> camera = gfxSceneCreateCamera(scene);
+    camera->eye              = glm::vec3(0.0f, 0.0f, 4.0f);
+    camera->center           = glm::vec3(0.0f);
+    GfxMetadata camera_metadata;
+    camera_metadata.is_valid    = true;
+    camera_metadata.asset_file  = asset_file;
+    camera_metadata.object_name = "Main";
+    gfxSceneSetCameraMetadata(scene, camera, camera_metadata);
+
+    GfxRef<GfxMaterial> material = gfxSceneCreateMaterial(scene);
+    material->albedo             = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f);
+
+    GfxRef<GfxImage> image   = gfxSceneCreateImage(scene);
+    image->width             = kImageSize;
+    image->height            = kImageSize;
+    image->format            = DXGI_FORMAT_R8G8B8A8_UNORM;
+    image->channel_count     = 4;
+    image->bytes_per_channel = 1;
+    image->data.resize((size_t)kImageSize * kImageSize * 4, 128);
+    material->albedo_map = image;
+
+    GfxRef<GfxMesh> mesh   = gfxSceneCreateMesh(scene);
+    mesh->default_material = material;
+    mesh->bounds_min       = glm::vec3(-1.0f, -1.0f, 0.0f);
+    mesh->bounds_max       = glm::vec3(1.0f, 1.0f, 0.0f);
+    glm::vec2 const uvs[]  = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+    for (glm::vec2 const &uv : uvs)
+    {
+        GfxVertex vertex;
+        vertex.position = glm::vec3(2.0f * uv - 1.0f, 0.0f);
+        vertex.normal   = glm::vec3(0.0f, 0.0f, 1.0f);
+        vertex.uv       = uv;
+        mesh->vertices.push_back(vertex);
+    }
+    mesh->indices = {0, 1, 2, 0, 2, 3};
+
+    GfxRef<GfxInstance> instances[2];
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        instances[i]            = gfxSceneCreateInstance(scene);
+        instances[i]->mesh      = mesh;
+        instances[i]->material  = material;
+        instances[i]->transform = glm::translate(glm::mat4(1.0f), glm::vec3(2.0f * i - 1.0f, 0.0f, 0.0f));
+    }
+
+    GfxRef<GfxAnimation>   animation = gfxSceneCreateAnimation(scene);
+    GfxAnimation::Channel &channel   = animation->channels.emplace_back();
+    channel.instance                 = instances[1];
+    channel.times                    = {0.0f, 1.0f};
+    channel.transforms               = {
+        instances[1]->transform, glm::translate(instances[1]->transform, glm::vec3(0.0f, 1.0f, 0.0f))};
+    return kGfxResult_NoError;
+}
+
+/**
+ * Gets the totals of a scope of a recorded frame.
+ * @param frame The recorded frame.
+ * @param name  The scope name.
+ * @returns The scope (an empty scope if not found).
+ */
+GfxRecordedScope GetScope(GfxRecordedFrame const &frame, char const *name) noexcept
+{
+    for (GfxRecordedScope const &scope : frame.scopes)
+    {
+        if (scope.name == name)
+        {
+            return scope;
+        }
+    }
+    return {};
+}
+
+/**
+ * Gets the number of calls of a given type made in a scope.
+ * @param scope The scope totals.
+ * @param type  The type of call.
+ * @returns The call count.
+ */
+uint32_t GetCount(GfxRecordedScope const &scope, GfxCallType type) noexcept
+{
+    return scope.counts[(size_t)type];
+}
+
+/**
+ * Gets the bytes created or written by the calls of a given type made in a scope.
+ * @param scope The scope totals.
+ * @param type  The type of call.
+ * @returns The byte count.
+ */
+uint64_t GetBytes(GfxRecordedScope const &scope, GfxCallType type) noexcept
+{
+    return scope.bytes[(size_t)type];
+}
+} // unnamed namespace
+
+HOST_TEST(HeadlessFrameLoop)
+{
+    GfxContext gfx = gfxCreateContext(kWidth, kHeight);
+    gfxNullSetSceneImporter(ImportHeadlessScene);
+    uint64_t dispatch_count = 0;
+    uint64_t draw_count     = 0;
+    uint64_t texture_bytes  = 0;
+    {
+        CapsaicinInternal capsaicin;
+        GfxRecorder::Start();
+        capsaicin.initialize(gfx, nullptr);
+        capsaicin.setSceneCacheEnabled(false);
+        capsaicin.setTextureUploadBudget(1);
+        capsaicin.setFixedFrameRate(true);
+        capsaicin.setFixedFrameTime(1.0 / 30.0);
+        capsaicin.setPaused(false);
+        bool const loaded = HOST_CHECK(capsaicin.getShaderPath() != nullptr && *capsaicin.getShaderPath() != '\0')
+                         && HOST_CHECK(capsaicin.setRenderer(kRenderer))
+                         && HOST_CHECK(capsaicin.setScenes({kSceneFile}));
+        if (!loaded)
+        {
+            GfxRecorder::Stop();
+            capsaicin.terminate();
+            gfxNullSetSceneImporter(nullptr);
+            gfxDestroyContext(gfx);
+            return;
+        }
+        HOST_CHECK(capsaicin.getCurrentRenderer() == kRenderer);
+        HOST_CHECK(capsaicin.getSceneCurrentCamera() == "Main");
+        HOST_CHECK(capsaicin.getTriangleCount() == 4);
+        HOST_CHECK(capsaicin.hasAnimation());
+
+        // Render a fixed number of frames then keep going until the albedo map got streamed in
+        uint32_t frame_count = 0;
+        for (; frame_count < kFrameCount; ++frame_count)
+        {
+            capsaicin.render();
+            gfxFrame(gfx);
+        }
+        auto const timeout = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (capsaicin.getPendingTextureCount() > 0 && std::chrono::steady_clock::now() < timeout)
+        {
+            capsaicin.render();
+            gfxFrame(gfx);
+            ++frame_count;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        GfxRecorder::Stop();
+        HOST_CHECK(capsaicin.getPendingTextureCount() == 0);
+        HOST_CHECK(capsaicin.getFrameIndex() == frame_count);
+
+        // The setup calls come first, outside of any frame
+        std::vector<GfxRecordedFrame> const &frames = GfxRecorder::GetFrames();
+        HOST_CHECK(frames.size() == frame_count + 1);
+        HOST_CHECK(frames.front().frame_index == GfxRecordedFrame::kNoFrame);
+        for (GfxRecordedFrame const &frame : frames)
+        {
+            dispatch_count += GetCount(frame.scopes.front(), GfxCallType::Dispatch);
+            draw_count += GetCount(frame.scopes.front(), GfxCallType::Draw);
+        }
+
+        // The first frame builds the scene, the following ones only refit it as the instance moves
+        HOST_CHECK(GetCount(frames[1].scopes.front(), GfxCallType::BuildRaytracingPrimitive) > 0);
+        for (size_t i = 1; i < frames.size(); ++i)
+        {
+            GfxRecordedFrame const &frame     = frames[i];
+            GfxRecordedScope const &totals    = frame.scopes.front();
+            GfxRecordedScope const  technique = GetScope(frame, "Headless");
+            HOST_CHECK(frame.frame_index == i - 1);
+            HOST_CHECK(GetCount(technique, GfxCallType::Dispatch) == 1);
+            HOST_CHECK(GetBytes(technique, GfxCallType::Upload) == sizeof(HeadlessConstants));
+            HOST_CHECK(GetCount(totals, GfxCallType::Draw) == 1); // the Color AOV is blit to the back buffer
+            if (i > 1 && i <= kFrameCount)
+            {
+                HOST_CHECK(GetCount(totals, GfxCallType::BuildRaytracingPrimitive) == 0);
+                HOST_CHECK(GetCount(totals, GfxCallType::UpdateAccelerationStructure) == 1);
+            }
+            for (GfxRecordedCall const &call : frame.calls)
+            {
+                if (call.type == GfxCallType::Dispatch && frame.scopes[call.scope].name == "Headless")
+                {
+                    HOST_CHECK(call.size[0] == kWidth / kGfxConstant_NumThreads
+                               && call.size[1] == kHeight / kGfxConstant_NumThreads && call.size[2] == 1);
+                }
+            }
+
+            // Once the scene got built and each upload pool got sized no more buffer is created
+            if (i > kGfxConstant_BackBufferCount + 1)
+            {
+                HOST_CHECK(GetCount(totals, GfxCallType::CreateBuffer) == 0);
+            }
+            texture_bytes += GetBytes(totals, GfxCallType::CopyTexture);
+        }
+        HOST_CHECK(texture_bytes >= (uint64_t)kImageSize * kImageSize * 4); // the albedo map and its mips
+
+        // The recorded stream matches the work the backend received
+        GfxNullStatistics const statistics = gfxNullGetStatistics(gfx);
+        HOST_CHECK(statistics.frame_count == frame_count);
+        HOST_CHECK(statistics.dispatch_count == dispatch_count);
+        HOST_CHECK(statistics.draw_count == draw_count);
+
+        capsaicin.terminate();
+    }
+    gfxNullSetSceneImporter(nullptr);
+
+    // Everything the framework created got released
+    GfxNullStatistics const statistics = gfxNullGetStatistics(gfx);
+    HOST_CHECK(statistics.buffer_count == 0);
+    HOST_CHECK(statistics.buffer_bytes == 0);
+    HOST_CHECK(statistics.texture_count == 0);
+    HOST_CHECK(statistics.kernel_count == 0);
+    HOST_CHECK(statistics.raytracing_primitive_count == 0);
+    gfxDestroyContext(gfx);
+}
+} // namespace Capsaicin
@@ -0,0 +1,117 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "host_test.h"
+#include "image_writer.h"
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint32_t kImageWidth  = 32; /**< Width of the written images */
+constexpr uint32_t kImageHeight = 16; /**< Height of the written images */
+constexpr uint32_t kQueueSize   = 16; /**< Number of images the writer accepts before refusing further ones */
+
+/**
+ * Create a read back buffer holding an image.
+ * @param gfx   Active gfx context.
+ * @param value The value of the image pixels.
+ * @returns The buffer.
+ */
+GfxBuffer CreateImageBuffer(GfxContext gfx, float value) noexcept
+{
+    std::vector<float> const pixels((size_t)kImageWidth * kImageHeight * 4, value);
+    return gfxCreateBuffer<float>(gfx, (uint32_t)pixels.size(), pixels.data(), kGfxCpuAccess_Read);
+}
+
+/**
+ * Check that a file starts with the expected signature.
+ * @param file_path Full pathname to the file.
+ * @param signature The expected first bytes.
+ * @returns True if the file exists and starts with the signature.
+ */
+bool HasSignature(std::filesystem::path const &file_path, std::vector<uint8_t> const &signature) noexcept
+{
+    std::ifstream        file(file_path, std::ios::binary);
+    std::vector<uint8_t> header(signature.size());
+    file.read((char *)header.data(), (std::streamsize)header.size());
+    return file.good() && header == signature;
+}
+} // unnamed namespace
+
+HOST_TEST(ImageWriterQueue)
+{
+    std::filesystem::path const directory = std::filesystem::temp_directory_path() / "capsaicin_host_tests";
+    std::filesystem::create_directories(directory);
+    GfxContext     gfx          = gfxCreateContext(kImageWidth, kImageHeight);
+    uint32_t const buffer_count = gfxNullGetStatistics(gfx).buffer_count;
+    {
+        ImageWriter writer;
+        GfxBuffer   buffer = CreateImageBuffer(gfx, 0.0f);
+        HOST_CHECK(!writer.write(buffer, kImageWidth, kImageHeight, (directory / "refused.exr").string()));
+        HOST_CHECK(writer.initialize(gfx));
+
+        // Written images hold their slot in the queue until their buffer is released by update()
+        std::vector<std::filesystem::path> file_paths;
+        for (uint32_t i = 0; i < kQueueSize; ++i)
+        {
+            file_paths.push_back(directory / ("image" + std::to_string(i) + (i % 4 == 0 ? ".jpg" : ".exr")));
+            writer.setExrFormat(i % 2 == 0 ? ImageCompression::ZIP : ImageCompression::None, i % 3 == 0);
+            HOST_CHECK(writer.write(
+                CreateImageBuffer(gfx, (float)i / kQueueSize), kImageWidth, kImageHeight, file_paths.back().string()));
+        }
+        HOST_CHECK(!writer.write(buffer, kImageWidth, kImageHeight, (directory / "refused.exr").string()));
+        HOST_CHECK(writer.getStats().image_count == 0);
+
+        // Once written and released, the buffers are destroyed and the queue accepts images again
+        writer.flush();
+        writer.update();
+        ImageWriterStats const &stats = writer.getStats();
+        HOST_CHECK(stats.image_count == kQueueSize);
+        HOST_CHECK(stats.queue_depth == 0);
+        HOST_CHECK(stats.peak_queue_depth == kQueueSize);
+        HOST_CHECK(gfxNullGetStatistics(gfx).buffer_count == buffer_count + 1);
+        uint64_t bytes_written = 0;
+        for (uint32_t i = 0; i < kQueueSize; ++i)
+        {
+            bytes_written += std::filesystem::exists(file_paths[i]) ? std::filesystem::file_size(file_paths[i]) : 0;
+            HOST_CHECK(i % 4 == 0 ? HasSignature(file_paths[i], {0xFF, 0xD8})
+                                  : HasSignature(file_paths[i], {0x76, 0x2F, 0x31, 0x01}));
+        }
+        HOST_CHECK(stats.bytes_written == bytes_written);
+
+        // Terminating writes the images still queued and releases their buffers
+        file_paths.push_back(directory / "last.exr");
+        HOST_CHECK(writer.write(buffer, kImageWidth, kImageHeight, file_paths.back().string()));
+        writer.terminate();
+        HOST_CHECK(!writer.isInitialized());
+        HOST_CHECK(writer.getStats().image_count == kQueueSize + 1);
+        HOST_CHECK(std::filesystem::exists(file_paths.back()));
+        HOST_CHECK(gfxNullGetStatistics(gfx).buffer_count == buffer_count);
+    }
+    gfxDestroyContext(gfx);
+    std::filesystem::remove_all(directory);
+}
+} // namespace Capsaicin
@@ -0,0 +1,179 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "host_test.h"
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <random>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint32_t kGridSize = 24; /**< Number of quads along each side of the test grid */
+
+/** Vertex of the test meshes. */
+struct Vertex
+{
+    float position[3];
+    float uv[2];
+};
+
+/**
+ * Build a grid as a triangle soup (each triangle has its own vertices) with the triangles in random order.
+ * Unreferenced vertices are appended at the end.
+ * @param [out] vertices The vertices.
+ * @param [out] indices  The triangle list indices.
+ */
+void MakeTriangleSoup(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices) noexcept
+{
+    auto const grid_vertex = [](uint32_t x, uint32_t y) {
+        float const u = (float)x / (float)kGridSize;
+        float const v = (float)y / (float)kGridSize;
+        return Vertex {{u, 0.0f, v}, {u, 1.0f - v}};
+    };
+    std::vector<uint32_t> quads(kGridSize * kGridSize);
+    for (uint32_t i = 0; i < (uint32_t)quads.size(); ++i)
+    {
+        quads[i] = i;
+    }
+    std::shuffle(quads.begin(), quads.end(), std::mt19937(kGridSize));
+    for (uint32_t const quad : quads)
+    {
+        uint32_t const x = quad % kGridSize;
+        uint32_t const y = quad / kGridSize;
+        for (Vertex const &vertex : {grid_vertex(x, y), grid_vertex(x + 1, y), grid_vertex(x + 1, y + 1),
+                 grid_vertex(x, y), grid_vertex(x + 1, y + 1), grid_vertex(x, y + 1)})
+        {
+            indices.push_back((uint32_t)vertices.size());
+            vertices.push_back(vertex);
+        }
+    }
+    vertices.push_back(Vertex {{-1.0f, -1.0f, -1.0f}, {0.0f, 0.0f}});
+    vertices.push_back(Vertex {{2.0f, 2.0f, 2.0f}, {1.0f, 1.0f}});
+}
+
+/**
+ * Check whether two vertices are bit-wise identical.
+ * @param left  The first vertex.
+ * @param right The second vertex.
+ * @returns True if identical, False otherwise.
+ */
+bool IsSameVertex(Vertex const &left, Vertex const &right) noexcept
+{
+    return memcmp(&left, &right, sizeof(Vertex)) == 0;
+}
+} // unnamed namespace
+
+HOST_TEST(MeshOptimizerRoundTrip)
+{
+    std::vector<Vertex>   vertices;
+    std::vector<uint32_t> indices;
+    MakeTriangleSoup(vertices, indices);
+
+    OptimizedMesh mesh;
+    OptimizeMesh(mesh, vertices.data(), (uint32_t)vertices.size(), sizeof(Vertex), indices.data(),
+        (uint32_t)indices.size(), sizeof(Vertex));
+
+    // Duplicates are welded and unreferenced vertices dropped
+    uint32_t const unique_count = (kGridSize + 1) * (kGridSize + 1);
+    HOST_CHECK(mesh.vertices.size() == unique_count);
+    HOST_CHECK(mesh.indices.size() == indices.size());
+    HOST_CHECK(mesh.before.vertex_count == vertices.size());
+    HOST_CHECK(mesh.after.vertex_count == unique_count);
+    bool vertices_unique = true;
+    for (size_t i = 0; i < mesh.vertices.size(); ++i)
+    {
+        HOST_CHECK(mesh.vertices[i] < vertices.size());
+        for (size_t j = 0; j < i && vertices_unique; ++j)
+        {
+            vertices_unique = !IsSameVertex(vertices[mesh.vertices[i]], vertices[mesh.vertices[j]]);
+        }
+    }
+    HOST_CHECK(vertices_unique);
+
+    // Vertices are stored in order of first reference
+    uint32_t next_vertex = 0;
+    for (uint32_t const index : mesh.indices)
+    {
+        HOST_CHECK(index <= next_vertex);
+        next_vertex = std::max(next_vertex, index + 1);
+    }
+    HOST_CHECK(next_vertex == unique_count);
+
+    // Decoding the mesh gives back the source triangles (with the same winding) in another order
+    auto const triangle_less = [](Vertex const *left, Vertex const *right) {
+        return memcmp(left, right, 3 * sizeof(Vertex)) < 0;
+    };
+    std::vector<Vertex> source_triangles = vertices;
+    source_triangles.resize(indices.size());
+    std::vector<Vertex> output_triangles(indices.size());
+    for (size_t i = 0; i < mesh.indices.size(); ++i)
+    {
+        output_triangles[i] = vertices[mesh.vertices[mesh.indices[i]]];
+    }
+    std::vector<Vertex const *> source_order;
+    std::vector<Vertex const *> output_order;
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        source_order.push_back(&source_triangles[i]);
+        output_order.push_back(&output_triangles[i]);
+    }
+    std::sort(source_order.begin(), source_order.end(), triangle_less);
+    std::sort(output_order.begin(), output_order.end(), triangle_less);
+    bool triangles_match = true;
+    for (size_t i = 0; i < source_order.size(); ++i)
+    {
+        triangles_match = triangles_match && memcmp(source_order[i], output_order[i], 3 * sizeof(Vertex)) == 0;
+    }
+    HOST_CHECK(triangles_match);
+
+    // The grid shares each vertex between up to 6 triangles, the reordered mesh must make use of that
+    HOST_CHECK(mesh.before.acmr == 3.0f);
+    HOST_CHECK(mesh.after.acmr < 1.0f);
+    HOST_CHECK(mesh.after.overfetch < 1.1f); // in first reference order each vertex is fetched about once
+
+    // The cached remapping survives a save and load, keys that are not listed are pruned
+    OptimizedMeshCache cache;
+    cache[1] = mesh;
+    cache[2] = mesh;
+    std::filesystem::path const directory = std::filesystem::temp_directory_path() / "capsaicin_host_tests";
+    std::filesystem::create_directories(directory);
+    std::filesystem::path const file_path = directory / "mesh_optimizer.cache";
+    HOST_CHECK(SaveOptimizedMeshCache(cache, {1, 3}, file_path.string().c_str()));
+    OptimizedMeshCache loaded;
+    HOST_CHECK(LoadOptimizedMeshCache(loaded, file_path.string().c_str()));
+    HOST_CHECK(loaded.size() == 1 && loaded.count(1) == 1);
+    if (loaded.count(1) == 1)
+    {
+        OptimizedMesh const &loaded_mesh = loaded[1];
+        HOST_CHECK(loaded_mesh.vertices == mesh.vertices);
+        HOST_CHECK(loaded_mesh.indices == mesh.indices);
+        HOST_CHECK(loaded_mesh.after.vertex_count == mesh.after.vertex_count);
+        HOST_CHECK(loaded_mesh.after.acmr == mesh.after.acmr);
+    }
+    std::filesystem::remove(file_path);
+    HOST_CHECK(!LoadOptimizedMeshCache(loaded, file_path.string().c_str()));
+}
+} // namespace Capsaicin
@@ -0,0 +1,100 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "host_test.h"
+#include "parallel_algorithms.h"
+
+#include <numeric>
+
+namespace Capsaicin
+{
+HOST_TEST(ParallelBlockBounds)
+{
+    // Block bounds must not wrap around for ranges close to UINT32_MAX
+    uint32_t const max_count = std::numeric_limits<uint32_t>::max();
+    HOST_CHECK(GetParallelBlockCount(0, kParallelBlockSize) == 0);
+    HOST_CHECK(GetParallelBlockCount(kParallelBlockSize, kParallelBlockSize) == 1);
+    HOST_CHECK(GetParallelBlockCount(kParallelBlockSize + 1, kParallelBlockSize) == 2);
+    HOST_CHECK(GetParallelBlockCount(max_count, kParallelBlockSize) == max_count / kParallelBlockSize + 1);
+    HOST_CHECK(GetParallelBlockCount(max_count, 1) == max_count);
+    uint32_t const last_block = GetParallelBlockCount(max_count, kParallelBlockSize) - 1;
+    HOST_CHECK(GetParallelBlockEnd(0, last_block, kParallelBlockSize, max_count) == max_count);
+    HOST_CHECK(
+        GetParallelBlockEnd(0, last_block - 1, kParallelBlockSize, max_count) == last_block * kParallelBlockSize);
+    HOST_CHECK(GetParallelBlockEnd(max_count - 10, 0, kParallelBlockSize, max_count) == max_count);
+}
+
+HOST_TEST(ParallelSegmentedAlgorithms)
+{
+    // Segments of every size, including empty ones and segments split into many blocks, must give the serial results
+    std::vector<uint32_t> const sizes = {0, 1, 5, kParallelBlockSize, kParallelBlockSize + 1, 0, 300000, 17, 0};
+    std::vector<uint32_t>       segment_offsets(sizes.size() + 1, 0);
+    std::inclusive_scan(sizes.begin(), sizes.end(), segment_offsets.begin() + 1);
+    uint32_t const        segment_count = (uint32_t)sizes.size();
+    std::vector<uint32_t> values(segment_offsets.back());
+    for (uint32_t i = 0; i < (uint32_t)values.size(); ++i)
+    {
+        values[i] = (i * 2654435761u) >> 20;
+    }
+    auto const add = [](uint32_t a, uint32_t b) { return a + b; };
+
+    std::vector<uint32_t> sums(segment_count);
+    ParallelSegmentedReduce(values.data(), segment_offsets.data(), segment_count, 0u, add, sums.data());
+    bool sums_match = true;
+    for (uint32_t segment = 0; segment < segment_count; ++segment)
+    {
+        sums_match = sums_match
+                  && sums[segment]
+                         == std::accumulate(values.begin() + segment_offsets[segment],
+                             values.begin() + segment_offsets[segment + 1], 0u);
+    }
+    HOST_CHECK(sums_match);
+
+    for (bool const inclusive : {false, true})
+    {
+        std::vector<uint32_t> scanned(values.size());
+        ParallelSegmentedScan(
+            values.data(), segment_offsets.data(), segment_count, scanned.data(), 0u, add, inclusive);
+        std::vector<uint32_t> expected(values.size());
+        for (uint32_t segment = 0; segment < segment_count; ++segment)
+        {
+            auto const begin = values.begin() + segment_offsets[segment];
+            auto const end   = values.begin() + segment_offsets[segment + 1];
+            if (inclusive)
+            {
+                std::inclusive_scan(begin, end, expected.begin() + segment_offsets[segment]);
+            }
+            else
+            {
+                std::exclusive_scan(begin, end, expected.begin() + segment_offsets[segment], 0u);
+            }
+        }
+        HOST_CHECK(scanned == expected);
+
+        // In place scans are allowed
+        std::vector<uint32_t> in_place = values;
+        ParallelSegmentedScan(
+            in_place.data(), segment_offsets.data(), segment_count, in_place.data(), 0u, add, inclusive);
+        HOST_CHECK(in_place == expected);
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,147 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "host_test.h"
+#include "render_graph_planner.h"
+
+namespace Capsaicin
+{
+namespace
+{
+using Access = RenderGraphPlanner::Access;
+
+constexpr uint64_t kColorKey = 1; /**< Key of the colour targets */
+constexpr uint64_t kDepthKey = 2; /**< Key of the depth targets */
+} // unnamed namespace
+
+HOST_TEST(RenderGraphPlannerAliasing)
+{
+    RenderGraphPlanner planner;
+    uint32_t const     output     = planner.addResource("Output", kColorKey, 100, true);
+    uint32_t const     temp0      = planner.addResource("Temp0", kColorKey, 300, false);
+    uint32_t const     temp1      = planner.addResource("Temp1", kColorKey, 200, false);
+    uint32_t const     temp2      = planner.addResource("Temp2", kColorKey, 100, false);
+    uint32_t const     depth      = planner.addResource("Depth", kDepthKey, 100, false);
+    uint32_t const     read_first = planner.addResource("ReadFirst", kColorKey, 100, false);
+    uint32_t const     cleared    = planner.addResource("Cleared", kColorKey, 100, false, true);
+    uint32_t const     unused     = planner.addResource("Unused", kColorKey, 100, false);
+    HOST_CHECK(planner.getResourceCount() == 8);
+    HOST_CHECK(planner.findResource("Temp1") == temp1);
+    HOST_CHECK(planner.findResource("Missing") == UINT32_MAX);
+
+    planner.addPass("Pass1");
+    planner.addAccess(temp0, Access::Write);
+    planner.addAccess(read_first, Access::Read);
+    planner.addPass("Pass2");
+    planner.addAccess(temp0, Access::Read);
+    planner.addAccess(temp2, Access::Write);
+    planner.addAccess(cleared, Access::ReadWrite);
+    planner.addPass("Pass3");
+    planner.addAccess(temp2, Access::Read);
+    planner.addAccess(temp1, Access::Write);
+    planner.addAccess(depth, Access::Write);
+    planner.addAccess(output, Access::Write);
+    planner.plan();
+    HOST_CHECK(planner.getPassCount() == 3);
+
+    // Resources written before being read live from their first write to their last access
+    HOST_CHECK(planner.isTransient(temp0) && planner.getFirstStep(temp0) == 1 && planner.getLastStep(temp0) == 2);
+    HOST_CHECK(planner.isTransient(temp2) && planner.getFirstStep(temp2) == 2 && planner.getLastStep(temp2) == 3);
+    HOST_CHECK(planner.isTransient(temp1) && planner.getFirstStep(temp1) == 3 && planner.getLastStep(temp1) == 3);
+    HOST_CHECK(planner.isTransient(cleared) && planner.getFirstStep(cleared) == 0);
+    HOST_CHECK(planner.getLastStep(cleared) == 2);
+
+    // Anything whose previous content may be read, external or never accessed is kept for the whole frame
+    HOST_CHECK(!planner.isTransient(output));
+    HOST_CHECK(!planner.isTransient(read_first));
+    HOST_CHECK(!planner.isTransient(unused));
+
+    // Only transient resources with matching keys and disjoint lifetimes share a slot, first fit in order of
+    // first live step places the last pass's temporary in the slot of the resource cleared at the start of the frame
+    HOST_CHECK(planner.getSlot(temp0) != planner.getSlot(cleared));
+    HOST_CHECK(planner.getSlot(temp2) != planner.getSlot(cleared) && planner.getSlot(temp2) != planner.getSlot(temp0));
+    HOST_CHECK(planner.getSlot(temp1) == planner.getSlot(cleared));
+    HOST_CHECK(planner.getSlot(depth) != planner.getSlot(temp0) && planner.getSlot(depth) != planner.getSlot(temp2));
+    uint32_t const shared_slot = planner.getSlot(temp1);
+    HOST_CHECK(planner.getSlotResourceCount(shared_slot) == 2);
+    HOST_CHECK(planner.getSlotSize(shared_slot) == 200);
+    for (uint32_t resource : {output, read_first, unused})
+    {
+        HOST_CHECK(planner.getSlotResourceCount(planner.getSlot(resource)) == 1);
+    }
+    HOST_CHECK(planner.getSlotCount() == 7);
+    HOST_CHECK(planner.getUnaliasedSize() == 1100);
+    HOST_CHECK(planner.getAliasedSize() == 1000);
+
+    planner.clear();
+    HOST_CHECK(planner.getResourceCount() == 0 && planner.getPassCount() == 0 && planner.getSlotCount() == 0);
+    HOST_CHECK(planner.getAliasedSize() == 0 && planner.getUnaliasedSize() == 0);
+}
+
+HOST_TEST(RenderGraphPlannerHistory)
+{
+    RenderGraphPlanner planner;
+    uint32_t const     depth      = planner.addResource("Depth", kDepthKey, 100, false);
+    uint32_t const     prev_depth = planner.addResource("PrevDepth", kDepthKey, 100, false);
+    uint32_t const     temp       = planner.addResource("Temp", kDepthKey, 100, false);
+    planner.addHistory(depth, prev_depth);
+    HOST_CHECK(planner.getHistorySource(prev_depth) == depth);
+    HOST_CHECK(planner.getHistorySource(depth) == UINT32_MAX);
+
+    // Accesses made before the first pass belong to it
+    planner.addAccess(temp, Access::Write);
+    planner.addPass("Pass1");
+    planner.addAccess(prev_depth, Access::Read);
+    planner.addAccess(temp, Access::Read);
+    planner.addPass("Pass2");
+    planner.addAccess(depth, Access::Write);
+    planner.addPass("Pass3");
+    planner.addAccess(depth, Access::Read);
+    planner.plan();
+
+    // The backup is written by the copy at the start of the frame and lives until its last reader
+    HOST_CHECK(planner.isTransient(prev_depth));
+    HOST_CHECK(planner.getFirstStep(prev_depth) == 0 && planner.getLastStep(prev_depth) == 1);
+    HOST_CHECK(planner.isTransient(temp) && planner.getFirstStep(temp) == 1 && planner.getLastStep(temp) == 1);
+
+    // The copied resource lives from its write until the copy at the start of the next frame
+    HOST_CHECK(planner.isTransient(depth));
+    HOST_CHECK(planner.getFirstStep(depth) == 2 && planner.getLastStep(depth) == 0);
+
+    // The wrapping lifetime overlaps the backup at the start of the frame but not the pass 1 temporary
+    HOST_CHECK(planner.getSlot(depth) != planner.getSlot(prev_depth));
+    HOST_CHECK(planner.getSlot(depth) == planner.getSlot(temp));
+    HOST_CHECK(planner.getSlotCount() == 2);
+    HOST_CHECK(planner.getAliasedSize() == 200);
+
+    // A copied resource written at the start of the frame is kept for the whole frame
+    planner.clear();
+    uint32_t const color      = planner.addResource("Color", kColorKey, 100, false, true);
+    uint32_t const prev_color = planner.addResource("PrevColor", kColorKey, 100, false);
+    planner.addHistory(color, prev_color);
+    planner.addPass("Pass1");
+    planner.addAccess(color, Access::Write);
+    planner.addAccess(prev_color, Access::Read);
+    planner.plan();
+    HOST_CHECK(!planner.isTransient(color));
+    HOST_CHECK(planner.getSlot(color) != planner.getSlot(prev_color));
+}
+} // namespace Capsaicin
@@ -0,0 +1,101 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "host_test.h"
+#include "scene_cache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Capsaicin
+{
+namespace
+{
+/**
+ * Write a text file.
+ * @param path The path of the file.
+ * @param text The contents of the file.
+ */
+void WriteFile(std::filesystem::path const &path, std::string const &text) noexcept
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(text.data(), (std::streamsize)text.size());
+}
+
+/**
+ * Get the path of a test file as returned by GetSceneFileReferences().
+ * @param directory The directory of the scene file.
+ * @param name      The name of the file relative to the directory.
+ * @returns The path of the file.
+ */
+std::string GetPath(std::filesystem::path const &directory, char const *name) noexcept
+{
+    return (directory / name).lexically_normal().string();
+}
+} // unnamed namespace
+
+HOST_TEST(SceneFileReferences)
+{
+    std::filesystem::path const directory =
+        std::filesystem::temp_directory_path() / "capsaicin_host_tests" / "scene_references";
+    std::filesystem::create_directories(directory / "textures");
+
+    // Embedded data is skipped, escapes and percent-encoding are decoded and "uri" values are not keys
+    std::string const json = R"({
+        "asset": {"version": "2.0", "generator": "\"uri\": \"ignored.bin\""},
+        "buffers": [
+            {"byteLength": 4, "uri" : "mesh.bin"},
+            {"byteLength": 4, "uri": "data:application/octet-stream;base64,AAAAAA=="}
+        ],
+        "images": [{"uri": "textures\/albedo%20map.png"}, {"uri": "textures/ao.png"}, {"name": "uri"}]
+    })";
+    std::vector<std::string> const expected = {GetPath(directory, "mesh.bin"),
+        GetPath(directory, "textures/albedo map.png"), GetPath(directory, "textures/ao.png")};
+    WriteFile(directory / "scene.gltf", json);
+    HOST_CHECK(GetSceneFileReferences((directory / "scene.gltf").string().c_str()) == expected);
+
+    // Binary glTF stores the same JSON in its first chunk
+    std::string glb(20, '\0');
+    uint32_t const header[5] = {0x46546C67u, 2, (uint32_t)(20 + json.size()), (uint32_t)json.size(), 0x4E4F534Au};
+    memcpy(glb.data(), header, sizeof(header));
+    WriteFile(directory / "scene.glb", glb + json);
+    HOST_CHECK(GetSceneFileReferences((directory / "scene.glb").string().c_str()) == expected);
+
+    // OBJ scenes reference material libraries, which reference textures after their options
+    WriteFile(directory / "scene.obj", "# comment\nmtllib scene.mtl\r\nv 0 0 0\nusemtl red\n");
+    WriteFile(directory / "scene.mtl",
+        "newmtl red\nKd 1 0 0\nmap_Kd textures/red.png\n  bump -bm 0.5 textures/bump.png  \nNs 10\n");
+    HOST_CHECK(GetSceneFileReferences((directory / "scene.obj").string().c_str())
+               == std::vector<std::string>({GetPath(directory, "scene.mtl"), GetPath(directory, "textures/red.png"),
+                   GetPath(directory, "textures/bump.png")}));
+
+    // Missing and unknown files reference nothing
+    HOST_CHECK(GetSceneFileReferences((directory / "missing.gltf").string().c_str()).empty());
+    WriteFile(directory / "scene.txt", json);
+    HOST_CHECK(GetSceneFileReferences((directory / "scene.txt").string().c_str()).empty());
+
+    std::filesystem::remove_all(directory);
+}
+} // namespace Capsaicin
@@ -0,0 +1,68 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "host_test.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace Capsaicin
+{
+HOST_TEST(ThreadPoolResize)
+{
+    // Other threads keep submitting parallel loops while the pool is re-sized, no task may be dropped or run twice
+    uint32_t const        count = 4096;
+    std::atomic<bool>     done  = false;
+    std::atomic<uint32_t> failures {0};
+    std::thread           submitter([&]() {
+        while (!done.load())
+        {
+            std::atomic<uint64_t> sum {0};
+            ThreadPool::ParallelFor(
+                count, [&](uint32_t index) { sum.fetch_add(index, std::memory_order_relaxed); }, 64);
+            if (sum.load() != (uint64_t)count * (count - 1) / 2)
+            {
+                ++failures;
+            }
+        }
+    });
+
+    uint32_t const thread_counts[] = {1, 4, 2, 3, 1, 8, 4};
+    for (uint32_t i = 0; i < 4 * (uint32_t)std::size(thread_counts); ++i)
+    {
+        uint32_t const thread_count = thread_counts[i % std::size(thread_counts)];
+        HOST_CHECK(ThreadPool::Create(thread_count));
+        HOST_CHECK(ThreadPool::GetThreadCount() == thread_count);
+        std::this_thread::yield();
+    }
+    ThreadPool::Destroy();
+    HOST_CHECK(ThreadPool::GetThreadCount() == 1);
+
+    done = true;
+    submitter.join();
+    HOST_CHECK(failures.load() == 0);
+
+    // Restore the pool the other tests run on
+    ThreadPool::Create(std::max(std::thread::hardware_concurrency(), 4u));
+}
+} // namespace Capsaicin
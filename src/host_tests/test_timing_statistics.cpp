@@ -0,0 +1,117 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "host_test.h"
+#include "timing_statistics.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace Capsaicin
+{
+HOST_TEST(TimingStatisticsSummaries)
+{
+    // Percentiles use the nearest rank of the sorted samples, whatever their insertion order
+    std::vector<double> samples(100);
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        samples[i] = 1.0 + i;
+    }
+    std::shuffle(samples.begin(), samples.end(), std::mt19937(100));
+    TimingSummary summary = TimingStatistics::Summarize("Frame", samples);
+    HOST_CHECK(summary.name == "Frame" && summary.count == 100);
+    HOST_CHECK(summary.min == 1.0 && summary.max == 100.0 && summary.mean == 50.5);
+    HOST_CHECK(summary.p50 == 50.0 && summary.p95 == 95.0 && summary.p99 == 99.0);
+    HOST_CHECK(summary.variance == 833.25); // (n^2 - 1) / 12
+
+    // Variance of samples far from zero doesn't suffer from cancellation
+    samples = {1e9 + 3.0, 1e9, 1e9 + 2.0, 1e9 + 1.0};
+    summary = TimingStatistics::Summarize("Offset", samples);
+    HOST_CHECK(summary.mean == 1e9 + 1.5 && summary.variance == 1.25);
+    HOST_CHECK(summary.p50 == 1e9 + 1.0 && summary.p95 == 1e9 + 3.0);
+
+    samples = {4.0};
+    summary = TimingStatistics::Summarize("Single", samples);
+    HOST_CHECK(summary.count == 1 && summary.min == 4.0 && summary.p50 == 4.0 && summary.p99 == 4.0);
+    HOST_CHECK(summary.max == 4.0 && summary.variance == 0.0);
+
+    samples.clear();
+    summary = TimingStatistics::Summarize("Empty", samples);
+    HOST_CHECK(summary.count == 0 && summary.mean == 0.0 && summary.max == 0.0);
+}
+
+HOST_TEST(TimingStatisticsSections)
+{
+    // Sections are reported in order of creation with the samples added to each
+    TimingStatistics statistics;
+    HOST_CHECK(statistics.empty());
+    for (uint32_t frame = 0; frame < 10; ++frame)
+    {
+        statistics.addSample("Total", 10.0 + frame);
+        statistics.addSample("Shading", 2.0);
+        if (frame == 0)
+        {
+            statistics.addSample("Scene Load (uncached)", 1000.0);
+        }
+    }
+    HOST_CHECK(!statistics.empty());
+    std::vector<TimingSummary> const summaries = statistics.getSummaries();
+    if (HOST_CHECK(summaries.size() == 3))
+    {
+        HOST_CHECK(summaries[0].name == "Total" && summaries[0].count == 10 && summaries[0].mean == 14.5);
+        HOST_CHECK(summaries[1].name == "Shading" && summaries[1].count == 10 && summaries[1].variance == 0.0);
+        HOST_CHECK(summaries[2].name == "Scene Load (uncached)" && summaries[2].count == 1);
+    }
+
+    // Summaries are written as CSV unless the file is a JSON one
+    std::filesystem::path const directory = std::filesystem::temp_directory_path() / "capsaicin_host_tests";
+    std::filesystem::create_directories(directory);
+    std::string const csv_path  = (directory / "timings.csv").string();
+    std::string const json_path = (directory / "timings.json").string();
+    HOST_CHECK(statistics.write(csv_path.c_str(), "ms"));
+    HOST_CHECK(statistics.write(json_path.c_str(), "ms"));
+    std::vector<std::string> lines;
+    {
+        std::ifstream file(csv_path);
+        for (std::string line; std::getline(file, line);)
+        {
+            lines.push_back(line);
+        }
+    }
+    if (HOST_CHECK(lines.size() == 4))
+    {
+        HOST_CHECK(lines[0]
+                   == "Section,Count,Min (ms),Mean (ms),P50 (ms),P95 (ms),P99 (ms),Max (ms),Variance (ms^2)");
+        HOST_CHECK(lines[1] == "Total,10,10,14.5,14,19,19,19,8.25");
+        HOST_CHECK(lines[2] == "Shading,10,2,2,2,2,2,2,0");
+    }
+    std::ifstream     json_file(json_path);
+    std::string const json((std::istreambuf_iterator<char>(json_file)), std::istreambuf_iterator<char>());
+    HOST_CHECK(json.find("\"unit\": \"ms\"") != std::string::npos);
+    HOST_CHECK(json.find("{\"name\": \"Shading\", \"count\": 10, \"min\": 2,") != std::string::npos);
+
+    statistics.clear();
+    HOST_CHECK(statistics.empty() && statistics.getSummaries().empty());
+    std::filesystem::remove_all(directory);
+}
+} // namespace Capsaicin
@@ -0,0 +1,113 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "host_test.h"
+#include "scene_flattener.h"
+
+#include <cmath>
+#include <random>
+
+namespace Capsaicin
+{
+namespace
+{
+/**
+ * Build a list of unit normals covering the whole sphere, including the axes and the octahedron seams.
+ * @param count The number of random normals.
+ * @returns The normals.
+ */
+std::vector<glm::vec3> MakeNormals(uint32_t count) noexcept
+{
+    std::vector<glm::vec3> normals = {
+        glm::vec3(1.0f, 0.0f, 0.0f),
+        glm::vec3(-1.0f, 0.0f, 0.0f),
+        glm::vec3(0.0f, 1.0f, 0.0f),
+        glm::vec3(0.0f, -1.0f, 0.0f),
+        glm::vec3(0.0f, 0.0f, 1.0f),
+        glm::vec3(0.0f, 0.0f, -1.0f),
+        glm::normalize(glm::vec3(1.0f, 1.0f, 0.0f)),
+        glm::normalize(glm::vec3(-1.0f, 0.0f, -1.0f)),
+        glm::normalize(glm::vec3(0.0f, -1.0f, -1.0f)),
+        glm::normalize(glm::vec3(-1.0f, -1.0f, -1.0f)),
+    };
+    std::mt19937                          random(count);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    while (normals.size() < count)
+    {
+        glm::vec3 const normal(distribution(random), distribution(random), distribution(random));
+        float const     length = glm::length(normal);
+        if (length > 1e-3f && length <= 1.0f)
+        {
+            normals.push_back(normal / length);
+        }
+    }
+    return normals;
+}
+} // unnamed namespace
+
+HOST_TEST(OctahedralNormalRoundTrip)
+{
+    // 2x16bit octahedral coordinates keep normals within a few hundredths of a degree
+    float const min_cosine = cosf(0.05f * 3.14159265f / 180.0f);
+
+    uint32_t failures = 0;
+    for (glm::vec3 const &normal : MakeNormals(1 << 20))
+    {
+        glm::vec3 const decoded = UnpackNormalOctahedral(PackNormalOctahedral(normal));
+        if (!(glm::abs(glm::length(decoded) - 1.0f) < 1e-5f && glm::dot(decoded, normal) >= min_cosine))
+        {
+            ++failures;
+        }
+    }
+    HOST_CHECK(failures == 0);
+
+    // The encoding is stable, decoding then encoding again gives the same bits
+    for (glm::vec3 const &normal : MakeNormals(4096))
+    {
+        uint32_t const packed_value = PackNormalOctahedral(normal);
+        HOST_CHECK(PackNormalOctahedral(UnpackNormalOctahedral(packed_value)) == packed_value);
+    }
+}
+
+HOST_TEST(CompactVertexRoundTrip)
+{
+    std::mt19937                          random(1);
+    std::uniform_real_distribution<float> positions(-1000.0f, 1000.0f);
+    std::uniform_real_distribution<float> uvs(-4.0f, 4.0f);
+    std::vector<glm::vec3> const          normals = MakeNormals(4096);
+    for (glm::vec3 const &normal : normals)
+    {
+        Vertex vertex   = {};
+        vertex.position = glm::vec4(positions(random), positions(random), positions(random), 1.0f);
+        vertex.normal   = glm::vec4(normal, 0.0f);
+        vertex.uv       = glm::vec2(uvs(random), uvs(random));
+
+        CompactVertex const compact = MakeCompactVertex(vertex);
+        HOST_CHECK(compact.position == glm::vec3(vertex.position)); // positions are kept at full precision
+        HOST_CHECK(glm::dot(UnpackNormalOctahedral(compact.normal), normal) > 0.99999f);
+
+        // Half precision keeps 11 significant bits
+        glm::vec2 const uv = UnpackUV(compact.uv);
+        HOST_CHECK(glm::abs(uv.x - vertex.uv.x) <= glm::abs(vertex.uv.x) * (1.0f / 2048.0f));
+        HOST_CHECK(glm::abs(uv.y - vertex.uv.y) <= glm::abs(vertex.uv.y) * (1.0f / 2048.0f));
+    }
+}
+} // namespace Capsaicin
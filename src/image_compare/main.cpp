@@ -0,0 +1,458 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "cpu_flip.h"
+#include "cpu_image_metrics.h"
+#include "thread_pool.h"
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <tinyexr.h>
+#include <vector>
+
+using namespace Capsaicin;
+
+namespace
+{
+char const *const kTypeNames[]   = {"HDR", "HDR_RGB", "SDR", "SDR_RGB", "SDR_NONLINEAR", "SDR_SRGB"};
+char const *const kMetricNames[] = {"MSE", "RMSE", "PSNR", "RMAE", "SMAPE", "SSIM", "FLIP", "Temporal"};
+
+constexpr uint32_t kFlipMetric     = 6; /**< Index of the perceptual difference in kMetricNames */
+constexpr uint32_t kTemporalMetric = 7; /**< Index of the temporal instability in kMetricNames */
+
+/** A pair of images to compare. */
+struct ImagePair
+{
+    uint32_t    frame_index = 0; /**< The frame index of the images (or their position if not frame dumps) */
+    std::string source_path;
+    std::string reference_path;
+};
+
+/** An image loaded as 4 floats per pixel. */
+struct Image
+{
+    std::vector<float> data;
+    uint32_t           width  = 0;
+    uint32_t           height = 0;
+};
+
+/**
+ * Get the frame index of a frame dump, named '<name>_<frame index>_<average frame time>.exr' by the scene viewer.
+ * @param       file_path   Path to the image.
+ * @param [out] frame_index The frame index in the file name.
+ * @returns True if the file name has a frame index, False otherwise.
+ */
+bool GetFrameIndex(std::filesystem::path const &file_path, uint32_t &frame_index)
+{
+    std::string const stem           = file_path.stem().string();
+    size_t const      time_separator = stem.rfind('_');
+    if (time_separator == std::string::npos || time_separator == 0)
+    {
+        return false;
+    }
+    size_t const      index_separator = stem.rfind('_', time_separator - 1);
+    size_t const      index_begin     = (index_separator == std::string::npos ? 0 : index_separator + 1);
+    std::string const index           = stem.substr(index_begin, time_separator - index_begin);
+    if (index.empty() || index.size() > 9
+        || !std::all_of(index.begin(), index.end(), [](char c) { return c >= '0' && c <= '9'; }))
+    {
+        return false;
+    }
+    frame_index = (uint32_t)std::stoul(index);
+    return true;
+}
+
+/**
+ * Pair the images of 2 directories, frame dumps are paired by frame index as their names hold the frame time and
+ * other images are paired by file name.
+ * @param       source_directory    Directory of the images to compare.
+ * @param       reference_directory Directory of the reference images.
+ * @param [out] pairs               The images found in both directories, in increasing frame index order.
+ */
+void PairImages(
+    std::string const &source_directory, std::string const &reference_directory, std::vector<ImagePair> &pairs)
+{
+    auto const list_images = [](std::string const &directory) {
+        std::vector<std::filesystem::path> images;
+        for (auto const &entry : std::filesystem::directory_iterator(directory))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".exr")
+            {
+                images.push_back(entry.path());
+            }
+        }
+        std::sort(images.begin(), images.end());
+        return images;
+    };
+    std::vector<std::filesystem::path> const references = list_images(reference_directory);
+    uint32_t                                 position   = 0;
+    for (auto const &source : list_images(source_directory))
+    {
+        uint32_t   frame_index = 0;
+        bool const is_dump     = GetFrameIndex(source, frame_index);
+        auto const reference = std::find_if(references.begin(), references.end(), [&](auto const &candidate) {
+            uint32_t candidate_index = 0;
+            return is_dump ? GetFrameIndex(candidate, candidate_index) && candidate_index == frame_index
+                           : candidate.filename() == source.filename();
+        });
+        if (reference == references.end())
+        {
+            fprintf(stderr, "No reference for '%s', skipped\n", source.string().c_str());
+            continue;
+        }
+        pairs.push_back({is_dump ? frame_index : position, source.string(), reference->string()});
+        ++position;
+    }
+    std::stable_sort(pairs.begin(), pairs.end(),
+        [](ImagePair const &a, ImagePair const &b) { return a.frame_index < b.frame_index; });
+}
+
+/**
+ * Load an EXR image.
+ * @param       file_path Full pathname to the file to read.
+ * @param [out] image     The loaded image.
+ * @returns True if succeeded, False otherwise.
+ */
+bool LoadImage(std::string const &file_path, Image &image)
+{
+    float      *rgba    = nullptr;
+    int         width   = 0;
+    int         height  = 0;
+    char const *exr_err = nullptr;
+    if (LoadEXR(&rgba, &width, &height, file_path.c_str(), &exr_err) != TINYEXR_SUCCESS)
+    {
+        fprintf(stderr, "Can't load '%s': %s\n", file_path.c_str(), exr_err != nullptr ? exr_err : "unknown error");
+        FreeEXRErrorMessage(exr_err);
+        return false;
+    }
+    image.width  = (uint32_t)width;
+    image.height = (uint32_t)height;
+    image.data.assign(rgba, rgba + (size_t)width * height * 4);
+    free(rgba);
+    return true;
+}
+
+/**
+ * Write an error map as a single channel EXR image.
+ * @param errors    The error of each pixel.
+ * @param width     The width of the map.
+ * @param height    The height of the map.
+ * @param file_path Full pathname to the file to write.
+ * @returns True if succeeded, False otherwise.
+ */
+bool WriteErrorMap(std::vector<float> const &errors, uint32_t width, uint32_t height, char const *file_path)
+{
+    EXRChannelInfo channel_info;
+    channel_info.name[0]     = 'Y';
+    channel_info.name[1]     = '\0';
+    int pixel_type           = TINYEXR_PIXELTYPE_FLOAT;
+    int requested_pixel_type = TINYEXR_PIXELTYPE_HALF;
+
+    EXRHeader exr_header;
+    InitEXRHeader(&exr_header);
+    exr_header.compression_type      = TINYEXR_COMPRESSIONTYPE_PIZ;
+    exr_header.num_channels          = 1;
+    exr_header.channels              = &channel_info;
+    exr_header.pixel_types           = &pixel_type;
+    exr_header.requested_pixel_types = &requested_pixel_type;
+
+    unsigned char *images[1] = {(unsigned char *)const_cast<float *>(errors.data())};
+    EXRImage       exr_image;
+    InitEXRImage(&exr_image);
+    exr_image.num_channels = 1;
+    exr_image.images       = images;
+    exr_image.width        = (int)width;
+    exr_image.height       = (int)height;
+
+    char const *exr_err = nullptr;
+    if (SaveEXRImageToFile(&exr_image, &exr_header, file_path, &exr_err) != TINYEXR_SUCCESS)
+    {
+        fprintf(stderr, "Can't save '%s': %s\n", file_path, exr_err != nullptr ? exr_err : "unknown error");
+        FreeEXRErrorMessage(exr_err);
+        return false;
+    }
+    return true;
+}
+} // unnamed namespace
+
+int main(int argc, char **argv)
+{
+    CLI::App app("Capsaicin - Image Compare");
+    std::string source_path;
+    app.add_option("source", source_path, "Image, or directory of images, to compare")
+        ->required()
+        ->check(CLI::ExistingPath);
+    std::string reference_path;
+    app.add_option("reference", reference_path, "Reference image, or directory of reference images")
+        ->required()
+        ->check(CLI::ExistingPath);
+    std::string type_name = "HDR_RGB";
+    app.add_option("-t,--type", type_name, "Type of the image values")
+        ->check(CLI::IsMember(std::vector<std::string>(std::begin(kTypeNames), std::end(kTypeNames))));
+    std::vector<std::string> metric_names(std::begin(kMetricNames), std::end(kMetricNames));
+    app.add_option("-m,--metrics", metric_names,
+           "Metrics to compute (all if omitted), Temporal is the flicker of the source relative to the reference "
+           "since the previous image of the directory")
+        ->check(CLI::IsMember(std::vector<std::string>(std::begin(kMetricNames), std::end(kMetricNames))));
+    std::string output_path;
+    app.add_option("-o,--output", output_path, "CSV file to write the metrics to (printed if omitted)");
+    float pixels_per_degree = CPUFlip::kDefaultPixelsPerDegree;
+    app.add_option("--ppd", pixels_per_degree, "Pixels per degree of visual angle used by FLIP");
+    float        exposure        = 0.0f;
+    CLI::Option *exposure_option = app.add_option("--exposure", exposure,
+        "Exposure (in stops) applied before FLIP clamps the images to [0,1], HDR images are compared with HDR-FLIP "
+        "over the exposure range of the reference if omitted");
+    std::string error_map_directory;
+    app.add_option("--error-maps", error_map_directory, "Directory to write the FLIP error map of each image to");
+    std::string tile_output_path;
+    app.add_option("--tile-output", tile_output_path, "CSV file to write the FLIP error histogram of each tile to");
+    uint32_t tile_size = 32;
+    app.add_option("--tile-size", tile_size, "Width and height of the tiles (in pixels)")->check(CLI::PositiveNumber);
+    uint32_t tile_bins = 10;
+    app.add_option("--tile-bins", tile_bins, "Number of bins of the tile histograms")->check(CLI::PositiveNumber);
+    double       max_flip        = 0.0;
+    CLI::Option *max_flip_option = app.add_option(
+        "--max-flip", max_flip, "Fail if the mean FLIP error over all images is above this threshold");
+    double       max_temporal        = 0.0;
+    CLI::Option *max_temporal_option = app.add_option(
+        "--max-temporal", max_temporal, "Fail if the mean temporal instability is above this threshold");
+    uint32_t thread_count = std::thread::hardware_concurrency();
+    app.add_option("-j,--threads", thread_count, "Number of threads used to compute the metrics");
+    CLI11_PARSE(app, argc, argv);
+
+    std::vector<ImagePair> pairs;
+    if (std::filesystem::is_directory(source_path) && std::filesystem::is_directory(reference_path))
+    {
+        PairImages(source_path, reference_path, pairs);
+    }
+    else if (!std::filesystem::is_directory(source_path) && !std::filesystem::is_directory(reference_path))
+    {
+        uint32_t frame_index = 0;
+        GetFrameIndex(source_path, frame_index);
+        pairs.push_back({frame_index, source_path, reference_path});
+    }
+    else
+    {
+        fprintf(stderr, "The source and the reference must both be images or both be directories\n");
+        return 1;
+    }
+    if (pairs.empty())
+    {
+        fprintf(stderr, "No images to compare\n");
+        return 1;
+    }
+
+    CPUImageMetrics::Type const type = (CPUImageMetrics::Type)(
+        std::find(std::begin(kTypeNames), std::end(kTypeNames), type_name) - std::begin(kTypeNames));
+    std::vector<uint32_t> metric_indices;
+    for (std::string const &metric_name : metric_names)
+    {
+        metric_indices.push_back((uint32_t)(
+            std::find(std::begin(kMetricNames), std::end(kMetricNames), metric_name) - std::begin(kMetricNames)));
+    }
+    bool const compute_flip =
+        std::find(metric_indices.begin(), metric_indices.end(), kFlipMetric) != metric_indices.end()
+        || !error_map_directory.empty() || !tile_output_path.empty() || *max_flip_option;
+    bool const hdr_flip =
+        (type == CPUImageMetrics::Type::HDR || type == CPUImageMetrics::Type::HDR_RGB) && !*exposure_option;
+    bool const compute_temporal =
+        std::find(metric_indices.begin(), metric_indices.end(), kTemporalMetric) != metric_indices.end()
+        || *max_temporal_option;
+    if (!error_map_directory.empty())
+    {
+        std::error_code error;
+        std::filesystem::create_directories(error_map_directory, error);
+    }
+
+    std::ofstream output_file;
+    if (!output_path.empty())
+    {
+        output_file.open(output_path);
+        if (!output_file.is_open())
+        {
+            fprintf(stderr, "Can't create '%s'\n", output_path.c_str());
+            return 1;
+        }
+    }
+    std::ostream &output = output_path.empty() ? std::cout : output_file;
+
+    // Same layout as the image metrics written in benchmark mode, one row per frame
+    output << "Frame";
+    for (std::string const &metric_name : metric_names)
+    {
+        output << ',' << metric_name;
+    }
+    output << '\n';
+
+    std::ofstream tile_output;
+    if (!tile_output_path.empty())
+    {
+        tile_output.open(tile_output_path);
+        if (!tile_output.is_open())
+        {
+            fprintf(stderr, "Can't create '%s'\n", tile_output_path.c_str());
+            return 1;
+        }
+        tile_output << "Frame,Tile X,Tile Y";
+        for (uint32_t bin = 0; bin < tile_bins; ++bin)
+        {
+            tile_output << ',' << (double)bin / tile_bins << '-' << (double)(bin + 1) / tile_bins;
+        }
+        tile_output << '\n';
+    }
+
+    ThreadPool::Create(thread_count);
+    CPUImageMetrics       metrics;
+    CPUImageMetrics       temporal_metrics;
+    CPUFlip               flip;
+    Image                 source;
+    Image                 reference;
+    std::vector<uint32_t> histograms;
+    double                flip_sum       = 0.0;
+    double                temporal_sum   = 0.0;
+    uint32_t              temporal_count = 0;
+    int                   result         = 0;
+    temporal_metrics.initialise(type, CPUImageMetrics::Operation::MSE);
+    flip.initialise(pixels_per_degree, exposure);
+    for (ImagePair const &pair : pairs)
+    {
+        if (!LoadImage(pair.source_path, source) || !LoadImage(pair.reference_path, reference))
+        {
+            result = 1;
+            break;
+        }
+        if (source.width != reference.width || source.height != reference.height)
+        {
+            fprintf(stderr, "'%s' and '%s' have different sizes\n", pair.source_path.c_str(),
+                pair.reference_path.c_str());
+            result = 1;
+            break;
+        }
+
+        if (compute_flip)
+        {
+            if (hdr_flip)
+            {
+                flip.compareHDR(source.data.data(), reference.data.data(), reference.width, reference.height);
+            }
+            else
+            {
+                flip.compare(source.data.data(), reference.data.data(), reference.width, reference.height);
+            }
+            flip_sum += flip.getMetricValue();
+            if (!error_map_directory.empty())
+            {
+                std::string const file_path =
+                    (std::filesystem::path(error_map_directory)
+                        / (std::filesystem::path(pair.source_path).stem().string() + "_flip.exr"))
+                        .string();
+                if (!WriteErrorMap(flip.getErrorMap(), reference.width, reference.height, file_path.c_str()))
+                {
+                    result = 1;
+                    break;
+                }
+            }
+            if (tile_output.is_open())
+            {
+                flip.getTileHistograms(tile_size, tile_bins, histograms);
+                uint32_t const tile_count_x = (reference.width + tile_size - 1) / tile_size;
+                for (size_t tile = 0; tile < histograms.size() / tile_bins; ++tile)
+                {
+                    tile_output << pair.frame_index << ',' << tile % tile_count_x << ',' << tile / tile_count_x;
+                    for (uint32_t bin = 0; bin < tile_bins; ++bin)
+                    {
+                        tile_output << ',' << histograms[tile * tile_bins + bin];
+                    }
+                    tile_output << '\n';
+                }
+            }
+        }
+        bool const has_temporal =
+            compute_temporal
+            && temporal_metrics.compareTemporal(
+                source.data.data(), reference.data.data(), reference.width, reference.height);
+        if (has_temporal)
+        {
+            temporal_sum += temporal_metrics.getMetricValue();
+            ++temporal_count;
+        }
+
+        output << pair.frame_index;
+        for (uint32_t const metric_index : metric_indices)
+        {
+            output << ',';
+            if (metric_index == kFlipMetric)
+            {
+                output << flip.getMetricValue();
+            }
+            else if (metric_index == kTemporalMetric)
+            {
+                // Left empty for the first image, that has no previous image
+                if (has_temporal)
+                {
+                    output << temporal_metrics.getMetricValue();
+                }
+            }
+            else
+            {
+                metrics.initialise(type, (CPUImageMetrics::Operation)metric_index);
+                metrics.compare(source.data.data(), reference.data.data(), reference.width, reference.height);
+                output << metrics.getMetricValue();
+            }
+        }
+        output << '\n';
+    }
+    ThreadPool::Destroy();
+    if (result != 0)
+    {
+        return result;
+    }
+
+    // Accept or reject the source images, e.g., a cheaper render configuration against an expensive one
+    if (compute_flip)
+    {
+        double const mean_flip = flip_sum / (double)pairs.size();
+        fprintf(stderr, "Mean FLIP: %g\n", mean_flip);
+        if (*max_flip_option && mean_flip > max_flip)
+        {
+            fprintf(stderr, "Quality regression: mean FLIP %g is above %g\n", mean_flip, max_flip);
+            result = 1;
+        }
+    }
+    if (compute_temporal && temporal_count > 0)
+    {
+        double const mean_temporal = temporal_sum / temporal_count;
+        fprintf(stderr, "Mean temporal instability: %g\n", mean_temporal);
+        if (*max_temporal_option && mean_temporal > max_temporal)
+        {
+            fprintf(stderr, "Quality regression: mean temporal instability %g is above %g\n", mean_temporal,
+                max_temporal);
+            result = 1;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,472 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+// Null gfx backend, used in place of gfx by the host targets so that the CPU side of Capsaicin can run and be
+// tested without a GPU (e.g., on build machines). It implements the subset of the gfx API used by the Capsaicin core
+// sources, with the gfx signatures so that those sources build unchanged against it: objects are fake handles,
+// buffers live in host memory and commands are only counted (see gfxNullGetStatistics()).
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <string_view> // included by gfx, which the Capsaicin headers rely on
+#include <vector>
+
+#include <d3d12.h>
+#include <dxgiformat.h>
+
+#define GFX_ALIGN(VAL, ALIGN) \
+    (((VAL) + (static_cast<decltype(VAL)>(ALIGN) - 1)) & ~(static_cast<decltype(VAL)>(ALIGN) - 1))
+#define GFX_MAX(X, Y)                ((X) > (Y) ? (X) : (Y))
+#define GFX_MIN(X, Y)                ((X) < (Y) ? (X) : (Y))
+#define GFX_ASSERT(X)                assert(X)
+#define GFX_SNPRINTF(...)            snprintf(__VA_ARGS__)
+#define GFX_PRINTLN(...)             (fprintf(stdout, __VA_ARGS__), fprintf(stdout, "\n"), (void)0)
+#define GFX_PRINT_ERROR(RESULT, ...) ((void)(RESULT), fprintf(stderr, __VA_ARGS__), fprintf(stderr, "\n"), (void)0)
+#ifndef ARRAYSIZE
+#    define ARRAYSIZE(ARRAY) (sizeof(ARRAY) / sizeof(*(ARRAY)))
+#endif
+
+enum GfxResult
+{
+    kGfxResult_NoError = 0,
+    kGfxResult_InvalidParameter,
+    kGfxResult_InvalidOperation,
+    kGfxResult_OutOfMemory,
+    kGfxResult_InternalError,
+    kGfxResult_DeviceError,
+
+    kGfxResult_Count
+};
+
+enum GfxCpuAccess
+{
+    kGfxCpuAccess_None = 0,
+    kGfxCpuAccess_Read,
+    kGfxCpuAccess_Write,
+
+    kGfxCpuAccess_Count
+};
+
+enum GfxCreateContextFlag
+{
+    kGfxCreateContextFlag_EnableDebugLayer = 1 << 0
+};
+using GfxCreateContextFlags = uint32_t;
+
+enum GfxDataType
+{
+    kGfxDataType_Int = 0,
+    kGfxDataType_Uint,
+    kGfxDataType_Float,
+
+    kGfxDataType_Count
+};
+
+enum GfxShaderGroupType
+{
+    kGfxShaderGroupType_Raygen = 0,
+    kGfxShaderGroupType_Miss,
+    kGfxShaderGroupType_Hit,
+    kGfxShaderGroupType_Callable,
+
+    kGfxShaderGroupType_Count
+};
+
+enum GfxBuildRaytracingPrimitiveFlag
+{
+    kGfxBuildRaytracingPrimitiveFlag_Opaque = 1 << 0
+};
+
+constexpr uint32_t kGfxConstant_MaxNameLength   = 64;
+constexpr uint32_t kGfxConstant_BackBufferCount = 3;
+constexpr uint32_t kGfxConstant_NumThreads      = 8; /**< Group size of the null kernels along X and Y */
+
+/** Base of the null gfx objects, a handle into the objects of the owning context (0 if invalid). */
+class GfxNullObject
+{
+public:
+    inline bool operator==(GfxNullObject const &other) const { return handle == other.handle; }
+    inline bool operator!=(GfxNullObject const &other) const { return handle != other.handle; }
+    inline operator bool() const { return handle != 0; }
+    inline uint64_t getHandle() const { return handle; }
+    inline char const *getName() const { return name; }
+    void               setName(char const *object_name);
+
+protected:
+    uint64_t handle                           = 0;
+    char     name[kGfxConstant_MaxNameLength] = {};
+};
+
+class GfxContext : public GfxNullObject
+{
+    friend class GfxNullInternal;
+
+public:
+    /** The null device has no vendor, it reports 0 so that no vendor specific path is taken. */
+    inline uint32_t getVendorId() const { return 0; }
+};
+
+class GfxBuffer : public GfxNullObject
+{
+    friend class GfxNullInternal;
+
+public:
+    inline uint64_t     getSize() const { return size; }
+    inline uint32_t     getStride() const { return stride; }
+    inline uint64_t     getCount() const { return stride != 0 ? size / stride : 0; }
+    inline void         setStride(uint32_t buffer_stride) { stride = buffer_stride; }
+    inline GfxCpuAccess getCpuAccess() const { return cpu_access; }
+
+protected:
+    uint64_t     size       = 0;
+    uint32_t     stride     = 0;
+    GfxCpuAccess cpu_access = kGfxCpuAccess_None;
+};
+
+class GfxTexture : public GfxNullObject
+{
+    friend class GfxNullInternal;
+
+public:
+    enum Type
+    {
+        kType_2D = 0,
+        kType_2DArray,
+        kType_3D,
+        kType_Cube,
+
+        kType_Count
+    };
+
+    inline Type        getType() const { return type; }
+    inline bool        is2D() const { return type == kType_2D; }
+    inline bool        is2DArray() const { return type == kType_2DArray; }
+    inline bool        is3D() const { return type == kType_3D; }
+    inline bool        isCube() const { return type == kType_Cube; }
+    inline uint32_t    getWidth() const { return width; }
+    inline uint32_t    getHeight() const { return height; }
+    inline uint32_t    getDepth() const { return depth; }
+    inline DXGI_FORMAT getFormat() const { return format; }
+    inline uint32_t    getMipLevels() const { return mip_levels; }
+
+protected:
+    Type        type       = kType_2D;
+    uint32_t    width      = 0;
+    uint32_t    height     = 0;
+    uint32_t    depth      = 0;
+    DXGI_FORMAT format     = DXGI_FORMAT_UNKNOWN;
+    uint32_t    mip_levels = 0;
+};
+
+class GfxProgram : public GfxNullObject
+{
+    friend class GfxNullInternal;
+};
+
+/** The shader sources of a program created from memory. */
+struct GfxProgramDesc
+{
+    char const *cs  = nullptr;
+    char const *as  = nullptr;
+    char const *ms  = nullptr;
+    char const *vs  = nullptr;
+    char const *gs  = nullptr;
+    char const *ps  = nullptr;
+    char const *lib = nullptr;
+};
+
+class GfxKernel : public GfxNullObject
+{
+    friend class GfxNullInternal;
+
+public:
+    enum Type
+    {
+        kType_Compute = 0,
+        kType_Graphics,
+        kType_Raytracing,
+
+        kType_Count
+    };
+
+    inline Type getType() const { return type; }
+    inline bool isCompute() const { return type == kType_Compute; }
+    inline bool isGraphics() const { return type == kType_Graphics; }
+    inline bool isRaytracing() const { return type == kType_Raytracing; }
+
+protected:
+    Type type = kType_Compute;
+};
+
+class GfxSamplerState : public GfxNullObject
+{
+    friend class GfxNullInternal;
+};
+
+class GfxTimestampQuery : public GfxNullObject
+{
+    friend class GfxNullInternal;
+};
+
+/** Render targets of a graphics kernel, accepted and ignored by the null backend. */
+class GfxDrawState
+{};
+
+class GfxSbt : public GfxNullObject
+{
+    friend class GfxNullInternal;
+};
+
+class GfxAccelerationStructure : public GfxNullObject
+{
+    friend class GfxNullInternal;
+};
+
+class GfxRaytracingPrimitive : public GfxNullObject
+{
+    friend class GfxNullInternal;
+};
+
+/** Counters of the objects and commands of a null context, used to check the work submitted by a frame loop. */
+struct GfxNullStatistics
+{
+    uint32_t buffer_count                = 0; /**< Number of live buffers (including buffer ranges) */
+    uint32_t texture_count               = 0; /**< Number of live textures */
+    uint32_t kernel_count                = 0; /**< Number of live kernels */
+    uint32_t raytracing_primitive_count  = 0; /**< Number of live raytracing primitives */
+    uint64_t buffer_bytes                = 0; /**< Memory allocated by the live buffers (ranges excluded) */
+    uint64_t frame_count                 = 0; /**< Number of calls to gfxFrame() */
+    uint64_t dispatch_count              = 0; /**< Number of compute dispatches (direct and indirect) */
+    uint64_t dispatch_group_count        = 0; /**< Number of groups launched by the direct dispatches */
+    uint64_t dispatch_rays_count         = 0; /**< Number of ray dispatches (direct and indirect) */
+    uint64_t draw_count                  = 0; /**< Number of draws */
+    uint64_t copy_count                  = 0; /**< Number of buffer and texture copies */
+    uint64_t copy_bytes                  = 0; /**< Number of bytes copied from buffers (to buffers or textures) */
+    uint64_t raytracing_build_count      = 0; /**< Number of raytracing primitive builds and updates */
+    uint64_t acceleration_update_count   = 0; /**< Number of acceleration structure updates */
+    uint64_t event_count                 = 0; /**< Number of events begun (and so of scopes timed) */
+};
+
+// Context
+GfxContext gfxCreateContext(uint32_t width, uint32_t height, GfxCreateContextFlags flags = 0);
+GfxResult  gfxDestroyContext(GfxContext context);
+uint32_t   gfxGetBackBufferWidth(GfxContext context);
+uint32_t   gfxGetBackBufferHeight(GfxContext context);
+uint32_t   gfxGetBackBufferIndex(GfxContext context);
+uint32_t   gfxGetBackBufferCount(GfxContext context);
+GfxResult  gfxFrame(GfxContext context, bool vsync = true);
+GfxResult  gfxFinish(GfxContext context);
+
+/**
+ * Gets the counters of a null context.
+ * @param context The null context.
+ * @returns The counters (all 0 for an invalid context).
+ */
+GfxNullStatistics gfxNullGetStatistics(GfxContext context);
+
+// Buffers
+GfxBuffer gfxCreateBuffer(
+    GfxContext gfx, uint64_t size, void const *data = nullptr, GfxCpuAccess cpu_access = kGfxCpuAccess_None);
+GfxBuffer gfxCreateBufferRange(GfxContext gfx, GfxBuffer buffer, uint64_t byte_offset, uint64_t size = 0);
+GfxResult gfxDestroyBuffer(GfxContext gfx, GfxBuffer buffer);
+void     *gfxBufferGetData(GfxContext gfx, GfxBuffer buffer);
+
+template<typename TYPE>
+GfxBuffer gfxCreateBuffer(GfxContext gfx, uint64_t element_count, void const *element_data = nullptr,
+    GfxCpuAccess cpu_access = kGfxCpuAccess_None)
+{
+    GfxBuffer buffer = gfxCreateBuffer(gfx, element_count * sizeof(TYPE), element_data, cpu_access);
+    buffer.setStride((uint32_t)sizeof(TYPE));
+    return buffer;
+}
+
+template<typename TYPE>
+GfxBuffer gfxCreateBufferRange(GfxContext gfx, GfxBuffer buffer, uint64_t element_offset, uint64_t element_count = 0)
+{
+    GfxBuffer buffer_range =
+        gfxCreateBufferRange(gfx, buffer, element_offset * sizeof(TYPE), element_count * sizeof(TYPE));
+    buffer_range.setStride((uint32_t)sizeof(TYPE));
+    return buffer_range;
+}
+
+template<typename TYPE>
+TYPE *gfxBufferGetData(GfxContext gfx, GfxBuffer buffer)
+{
+    return static_cast<TYPE *>(gfxBufferGetData(gfx, buffer));
+}
+
+// Textures
+GfxTexture gfxCreateTexture2D(GfxContext gfx, DXGI_FORMAT format);
+GfxTexture gfxCreateTexture2D(GfxContext gfx, uint32_t width, uint32_t height, DXGI_FORMAT format,
+    uint32_t mip_levels = 1, float const *clear_value = nullptr);
+GfxTexture gfxCreateTexture2DArray(GfxContext gfx, uint32_t width, uint32_t height, uint32_t slice_count,
+    DXGI_FORMAT format, uint32_t mip_levels = 1, float const *clear_value = nullptr);
+GfxTexture gfxCreateTexture3D(GfxContext gfx, uint32_t width, uint32_t height, uint32_t depth, DXGI_FORMAT format,
+    uint32_t mip_levels = 1, float const *clear_value = nullptr);
+GfxTexture gfxCreateTextureCube(
+    GfxContext gfx, uint32_t size, DXGI_FORMAT format, uint32_t mip_levels = 1, float const *clear_value = nullptr);
+GfxResult  gfxDestroyTexture(GfxContext gfx, GfxTexture texture);
+uint32_t   gfxCalculateMipCount(uint32_t width, uint32_t height = 0, uint32_t depth = 0);
+
+// Sampler states
+GfxSamplerState gfxCreateSamplerState(GfxContext gfx, D3D12_FILTER filter,
+    D3D12_TEXTURE_ADDRESS_MODE address_u = D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+    D3D12_TEXTURE_ADDRESS_MODE address_v = D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+    D3D12_TEXTURE_ADDRESS_MODE address_w = D3D12_TEXTURE_ADDRESS_MODE_CLAMP, float mip_lod_bias = 0.0f,
+    float min_lod = 0.0f, float max_lod = (float)D3D12_REQ_MIP_LEVELS);
+GfxSamplerState gfxCreateSamplerState(GfxContext gfx, D3D12_FILTER filter, D3D12_COMPARISON_FUNC comparison_func,
+    D3D12_TEXTURE_ADDRESS_MODE address_u = D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+    D3D12_TEXTURE_ADDRESS_MODE address_v = D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+    D3D12_TEXTURE_ADDRESS_MODE address_w = D3D12_TEXTURE_ADDRESS_MODE_CLAMP, float mip_lod_bias = 0.0f,
+    float min_lod = 0.0f, float max_lod = (float)D3D12_REQ_MIP_LEVELS);
+GfxResult       gfxDestroySamplerState(GfxContext gfx, GfxSamplerState sampler_state);
+
+// Programs and kernels
+GfxProgram gfxCreateProgram(GfxContext gfx, char const *file_name, char const *file_path = nullptr,
+    char const *shader_model = nullptr, char const **include_paths = nullptr, uint32_t include_path_count = 0);
+GfxProgram gfxCreateProgram(GfxContext gfx, GfxProgramDesc program_desc, char const *name = nullptr,
+    char const *shader_model = nullptr, char const **include_paths = nullptr, uint32_t include_path_count = 0);
+GfxResult  gfxDestroyProgram(GfxContext gfx, GfxProgram program);
+GfxKernel  gfxCreateComputeKernel(GfxContext gfx, GfxProgram program, char const *entry_point = nullptr,
+     char const **defines = nullptr, uint32_t define_count = 0);
+GfxKernel  gfxCreateGraphicsKernel(GfxContext gfx, GfxProgram program, char const *entry_point = nullptr,
+     char const **defines = nullptr, uint32_t define_count = 0);
+GfxKernel  gfxCreateGraphicsKernel(GfxContext gfx, GfxProgram program, GfxDrawState draw_state,
+     char const *entry_point = nullptr, char const **defines = nullptr, uint32_t define_count = 0);
+GfxKernel  gfxCreateRaytracingKernel(
+     GfxContext gfx, GfxProgram program, char const **defines = nullptr, uint32_t define_count = 0);
+GfxResult  gfxDestroyKernel(GfxContext gfx, GfxKernel kernel);
+
+/** Every null kernel has a group size of kGfxConstant_NumThreads along X and Y. */
+uint32_t const *gfxKernelGetNumThreads(GfxContext gfx, GfxKernel kernel);
+GfxResult       gfxDrawStateSetColorTarget(GfxDrawState draw_state, uint32_t target_index, GfxTexture texture,
+          uint32_t mip_level = 0, uint32_t slice = 0);
+
+/** Parameters are accepted and ignored, the null backend doesn't run shaders. */
+template<typename TYPE>
+GfxResult gfxProgramSetParameter(GfxContext, GfxProgram, char const *, TYPE const &)
+{
+    return kGfxResult_NoError;
+}
+
+inline GfxResult gfxProgramSetParameter(GfxContext, GfxProgram, char const *, GfxTexture const &, uint32_t)
+{
+    return kGfxResult_NoError;
+}
+
+inline GfxResult gfxProgramSetParameter(GfxContext, GfxProgram, char const *, GfxTexture const *, uint32_t)
+{
+    return kGfxResult_NoError;
+}
+
+inline GfxResult gfxProgramSetParameter(GfxContext, GfxProgram, char const *, GfxBuffer const *, uint32_t)
+{
+    return kGfxResult_NoError;
+}
+
+// Commands
+GfxResult gfxCommandBindKernel(GfxContext gfx, GfxKernel kernel);
+GfxResult gfxCommandDispatch(GfxContext gfx, uint32_t num_groups_x, uint32_t num_groups_y, uint32_t num_groups_z);
+GfxResult gfxCommandDispatchIndirect(GfxContext gfx, GfxBuffer args_buffer);
+GfxResult gfxCommandDispatchRays(GfxContext gfx, GfxSbt sbt, uint32_t width, uint32_t height, uint32_t depth);
+GfxResult gfxCommandDispatchRaysIndirect(GfxContext gfx, GfxSbt sbt, GfxBuffer args_buffer);
+GfxResult gfxCommandDraw(GfxContext gfx, uint32_t vertex_count, uint32_t instance_count = 1,
+    uint32_t base_vertex = 0, uint32_t base_instance = 0);
+GfxResult gfxCommandDrawIndexed(GfxContext gfx, uint32_t index_count, uint32_t instance_count = 1,
+    uint32_t first_index = 0, uint32_t base_vertex = 0, uint32_t base_instance = 0);
+GfxResult gfxCommandCopyBuffer(GfxContext gfx, GfxBuffer dst, GfxBuffer src);
+GfxResult gfxCommandCopyBuffer(
+    GfxContext gfx, GfxBuffer dst, uint64_t dst_offset, GfxBuffer src, uint64_t src_offset, uint64_t size);
+GfxResult gfxCommandCopyTexture(GfxContext gfx, GfxTexture dst, GfxTexture src);
+GfxResult gfxCommandCopyBufferToTexture(GfxContext gfx, GfxTexture dst, GfxBuffer src);
+GfxResult gfxCommandClearBuffer(GfxContext gfx, GfxBuffer buffer, uint32_t clear_value = 0);
+GfxResult gfxCommandClearTexture(GfxContext gfx, GfxTexture texture);
+GfxResult gfxCommandGenerateMips(GfxContext gfx, GfxTexture texture);
+GfxResult gfxCommandClearBackBuffer(GfxContext gfx);
+GfxResult gfxCommandBindIndexBuffer(GfxContext gfx, GfxBuffer index_buffer);
+GfxResult gfxCommandBindVertexBuffer(GfxContext gfx, GfxBuffer vertex_buffer);
+GfxResult gfxCommandMultiDrawIndexedIndirect(GfxContext gfx, GfxBuffer args_buffer, uint32_t args_count);
+GfxResult gfxCommandScanSum(
+    GfxContext gfx, GfxDataType data_type, GfxBuffer dst, GfxBuffer src, GfxBuffer const *count = nullptr);
+GfxResult gfxCommandBeginEvent(GfxContext gfx, char const *format, ...);
+GfxResult gfxCommandEndEvent(GfxContext gfx);
+
+/** Scoped command event, as in gfx. */
+class GfxCommandEvent
+{
+public:
+    template<typename... ARGS>
+    GfxCommandEvent(GfxContext const &gfx, char const *format, ARGS... args)
+        : gfx_(gfx)
+    {
+        gfxCommandBeginEvent(gfx_, format, args...);
+    }
+
+    ~GfxCommandEvent() { gfxCommandEndEvent(gfx_); }
+
+    GfxCommandEvent(GfxCommandEvent const &)            = delete;
+    GfxCommandEvent &operator=(GfxCommandEvent const &) = delete;
+
+private:
+    GfxContext gfx_;
+};
+
+// Timestamp queries
+GfxTimestampQuery gfxCreateTimestampQuery(GfxContext gfx);
+GfxResult         gfxDestroyTimestampQuery(GfxContext gfx, GfxTimestampQuery timestamp_query);
+
+/** Null queries always measure 0 ms, the null backend executes no GPU work. */
+float     gfxTimestampQueryGetDuration(GfxContext gfx, GfxTimestampQuery timestamp_query);
+GfxResult gfxCommandBeginTimestampQuery(GfxContext gfx, GfxTimestampQuery timestamp_query);
+GfxResult gfxCommandEndTimestampQuery(GfxContext gfx, GfxTimestampQuery timestamp_query);
+
+// Raytracing
+GfxAccelerationStructure gfxCreateAccelerationStructure(GfxContext gfx);
+/** Also destroys the raytracing primitives created on the acceleration structure, as gfx does. */
+GfxResult gfxDestroyAccelerationStructure(GfxContext gfx, GfxAccelerationStructure acceleration_structure);
+GfxResult gfxAccelerationStructureUpdate(GfxContext gfx, GfxAccelerationStructure acceleration_structure);
+uint64_t  gfxAccelerationStructureGetDataSize(GfxContext gfx, GfxAccelerationStructure acceleration_structure);
+GfxRaytracingPrimitive const *gfxAccelerationStructureGetRaytracingPrimitives(
+    GfxContext gfx, GfxAccelerationStructure acceleration_structure);
+uint32_t gfxAccelerationStructureGetRaytracingPrimitiveCount(
+    GfxContext gfx, GfxAccelerationStructure acceleration_structure);
+GfxRaytracingPrimitive gfxCreateRaytracingPrimitive(
+    GfxContext gfx, GfxAccelerationStructure acceleration_structure);
+GfxResult gfxDestroyRaytracingPrimitive(GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive);
+GfxResult gfxRaytracingPrimitiveBuild(GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive,
+    GfxBuffer vertex_buffer, uint32_t vertex_stride = 0, uint32_t build_flags = 0);
+GfxResult gfxRaytracingPrimitiveBuild(GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive,
+    GfxBuffer index_buffer, GfxBuffer vertex_buffer, uint32_t vertex_stride = 0, uint32_t build_flags = 0);
+GfxResult gfxRaytracingPrimitiveSetTransform(
+    GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive, float const *row_major_4x4_transform);
+GfxResult gfxRaytracingPrimitiveSetInstanceID(
+    GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive, uint32_t instance_id);
+GfxResult gfxRaytracingPrimitiveSetInstanceContributionToHitGroupIndex(
+    GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive, uint32_t instance_contribution_to_hit_group_index);
+uint64_t  gfxRaytracingPrimitiveGetDataSize(GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive);
+GfxResult gfxRaytracingPrimitiveUpdate(GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive);
+GfxResult gfxRaytracingPrimitiveUpdate(GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive,
+    GfxBuffer vertex_buffer, uint32_t vertex_stride = 0);
+GfxResult gfxRaytracingPrimitiveUpdate(GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive,
+    GfxBuffer index_buffer, GfxBuffer vertex_buffer, uint32_t vertex_stride = 0);
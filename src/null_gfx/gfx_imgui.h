@@ -0,0 +1,123 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+// ImGui integration of the null gfx backend (see gfx.h). The host targets have no user interface, so this declares
+// the subset of ImGui used by Capsaicin as no-ops: widgets are never open nor edited and the current context is
+// only stored, which lets the user interface code build unchanged and be skipped at runtime.
+
+#include "gfx.h"
+
+#include <cstdint>
+
+struct ImGuiContext;
+
+struct ImVec2
+{
+    float x = 0.0f;
+    float y = 0.0f;
+
+    constexpr ImVec2() = default;
+    constexpr ImVec2(float x_, float y_)
+        : x(x_)
+        , y(y_)
+    {}
+};
+
+enum ImGuiTreeNodeFlags_
+{
+    ImGuiTreeNodeFlags_None             = 0,
+    ImGuiTreeNodeFlags_NoTreePushOnOpen = 1 << 3,
+    ImGuiTreeNodeFlags_DefaultOpen      = 1 << 5,
+    ImGuiTreeNodeFlags_Leaf             = 1 << 8
+};
+using ImGuiTreeNodeFlags = int;
+
+namespace ImGui
+{
+inline ImGuiContext *&CurrentContext()
+{
+    static ImGuiContext *context = nullptr;
+    return context;
+}
+
+inline ImGuiContext *GetCurrentContext()
+{
+    return CurrentContext();
+}
+
+inline void SetCurrentContext(ImGuiContext *context)
+{
+    CurrentContext() = context;
+}
+
+inline void Text(char const *, ...) {}
+
+inline void Separator() {}
+
+inline void SameLine(float = 0.0f, float = -1.0f) {}
+
+inline void PushID(char const *) {}
+
+inline void PopID() {}
+
+inline bool CollapsingHeader(char const *, ImGuiTreeNodeFlags = 0)
+{
+    return false;
+}
+
+inline bool TreeNode(char const *)
+{
+    return false;
+}
+
+inline bool TreeNodeEx(char const *, ImGuiTreeNodeFlags, char const *, ...)
+{
+    return false;
+}
+
+inline bool TreeNodeEx(void const *, ImGuiTreeNodeFlags, char const *, ...)
+{
+    return false;
+}
+
+inline void TreePop() {}
+
+inline bool Checkbox(char const *, bool *)
+{
+    return false;
+}
+
+inline bool DragInt(char const *, int *, float = 1.0f, int = 0, int = 0, char const * = "%d", int = 0)
+{
+    return false;
+}
+
+inline bool DragFloat(char const *, float *, float = 1.0f, float = 0.0f, float = 0.0f, char const * = "%.3f", int = 0)
+{
+    return false;
+}
+
+inline void PlotLines(char const *, float (*)(void *, int), void *, int, int = 0, char const * = nullptr,
+    float = 0.0f, float = 0.0f, ImVec2 = ImVec2(0.0f, 0.0f), int = sizeof(float))
+{}
+} // namespace ImGui
@@ -0,0 +1,1214 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "gfx.h"
+#include "gfx_scene.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+/** Gives the null backend access to the internals of the gfx objects. */
+class GfxNullInternal
+{
+public:
+    /** Kind of a non-buffer object. */
+    enum class Kind : uint8_t
+    {
+        Texture,
+        Program,
+        Kernel,
+        SamplerState,
+        TimestampQuery,
+        AccelerationStructure,
+        RaytracingPrimitive
+    };
+
+    /** A buffer, ranges share the memory of the buffer they were created from. */
+    struct Buffer
+    {
+        std::shared_ptr<std::vector<uint8_t>> memory;
+        uint64_t                              offset = 0;
+        uint64_t                              size   = 0;
+        bool                                  range  = false;
+    };
+
+    /** A raytracing primitive and the acceleration structure it belongs to. */
+    struct RaytracingPrimitive
+    {
+        uint64_t acceleration_structure = 0;
+        uint64_t data_size              = 0; /**< Size of the geometry of the last build */
+    };
+
+    /** The state of a null context. */
+    struct Context
+    {
+        std::mutex                                                        mutex;
+        uint32_t                                                          width             = 0;
+        uint32_t                                                          height            = 0;
+        uint32_t                                                          back_buffer_index = 0;
+        uint64_t                                                          next_handle       = 1;
+        std::unordered_map<uint64_t, Buffer>                              buffers;
+        std::unordered_map<uint64_t, Kind>                                objects;
+        std::unordered_map<uint64_t, RaytracingPrimitive>                 raytracing_primitives;
+        std::unordered_map<uint64_t, std::vector<GfxRaytracingPrimitive>> acceleration_structures;
+        GfxNullStatistics                                                 statistics;
+    };
+
+    /** The objects of one type in a null scene, kept dense with stable handles as in gfx. */
+    template<typename TYPE>
+    struct ObjectStore
+    {
+        std::vector<TYPE>        objects;      /**< The live objects */
+        std::vector<uint32_t>    handles;      /**< Handle of each live object */
+        std::vector<uint32_t>    indices;      /**< Index of the object of each handle (kInvalidHandle if free) */
+        std::vector<GfxMetadata> metadata;     /**< Metadata of each handle */
+        std::vector<uint32_t>    free_handles; /**< Handles of the destroyed objects, reused first */
+    };
+
+    /** The state of a null scene. */
+    struct Scene
+    {
+        std::tuple<ObjectStore<GfxAnimation>, ObjectStore<GfxCamera>, ObjectStore<GfxImage>,
+            ObjectStore<GfxMaterial>, ObjectStore<GfxMesh>, ObjectStore<GfxInstance>, ObjectStore<GfxLight>>
+                 stores;
+        uint32_t active_camera = GfxConstRef<GfxCamera>::kInvalidHandle;
+    };
+
+    static inline GfxNullSceneImporter scene_importer = nullptr;
+
+    static Context *GetContext(GfxContext const &gfx) { return reinterpret_cast<Context *>(gfx.handle); }
+
+    static GfxContext MakeContext(Context *context)
+    {
+        GfxContext gfx;
+        gfx.handle = reinterpret_cast<uint64_t>(context);
+        return gfx;
+    }
+
+    static GfxBuffer MakeBuffer(Context &context, Buffer buffer, GfxCpuAccess cpu_access)
+    {
+        GfxBuffer gfx_buffer;
+        gfx_buffer.handle     = context.next_handle++;
+        gfx_buffer.size       = buffer.size;
+        gfx_buffer.cpu_access = cpu_access;
+        if (!buffer.range)
+        {
+            context.statistics.buffer_bytes += buffer.size;
+        }
+        ++context.statistics.buffer_count;
+        context.buffers.emplace(gfx_buffer.handle, std::move(buffer));
+        return gfx_buffer;
+    }
+
+    static Buffer *GetBuffer(Context &context, GfxBuffer const &buffer)
+    {
+        auto const it = context.buffers.find(buffer.handle);
+        return it != context.buffers.end() ? &it->second : nullptr;
+    }
+
+    static uint8_t *GetData(Buffer &buffer) { return buffer.memory->data() + buffer.offset; }
+
+    static Scene *GetScene(GfxScene const &scene) { return reinterpret_cast<Scene *>(scene.handle); }
+
+    static GfxScene MakeScene(Scene *null_scene)
+    {
+        GfxScene scene;
+        scene.handle = reinterpret_cast<uint64_t>(null_scene);
+        return scene;
+    }
+
+    template<typename TYPE>
+    static ObjectStore<TYPE> *GetStore(GfxScene const &scene)
+    {
+        Scene *null_scene = GetScene(scene);
+        return null_scene != nullptr ? &std::get<ObjectStore<TYPE>>(null_scene->stores) : nullptr;
+    }
+
+    template<typename TYPE>
+    static TYPE *GetObject(GfxScene const &scene, uint64_t object_handle)
+    {
+        ObjectStore<TYPE> *store = GetStore<TYPE>(scene);
+        if (store == nullptr || object_handle >= store->indices.size()
+            || store->indices[object_handle] == GfxConstRef<TYPE>::kInvalidHandle)
+        {
+            return nullptr;
+        }
+        return &store->objects[store->indices[object_handle]];
+    }
+
+    template<typename TYPE>
+    static GfxRef<TYPE> CreateObject(GfxScene const &scene)
+    {
+        ObjectStore<TYPE> *store = GetStore<TYPE>(scene);
+        if (store == nullptr)
+        {
+            return {};
+        }
+        uint32_t handle = (uint32_t)store->indices.size();
+        if (!store->free_handles.empty())
+        {
+            handle = store->free_handles.back();
+            store->free_handles.pop_back();
+        }
+        else
+        {
+            store->indices.push_back(GfxConstRef<TYPE>::kInvalidHandle);
+            store->metadata.emplace_back();
+        }
+        store->indices[handle] = (uint32_t)store->objects.size();
+        store->objects.emplace_back();
+        store->handles.push_back(handle);
+        return GfxRef<TYPE>(scene, handle);
+    }
+
+    template<typename TYPE>
+    static GfxResult DestroyObject(GfxScene const &scene, uint64_t object_handle)
+    {
+        ObjectStore<TYPE> *store = GetStore<TYPE>(scene);
+        if (GetObject<TYPE>(scene, object_handle) == nullptr)
+        {
+            return store != nullptr ? kGfxResult_NoError : kGfxResult_InvalidParameter;
+        }
+        // Move the last object into the freed slot so that the objects remain dense
+        uint32_t const index = store->indices[object_handle];
+        uint32_t const last  = (uint32_t)store->objects.size() - 1;
+        if (index != last)
+        {
+            store->objects[index]                 = std::move(store->objects[last]);
+            store->handles[index]                 = store->handles[last];
+            store->indices[store->handles[index]] = index;
+        }
+        store->objects.pop_back();
+        store->handles.pop_back();
+        store->indices[object_handle]  = GfxConstRef<TYPE>::kInvalidHandle;
+        store->metadata[object_handle] = GfxMetadata();
+        store->free_handles.push_back((uint32_t)object_handle);
+        return kGfxResult_NoError;
+    }
+
+    template<typename TYPE>
+    static GfxRef<TYPE> GetObjectHandle(GfxScene const &scene, uint32_t object_index)
+    {
+        ObjectStore<TYPE> *store = GetStore<TYPE>(scene);
+        if (store == nullptr || object_index >= store->handles.size())
+        {
+            return {};
+        }
+        return GfxRef<TYPE>(scene, store->handles[object_index]);
+    }
+
+    template<typename TYPE>
+    static GfxMetadata const &GetObjectMetadata(GfxScene const &scene, uint64_t object_handle)
+    {
+        static GfxMetadata const invalid_metadata;
+        if (GetObject<TYPE>(scene, object_handle) == nullptr)
+        {
+            return invalid_metadata;
+        }
+        return GetStore<TYPE>(scene)->metadata[object_handle];
+    }
+
+    template<typename TYPE>
+    static GfxResult SetObjectMetadata(GfxScene const &scene, uint64_t object_handle, GfxMetadata const &metadata)
+    {
+        if (GetObject<TYPE>(scene, object_handle) == nullptr)
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        GfxMetadata &object_metadata = GetStore<TYPE>(scene)->metadata[object_handle];
+        object_metadata              = metadata;
+        object_metadata.is_valid     = true;
+        return kGfxResult_NoError;
+    }
+
+    template<typename TYPE>
+    static GfxRef<TYPE> FindObjectByAssetFile(GfxScene const &scene, char const *asset_file)
+    {
+        ObjectStore<TYPE> *store = GetStore<TYPE>(scene);
+        if (store == nullptr || asset_file == nullptr)
+        {
+            return {};
+        }
+        for (uint32_t handle : store->handles)
+        {
+            if (store->metadata[handle].asset_file == asset_file)
+            {
+                return GfxRef<TYPE>(scene, handle);
+            }
+        }
+        return {};
+    }
+
+    template<typename OBJECT>
+    static OBJECT MakeObject(Context &context, Kind kind)
+    {
+        OBJECT object;
+        object.handle = context.next_handle++;
+        context.objects.emplace(object.handle, kind);
+        switch (kind)
+        {
+        case Kind::Texture: ++context.statistics.texture_count; break;
+        case Kind::Kernel: ++context.statistics.kernel_count; break;
+        case Kind::RaytracingPrimitive: ++context.statistics.raytracing_primitive_count; break;
+        default: break;
+        }
+        return object;
+    }
+
+    static GfxResult DestroyObject(GfxContext const &gfx, GfxNullObject const &object, Kind kind)
+    {
+        Context *context = GetContext(gfx);
+        if (context == nullptr)
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        if (!object)
+        {
+            return kGfxResult_NoError; // destroying an invalid object is allowed
+        }
+        std::lock_guard<std::mutex> lock(context->mutex);
+        auto const                  it = context->objects.find(object.getHandle());
+        if (it == context->objects.end() || it->second != kind)
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        context->objects.erase(it);
+        switch (kind)
+        {
+        case Kind::Texture: --context->statistics.texture_count; break;
+        case Kind::Kernel: --context->statistics.kernel_count; break;
+        case Kind::RaytracingPrimitive: --context->statistics.raytracing_primitive_count; break;
+        default: break;
+        }
+        return kGfxResult_NoError;
+    }
+
+    static GfxTexture MakeTexture(GfxContext const &gfx, GfxTexture::Type type, uint32_t width, uint32_t height,
+        uint32_t depth, DXGI_FORMAT format, uint32_t mip_levels)
+    {
+        Context *context = GetContext(gfx);
+        if (context == nullptr)
+        {
+            return {};
+        }
+        std::lock_guard<std::mutex> lock(context->mutex);
+        GfxTexture                  texture = MakeObject<GfxTexture>(*context, Kind::Texture);
+        texture.type                        = type;
+        texture.width                       = std::max(width, 1u);
+        texture.height                      = std::max(height, 1u);
+        texture.depth                       = std::max(depth, 1u);
+        texture.format                      = format;
+        texture.mip_levels                  = std::max(mip_levels, 1u);
+        return texture;
+    }
+
+    static GfxKernel MakeKernel(GfxContext const &gfx, GfxProgram const &program, GfxKernel::Type type)
+    {
+        Context *context = GetContext(gfx);
+        if (context == nullptr || !program)
+        {
+            return {};
+        }
+        std::lock_guard<std::mutex> lock(context->mutex);
+        GfxKernel                   kernel = MakeObject<GfxKernel>(*context, Kind::Kernel);
+        kernel.type                        = type;
+        return kernel;
+    }
+
+    /** Run an operation on a context under its lock. */
+    template<typename FUNCTION>
+    static GfxResult Update(GfxContext const &gfx, FUNCTION const &function)
+    {
+        Context *context = GetContext(gfx);
+        if (context == nullptr)
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        std::lock_guard<std::mutex> lock(context->mutex);
+        return function(*context);
+    }
+};
+
+using Kind = GfxNullInternal::Kind;
+
+void GfxNullObject::setName(char const *object_name)
+{
+    if (object_name == nullptr)
+    {
+        name[0] = '\0';
+        return;
+    }
+    strncpy(name, object_name, kGfxConstant_MaxNameLength - 1);
+    name[kGfxConstant_MaxNameLength - 1] = '\0';
+}
+
+GfxContext gfxCreateContext(uint32_t width, uint32_t height, GfxCreateContextFlags)
+{
+    auto *context   = new GfxNullInternal::Context;
+    context->width  = width;
+    context->height = height;
+    return GfxNullInternal::MakeContext(context);
+}
+
+GfxResult gfxDestroyContext(GfxContext context)
+{
+    delete GfxNullInternal::GetContext(context);
+    return kGfxResult_NoError;
+}
+
+uint32_t gfxGetBackBufferWidth(GfxContext context)
+{
+    GfxNullInternal::Context const *null_context = GfxNullInternal::GetContext(context);
+    return null_context != nullptr ? null_context->width : 0;
+}
+
+uint32_t gfxGetBackBufferHeight(GfxContext context)
+{
+    GfxNullInternal::Context const *null_context = GfxNullInternal::GetContext(context);
+    return null_context != nullptr ? null_context->height : 0;
+}
+
+uint32_t gfxGetBackBufferIndex(GfxContext context)
+{
+    GfxNullInternal::Context const *null_context = GfxNullInternal::GetContext(context);
+    return null_context != nullptr ? null_context->back_buffer_index : 0;
+}
+
+uint32_t gfxGetBackBufferCount(GfxContext)
+{
+    return kGfxConstant_BackBufferCount;
+}
+
+GfxResult gfxFrame(GfxContext context, bool)
+{
+    return GfxNullInternal::Update(context, [](GfxNullInternal::Context &null_context) {
+        null_context.back_buffer_index = (null_context.back_buffer_index + 1) % kGfxConstant_BackBufferCount;
+        ++null_context.statistics.frame_count;
+        return kGfxResult_NoError;
+    });
+}
+
+GfxResult gfxFinish(GfxContext context)
+{
+    return GfxNullInternal::GetContext(context) != nullptr ? kGfxResult_NoError : kGfxResult_InvalidParameter;
+}
+
+GfxNullStatistics gfxNullGetStatistics(GfxContext context)
+{
+    GfxNullStatistics statistics;
+    GfxNullInternal::Update(context, [&](GfxNullInternal::Context &null_context) {
+        statistics = null_context.statistics;
+        return kGfxResult_NoError;
+    });
+    return statistics;
+}
+
+GfxBuffer gfxCreateBuffer(GfxContext gfx, uint64_t size, void const *data, GfxCpuAccess cpu_access)
+{
+    GfxBuffer buffer;
+    GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        GfxNullInternal::Buffer null_buffer;
+        null_buffer.memory = std::make_shared<std::vector<uint8_t>>(size);
+        null_buffer.size   = size;
+        if (data != nullptr && size > 0)
+        {
+            memcpy(null_buffer.memory->data(), data, size);
+        }
+        buffer = GfxNullInternal::MakeBuffer(context, std::move(null_buffer), cpu_access);
+        return kGfxResult_NoError;
+    });
+    return buffer;
+}
+
+GfxBuffer gfxCreateBufferRange(GfxContext gfx, GfxBuffer buffer, uint64_t byte_offset, uint64_t size)
+{
+    GfxBuffer buffer_range;
+    GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        GfxNullInternal::Buffer const *null_buffer = GfxNullInternal::GetBuffer(context, buffer);
+        if (null_buffer == nullptr || byte_offset > null_buffer->size)
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        GfxNullInternal::Buffer range;
+        range.memory = null_buffer->memory;
+        range.offset = null_buffer->offset + byte_offset;
+        range.size   = (size == 0 ? null_buffer->size - byte_offset : size);
+        range.range  = true;
+        if (byte_offset + range.size > null_buffer->size)
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        buffer_range = GfxNullInternal::MakeBuffer(context, std::move(range), buffer.getCpuAccess());
+        buffer_range.setStride(buffer.getStride());
+        return kGfxResult_NoError;
+    });
+    return buffer_range;
+}
+
+GfxResult gfxDestroyBuffer(GfxContext gfx, GfxBuffer buffer)
+{
+    if (!buffer)
+    {
+        return kGfxResult_NoError;
+    }
+    return GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        GfxNullInternal::Buffer const *null_buffer = GfxNullInternal::GetBuffer(context, buffer);
+        if (null_buffer == nullptr)
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        if (!null_buffer->range)
+        {
+            context.statistics.buffer_bytes -= null_buffer->size;
+        }
+        --context.statistics.buffer_count;
+        context.buffers.erase(buffer.getHandle());
+        return kGfxResult_NoError;
+    });
+}
+
+void *gfxBufferGetData(GfxContext gfx, GfxBuffer buffer)
+{
+    void *data = nullptr;
+    GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        GfxNullInternal::Buffer *null_buffer = GfxNullInternal::GetBuffer(context, buffer);
+        if (null_buffer == nullptr || buffer.getCpuAccess() == kGfxCpuAccess_None)
+        {
+            return kGfxResult_InvalidOperation;
+        }
+        data = GfxNullInternal::GetData(*null_buffer);
+        return kGfxResult_NoError;
+    });
+    return data;
+}
+
+GfxTexture gfxCreateTexture2D(GfxContext gfx, DXGI_FORMAT format)
+{
+    return GfxNullInternal::MakeTexture(
+        gfx, GfxTexture::kType_2D, gfxGetBackBufferWidth(gfx), gfxGetBackBufferHeight(gfx), 1, format, 1);
+}
+
+GfxTexture gfxCreateTexture2D(
+    GfxContext gfx, uint32_t width, uint32_t height, DXGI_FORMAT format, uint32_t mip_levels, float const *)
+{
+    return GfxNullInternal::MakeTexture(gfx, GfxTexture::kType_2D, width, height, 1, format, mip_levels);
+}
+
+GfxTexture gfxCreateTexture2DArray(GfxContext gfx, uint32_t width, uint32_t height, uint32_t slice_count,
+    DXGI_FORMAT format, uint32_t mip_levels, float const *)
+{
+    return GfxNullInternal::MakeTexture(
+        gfx, GfxTexture::kType_2DArray, width, height, slice_count, format, mip_levels);
+}
+
+GfxTexture gfxCreateTexture3D(GfxContext gfx, uint32_t width, uint32_t height, uint32_t depth, DXGI_FORMAT format,
+    uint32_t mip_levels, float const *)
+{
+    return GfxNullInternal::MakeTexture(gfx, GfxTexture::kType_3D, width, height, depth, format, mip_levels);
+}
+
+GfxTexture gfxCreateTextureCube(
+    GfxContext gfx, uint32_t size, DXGI_FORMAT format, uint32_t mip_levels, float const *)
+{
+    return GfxNullInternal::MakeTexture(gfx, GfxTexture::kType_Cube, size, size, 6, format, mip_levels);
+}
+
+GfxResult gfxDestroyTexture(GfxContext gfx, GfxTexture texture)
+{
+    return GfxNullInternal::DestroyObject(gfx, texture, Kind::Texture);
+}
+
+uint32_t gfxCalculateMipCount(uint32_t width, uint32_t height, uint32_t depth)
+{
+    uint32_t mip_count = 0;
+    for (uint32_t size = std::max(std::max(width, height), depth); size > 0; size >>= 1)
+    {
+        ++mip_count;
+    }
+    return std::max(mip_count, 1u);
+}
+
+GfxProgram gfxCreateProgram(GfxContext gfx, char const *, char const *, char const *, char const **, uint32_t)
+{
+    GfxProgram program;
+    GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        program = GfxNullInternal::MakeObject<GfxProgram>(context, Kind::Program);
+        return kGfxResult_NoError;
+    });
+    return program;
+}
+
+GfxProgram gfxCreateProgram(GfxContext gfx, GfxProgramDesc, char const *name, char const *, char const **, uint32_t)
+{
+    GfxProgram program = gfxCreateProgram(gfx, nullptr);
+    program.setName(name);
+    return program;
+}
+
+GfxResult gfxDestroyProgram(GfxContext gfx, GfxProgram program)
+{
+    return GfxNullInternal::DestroyObject(gfx, program, Kind::Program);
+}
+
+GfxKernel gfxCreateComputeKernel(GfxContext gfx, GfxProgram program, char const *, char const **, uint32_t)
+{
+    return GfxNullInternal::MakeKernel(gfx, program, GfxKernel::kType_Compute);
+}
+
+GfxKernel gfxCreateGraphicsKernel(GfxContext gfx, GfxProgram program, char const *, char const **, uint32_t)
+{
+    return GfxNullInternal::MakeKernel(gfx, program, GfxKernel::kType_Graphics);
+}
+
+GfxKernel gfxCreateGraphicsKernel(
+    GfxContext gfx, GfxProgram program, GfxDrawState, char const *, char const **, uint32_t)
+{
+    return GfxNullInternal::MakeKernel(gfx, program, GfxKernel::kType_Graphics);
+}
+
+GfxKernel gfxCreateRaytracingKernel(GfxContext gfx, GfxProgram program, char const **, uint32_t)
+{
+    return GfxNullInternal::MakeKernel(gfx, program, GfxKernel::kType_Raytracing);
+}
+
+GfxResult gfxDestroyKernel(GfxContext gfx, GfxKernel kernel)
+{
+    return GfxNullInternal::DestroyObject(gfx, kernel, Kind::Kernel);
+}
+
+uint32_t const *gfxKernelGetNumThreads(GfxContext, GfxKernel kernel)
+{
+    static uint32_t const compute_num_threads[] = {kGfxConstant_NumThreads, kGfxConstant_NumThreads, 1};
+    static uint32_t const no_num_threads[]      = {1, 1, 1};
+    return kernel.isCompute() ? compute_num_threads : no_num_threads;
+}
+
+GfxResult gfxDrawStateSetColorTarget(GfxDrawState, uint32_t, GfxTexture texture, uint32_t, uint32_t)
+{
+    return texture ? kGfxResult_NoError : kGfxResult_InvalidParameter;
+}
+
+GfxSamplerState gfxCreateSamplerState(GfxContext gfx, D3D12_FILTER, D3D12_TEXTURE_ADDRESS_MODE,
+    D3D12_TEXTURE_ADDRESS_MODE, D3D12_TEXTURE_ADDRESS_MODE, float, float, float)
+{
+    GfxSamplerState sampler_state;
+    GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        sampler_state = GfxNullInternal::MakeObject<GfxSamplerState>(context, Kind::SamplerState);
+        return kGfxResult_NoError;
+    });
+    return sampler_state;
+}
+
+GfxSamplerState gfxCreateSamplerState(GfxContext gfx, D3D12_FILTER filter, D3D12_COMPARISON_FUNC,
+    D3D12_TEXTURE_ADDRESS_MODE address_u, D3D12_TEXTURE_ADDRESS_MODE address_v,
+    D3D12_TEXTURE_ADDRESS_MODE address_w, float mip_lod_bias, float min_lod, float max_lod)
+{
+    return gfxCreateSamplerState(gfx, filter, address_u, address_v, address_w, mip_lod_bias, min_lod, max_lod);
+}
+
+GfxResult gfxDestroySamplerState(GfxContext gfx, GfxSamplerState sampler_state)
+{
+    return GfxNullInternal::DestroyObject(gfx, sampler_state, Kind::SamplerState);
+}
+
+GfxResult gfxCommandBindKernel(GfxContext gfx, GfxKernel kernel)
+{
+    return GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        auto const it = context.objects.find(kernel.getHandle());
+        return it != context.objects.end() && it->second == Kind::Kernel ? kGfxResult_NoError
+                                                                          : kGfxResult_InvalidParameter;
+    });
+}
+
+GfxResult gfxCommandDispatch(GfxContext gfx, uint32_t num_groups_x, uint32_t num_groups_y, uint32_t num_groups_z)
+{
+    return GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        ++context.statistics.dispatch_count;
+        context.statistics.dispatch_group_count += (uint64_t)num_groups_x * num_groups_y * num_groups_z;
+        return kGfxResult_NoError;
+    });
+}
+
+GfxResult gfxCommandDispatchIndirect(GfxContext gfx, GfxBuffer)
+{
+    return GfxNullInternal::Update(gfx, [](GfxNullInternal::Context &context) {
+        ++context.statistics.dispatch_count;
+        return kGfxResult_NoError;
+    });
+}
+
+GfxResult gfxCommandDispatchRays(GfxContext gfx, GfxSbt, uint32_t, uint32_t, uint32_t)
+{
+    return GfxNullInternal::Update(gfx, [](GfxNullInternal::Context &context) {
+        ++context.statistics.dispatch_rays_count;
+        return kGfxResult_NoError;
+    });
+}
+
+GfxResult gfxCommandDispatchRaysIndirect(GfxContext gfx, GfxSbt, GfxBuffer)
+{
+    return GfxNullInternal::Update(gfx, [](GfxNullInternal::Context &context) {
+        ++context.statistics.dispatch_rays_count;
+        return kGfxResult_NoError;
+    });
+}
+
+GfxResult gfxCommandDraw(GfxContext gfx, uint32_t, uint32_t, uint32_t, uint32_t)
+{
+    return GfxNullInternal::Update(gfx, [](GfxNullInternal::Context &context) {
+        ++context.statistics.draw_count;
+        return kGfxResult_NoError;
+    });
+}
+
+GfxResult gfxCommandDrawIndexed(GfxContext gfx, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t)
+{
+    return GfxNullInternal::Update(gfx, [](GfxNullInternal::Context &context) {
+        ++context.statistics.draw_count;
+        return kGfxResult_NoError;
+    });
+}
+
+GfxResult gfxCommandCopyBuffer(GfxContext gfx, GfxBuffer dst, GfxBuffer src)
+{
+    return gfxCommandCopyBuffer(gfx, dst, 0, src, 0, std::min(dst.getSize(), src.getSize()));
+}
+
+GfxResult gfxCommandCopyBuffer(
+    GfxContext gfx, GfxBuffer dst, uint64_t dst_offset, GfxBuffer src, uint64_t src_offset, uint64_t size)
+{
+    return GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        GfxNullInternal::Buffer *dst_buffer = GfxNullInternal::GetBuffer(context, dst);
+        GfxNullInternal::Buffer *src_buffer = GfxNullInternal::GetBuffer(context, src);
+        if (dst_buffer == nullptr || src_buffer == nullptr || dst_offset + size > dst_buffer->size
+            || src_offset + size > src_buffer->size)
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        // Buffers live in host memory so copies are executed straight away, results can be read back at once
+        memmove(GfxNullInternal::GetData(*dst_buffer) + dst_offset, GfxNullInternal::GetData(*src_buffer) + src_offset,
+            size);
+        ++context.statistics.copy_count;
+        context.statistics.copy_bytes += size;
+        return kGfxResult_NoError;
+    });
+}
+
+GfxResult gfxCommandCopyTexture(GfxContext gfx, GfxTexture, GfxTexture)
+{
+    return GfxNullInternal::Update(gfx, [](GfxNullInternal::Context &context) {
+        ++context.statistics.copy_count;
+        return kGfxResult_NoError;
+    });
+}
+
+GfxResult gfxCommandCopyBufferToTexture(GfxContext gfx, GfxTexture dst, GfxBuffer src)
+{
+    return GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        if (GfxNullInternal::GetBuffer(context, src) == nullptr || context.objects.count(dst.getHandle()) == 0)
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        ++context.statistics.copy_count;
+        context.statistics.copy_bytes += src.getSize();
+        return kGfxResult_NoError;
+    });
+}
+
+GfxResult gfxCommandClearBuffer(GfxContext gfx, GfxBuffer buffer, uint32_t clear_value)
+{
+    return GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        GfxNullInternal::Buffer *null_buffer = GfxNullInternal::GetBuffer(context, buffer);
+        if (null_buffer == nullptr)
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        uint8_t *data = GfxNullInternal::GetData(*null_buffer);
+        for (uint64_t offset = 0; offset + sizeof(uint32_t) <= null_buffer->size; offset += sizeof(uint32_t))
+        {
+            memcpy(data + offset, &clear_value, sizeof(uint32_t));
+        }
+        return kGfxResult_NoError;
+    });
+}
+
+GfxResult gfxCommandClearTexture(GfxContext gfx, GfxTexture)
+{
+    return gfxFinish(gfx);
+}
+
+GfxResult gfxCommandGenerateMips(GfxContext gfx, GfxTexture)
+{
+    return gfxFinish(gfx);
+}
+
+GfxResult gfxCommandClearBackBuffer(GfxContext gfx)
+{
+    return gfxFinish(gfx);
+}
+
+GfxResult gfxCommandBindIndexBuffer(GfxContext gfx, GfxBuffer index_buffer)
+{
+    return GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        return !index_buffer || GfxNullInternal::GetBuffer(context, index_buffer) != nullptr
+                 ? kGfxResult_NoError
+                 : kGfxResult_InvalidParameter;
+    });
+}
+
+GfxResult gfxCommandBindVertexBuffer(GfxContext gfx, GfxBuffer vertex_buffer)
+{
+    return gfxCommandBindIndexBuffer(gfx, vertex_buffer);
+}
+
+GfxResult gfxCommandMultiDrawIndexedIndirect(GfxContext gfx, GfxBuffer, uint32_t args_count)
+{
+    return GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        context.statistics.draw_count += args_count;
+        return kGfxResult_NoError;
+    });
+}
+
+GfxResult gfxCommandScanSum(GfxContext gfx, GfxDataType, GfxBuffer, GfxBuffer, GfxBuffer const *)
+{
+    return GfxNullInternal::Update(gfx, [](GfxNullInternal::Context &context) {
+        ++context.statistics.dispatch_count;
+        return kGfxResult_NoError;
+    });
+}
+
+GfxResult gfxCommandBeginEvent(GfxContext gfx, char const *, ...)
+{
+    return GfxNullInternal::Update(gfx, [](GfxNullInternal::Context &context) {
+        ++context.statistics.event_count;
+        return kGfxResult_NoError;
+    });
+}
+
+GfxResult gfxCommandEndEvent(GfxContext gfx)
+{
+    return gfxFinish(gfx);
+}
+
+GfxTimestampQuery gfxCreateTimestampQuery(GfxContext gfx)
+{
+    GfxTimestampQuery timestamp_query;
+    GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        timestamp_query = GfxNullInternal::MakeObject<GfxTimestampQuery>(context, Kind::TimestampQuery);
+        return kGfxResult_NoError;
+    });
+    return timestamp_query;
+}
+
+GfxResult gfxDestroyTimestampQuery(GfxContext gfx, GfxTimestampQuery timestamp_query)
+{
+    return GfxNullInternal::DestroyObject(gfx, timestamp_query, Kind::TimestampQuery);
+}
+
+float gfxTimestampQueryGetDuration(GfxContext, GfxTimestampQuery)
+{
+    return 0.0f;
+}
+
+GfxResult gfxCommandBeginTimestampQuery(GfxContext gfx, GfxTimestampQuery)
+{
+    return gfxFinish(gfx);
+}
+
+GfxResult gfxCommandEndTimestampQuery(GfxContext gfx, GfxTimestampQuery)
+{
+    return gfxFinish(gfx);
+}
+
+GfxAccelerationStructure gfxCreateAccelerationStructure(GfxContext gfx)
+{
+    GfxAccelerationStructure acceleration_structure;
+    GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        acceleration_structure =
+            GfxNullInternal::MakeObject<GfxAccelerationStructure>(context, Kind::AccelerationStructure);
+        context.acceleration_structures[acceleration_structure.getHandle()];
+        return kGfxResult_NoError;
+    });
+    return acceleration_structure;
+}
+
+GfxResult gfxDestroyAccelerationStructure(GfxContext gfx, GfxAccelerationStructure acceleration_structure)
+{
+    // As in gfx the raytracing primitives are owned by their acceleration structure and released with it
+    std::vector<GfxRaytracingPrimitive> raytracing_primitives;
+    GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        auto const it = context.acceleration_structures.find(acceleration_structure.getHandle());
+        if (it != context.acceleration_structures.end())
+        {
+            raytracing_primitives = std::move(it->second);
+            context.acceleration_structures.erase(it);
+        }
+        return kGfxResult_NoError;
+    });
+    for (GfxRaytracingPrimitive const &raytracing_primitive : raytracing_primitives)
+    {
+        gfxDestroyRaytracingPrimitive(gfx, raytracing_primitive);
+    }
+    return GfxNullInternal::DestroyObject(gfx, acceleration_structure, Kind::AccelerationStructure);
+}
+
+GfxResult gfxAccelerationStructureUpdate(GfxContext gfx, GfxAccelerationStructure)
+{
+    return GfxNullInternal::Update(gfx, [](GfxNullInternal::Context &context) {
+        ++context.statistics.acceleration_update_count;
+        return kGfxResult_NoError;
+    });
+}
+
+uint64_t gfxAccelerationStructureGetDataSize(GfxContext, GfxAccelerationStructure)
+{
+    return 0; // the null primitives are not gathered into an instance structure
+}
+
+GfxRaytracingPrimitive const *gfxAccelerationStructureGetRaytracingPrimitives(
+    GfxContext gfx, GfxAccelerationStructure acceleration_structure)
+{
+    GfxRaytracingPrimitive const *raytracing_primitives = nullptr;
+    GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        auto const it = context.acceleration_structures.find(acceleration_structure.getHandle());
+        if (it == context.acceleration_structures.end())
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        raytracing_primitives = it->second.data();
+        return kGfxResult_NoError;
+    });
+    return raytracing_primitives;
+}
+
+uint32_t gfxAccelerationStructureGetRaytracingPrimitiveCount(
+    GfxContext gfx, GfxAccelerationStructure acceleration_structure)
+{
+    uint32_t raytracing_primitive_count = 0;
+    GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        auto const it = context.acceleration_structures.find(acceleration_structure.getHandle());
+        if (it == context.acceleration_structures.end())
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        raytracing_primitive_count = (uint32_t)it->second.size();
+        return kGfxResult_NoError;
+    });
+    return raytracing_primitive_count;
+}
+
+GfxRaytracingPrimitive gfxCreateRaytracingPrimitive(GfxContext gfx, GfxAccelerationStructure acceleration_structure)
+{
+    GfxRaytracingPrimitive raytracing_primitive;
+    GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        auto const it = context.acceleration_structures.find(acceleration_structure.getHandle());
+        if (it == context.acceleration_structures.end())
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        raytracing_primitive =
+            GfxNullInternal::MakeObject<GfxRaytracingPrimitive>(context, Kind::RaytracingPrimitive);
+        context.raytracing_primitives[raytracing_primitive.getHandle()].acceleration_structure =
+            acceleration_structure.getHandle();
+        it->second.push_back(raytracing_primitive);
+        return kGfxResult_NoError;
+    });
+    return raytracing_primitive;
+}
+
+GfxResult gfxDestroyRaytracingPrimitive(GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive)
+{
+    GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        auto const it = context.raytracing_primitives.find(raytracing_primitive.getHandle());
+        if (it == context.raytracing_primitives.end())
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        auto const owner = context.acceleration_structures.find(it->second.acceleration_structure);
+        if (owner != context.acceleration_structures.end())
+        {
+            std::erase(owner->second, raytracing_primitive);
+        }
+        context.raytracing_primitives.erase(it);
+        return kGfxResult_NoError;
+    });
+    return GfxNullInternal::DestroyObject(gfx, raytracing_primitive, Kind::RaytracingPrimitive);
+}
+
+namespace
+{
+/**
+ * Count a raytracing primitive build or update.
+ * @param gfx                  The null context.
+ * @param raytracing_primitive The primitive.
+ * @param index_buffer         The index buffer (invalid if not indexed or if the geometry is unchanged).
+ * @param vertex_buffer        The vertex buffer (invalid if the geometry is unchanged).
+ * @returns The result.
+ */
+GfxResult BuildRaytracingPrimitive(GfxContext const &gfx, GfxRaytracingPrimitive const &raytracing_primitive,
+    GfxBuffer const &index_buffer = {}, GfxBuffer const &vertex_buffer = {})
+{
+    return GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        auto const it = context.raytracing_primitives.find(raytracing_primitive.getHandle());
+        if (it == context.raytracing_primitives.end())
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        if (vertex_buffer)
+        {
+            it->second.data_size = index_buffer.getSize() + vertex_buffer.getSize();
+        }
+        ++context.statistics.raytracing_build_count;
+        return kGfxResult_NoError;
+    });
+}
+} // unnamed namespace
+
+GfxResult gfxRaytracingPrimitiveBuild(
+    GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive, GfxBuffer vertex_buffer, uint32_t, uint32_t)
+{
+    return BuildRaytracingPrimitive(gfx, raytracing_primitive, {}, vertex_buffer);
+}
+
+GfxResult gfxRaytracingPrimitiveBuild(GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive,
+    GfxBuffer index_buffer, GfxBuffer vertex_buffer, uint32_t, uint32_t)
+{
+    return BuildRaytracingPrimitive(gfx, raytracing_primitive, index_buffer, vertex_buffer);
+}
+
+GfxResult gfxRaytracingPrimitiveSetTransform(GfxContext gfx, GfxRaytracingPrimitive, float const *)
+{
+    return gfxFinish(gfx);
+}
+
+GfxResult gfxRaytracingPrimitiveSetInstanceID(GfxContext gfx, GfxRaytracingPrimitive, uint32_t)
+{
+    return gfxFinish(gfx);
+}
+
+GfxResult gfxRaytracingPrimitiveSetInstanceContributionToHitGroupIndex(
+    GfxContext gfx, GfxRaytracingPrimitive, uint32_t)
+{
+    return gfxFinish(gfx);
+}
+
+uint64_t gfxRaytracingPrimitiveGetDataSize(GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive)
+{
+    uint64_t data_size = 0;
+    GfxNullInternal::Update(gfx, [&](GfxNullInternal::Context &context) {
+        auto const it = context.raytracing_primitives.find(raytracing_primitive.getHandle());
+        if (it == context.raytracing_primitives.end())
+        {
+            return kGfxResult_InvalidParameter;
+        }
+        data_size = it->second.data_size;
+        return kGfxResult_NoError;
+    });
+    return data_size;
+}
+
+GfxResult gfxRaytracingPrimitiveUpdate(GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive)
+{
+    return BuildRaytracingPrimitive(gfx, raytracing_primitive);
+}
+
+GfxResult gfxRaytracingPrimitiveUpdate(
+    GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive, GfxBuffer vertex_buffer, uint32_t)
+{
+    return BuildRaytracingPrimitive(gfx, raytracing_primitive, {}, vertex_buffer);
+}
+
+GfxResult gfxRaytracingPrimitiveUpdate(GfxContext gfx, GfxRaytracingPrimitive raytracing_primitive,
+    GfxBuffer index_buffer, GfxBuffer vertex_buffer, uint32_t)
+{
+    return BuildRaytracingPrimitive(gfx, raytracing_primitive, index_buffer, vertex_buffer);
+}
+
+GfxScene gfxCreateScene()
+{
+    return GfxNullInternal::MakeScene(new GfxNullInternal::Scene);
+}
+
+GfxResult gfxDestroyScene(GfxScene scene)
+{
+    delete GfxNullInternal::GetScene(scene);
+    return kGfxResult_NoError;
+}
+
+GfxResult gfxSceneClear(GfxScene scene)
+{
+    GfxNullInternal::Scene *null_scene = GfxNullInternal::GetScene(scene);
+    if (null_scene == nullptr)
+    {
+        return kGfxResult_InvalidParameter;
+    }
+    *null_scene = GfxNullInternal::Scene();
+    return kGfxResult_NoError;
+}
+
+GfxResult gfxSceneImport(GfxScene scene, char const *asset_file)
+{
+    if (GfxNullInternal::GetScene(scene) == nullptr || asset_file == nullptr)
+    {
+        return kGfxResult_InvalidParameter;
+    }
+    if (GfxNullInternal::scene_importer == nullptr)
+    {
+        GFX_PRINT_ERROR(kGfxResult_InvalidOperation, "No importer was installed to import `%s'", asset_file);
+        return kGfxResult_InvalidOperation;
+    }
+    return GfxNullInternal::scene_importer(scene, asset_file);
+}
+
+void gfxNullSetSceneImporter(GfxNullSceneImporter importer)
+{
+    GfxNullInternal::scene_importer = importer;
+}
+
+GfxResult gfxSceneApplyAnimation(GfxScene scene, uint64_t animation_handle, float time_in_seconds)
+{
+    GfxAnimation const *animation = gfxSceneGetObject<GfxAnimation>(scene, animation_handle);
+    if (animation == nullptr)
+    {
+        return kGfxResult_InvalidParameter;
+    }
+    for (GfxAnimation::Channel const &channel : animation->channels)
+    {
+        GfxInstance *instance = gfxSceneGetObject<GfxInstance>(scene, (uint32_t)channel.instance);
+        if (instance == nullptr || channel.times.empty() || channel.times.size() != channel.transforms.size())
+        {
+            continue;
+        }
+        // Find the key frames around the time and interpolate in between
+        size_t const next =
+            std::upper_bound(channel.times.begin(), channel.times.end(), time_in_seconds) - channel.times.begin();
+        if (next == 0 || next == channel.times.size())
+        {
+            instance->transform = channel.transforms[next == 0 ? 0 : next - 1];
+            continue;
+        }
+        float const span     = channel.times[next] - channel.times[next - 1];
+        float const weight   = span > 0.0f ? (time_in_seconds - channel.times[next - 1]) / span : 0.0f;
+        instance->transform = channel.transforms[next - 1] * (1.0f - weight) + channel.transforms[next] * weight;
+    }
+    return kGfxResult_NoError;
+}
+
+float gfxSceneGetAnimationLength(GfxScene scene, uint64_t animation_handle)
+{
+    GfxAnimation const *animation = gfxSceneGetObject<GfxAnimation>(scene, animation_handle);
+    float               length    = 0.0f;
+    if (animation != nullptr)
+    {
+        for (GfxAnimation::Channel const &channel : animation->channels)
+        {
+            length = channel.times.empty() ? length : std::max(length, channel.times.back());
+        }
+    }
+    return length;
+}
+
+GfxResult gfxSceneSetActiveCamera(GfxScene scene, uint64_t camera_handle)
+{
+    if (gfxSceneGetObject<GfxCamera>(scene, camera_handle) == nullptr)
+    {
+        return kGfxResult_InvalidParameter;
+    }
+    GfxNullInternal::GetScene(scene)->active_camera = (uint32_t)camera_handle;
+    return kGfxResult_NoError;
+}
+
+GfxRef<GfxCamera> gfxSceneGetActiveCamera(GfxScene scene)
+{
+    GfxNullInternal::Scene const *null_scene = GfxNullInternal::GetScene(scene);
+    if (null_scene == nullptr || gfxSceneGetObject<GfxCamera>(scene, null_scene->active_camera) == nullptr)
+    {
+        return {};
+    }
+    return GfxRef<GfxCamera>(scene, null_scene->active_camera);
+}
+
+#define GFX_NULL_SCENE_OBJECT(TYPE)                                                                    \
+    template<>                                                                                         \
+    TYPE *gfxSceneGetObject<TYPE>(GfxScene scene, uint64_t object_handle)                              \
+    {                                                                                                  \
+        return GfxNullInternal::GetObject<TYPE>(scene, object_handle);                                 \
+    }                                                                                                  \
+    template<>                                                                                         \
+    GfxRef<TYPE> gfxSceneCreateObject<TYPE>(GfxScene scene)                                            \
+    {                                                                                                  \
+        return GfxNullInternal::CreateObject<TYPE>(scene);                                             \
+    }                                                                                                  \
+    template<>                                                                                         \
+    GfxResult gfxSceneDestroyObject<TYPE>(GfxScene scene, uint64_t object_handle)                      \
+    {                                                                                                  \
+        return GfxNullInternal::DestroyObject<TYPE>(scene, object_handle);                             \
+    }                                                                                                  \
+    template<>                                                                                         \
+    uint32_t gfxSceneGetObjectCount<TYPE>(GfxScene scene)                                              \
+    {                                                                                                  \
+        GfxNullInternal::ObjectStore<TYPE> const *store = GfxNullInternal::GetStore<TYPE>(scene);      \
+        return store != nullptr ? (uint32_t)store->objects.size() : 0;                                 \
+    }                                                                                                  \
+    template<>                                                                                         \
+    TYPE *gfxSceneGetObjects<TYPE>(GfxScene scene)                                                     \
+    {                                                                                                  \
+        GfxNullInternal::ObjectStore<TYPE> *store = GfxNullInternal::GetStore<TYPE>(scene);            \
+        return store != nullptr ? store->objects.data() : nullptr;                                     \
+    }                                                                                                  \
+    template<>                                                                                         \
+    GfxRef<TYPE> gfxSceneGetObjectHandle<TYPE>(GfxScene scene, uint32_t object_index)                  \
+    {                                                                                                  \
+        return GfxNullInternal::GetObjectHandle<TYPE>(scene, object_index);                            \
+    }                                                                                                  \
+    template<>                                                                                         \
+    GfxMetadata const &gfxSceneGetObjectMetadata<TYPE>(GfxScene scene, uint64_t object_handle)         \
+    {                                                                                                  \
+        return GfxNullInternal::GetObjectMetadata<TYPE>(scene, object_handle);                         \
+    }                                                                                                  \
+    template<>                                                                                         \
+    GfxResult gfxSceneSetObjectMetadata<TYPE>(                                                         \
+        GfxScene scene, uint64_t object_handle, GfxMetadata const &metadata)                           \
+    {                                                                                                  \
+        return GfxNullInternal::SetObjectMetadata<TYPE>(scene, object_handle, metadata);               \
+    }                                                                                                  \
+    template<>                                                                                         \
+    GfxRef<TYPE> gfxSceneFindObjectByAssetFile<TYPE>(GfxScene scene, char const *asset_file)           \
+    {                                                                                                  \
+        return GfxNullInternal::FindObjectByAssetFile<TYPE>(scene, asset_file);                        \
+    }
+GFX_NULL_SCENE_OBJECT(GfxAnimation)
+GFX_NULL_SCENE_OBJECT(GfxCamera)
+GFX_NULL_SCENE_OBJECT(GfxImage)
+GFX_NULL_SCENE_OBJECT(GfxMaterial)
+GFX_NULL_SCENE_OBJECT(GfxMesh)
+GFX_NULL_SCENE_OBJECT(GfxInstance)
+GFX_NULL_SCENE_OBJECT(GfxLight)
+#undef GFX_NULL_SCENE_OBJECT
@@ -0,0 +1,346 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+// Scene types of the null gfx backend (see gfx.h). Scenes are in-memory databases with the gfx object types and
+// handles, so that the Capsaicin scene code runs unchanged on the host. Assets are not parsed, instead gfxSceneImport()
+// forwards to an importer that the host targets install to build their scenes in code (see gfxNullSetSceneImporter()).
+
+#include "gfx.h"
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+class GfxScene : public GfxNullObject
+{
+    friend class GfxNullInternal;
+};
+
+template<typename TYPE>
+TYPE *gfxSceneGetObject(GfxScene scene, uint64_t object_handle);
+
+/** A read-only reference to a scene object, the handle remains stable for the lifetime of the object. */
+template<typename TYPE>
+class GfxConstRef
+{
+public:
+    static constexpr uint32_t kInvalidHandle = 0xFFFFFFFFu;
+
+    GfxConstRef() = default;
+    GfxConstRef(GfxScene const &object_scene, uint32_t object_handle)
+        : scene(object_scene)
+        , handle(object_handle)
+    {}
+
+    inline bool operator==(GfxConstRef const &other) const { return scene == other.scene && handle == other.handle; }
+    inline bool operator!=(GfxConstRef const &other) const { return !(*this == other); }
+    inline explicit operator bool() const { return gfxSceneGetObject<TYPE>(scene, handle) != nullptr; }
+
+    /** Gets the stable handle of the object (kInvalidHandle if invalid). */
+    inline operator uint32_t() const { return handle; }
+
+    inline TYPE const *operator->() const { return gfxSceneGetObject<TYPE>(scene, handle); }
+    inline TYPE const &operator*() const { return *gfxSceneGetObject<TYPE>(scene, handle); }
+
+    /** Gets the index of the object in the array returned by gfxSceneGetObjects(). */
+    uint32_t getIndex() const;
+
+protected:
+    GfxScene scene;
+    uint32_t handle = kInvalidHandle;
+};
+
+/** A reference to a scene object. */
+template<typename TYPE>
+class GfxRef : public GfxConstRef<TYPE>
+{
+public:
+    using GfxConstRef<TYPE>::GfxConstRef;
+
+    inline TYPE *operator->() const { return gfxSceneGetObject<TYPE>(this->scene, this->handle); }
+    inline TYPE &operator*() const { return *gfxSceneGetObject<TYPE>(this->scene, this->handle); }
+};
+
+class GfxMetadata
+{
+public:
+    inline bool        isValid() const { return is_valid; }
+    inline char const *getAssetFile() const { return asset_file.c_str(); }
+    inline char const *getObjectName() const { return object_name.c_str(); }
+
+    bool        is_valid = false;
+    std::string asset_file;
+    std::string object_name;
+};
+
+enum GfxCameraType
+{
+    kGfxCameraType_Perspective = 0,
+
+    kGfxCameraType_Count
+};
+
+struct GfxCamera
+{
+    GfxCameraType type   = kGfxCameraType_Perspective;
+    glm::vec3     eye    = glm::vec3(0.0f, 0.0f, 0.0f);
+    glm::vec3     center = glm::vec3(0.0f, 0.0f, -1.0f);
+    glm::vec3     up     = glm::vec3(0.0f, 1.0f, 0.0f);
+    float         aspect = 1.0f;
+    float         fovY   = 1.04719755f;
+    float         nearZ  = 0.1f;
+    float         farZ   = 1e4f;
+};
+
+enum GfxImageFlag
+{
+    kGfxImageFlag_HasAlphaChannel = 1 << 0,
+    kGfxImageFlag_HasMipLevels    = 1 << 1
+};
+using GfxImageFlags = uint32_t;
+
+struct GfxImage
+{
+    uint32_t             width             = 0;
+    uint32_t             height            = 0;
+    DXGI_FORMAT          format            = DXGI_FORMAT_UNKNOWN;
+    uint32_t             channel_count     = 0;
+    uint32_t             bytes_per_channel = 0;
+    GfxImageFlags        flags             = 0;
+    std::vector<uint8_t> data;
+};
+
+enum GfxMaterialFlag
+{
+    kGfxMaterialFlag_DoubleSided = 1 << 0
+};
+using GfxMaterialFlags = uint32_t;
+
+struct GfxMaterial
+{
+    glm::vec4        albedo      = glm::vec4(1.0f);
+    float            roughness   = 1.0f;
+    float            metallicity = 0.0f;
+    glm::vec3        emissivity  = glm::vec3(0.0f);
+    GfxMaterialFlags flags       = 0;
+
+    GfxConstRef<GfxImage> albedo_map;
+    GfxConstRef<GfxImage> roughness_map;
+    GfxConstRef<GfxImage> metallicity_map;
+    GfxConstRef<GfxImage> emissivity_map;
+    GfxConstRef<GfxImage> normal_map;
+};
+
+/**
+ * Check whether a material emits light.
+ * @param material The material.
+ * @returns True if emissive.
+ */
+inline bool gfxMaterialIsEmissive(GfxMaterial const &material)
+{
+    return material.emissivity.x > 0.0f || material.emissivity.y > 0.0f || material.emissivity.z > 0.0f;
+}
+
+struct GfxVertex
+{
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::vec3 normal   = glm::vec3(0.0f);
+    glm::vec2 uv       = glm::vec2(0.0f);
+};
+
+struct GfxMesh
+{
+    GfxConstRef<GfxMaterial> default_material;
+
+    glm::vec3 bounds_min = glm::vec3(0.0f);
+    glm::vec3 bounds_max = glm::vec3(0.0f);
+
+    std::vector<GfxVertex> vertices;
+    std::vector<uint32_t>  indices;
+};
+
+struct GfxInstance
+{
+    GfxConstRef<GfxMesh>     mesh;
+    GfxConstRef<GfxMaterial> material;
+    glm::mat4                transform = glm::mat4(1.0f);
+};
+
+enum GfxLightType
+{
+    kGfxLightType_Point = 0,
+    kGfxLightType_Spot,
+    kGfxLightType_Directional,
+
+    kGfxLightType_Count
+};
+
+struct GfxLight
+{
+    GfxLightType type             = kGfxLightType_Point;
+    glm::vec3    color            = glm::vec3(1.0f);
+    float        intensity        = 1.0f;
+    glm::vec3    position         = glm::vec3(0.0f);
+    glm::vec3    direction        = glm::vec3(0.0f, 0.0f, -1.0f);
+    float        range            = 1e4f;
+    float        inner_cone_angle = 0.0f;
+    float        outer_cone_angle = 0.78539816f;
+};
+
+/**
+ * An animation of the null backend, made of key frames of instance transforms (gfx animations are imported from
+ * assets, which the null backend doesn't parse). Transforms are linearly interpolated between key frames.
+ */
+struct GfxAnimation
+{
+    struct Channel
+    {
+        GfxConstRef<GfxInstance> instance;
+        std::vector<float>       times;      /**< Key frame times (in seconds, increasing) */
+        std::vector<glm::mat4>   transforms; /**< Instance transform at each key frame */
+    };
+
+    std::vector<Channel> channels;
+};
+
+/**
+ * Check whether an image holds block compressed data.
+ * @param image The image.
+ * @returns True if compressed.
+ */
+inline bool gfxImageIsFormatCompressed(GfxImage const &image)
+{
+    return image.format >= DXGI_FORMAT_BC1_TYPELESS && image.format <= DXGI_FORMAT_BC7_UNORM_SRGB
+        && !(image.format >= DXGI_FORMAT_B5G6R5_UNORM && image.format <= DXGI_FORMAT_B8G8R8X8_UNORM_SRGB);
+}
+
+// Scenes
+GfxScene  gfxCreateScene();
+GfxResult gfxDestroyScene(GfxScene scene);
+GfxResult gfxSceneClear(GfxScene scene);
+
+/**
+ * Imports an asset file into a scene by calling the importer installed with gfxNullSetSceneImporter().
+ * @param scene      The scene to import into.
+ * @param asset_file The asset file.
+ * @returns The result of the importer (kGfxResult_InvalidOperation if none was installed).
+ */
+GfxResult gfxSceneImport(GfxScene scene, char const *asset_file);
+
+/** The importer called by gfxSceneImport() to add the objects of an asset file to a scene. */
+using GfxNullSceneImporter = GfxResult (*)(GfxScene scene, char const *asset_file);
+
+/**
+ * Installs the importer called by gfxSceneImport().
+ * @param importer The importer (nullptr to fail all imports).
+ */
+void gfxNullSetSceneImporter(GfxNullSceneImporter importer);
+
+GfxResult         gfxSceneApplyAnimation(GfxScene scene, uint64_t animation_handle, float time_in_seconds);
+float             gfxSceneGetAnimationLength(GfxScene scene, uint64_t animation_handle);
+GfxResult         gfxSceneSetActiveCamera(GfxScene scene, uint64_t camera_handle);
+GfxRef<GfxCamera> gfxSceneGetActiveCamera(GfxScene scene);
+
+// Scene objects, each type also has the named wrappers of gfx below (e.g., gfxSceneCreateMesh())
+template<typename TYPE>
+GfxRef<TYPE> gfxSceneCreateObject(GfxScene scene);
+template<typename TYPE>
+GfxResult gfxSceneDestroyObject(GfxScene scene, uint64_t object_handle);
+template<typename TYPE>
+uint32_t gfxSceneGetObjectCount(GfxScene scene);
+template<typename TYPE>
+TYPE *gfxSceneGetObjects(GfxScene scene);
+template<typename TYPE>
+GfxRef<TYPE> gfxSceneGetObjectHandle(GfxScene scene, uint32_t object_index);
+template<typename TYPE>
+GfxMetadata const &gfxSceneGetObjectMetadata(GfxScene scene, uint64_t object_handle);
+template<typename TYPE>
+GfxResult gfxSceneSetObjectMetadata(GfxScene scene, uint64_t object_handle, GfxMetadata const &metadata);
+template<typename TYPE>
+GfxRef<TYPE> gfxSceneFindObjectByAssetFile(GfxScene scene, char const *asset_file);
+
+#define GFX_NULL_SCENE_OBJECT(TYPE, NAME)                                                                       \
+    template<>                                                                                                  \
+    TYPE *gfxSceneGetObject<TYPE>(GfxScene scene, uint64_t object_handle);                                      \
+    template<>                                                                                                  \
+    GfxRef<TYPE> gfxSceneCreateObject<TYPE>(GfxScene scene);                                                    \
+    template<>                                                                                                  \
+    GfxResult gfxSceneDestroyObject<TYPE>(GfxScene scene, uint64_t object_handle);                              \
+    template<>                                                                                                  \
+    uint32_t gfxSceneGetObjectCount<TYPE>(GfxScene scene);                                                      \
+    template<>                                                                                                  \
+    TYPE *gfxSceneGetObjects<TYPE>(GfxScene scene);                                                             \
+    template<>                                                                                                  \
+    GfxRef<TYPE> gfxSceneGetObjectHandle<TYPE>(GfxScene scene, uint32_t object_index);                          \
+    template<>                                                                                                  \
+    GfxMetadata const &gfxSceneGetObjectMetadata<TYPE>(GfxScene scene, uint64_t object_handle);                 \
+    template<>                                                                                                  \
+    GfxResult gfxSceneSetObjectMetadata<TYPE>(GfxScene scene, uint64_t object_handle, GfxMetadata const &);     \
+    template<>                                                                                                  \
+    GfxRef<TYPE> gfxSceneFindObjectByAssetFile<TYPE>(GfxScene scene, char const *asset_file);                   \
+    template<>                                                                                                  \
+    inline uint32_t GfxConstRef<TYPE>::getIndex() const                                                         \
+    {                                                                                                           \
+        uint32_t const count = gfxSceneGetObjectCount<TYPE>(scene);                                             \
+        for (uint32_t i = 0; i < count; ++i)                                                                    \
+        {                                                                                                       \
+            if ((uint32_t)gfxSceneGetObjectHandle<TYPE>(scene, i) == handle) return i;                         \
+        }                                                                                                       \
+        return kInvalidHandle;                                                                                  \
+    }                                                                                                           \
+    inline GfxRef<TYPE> gfxSceneCreate##NAME(GfxScene scene)                                                    \
+    {                                                                                                           \
+        return gfxSceneCreateObject<TYPE>(scene);                                                               \
+    }                                                                                                           \
+    inline GfxResult gfxSceneDestroy##NAME(GfxScene scene, uint64_t object_handle)                              \
+    {                                                                                                           \
+        return gfxSceneDestroyObject<TYPE>(scene, object_handle);                                               \
+    }                                                                                                           \
+    inline uint32_t gfxSceneGet##NAME##Count(GfxScene scene)                                                    \
+    {                                                                                                           \
+        return gfxSceneGetObjectCount<TYPE>(scene);                                                             \
+    }                                                                                                           \
+    inline TYPE *gfxSceneGet##NAME##s(GfxScene scene)                                                           \
+    {                                                                                                           \
+        return gfxSceneGetObjects<TYPE>(scene);                                                                 \
+    }                                                                                                           \
+    inline GfxRef<TYPE> gfxSceneGet##NAME##Handle(GfxScene scene, uint32_t object_index)                        \
+    {                                                                                                           \
+        return gfxSceneGetObjectHandle<TYPE>(scene, object_index);                                              \
+    }                                                                                                           \
+    inline GfxMetadata const &gfxSceneGet##NAME##Metadata(GfxScene scene, uint64_t object_handle)               \
+    {                                                                                                           \
+        return gfxSceneGetObjectMetadata<TYPE>(scene, object_handle);                                           \
+    }                                                                                                           \
+    inline GfxResult gfxSceneSet##NAME##Metadata(GfxScene scene, uint64_t object_handle, GfxMetadata const &m)  \
+    {                                                                                                           \
+        return gfxSceneSetObjectMetadata<TYPE>(scene, object_handle, m);                                        \
+    }
+GFX_NULL_SCENE_OBJECT(GfxAnimation, Animation)
+GFX_NULL_SCENE_OBJECT(GfxCamera, Camera)
+GFX_NULL_SCENE_OBJECT(GfxImage, Image)
+GFX_NULL_SCENE_OBJECT(GfxMaterial, Material)
+GFX_NULL_SCENE_OBJECT(GfxMesh, Mesh)
+GFX_NULL_SCENE_OBJECT(GfxInstance, Instance)
+GFX_NULL_SCENE_OBJECT(GfxLight, Light)
+#undef GFX_NULL_SCENE_OBJECT
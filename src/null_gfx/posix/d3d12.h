@@ -0,0 +1,79 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+// Subset of the Windows SDK Direct3D 12 declarations, only used on platforms without the Windows SDK so that the
+// host targets can build the Capsaicin sources referring to <d3d12.h> (sampler descriptions and indirect arguments).
+
+#include <cstdint>
+
+#include <dxgiformat.h>
+
+#define D3D12_REQ_MIP_LEVELS 15
+
+enum D3D12_FILTER
+{
+    D3D12_FILTER_MIN_MAG_MIP_POINT             = 0,
+    D3D12_FILTER_MIN_MAG_MIP_LINEAR            = 0x15,
+    D3D12_FILTER_ANISOTROPIC                   = 0x55,
+    D3D12_FILTER_COMPARISON_MIN_MAG_MIP_POINT  = 0x80,
+    D3D12_FILTER_COMPARISON_MIN_MAG_MIP_LINEAR = 0x95,
+    D3D12_FILTER_MINIMUM_MIN_MAG_MIP_POINT     = 0x100,
+    D3D12_FILTER_MAXIMUM_MIN_MAG_MIP_POINT     = 0x180
+};
+
+enum D3D12_TEXTURE_ADDRESS_MODE
+{
+    D3D12_TEXTURE_ADDRESS_MODE_WRAP        = 1,
+    D3D12_TEXTURE_ADDRESS_MODE_MIRROR      = 2,
+    D3D12_TEXTURE_ADDRESS_MODE_CLAMP       = 3,
+    D3D12_TEXTURE_ADDRESS_MODE_BORDER      = 4,
+    D3D12_TEXTURE_ADDRESS_MODE_MIRROR_ONCE = 5
+};
+
+enum D3D12_COMPARISON_FUNC
+{
+    D3D12_COMPARISON_FUNC_NEVER         = 1,
+    D3D12_COMPARISON_FUNC_LESS          = 2,
+    D3D12_COMPARISON_FUNC_EQUAL         = 3,
+    D3D12_COMPARISON_FUNC_LESS_EQUAL    = 4,
+    D3D12_COMPARISON_FUNC_GREATER       = 5,
+    D3D12_COMPARISON_FUNC_NOT_EQUAL     = 6,
+    D3D12_COMPARISON_FUNC_GREATER_EQUAL = 7,
+    D3D12_COMPARISON_FUNC_ALWAYS        = 8
+};
+
+struct D3D12_DRAW_INDEXED_ARGUMENTS
+{
+    uint32_t IndexCountPerInstance;
+    uint32_t InstanceCount;
+    uint32_t StartIndexLocation;
+    int32_t  BaseVertexLocation;
+    uint32_t StartInstanceLocation;
+};
+
+struct D3D12_DISPATCH_ARGUMENTS
+{
+    uint32_t ThreadGroupCountX;
+    uint32_t ThreadGroupCountY;
+    uint32_t ThreadGroupCountZ;
+};
@@ -0,0 +1,312 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "benchmark_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+/** Welch t statistic above which a change of the mean is considered significant */
+constexpr double kSignificantT = 3.0;
+
+std::string Trim(std::string const &text) noexcept
+{
+    auto const first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos)
+    {
+        return {};
+    }
+    auto const last = text.find_last_not_of(" \t\r\n");
+    return text.substr(first, last - first + 1);
+}
+
+std::vector<std::string> Split(std::string const &text, char separator) noexcept
+{
+    std::vector<std::string> items;
+    if (Trim(text).empty())
+    {
+        return items;
+    }
+    size_t start = 0;
+    for (size_t end = text.find(separator); end != std::string::npos; end = text.find(separator, start))
+    {
+        items.push_back(Trim(text.substr(start, end - start)));
+        start = end + 1;
+    }
+    items.push_back(Trim(text.substr(start)));
+    return items;
+}
+
+/** Names are written to CSV cells so must not contain separators */
+std::string ToCell(std::string text) noexcept
+{
+    std::replace(text.begin(), text.end(), ',', ';');
+    return text;
+}
+
+bool IsSameCell(BenchmarkResult const &result, BenchmarkResult const &other) noexcept
+{
+    // Reports hold the names as written to the cells
+    return ToCell(result.timing.name) == ToCell(other.timing.name) && ToCell(result.scene) == ToCell(other.scene)
+        && ToCell(result.camera) == ToCell(other.camera) && ToCell(result.renderer) == ToCell(other.renderer)
+        && ToCell(result.optionSet) == ToCell(other.optionSet);
+}
+} // unnamed namespace
+
+bool BenchmarkMatrix::load(std::string const &filePath, std::string &error) noexcept
+{
+    std::ifstream file(filePath);
+    if (!file.is_open())
+    {
+        error = "Failed to open benchmark matrix file: " + filePath;
+        return false;
+    }
+    std::string line;
+    for (uint32_t lineNumber = 1; std::getline(file, line); ++lineNumber)
+    {
+        line = Trim(line);
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        auto const splitLoc = line.find('=');
+        if (splitLoc == std::string::npos)
+        {
+            error = filePath + '(' + std::to_string(lineNumber) + "): expected 'key = value'";
+            return false;
+        }
+        std::string const key   = Trim(line.substr(0, splitLoc));
+        std::string const value = Trim(line.substr(splitLoc + 1));
+        try
+        {
+            if (key == "scenes")
+            {
+                scenes = Split(value, ',');
+            }
+            else if (key == "cameras")
+            {
+                cameras = Split(value, ',');
+            }
+            else if (key == "renderers")
+            {
+                renderers = Split(value, ',');
+            }
+            else if (key == "options")
+            {
+                auto const nameLoc = value.find(':');
+                if (nameLoc == std::string::npos || Trim(value.substr(0, nameLoc)).empty())
+                {
+                    error = filePath + '(' + std::to_string(lineNumber)
+                          + "): expected 'options = name: option=value option=value'";
+                    return false;
+                }
+                BenchmarkOptionSet optionSet;
+                optionSet.name = ToCell(Trim(value.substr(0, nameLoc)));
+                std::stringstream options(value.substr(nameLoc + 1));
+                std::string       option;
+                while (options >> option)
+                {
+                    optionSet.options.push_back(option);
+                }
+                optionSets.push_back(std::move(optionSet));
+            }
+            else if (key == "warmup_frames")
+            {
+                warmupFrames = (uint32_t)std::stoul(value);
+            }
+            else if (key == "measure_frames")
+            {
+                measureFrames = (uint32_t)std::stoul(value);
+            }
+            else if (key == "regression_threshold")
+            {
+                regressionThreshold = std::stod(value);
+            }
+            else
+            {
+                error = filePath + '(' + std::to_string(lineNumber) + "): unknown key '" + key + "'";
+                return false;
+            }
+        }
+        catch (...)
+        {
+            error = filePath + '(' + std::to_string(lineNumber) + "): invalid value for '" + key + "'";
+            return false;
+        }
+    }
+
+    // Empty list items would silently benchmark nothing
+    auto const hasEmpty = [](std::vector<std::string> const &list) {
+        return std::any_of(list.cbegin(), list.cend(), [](std::string const &item) { return item.empty(); });
+    };
+    if (scenes.empty() || renderers.empty() || hasEmpty(scenes) || hasEmpty(cameras) || hasEmpty(renderers))
+    {
+        error = filePath + ": 'scenes' and 'renderers' must list at least one name and no list may have empty names";
+        return false;
+    }
+    if (measureFrames == 0)
+    {
+        error = filePath + ": 'measure_frames' must be greater than 0";
+        return false;
+    }
+    if (optionSets.empty())
+    {
+        optionSets.push_back({"Default", {}});
+    }
+    return true;
+}
+
+BenchmarkStatus CompareBenchmarkTimings(Capsaicin::TimingSummary const &timing,
+    Capsaicin::TimingSummary const &baseline, double threshold, double &change, double &t) noexcept
+{
+    change = (baseline.mean > 0.0 ? 100.0 * (timing.mean - baseline.mean) / baseline.mean : 0.0);
+    t      = 0.0;
+    if (timing.count < 2 || baseline.count < 2)
+    {
+        return BenchmarkStatus::Unchanged;
+    }
+
+    // Summaries store the population variance, the test needs the sample variance
+    double const variance         = timing.variance * timing.count / (timing.count - 1);
+    double const baselineVariance = baseline.variance * baseline.count / (baseline.count - 1);
+    double const standardError    = std::sqrt(variance / timing.count + baselineVariance / baseline.count);
+    double const difference       = timing.mean - baseline.mean;
+    if (standardError > 0.0)
+    {
+        t = difference / standardError;
+    }
+    else if (difference != 0.0)
+    {
+        t = std::copysign(INFINITY, difference);
+    }
+
+    if (change > threshold && t > kSignificantT)
+    {
+        return BenchmarkStatus::Regressed;
+    }
+    if (change < -threshold && t < -kSignificantT)
+    {
+        return BenchmarkStatus::Improved;
+    }
+    return BenchmarkStatus::Unchanged;
+}
+
+bool ReadBenchmarkReport(std::string const &filePath, std::vector<BenchmarkResult> &results) noexcept
+{
+    std::ifstream file(filePath);
+    std::string   line;
+    if (!file.is_open() || !std::getline(file, line))
+    {
+        return false;
+    }
+    results.clear();
+    while (std::getline(file, line))
+    {
+        auto const cells = Split(line, ',');
+        if (cells.size() < 13)
+        {
+            if (Trim(line).empty())
+            {
+                continue;
+            }
+            return false;
+        }
+        BenchmarkResult result;
+        result.scene       = cells[0];
+        result.camera      = cells[1];
+        result.renderer    = cells[2];
+        result.optionSet   = cells[3];
+        result.timing.name = cells[4];
+        try
+        {
+            result.timing.count    = (uint32_t)std::stoul(cells[5]);
+            result.timing.min      = std::stod(cells[6]);
+            result.timing.mean     = std::stod(cells[7]);
+            result.timing.p50      = std::stod(cells[8]);
+            result.timing.p95      = std::stod(cells[9]);
+            result.timing.p99      = std::stod(cells[10]);
+            result.timing.max      = std::stod(cells[11]);
+            result.timing.variance = std::stod(cells[12]);
+        }
+        catch (...)
+        {
+            return false;
+        }
+        results.push_back(std::move(result));
+    }
+    return true;
+}
+
+bool WriteBenchmarkReport(std::string const &filePath, std::vector<BenchmarkResult> const &results,
+    std::vector<BenchmarkResult> const &baseline, double threshold,
+    std::vector<BenchmarkResult> &regressions) noexcept
+{
+    std::ofstream file(filePath);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    file << "Scene,Camera,Renderer,Options,Section,Count,Min (ms),Mean (ms),P50 (ms),P95 (ms),P99 (ms),Max (ms),"
+            "Variance (ms^2)";
+    if (!baseline.empty())
+    {
+        file << ",Baseline Mean (ms),Change (%),Welch t,Status";
+    }
+    file << '\n';
+
+    regressions.clear();
+    char const *statusNames[] = {"New", "Unchanged", "Improved", "Regressed"};
+    for (auto const &result : results)
+    {
+        Capsaicin::TimingSummary const &timing = result.timing;
+        file << ToCell(result.scene) << ',' << ToCell(result.camera) << ',' << ToCell(result.renderer) << ','
+             << ToCell(result.optionSet) << ',' << ToCell(timing.name) << ',' << timing.count << ',' << timing.min
+             << ',' << timing.mean << ',' << timing.p50 << ',' << timing.p95 << ',' << timing.p99 << ','
+             << timing.max << ',' << timing.variance;
+        if (!baseline.empty())
+        {
+            auto const baselineResult = std::find_if(baseline.cbegin(), baseline.cend(),
+                [&result](BenchmarkResult const &other) { return IsSameCell(result, other); });
+            if (baselineResult == baseline.cend())
+            {
+                file << ",,,," << statusNames[(uint32_t)BenchmarkStatus::New];
+            }
+            else
+            {
+                double     change = 0.0;
+                double     t      = 0.0;
+                auto const status = CompareBenchmarkTimings(timing, baselineResult->timing, threshold, change, t);
+                file << ',' << baselineResult->timing.mean << ',' << change << ',' << t << ','
+                     << statusNames[(uint32_t)status];
+                if (status == BenchmarkStatus::Regressed)
+                {
+                    regressions.push_back(result);
+                }
+            }
+        }
+        file << '\n';
+    }
+    return file.good();
+}
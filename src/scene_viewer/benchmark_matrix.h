@@ -0,0 +1,120 @@
+/**********************************************************************
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <timing_summary.h>
+#include <vector>
+
+/** A named set of render options benchmarked together. */
+struct BenchmarkOptionSet
+{
+    std::string              name;    /**< Name of the set (used to identify it in reports) */
+    std::vector<std::string> options; /**< Render options in the form 'name=value' */
+};
+
+/**
+ * The scenes, cameras, renderers and render option sets benchmarked one after the other in a single run.
+ * @note Matrix files are made of 'key = value' lines, lists are separated by ',' and lines starting with '#' are
+ * comments. Each 'options' line adds an option set in the form 'name: option=value option=value':
+ *   scenes = Sponza, Gas Station
+ *   cameras = Camera0
+ *   renderers = GI-1.1, Path Tracer
+ *   options = Default:
+ *   options = HalfRes: gi10_hash_grid_cache_cell_size=64
+ *   warmup_frames = 16
+ *   measure_frames = 256
+ *   regression_threshold = 2.0
+ */
+struct BenchmarkMatrix
+{
+    std::vector<std::string>        scenes;                    /**< Names of the scenes */
+    std::vector<std::string>        cameras;                   /**< Names of the cameras (empty for defaults) */
+    std::vector<std::string>        renderers;                 /**< Names of the renderers */
+    std::vector<BenchmarkOptionSet> optionSets;                /**< Render option sets (a default set if none) */
+    uint32_t                        warmupFrames        = 16;  /**< Frames rendered before collecting timings */
+    uint32_t                        measureFrames       = 256; /**< Frames timings are collected over */
+    double                          regressionThreshold = 2.0; /**< Smallest slow down reported (in percent) */
+
+    /**
+     * Load a matrix file.
+     * @param filePath Path to the file.
+     * @param [out] error Description of the problem if failed.
+     * @return Boolean signaling if no error occurred.
+     */
+    [[nodiscard]] bool load(std::string const &filePath, std::string &error) noexcept;
+};
+
+/** Timing statistics of a section in a cell of the benchmark matrix. */
+struct BenchmarkResult
+{
+    std::string              scene;     /**< Name of the scene */
+    std::string              camera;    /**< Name of the camera */
+    std::string              renderer;  /**< Name of the renderer */
+    std::string              optionSet; /**< Name of the render option set */
+    Capsaicin::TimingSummary timing;    /**< Statistics of the section (in milliseconds) */
+};
+
+/** Outcome of comparing a result against its baseline. */
+enum class BenchmarkStatus : uint32_t
+{
+    New = 0,   /**< No baseline result */
+    Unchanged, /**< Difference is below the threshold or not statistically significant */
+    Improved,  /**< Significantly faster than the baseline */
+    Regressed, /**< Significantly slower than the baseline */
+};
+
+/**
+ * Compare a result against its baseline using Welch's t-test on the means.
+ * @note Frame timings are autocorrelated so the test is optimistic, a change must also exceed the threshold to be
+ * reported.
+ * @param timing    Statistics of the result.
+ * @param baseline  Statistics of the baseline.
+ * @param threshold The smallest change reported (in percent).
+ * @param [out] change Relative change of the mean (in percent).
+ * @param [out] t      The t statistic (positive when slower).
+ * @return The comparison outcome.
+ */
+BenchmarkStatus CompareBenchmarkTimings(Capsaicin::TimingSummary const &timing,
+    Capsaicin::TimingSummary const &baseline, double threshold, double &change, double &t) noexcept;
+
+/**
+ * Read a report previously written by WriteBenchmarkReport (e.g., to use it as a baseline).
+ * @param filePath Path to the CSV file.
+ * @param [out] results The results in the report.
+ * @return Boolean signaling if no error occurred.
+ */
+[[nodiscard]] bool ReadBenchmarkReport(std::string const &filePath, std::vector<BenchmarkResult> &results) noexcept;
+
+/**
+ * Write the results of a benchmark matrix to a CSV file, comparing each result against the baseline.
+ * @param filePath  Path to the CSV file.
+ * @param results   The results of the matrix.
+ * @param baseline  The baseline results (may be empty).
+ * @param threshold The smallest change reported (in percent).
+ * @param [out] regressions The results that regressed compared to the baseline.
+ * @return Boolean signaling if no error occurred.
+ */
+[[nodiscard]] bool WriteBenchmarkReport(std::string const &filePath, std::vector<BenchmarkResult> const &results,
+    std::vector<BenchmarkResult> const &baseline, double threshold,
+    std::vector<BenchmarkResult> &regressions) noexcept;
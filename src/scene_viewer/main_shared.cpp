@@ -23,6 +23,8 @@ THE SOFTWARE.
 #define _USE_MATH_DEFINES
 #include "main_shared.h"
 
+#include "benchmark_matrix.h"
+
 #include <CLI/CLI.hpp>
 #include <chrono>
 #include <cmath>
@@ -112,6 +114,17 @@ CapsaicinMain::CapsaicinMain(string_view &&programNameIn) noexcept
 
 CapsaicinMain::~CapsaicinMain() noexcept
 {
+    // Write out the gfx calls and CPU profile recorded over the whole run
+    if (!gfxRecordingFile.empty())
+    {
+        Capsaicin::StopGfxRecording(gfxRecordingFile.c_str());
+    }
+    if (!cpuProfileFile.empty())
+    {
+        Capsaicin::StopCpuProfiling(cpuProfileFile.c_str());
+    }
+    Capsaicin::StopCameraRecording();
+
     // Destroy Capsaicin context
     gfxImGuiTerminate();
     Capsaicin::Terminate();
@@ -134,6 +147,11 @@ bool CapsaicinMain::run() noexcept
         return false;
     }
 
+    if (!benchmarkMatrixFile.empty())
+    {
+        return runBenchmarkMatrix();
+    }
+
     // Render frames continuously
     while (true)
     {
@@ -157,6 +175,27 @@ bool CapsaicinMain::run() noexcept
         }
     }
 
+    if (benchmarkMode)
+    {
+        printString("Scene load time: "s + to_string(Capsaicin::GetSceneLoadTime() * 1000.0) + "ms ("s
+                    + (Capsaicin::GetSceneCacheHit() ? "scene cache hit)"s : "scene cache miss)"s));
+    }
+
+    if (benchmarkMode && !benchmarkTimingsFile.empty())
+    {
+        // Add the suffix to the file name, before its extension
+        std::filesystem::path timingsFile = benchmarkTimingsFile;
+        if (!benchmarkModeSuffix.empty())
+        {
+            timingsFile.replace_filename(timingsFile.stem().string() + '_' + benchmarkModeSuffix
+                                         + timingsFile.extension().string());
+        }
+        if (!Capsaicin::StopTimingStatistics(timingsFile.string().c_str()))
+        {
+            printString("Failed to write timing statistics file: "s + timingsFile.string(), MessageLevel::Warning);
+        }
+    }
+
     if (benchmarkMode && !benchmarkModeSuffix.empty() && Capsaicin::hasOption<bool>("image_metrics_enable")
         && Capsaicin::getOption<bool>("image_metrics_enable")
         && Capsaicin::getOption<bool>("image_metrics_save_to_file"))
@@ -348,6 +387,70 @@ bool CapsaicinMain::initialise() noexcept
         "--user-camera-lookat", cameraLookAt, "Set the initial look at position of the user camera");
     bool startPlaying = false;
     app.add_flag("--start-playing", startPlaying, "Start with any animations running");
+    bool compactVertices = false;
+    app.add_flag("--compact-vertices", compactVertices, "Use the compact (quantized) scene vertex layout");
+    bool optimizeMeshes = false;
+    app.add_flag("--optimize-meshes", optimizeMeshes,
+        "Weld and reorder scene meshes for vertex cache and fetch locality (cached next to the scene file)");
+    bool disableSceneCache = false;
+    app.add_flag("--disable-scene-cache", disableSceneCache,
+        "Always build the scene data from the scene files instead of using the binary scene cache");
+    uint32_t textureUploadBudget = 0;
+    app.add_option("--texture-upload-budget", textureUploadBudget,
+           "Stream scene textures in the background uploading at most this many MiB per frame (0 to disable)")
+        ->capture_default_str();
+    std::string textureMipFilter = "Box";
+    app.add_option("--texture-mip-filter", textureMipFilter, "Filter used to generate streamed texture mip levels")
+        ->capture_default_str()
+        ->check(CLI::IsMember({"Box", "Kaiser"}));
+    float animationSampleRate = 0.0f;
+    app.add_option("--animation-sample-rate", animationSampleRate,
+           "Bake scene animations at this many samples per second and evaluate them in Capsaicin (0 to disable)")
+        ->capture_default_str()
+        ->check(CLI::NonNegativeNumber);
+    uint32_t workerThreads = 0;
+    app.add_option("--worker-threads", workerThreads,
+           "Number of threads running the CPU side work, including the main thread (0 for all hardware threads)")
+        ->capture_default_str();
+    bool pinWorkerThreads = false;
+    app.add_flag("--pin-worker-threads", pinWorkerThreads, "Run each worker thread on its own logical processor");
+    bool transientAliasing = false;
+    app.add_flag("--alias-transient-resources", transientAliasing,
+        "Let AOVs and buffers only used during part of the frame share memory");
+    std::string dumpCompression = "PIZ";
+    app.add_option("--dump-compression", dumpCompression, "Compression of the EXR images saved when dumping frames")
+        ->capture_default_str()
+        ->check(CLI::IsMember({"None", "ZIP", "PIZ"}));
+    bool dumpHalf = false;
+    app.add_flag("--dump-half", dumpHalf, "Save dumped EXR images with half precision channels");
+    std::string captureFile;
+    app.add_option("--capture-frames", captureFile,
+        "Capture an AOV every frame into this frame sequence container (or to a command prefixed with '|')");
+    std::string captureAOV = "Color";
+    app.add_option("--capture-aov", captureAOV, "The AOV captured by '--capture-frames'")->capture_default_str();
+    uint32_t captureFirstFrame = 0;
+    app.add_option("--capture-first-frame", captureFirstFrame, "The first frame index captured by '--capture-frames'")
+        ->capture_default_str();
+    uint32_t captureFrameCount = 512;
+    app.add_option("--capture-frame-count", captureFrameCount, "The number of frames captured by '--capture-frames'")
+        ->capture_default_str()
+        ->check(CLI::PositiveNumber);
+    bool captureHalf = false;
+    app.add_flag("--capture-half", captureHalf, "Capture frames with half precision channels");
+    std::string cameraRecordingFile;
+    app.add_option("--record-camera", cameraRecordingFile,
+        "Record the camera state of every frame into this trajectory file (for use with '--replay-camera')");
+    std::string cameraReplayFile;
+    app.add_option("--replay-camera", cameraReplayFile,
+        "Drive the camera from this trajectory file using fixed frame rate playback");
+    app.add_option("--record-gfx", gfxRecordingFile,
+        "Record the gfx calls made each frame by each render technique and write them to this JSON file on exit");
+    app.add_option("--profile-cpu", cpuProfileFile,
+        "Profile the CPU and GPU time of each frame and write it to this Chrome trace JSON file on exit");
+    std::vector<uint32_t> buildCacheScenes;
+    app.add_option("--build-scene-caches", buildCacheScenes,
+           "Build the binary scene caches of the listed scene indexes and exit")
+        ->check(CLI::Range(0u, (uint32_t)scenes.size() - 1));
     auto bench = app.add_flag("--benchmark-mode", benchmarkMode, "Enable benchmarking mode");
     app.add_option(
            "--benchmark-frames", benchmarkModeFrameCount, "Number of frames to render during benchmark mode")
@@ -360,6 +463,23 @@ bool CapsaicinMain::initialise() noexcept
     app.add_option("--benchmark-suffix", benchmarkModeSuffix, "Suffix to add to any saved filenames")
         ->needs(bench)
         ->capture_default_str();
+    app.add_option("--benchmark-timings", benchmarkTimingsFile,
+           "Write the statistics of the scene load time, the CPU frame time and of each GPU timed section to this "
+           "CSV or JSON file")
+        ->needs(bench);
+    app.add_option("--benchmark-warmup-frames", benchmarkWarmupFrames,
+           "The number of frames rendered before collecting timings for '--benchmark-timings'")
+        ->needs(bench)
+        ->capture_default_str();
+
+    auto matrix = app.add_option("--benchmark-matrix", benchmarkMatrixFile,
+        "Benchmark every scene, camera, renderer and render option set listed in this file and exit");
+    app.add_option("--benchmark-baseline", benchmarkBaselineFile,
+           "Compare the '--benchmark-matrix' results against this report and fail on significant regressions")
+        ->needs(matrix);
+    app.add_option("--benchmark-report", benchmarkReportFile, "The report written by '--benchmark-matrix'")
+        ->needs(matrix)
+        ->capture_default_str();
 
     std::vector<std::string> renderOptions;
     app.add_option("--render-options", renderOptions, "Additional render options");
@@ -468,6 +588,26 @@ bool CapsaicinMain::initialise() noexcept
 
     // Create Capsaicin render context
     Capsaicin::Initialize(contextGFX, ImGui::GetCurrentContext());
+    if (workerThreads != 0 || pinWorkerThreads)
+    {
+        Capsaicin::SetThreadCount(workerThreads, pinWorkerThreads);
+    }
+    Capsaicin::SetCompactVertices(compactVertices);
+    Capsaicin::SetOptimizeMeshes(optimizeMeshes);
+    Capsaicin::SetSceneCacheEnabled(!disableSceneCache);
+    Capsaicin::SetTextureUploadBudget(textureUploadBudget);
+    Capsaicin::SetTextureMipFilter(textureMipFilter);
+    Capsaicin::SetAnimationSampleRate(animationSampleRate);
+    Capsaicin::SetTransientAliasing(transientAliasing);
+    Capsaicin::SetDumpFormat(dumpCompression, dumpHalf);
+    if (!gfxRecordingFile.empty())
+    {
+        Capsaicin::StartGfxRecording();
+    }
+    if (!cpuProfileFile.empty())
+    {
+        Capsaicin::StartCpuProfiling();
+    }
 
     // Initialise render settings
     if (!setRenderer(renderers[rendererSelect]))
@@ -476,92 +616,19 @@ bool CapsaicinMain::initialise() noexcept
     }
 
     // Pass any command line render options
-    if (!renderOptions.empty())
+    if (!setRenderOptions(renderOptions))
+    {
+        return false;
+    }
+
+    // Pre-build any requested scene caches instead of running
+    if (!buildCacheScenes.empty())
     {
-        auto &validOpts = Capsaicin::GetOptions();
-        for (auto const &opt : renderOptions)
+        if (!buildSceneCaches(buildCacheScenes))
         {
-            auto const splitLoc = opt.find('=');
-            if (splitLoc == std::string::npos)
-            {
-                printString("Invalid command line format of '--render-options'", MessageLevel::Error);
-                return false;
-            }
-            std::string option = opt.substr(0, splitLoc);
-            std::string value  = opt.substr(splitLoc + 1);
-            if (auto found = validOpts.find(option); found != validOpts.end())
-            {
-                if (std::holds_alternative<bool>(found->second))
-                {
-                    if (value == "true" || value == "1")
-                    {
-                        Capsaicin::setOption(option, true);
-                    }
-                    else if (value == "false" || value == "0")
-                    {
-                        Capsaicin::setOption(option, false);
-                    }
-                    else
-                    {
-                        printString("Invalid command line value passed for render option '" + option
-                                        + "' expected bool",
-                            MessageLevel::Error);
-                        return false;
-                    }
-                }
-                else if (std::holds_alternative<int32_t>(found->second))
-                {
-                    try
-                    {
-                        const int32_t newValue = std::stoi(value);
-                        Capsaicin::setOption(option, newValue);
-                    }
-                    catch (...)
-                    {
-                        printString("Invalid command line value passed for render option '" + option
-                                        + "' expected integer",
-                            MessageLevel::Error);
-                        return false;
-                    }
-                }
-                else if (std::holds_alternative<uint32_t>(found->second))
-                {
-                    try
-                    {
-                        const uint32_t newValue = std::stoul(value);
-                        Capsaicin::setOption(option, newValue);
-                    }
-                    catch (...)
-                    {
-                        printString("Invalid command line value passed for render option '" + option
-                                        + "' expected unsigned integer",
-                            MessageLevel::Error);
-                        return false;
-                    }
-                }
-                else if (std::holds_alternative<float>(found->second))
-                {
-                    try
-                    {
-                        float const newValue = std::stof(value);
-                        Capsaicin::setOption(option, newValue);
-                    }
-                    catch (...)
-                    {
-                        printString("Invalid command line value passed for render option '" + option
-                                        + "' expected float",
-                            MessageLevel::Error);
-                        return false;
-                    }
-                }
-            }
-            else
-            {
-                printString(
-                    "Invalid command line value passed for '--render-options': " + opt, MessageLevel::Error);
-                return false;
-            }
+            printString("Failed to build scene caches", MessageLevel::Error);
         }
+        return false;
     }
 
     // Load the requested start scene
@@ -653,6 +720,41 @@ bool CapsaicinMain::initialise() noexcept
         Capsaicin::SetPaused(false);
     }
 
+    if (benchmarkMode && !benchmarkTimingsFile.empty())
+    {
+        Capsaicin::StartTimingStatistics(benchmarkWarmupFrames);
+    }
+
+    if (!captureFile.empty())
+    {
+        Capsaicin::StartFrameCapture(
+            captureFile.c_str(), captureAOV, captureFirstFrame, captureFrameCount, captureHalf);
+    }
+
+    if (!cameraRecordingFile.empty() && !Capsaicin::StartCameraRecording(cameraRecordingFile.c_str()))
+    {
+        printString("Failed to create camera trajectory file: " + cameraRecordingFile, MessageLevel::Error);
+        return false;
+    }
+
+    if (!cameraReplayFile.empty())
+    {
+        // Replays are only reproducible with a fixed frame rate, the trajectory drives the user camera so that the
+        // scene cameras are left untouched
+        Capsaicin::SetFixedFrameRate(true);
+        if (Capsaicin::GetSceneCurrentCamera() != "User")
+        {
+            auto const oldCamera = *Capsaicin::GetSceneCamera();
+            Capsaicin::SetSceneCamera("User");
+            *Capsaicin::GetSceneCamera() = oldCamera;
+        }
+        if (!Capsaicin::StartCameraReplay(cameraReplayFile.c_str()))
+        {
+            printString("Failed to load camera trajectory file: " + cameraReplayFile, MessageLevel::Error);
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -699,6 +801,34 @@ bool CapsaicinMain::loadScene(Scene scene) noexcept
     return true;
 }
 
+bool CapsaicinMain::buildSceneCaches(std::vector<uint32_t> const &sceneIndices) noexcept
+{
+    for (auto const index : sceneIndices)
+    {
+        // The first load writes the cache if it is missing or stale, the second load then reads it back
+        double loadTimes[2] = {};
+        bool   cacheHits[2] = {};
+        for (uint32_t pass = 0; pass < 2; ++pass)
+        {
+            if (!loadScene(static_cast<Scene>(index)))
+            {
+                return false;
+            }
+            // Scene data is built during the first rendered frame
+            Capsaicin::Render();
+            gfxFrame(contextGFX);
+            loadTimes[pass] = Capsaicin::GetSceneLoadTime();
+            cacheHits[pass] = Capsaicin::GetSceneCacheHit();
+            // Unload the scene so that the next load is not skipped
+            Capsaicin::SetScenes({});
+        }
+        printString(scenes[index].name + ": load time "s + to_string(loadTimes[0] * 1000.0) + "ms ("s
+                    + (cacheHits[0] ? "cached"s : "uncached"s) + ") -> "s + to_string(loadTimes[1] * 1000.0)
+                    + "ms ("s + (cacheHits[1] ? "cached)"s : "uncached)"s));
+    }
+    return true;
+}
+
 void CapsaicinMain::setCamera(std::string_view camera) noexcept
 {
     // Set the camera to the currently requested camera index
@@ -770,6 +900,211 @@ bool CapsaicinMain::setRenderer(std::string_view renderer) noexcept
     return true;
 }
 
+bool CapsaicinMain::setRenderOptions(std::vector<std::string> const &options) noexcept
+{
+    auto &validOpts = Capsaicin::GetOptions();
+    for (auto const &opt : options)
+    {
+        auto const splitLoc = opt.find('=');
+        if (splitLoc == std::string::npos)
+        {
+            printString("Invalid render option '" + opt + "' expected 'name=value'", MessageLevel::Error);
+            return false;
+        }
+        std::string option = opt.substr(0, splitLoc);
+        std::string value  = opt.substr(splitLoc + 1);
+        if (auto found = validOpts.find(option); found != validOpts.end())
+        {
+            if (std::holds_alternative<bool>(found->second))
+            {
+                if (value == "true" || value == "1")
+                {
+                    Capsaicin::setOption(option, true);
+                }
+                else if (value == "false" || value == "0")
+                {
+                    Capsaicin::setOption(option, false);
+                }
+                else
+                {
+                    printString(
+                        "Invalid value passed for render option '" + option + "' expected bool", MessageLevel::Error);
+                    return false;
+                }
+            }
+            else if (std::holds_alternative<int32_t>(found->second))
+            {
+                try
+                {
+                    const int32_t newValue = std::stoi(value);
+                    Capsaicin::setOption(option, newValue);
+                }
+                catch (...)
+                {
+                    printString("Invalid value passed for render option '" + option + "' expected integer",
+                        MessageLevel::Error);
+                    return false;
+                }
+            }
+            else if (std::holds_alternative<uint32_t>(found->second))
+            {
+                try
+                {
+                    const uint32_t newValue = std::stoul(value);
+                    Capsaicin::setOption(option, newValue);
+                }
+                catch (...)
+                {
+                    printString("Invalid value passed for render option '" + option + "' expected unsigned integer",
+                        MessageLevel::Error);
+                    return false;
+                }
+            }
+            else if (std::holds_alternative<float>(found->second))
+            {
+                try
+                {
+                    float const newValue = std::stof(value);
+                    Capsaicin::setOption(option, newValue);
+                }
+                catch (...)
+                {
+                    printString(
+                        "Invalid value passed for render option '" + option + "' expected float", MessageLevel::Error);
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            printString("Invalid render option '" + option + "'", MessageLevel::Error);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CapsaicinMain::runBenchmarkMatrix() noexcept
+{
+    BenchmarkMatrix matrix;
+    std::string     error;
+    if (!matrix.load(benchmarkMatrixFile, error))
+    {
+        printString(error, MessageLevel::Error);
+        return false;
+    }
+    std::vector<BenchmarkResult> baseline;
+    if (!benchmarkBaselineFile.empty() && !ReadBenchmarkReport(benchmarkBaselineFile, baseline))
+    {
+        printString("Failed to read benchmark baseline file: "s + benchmarkBaselineFile, MessageLevel::Error);
+        return false;
+    }
+
+    // Check the whole matrix up front so that a typo doesn't abort a long run half way through
+    std::vector<Scene> matrixScenes;
+    for (auto const &sceneName : matrix.scenes)
+    {
+        auto const scene = std::find_if(
+            scenes.cbegin(), scenes.cend(), [&sceneName](auto const &value) { return value.name == sceneName; });
+        if (scene == scenes.cend())
+        {
+            printString("Unknown scene in benchmark matrix: "s + sceneName, MessageLevel::Error);
+            return false;
+        }
+        matrixScenes.push_back(static_cast<Scene>(scene - scenes.cbegin()));
+    }
+    auto const renderers = Capsaicin::GetRenderers();
+    for (auto const &renderer : matrix.renderers)
+    {
+        if (std::find(renderers.cbegin(), renderers.cend(), renderer) == renderers.cend())
+        {
+            printString("Unknown renderer in benchmark matrix: "s + renderer, MessageLevel::Error);
+            return false;
+        }
+    }
+
+    // Benchmark mode prevents user inputs, fixed frame rate playback makes every cell render the same frames
+    benchmarkMode = true;
+    Capsaicin::SetFixedFrameRate(true);
+    auto const                   environmentMap = currentEnvironmentMap;
+    std::vector<BenchmarkResult> results;
+    for (auto const scene : matrixScenes)
+    {
+        // Loading the scene that is already loaded is skipped
+        auto const &sceneData = scenes[static_cast<uint32_t>(scene)];
+        if (!loadScene(scene))
+        {
+            return false;
+        }
+        std::vector<std::string> cameras = matrix.cameras;
+        if (cameras.empty())
+        {
+            cameras.emplace_back(Capsaicin::GetSceneCurrentCamera());
+        }
+        auto const sceneCameras = Capsaicin::GetSceneCameras();
+        for (auto const &camera : cameras)
+        {
+            if (std::find(sceneCameras.cbegin(), sceneCameras.cend(), camera) == sceneCameras.cend())
+            {
+                printString("Skipping camera missing from scene '"s + sceneData.name + "': " + camera,
+                    MessageLevel::Warning);
+                continue;
+            }
+            for (auto const &renderer : matrix.renderers)
+            {
+                // Changing renderer resets the render options so the environment map is set again afterwards
+                if (!setRenderer(renderer)
+                    || !setEnvironmentMap(sceneData.useEnvironmentMap ? environmentMap : EnvironmentMap::None))
+                {
+                    return false;
+                }
+                // Option sets are applied on top of the renderer defaults
+                auto const defaultOptions = Capsaicin::GetOptions();
+                for (auto const &optionSet : matrix.optionSets)
+                {
+                    Capsaicin::GetOptions() = defaultOptions;
+                    if (!setRenderOptions(optionSet.options))
+                    {
+                        return false;
+                    }
+                    setCamera(camera);
+                    Capsaicin::RestartPlayback();
+                    Capsaicin::StartTimingStatistics(matrix.warmupFrames);
+                    while (Capsaicin::GetFrameIndex() < matrix.warmupFrames + matrix.measureFrames)
+                    {
+                        if (!renderFrame())
+                        {
+                            Capsaicin::StopTimingStatistics(nullptr);
+                            return false;
+                        }
+                    }
+                    for (auto &timing : Capsaicin::GetTimingStatistics())
+                    {
+                        results.push_back({sceneData.name, camera, renderer, optionSet.name, std::move(timing)});
+                    }
+                    Capsaicin::StopTimingStatistics(nullptr);
+                    printString("Benchmarked "s + sceneData.name + " / " + camera + " / " + renderer + " / "
+                                + optionSet.name);
+                }
+            }
+        }
+    }
+
+    std::vector<BenchmarkResult> regressions;
+    if (!WriteBenchmarkReport(benchmarkReportFile, results, baseline, matrix.regressionThreshold, regressions))
+    {
+        printString("Failed to write benchmark report file: "s + benchmarkReportFile, MessageLevel::Error);
+        return false;
+    }
+    for (auto const &regression : regressions)
+    {
+        printString("Performance regression: "s + regression.scene + " / " + regression.camera + " / "
+                        + regression.renderer + " / " + regression.optionSet + " / " + regression.timing.name,
+            MessageLevel::Warning);
+    }
+    return regressions.empty();
+}
+
 bool CapsaicinMain::renderFrame() noexcept
 {
     // Get keyboard layout mapping
@@ -791,7 +1126,7 @@ bool CapsaicinMain::renderFrame() noexcept
     if (!benchmarkMode)
     {
         // Update the camera
-        if (!Capsaicin::GetFixedFrameRate())
+        if (!Capsaicin::GetFixedFrameRate() && !Capsaicin::IsCameraReplaying())
         {
             auto        camera       = Capsaicin::GetSceneCamera();
             vec3 const  forward      = normalize(camera->center - camera->eye);
@@ -103,6 +103,13 @@ class CapsaicinMain
      */
     [[nodiscard]] bool loadScene(Scene scene) noexcept;
 
+    /**
+     * Build the scene caches of a list of scenes, each scene is then reloaded from its cache to compare load times.
+     * @param sceneIndices The indexes of the scenes to build the caches for.
+     * @return Boolean signaling if no error occurred.
+     */
+    [[nodiscard]] bool buildSceneCaches(std::vector<uint32_t> const &sceneIndices) noexcept;
+
     /**
      * Set the current camera data to the currently set cameraIndex.
      * @param camera The camera to load.
@@ -122,6 +129,20 @@ class CapsaicinMain
      */
     [[nodiscard]] bool setRenderer(std::string_view renderer) noexcept;
 
+    /**
+     * Set a list of render options of the current renderer.
+     * @param options The render options in the form 'name=value'.
+     * @return Boolean signaling if no error occurred.
+     */
+    [[nodiscard]] bool setRenderOptions(std::vector<std::string> const &options) noexcept;
+
+    /**
+     * Benchmark each cell of the benchmark matrix in turn and write the combined report.
+     * @note Loaded scenes are reused between cells, each cell restarts playback and collects its own timings.
+     * @return Boolean signaling if no error occurred and no regression was found compared to the baseline.
+     */
+    [[nodiscard]] bool runBenchmarkMatrix() noexcept;
+
     /**
      * Update render settings based on the currently set renderer.
      * @return Boolean signaling if no error occurred.
@@ -177,6 +198,13 @@ class CapsaicinMain
     uint32_t benchmarkModeStartFrame = uint32_t(-1); /**< The first frame to start saving images at in
                                                         benchmark mode (default is just the last frame) */
     std::string benchmarkModeSuffix;                 /**< String appended to any saved files */
+    std::string benchmarkTimingsFile;      /**< File timing statistics are written to in benchmark mode (if any) */
+    uint32_t    benchmarkWarmupFrames = 8; /**< The number of frames rendered before collecting timings */
+    std::string benchmarkMatrixFile;       /**< File listing the benchmark matrix to run (if any) */
+    std::string benchmarkBaselineFile;     /**< Report the benchmark matrix results are compared against (if any) */
+    std::string benchmarkReportFile = "benchmark_report.csv"; /**< File the benchmark matrix report is written to */
+    std::string gfxRecordingFile; /**< File the recorded gfx calls are written to on exit (empty if not recording) */
+    std::string cpuProfileFile;   /**< File the CPU profile is written to on exit (empty if not profiling) */
     bool        saveAsJPEG = false;                  /**< File type selector for dump frame */
     bool reenableToneMap   = false; /**< Used to re-enable Tonemapping after a frame has been saved to disk */
     bool reDisableRender   = false; /**< Use to render only a single frame at a time */